@@ -20,11 +20,15 @@
 #include <complex.h>
 #include <math.h>
 #include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include <gsl/gsl_sf_gamma.h>
 #include <lal/FrequencySeries.h>
 #include <lal/LALAtomicDatatypes.h>
 #include <lal/LALConstants.h>
 #include <lal/AVFactories.h>
+#include <lal/SeqFactories.h>
 #include <lal/Sequence.h>
 #include <lal/TimeFreqFFT.h>
 #include <lal/Units.h>
@@ -191,6 +195,195 @@ int XLALREAL8ModifiedPeriodogram(
 }
 
 
+/* number of segments whose periodograms are held at a time by the Welch
+ * routines */
+#define SEGMENT_BLOCK_LENGTH 64
+
+/*
+ * Compute the modified periodograms of segments of a time series.  Row i of
+ * periodograms receives the periodogram of the segment starting at sample
+ * start + i * stride.  Each segment is windowed in a workspace which is
+ * re-used for all segments, and is then transformed with the supplied plan,
+ * with the same operations as XLALREAL4ModifiedPeriodogram(), so that the
+ * results are identical.  Metadata are not set.
+ */
+static int segment_periodograms_REAL4(
+    REAL4VectorSequence         *periodograms,
+    const REAL4TimeSeries       *tseries,
+    UINT4                        start,
+    UINT4                        seglen,
+    UINT4                        stride,
+    const REAL4Window           *window,
+    const REAL4FFTPlan          *plan
+    )
+{
+  const UINT4 numseg = periodograms->length;
+  const UINT4 numbin = periodograms->vectorLength;
+  REAL4Sequence *work = NULL;
+  REAL4 normfac;
+  UINT4 seg;
+  UINT4 k;
+
+  if ( numbin != seglen/2 + 1 )
+    XLAL_ERROR( XLAL_EBADLEN );
+  if ( start + (numseg - 1) * stride + seglen > tseries->data->length )
+    XLAL_ERROR( XLAL_EBADLEN );
+
+  /* create a workspace for the windowed segments */
+  if ( window )
+  {
+    work = XLALCreateREAL4Sequence( seglen );
+    if ( ! work )
+      XLAL_ERROR( XLAL_EFUNC );
+  }
+
+  normfac = tseries->deltaT / seglen;
+
+  for ( seg = 0; seg < numseg; ++seg )
+  {
+    REAL4Vector segment = { seglen, tseries->data->data + start + seg * stride };
+    REAL4Vector power = { numbin, periodograms->data + seg * numbin };
+    const REAL4Vector *data = &segment;
+
+    /* apply windowing to a copy of the data */
+    if ( window )
+    {
+      memcpy( work->data, segment.data, seglen * sizeof( *work->data ) );
+      if ( ! XLALUnitaryWindowREAL4Sequence( work, window ) )
+      {
+        XLALDestroyREAL4Sequence( work );
+        XLAL_ERROR( XLAL_EFUNC );
+      }
+      data = work;
+    }
+
+    /* compute the power spectrum of the (windowed) segment, and normalize
+     * it to give correct units */
+    if ( XLALREAL4PowerSpectrum( &power, data, plan ) == XLAL_FAILURE )
+    {
+      XLALDestroyREAL4Sequence( work );
+      XLAL_ERROR( XLAL_EFUNC );
+    }
+    for ( k = 0; k < numbin; ++k )
+      power.data[k] *= normfac;
+  }
+
+  XLALDestroyREAL4Sequence( work );
+
+  return 0;
+}
+/* set the metadata of a spectrum estimated from segments of a time series,
+ * as XLALREAL4ModifiedPeriodogram() would */
+static int periodogram_metadata_REAL4(
+    REAL4FrequencySeries        *spectrum,
+    const REAL4TimeSeries       *tseries,
+    UINT4                        seglen
+    )
+{
+  spectrum->epoch  = tseries->epoch;
+  spectrum->f0     = tseries->f0;
+  spectrum->deltaF = 1.0 / ( seglen * tseries->deltaT );
+  if ( ! XLALUnitSquare( &spectrum->sampleUnits, &tseries->sampleUnits ) )
+    XLAL_ERROR( XLAL_EFUNC );
+  if ( ! XLALUnitMultiply( &spectrum->sampleUnits,
+                           &spectrum->sampleUnits, &lalSecondUnit ) )
+    XLAL_ERROR( XLAL_EFUNC );
+  return 0;
+}
+
+/*
+ * Compute the modified periodograms of segments of a time series.  Row i of
+ * periodograms receives the periodogram of the segment starting at sample
+ * start + i * stride.  Each segment is windowed in a workspace which is
+ * re-used for all segments, and is then transformed with the supplied plan,
+ * with the same operations as XLALREAL8ModifiedPeriodogram(), so that the
+ * results are identical.  Metadata are not set.
+ */
+static int segment_periodograms_REAL8(
+    REAL8VectorSequence         *periodograms,
+    const REAL8TimeSeries       *tseries,
+    UINT4                        start,
+    UINT4                        seglen,
+    UINT4                        stride,
+    const REAL8Window           *window,
+    const REAL8FFTPlan          *plan
+    )
+{
+  const UINT4 numseg = periodograms->length;
+  const UINT4 numbin = periodograms->vectorLength;
+  REAL8Sequence *work = NULL;
+  REAL8 normfac;
+  UINT4 seg;
+  UINT4 k;
+
+  if ( numbin != seglen/2 + 1 )
+    XLAL_ERROR( XLAL_EBADLEN );
+  if ( start + (numseg - 1) * stride + seglen > tseries->data->length )
+    XLAL_ERROR( XLAL_EBADLEN );
+
+  /* create a workspace for the windowed segments */
+  if ( window )
+  {
+    work = XLALCreateREAL8Sequence( seglen );
+    if ( ! work )
+      XLAL_ERROR( XLAL_EFUNC );
+  }
+
+  normfac = tseries->deltaT / seglen;
+
+  for ( seg = 0; seg < numseg; ++seg )
+  {
+    REAL8Vector segment = { seglen, tseries->data->data + start + seg * stride };
+    REAL8Vector power = { numbin, periodograms->data + seg * numbin };
+    const REAL8Vector *data = &segment;
+
+    /* apply windowing to a copy of the data */
+    if ( window )
+    {
+      memcpy( work->data, segment.data, seglen * sizeof( *work->data ) );
+      if ( ! XLALUnitaryWindowREAL8Sequence( work, window ) )
+      {
+        XLALDestroyREAL8Sequence( work );
+        XLAL_ERROR( XLAL_EFUNC );
+      }
+      data = work;
+    }
+
+    /* compute the power spectrum of the (windowed) segment, and normalize
+     * it to give correct units */
+    if ( XLALREAL8PowerSpectrum( &power, data, plan ) == XLAL_FAILURE )
+    {
+      XLALDestroyREAL8Sequence( work );
+      XLAL_ERROR( XLAL_EFUNC );
+    }
+    for ( k = 0; k < numbin; ++k )
+      power.data[k] *= normfac;
+  }
+
+  XLALDestroyREAL8Sequence( work );
+
+  return 0;
+}
+/* set the metadata of a spectrum estimated from segments of a time series,
+ * as XLALREAL8ModifiedPeriodogram() would */
+static int periodogram_metadata_REAL8(
+    REAL8FrequencySeries        *spectrum,
+    const REAL8TimeSeries       *tseries,
+    UINT4                        seglen
+    )
+{
+  spectrum->epoch  = tseries->epoch;
+  spectrum->f0     = tseries->f0;
+  spectrum->deltaF = 1.0 / ( seglen * tseries->deltaT );
+  if ( ! XLALUnitSquare( &spectrum->sampleUnits, &tseries->sampleUnits ) )
+    XLAL_ERROR( XLAL_EFUNC );
+  if ( ! XLALUnitMultiply( &spectrum->sampleUnits,
+                           &spectrum->sampleUnits, &lalSecondUnit ) )
+    XLAL_ERROR( XLAL_EFUNC );
+  return 0;
+}
+
+
 /**
  * Use Welch's method to compute the average power spectrum of a time series.
  *
@@ -209,11 +402,11 @@ int XLALREAL4AverageSpectrumWelch(
     const REAL4FFTPlan          *plan
     )
 {
-  REAL4FrequencySeries *work; /* workspace */
-  REAL4Sequence sequence; /* working copy of input time series data */
-  REAL4TimeSeries tseriescopy; /* working copy of input time series */
+  REAL4VectorSequence *work; /* workspace: periodograms of one block of segments */
   UINT4 numseg;
+  UINT4 block;
   UINT4 seg;
+  UINT4 i;
   UINT4 k;
 
   if ( ! spectrum || ! tseries || ! plan )
@@ -223,12 +416,6 @@ int XLALREAL4AverageSpectrumWelch(
   if ( tseries->deltaT <= 0.0 )
       XLAL_ERROR( XLAL_EINVAL );
 
-  /* construct local copy of time series */
-  sequence = *tseries->data;
-  tseriescopy = *tseries;
-  tseriescopy.data = &sequence;
-  tseriescopy.data->length = seglen;
-
   numseg = 1 + (tseries->data->length - seglen)/stride;
 
   /* consistency check for lengths: make sure that the segments cover the
@@ -238,42 +425,41 @@ int XLALREAL4AverageSpectrumWelch(
   if ( spectrum->data->length != seglen/2 + 1 )
     XLAL_ERROR( XLAL_EBADLEN );
 
+  block = numseg < SEGMENT_BLOCK_LENGTH ? numseg : SEGMENT_BLOCK_LENGTH;
+  work = XLALCreateREAL4VectorSequence( block, spectrum->data->length );
+  if( ! work )
+    XLAL_ERROR( XLAL_EFUNC );
+
   /* clear spectrum data */
   memset( spectrum->data->data, 0,
       spectrum->data->length * sizeof( *spectrum->data->data ) );
 
-  /* create frequency series data workspace */
-  work = XLALCutREAL4FrequencySeries( spectrum, 0, spectrum->data->length );
-  if( ! work )
-    XLAL_ERROR( XLAL_EFUNC );
-
-  for ( seg = 0; seg < numseg; seg++, tseriescopy.data->data += stride )
+  /* compute the modified periodograms of each block of segments and add
+   * them to the running sum */
+  for ( seg = 0; seg < numseg; seg += block )
   {
-    /* compute the modified periodogram; clean up and exit on failure */
-    if ( XLALREAL4ModifiedPeriodogram( work, &tseriescopy, window, plan ) == XLAL_FAILURE )
+    REAL4VectorSequence rows = { numseg - seg < block ? numseg - seg : block, work->vectorLength, work->data };
+    if ( segment_periodograms_REAL4( &rows, tseries, seg * stride, seglen, stride, window, plan ) == XLAL_FAILURE )
     {
-      XLALDestroyREAL4FrequencySeries( work );
+      XLALDestroyREAL4VectorSequence( work );
       XLAL_ERROR( XLAL_EFUNC );
     }
-
-    /* add the periodogram to the running sum */
-    for ( k = 0; k < spectrum->data->length; ++k )
-      spectrum->data->data[k] += work->data->data[k];
+    for ( i = 0; i < rows.length; ++i )
+      for ( k = 0; k < spectrum->data->length; ++k )
+        spectrum->data->data[k] += rows.data[i * rows.vectorLength + k];
   }
 
+  /* clean up */
+  XLALDestroyREAL4VectorSequence( work );
+
   /* set metadata */
-  spectrum->epoch       = work->epoch;
-  spectrum->f0          = work->f0;
-  spectrum->deltaF      = work->deltaF;
-  spectrum->sampleUnits = work->sampleUnits;
+  if ( periodogram_metadata_REAL4( spectrum, tseries, seglen ) == XLAL_FAILURE )
+    XLAL_ERROR( XLAL_EFUNC );
 
   /* divide spectrum data by the number of segments in average */
   for ( k = 0; k < spectrum->data->length; ++k )
     spectrum->data->data[k] /= numseg;
 
-  /* clean up */
-  XLALDestroyREAL4FrequencySeries( work );
-
   return 0;
 }
 
@@ -295,11 +481,11 @@ int XLALREAL8AverageSpectrumWelch(
     const REAL8FFTPlan          *plan
     )
 {
-  REAL8FrequencySeries *work; /* workspace */
-  REAL8Sequence sequence; /* working copy of input time series data */
-  REAL8TimeSeries tseriescopy; /* working copy of input time series */
+  REAL8VectorSequence *work; /* workspace: periodograms of one block of segments */
   UINT4 numseg;
+  UINT4 block;
   UINT4 seg;
+  UINT4 i;
   UINT4 k;
 
   if ( ! spectrum || ! tseries || ! plan )
@@ -309,12 +495,6 @@ int XLALREAL8AverageSpectrumWelch(
   if ( tseries->deltaT <= 0.0 )
       XLAL_ERROR( XLAL_EINVAL );
 
-  /* construct local copy of time series */
-  sequence = *tseries->data;
-  tseriescopy = *tseries;
-  tseriescopy.data = &sequence;
-  tseriescopy.data->length = seglen;
-
   numseg = 1 + (tseries->data->length - seglen)/stride;
 
   /* consistency check for lengths: make sure that the segments cover the
@@ -324,46 +504,44 @@ int XLALREAL8AverageSpectrumWelch(
   if ( spectrum->data->length != seglen/2 + 1 )
     XLAL_ERROR( XLAL_EBADLEN );
 
+  block = numseg < SEGMENT_BLOCK_LENGTH ? numseg : SEGMENT_BLOCK_LENGTH;
+  work = XLALCreateREAL8VectorSequence( block, spectrum->data->length );
+  if( ! work )
+    XLAL_ERROR( XLAL_EFUNC );
+
   /* clear spectrum data */
   memset( spectrum->data->data, 0,
       spectrum->data->length * sizeof( *spectrum->data->data ) );
 
-  /* create frequency series data workspace */
-  work = XLALCutREAL8FrequencySeries( spectrum, 0, spectrum->data->length );
-  if( ! work )
-    XLAL_ERROR( XLAL_EFUNC );
-
-  for ( seg = 0; seg < numseg; seg++, tseriescopy.data->data += stride )
+  /* compute the modified periodograms of each block of segments and add
+   * them to the running sum */
+  for ( seg = 0; seg < numseg; seg += block )
   {
-    /* compute the modified periodogram; clean up and exit on failure */
-    if ( XLALREAL8ModifiedPeriodogram( work, &tseriescopy, window, plan ) == XLAL_FAILURE )
+    REAL8VectorSequence rows = { numseg - seg < block ? numseg - seg : block, work->vectorLength, work->data };
+    if ( segment_periodograms_REAL8( &rows, tseries, seg * stride, seglen, stride, window, plan ) == XLAL_FAILURE )
     {
-      XLALDestroyREAL8FrequencySeries( work );
+      XLALDestroyREAL8VectorSequence( work );
       XLAL_ERROR( XLAL_EFUNC );
     }
-
-    /* add the periodogram to the running sum */
-    for ( k = 0; k < spectrum->data->length; ++k )
-      spectrum->data->data[k] += work->data->data[k];
+    for ( i = 0; i < rows.length; ++i )
+      for ( k = 0; k < spectrum->data->length; ++k )
+        spectrum->data->data[k] += rows.data[i * rows.vectorLength + k];
   }
 
+  /* clean up */
+  XLALDestroyREAL8VectorSequence( work );
+
   /* set metadata */
-  spectrum->epoch       = work->epoch;
-  spectrum->f0          = work->f0;
-  spectrum->deltaF      = work->deltaF;
-  spectrum->sampleUnits = work->sampleUnits;
+  if ( periodogram_metadata_REAL8( spectrum, tseries, seglen ) == XLAL_FAILURE )
+    XLAL_ERROR( XLAL_EFUNC );
 
   /* divide spectrum data by the number of segments in average */
   for ( k = 0; k < spectrum->data->length; ++k )
     spectrum->data->data[k] /= numseg;
 
-  /* clean up */
-  XLALDestroyREAL8FrequencySeries( work );
-
   return 0;
 }
 
-
 /*
  *
  * Median Method: use median average rather than mean.
@@ -394,37 +572,7 @@ REAL8 XLALMedianBias( UINT4 nn )
   return ans;
 }
 
-/* cleanup temporary workspace... ignore xlal errors */
-static void median_cleanup_REAL4( REAL4FrequencySeries *work, UINT4 n )
-{
-  int saveErrno = xlalErrno;
-  UINT4 i;
-  for ( i = 0; i < n; ++i )
-    if ( work[i].data )
-      XLALDestroyREAL4Vector( work[i].data );
-  XLALFree( work );
-  xlalErrno = saveErrno;
-  return;
-}
-static void median_cleanup_REAL8( REAL8FrequencySeries *work, UINT4 n )
-{
-  int saveErrno = xlalErrno;
-  UINT4 i;
-  for ( i = 0; i < n; ++i )
-    if ( work[i].data )
-      XLALDestroyREAL8Vector( work[i].data );
-  XLALFree( work );
-  xlalErrno = saveErrno;
-  return;
-}
-
 /* comparison for floating point numbers */
-static int compare_REAL4( const void *p1, const void *p2 )
-{
-  REAL4 x1 = *(const REAL4 *)p1;
-  REAL4 x2 = *(const REAL4 *)p2;
-  return (x1 > x2) - (x1 < x2);
-}
 static int compare_REAL8( const void *p1, const void *p2 )
 {
   REAL8 x1 = *(const REAL8 *)p1;
@@ -432,6 +580,17 @@ static int compare_REAL8( const void *p1, const void *p2 )
   return (x1 > x2) - (x1 < x2);
 }
 
+/* number of values below which medians are found by sorting */
+#define MEDIAN_SORT_LENGTH 16
+
+/* number of frequency bins transposed into bin-major order at a time */
+#define MEDIAN_BLOCK_LENGTH 64
+
+#define SINGLE_PRECISION
+#include "AverageSpectrumMedian_source.c"
+#undef SINGLE_PRECISION
+#include "AverageSpectrumMedian_source.c"
+
 
 /**
  * Median Method: use median average rather than mean.  Note: this will
@@ -450,13 +609,10 @@ int XLALREAL4AverageSpectrumMedian(
     const REAL4FFTPlan          *plan
     )
 {
-  REAL4FrequencySeries *work; /* array of frequency series */
-  REAL4 *bin; /* array of bin values */
   REAL4 biasfac; /* median bias factor */
   REAL4 normfac; /* normalization factor */
   UINT4 reclen; /* length of entire data record */
   UINT4 numseg;
-  UINT4 seg;
   UINT4 k;
 
   if ( ! spectrum || ! tseries || ! plan )
@@ -476,53 +632,10 @@ int XLALREAL4AverageSpectrumMedian(
   if ( spectrum->data->length != seglen/2 + 1 )
     XLAL_ERROR( XLAL_EBADLEN );
 
-  /* create frequency series data workspaces */
-  work = XLALCalloc( numseg, sizeof( *work ) );
-  if ( ! work )
-    XLAL_ERROR( XLAL_ENOMEM );
-  for ( seg = 0; seg < numseg; ++seg )
-  {
-    work[seg].data = XLALCreateREAL4Vector( spectrum->data->length );
-    if ( ! work[seg].data )
-    {
-      median_cleanup_REAL4( work, numseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-  }
-
-  for ( seg = 0; seg < numseg; ++seg )
-  {
-    REAL4Vector savevec; /* save the time series data vector */
-    int code;
-
-    /* save the time series data vector */
-    savevec = *tseries->data;
-
-    /* set the data vector to be appropriate for the even segment */
-    tseries->data->length  = seglen;
-    tseries->data->data   += seg * stride;
-
-    /* compute the modified periodogram for the even segment */
-    code = XLALREAL4ModifiedPeriodogram( work + seg, tseries, window, plan );
-
-    /* restore the time series data vector to its original state */
-    *tseries->data = savevec;
-
-    /* now check for failure of the XLAL routine */
-    if ( code == XLAL_FAILURE )
-    {
-      median_cleanup_REAL4( work, numseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-  }
-
-  /* create array to hold a particular frequency bin data */
-  bin = XLALMalloc( numseg * sizeof( *bin ) );
-  if ( ! bin )
-  {
-    median_cleanup_REAL4( work, numseg ); /* cleanup */
-    XLAL_ERROR( XLAL_ENOMEM );
-  }
+  /* compute the median of each frequency bin over the periodograms of all
+   * segments */
+  if ( segment_medians_REAL4( spectrum->data->data, tseries, numseg, 0, seglen, stride, window, plan ) == XLAL_FAILURE )
+    XLAL_ERROR( XLAL_EFUNC );
 
   /* compute median bias factor */
   biasfac = XLALMedianBias( numseg );
@@ -530,33 +643,13 @@ int XLALREAL4AverageSpectrumMedian(
   /* normaliztion takes into account bias */
   normfac = 1.0 / biasfac;
 
-  /* now loop over frequency bins and compute the median-mean */
+  /* remove median bias */
   for ( k = 0; k < spectrum->data->length; ++k )
-  {
-    /* assign array of even segment values to bin array for this freq bin */
-    for ( seg = 0; seg < numseg; ++seg )
-      bin[seg] = work[seg].data->data[k];
-
-    /* sort them and find median */
-    qsort( bin, numseg, sizeof( *bin ), compare_REAL4 );
-    if ( numseg % 2 ) /* odd number of evens */
-      spectrum->data->data[k] = bin[numseg/2];
-    else /* even number... take average */
-      spectrum->data->data[k] = 0.5*(bin[numseg/2-1] + bin[numseg/2]);
-
-    /* remove median bias */
     spectrum->data->data[k] *= normfac;
-  }
 
   /* set metadata */
-  spectrum->epoch       = work->epoch;
-  spectrum->f0          = work->f0;
-  spectrum->deltaF      = work->deltaF;
-  spectrum->sampleUnits = work->sampleUnits;
-
-  /* free the workspace data */
-  XLALFree( bin );
-  median_cleanup_REAL4( work, numseg );
+  if ( periodogram_metadata_REAL4( spectrum, tseries, seglen ) == XLAL_FAILURE )
+    XLAL_ERROR( XLAL_EFUNC );
 
   return 0;
 }
@@ -578,13 +671,10 @@ int XLALREAL8AverageSpectrumMedian(
     const REAL8FFTPlan          *plan
     )
 {
-  REAL8FrequencySeries *work; /* array of frequency series */
-  REAL8 *bin; /* array of bin values */
   REAL8 biasfac; /* median bias factor */
   REAL8 normfac; /* normalization factor */
   UINT4 reclen; /* length of entire data record */
   UINT4 numseg;
-  UINT4 seg;
   UINT4 k;
 
   if ( ! spectrum || ! tseries || ! plan )
@@ -604,53 +694,10 @@ int XLALREAL8AverageSpectrumMedian(
   if ( spectrum->data->length != seglen/2 + 1 )
     XLAL_ERROR( XLAL_EBADLEN );
 
-  /* create frequency series data workspaces */
-  work = XLALCalloc( numseg, sizeof( *work ) );
-  if ( ! work )
-    XLAL_ERROR( XLAL_ENOMEM );
-  for ( seg = 0; seg < numseg; ++seg )
-  {
-    work[seg].data = XLALCreateREAL8Vector( spectrum->data->length );
-    if ( ! work[seg].data )
-    {
-      median_cleanup_REAL8( work, numseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-  }
-
-  for ( seg = 0; seg < numseg; ++seg )
-  {
-    REAL8Vector savevec; /* save the time series data vector */
-    int code;
-
-    /* save the time series data vector */
-    savevec = *tseries->data;
-
-    /* set the data vector to be appropriate for the even segment */
-    tseries->data->length  = seglen;
-    tseries->data->data   += seg * stride;
-
-    /* compute the modified periodogram for the even segment */
-    code = XLALREAL8ModifiedPeriodogram( work + seg, tseries, window, plan );
-
-    /* restore the time series data vector to its original state */
-    *tseries->data = savevec;
-
-    /* now check for failure of the XLAL routine */
-    if ( code == XLAL_FAILURE )
-    {
-      median_cleanup_REAL8( work, numseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-  }
-
-  /* create array to hold a particular frequency bin data */
-  bin = XLALMalloc( numseg * sizeof( *bin ) );
-  if ( ! bin )
-  {
-    median_cleanup_REAL8( work, numseg ); /* cleanup */
-    XLAL_ERROR( XLAL_ENOMEM );
-  }
+  /* compute the median of each frequency bin over the periodograms of all
+   * segments */
+  if ( segment_medians_REAL8( spectrum->data->data, tseries, numseg, 0, seglen, stride, window, plan ) == XLAL_FAILURE )
+    XLAL_ERROR( XLAL_EFUNC );
 
   /* compute median bias factor */
   biasfac = XLALMedianBias( numseg );
@@ -658,38 +705,17 @@ int XLALREAL8AverageSpectrumMedian(
   /* normaliztion takes into account bias */
   normfac = 1.0 / biasfac;
 
-  /* now loop over frequency bins and compute the median-mean */
+  /* remove median bias */
   for ( k = 0; k < spectrum->data->length; ++k )
-  {
-    /* assign array of even segment values to bin array for this freq bin */
-    for ( seg = 0; seg < numseg; ++seg )
-      bin[seg] = work[seg].data->data[k];
-
-    /* sort them and find median */
-    qsort( bin, numseg, sizeof( *bin ), compare_REAL8 );
-    if ( numseg % 2 ) /* odd number of evens */
-      spectrum->data->data[k] = bin[numseg/2];
-    else /* even number... take average */
-      spectrum->data->data[k] = 0.5*(bin[numseg/2-1] + bin[numseg/2]);
-
-    /* remove median bias */
     spectrum->data->data[k] *= normfac;
-  }
 
   /* set metadata */
-  spectrum->epoch       = work->epoch;
-  spectrum->f0          = work->f0;
-  spectrum->deltaF      = work->deltaF;
-  spectrum->sampleUnits = work->sampleUnits;
-
-  /* free the workspace data */
-  XLALFree( bin );
-  median_cleanup_REAL8( work, numseg );
+  if ( periodogram_metadata_REAL8( spectrum, tseries, seglen ) == XLAL_FAILURE )
+    XLAL_ERROR( XLAL_EFUNC );
 
   return 0;
 }
 
-
 /*
  *
  * Median-Mean Method
@@ -697,39 +723,6 @@ int XLALREAL8AverageSpectrumMedian(
  */
 
 
-/* cleanup temporary workspace... ignore xlal errors */
-static void median_mean_cleanup_REAL4( REAL4FrequencySeries *even, REAL4FrequencySeries *odd, UINT4 n )
-{
-  int saveErrno = xlalErrno;
-  UINT4 i;
-  for ( i = 0; i < n; ++i )
-  {
-    if ( even[i].data )
-      XLALDestroyREAL4Vector( even[i].data );
-    if ( odd[i].data )
-      XLALDestroyREAL4Vector( odd[i].data );
-  }
-  XLALFree( even );
-  XLALFree( odd );
-  xlalErrno = saveErrno;
-  return;
-}
-static void median_mean_cleanup_REAL8( REAL8FrequencySeries *even, REAL8FrequencySeries *odd, UINT4 n )
-{
-  int saveErrno = xlalErrno;
-  UINT4 i;
-  for ( i = 0; i < n; ++i )
-  {
-    if ( even[i].data )
-      XLALDestroyREAL8Vector( even[i].data );
-    if ( odd[i].data )
-      XLALDestroyREAL8Vector( odd[i].data );
-  }
-  XLALFree( even );
-  XLALFree( odd );
-  xlalErrno = saveErrno;
-  return;
-}
 
 /**
  * Median-Mean Method: divide overlapping segments into "even" and "odd"
@@ -747,15 +740,14 @@ int XLALREAL4AverageSpectrumMedianMean(
     const REAL4FFTPlan          *plan
     )
 {
-  REAL4FrequencySeries *even; /* array of even frequency series */
-  REAL4FrequencySeries *odd;  /* array of odd frequency series */
-  REAL4 *bin; /* array of bin values */
+  REAL4 *evenmedian; /* array of medians of the even segments */
+  REAL4 *oddmedian; /* array of medians of the odd segments */
+  int code;
   REAL4 biasfac; /* median bias factor */
   REAL4 normfac; /* normalization factor */
   UINT4 reclen; /* length of entire data record */
   UINT4 numseg;
   UINT4 halfnumseg;
-  UINT4 seg;
   UINT4 k;
 
   if ( ! spectrum || ! tseries || ! plan )
@@ -781,71 +773,27 @@ int XLALREAL4AverageSpectrumMedianMean(
   if ( numseg%2 || stride < seglen/2 )
     XLAL_ERROR( XLAL_EBADLEN );
 
-  /* create frequency series data workspaces */
-  even = XLALCalloc( halfnumseg, sizeof( *even ) );
-  if ( ! even )
-    XLAL_ERROR( XLAL_ENOMEM );
-  odd = XLALCalloc( halfnumseg, sizeof( *odd ) );
-  if ( ! odd )
-    XLAL_ERROR( XLAL_ENOMEM );
-  for ( seg = 0; seg < halfnumseg; ++seg )
-  {
-    even[seg].data = XLALCreateREAL4Vector( spectrum->data->length );
-    odd[seg].data  = XLALCreateREAL4Vector( spectrum->data->length );
-    if ( ! even[seg].data || ! odd[seg].data )
-    {
-      median_mean_cleanup_REAL4( even, odd, halfnumseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-  }
-
-  for ( seg = 0; seg < halfnumseg; ++seg )
+  /* create arrays to hold the even and odd medians */
+  evenmedian = XLALMalloc( spectrum->data->length * sizeof( *evenmedian ) );
+  oddmedian = XLALMalloc( spectrum->data->length * sizeof( *oddmedian ) );
+  if ( ! evenmedian || ! oddmedian )
   {
-    REAL4Vector savevec; /* save the time series data vector */
-    int code;
-
-    /* save the time series data vector */
-    savevec = *tseries->data;
-
-    /* set the data vector to be appropriate for the even segment */
-    tseries->data->length  = seglen;
-    tseries->data->data   += 2 * seg * stride;
-
-    /* compute the modified periodogram for the even segment */
-    code = XLALREAL4ModifiedPeriodogram( even + seg, tseries, window, plan );
-
-    /* now check for failure of the XLAL routine */
-    if ( code == XLAL_FAILURE )
-    {
-      *tseries->data = savevec;
-      median_mean_cleanup_REAL4( even, odd, halfnumseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-
-    /* set the data vector to be appropriate for the odd segment */
-    tseries->data->data += stride;
-
-    /* compute the modified periodogram for the odd segment */
-    code = XLALREAL4ModifiedPeriodogram( odd + seg, tseries, window, plan );
-
-    /* now check for failure of the XLAL routine */
-    if ( code == XLAL_FAILURE )
-    {
-      *tseries->data = savevec;
-      median_mean_cleanup_REAL4( even, odd, halfnumseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-
-    /* restore the time series data vector to its original state */
-    *tseries->data = savevec;
+    XLALFree( evenmedian );
+    XLALFree( oddmedian );
+    XLAL_ERROR( XLAL_ENOMEM );
   }
 
-  /* create array to hold a particular frequency bin data */
-  bin = XLALMalloc( halfnumseg * sizeof( *bin ) );
-  if ( ! bin )
+  /* compute the medians of the even segments, which start at multiples of
+   * twice the stride, and of the odd segments, which start one stride later,
+   * in each bin */
+  code = segment_medians_REAL4( evenmedian, tseries, halfnumseg, 0, seglen, 2 * stride, window, plan );
+  if ( code != XLAL_FAILURE )
+    code = segment_medians_REAL4( oddmedian, tseries, halfnumseg, stride, seglen, 2 * stride, window, plan );
+  if ( code == XLAL_FAILURE )
   {
-    median_mean_cleanup_REAL4( even, odd, halfnumseg ); /* cleanup */
-    XLAL_ERROR( XLAL_ENOMEM );
+    XLALFree( evenmedian );
+    XLALFree( oddmedian );
+    XLAL_ERROR( XLAL_EFUNC );
   }
 
   /* compute median bias factor */
@@ -858,44 +806,17 @@ int XLALREAL4AverageSpectrumMedianMean(
   /* now loop over frequency bins and compute the median-mean */
   for ( k = 0; k < spectrum->data->length; ++k )
   {
-    REAL4 evenmedian;
-    REAL4 oddmedian;
-
-    /* assign array of even segment values to bin array for this freq bin */
-    for ( seg = 0; seg < halfnumseg; ++seg )
-      bin[seg] = even[seg].data->data[k];
-
-    /* sort them and find median */
-    qsort( bin, halfnumseg, sizeof( *bin ), compare_REAL4 );
-    if ( halfnumseg % 2 ) /* odd number of evens */
-      evenmedian = bin[halfnumseg/2];
-    else /* even number... take average */
-      evenmedian = 0.5*(bin[halfnumseg/2-1] + bin[halfnumseg/2]);
-
-    /* assign array of odd segment values to bin array for this freq bin */
-    for ( seg = 0; seg < halfnumseg; ++seg )
-      bin[seg] = odd[seg].data->data[k];
-
-    /* sort them and find median */
-    qsort( bin, halfnumseg, sizeof( *bin ), compare_REAL4 );
-    if ( halfnumseg % 2 ) /* odd number of odds */
-      oddmedian = bin[halfnumseg/2];
-    else /* even number... take average */
-      oddmedian = 0.5*(bin[halfnumseg/2-1] + bin[halfnumseg/2]);
-
     /* spectrum for this bin is the mean of the medians */
-    spectrum->data->data[k] = normfac * (evenmedian + oddmedian);
+    spectrum->data->data[k] = normfac * (evenmedian[k] + oddmedian[k]);
   }
 
-  /* set metadata */
-  spectrum->epoch       = even->epoch;
-  spectrum->f0          = even->f0;
-  spectrum->deltaF      = even->deltaF;
-  spectrum->sampleUnits = even->sampleUnits;
-
   /* free the workspace data */
-  XLALFree( bin );
-  median_mean_cleanup_REAL4( even, odd, halfnumseg );
+  XLALFree( evenmedian );
+  XLALFree( oddmedian );
+
+  /* set metadata */
+  if ( periodogram_metadata_REAL4( spectrum, tseries, seglen ) == XLAL_FAILURE )
+    XLAL_ERROR( XLAL_EFUNC );
 
   return 0;
 }
@@ -916,15 +837,14 @@ int XLALREAL8AverageSpectrumMedianMean(
     const REAL8FFTPlan          *plan
     )
 {
-  REAL8FrequencySeries *even; /* array of even frequency series */
-  REAL8FrequencySeries *odd;  /* array of odd frequency series */
-  REAL8 *bin; /* array of bin values */
+  REAL8 *evenmedian; /* array of medians of the even segments */
+  REAL8 *oddmedian; /* array of medians of the odd segments */
+  int code;
   REAL8 biasfac; /* median bias factor */
   REAL8 normfac; /* normalization factor */
   UINT4 reclen; /* length of entire data record */
   UINT4 numseg;
   UINT4 halfnumseg;
-  UINT4 seg;
   UINT4 k;
 
   if ( ! spectrum || ! tseries || ! plan )
@@ -950,71 +870,27 @@ int XLALREAL8AverageSpectrumMedianMean(
   if ( numseg%2 || stride < seglen/2 )
     XLAL_ERROR( XLAL_EBADLEN );
 
-  /* create frequency series data workspaces */
-  even = XLALCalloc( halfnumseg, sizeof( *even ) );
-  if ( ! even )
-    XLAL_ERROR( XLAL_ENOMEM );
-  odd = XLALCalloc( halfnumseg, sizeof( *odd ) );
-  if ( ! odd )
-    XLAL_ERROR( XLAL_ENOMEM );
-  for ( seg = 0; seg < halfnumseg; ++seg )
+  /* create arrays to hold the even and odd medians */
+  evenmedian = XLALMalloc( spectrum->data->length * sizeof( *evenmedian ) );
+  oddmedian = XLALMalloc( spectrum->data->length * sizeof( *oddmedian ) );
+  if ( ! evenmedian || ! oddmedian )
   {
-    even[seg].data = XLALCreateREAL8Vector( spectrum->data->length );
-    odd[seg].data  = XLALCreateREAL8Vector( spectrum->data->length );
-    if ( ! even[seg].data || ! odd[seg].data )
-    {
-      median_mean_cleanup_REAL8( even, odd, halfnumseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-  }
-
-  for ( seg = 0; seg < halfnumseg; ++seg )
-  {
-    REAL8Vector savevec; /* save the time series data vector */
-    int code;
-
-    /* save the time series data vector */
-    savevec = *tseries->data;
-
-    /* set the data vector to be appropriate for the even segment */
-    tseries->data->length  = seglen;
-    tseries->data->data   += 2 * seg * stride;
-
-    /* compute the modified periodogram for the even segment */
-    code = XLALREAL8ModifiedPeriodogram( even + seg, tseries, window, plan );
-
-    /* now check for failure of the XLAL routine */
-    if ( code == XLAL_FAILURE )
-    {
-      *tseries->data = savevec;
-      median_mean_cleanup_REAL8( even, odd, halfnumseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-
-    /* set the data vector to be appropriate for the odd segment */
-    tseries->data->data += stride;
-
-    /* compute the modified periodogram for the odd segment */
-    code = XLALREAL8ModifiedPeriodogram( odd + seg, tseries, window, plan );
-
-    /* now check for failure of the XLAL routine */
-    if ( code == XLAL_FAILURE )
-    {
-      *tseries->data = savevec;
-      median_mean_cleanup_REAL8( even, odd, halfnumseg ); /* cleanup */
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-
-    /* restore the time series data vector to its original state */
-    *tseries->data = savevec;
+    XLALFree( evenmedian );
+    XLALFree( oddmedian );
+    XLAL_ERROR( XLAL_ENOMEM );
   }
 
-  /* create array to hold a particular frequency bin data */
-  bin = XLALMalloc( halfnumseg * sizeof( *bin ) );
-  if ( ! bin )
+  /* compute the medians of the even segments, which start at multiples of
+   * twice the stride, and of the odd segments, which start one stride later,
+   * in each bin */
+  code = segment_medians_REAL8( evenmedian, tseries, halfnumseg, 0, seglen, 2 * stride, window, plan );
+  if ( code != XLAL_FAILURE )
+    code = segment_medians_REAL8( oddmedian, tseries, halfnumseg, stride, seglen, 2 * stride, window, plan );
+  if ( code == XLAL_FAILURE )
   {
-    median_mean_cleanup_REAL8( even, odd, halfnumseg ); /* cleanup */
-    XLAL_ERROR( XLAL_ENOMEM );
+    XLALFree( evenmedian );
+    XLALFree( oddmedian );
+    XLAL_ERROR( XLAL_EFUNC );
   }
 
   /* compute median bias factor */
@@ -1027,44 +903,17 @@ int XLALREAL8AverageSpectrumMedianMean(
   /* now loop over frequency bins and compute the median-mean */
   for ( k = 0; k < spectrum->data->length; ++k )
   {
-    REAL8 evenmedian;
-    REAL8 oddmedian;
-
-    /* assign array of even segment values to bin array for this freq bin */
-    for ( seg = 0; seg < halfnumseg; ++seg )
-      bin[seg] = even[seg].data->data[k];
-
-    /* sort them and find median */
-    qsort( bin, halfnumseg, sizeof( *bin ), compare_REAL8 );
-    if ( halfnumseg % 2 ) /* odd number of evens */
-      evenmedian = bin[halfnumseg/2];
-    else /* even number... take average */
-      evenmedian = 0.5*(bin[halfnumseg/2-1] + bin[halfnumseg/2]);
-
-    /* assign array of odd segment values to bin array for this freq bin */
-    for ( seg = 0; seg < halfnumseg; ++seg )
-      bin[seg] = odd[seg].data->data[k];
-
-    /* sort them and find median */
-    qsort( bin, halfnumseg, sizeof( *bin ), compare_REAL8 );
-    if ( halfnumseg % 2 ) /* odd number of odds */
-      oddmedian = bin[halfnumseg/2];
-    else /* even number... take average */
-      oddmedian = 0.5*(bin[halfnumseg/2-1] + bin[halfnumseg/2]);
-
     /* spectrum for this bin is the mean of the medians */
-    spectrum->data->data[k] = normfac * (evenmedian + oddmedian);
+    spectrum->data->data[k] = normfac * (evenmedian[k] + oddmedian[k]);
   }
 
-  /* set metadata */
-  spectrum->epoch       = even->epoch;
-  spectrum->f0          = even->f0;
-  spectrum->deltaF      = even->deltaF;
-  spectrum->sampleUnits = even->sampleUnits;
-
   /* free the workspace data */
-  XLALFree( bin );
-  median_mean_cleanup_REAL8( even, odd, halfnumseg );
+  XLALFree( evenmedian );
+  XLALFree( oddmedian );
+
+  /* set metadata */
+  if ( periodogram_metadata_REAL8( spectrum, tseries, seglen ) == XLAL_FAILURE )
+    XLAL_ERROR( XLAL_EFUNC );
 
   return 0;
 }
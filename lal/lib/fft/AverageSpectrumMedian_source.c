@@ -0,0 +1,214 @@
+/*
+ * Median routines of AverageSpectrum.c, for the real type REAL_TYPE; this
+ * file is included once for each precision.
+ */
+
+#define CONCAT2x(a,b) a##b
+#define CONCAT2(a,b) CONCAT2x(a,b)
+#define CONCAT3x(a,b,c) a##b##c
+#define CONCAT3(a,b,c) CONCAT3x(a,b,c)
+
+#ifdef SINGLE_PRECISION
+#define REAL_TYPE REAL4
+#else
+#define REAL_TYPE REAL8
+#endif
+
+#define REAL_VECTOR_SEQUENCE_TYPE	CONCAT2(REAL_TYPE,VectorSequence)
+#define TIME_SERIES_TYPE		CONCAT2(REAL_TYPE,TimeSeries)
+#define WINDOW_TYPE			CONCAT2(REAL_TYPE,Window)
+#define PLAN_TYPE			CONCAT2(REAL_TYPE,FFTPlan)
+
+#define CREATE_SEQUENCE_FUNCTION	CONCAT3(XLALCreate,REAL_TYPE,VectorSequence)
+#define DESTROY_SEQUENCE_FUNCTION	CONCAT3(XLALDestroy,REAL_TYPE,VectorSequence)
+#define SEGMENT_PERIODOGRAMS_FUNCTION	CONCAT2(segment_periodograms_,REAL_TYPE)
+#define MEDIAN_FUNCTION			CONCAT2(median_,REAL_TYPE)
+#define BIN_MEDIANS_FUNCTION		CONCAT2(bin_medians_,REAL_TYPE)
+#define SEGMENT_MEDIANS_FUNCTION	CONCAT2(segment_medians_,REAL_TYPE)
+
+/* median of n values, which are reordered; the result is identical to
+ * sorting the values and taking the middle one, or the average of the two
+ * middle ones if n is even */
+static REAL_TYPE MEDIAN_FUNCTION( REAL_TYPE *x, UINT4 n )
+{
+  const long mid = n / 2;
+  long lo = 0;
+  long hi = (long) n - 1;
+  long i, j;
+  REAL_TYPE below;
+
+  /* short arrays: insertion sort */
+  if ( n <= MEDIAN_SORT_LENGTH )
+  {
+    for ( i = 1; i < (long) n; ++i )
+    {
+      REAL_TYPE tmp = x[i];
+      for ( j = i; j > 0 && x[j-1] > tmp; --j )
+        x[j] = x[j-1];
+      x[j] = tmp;
+    }
+    if ( n % 2 )
+      return x[mid];
+    return 0.5*(x[mid-1] + x[mid]);
+  }
+
+  /* quickselect: move the value of rank mid to x[mid], with no larger
+   * values before it and no smaller values after it */
+  while ( lo < hi )
+  {
+    const long m = lo + (hi - lo)/2;
+    REAL_TYPE pivot;
+    REAL_TYPE tmp;
+
+    /* median-of-three pivot */
+    if ( x[m] < x[lo] ) { tmp = x[m]; x[m] = x[lo]; x[lo] = tmp; }
+    if ( x[hi] < x[lo] ) { tmp = x[hi]; x[hi] = x[lo]; x[lo] = tmp; }
+    if ( x[hi] < x[m] ) { tmp = x[hi]; x[hi] = x[m]; x[m] = tmp; }
+    pivot = x[m];
+
+    /* partition */
+    i = lo;
+    j = hi;
+    while ( i <= j )
+    {
+      while ( x[i] < pivot )
+        ++i;
+      while ( pivot < x[j] )
+        --j;
+      if ( i <= j )
+      {
+        tmp = x[i]; x[i] = x[j]; x[j] = tmp;
+        ++i;
+        --j;
+      }
+    }
+
+    if ( mid <= j )
+      hi = j;
+    else if ( mid >= i )
+      lo = i;
+    else
+      break;
+  }
+
+  if ( n % 2 )
+    return x[mid];
+
+  /* the value of rank mid - 1 is the largest of those before x[mid] */
+  below = x[0];
+  for ( i = 1; i < mid; ++i )
+    if ( x[i] > below )
+      below = x[i];
+  return 0.5*(below + x[mid]);
+}
+
+/* compute the median over rows of each of the numbin columns of the nrows
+ * arrays rows; blocks of columns are transposed into bin-major order so
+ * that the values for each bin are contiguous, and the blocks are divided
+ * between threads */
+static int BIN_MEDIANS_FUNCTION( REAL_TYPE *medians, REAL_TYPE * const *rows, UINT4 nrows, UINT4 numbin )
+{
+  const int nblocks = (numbin + MEDIAN_BLOCK_LENGTH - 1) / MEDIAN_BLOCK_LENGTH;
+  int nthreads = 1;
+  int block;
+  REAL_TYPE *buffer;
+
+#ifdef _OPENMP
+  nthreads = omp_get_max_threads();
+#endif
+
+  /* one bin-major block per thread */
+  buffer = XLALMalloc( (size_t) nthreads * MEDIAN_BLOCK_LENGTH * nrows * sizeof( *buffer ) );
+  if ( ! buffer )
+    XLAL_ERROR( XLAL_ENOMEM );
+
+#pragma omp parallel for schedule(dynamic)
+  for ( block = 0; block < nblocks; ++block )
+  {
+#ifdef _OPENMP
+    REAL_TYPE *bin = buffer + (size_t) omp_get_thread_num() * MEDIAN_BLOCK_LENGTH * nrows;
+#else
+    REAL_TYPE *bin = buffer;
+#endif
+    const UINT4 k0 = block * MEDIAN_BLOCK_LENGTH;
+    const UINT4 count = numbin - k0 < MEDIAN_BLOCK_LENGTH ? numbin - k0 : MEDIAN_BLOCK_LENGTH;
+    UINT4 seg;
+    UINT4 k;
+
+    /* transpose this block of bins */
+    for ( seg = 0; seg < nrows; ++seg )
+      for ( k = 0; k < count; ++k )
+        bin[k * nrows + seg] = rows[seg][k0 + k];
+
+    for ( k = 0; k < count; ++k )
+      medians[k0 + k] = MEDIAN_FUNCTION( bin + k * nrows, nrows );
+  }
+
+  XLALFree( buffer );
+  return 0;
+}
+
+/* compute the medians over the nrows segments starting at samples start,
+ * start + stride, ... of each frequency bin of their modified periodograms;
+ * the periodogram of each segment is computed once, and the periodograms
+ * are then transposed one block of bins at a time by BIN_MEDIANS_FUNCTION */
+static int SEGMENT_MEDIANS_FUNCTION(
+    REAL_TYPE                   *medians,
+    const TIME_SERIES_TYPE      *tseries,
+    UINT4                        nrows,
+    UINT4                        start,
+    UINT4                        seglen,
+    UINT4                        stride,
+    const WINDOW_TYPE           *window,
+    const PLAN_TYPE             *plan
+    )
+{
+  const UINT4 numbin = seglen/2 + 1;
+  REAL_VECTOR_SEQUENCE_TYPE *work; /* workspace: the periodograms of all segments */
+  REAL_TYPE **rows; /* array of pointers to the periodograms */
+  UINT4 seg;
+  int code;
+
+  work = CREATE_SEQUENCE_FUNCTION( nrows, numbin );
+  rows = XLALMalloc( nrows * sizeof( *rows ) );
+  if ( ! work || ! rows )
+  {
+    DESTROY_SEQUENCE_FUNCTION( work );
+    XLALFree( rows );
+    XLAL_ERROR( XLAL_ENOMEM );
+  }
+
+  code = SEGMENT_PERIODOGRAMS_FUNCTION( work, tseries, start, seglen, stride, window, plan );
+  if ( code != XLAL_FAILURE )
+  {
+    for ( seg = 0; seg < nrows; ++seg )
+      rows[seg] = work->data + seg * numbin;
+    code = BIN_MEDIANS_FUNCTION( medians, rows, nrows, numbin );
+  }
+
+  XLALFree( rows );
+  DESTROY_SEQUENCE_FUNCTION( work );
+  if ( code == XLAL_FAILURE )
+    XLAL_ERROR( XLAL_EFUNC );
+
+  return 0;
+}
+
+#undef CONCAT2x
+#undef CONCAT2
+#undef CONCAT3x
+#undef CONCAT3
+
+#undef REAL_TYPE
+
+#undef REAL_VECTOR_SEQUENCE_TYPE
+#undef TIME_SERIES_TYPE
+#undef WINDOW_TYPE
+#undef PLAN_TYPE
+
+#undef CREATE_SEQUENCE_FUNCTION
+#undef DESTROY_SEQUENCE_FUNCTION
+#undef SEGMENT_PERIODOGRAMS_FUNCTION
+#undef MEDIAN_FUNCTION
+#undef BIN_MEDIANS_FUNCTION
+#undef SEGMENT_MEDIANS_FUNCTION
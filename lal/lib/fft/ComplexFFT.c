@@ -23,6 +23,10 @@
 #include <fftw3.h>
 #include <string.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <lal/AVFactories.h>
 #include <lal/ComplexFFT.h>
 #include <lal/FFTWMutex.h>
@@ -30,6 +34,8 @@
 #include <lal/LALMalloc.h>
 #include <lal/XLALError.h>
 
+#include "FFTWWisdom_internal.h"
+
 /**
  * \addtogroup ComplexFFT_h
  *
@@ -127,6 +133,10 @@ tagCOMPLEX8FFTPlan
   INT4       sign; /**< sign in transform exponential, -1 for forward, +1 for reverse */
   UINT4      size; /**< length of the complex data vector for this plan */
   fftwf_plan plan; /**< the FFTW plan */
+  UINT4      howmany; /**< number of transforms performed by a batched plan, or 0 for a plan of a single transform */
+  UINT4      stride; /**< for a batched plan, the distance between successive elements of each transform (1 if each transform is contiguous) */
+  UINT4      blocksize; /**< for a batched plan, the number of transforms performed by each execution of \c plan */
+  fftwf_plan tailplan; /**< for a batched plan, the FFTW plan for a final, smaller block of transforms, if needed */
 };
 
 /**
@@ -138,6 +148,10 @@ tagCOMPLEX16FFTPlan
   INT4       sign; /**< sign in transform exponential, -1 for forward, +1 for reverse */
   UINT4      size; /**< length of the complex data vector for this plan */
   fftw_plan  plan; /**< the FFTW plan */
+  UINT4      howmany; /**< number of transforms performed by a batched plan, or 0 for a plan of a single transform */
+  UINT4      stride; /**< for a batched plan, the distance between successive elements of each transform (1 if each transform is contiguous) */
+  UINT4      blocksize; /**< for a batched plan, the number of transforms performed by each execution of \c plan */
+  fftw_plan  tailplan; /**< for a batched plan, the FFTW plan for a final, smaller block of transforms, if needed */
 };
 
 /* single- and double-precision routines */
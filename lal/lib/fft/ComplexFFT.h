@@ -222,6 +222,72 @@ void XLALDestroyCOMPLEX8FFTPlan( COMPLEX8FFTPlan *plan );
  */
 int XLALCOMPLEX8VectorFFT( COMPLEX8Vector * _LAL_RESTRICT_ output, const COMPLEX8Vector * _LAL_RESTRICT_ input, const COMPLEX8FFTPlan *plan );
 
+/**
+ * Returns a new COMPLEX8FFTPlan for performing many transforms at once
+ *
+ * The plan performs \c howmany forward or reverse transforms of complex
+ * data vectors of length \c size, which are either stored contiguously one
+ * after another (\c stride equal to 1), or interleaved in the columns of a
+ * row-major array with rows of length \c stride.  If LAL has been compiled
+ * with OpenMP support the transforms are divided between the available
+ * threads.  The resulting plan may only be used with
+ * XLALCOMPLEX8VectorFFTMany(), and is destroyed with
+ * XLALDestroyCOMPLEX8FFTPlan().  Batched transforms are only available with
+ * the FFTW backend.
+ *
+ * @param[in] size The number of points in each complex data vector.
+ * @param[in] howmany The number of transforms to perform.
+ * @param[in] stride Set to 1 if each transform is contiguous; otherwise
+ * the distance between successive elements of each transform, which must
+ * be at least \c howmany.
+ * @param[in] fwdflg Set non-zero for a forward FFT plan;
+ * otherwise create a reverse plan
+ * @param[in] measurelvl Measurement level for plan creation:
+ * - 0: no measurement, just estimate the plan;
+ * - 1: measure the best plan;
+ * - 2: perform a lengthy measurement of the best plan;
+ * - 3: perform an exhasutive measurement of the best plan.
+ * @return A pointer to an allocated \c COMPLEX8FFTPlan structure is returned
+ * upon successful completion.  Otherwise, a \c NULL pointer is returned
+ * and \c xlalErrno is set to indicate the error.
+ * @par Errors:
+ * The \c XLALCreateCOMPLEX8FFTPlanMany() function shall fail if:
+ * - [\c XLAL_EBADLEN] The size of the requested plan, or the number of
+ * transforms, is 0.
+ * - [\c XLAL_EINVAL] The stride is neither 1 nor at least \c howmany.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * - [\c XLAL_EFAILED] The call to the underlying FFTW routine failed.
+ * .
+ */
+COMPLEX8FFTPlan * XLALCreateCOMPLEX8FFTPlanMany( UINT4 size, UINT4 howmany, UINT4 stride, int fwdflg, int measurelvl );
+
+/**
+ * Performs many complex-to-complex FFTs at once
+ *
+ * This routine performs the same transforms as XLALCOMPLEX8VectorFFT() on
+ * each of the \c howmany data vectors described by the plan.  If the plan
+ * stride is 1 then each vector of the \c input sequence is transformed
+ * into the corresponding vector of the \c output sequence; otherwise the
+ * columns of the sequences are transformed.
+ *
+ * @param[out] output The complex output data sequence.
+ * @param[in] input The complex input data sequence: either \c howmany
+ * vectors of length \c size, or \c size vectors of length \c stride.
+ * @param[in] plan The batched FFT plan to use, created by
+ * XLALCreateCOMPLEX8FFTPlanMany().
+ * @retval 0 Success.
+ * @retval #XLAL_FAILURE Failure.
+ * @par Errors:
+ * The \c XLALCOMPLEX8VectorFFTMany() function shall fail if:
+ * - [\c XLAL_EFAULT] A \c NULL pointer is provided as one of the arguments.
+ * - [\c XLAL_EINVAL] A argument is invalid, the plan is not a batched
+ * plan, or the input and output data are the same.
+ * - [\c XLAL_EBADLEN] The input sequence, output sequence, and plan are
+ * incompatible.
+ * .
+ */
+int XLALCOMPLEX8VectorFFTMany( COMPLEX8VectorSequence * _LAL_RESTRICT_ output, const COMPLEX8VectorSequence * _LAL_RESTRICT_ input, const COMPLEX8FFTPlan *plan );
+
 /*
  *
  * XLAL COMPLEX16 functions
@@ -358,6 +424,72 @@ void XLALDestroyCOMPLEX16FFTPlan( COMPLEX16FFTPlan *plan );
  */
 int XLALCOMPLEX16VectorFFT( COMPLEX16Vector * _LAL_RESTRICT_ output, const COMPLEX16Vector * _LAL_RESTRICT_ input, const COMPLEX16FFTPlan *plan );
 
+/**
+ * Returns a new COMPLEX16FFTPlan for performing many transforms at once
+ *
+ * The plan performs \c howmany forward or reverse transforms of complex
+ * data vectors of length \c size, which are either stored contiguously one
+ * after another (\c stride equal to 1), or interleaved in the columns of a
+ * row-major array with rows of length \c stride.  If LAL has been compiled
+ * with OpenMP support the transforms are divided between the available
+ * threads.  The resulting plan may only be used with
+ * XLALCOMPLEX16VectorFFTMany(), and is destroyed with
+ * XLALDestroyCOMPLEX16FFTPlan().  Batched transforms are only available with
+ * the FFTW backend.
+ *
+ * @param[in] size The number of points in each complex data vector.
+ * @param[in] howmany The number of transforms to perform.
+ * @param[in] stride Set to 1 if each transform is contiguous; otherwise
+ * the distance between successive elements of each transform, which must
+ * be at least \c howmany.
+ * @param[in] fwdflg Set non-zero for a forward FFT plan;
+ * otherwise create a reverse plan
+ * @param[in] measurelvl Measurement level for plan creation:
+ * - 0: no measurement, just estimate the plan;
+ * - 1: measure the best plan;
+ * - 2: perform a lengthy measurement of the best plan;
+ * - 3: perform an exhasutive measurement of the best plan.
+ * @return A pointer to an allocated \c COMPLEX16FFTPlan structure is returned
+ * upon successful completion.  Otherwise, a \c NULL pointer is returned
+ * and \c xlalErrno is set to indicate the error.
+ * @par Errors:
+ * The \c XLALCreateCOMPLEX16FFTPlanMany() function shall fail if:
+ * - [\c XLAL_EBADLEN] The size of the requested plan, or the number of
+ * transforms, is 0.
+ * - [\c XLAL_EINVAL] The stride is neither 1 nor at least \c howmany.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * - [\c XLAL_EFAILED] The call to the underlying FFTW routine failed.
+ * .
+ */
+COMPLEX16FFTPlan * XLALCreateCOMPLEX16FFTPlanMany( UINT4 size, UINT4 howmany, UINT4 stride, int fwdflg, int measurelvl );
+
+/**
+ * Performs many complex-to-complex FFTs at once
+ *
+ * This routine performs the same transforms as XLALCOMPLEX16VectorFFT() on
+ * each of the \c howmany data vectors described by the plan.  If the plan
+ * stride is 1 then each vector of the \c input sequence is transformed
+ * into the corresponding vector of the \c output sequence; otherwise the
+ * columns of the sequences are transformed.
+ *
+ * @param[out] output The complex output data sequence.
+ * @param[in] input The complex input data sequence: either \c howmany
+ * vectors of length \c size, or \c size vectors of length \c stride.
+ * @param[in] plan The batched FFT plan to use, created by
+ * XLALCreateCOMPLEX16FFTPlanMany().
+ * @retval 0 Success.
+ * @retval #XLAL_FAILURE Failure.
+ * @par Errors:
+ * The \c XLALCOMPLEX16VectorFFTMany() function shall fail if:
+ * - [\c XLAL_EFAULT] A \c NULL pointer is provided as one of the arguments.
+ * - [\c XLAL_EINVAL] A argument is invalid, the plan is not a batched
+ * plan, or the input and output data are the same.
+ * - [\c XLAL_EBADLEN] The input sequence, output sequence, and plan are
+ * incompatible.
+ * .
+ */
+int XLALCOMPLEX16VectorFFTMany( COMPLEX16VectorSequence * _LAL_RESTRICT_ output, const COMPLEX16VectorSequence * _LAL_RESTRICT_ input, const COMPLEX16FFTPlan *plan );
+
 /** @} */
 
 #if 0
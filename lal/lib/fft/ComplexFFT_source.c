@@ -14,16 +14,20 @@
 
 #define PLAN_TYPE			CONCAT2(COMPLEX_TYPE,FFTPlan)
 #define COMPLEX_VECTOR_TYPE		CONCAT2(COMPLEX_TYPE,Vector)
+#define COMPLEX_VECTOR_SEQUENCE_TYPE	CONCAT2(COMPLEX_TYPE,VectorSequence)
 
 #define CREATE_PLAN_FUNCTION		CONCAT2(XLALCreate,PLAN_TYPE)
 #define CREATE_FORWARD_PLAN_FUNCTION	CONCAT2(XLALCreateForward,PLAN_TYPE)
 #define CREATE_REVERSE_PLAN_FUNCTION	CONCAT2(XLALCreateReverse,PLAN_TYPE)
 #define DESTROY_PLAN_FUNCTION		CONCAT2(XLALDestroy,PLAN_TYPE)
 #define VECTOR_FFT_FUNCTION		CONCAT3(XLAL,COMPLEX_VECTOR_TYPE,FFT)
+#define CREATE_MANY_PLAN_FUNCTION	CONCAT3(XLALCreate,PLAN_TYPE,Many)
+#define VECTOR_MANY_FFT_FUNCTION	CONCAT3(XLAL,COMPLEX_VECTOR_TYPE,FFTMany)
 
 #define FFTWX				CONCAT2(fftw,TYPESUFFIX)
 #define FFTWX_COMPLEX			CONCAT2(FFTWX,_complex)
 #define FFTWX_PLAN_DFT_1D		CONCAT2(FFTWX,_plan_dft_1d)
+#define FFTWX_PLAN_MANY_DFT		CONCAT2(FFTWX,_plan_many_dft)
 #define FFTWX_DESTROY_PLAN		CONCAT2(FFTWX,_destroy_plan)
 #define FFTWX_EXECUTE_DFT		CONCAT2(FFTWX,_execute_dft)
 
@@ -87,11 +91,14 @@ PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
     }
 #   endif
 
-    /* establish fftw mutex lock and create plan */
+    /* establish fftw mutex lock, import any stored wisdom, and create plan */
 
     LAL_FFTW_WISDOM_LOCK;
+    XLALFFTWWisdomAutoImport();
     plan->plan =
         FFTWX_PLAN_DFT_1D(size, (FFTWX_COMPLEX *) tmp1, (FFTWX_COMPLEX *) tmp2, fwdflg ? FFTW_FORWARD : FFTW_BACKWARD, flags);
+    if (plan->plan)
+        XLALFFTWWisdomMarkModified(measurelvl);
     LAL_FFTW_WISDOM_UNLOCK;
 
     /* free the temporary arrays */
@@ -115,6 +122,10 @@ PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
 
     plan->size = size;
     plan->sign = (fwdflg ? -1 : 1);
+    plan->howmany = 0;
+    plan->stride = 1;
+    plan->blocksize = 0;
+    plan->tailplan = NULL;
 
     return plan;
 }
@@ -140,9 +151,12 @@ PLAN_TYPE *CREATE_REVERSE_PLAN_FUNCTION(UINT4 size, int measurelvl)
 void DESTROY_PLAN_FUNCTION(PLAN_TYPE * plan)
 {
     if (plan) {
-        if (plan->plan) {
+        if (plan->plan || plan->tailplan) {
             LAL_FFTW_WISDOM_LOCK;
-            FFTWX_DESTROY_PLAN(plan->plan);
+            if (plan->plan)
+                FFTWX_DESTROY_PLAN(plan->plan);
+            if (plan->tailplan)
+                FFTWX_DESTROY_PLAN(plan->tailplan);
             LAL_FFTW_WISDOM_UNLOCK;
         }
         memset(plan, 0, sizeof(*plan));
@@ -160,7 +174,7 @@ int VECTOR_FFT_FUNCTION(COMPLEX_VECTOR_TYPE * _LAL_RESTRICT_ output, const COMPL
 
     if (!output || !input || !plan)
         XLAL_ERROR(XLAL_EFAULT);
-    if (!plan->plan || !plan->size)
+    if (!plan->plan || !plan->size || plan->howmany)
         XLAL_ERROR(XLAL_EINVAL);
     if (!output->data || !input->data || output->data == input->data)
         XLAL_ERROR(XLAL_EINVAL);        /* note: must be out-of-place */
@@ -209,6 +223,148 @@ int VECTOR_FFT_FUNCTION(COMPLEX_VECTOR_TYPE * _LAL_RESTRICT_ output, const COMPL
     return 0;
 }
 
+PLAN_TYPE *CREATE_MANY_PLAN_FUNCTION(UINT4 size, UINT4 howmany, UINT4 stride, int fwdflg, int measurelvl)
+{
+    PLAN_TYPE *plan;
+    COMPLEX_TYPE *tmp1;
+    COMPLEX_TYPE *tmp2;
+    UINT4 nblocks;
+    UINT4 blocksize;
+    UINT4 tailsize;
+    size_t nbytes;
+    int n = size;
+    int dist;
+    int sign;
+    int flags;
+
+    if (!size || !howmany)
+        XLAL_ERROR_NULL(XLAL_EBADLEN);
+    if (stride != 1 && stride < howmany)
+        XLAL_ERROR_NULL(XLAL_EINVAL);
+
+    /* set fftw3 flags to perform requested degree of measurement; the
+     * transforms of a block do not in general start on aligned memory */
+
+    flags = FFTW_UNALIGNED;
+
+    switch (measurelvl) {
+    case 0:    /* estimate */
+        flags |= FFTW_ESTIMATE;
+        break;
+    default:   /* exhaustive measurement */
+        flags |= FFTW_EXHAUSTIVE;
+        /* fall-through */
+    case 2:    /* lengthy measurement */
+        flags |= FFTW_PATIENT;
+        /* fall-through */
+    case 1:    /* measure the best plan */
+        flags |= FFTW_MEASURE;
+        break;
+    }
+
+    /* divide the transforms into one block per thread */
+
+#   ifdef _OPENMP
+    nblocks = omp_get_max_threads();
+    if (nblocks > howmany)
+        nblocks = howmany;
+#   else
+    nblocks = 1;
+#   endif
+    blocksize = (howmany + nblocks - 1) / nblocks;
+    tailsize = howmany % blocksize;
+
+    /* distance between the first elements of successive transforms */
+
+    dist = (stride == 1) ? (int) size : 1;
+    sign = fwdflg ? FFTW_FORWARD : FFTW_BACKWARD;
+
+    /* allocate memory for the plan and the temporary arrays */
+
+    nbytes = size * (stride == 1 ? blocksize : stride) * sizeof(COMPLEX_TYPE);
+    plan = XLALMalloc(sizeof(*plan));
+    tmp1 = XLALMalloc(nbytes);
+    tmp2 = XLALMalloc(nbytes);
+    if (!plan || !tmp1 || !tmp2) {
+        XLALFree(plan);
+        XLALFree(tmp1);
+        XLALFree(tmp2);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+
+    /* establish fftw mutex lock, import any stored wisdom, and create plans */
+
+    LAL_FFTW_WISDOM_LOCK;
+    XLALFFTWWisdomAutoImport();
+    plan->plan = FFTWX_PLAN_MANY_DFT(1, &n, blocksize, (FFTWX_COMPLEX *) tmp1, NULL, stride, dist, (FFTWX_COMPLEX *) tmp2, NULL, stride, dist, sign, flags);
+    plan->tailplan = tailsize ? FFTWX_PLAN_MANY_DFT(1, &n, tailsize, (FFTWX_COMPLEX *) tmp1, NULL, stride, dist, (FFTWX_COMPLEX *) tmp2, NULL, stride, dist, sign, flags) : NULL;
+    if (plan->plan)
+        XLALFFTWWisdomMarkModified(measurelvl);
+    LAL_FFTW_WISDOM_UNLOCK;
+
+    /* free the temporary arrays */
+
+    XLALFree(tmp1);
+    XLALFree(tmp2);
+
+    /* set plan fields and check to see success of plan creation */
+
+    plan->size = size;
+    plan->sign = (fwdflg ? -1 : 1);
+    plan->howmany = howmany;
+    plan->stride = stride;
+    plan->blocksize = blocksize;
+
+    if (!plan->plan || (tailsize && !plan->tailplan)) {
+        DESTROY_PLAN_FUNCTION(plan);
+        XLAL_ERROR_NULL(XLAL_EFAILED);
+    }
+
+    return plan;
+}
+
+int VECTOR_MANY_FFT_FUNCTION(COMPLEX_VECTOR_SEQUENCE_TYPE * _LAL_RESTRICT_ output, const COMPLEX_VECTOR_SEQUENCE_TYPE * _LAL_RESTRICT_ input,
+    const PLAN_TYPE * plan)
+{
+    UINT4 dist;
+    UINT4 nblocks;
+    int b;
+
+    /* sanity check on arguments */
+
+    if (!output || !input || !plan)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (!plan->plan || !plan->size || !plan->howmany)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (!output->data || !input->data || output->data == input->data)
+        XLAL_ERROR(XLAL_EINVAL);        /* note: must be out-of-place */
+    if (output->length != input->length || output->vectorLength != input->vectorLength)
+        XLAL_ERROR(XLAL_EBADLEN);
+    if (plan->stride == 1) {
+        if (input->length != plan->howmany || input->vectorLength != plan->size)
+            XLAL_ERROR(XLAL_EBADLEN);
+    } else {
+        if (input->length != plan->size || input->vectorLength != plan->stride)
+            XLAL_ERROR(XLAL_EBADLEN);
+    }
+
+    dist = (plan->stride == 1) ? plan->size : 1;
+    nblocks = (plan->howmany + plan->blocksize - 1) / plan->blocksize;
+
+    /* perform the ffts, one block of transforms per thread */
+
+#   pragma omp parallel for
+    for (b = 0; b < (int) nblocks; ++b) {
+        const size_t first = (size_t) b * plan->blocksize * dist;
+        if ((UINT4) b + 1 == nblocks && plan->tailplan)
+            FFTWX_EXECUTE_DFT(plan->tailplan, (FFTWX_COMPLEX *) (input->data + first), (FFTWX_COMPLEX *) (output->data + first));
+        else
+            FFTWX_EXECUTE_DFT(plan->plan, (FFTWX_COMPLEX *) (input->data + first), (FFTWX_COMPLEX *) (output->data + first));
+    }
+
+    return 0;
+}
+
 #undef CONCAT2x
 #undef CONCAT2
 #undef CONCAT3x
@@ -220,15 +376,19 @@ int VECTOR_FFT_FUNCTION(COMPLEX_VECTOR_TYPE * _LAL_RESTRICT_ output, const COMPL
 
 #undef PLAN_TYPE
 #undef COMPLEX_VECTOR_TYPE
+#undef COMPLEX_VECTOR_SEQUENCE_TYPE
 
 #undef CREATE_PLAN_FUNCTION
 #undef CREATE_FORWARD_PLAN_FUNCTION
 #undef CREATE_REVERSE_PLAN_FUNCTION
 #undef DESTROY_PLAN_FUNCTION
 #undef VECTOR_FFT_FUNCTION
+#undef CREATE_MANY_PLAN_FUNCTION
+#undef VECTOR_MANY_FFT_FUNCTION
 
 #undef FFTWX
 #undef FFTWX_COMPLEX
 #undef FFTWX_PLAN_DFT_1D
+#undef FFTWX_PLAN_MANY_DFT
 #undef FFTWX_DESTROY_PLAN
 #undef FFTWX_EXECUTE_DFT
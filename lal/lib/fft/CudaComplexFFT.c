@@ -292,3 +292,30 @@ int XLALCOMPLEX16VectorFFT( COMPLEX16Vector * _LAL_RESTRICT_ output, const COMPL
       );
   return 0;
 }
+
+
+/*
+ *
+ * Batched transforms: not implemented with the CUDA backend
+ *
+ */
+
+COMPLEX8FFTPlan * XLALCreateCOMPLEX8FFTPlanMany( UNUSED UINT4 size, UNUSED UINT4 howmany, UNUSED UINT4 stride, UNUSED int fwdflg, UNUSED int measurelvl )
+{
+  XLAL_ERROR_NULL( XLAL_EFAILED, "Batched FFTs are not supported by the CUDA FFT backend" );
+}
+
+int XLALCOMPLEX8VectorFFTMany( UNUSED COMPLEX8VectorSequence * _LAL_RESTRICT_ output, UNUSED const COMPLEX8VectorSequence * _LAL_RESTRICT_ input, UNUSED const COMPLEX8FFTPlan *plan )
+{
+  XLAL_ERROR( XLAL_EFAILED, "Batched FFTs are not supported by the CUDA FFT backend" );
+}
+
+COMPLEX16FFTPlan * XLALCreateCOMPLEX16FFTPlanMany( UNUSED UINT4 size, UNUSED UINT4 howmany, UNUSED UINT4 stride, UNUSED int fwdflg, UNUSED int measurelvl )
+{
+  XLAL_ERROR_NULL( XLAL_EFAILED, "Batched FFTs are not supported by the CUDA FFT backend" );
+}
+
+int XLALCOMPLEX16VectorFFTMany( UNUSED COMPLEX16VectorSequence * _LAL_RESTRICT_ output, UNUSED const COMPLEX16VectorSequence * _LAL_RESTRICT_ input, UNUSED const COMPLEX16FFTPlan *plan )
+{
+  XLAL_ERROR( XLAL_EFAILED, "Batched FFTs are not supported by the CUDA FFT backend" );
+}
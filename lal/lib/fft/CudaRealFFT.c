@@ -634,3 +634,40 @@ int XLALREAL8PowerSpectrum( REAL8Vector *spec, const REAL8Vector *data,
   XLALFree( tmp );
   return 0;
 }
+
+
+/*
+ *
+ * Batched transforms: not implemented with the CUDA backend
+ *
+ */
+
+REAL4FFTPlan * XLALCreateREAL4FFTPlanMany( UNUSED UINT4 size, UNUSED UINT4 howmany, UNUSED UINT4 stride, UNUSED int fwdflg, UNUSED int measurelvl )
+{
+  XLAL_ERROR_NULL( XLAL_EFAILED, "Batched FFTs are not supported by the CUDA FFT backend" );
+}
+
+int XLALREAL4ForwardFFTMany( UNUSED COMPLEX8VectorSequence *output, UNUSED const REAL4VectorSequence *input, UNUSED const REAL4FFTPlan *plan )
+{
+  XLAL_ERROR( XLAL_EFAILED, "Batched FFTs are not supported by the CUDA FFT backend" );
+}
+
+int XLALREAL4ReverseFFTMany( UNUSED REAL4VectorSequence *output, UNUSED const COMPLEX8VectorSequence *input, UNUSED const REAL4FFTPlan *plan )
+{
+  XLAL_ERROR( XLAL_EFAILED, "Batched FFTs are not supported by the CUDA FFT backend" );
+}
+
+REAL8FFTPlan * XLALCreateREAL8FFTPlanMany( UNUSED UINT4 size, UNUSED UINT4 howmany, UNUSED UINT4 stride, UNUSED int fwdflg, UNUSED int measurelvl )
+{
+  XLAL_ERROR_NULL( XLAL_EFAILED, "Batched FFTs are not supported by the CUDA FFT backend" );
+}
+
+int XLALREAL8ForwardFFTMany( UNUSED COMPLEX16VectorSequence *output, UNUSED const REAL8VectorSequence *input, UNUSED const REAL8FFTPlan *plan )
+{
+  XLAL_ERROR( XLAL_EFAILED, "Batched FFTs are not supported by the CUDA FFT backend" );
+}
+
+int XLALREAL8ReverseFFTMany( UNUSED REAL8VectorSequence *output, UNUSED const COMPLEX16VectorSequence *input, UNUSED const REAL8FFTPlan *plan )
+{
+  XLAL_ERROR( XLAL_EFAILED, "Batched FFTs are not supported by the CUDA FFT backend" );
+}
@@ -0,0 +1,78 @@
+/*
+*  Copyright (C) 2026
+*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+*  MA  02111-1307  USA
+*/
+
+#include <config.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALConfig.h>
+#include <lal/RealFFT.h>
+#include <lal/ComplexFFT.h>
+#include <lal/FFTPlanCache.h>
+#include <lal/XLALError.h>
+
+#if defined(LAL_PTHREAD_LOCK)
+#include <pthread.h>
+static pthread_mutex_t lalFFTPlanCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+# define LAL_FFT_PLAN_CACHE_LOCK pthread_mutex_lock( &lalFFTPlanCacheMutex )
+# define LAL_FFT_PLAN_CACHE_UNLOCK pthread_mutex_unlock( &lalFFTPlanCacheMutex )
+#else
+# define LAL_FFT_PLAN_CACHE_LOCK
+# define LAL_FFT_PLAN_CACHE_UNLOCK
+#endif
+
+/**
+ * \addtogroup FFTPlanCache_h
+ * @{
+ */
+
+#define DATA_TYPE REAL4
+#include "FFTPlanCache_source.c"
+#undef DATA_TYPE
+
+#define DATA_TYPE REAL8
+#include "FFTPlanCache_source.c"
+#undef DATA_TYPE
+
+#define DATA_TYPE COMPLEX8
+#include "FFTPlanCache_source.c"
+#undef DATA_TYPE
+
+#define DATA_TYPE COMPLEX16
+#include "FFTPlanCache_source.c"
+#undef DATA_TYPE
+
+/**
+ * Destroys all plans in the FFT plan cache which are not currently in use,
+ * e.g. to free memory, or before checking for memory leaks.  Plans which
+ * are still in use are left in the cache, and a warning is printed.
+ */
+void XLALClearFFTPlanCache(void)
+{
+    UINT4 in_use = 0;
+    LAL_FFT_PLAN_CACHE_LOCK;
+    in_use += clear_REAL4_plans();
+    in_use += clear_REAL8_plans();
+    in_use += clear_COMPLEX8_plans();
+    in_use += clear_COMPLEX16_plans();
+    LAL_FFT_PLAN_CACHE_UNLOCK;
+    if (in_use > 0)
+        XLAL_PRINT_WARNING("%u cached FFT plans are still in use", in_use);
+}
+
+/** @} */
@@ -0,0 +1,101 @@
+/*
+*  Copyright (C) 2026
+*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+*  MA  02111-1307  USA
+*/
+
+#ifndef _FFTPLANCACHE_H
+#define _FFTPLANCACHE_H
+
+#include <lal/LALDatatypes.h>
+#include <lal/RealFFT.h>
+#include <lal/ComplexFFT.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#elif 0
+} /* so that editors will match preceding brace */
+#endif
+
+/**
+ * \defgroup FFTPlanCache_h Header FFTPlanCache.h
+ * \ingroup lal_fft
+ * \brief Process-wide cache of shared FFT plans.
+ *
+ * ### Synopsis ###
+ *
+ * \code
+ * #include <lal/FFTPlanCache.h>
+ * \endcode
+ *
+ * Routines which repeatedly create and destroy plans for transforms of the
+ * same size pay the cost of planning each time, and routines running in
+ * different threads hold duplicate copies of identical plans.  The routines
+ * in this package instead share a single plan for each combination of
+ * transform size, direction, precision, and measurement level between all
+ * users in a process.
+ *
+ * XLALGetCachedREAL8FFTPlan() (and its analogues for other types) returns
+ * a plan from the cache, creating it with XLALCreateREAL8FFTPlan() if no
+ * such plan exists, and increments its reference count.  The plan must not
+ * be modified or destroyed with XLALDestroyREAL8FFTPlan(); instead, when
+ * it is no longer needed it must be returned to the cache with
+ * XLALReleaseCachedREAL8FFTPlan().  Plans for batches of transforms are
+ * obtained in the same way with XLALGetCachedREAL8FFTPlanMany(), which takes
+ * the arguments of XLALCreateREAL8FFTPlanMany(), and are released with
+ * XLALReleaseCachedREAL8FFTPlan().  Plans which are no longer in use
+ * remain in the cache so that they can be returned by later requests
+ * without re-planning; they are only destroyed by XLALClearFFTPlanCache().
+ *
+ * Since executing a plan does not modify it, a plan returned by the cache
+ * may be used concurrently by any number of threads.  All routines in this
+ * package are thread-safe if LAL has been compiled with pthread support.
+ *
+ * ### Operating Instructions ###
+ *
+ * \code
+ * REAL8FFTPlan *plan = XLALGetCachedREAL8FFTPlan( n, 1, 1 );
+ *
+ * XLALREAL8ForwardFFT( output, input, plan );
+ *
+ * XLALReleaseCachedREAL8FFTPlan( plan );
+ * \endcode
+ */
+/** @{ */
+
+REAL4FFTPlan * XLALGetCachedREAL4FFTPlan( UINT4 size, int fwdflg, int measurelvl );
+REAL4FFTPlan * XLALGetCachedREAL4FFTPlanMany( UINT4 size, UINT4 howmany, UINT4 stride, int fwdflg, int measurelvl );
+void XLALReleaseCachedREAL4FFTPlan( REAL4FFTPlan *plan );
+REAL8FFTPlan * XLALGetCachedREAL8FFTPlan( UINT4 size, int fwdflg, int measurelvl );
+REAL8FFTPlan * XLALGetCachedREAL8FFTPlanMany( UINT4 size, UINT4 howmany, UINT4 stride, int fwdflg, int measurelvl );
+void XLALReleaseCachedREAL8FFTPlan( REAL8FFTPlan *plan );
+COMPLEX8FFTPlan * XLALGetCachedCOMPLEX8FFTPlan( UINT4 size, int fwdflg, int measurelvl );
+COMPLEX8FFTPlan * XLALGetCachedCOMPLEX8FFTPlanMany( UINT4 size, UINT4 howmany, UINT4 stride, int fwdflg, int measurelvl );
+void XLALReleaseCachedCOMPLEX8FFTPlan( COMPLEX8FFTPlan *plan );
+COMPLEX16FFTPlan * XLALGetCachedCOMPLEX16FFTPlan( UINT4 size, int fwdflg, int measurelvl );
+COMPLEX16FFTPlan * XLALGetCachedCOMPLEX16FFTPlanMany( UINT4 size, UINT4 howmany, UINT4 stride, int fwdflg, int measurelvl );
+void XLALReleaseCachedCOMPLEX16FFTPlan( COMPLEX16FFTPlan *plan );
+void XLALClearFFTPlanCache( void );
+
+/** @} */
+
+#if 0
+{ /* so that editors will match succeeding brace */
+#elif defined(__cplusplus)
+}
+#endif
+
+#endif /* _FFTPLANCACHE_H */
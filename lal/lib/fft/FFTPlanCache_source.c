@@ -0,0 +1,186 @@
+#define CONCAT2x(a,b) a##b
+#define CONCAT2(a,b) CONCAT2x(a,b)
+#define CONCAT3x(a,b,c) a##b##c
+#define CONCAT3(a,b,c) CONCAT3x(a,b,c)
+
+#define PLAN_TYPE			CONCAT2(DATA_TYPE,FFTPlan)
+#define CACHE_ENTRY_TYPE		CONCAT2(DATA_TYPE,FFTPlanCacheEntry)
+#define CACHE_LIST			CONCAT3(cached_,DATA_TYPE,_plans)
+
+#define CREATE_PLAN_FUNCTION		CONCAT2(XLALCreate,PLAN_TYPE)
+#define CREATE_PLAN_MANY_FUNCTION	CONCAT3(XLALCreate,PLAN_TYPE,Many)
+#define DESTROY_PLAN_FUNCTION		CONCAT2(XLALDestroy,PLAN_TYPE)
+#define GET_CACHED_PLAN_FUNCTION	CONCAT2(XLALGetCached,PLAN_TYPE)
+#define GET_CACHED_PLAN_MANY_FUNCTION	CONCAT3(XLALGetCached,PLAN_TYPE,Many)
+#define GET_CACHED_ENTRY_FUNCTION	CONCAT3(get_cached_,DATA_TYPE,_plan)
+#define RELEASE_CACHED_PLAN_FUNCTION	CONCAT2(XLALReleaseCached,PLAN_TYPE)
+#define CLEAR_CACHE_FUNCTION		CONCAT3(clear_,DATA_TYPE,_plans)
+
+typedef struct CONCAT2(tag,CACHE_ENTRY_TYPE) {
+    struct CONCAT2(tag,CACHE_ENTRY_TYPE) *next;
+    UINT4 size;
+    UINT4 howmany; /* zero for plans of a single transform */
+    UINT4 stride;
+    int fwdflg;
+    int measurelvl;
+    UINT4 refcount;
+    PLAN_TYPE *plan;
+} CACHE_ENTRY_TYPE;
+
+/* list of cached plans; protected by the plan cache lock */
+static CACHE_ENTRY_TYPE *CACHE_LIST = NULL;
+
+/* returns the cached plan for the given arguments, creating it if
+ * necessary, and increments its reference count; howmany is zero for a plan
+ * of a single transform, and otherwise the arguments are as for the batched
+ * plan constructor */
+static PLAN_TYPE *GET_CACHED_ENTRY_FUNCTION(UINT4 size, UINT4 howmany, UINT4 stride, int fwdflg, int measurelvl)
+{
+    CACHE_ENTRY_TYPE *entry;
+
+    if (!size)
+        XLAL_ERROR_NULL(XLAL_EBADLEN);
+
+    /* normalise the arguments so that equivalent plans are shared */
+    fwdflg = fwdflg ? 1 : 0;
+    if (measurelvl < 0 || measurelvl > 3)
+        measurelvl = 3;
+    if (!howmany)
+        stride = 0;
+
+    LAL_FFT_PLAN_CACHE_LOCK;
+
+    for (entry = CACHE_LIST; entry; entry = entry->next)
+        if (entry->size == size && entry->howmany == howmany && entry->stride == stride && entry->fwdflg == fwdflg && entry->measurelvl == measurelvl)
+            break;
+
+    /* plan is not yet cached: create it while holding the lock, so that
+     * concurrent requests for the same plan only plan once */
+    if (!entry) {
+        entry = XLALMalloc(sizeof(*entry));
+        if (!entry) {
+            LAL_FFT_PLAN_CACHE_UNLOCK;
+            XLAL_ERROR_NULL(XLAL_ENOMEM);
+        }
+        if (howmany)
+            entry->plan = CREATE_PLAN_MANY_FUNCTION(size, howmany, stride, fwdflg, measurelvl);
+        else
+            entry->plan = CREATE_PLAN_FUNCTION(size, fwdflg, measurelvl);
+        if (!entry->plan) {
+            XLALFree(entry);
+            LAL_FFT_PLAN_CACHE_UNLOCK;
+            XLAL_ERROR_NULL(XLAL_EFUNC);
+        }
+        entry->size = size;
+        entry->howmany = howmany;
+        entry->stride = stride;
+        entry->fwdflg = fwdflg;
+        entry->measurelvl = measurelvl;
+        entry->refcount = 0;
+        entry->next = CACHE_LIST;
+        CACHE_LIST = entry;
+    }
+
+    ++entry->refcount;
+
+    LAL_FFT_PLAN_CACHE_UNLOCK;
+
+    return entry->plan;
+}
+
+/*
+ * Returns a shared plan from the FFT plan cache, creating it if necessary.
+ * The arguments are as for the corresponding plan constructor.  The plan
+ * must be returned to the cache with the corresponding release function
+ * and must not be destroyed by the caller.
+ */
+PLAN_TYPE *GET_CACHED_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
+{
+    PLAN_TYPE *plan = GET_CACHED_ENTRY_FUNCTION(size, 0, 0, fwdflg, measurelvl);
+    if (!plan)
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    return plan;
+}
+
+/*
+ * Returns a shared plan for \c howmany batched transforms from the FFT plan
+ * cache, creating it if necessary.  The arguments are as for the
+ * corresponding batched plan constructor, and the plan is returned to the
+ * cache with the same release function as other cached plans.
+ */
+PLAN_TYPE *GET_CACHED_PLAN_MANY_FUNCTION(UINT4 size, UINT4 howmany, UINT4 stride, int fwdflg, int measurelvl)
+{
+    PLAN_TYPE *plan;
+    if (!howmany)
+        XLAL_ERROR_NULL(XLAL_EBADLEN);
+    plan = GET_CACHED_ENTRY_FUNCTION(size, howmany, stride, fwdflg, measurelvl);
+    if (!plan)
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    return plan;
+}
+
+/*
+ * Releases a plan obtained from the FFT plan cache.  The plan is kept in the
+ * cache for re-use.  Passing a \c NULL pointer is a no-op.
+ */
+void RELEASE_CACHED_PLAN_FUNCTION(PLAN_TYPE *plan)
+{
+    CACHE_ENTRY_TYPE *entry;
+
+    if (!plan)
+        return;
+
+    LAL_FFT_PLAN_CACHE_LOCK;
+
+    for (entry = CACHE_LIST; entry; entry = entry->next)
+        if (entry->plan == plan)
+            break;
+
+    if (!entry || entry->refcount == 0) {
+        LAL_FFT_PLAN_CACHE_UNLOCK;
+        XLAL_ERROR_VOID(XLAL_EINVAL, "Plan was not obtained from the FFT plan cache");
+    }
+
+    --entry->refcount;
+
+    LAL_FFT_PLAN_CACHE_UNLOCK;
+}
+
+/* destroy all cached plans which are no longer in use, returning the number
+ * of plans which are still in use; must be called while holding the plan
+ * cache lock */
+static UINT4 CLEAR_CACHE_FUNCTION(void)
+{
+    CACHE_ENTRY_TYPE **p = &CACHE_LIST;
+    UINT4 in_use = 0;
+    while (*p) {
+        CACHE_ENTRY_TYPE *entry = *p;
+        if (entry->refcount > 0) {
+            ++in_use;
+            p = &entry->next;
+        } else {
+            *p = entry->next;
+            DESTROY_PLAN_FUNCTION(entry->plan);
+            XLALFree(entry);
+        }
+    }
+    return in_use;
+}
+
+#undef CONCAT2x
+#undef CONCAT2
+#undef CONCAT3x
+#undef CONCAT3
+
+#undef PLAN_TYPE
+#undef CACHE_ENTRY_TYPE
+#undef CACHE_LIST
+
+#undef CREATE_PLAN_FUNCTION
+#undef CREATE_PLAN_MANY_FUNCTION
+#undef DESTROY_PLAN_FUNCTION
+#undef GET_CACHED_PLAN_FUNCTION
+#undef GET_CACHED_PLAN_MANY_FUNCTION
+#undef GET_CACHED_ENTRY_FUNCTION
+#undef RELEASE_CACHED_PLAN_FUNCTION
+#undef CLEAR_CACHE_FUNCTION
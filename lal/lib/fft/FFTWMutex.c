@@ -19,6 +19,8 @@
 
 #include <lal/FFTWMutex.h>
 
+#include "FFTWWisdom_internal.h"
+
 #if defined(LAL_PTHREAD_LOCK) && defined(LAL_FFTW3_ENABLED)
 #include <pthread.h>
 static pthread_mutex_t lalFFTWMutex = PTHREAD_MUTEX_INITIALIZER;
@@ -55,3 +57,18 @@ void XLALFFTWWisdomUnlock(void)
     pthread_mutex_unlock( &lalFFTWMutex );
 #endif
 }
+
+
+/* Acquire LAL's FFTW wisdom lock only if it is not held by another thread;
+ * returns non-zero if the lock was acquired (always, if LAL has been
+ * compiled without pthread support or with an FFT backend other than FFTW).
+ * Used internally where waiting for the lock could deadlock. */
+
+int XLALFFTWWisdomTryLock(void)
+{
+#if defined(LAL_PTHREAD_LOCK) && defined(LAL_FFTW3_ENABLED)
+    return pthread_mutex_trylock( &lalFFTWMutex ) == 0;
+#else
+    return 1;
+#endif
+}
@@ -0,0 +1,385 @@
+/*
+*  Copyright (C) 2026
+*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+*  MA  02111-1307  USA
+*/
+
+#include <config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+
+#include <lal/FFTWMutex.h>
+#include <lal/FFTWWisdom.h>
+#include <lal/LALStdlib.h>
+#include <lal/XLALError.h>
+
+#include "FFTWWisdom_internal.h"
+
+#ifdef LAL_FFTW3_ENABLED
+
+#include <fftw3.h>
+
+#if defined(HAVE_UNISTD_H) && defined(HAVE_FCNTL_H)
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#define LAL_FFTW_WISDOM_FILE_LOCK
+#endif
+
+/* wisdom is kept separately by the double- and single-precision FFTW libraries */
+enum { WISDOM_DOUBLE, WISDOM_SINGLE, WISDOM_MAX };
+static const char *const wisdom_env[WISDOM_MAX] = { "LAL_FFTW_WISDOM", "LAL_FFTWF_WISDOM" };
+
+/* state of the wisdom store; protected by the FFTW wisdom lock */
+static int wisdom_imported = 0;
+static int wisdom_modified = 0;
+static int wisdom_save_at_exit = 0;
+
+static int import_wisdom_from_file(FILE *fp, int prec)
+{
+    return (prec == WISDOM_SINGLE) ? fftwf_import_wisdom_from_file(fp) : fftw_import_wisdom_from_file(fp);
+}
+
+static void export_wisdom_to_file(FILE *fp, int prec)
+{
+    if (prec == WISDOM_SINGLE)
+        fftwf_export_wisdom_to_file(fp);
+    else
+        fftw_export_wisdom_to_file(fp);
+}
+
+#ifdef LAL_FFTW_WISDOM_FILE_LOCK
+
+/* acquire (type = F_RDLCK or F_WRLCK) or release (type = F_UNLCK) a POSIX
+ * advisory lock on an entire file, waiting for other processes if needed */
+static int lock_wisdom_file(int fd, short type)
+{
+    struct flock fl;
+    fl.l_type = type;
+    fl.l_whence = SEEK_SET;
+    fl.l_start = 0;
+    fl.l_len = 0;
+    while (fcntl(fd, F_SETLKW, &fl) == -1) {
+        if (errno != EINTR)
+            return -1;
+    }
+    return 0;
+}
+
+#endif /* LAL_FFTW_WISDOM_FILE_LOCK */
+
+/* import wisdom from a file; must be called while holding the FFTW wisdom
+ * lock; a non-existent file is not an error unless required is set */
+static int import_wisdom(const char *filename, int prec, int required)
+{
+    FILE *fp;
+    int success;
+
+    fp = fopen(filename, "r");
+    if (!fp) {
+        if (errno == ENOENT && !required)
+            return 0;
+        XLAL_ERROR(XLAL_EIO, "Could not open FFTW wisdom file '%s'", filename);
+    }
+
+#   ifdef LAL_FFTW_WISDOM_FILE_LOCK
+    if (lock_wisdom_file(fileno(fp), F_RDLCK) != 0) {
+        fclose(fp);
+        XLAL_ERROR(XLAL_EIO, "Could not lock FFTW wisdom file '%s'", filename);
+    }
+#   endif
+
+    success = import_wisdom_from_file(fp, prec);
+
+    /* closing the file releases the lock */
+    fclose(fp);
+
+    if (!success)
+        XLAL_ERROR(XLAL_EIO, "Could not import FFTW wisdom from '%s'", filename);
+
+    return 0;
+}
+
+/* merge the wisdom in a file with the current wisdom, and write the result
+ * back to the file; must be called while holding the FFTW wisdom lock */
+static int export_wisdom(const char *filename, int prec)
+{
+    FILE *fp;
+
+#   ifdef LAL_FFTW_WISDOM_FILE_LOCK
+    struct stat st;
+    int fd;
+
+    fd = open(filename, O_RDWR | O_CREAT, 0666);
+    if (fd < 0)
+        XLAL_ERROR(XLAL_EIO, "Could not open FFTW wisdom file '%s'", filename);
+    if (lock_wisdom_file(fd, F_WRLCK) != 0) {
+        close(fd);
+        XLAL_ERROR(XLAL_EIO, "Could not lock FFTW wisdom file '%s'", filename);
+    }
+    fp = fdopen(fd, "r+");
+    if (!fp) {
+        close(fd);
+        XLAL_ERROR(XLAL_EIO, "Could not open FFTW wisdom file '%s'", filename);
+    }
+
+    /* merge in any wisdom written by other processes; if the existing file
+     * cannot be parsed it is simply overwritten */
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+        import_wisdom_from_file(fp, prec);
+
+    /* rewrite the file in place, while still holding the lock */
+    rewind(fp);
+    if (ftruncate(fd, 0) != 0) {
+        fclose(fp);
+        XLAL_ERROR(XLAL_EIO, "Could not truncate FFTW wisdom file '%s'", filename);
+    }
+#   else
+    fp = fopen(filename, "w");
+    if (!fp)
+        XLAL_ERROR(XLAL_EIO, "Could not open FFTW wisdom file '%s'", filename);
+#   endif
+
+    export_wisdom_to_file(fp, prec);
+
+    /* closing the file releases the lock */
+    if (ferror(fp) || fclose(fp) != 0)
+        XLAL_ERROR(XLAL_EIO, "Could not write FFTW wisdom to '%s'", filename);
+
+    return 0;
+}
+
+/* import wisdom from all files named by the environment; must be called
+ * while holding the FFTW wisdom lock */
+static int load_wisdom(void)
+{
+    int status = 0;
+    int prec;
+    for (prec = 0; prec < WISDOM_MAX; ++prec) {
+        const char *filename = getenv(wisdom_env[prec]);
+        if (filename && *filename && import_wisdom(filename, prec, 0) != 0)
+            status = XLAL_FAILURE;
+    }
+    return status;
+}
+
+/* export wisdom to all files named by the environment; must be called
+ * while holding the FFTW wisdom lock */
+static int save_wisdom(void)
+{
+    int status = 0;
+    int prec;
+    for (prec = 0; prec < WISDOM_MAX; ++prec) {
+        const char *filename = getenv(wisdom_env[prec]);
+        if (filename && *filename && export_wisdom(filename, prec) != 0)
+            status = XLAL_FAILURE;
+    }
+    if (status == 0)
+        wisdom_modified = 0;
+    return status;
+}
+
+/* save wisdom at exit; if another thread still holds the FFTW wisdom lock,
+ * e.g. because exit() was called while it was creating a plan, waiting for
+ * the lock could hang, so wisdom is not saved */
+static void save_wisdom_at_exit(void)
+{
+    if (!XLALFFTWWisdomTryLock()) {
+        XLAL_PRINT_WARNING("FFTW wisdom lock is held by another thread; not saving FFTW wisdom at exit");
+        return;
+    }
+    if (wisdom_modified) {
+        int errnum;
+        XLAL_TRY_SILENT(save_wisdom(), errnum);
+        if (errnum)
+            XLAL_PRINT_WARNING("Could not save FFTW wisdom at exit");
+    }
+    XLALFFTWWisdomUnlock();
+}
+
+/* arrange for wisdom to be saved at exit if any wisdom files are named by
+ * the environment; must be called while holding the FFTW wisdom lock */
+static void register_save_wisdom_at_exit(void)
+{
+    if (!wisdom_save_at_exit && (getenv(wisdom_env[WISDOM_DOUBLE]) || getenv(wisdom_env[WISDOM_SINGLE]))) {
+        wisdom_save_at_exit = 1;
+        atexit(save_wisdom_at_exit);
+    }
+}
+
+#endif /* LAL_FFTW3_ENABLED */
+
+
+/**
+ * \addtogroup FFTWWisdom_h
+ * @{
+ */
+
+/**
+ * Import double-precision FFTW wisdom from the named file, merging it
+ * with the wisdom already known.  The file is read while holding a shared
+ * lock on it.  Returns 0 on success, or #XLAL_FAILURE and sets xlalErrno
+ * to #XLAL_EIO if the file cannot be read or does not contain valid
+ * wisdom.
+ */
+int XLALFFTWImportWisdomFromFilename(const char *filename)
+{
+    XLAL_CHECK(filename != NULL, XLAL_EFAULT);
+#ifdef LAL_FFTW3_ENABLED
+    int retn;
+    XLALFFTWWisdomLock();
+    retn = import_wisdom(filename, WISDOM_DOUBLE, 1);
+    XLALFFTWWisdomUnlock();
+    XLAL_CHECK(retn == 0, XLAL_EFUNC);
+#endif
+    return 0;
+}
+
+/**
+ * Import single-precision FFTW wisdom from the named file.
+ *
+ * See also: XLALFFTWImportWisdomFromFilename()
+ */
+int XLALFFTWFImportWisdomFromFilename(const char *filename)
+{
+    XLAL_CHECK(filename != NULL, XLAL_EFAULT);
+#ifdef LAL_FFTW3_ENABLED
+    int retn;
+    XLALFFTWWisdomLock();
+    retn = import_wisdom(filename, WISDOM_SINGLE, 1);
+    XLALFFTWWisdomUnlock();
+    XLAL_CHECK(retn == 0, XLAL_EFUNC);
+#endif
+    return 0;
+}
+
+/**
+ * Export double-precision FFTW wisdom to the named file.  The file is
+ * created if it does not exist; otherwise, while holding an exclusive lock
+ * on it, the wisdom it contains is first merged with the wisdom already
+ * known, and the file is then rewritten.  Returns 0 on success, or
+ * #XLAL_FAILURE and sets xlalErrno to #XLAL_EIO if the file cannot be
+ * written.
+ */
+int XLALFFTWExportWisdomToFilename(const char *filename)
+{
+    XLAL_CHECK(filename != NULL, XLAL_EFAULT);
+#ifdef LAL_FFTW3_ENABLED
+    int retn;
+    XLALFFTWWisdomLock();
+    retn = export_wisdom(filename, WISDOM_DOUBLE);
+    XLALFFTWWisdomUnlock();
+    XLAL_CHECK(retn == 0, XLAL_EFUNC);
+#endif
+    return 0;
+}
+
+/**
+ * Export single-precision FFTW wisdom to the named file.
+ *
+ * See also: XLALFFTWExportWisdomToFilename()
+ */
+int XLALFFTWFExportWisdomToFilename(const char *filename)
+{
+    XLAL_CHECK(filename != NULL, XLAL_EFAULT);
+#ifdef LAL_FFTW3_ENABLED
+    int retn;
+    XLALFFTWWisdomLock();
+    retn = export_wisdom(filename, WISDOM_SINGLE);
+    XLALFFTWWisdomUnlock();
+    XLAL_CHECK(retn == 0, XLAL_EFUNC);
+#endif
+    return 0;
+}
+
+/**
+ * Import FFTW wisdom from the files named by the environment variables
+ * <tt>LAL_FFTW_WISDOM</tt> and <tt>LAL_FFTWF_WISDOM</tt>, if set.  Wisdom
+ * files which do not yet exist are silently ignored.  This is done
+ * automatically when the first LAL FFT plan is created, but may be called
+ * again at any time to pick up wisdom saved by other processes.
+ */
+int XLALFFTWWisdomLoad(void)
+{
+#ifdef LAL_FFTW3_ENABLED
+    int retn;
+    XLALFFTWWisdomLock();
+    wisdom_imported = 1;
+    register_save_wisdom_at_exit();
+    retn = load_wisdom();
+    XLALFFTWWisdomUnlock();
+    XLAL_CHECK(retn == 0, XLAL_EFUNC);
+#endif
+    return 0;
+}
+
+/**
+ * Merge the current FFTW wisdom into the files named by the environment
+ * variables <tt>LAL_FFTW_WISDOM</tt> and <tt>LAL_FFTWF_WISDOM</tt>, if
+ * set.  This is done automatically at exit if any measured plans were
+ * created, but may be called earlier, e.g. by long-running programs.
+ */
+int XLALFFTWWisdomSave(void)
+{
+#ifdef LAL_FFTW3_ENABLED
+    int retn;
+    XLALFFTWWisdomLock();
+    retn = save_wisdom();
+    XLALFFTWWisdomUnlock();
+    XLAL_CHECK(retn == 0, XLAL_EFUNC);
+#endif
+    return 0;
+}
+
+/**
+ * Import FFTW wisdom from the files named by the environment, if this has
+ * not already been done, and arrange for accumulated wisdom to be saved at
+ * exit.  Called by the LAL FFT plan constructors while holding the FFTW
+ * wisdom lock; failure to read the wisdom files is not fatal.
+ */
+void XLALFFTWWisdomAutoImport(void)
+{
+#ifdef LAL_FFTW3_ENABLED
+    if (!wisdom_imported) {
+        int errnum;
+        wisdom_imported = 1;
+        register_save_wisdom_at_exit();
+        XLAL_TRY_SILENT(load_wisdom(), errnum);
+        if (errnum)
+            XLAL_PRINT_WARNING("Could not load FFTW wisdom");
+    }
+#endif
+}
+
+/**
+ * Record that a plan has been created with the given measurement level, and
+ * therefore (if <tt>measurelvl</tt> is non-zero) that new wisdom may have been
+ * accumulated.  Called by the LAL FFT plan constructors while holding the
+ * FFTW wisdom lock.
+ */
+void XLALFFTWWisdomMarkModified(int measurelvl)
+{
+#ifdef LAL_FFTW3_ENABLED
+    if (measurelvl)
+        wisdom_modified = 1;
+#else
+    (void)measurelvl;
+#endif
+}
+
+/** @} */
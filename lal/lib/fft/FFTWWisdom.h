@@ -0,0 +1,86 @@
+/*
+*  Copyright (C) 2026
+*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+*  MA  02111-1307  USA
+*/
+
+#ifndef _FFTWWISDOM_H
+#define _FFTWWISDOM_H
+
+#include <lal/LALConfig.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#elif 0
+} /* so that editors will match preceding brace */
+#endif
+
+/**
+ * \defgroup FFTWWisdom_h Header FFTWWisdom.h
+ * \ingroup lal_fft
+ * \brief Persistent storage of FFTW wisdom.
+ *
+ * ### Synopsis ###
+ *
+ * \code
+ * #include <lal/FFTWWisdom.h>
+ * \endcode
+ *
+ * Creating a measured FFTW plan (a non-zero \c measurelvl passed to
+ * e.g. XLALCreateREAL8FFTPlan()) can be far more expensive than the
+ * transforms it is used for, particularly in short-lived jobs.  FFTW
+ * records what it learns while measuring as "wisdom", which can be saved
+ * and re-used so that subsequent plans of the same kind are created
+ * almost instantly.
+ *
+ * The routines in this package store FFTW wisdom in files that may be
+ * shared between processes.  If the environment variable
+ * <tt>LAL_FFTW_WISDOM</tt> (double precision) or <tt>LAL_FFTWF_WISDOM</tt>
+ * (single precision) names a wisdom file, that file is imported the first
+ * time any LAL FFT plan is created, and any wisdom accumulated by the
+ * process is merged back into it when the process exits.  The same files
+ * can be read and written explicitly with the functions below.
+ *
+ * Files are read while holding a shared POSIX advisory lock and written
+ * while holding an exclusive lock, so several jobs running concurrently on
+ * the same host may share the same wisdom files.  When writing, the
+ * wisdom already in the file is first merged into the process's wisdom, so
+ * that no wisdom gathered by other processes is lost.  The files use
+ * FFTW's own format, and are therefore compatible with those produced by
+ * the <tt>fftw-wisdom</tt> and <tt>fftwf-wisdom</tt> utilities.
+ *
+ * All of these routines acquire LAL's FFTW wisdom lock (see
+ * XLALFFTWWisdomLock()), and are no-ops if LAL has been compiled with an
+ * FFT backend other than FFTW.
+ */
+/** @{ */
+
+int XLALFFTWImportWisdomFromFilename( const char *filename );
+int XLALFFTWFImportWisdomFromFilename( const char *filename );
+int XLALFFTWExportWisdomToFilename( const char *filename );
+int XLALFFTWFExportWisdomToFilename( const char *filename );
+int XLALFFTWWisdomLoad( void );
+int XLALFFTWWisdomSave( void );
+
+/** @} */
+
+#if 0
+{ /* so that editors will match succeeding brace */
+#elif defined(__cplusplus)
+}
+#endif
+
+#endif /* _FFTWWISDOM_H */
@@ -0,0 +1,32 @@
+/*
+*  Copyright (C) 2026
+*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+*  MA  02111-1307  USA
+*/
+
+#ifndef _FFTWWISDOM_INTERNAL_H
+#define _FFTWWISDOM_INTERNAL_H
+
+/* internal routines used by the LAL FFT plan constructors; must be called
+ * while holding the FFTW wisdom lock */
+void XLALFFTWWisdomAutoImport( void );
+void XLALFFTWWisdomMarkModified( int measurelvl );
+
+/* acquire the FFTW wisdom lock only if it is not held by another thread;
+ * returns non-zero if the lock was acquired */
+int XLALFFTWWisdomTryLock( void );
+
+#endif /* _FFTWWISDOM_INTERNAL_H */
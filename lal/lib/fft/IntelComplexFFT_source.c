@@ -16,12 +16,15 @@
 
 #define PLAN_TYPE			CONCAT2(COMPLEX_TYPE,FFTPlan)
 #define COMPLEX_VECTOR_TYPE		CONCAT2(COMPLEX_TYPE,Vector)
+#define COMPLEX_VECTOR_SEQUENCE_TYPE	CONCAT2(COMPLEX_TYPE,VectorSequence)
 
 #define CREATE_PLAN_FUNCTION		CONCAT2(XLALCreate,PLAN_TYPE)
 #define CREATE_FORWARD_PLAN_FUNCTION	CONCAT2(XLALCreateForward,PLAN_TYPE)
 #define CREATE_REVERSE_PLAN_FUNCTION	CONCAT2(XLALCreateReverse,PLAN_TYPE)
 #define DESTROY_PLAN_FUNCTION		CONCAT2(XLALDestroy,PLAN_TYPE)
 #define VECTOR_FFT_FUNCTION		CONCAT3(XLAL,COMPLEX_VECTOR_TYPE,FFT)
+#define CREATE_MANY_PLAN_FUNCTION	CONCAT3(XLALCreate,PLAN_TYPE,Many)
+#define VECTOR_MANY_FFT_FUNCTION	CONCAT3(XLAL,COMPLEX_VECTOR_TYPE,FFTMany)
 
 #define FFTWX				CONCAT2(fftw,TYPESUFFIX)
 #define FFTWX_COMPLEX			CONCAT2(FFTWX,_complex)
@@ -134,6 +137,20 @@ int VECTOR_FFT_FUNCTION(COMPLEX_VECTOR_TYPE * _LAL_RESTRICT_ output, const COMPL
     return 0;
 }
 
+/*
+ * Batched transforms are not implemented with the Intel FFT library.
+ */
+
+PLAN_TYPE *CREATE_MANY_PLAN_FUNCTION(__attribute__((unused)) UINT4 size, __attribute__((unused)) UINT4 howmany, __attribute__((unused)) UINT4 stride, __attribute__((unused)) int fwdflg, __attribute__((unused)) int measurelvl)
+{
+    XLAL_ERROR_NULL(XLAL_EFAILED, "Batched FFTs are not supported by the Intel FFT library");
+}
+
+int VECTOR_MANY_FFT_FUNCTION(__attribute__((unused)) COMPLEX_VECTOR_SEQUENCE_TYPE * _LAL_RESTRICT_ output, __attribute__((unused)) const COMPLEX_VECTOR_SEQUENCE_TYPE * _LAL_RESTRICT_ input, __attribute__((unused)) const PLAN_TYPE * plan)
+{
+    XLAL_ERROR(XLAL_EFAILED, "Batched FFTs are not supported by the Intel FFT library");
+}
+
 #undef CONCAT2x
 #undef CONCAT2
 #undef CONCAT3x
@@ -146,12 +163,15 @@ int VECTOR_FFT_FUNCTION(COMPLEX_VECTOR_TYPE * _LAL_RESTRICT_ output, const COMPL
 
 #undef PLAN_TYPE
 #undef COMPLEX_VECTOR_TYPE
+#undef COMPLEX_VECTOR_SEQUENCE_TYPE
 
 #undef CREATE_PLAN_FUNCTION
 #undef CREATE_FORWARD_PLAN_FUNCTION
 #undef CREATE_REVERSE_PLAN_FUNCTION
 #undef DESTROY_PLAN_FUNCTION
 #undef VECTOR_FFT_FUNCTION
+#undef CREATE_MANY_PLAN_FUNCTION
+#undef VECTOR_MANY_FFT_FUNCTION
 
 #undef FFTWX
 #undef FFTWX_COMPLEX
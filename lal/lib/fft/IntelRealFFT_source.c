@@ -19,6 +19,8 @@
 #define PLAN_TYPE			CONCAT2(REAL_TYPE,FFTPlan)
 #define REAL_VECTOR_TYPE		CONCAT2(REAL_TYPE,Vector)
 #define COMPLEX_VECTOR_TYPE		CONCAT2(COMPLEX_TYPE,Vector)
+#define REAL_VECTOR_SEQUENCE_TYPE	CONCAT2(REAL_TYPE,VectorSequence)
+#define COMPLEX_VECTOR_SEQUENCE_TYPE	CONCAT2(COMPLEX_TYPE,VectorSequence)
 
 #define CREATE_PLAN_FUNCTION		CONCAT2(XLALCreate,PLAN_TYPE)
 #define CREATE_FORWARD_PLAN_FUNCTION	CONCAT2(XLALCreateForward,PLAN_TYPE)
@@ -28,6 +30,9 @@
 #define REVERSE_FFT_FUNCTION		CONCAT3(XLAL,REAL_TYPE,ReverseFFT)
 #define VECTOR_FFT_FUNCTION		CONCAT3(XLAL,REAL_VECTOR_TYPE,FFT)
 #define POWER_SPECTRUM_FUNCTION		CONCAT3(XLAL,REAL_TYPE,PowerSpectrum)
+#define CREATE_MANY_PLAN_FUNCTION	CONCAT3(XLALCreate,PLAN_TYPE,Many)
+#define FORWARD_MANY_FFT_FUNCTION	CONCAT3(XLAL,REAL_TYPE,ForwardFFTMany)
+#define REVERSE_MANY_FFT_FUNCTION	CONCAT3(XLAL,REAL_TYPE,ReverseFFTMany)
 
 #define CREALX				CONCAT2(creal,TYPESUFFIX)
 #define CIMAGX				CONCAT2(cimag,TYPESUFFIX)
@@ -305,6 +310,25 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
     return 0;
 }
 
+/*
+ * Batched transforms are not implemented with the Intel FFT library.
+ */
+
+PLAN_TYPE *CREATE_MANY_PLAN_FUNCTION(__attribute__((unused)) UINT4 size, __attribute__((unused)) UINT4 howmany, __attribute__((unused)) UINT4 stride, __attribute__((unused)) int fwdflg, __attribute__((unused)) int measurelvl)
+{
+    XLAL_ERROR_NULL(XLAL_EFAILED, "Batched FFTs are not supported by the Intel FFT library");
+}
+
+int FORWARD_MANY_FFT_FUNCTION(__attribute__((unused)) COMPLEX_VECTOR_SEQUENCE_TYPE * output, __attribute__((unused)) const REAL_VECTOR_SEQUENCE_TYPE * input, __attribute__((unused)) const PLAN_TYPE * plan)
+{
+    XLAL_ERROR(XLAL_EFAILED, "Batched FFTs are not supported by the Intel FFT library");
+}
+
+int REVERSE_MANY_FFT_FUNCTION(__attribute__((unused)) REAL_VECTOR_SEQUENCE_TYPE * output, __attribute__((unused)) const COMPLEX_VECTOR_SEQUENCE_TYPE * input, __attribute__((unused)) const PLAN_TYPE * plan)
+{
+    XLAL_ERROR(XLAL_EFAILED, "Batched FFTs are not supported by the Intel FFT library");
+}
+
 #undef CONCAT2x
 #undef CONCAT2
 #undef CONCAT3x
@@ -319,6 +343,8 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
 #undef PLAN_TYPE
 #undef REAL_VECTOR_TYPE
 #undef COMPLEX_VECTOR_TYPE
+#undef REAL_VECTOR_SEQUENCE_TYPE
+#undef COMPLEX_VECTOR_SEQUENCE_TYPE
 
 #undef CREATE_PLAN_FUNCTION
 #undef CREATE_FORWARD_PLAN_FUNCTION
@@ -328,6 +354,9 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
 #undef REVERSE_FFT_FUNCTION
 #undef VECTOR_FFT_FUNCTION
 #undef POWER_SPECTRUM_FUNCTION
+#undef CREATE_MANY_PLAN_FUNCTION
+#undef FORWARD_MANY_FFT_FUNCTION
+#undef REVERSE_MANY_FFT_FUNCTION
 
 #undef CREALX
 #undef CIMAGX
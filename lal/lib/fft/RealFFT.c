@@ -23,6 +23,10 @@
 #include <fftw3.h>
 #include <string.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <lal/LALDatatypes.h>
 #include <lal/FFTWMutex.h>
 #include <lal/LALConfig.h> /* Needed to know whether aligning memory */
@@ -31,6 +35,8 @@
 #include <lal/SeqFactories.h>
 #include <lal/XLALError.h>
 
+#include "FFTWWisdom_internal.h"
+
 /**
  * \addtogroup RealFFT_h
  *
@@ -155,6 +161,10 @@ tagREAL4FFTPlan
   INT4       sign; /**< sign in transform exponential, -1 for forward, +1 for reverse */
   UINT4      size; /**< length of the real data vector for this plan */
   fftwf_plan plan; /**< the FFTW plan */
+  UINT4      howmany; /**< number of transforms performed by a batched plan, or 0 for a plan of a single transform */
+  UINT4      stride; /**< for a batched plan, the distance between successive elements of each transform (1 if each transform is contiguous) */
+  UINT4      blocksize; /**< for a batched plan, the number of transforms performed by each execution of \c plan */
+  fftwf_plan tailplan; /**< for a batched plan, the FFTW plan for a final, smaller block of transforms, if needed */
 };
 
 /**
@@ -166,6 +176,10 @@ tagREAL8FFTPlan
   INT4       sign; /**< sign in transform exponential, -1 for forward, +1 for reverse */
   UINT4      size; /**< length of the real data vector for this plan */
   fftw_plan  plan; /**< the FFTW plan */
+  UINT4      howmany; /**< number of transforms performed by a batched plan, or 0 for a plan of a single transform */
+  UINT4      stride; /**< for a batched plan, the distance between successive elements of each transform (1 if each transform is contiguous) */
+  UINT4      blocksize; /**< for a batched plan, the number of transforms performed by each execution of \c plan */
+  fftw_plan  tailplan; /**< for a batched plan, the FFTW plan for a final, smaller block of transforms, if needed */
 };
 
 
@@ -60,6 +60,10 @@ extern "C" {
  * int XLALREAL4VectorFFT( REAL4Vector *output, REAL4Vector *input, REAL4FFTPlan *plan );
  * int XLALREAL4PowerSpectrum( REAL4Vector *spec, REAL4Vector *data, REAL4FFTPlan *plan );
  *
+ * REAL4FFTPlan * XLALCreateREAL4FFTPlanMany( UINT4 size, UINT4 howmany, UINT4 stride, int fwdflg, int measurelvl );
+ * int XLALREAL4ForwardFFTMany( COMPLEX8VectorSequence *output, REAL4VectorSequence *input, REAL4FFTPlan *plan );
+ * int XLALREAL4ReverseFFTMany( REAL4VectorSequence *output, COMPLEX8VectorSequence *input, REAL4FFTPlan *plan );
+ *
  * REAL8FFTPlan * XLALCreateREAL8FFTPlan( UINT4 size, int fwdflg, int measurelvl );
  * REAL8FFTPlan * XLALCreateForwardREAL8FFTPlan( UINT4 size, int measurelvl );
  * REAL8FFTPlan * XLALCreateReverseREAL8FFTPlan( UINT4 size, int measurelvl );
@@ -69,6 +73,10 @@ extern "C" {
  * int XLALREAL8ReverseFFT( REAL8Vector *output, COMPLEX16Vector *input, REAL8FFTPlan *plan );
  * int XLALREAL8VectorFFT( REAL8Vector *output, REAL8Vector *input, REAL8FFTPlan *plan );
  * int XLALREAL8PowerSpectrum( REAL8Vector *spec, REAL8Vector *data, REAL8FFTPlan *plan );
+ *
+ * REAL8FFTPlan * XLALCreateREAL8FFTPlanMany( UINT4 size, UINT4 howmany, UINT4 stride, int fwdflg, int measurelvl );
+ * int XLALREAL8ForwardFFTMany( COMPLEX16VectorSequence *output, REAL8VectorSequence *input, REAL8FFTPlan *plan );
+ * int XLALREAL8ReverseFFTMany( REAL8VectorSequence *output, COMPLEX16VectorSequence *input, REAL8FFTPlan *plan );
  * \endcode
  *
  * ### Description ###
@@ -116,6 +124,21 @@ extern "C" {
  * XLALREAL4PowerSpectrum() computes a real power spectrum of the
  * input real vector and a forward FFT plan.
  *
+ * XLALCreateREAL4FFTPlanMany() creates a plan which performs \c howmany
+ * transforms of the same size at once, using the advanced interface of
+ * FFTW; this is more efficient than performing each transform in turn.
+ * XLALREAL4ForwardFFTMany() and XLALREAL4ReverseFFTMany() perform the
+ * forward and reverse transforms of the vectors of a sequence.  If
+ * \c stride is 1 each transform is contiguous, i.e., each vector of the
+ * sequence is transformed.  Otherwise element \f$j\f$ of transform \f$i\f$
+ * is stored at position \f$j \times \mathrm{stride} + i\f$, i.e., the
+ * first \c howmany columns of a sequence with vectors of length \c stride
+ * are transformed.  If LAL has been compiled with OpenMP support the
+ * transforms are divided between the available threads.  These plans can
+ * only be used with the batched routines, and are destroyed with
+ * XLALDestroyREAL4FFTPlan().  Batched transforms are only available with
+ * the FFTW backend.
+ *
  * ### Return Values ###
  *
  * Upon success,
@@ -428,6 +451,102 @@ int XLALREAL4VectorFFT( REAL4Vector * _LAL_RESTRICT_ output, const REAL4Vector *
  */
 int XLALREAL4PowerSpectrum( REAL4Vector * _LAL_RESTRICT_ spec, const REAL4Vector * _LAL_RESTRICT_ data, const REAL4FFTPlan *plan );
 
+/**
+ * Returns a new REAL4FFTPlan for performing many transforms at once
+ *
+ * The plan performs \c howmany forward or reverse transforms of real data
+ * vectors of length \c size, which are either stored contiguously one after
+ * another (\c stride equal to 1), or interleaved in the columns of a
+ * row-major array with rows of length \c stride.  The resulting plan may
+ * only be used with XLALREAL4ForwardFFTMany() or XLALREAL4ReverseFFTMany().
+ *
+ * @param[in] size The number of points in each real data vector.
+ * @param[in] howmany The number of transforms to perform.
+ * @param[in] stride Set to 1 if each transform is contiguous; otherwise
+ * the distance between successive elements of each transform, which must
+ * be at least \c howmany.
+ * @param[in] fwdflg Set non-zero for a forward FFT plan;
+ * otherwise create a reverse plan
+ * @param[in] measurelvl Measurement level for plan creation:
+ * - 0: no measurement, just estimate the plan;
+ * - 1: measure the best plan;
+ * - 2: perform a lengthy measurement of the best plan;
+ * - 3: perform an exhasutive measurement of the best plan.
+ * @return A pointer to an allocated \c REAL4FFTPlan structure is returned
+ * upon successful completion.  Otherwise, a \c NULL pointer is returned
+ * and \c xlalErrno is set to indicate the error.
+ * @par Errors:
+ * The \c XLALCreateREAL4FFTPlanMany() function shall fail if:
+ * - [\c XLAL_EBADLEN] The size of the requested plan, or the number of
+ * transforms, is 0.
+ * - [\c XLAL_EINVAL] The stride is neither 1 nor at least \c howmany.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * - [\c XLAL_EFAILED] The call to the underlying FFTW routine failed.
+ * .
+ */
+REAL4FFTPlan * XLALCreateREAL4FFTPlanMany( UINT4 size, UINT4 howmany, UINT4 stride, int fwdflg, int measurelvl );
+
+/**
+ * Performs many forward FFTs of REAL4 data at once
+ *
+ * This routine performs the same transforms as XLALREAL4ForwardFFT() on
+ * each of the \c howmany real data vectors described by the plan.  If the
+ * plan stride is 1 then each vector of the \c input sequence is transformed
+ * into the corresponding vector of the \c output sequence; otherwise the
+ * columns of the sequences are transformed.
+ *
+ * @param[out] output The complex output data sequence: either \c howmany
+ * vectors of length <tt>size/2+1</tt>, or <tt>size/2+1</tt> vectors of
+ * length \c stride.
+ * @param[in] input The real input data sequence: either \c howmany
+ * vectors of length \c size, or \c size vectors of length \c stride.
+ * @param[in] plan The batched forward FFT plan to use, created by
+ * XLALCreateREAL4FFTPlanMany().
+ * @retval 0 Success.
+ * @retval #XLAL_FAILURE Failure.
+ * @par Errors:
+ * The \c XLALREAL4ForwardFFTMany() function shall fail if:
+ * - [\c XLAL_EFAULT] A \c NULL pointer is provided as one of the arguments.
+ * - [\c XLAL_EINVAL] A argument is invalid, or the plan is not a batched
+ * plan for a forward transform.
+ * - [\c XLAL_EBADLEN] The input sequence, output sequence, and plan are
+ * incompatible.
+ * .
+ */
+int XLALREAL4ForwardFFTMany( COMPLEX8VectorSequence *output, const REAL4VectorSequence *input, const REAL4FFTPlan *plan );
+
+/**
+ * Performs many reverse FFTs of REAL4 data at once
+ *
+ * This routine performs the same transforms as XLALREAL4ReverseFFT() on
+ * each of the \c howmany complex data vectors described by the plan.  If
+ * the plan stride is 1 then each vector of the \c input sequence is
+ * transformed into the corresponding vector of the \c output sequence;
+ * otherwise the columns of the sequences are transformed.  The input
+ * sequence is not modified.
+ *
+ * @param[out] output The real output data sequence: either \c howmany
+ * vectors of length \c size, or \c size vectors of length \c stride.
+ * @param[in] input The complex input data sequence: either \c howmany
+ * vectors of length <tt>size/2+1</tt>, or <tt>size/2+1</tt> vectors of
+ * length \c stride.
+ * @param[in] plan The batched reverse FFT plan to use, created by
+ * XLALCreateREAL4FFTPlanMany().
+ * @retval 0 Success.
+ * @retval #XLAL_FAILURE Failure.
+ * @par Errors:
+ * The \c XLALREAL4ReverseFFTMany() function shall fail if:
+ * - [\c XLAL_EFAULT] A \c NULL pointer is provided as one of the arguments.
+ * - [\c XLAL_EINVAL] A argument is invalid, or the plan is not a batched
+ * plan for a reverse transform.
+ * - [\c XLAL_EBADLEN] The input sequence, output sequence, and plan are
+ * incompatible.
+ * - [\c XLAL_EDOM] The imaginary part of the DC or Nyquist component of
+ * one of the input vectors is not zero.
+ * .
+ */
+int XLALREAL4ReverseFFTMany( REAL4VectorSequence *output, const COMPLEX8VectorSequence *input, const REAL4FFTPlan *plan );
+
 /*
  *
  * XLAL REAL8 functions
@@ -660,6 +779,102 @@ int XLALREAL8VectorFFT( REAL8Vector *output, const REAL8Vector *input,
 int XLALREAL8PowerSpectrum( REAL8Vector *spec, const REAL8Vector *data,
     const REAL8FFTPlan *plan );
 
+/**
+ * Returns a new REAL8FFTPlan for performing many transforms at once
+ *
+ * The plan performs \c howmany forward or reverse transforms of real data
+ * vectors of length \c size, which are either stored contiguously one after
+ * another (\c stride equal to 1), or interleaved in the columns of a
+ * row-major array with rows of length \c stride.  The resulting plan may
+ * only be used with XLALREAL8ForwardFFTMany() or XLALREAL8ReverseFFTMany().
+ *
+ * @param[in] size The number of points in each real data vector.
+ * @param[in] howmany The number of transforms to perform.
+ * @param[in] stride Set to 1 if each transform is contiguous; otherwise
+ * the distance between successive elements of each transform, which must
+ * be at least \c howmany.
+ * @param[in] fwdflg Set non-zero for a forward FFT plan;
+ * otherwise create a reverse plan
+ * @param[in] measurelvl Measurement level for plan creation:
+ * - 0: no measurement, just estimate the plan;
+ * - 1: measure the best plan;
+ * - 2: perform a lengthy measurement of the best plan;
+ * - 3: perform an exhasutive measurement of the best plan.
+ * @return A pointer to an allocated \c REAL8FFTPlan structure is returned
+ * upon successful completion.  Otherwise, a \c NULL pointer is returned
+ * and \c xlalErrno is set to indicate the error.
+ * @par Errors:
+ * The \c XLALCreateREAL8FFTPlanMany() function shall fail if:
+ * - [\c XLAL_EBADLEN] The size of the requested plan, or the number of
+ * transforms, is 0.
+ * - [\c XLAL_EINVAL] The stride is neither 1 nor at least \c howmany.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * - [\c XLAL_EFAILED] The call to the underlying FFTW routine failed.
+ * .
+ */
+REAL8FFTPlan * XLALCreateREAL8FFTPlanMany( UINT4 size, UINT4 howmany, UINT4 stride, int fwdflg, int measurelvl );
+
+/**
+ * Performs many forward FFTs of REAL8 data at once
+ *
+ * This routine performs the same transforms as XLALREAL8ForwardFFT() on
+ * each of the \c howmany real data vectors described by the plan.  If the
+ * plan stride is 1 then each vector of the \c input sequence is transformed
+ * into the corresponding vector of the \c output sequence; otherwise the
+ * columns of the sequences are transformed.
+ *
+ * @param[out] output The complex output data sequence: either \c howmany
+ * vectors of length <tt>size/2+1</tt>, or <tt>size/2+1</tt> vectors of
+ * length \c stride.
+ * @param[in] input The real input data sequence: either \c howmany
+ * vectors of length \c size, or \c size vectors of length \c stride.
+ * @param[in] plan The batched forward FFT plan to use, created by
+ * XLALCreateREAL8FFTPlanMany().
+ * @retval 0 Success.
+ * @retval #XLAL_FAILURE Failure.
+ * @par Errors:
+ * The \c XLALREAL8ForwardFFTMany() function shall fail if:
+ * - [\c XLAL_EFAULT] A \c NULL pointer is provided as one of the arguments.
+ * - [\c XLAL_EINVAL] A argument is invalid, or the plan is not a batched
+ * plan for a forward transform.
+ * - [\c XLAL_EBADLEN] The input sequence, output sequence, and plan are
+ * incompatible.
+ * .
+ */
+int XLALREAL8ForwardFFTMany( COMPLEX16VectorSequence *output, const REAL8VectorSequence *input, const REAL8FFTPlan *plan );
+
+/**
+ * Performs many reverse FFTs of REAL8 data at once
+ *
+ * This routine performs the same transforms as XLALREAL8ReverseFFT() on
+ * each of the \c howmany complex data vectors described by the plan.  If
+ * the plan stride is 1 then each vector of the \c input sequence is
+ * transformed into the corresponding vector of the \c output sequence;
+ * otherwise the columns of the sequences are transformed.  The input
+ * sequence is not modified.
+ *
+ * @param[out] output The real output data sequence: either \c howmany
+ * vectors of length \c size, or \c size vectors of length \c stride.
+ * @param[in] input The complex input data sequence: either \c howmany
+ * vectors of length <tt>size/2+1</tt>, or <tt>size/2+1</tt> vectors of
+ * length \c stride.
+ * @param[in] plan The batched reverse FFT plan to use, created by
+ * XLALCreateREAL8FFTPlanMany().
+ * @retval 0 Success.
+ * @retval #XLAL_FAILURE Failure.
+ * @par Errors:
+ * The \c XLALREAL8ReverseFFTMany() function shall fail if:
+ * - [\c XLAL_EFAULT] A \c NULL pointer is provided as one of the arguments.
+ * - [\c XLAL_EINVAL] A argument is invalid, or the plan is not a batched
+ * plan for a reverse transform.
+ * - [\c XLAL_EBADLEN] The input sequence, output sequence, and plan are
+ * incompatible.
+ * - [\c XLAL_EDOM] The imaginary part of the DC or Nyquist component of
+ * one of the input vectors is not zero.
+ * .
+ */
+int XLALREAL8ReverseFFTMany( REAL8VectorSequence *output, const COMPLEX16VectorSequence *input, const REAL8FFTPlan *plan );
+
 /** @} */
 
 #if 0
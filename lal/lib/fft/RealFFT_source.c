@@ -17,6 +17,8 @@
 #define PLAN_TYPE			CONCAT2(REAL_TYPE,FFTPlan)
 #define REAL_VECTOR_TYPE		CONCAT2(REAL_TYPE,Vector)
 #define COMPLEX_VECTOR_TYPE		CONCAT2(COMPLEX_TYPE,Vector)
+#define REAL_VECTOR_SEQUENCE_TYPE	CONCAT2(REAL_TYPE,VectorSequence)
+#define COMPLEX_VECTOR_SEQUENCE_TYPE	CONCAT2(COMPLEX_TYPE,VectorSequence)
 
 #define CREATE_PLAN_FUNCTION		CONCAT2(XLALCreate,PLAN_TYPE)
 #define CREATE_FORWARD_PLAN_FUNCTION	CONCAT2(XLALCreateForward,PLAN_TYPE)
@@ -26,13 +28,21 @@
 #define REVERSE_FFT_FUNCTION		CONCAT3(XLAL,REAL_TYPE,ReverseFFT)
 #define VECTOR_FFT_FUNCTION		CONCAT3(XLAL,REAL_VECTOR_TYPE,FFT)
 #define POWER_SPECTRUM_FUNCTION		CONCAT3(XLAL,REAL_TYPE,PowerSpectrum)
+#define CREATE_MANY_PLAN_FUNCTION	CONCAT3(XLALCreate,PLAN_TYPE,Many)
+#define FORWARD_MANY_FFT_FUNCTION	CONCAT3(XLAL,REAL_TYPE,ForwardFFTMany)
+#define REVERSE_MANY_FFT_FUNCTION	CONCAT3(XLAL,REAL_TYPE,ReverseFFTMany)
 
 #define CREALX				CONCAT2(creal,TYPESUFFIX)
 #define CIMAGX				CONCAT2(cimag,TYPESUFFIX)
 #define FFTWX				CONCAT2(fftw,TYPESUFFIX)
+#define FFTWX_COMPLEX			CONCAT2(FFTWX,_complex)
 #define FFTWX_PLAN_R2R_1D		CONCAT2(FFTWX,_plan_r2r_1d)
+#define FFTWX_PLAN_MANY_DFT_R2C		CONCAT2(FFTWX,_plan_many_dft_r2c)
+#define FFTWX_PLAN_MANY_DFT_C2R		CONCAT2(FFTWX,_plan_many_dft_c2r)
 #define FFTWX_DESTROY_PLAN		CONCAT2(FFTWX,_destroy_plan)
 #define FFTWX_EXECUTE_R2R		CONCAT2(FFTWX,_execute_r2r)
+#define FFTWX_EXECUTE_DFT_R2C		CONCAT2(FFTWX,_execute_dft_r2c)
+#define FFTWX_EXECUTE_DFT_C2R		CONCAT2(FFTWX,_execute_dft_c2r)
 
 PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
 {
@@ -94,13 +104,16 @@ PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
     }
 #   endif
 
-    /* establish fftw mutex lock and create plan */
+    /* establish fftw mutex lock, import any stored wisdom, and create plan */
 
     LAL_FFTW_WISDOM_LOCK;
+    XLALFFTWWisdomAutoImport();
     if (fwdflg) /* forward */
         plan->plan = FFTWX_PLAN_R2R_1D(size, tmp1, tmp2, FFTW_R2HC, flags);
     else        /* reverse */
         plan->plan = FFTWX_PLAN_R2R_1D(size, tmp1, tmp2, FFTW_HC2R, flags);
+    if (plan->plan)
+        XLALFFTWWisdomMarkModified(measurelvl);
     LAL_FFTW_WISDOM_UNLOCK;
 
     /* free the temporary arrays */
@@ -124,6 +137,10 @@ PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
 
     plan->size = size;
     plan->sign = (fwdflg ? -1 : 1);
+    plan->howmany = 0;
+    plan->stride = 1;
+    plan->blocksize = 0;
+    plan->tailplan = NULL;
 
     return plan;
 }
@@ -149,9 +166,12 @@ PLAN_TYPE *CREATE_REVERSE_PLAN_FUNCTION(UINT4 size, int measurelvl)
 void DESTROY_PLAN_FUNCTION(PLAN_TYPE * plan)
 {
     if (plan) {
-        if (plan->plan) {
+        if (plan->plan || plan->tailplan) {
             LAL_FFTW_WISDOM_LOCK;
-            FFTWX_DESTROY_PLAN(plan->plan);
+            if (plan->plan)
+                FFTWX_DESTROY_PLAN(plan->plan);
+            if (plan->tailplan)
+                FFTWX_DESTROY_PLAN(plan->tailplan);
             LAL_FFTW_WISDOM_UNLOCK;
         }
         memset(plan, 0, sizeof(*plan));
@@ -170,7 +190,7 @@ int FORWARD_FFT_FUNCTION(COMPLEX_VECTOR_TYPE * output, const REAL_VECTOR_TYPE *
 
     if (!output || !input || !plan)
         XLAL_ERROR(XLAL_EFAULT);
-    if (!plan->plan || !plan->size || plan->sign != -1)
+    if (!plan->plan || !plan->size || plan->howmany || plan->sign != -1)
         XLAL_ERROR(XLAL_EINVAL);
     if (!output->data || !input->data)
         XLAL_ERROR(XLAL_EINVAL);
@@ -243,7 +263,7 @@ int REVERSE_FFT_FUNCTION(REAL_VECTOR_TYPE * output, const COMPLEX_VECTOR_TYPE *
 
     if (!output || !input || !plan)
         XLAL_ERROR(XLAL_EFAULT);
-    if (!plan->plan || !plan->size || plan->sign != 1)
+    if (!plan->plan || !plan->size || plan->howmany || plan->sign != 1)
         XLAL_ERROR(XLAL_EINVAL);
     if (!output->data || !input->data)
         XLAL_ERROR(XLAL_EINVAL);
@@ -327,7 +347,7 @@ int VECTOR_FFT_FUNCTION(REAL_VECTOR_TYPE * _LAL_RESTRICT_ output, const REAL_VEC
 
     if (!output || !input || !plan)
         XLAL_ERROR(XLAL_EFAULT);
-    if (!plan->plan || !plan->size)
+    if (!plan->plan || !plan->size || plan->howmany)
         XLAL_ERROR(XLAL_EINVAL);
     if (!output->data || !input->data || output->data == input->data)
         XLAL_ERROR(XLAL_EINVAL);        /* note: must be out-of-place */
@@ -387,7 +407,7 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
 
     if (!spec || !data || !plan)
         XLAL_ERROR(XLAL_EFAULT);
-    if (!plan->plan || !plan->size)
+    if (!plan->plan || !plan->size || plan->howmany)
         XLAL_ERROR(XLAL_EINVAL);
     if (!spec->data || !data->data)
         XLAL_ERROR(XLAL_EINVAL);
@@ -453,6 +473,213 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
     return 0;
 }
 
+PLAN_TYPE *CREATE_MANY_PLAN_FUNCTION(UINT4 size, UINT4 howmany, UINT4 stride, int fwdflg, int measurelvl)
+{
+    PLAN_TYPE *plan;
+    REAL_TYPE *rtmp;
+    COMPLEX_TYPE *ctmp;
+    UINT4 nblocks;
+    UINT4 blocksize;
+    UINT4 tailsize;
+    int n = size;
+    int rdist;
+    int cdist;
+    int flags;
+
+    if (!size || !howmany)
+        XLAL_ERROR_NULL(XLAL_EBADLEN);
+    if (stride != 1 && stride < howmany)
+        XLAL_ERROR_NULL(XLAL_EINVAL);
+
+    /* set fftw3 flags to perform requested degree of measurement; the
+     * transforms of a block do not in general start on aligned memory, and
+     * the input to a reverse transform must not be overwritten */
+
+    flags = FFTW_UNALIGNED;
+    if (!fwdflg)
+        flags |= FFTW_PRESERVE_INPUT;
+
+    switch (measurelvl) {
+    case 0:    /* estimate */
+        flags |= FFTW_ESTIMATE;
+        break;
+    default:   /* exhaustive measurement */
+        flags |= FFTW_EXHAUSTIVE;
+        /* fall-through */
+    case 2:    /* lengthy measurement */
+        flags |= FFTW_PATIENT;
+        /* fall-through */
+    case 1:    /* measure the best plan */
+        flags |= FFTW_MEASURE;
+        break;
+    }
+
+    /* divide the transforms into one block per thread */
+
+#   ifdef _OPENMP
+    nblocks = omp_get_max_threads();
+    if (nblocks > howmany)
+        nblocks = howmany;
+#   else
+    nblocks = 1;
+#   endif
+    blocksize = (howmany + nblocks - 1) / nblocks;
+    tailsize = howmany % blocksize;
+
+    /* distance between the first elements of successive transforms */
+
+    rdist = (stride == 1) ? (int) size : 1;
+    cdist = (stride == 1) ? (int) (size / 2 + 1) : 1;
+
+    /* allocate memory for the plan and the temporary arrays */
+
+    plan = XLALMalloc(sizeof(*plan));
+    rtmp = XLALMalloc(size * (stride == 1 ? blocksize : stride) * sizeof(*rtmp));
+    ctmp = XLALMalloc((size / 2 + 1) * (stride == 1 ? blocksize : stride) * sizeof(*ctmp));
+    if (!plan || !rtmp || !ctmp) {
+        XLALFree(plan);
+        XLALFree(rtmp);
+        XLALFree(ctmp);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+
+    /* establish fftw mutex lock, import any stored wisdom, and create plans */
+
+    LAL_FFTW_WISDOM_LOCK;
+    XLALFFTWWisdomAutoImport();
+    if (fwdflg) {
+        plan->plan = FFTWX_PLAN_MANY_DFT_R2C(1, &n, blocksize, rtmp, NULL, stride, rdist, (FFTWX_COMPLEX *) ctmp, NULL, stride, cdist, flags);
+        plan->tailplan = tailsize ? FFTWX_PLAN_MANY_DFT_R2C(1, &n, tailsize, rtmp, NULL, stride, rdist, (FFTWX_COMPLEX *) ctmp, NULL, stride, cdist, flags) : NULL;
+    } else {
+        plan->plan = FFTWX_PLAN_MANY_DFT_C2R(1, &n, blocksize, (FFTWX_COMPLEX *) ctmp, NULL, stride, cdist, rtmp, NULL, stride, rdist, flags);
+        plan->tailplan = tailsize ? FFTWX_PLAN_MANY_DFT_C2R(1, &n, tailsize, (FFTWX_COMPLEX *) ctmp, NULL, stride, cdist, rtmp, NULL, stride, rdist, flags) : NULL;
+    }
+    if (plan->plan)
+        XLALFFTWWisdomMarkModified(measurelvl);
+    LAL_FFTW_WISDOM_UNLOCK;
+
+    /* free the temporary arrays */
+
+    XLALFree(rtmp);
+    XLALFree(ctmp);
+
+    /* set plan fields and check to see success of plan creation */
+
+    plan->size = size;
+    plan->sign = (fwdflg ? -1 : 1);
+    plan->howmany = howmany;
+    plan->stride = stride;
+    plan->blocksize = blocksize;
+
+    if (!plan->plan || (tailsize && !plan->tailplan)) {
+        DESTROY_PLAN_FUNCTION(plan);
+        XLAL_ERROR_NULL(XLAL_EFAILED);
+    }
+
+    return plan;
+}
+
+int FORWARD_MANY_FFT_FUNCTION(COMPLEX_VECTOR_SEQUENCE_TYPE * output, const REAL_VECTOR_SEQUENCE_TYPE * input, const PLAN_TYPE * plan)
+{
+    UINT4 rdist;
+    UINT4 cdist;
+    UINT4 nblocks;
+    int b;
+
+    /* sanity checks on arguments */
+
+    if (!output || !input || !plan)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (!plan->plan || !plan->size || !plan->howmany || plan->sign != -1)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (!output->data || !input->data)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (plan->stride == 1) {
+        if (input->length != plan->howmany || input->vectorLength != plan->size)
+            XLAL_ERROR(XLAL_EBADLEN);
+        if (output->length != plan->howmany || output->vectorLength != plan->size / 2 + 1)
+            XLAL_ERROR(XLAL_EBADLEN);
+    } else {
+        if (input->length != plan->size || input->vectorLength != plan->stride)
+            XLAL_ERROR(XLAL_EBADLEN);
+        if (output->length != plan->size / 2 + 1 || output->vectorLength != plan->stride)
+            XLAL_ERROR(XLAL_EBADLEN);
+    }
+
+    rdist = (plan->stride == 1) ? plan->size : 1;
+    cdist = (plan->stride == 1) ? plan->size / 2 + 1 : 1;
+    nblocks = (plan->howmany + plan->blocksize - 1) / plan->blocksize;
+
+    /* perform the ffts, one block of transforms per thread */
+
+#   pragma omp parallel for
+    for (b = 0; b < (int) nblocks; ++b) {
+        const size_t first = (size_t) b * plan->blocksize;
+        if ((UINT4) b + 1 == nblocks && plan->tailplan)
+            FFTWX_EXECUTE_DFT_R2C(plan->tailplan, input->data + first * rdist, (FFTWX_COMPLEX *) (output->data + first * cdist));
+        else
+            FFTWX_EXECUTE_DFT_R2C(plan->plan, input->data + first * rdist, (FFTWX_COMPLEX *) (output->data + first * cdist));
+    }
+
+    return 0;
+}
+
+int REVERSE_MANY_FFT_FUNCTION(REAL_VECTOR_SEQUENCE_TYPE * output, const COMPLEX_VECTOR_SEQUENCE_TYPE * input, const PLAN_TYPE * plan)
+{
+    UINT4 rdist;
+    UINT4 cdist;
+    UINT4 nblocks;
+    UINT4 i;
+    int b;
+
+    /* sanity checks on arguments */
+
+    if (!output || !input || !plan)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (!plan->plan || !plan->size || !plan->howmany || plan->sign != 1)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (!output->data || !input->data)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (plan->stride == 1) {
+        if (output->length != plan->howmany || output->vectorLength != plan->size)
+            XLAL_ERROR(XLAL_EBADLEN);
+        if (input->length != plan->howmany || input->vectorLength != plan->size / 2 + 1)
+            XLAL_ERROR(XLAL_EBADLEN);
+    } else {
+        if (output->length != plan->size || output->vectorLength != plan->stride)
+            XLAL_ERROR(XLAL_EBADLEN);
+        if (input->length != plan->size / 2 + 1 || input->vectorLength != plan->stride)
+            XLAL_ERROR(XLAL_EBADLEN);
+    }
+
+    rdist = (plan->stride == 1) ? plan->size : 1;
+    cdist = (plan->stride == 1) ? plan->size / 2 + 1 : 1;
+    nblocks = (plan->howmany + plan->blocksize - 1) / plan->blocksize;
+
+    /* imaginary parts of DC and Nyquist components must be zero */
+
+    for (i = 0; i < plan->howmany; ++i) {
+        if (CIMAGX(input->data[i * cdist]) != 0.0)
+            XLAL_ERROR(XLAL_EDOM);
+        if (plan->size % 2 == 0 && CIMAGX(input->data[i * cdist + (plan->size / 2) * plan->stride]) != 0.0)
+            XLAL_ERROR(XLAL_EDOM);
+    }
+
+    /* perform the ffts, one block of transforms per thread; the plans
+     * preserve their input */
+
+#   pragma omp parallel for
+    for (b = 0; b < (int) nblocks; ++b) {
+        const size_t first = (size_t) b * plan->blocksize;
+        if ((UINT4) b + 1 == nblocks && plan->tailplan)
+            FFTWX_EXECUTE_DFT_C2R(plan->tailplan, (FFTWX_COMPLEX *) (input->data + first * cdist), output->data + first * rdist);
+        else
+            FFTWX_EXECUTE_DFT_C2R(plan->plan, (FFTWX_COMPLEX *) (input->data + first * cdist), output->data + first * rdist);
+    }
+
+    return 0;
+}
+
 #undef CONCAT2x
 #undef CONCAT2
 #undef CONCAT3x
@@ -466,6 +693,8 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
 #undef PLAN_TYPE
 #undef REAL_VECTOR_TYPE
 #undef COMPLEX_VECTOR_TYPE
+#undef REAL_VECTOR_SEQUENCE_TYPE
+#undef COMPLEX_VECTOR_SEQUENCE_TYPE
 
 #undef CREATE_PLAN_FUNCTION
 #undef CREATE_FORWARD_PLAN_FUNCTION
@@ -475,10 +704,18 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
 #undef REVERSE_FFT_FUNCTION
 #undef VECTOR_FFT_FUNCTION
 #undef POWER_SPECTRUM_FUNCTION
+#undef CREATE_MANY_PLAN_FUNCTION
+#undef FORWARD_MANY_FFT_FUNCTION
+#undef REVERSE_MANY_FFT_FUNCTION
 
 #undef CREALX
 #undef CIMAGX
 #undef FFTWX
+#undef FFTWX_COMPLEX
 #undef FFTWX_PLAN_R2R_1D
+#undef FFTWX_PLAN_MANY_DFT_R2C
+#undef FFTWX_PLAN_MANY_DFT_C2R
 #undef FFTWX_DESTROY_PLAN
 #undef FFTWX_EXECUTE_R2R
+#undef FFTWX_EXECUTE_DFT_R2C
+#undef FFTWX_EXECUTE_DFT_C2R
@@ -87,6 +87,8 @@ static const char *const iset_names[LAL_SIMD_ISET_MAX] = {
   [LAL_SIMD_ISET_SSE4_2]	= "SSE4.2",
   [LAL_SIMD_ISET_AVX]		= "AVX",
   [LAL_SIMD_ISET_AVX2]		= "AVX2",
+  [LAL_SIMD_ISET_AVX512F]	= "AVX512F",
+  [LAL_SIMD_ISET_AVX512DQ]	= "AVX512DQ",
 };
 
 /* pthread locking to make SIMD detection thread-safe */
@@ -110,7 +112,13 @@ static inline UNUSED void cpuid( uint32_t output[4], UNUSED int functionnumber )
 
 #if HAVE__GET_CPUID
 
-  __get_cpuid(functionnumber, &output[0], &output[1], &output[2], &output[3]);
+  /* __get_cpuid() does not set ecx, which selects the sub-leaf of e.g.
+     function 7, so check the function is supported and call __cpuid_count() */
+  if ((unsigned int) functionnumber > __get_cpuid_max(functionnumber & 0x80000000, 0)) {
+    output[0] = output[1] = output[2] = output[3] = 0;
+  } else {
+    __cpuid_count(functionnumber, 0, output[0], output[1], output[2], output[3]);
+  }
 
 #elif defined(__GNUC__) || defined(__clang__)	// weird case: gcc|clang but NO cpuid.h file, can happen on Macs for old gcc's: give up here
 
@@ -233,6 +241,15 @@ static LAL_SIMD_ISET detect_instruction_set(void) {
 #endif
   iset = LAL_SIMD_ISET_AVX2;				/* AVX2 detected */
 
+  if ((xgetbv(0) & 0xe0) != 0xe0) return iset;		/* AVX-512 not enabled in O.S. */
+  /* __builtin_cpu_supports() only accepts AVX-512 feature names from GCC 5 or 6 onwards, so always use cpuid */
+  cpuid(abcd, 7);					/* call cpuid function 7 for feature flags */
+  if ((abcd[1] & (1 << 16)) == 0) return iset;		/* no AVX-512F */
+  iset = LAL_SIMD_ISET_AVX512F;				/* AVX-512F detected */
+
+  if ((abcd[1] & (1 << 17)) == 0) return iset;		/* no AVX-512DQ */
+  iset = LAL_SIMD_ISET_AVX512DQ;			/* AVX-512DQ detected */
+
   return iset;
 
 }
@@ -55,6 +55,8 @@ typedef enum tagLAL_SIMD_ISET {
   LAL_SIMD_ISET_SSE4_2,		/**< SSE version 4.2 */
   LAL_SIMD_ISET_AVX,		/**< AVX (Advanced Vector Extensions) */
   LAL_SIMD_ISET_AVX2,		/**< AVX version 2 */
+  LAL_SIMD_ISET_AVX512F,	/**< AVX-512 Foundation */
+  LAL_SIMD_ISET_AVX512DQ,	/**< AVX-512 Doubleword and Quadword instructions */
 
   LAL_SIMD_ISET_MAX
 } LAL_SIMD_ISET;
@@ -79,6 +81,8 @@ const char *XLALSIMDInstructionSetName(LAL_SIMD_ISET iset);
 #define LAL_HAVE_SSE4_2_RUNTIME()	(XLALHaveSIMDInstructionSet(LAL_SIMD_ISET_SSE4_2))
 #define LAL_HAVE_AVX_RUNTIME()		(XLALHaveSIMDInstructionSet(LAL_SIMD_ISET_AVX))
 #define LAL_HAVE_AVX2_RUNTIME()		(XLALHaveSIMDInstructionSet(LAL_SIMD_ISET_AVX2))
+#define LAL_HAVE_AVX512F_RUNTIME()	(XLALHaveSIMDInstructionSet(LAL_SIMD_ISET_AVX512F))
+#define LAL_HAVE_AVX512DQ_RUNTIME()	(XLALHaveSIMDInstructionSet(LAL_SIMD_ISET_AVX512DQ))
 /** @} */
 
 /** @} */
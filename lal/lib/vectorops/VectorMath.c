@@ -125,86 +125,117 @@ DEFINE_ALIGNED_VECT_API(COMPLEX16);
 #define EXPORT_VECTORMATH_S2I(NAME, ...)                                     \
   EXPORT_VECTORMATH_ANY( NAME ## REAL4, (INT4 *out, const REAL4 *in, const UINT4 len), (out, in, len), __VA_ARGS__ )
 
-EXPORT_VECTORMATH_S2I(INT4From, SSE2, NONE, NONE, NONE)
+EXPORT_VECTORMATH_S2I(INT4From, AVX512F, SSE2, NONE, NONE)
 
 // ---------- define exported vector math functions with 1 REAL4 vector input to 1 REAL4 vector output (S2S) ----------
 #define EXPORT_VECTORMATH_S2S(NAME, ...)                                     \
   EXPORT_VECTORMATH_ANY( NAME ## REAL4, (REAL4 *out, const REAL4 *in, const UINT4 len), (out, in, len), __VA_ARGS__ )
 
-EXPORT_VECTORMATH_S2S(Sin, AVX2, AVX, SSE2, NONE)
-EXPORT_VECTORMATH_S2S(Cos, AVX2, AVX, SSE2, NONE)
-EXPORT_VECTORMATH_S2S(Exp, AVX2, AVX, SSE2, NONE)
-EXPORT_VECTORMATH_S2S(Log, AVX2, AVX, SSE2, NONE)
-EXPORT_VECTORMATH_S2S(Round, AVX2, AVX, NONE, NONE)
+EXPORT_VECTORMATH_S2S(Sin, AVX512F, AVX2, AVX, SSE2)
+EXPORT_VECTORMATH_S2S(Cos, AVX512F, AVX2, AVX, SSE2)
+EXPORT_VECTORMATH_S2S(Exp, AVX512F, AVX2, AVX, SSE2)
+EXPORT_VECTORMATH_S2S(Log, AVX512F, AVX2, AVX, SSE2)
+EXPORT_VECTORMATH_S2S(Round, AVX512F, AVX2, AVX, NONE)
 
 // ---------- define exported vector math functions with 1 REAL4 vector input to 2 REAL4 vector outputs (S2SS) ----------
 #define EXPORT_VECTORMATH_S2SS(NAME, ...)                                    \
   EXPORT_VECTORMATH_ANY( NAME ## REAL4, (REAL4 *out1, REAL4 *out2, const REAL4 *in, const UINT4 len), (out1, out2, in, len), __VA_ARGS__ )
 
-EXPORT_VECTORMATH_S2SS(SinCos, AVX2, AVX, SSE2, NONE)
-EXPORT_VECTORMATH_S2SS(SinCos2Pi, AVX2, AVX, SSE2, NONE)
+EXPORT_VECTORMATH_S2SS(SinCos, AVX512F, AVX2, AVX, SSE2)
+EXPORT_VECTORMATH_S2SS(SinCos2Pi, AVX512F, AVX2, AVX, SSE2)
 
 // ---------- define exported vector math functions with 2 REAL4 vector inputs to 1 REAL4 vector output (SS2S) ----------
 #define EXPORT_VECTORMATH_SS2S(NAME, ...)                                    \
   EXPORT_VECTORMATH_ANY( NAME ## REAL4, (REAL4 *out, const REAL4 *in1, const REAL4 *in2, const UINT4 len), (out, in1, in2, len), __VA_ARGS__ )
 
-EXPORT_VECTORMATH_SS2S(Add, AVX2, AVX, SSE2, NONE)
-EXPORT_VECTORMATH_SS2S(Sub, AVX2, AVX, SSE2, NONE)
-EXPORT_VECTORMATH_SS2S(Multiply, AVX2, AVX, SSE2, NONE)
-EXPORT_VECTORMATH_SS2S(Max, AVX2, AVX, SSE2, NONE)
+EXPORT_VECTORMATH_SS2S(Add, AVX512F, AVX2, AVX, SSE2)
+EXPORT_VECTORMATH_SS2S(Sub, AVX512F, AVX2, AVX, SSE2)
+EXPORT_VECTORMATH_SS2S(Multiply, AVX512F, AVX2, AVX, SSE2)
+EXPORT_VECTORMATH_SS2S(Max, AVX512F, AVX2, AVX, SSE2)
 
 // ---------- define exported vector math functions with 1 REAL4 scalar, 1 REAL4 vector inputs to 1 REAL4 vector output (sS2S) ----------
 #define EXPORT_VECTORMATH_sS2S(NAME, ...)                                    \
   EXPORT_VECTORMATH_ANY( NAME ## REAL4, (REAL4 *out, REAL4 scalar, const REAL4 *in, const UINT4 len), (out, scalar, in, len), __VA_ARGS__ )
 
-EXPORT_VECTORMATH_sS2S(Scale, AVX2, AVX, SSE2, NONE)
-EXPORT_VECTORMATH_sS2S(Shift, AVX2, AVX, SSE2, NONE)
+EXPORT_VECTORMATH_sS2S(Scale, AVX512F, AVX2, AVX, SSE2)
+EXPORT_VECTORMATH_sS2S(Shift, AVX512F, AVX2, AVX, SSE2)
 
 // ---------- define exported vector math functions with 2 REAL4 vector inputs to 1 UINT4 scalar and 1 UINT4 vector output (SS2uU) ----------
 #define EXPORT_VECTORMATH_SS2uU(NAME, ...)                            \
   EXPORT_VECTORMATH_ANY( NAME ## REAL4, ( UINT4* count, UINT4 *out, const REAL4 *in1, const REAL4 *in2, const UINT4 len ), (count, out, in1, in2, len), __VA_ARGS__ )
 
-EXPORT_VECTORMATH_SS2uU(FindVectorLessEqual, AVX2, SSSE3, NONE, NONE)
+EXPORT_VECTORMATH_SS2uU(FindVectorLessEqual, AVX512F, AVX2, SSSE3, NONE)
 
 // ---------- define exported vector math functions with 1 REAL4 scalar and 1 REAL4 vector inputs to 1 UINT4 scalar and 1 UINT4 vector output (sS2uU) ----------
 #define EXPORT_VECTORMATH_sS2uU(NAME, ...)                            \
   EXPORT_VECTORMATH_ANY( NAME ## REAL4, ( UINT4* count, UINT4 *out, REAL4 scalar, const REAL4 *in, const UINT4 len ), (count, out, scalar, in, len), __VA_ARGS__ )
 
-EXPORT_VECTORMATH_sS2uU(FindScalarLessEqual, AVX2, SSSE3, NONE, NONE)
+EXPORT_VECTORMATH_sS2uU(FindScalarLessEqual, AVX512F, AVX2, SSSE3, NONE)
 
 // ---------- define exported vector math functions with 1 REAL8 scalar, 1 REAL8 vector inputs to 1 REAL8 vector output (dD2D) ----------
 #define EXPORT_VECTORMATH_dD2D(NAME, ...)                                    \
   EXPORT_VECTORMATH_ANY( NAME ## REAL8, (REAL8 *out, REAL8 scalar, const REAL8 *in, const UINT4 len), (out, scalar, in, len), __VA_ARGS__ )
 
-EXPORT_VECTORMATH_dD2D(Scale, AVX2, AVX, SSE2, NONE)
-EXPORT_VECTORMATH_dD2D(Shift, AVX2, AVX, SSE2, NONE)
+EXPORT_VECTORMATH_dD2D(Scale, AVX512F, AVX2, AVX, SSE2)
+EXPORT_VECTORMATH_dD2D(Shift, AVX512F, AVX2, AVX, SSE2)
 
 // ---------- define exported vector math functions with 2 REAL8 vector inputs to 1 REAL8 vector output (DD2D) ----------
 #define EXPORT_VECTORMATH_DD2D(NAME, ...)                                    \
   EXPORT_VECTORMATH_ANY( NAME ## REAL8, (REAL8 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len), (out, in1, in2, len), __VA_ARGS__ )
 
-EXPORT_VECTORMATH_DD2D(Add, AVX2, AVX, SSE2, NONE)
-EXPORT_VECTORMATH_DD2D(Sub, AVX2, AVX, SSE2, NONE)
-EXPORT_VECTORMATH_DD2D(Multiply, AVX2, AVX, SSE2, NONE)
-EXPORT_VECTORMATH_DD2D(Max, AVX2, AVX, NONE, NONE)
+EXPORT_VECTORMATH_DD2D(Add, AVX512F, AVX2, AVX, SSE2)
+EXPORT_VECTORMATH_DD2D(Sub, AVX512F, AVX2, AVX, SSE2)
+EXPORT_VECTORMATH_DD2D(Multiply, AVX512F, AVX2, AVX, SSE2)
+EXPORT_VECTORMATH_DD2D(Max, AVX512F, AVX2, AVX, NONE)
 
 // ---------- define exported vector math functions with 2 COMPLEX8 vector inputs to 1 COMPLEX8 vector output (CC2C) ----------
 #define EXPORT_VECTORMATH_CC2C(NAME, ...)                                    \
   EXPORT_VECTORMATH_ANY( NAME ## COMPLEX8, (COMPLEX8 *out, const COMPLEX8 *in1, const COMPLEX8 *in2, const UINT4 len), (out, in1, in2, len), __VA_ARGS__ )
 
-EXPORT_VECTORMATH_CC2C(Multiply, AVX2, AVX, SSE2, NONE)
-EXPORT_VECTORMATH_CC2C(Add, AVX2, AVX, SSE2, NONE)
+EXPORT_VECTORMATH_CC2C(Multiply, AVX512F, AVX2, AVX, SSE2)
+EXPORT_VECTORMATH_CC2C(Add, AVX512F, AVX2, AVX, SSE2)
 
 // ---------- define exported vector math functions with 1 COMPLEX8 scalar and 1 COMPLEX8 vector inputs to 1 COMPLEX8 vector output (cC2C) ----------
 #define EXPORT_VECTORMATH_cC2C(NAME, ...)                                    \
   EXPORT_VECTORMATH_ANY( NAME ## COMPLEX8, (COMPLEX8 *out, COMPLEX8 scalar, const COMPLEX8 *in, const UINT4 len), (out, scalar, in, len), __VA_ARGS__ )
 
-EXPORT_VECTORMATH_cC2C(Scale, AVX2, AVX, SSE2, NONE)
-EXPORT_VECTORMATH_cC2C(Shift, AVX2, AVX, SSE2, NONE)
+EXPORT_VECTORMATH_cC2C(Scale, AVX512F, AVX2, AVX, SSE2)
+EXPORT_VECTORMATH_cC2C(Shift, AVX512F, AVX2, AVX, SSE2)
 
 // ---------- define exported vector math functions with 1 REAL8 vector input to 1 REAL8 vector output (D2D) ----------
 #define EXPORT_VECTORMATH_D2D(NAME, ...)                                     \
   EXPORT_VECTORMATH_ANY( NAME ## REAL8, (REAL8 *out, const REAL8 *in, const UINT4 len), (out, in, len), __VA_ARGS__ )
 
-EXPORT_VECTORMATH_D2D(Round, AVX2, AVX, NONE, NONE)
+EXPORT_VECTORMATH_D2D(Round, AVX512F, AVX2, AVX, NONE)
+EXPORT_VECTORMATH_D2D(Exp, AVX512F, AVX2, SSE2, NONE)
+
+// ---------- define exported vector math functions with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+#define EXPORT_VECTORMATH_D2DD(NAME, ...)                                    \
+  EXPORT_VECTORMATH_ANY( NAME ## REAL8, (REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len), (out1, out2, in, len), __VA_ARGS__ )
+
+EXPORT_VECTORMATH_D2DD(SinCos, AVX512F, AVX2, SSE2, NONE)
+
+// ---------- define exported vector math functions with 2 REAL8 vector inputs to 1 COMPLEX16 vector output (DD2Z) ----------
+#define EXPORT_VECTORMATH_DD2Z(NAME, ...)                                    \
+  EXPORT_VECTORMATH_ANY( NAME ## COMPLEX16, (COMPLEX16 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len), (out, in1, in2, len), __VA_ARGS__ )
+
+EXPORT_VECTORMATH_DD2Z(CExp, AVX512F, AVX2, SSE2, NONE)
+
+// ---------- define exported vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+#define EXPORT_VECTORMATH_ZZ2Z(NAME, ...)                                    \
+  EXPORT_VECTORMATH_ANY( NAME ## COMPLEX16, (COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len), (out, in1, in2, len), __VA_ARGS__ )
+
+EXPORT_VECTORMATH_ZZ2Z(Multiply, AVX512F, AVX2, AVX, SSE2)
+EXPORT_VECTORMATH_ZZ2Z(MultiplyConj, AVX512F, AVX2, AVX, SSE2)
+
+// ---------- define exported vector math functions with 2 COMPLEX16 vector inputs, summed to 1 COMPLEX16 scalar output (ZZ2z) ----------
+#define EXPORT_VECTORMATH_ZZ2z(NAME, ...)                                    \
+  EXPORT_VECTORMATH_ANY( NAME ## COMPLEX16, (COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len), (out, in1, in2, len), __VA_ARGS__ )
+
+EXPORT_VECTORMATH_ZZ2z(DotProduct, AVX512F, AVX2, AVX, SSE2)
+
+// ---------- define exported vector math function computing the weighted inner products of a COMPLEX16 vector with a time-shifted COMPLEX16 vector ----------
+EXPORT_VECTORMATH_ANY( TimeShiftedInnerProductsCOMPLEX16,
+                       (COMPLEX16 *dh, REAL8 *hh, REAL8 *dd, REAL8 *rr, const COMPLEX16 *d, const COMPLEX16 *h, const REAL8 *w, const REAL8 phi0, const REAL8 dphi, const UINT4 len),
+                       (dh, hh, dd, rr, d, h, w, phi0, dphi, len), AVX512F, AVX2, AVX, NONE )
 
@@ -44,6 +44,16 @@ extern "C" {
  *
  * Neither input nor output vectors are \b required to have any particular memory alignment. Nevertheless, performance
  * \e may be improved if vectors are 16-byte aligned for SSE, and 32-byte aligned for AVX.
+ *
+ * ### Accuracy of double-precision functions ###
+ *
+ * The SIMD implementations of XLALVectorSinCosREAL8() and XLALVectorCExpCOMPLEX16() have an absolute error in
+ * \f$\sin\f$ and \f$\cos\f$ below \f$2.5\times 10^{-16}\f$ for \f$|x| < 2^{28}\f$; beyond this the accuracy of the
+ * argument reduction degrades, and the results are meaningless for \f$|x| \ge 2^{51}\f$. The SIMD implementation of
+ * XLALVectorExpREAL8() has a relative error below \f$3.5\times 10^{-16}\f$ for results in the normal range of REAL8,
+ * and correctly underflows to zero and overflows to infinity. Complex multiplications are not rounded identically to
+ * the generic implementation, and XLALVectorDotProductCOMPLEX16() sums terms in a different order for each instruction set,
+ * so results agree with the generic implementation only to within rounding errors.
  */
 /** @{ */
 
@@ -162,6 +172,15 @@ int XLALVectorSinCosREAL4 ( REAL4 *out1, REAL4 *out2, const REAL4 *in, const UIN
 /** Compute \f$\text{out1} = \sin(2\pi \text{in}), \text{out2} = \cos(2\pi \text{in})\f$ over REAL4 vectors \c out1, \c out2, \c in with \c len elements */
 int XLALVectorSinCos2PiREAL4 ( REAL4 *out1, REAL4 *out2, const REAL4 *in, const UINT4 len );
 
+/** Compute \f$\text{out} = \exp(\text{in})\f$ over REAL8 vectors \c out, \c in with \c len elements */
+int XLALVectorExpREAL8 ( REAL8 *out, const REAL8 *in, const UINT4 len );
+
+/** Compute \f$\text{out1} = \sin(\text{in}), \text{out2} = \cos(\text{in})\f$ over REAL8 vectors \c out1, \c out2, \c in with \c len elements */
+int XLALVectorSinCosREAL8 ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len );
+
+/** Compute \f$\text{out} = \text{in1} \exp(i\,\text{in2})\f$ over COMPLEX16 vector \c out and REAL8 vectors \c in1 (amplitude), \c in2 (phase) with \c len elements */
+int XLALVectorCExpCOMPLEX16 ( COMPLEX16 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len );
+
 /** @} */
 
 /** \name Vector by Vector Operations */
@@ -197,6 +216,12 @@ int XLALVectorMultiplyCOMPLEX8 (  COMPLEX8 *out, const COMPLEX8 *in1, const COMP
 /** Compute \f$\text{out} = \text{in1} + \text{in2}\f$ over COMPLEX8 vectors \c in1 and \c in2 with \c len elements */
 int XLALVectorAddCOMPLEX8 ( COMPLEX8 *out, const COMPLEX8 *in1, const COMPLEX8 *in2, const UINT4 len);
 
+/** Compute \f$\text{out} = \text{in1} \times \text{in2}\f$ over COMPLEX16 vectors \c in1 and \c in2 with \c len elements */
+int XLALVectorMultiplyCOMPLEX16 ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len );
+
+/** Compute \f$\text{out} = \text{in1} \times \text{in2}^*\f$ over COMPLEX16 vectors \c in1 and \c in2 with \c len elements */
+int XLALVectorMultiplyConjCOMPLEX16 ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len );
+
 /** @} */
 
 /** \name Vector by Scalar Operations */
@@ -222,6 +247,28 @@ int XLALVectorShiftCOMPLEX8 ( COMPLEX8 *out, COMPLEX8 scalar, const COMPLEX8 *in
 
 /** @} */
 
+/** \name Vector Reduction Operations */
+/** @{ */
+
+/** Compute the inner product \f$\text{out} = \sum_i \text{in1}_i \times \text{in2}_i^*\f$ of COMPLEX16 vectors \c in1 and \c in2 with \c len elements */
+int XLALVectorDotProductCOMPLEX16 ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len );
+
+/**
+ * Compute the weighted inner products of COMPLEX16 vector \c d with COMPLEX16 vector \c h, after \c h has been multiplied by the
+ * phase ramp \f$e^{i\phi_k}\f$ with \f$\phi_k = \text{phi0} + k\,\text{dphi}\f$, i.e. shifted in time if \c d and \c h are
+ * frequency series. With \f$t_k = h_k e^{i\phi_k}\f$, and REAL8 weights \c w, the outputs are
+ * \f$\text{dh} = \sum_k w_k d_k t_k^*\f$, \f$\text{hh} = \sum_k w_k |h_k|^2\f$, \f$\text{dd} = \sum_k w_k |d_k|^2\f$, and
+ * \f$\text{rr} = \sum_k w_k |d_k - t_k|^2\f$, over vectors with \c len elements.
+ *
+ * The phase factors are computed by a recurrence \f$e^{i\phi_{k+n}} = e^{i\phi_k} + e^{i\phi_k} (e^{i n\,\text{dphi}} - 1)\f$,
+ * where \c n is the number of elements in a SIMD vector, whose error grows as \f$O(\sqrt{\text{len}})\f$ [Numerical Recipes,
+ * 3rd ed., Sec. 5.4]. Callers needing results independent of the vector length should therefore split long vectors into
+ * fixed-size blocks, and sum the results of each block in a fixed order.
+ */
+int XLALVectorTimeShiftedInnerProductsCOMPLEX16 ( COMPLEX16 *dh, REAL8 *hh, REAL8 *dd, REAL8 *rr, const COMPLEX16 *d, const COMPLEX16 *h, const REAL8 *w, const REAL8 phi0, const REAL8 dphi, const UINT4 len );
+
+/** @} */
+
 /** \name Vector Element Finding Operations */
 /** @{ */
 
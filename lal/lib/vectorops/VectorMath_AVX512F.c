@@ -0,0 +1,673 @@
+//
+// Copyright (C) 2026
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+// ---------- INCLUDES ----------
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <config.h>
+
+#include <lal/LALConstants.h>
+#include <lal/VectorMath.h>
+
+#include "VectorMath_internal.h"
+
+#ifndef __AVX512F__
+#error "VectorMath_AVX512F.c requires SIMD instruction set AVX512F"
+#endif
+
+#include "VectorMath_avx512_mathfun.h"
+
+// ---------- double-precision sincos512_pd() and exp512_pd() ----------
+#define PD_MATHFUN(name)	name##512_pd
+#define PD_V			__m512d
+#define PD_VI			__m512i
+#define PD_SET1			_mm512_set1_pd
+#define PD_SET1_EPI64		_mm512_set1_epi64
+#define PD_ADD			_mm512_add_pd
+#define PD_SUB			_mm512_sub_pd
+#define PD_MUL			_mm512_mul_pd
+#define PD_DIV			_mm512_div_pd
+#define PD_MIN			_mm512_min_pd
+#define PD_MAX			_mm512_max_pd
+#define PD_CASTPD_SI		_mm512_castpd_si512
+#define PD_CASTSI_PD		_mm512_castsi512_pd
+#define PD_AND_SI		_mm512_and_si512
+#define PD_ANDNOT_SI		_mm512_andnot_si512
+#define PD_OR_SI		_mm512_or_si512
+#define PD_XOR_SI		_mm512_xor_si512
+#define PD_ADD_EPI64		_mm512_add_epi64
+#define PD_SUB_EPI64		_mm512_sub_epi64
+#define PD_SLLI_EPI64		_mm512_slli_epi64
+#include "VectorMath_pd_mathfun.h"
+
+// ---------- local operators and operator-wrappers ----------
+UNUSED static inline __m512i
+local_cast_to_INT4 ( __m512 in1 )
+{
+  return _mm512_cvttps_epi32 ( in1 );
+}
+
+UNUSED static inline __m512
+local_add_ps ( __m512 in1, __m512 in2 )
+{
+  return _mm512_add_ps ( in1, in2 );
+}
+
+UNUSED static inline __m512
+local_sub_ps ( __m512 in1, __m512 in2 )
+{
+  return _mm512_sub_ps ( in1, in2 );
+}
+
+UNUSED static inline __m512
+local_mul_ps ( __m512 in1, __m512 in2 )
+{
+  return _mm512_mul_ps ( in1, in2 );
+}
+
+UNUSED static inline __m512
+local_max_ps ( __m512 in1, __m512 in2 )
+{
+  return _mm512_max_ps ( in1, in2 );
+}
+
+UNUSED static inline __m512d
+local_add_pd ( __m512d in1, __m512d in2 )
+{
+  return _mm512_add_pd ( in1, in2 );
+}
+
+UNUSED static inline __m512d
+local_sub_pd ( __m512d in1, __m512d in2 )
+{
+  return _mm512_sub_pd ( in1, in2 );
+}
+
+UNUSED static inline __m512d
+local_mul_pd ( __m512d in1, __m512d in2 )
+{
+  return _mm512_mul_pd ( in1, in2 );
+}
+
+UNUSED static inline __m512d
+local_max_pd ( __m512d in1, __m512d in2 )
+{
+  return _mm512_max_pd ( in1, in2 );
+}
+
+UNUSED static inline __m512
+local_round_ps ( __m512 in )
+{
+
+  __m512 result = _mm512_roundscale_ps ( in, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC );
+
+  //test if we had round half down to even
+  __m512 diff = _mm512_sub_ps ( _mm512_abs_ps ( result ), _mm512_abs_ps ( in ) );
+  __mmask16 cmp = _mm512_cmp_ps_mask ( diff, _mm512_set1_ps ( -0.5f ), _CMP_EQ_OQ );
+
+  //add or sub 1.0 to the 'rounded half down to even' values
+  __m512 zero = _mm512_setzero_ps ();
+  __m512 pos = _mm512_set1_ps ( 1.0f );
+  __mmask16 cmp_pos = _mm512_mask_cmp_ps_mask ( cmp, in, zero, _CMP_GT_OQ );
+  __mmask16 cmp_neg = _mm512_mask_cmp_ps_mask ( cmp, in, zero, _CMP_LT_OQ );
+  result = _mm512_mask_add_ps ( result, cmp_pos, result, pos );
+  result = _mm512_mask_sub_ps ( result, cmp_neg, result, pos );
+
+  return result;
+}
+
+UNUSED static inline __m512d
+local_round_pd ( __m512d in )
+{
+
+  __m512d result = _mm512_roundscale_pd ( in, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC );
+
+  //test if we had round half down to even
+  __m512d diff = _mm512_sub_pd ( _mm512_abs_pd ( result ), _mm512_abs_pd ( in ) );
+  __mmask8 cmp = _mm512_cmp_pd_mask ( diff, _mm512_set1_pd ( -0.5 ), _CMP_EQ_OQ );
+
+  //add or sub 1.0 to the 'rounded half down to even' values
+  __m512d zero = _mm512_setzero_pd ();
+  __m512d pos = _mm512_set1_pd ( 1.0 );
+  __mmask8 cmp_pos = _mm512_mask_cmp_pd_mask ( cmp, in, zero, _CMP_GT_OQ );
+  __mmask8 cmp_neg = _mm512_mask_cmp_pd_mask ( cmp, in, zero, _CMP_LT_OQ );
+  result = _mm512_mask_add_pd ( result, cmp_pos, result, pos );
+  result = _mm512_mask_sub_pd ( result, cmp_neg, result, pos );
+
+  return result;
+}
+
+// in1: a0,b0,a1,b1,...,a7,b7 in2: c0,d0,c1,d1,...,c7,d7
+UNUSED static inline __m512
+local_cmul_ps ( __m512 in1, __m512 in2 )
+{
+  // Duplicate the real and imaginary elements of in1
+  // a0,a0,a1,a1,... and b0,b0,b1,b1,...
+  __m512 re1 = _mm512_moveldup_ps ( in1 );
+  __m512 im1 = _mm512_movehdup_ps ( in1 );
+
+  // Switch the real and imaginary elements of in2
+  // d0,c0,d1,c1,...
+  __m512 in2_swap = _mm512_permute_ps ( in2, 0xb1 );
+
+  // a0c0, a0d0, a1c1, a1d1, ... and b0d0, b0c0, b1d1, b1c1, ...
+  __m512 temp1 = _mm512_mul_ps ( re1, in2 );
+  __m512 temp2 = _mm512_mul_ps ( im1, in2_swap );
+
+  // subtract in the real elements, add in the imaginary elements
+  // a0c0-b0d0, a0d0+b0c0, a1c1-b1d1, a1d1+b1c1, ...
+  return _mm512_mask_add_ps ( _mm512_sub_ps ( temp1, temp2 ), 0xAAAA, temp1, temp2 );
+}
+
+// in1: a0,b0,a1,b1,a2,b2,a3,b3 in2: c0,d0,c1,d1,c2,d2,c3,d3
+UNUSED static inline __m512d
+local_cmul_pd ( __m512d in1, __m512d in2 )
+{
+  // a0c0, a0d0, a1c1, a1d1, ... and b0d0, b0c0, b1d1, b1c1, ...
+  __m512d temp1 = _mm512_mul_pd ( _mm512_movedup_pd ( in1 ), in2 );
+  __m512d temp2 = _mm512_mul_pd ( _mm512_permute_pd ( in1, 0xFF ), _mm512_permute_pd ( in2, 0x55 ) );
+
+  // subtract in the real elements, add in the imaginary elements
+  // a0c0-b0d0, a0d0+b0c0, a1c1-b1d1, a1d1+b1c1, ...
+  return _mm512_mask_add_pd ( _mm512_sub_pd ( temp1, temp2 ), 0xAA, temp1, temp2 );
+}
+
+// in1: a0,b0,a1,b1,a2,b2,a3,b3 in2: c0,d0,c1,d1,c2,d2,c3,d3; returns in1 * conj(in2)
+UNUSED static inline __m512d
+local_cmulconj_pd ( __m512d in1, __m512d in2 )
+{
+  // a0c0, a0d0, a1c1, a1d1, ... and b0d0, b0c0, b1d1, b1c1, ...
+  __m512d temp1 = _mm512_mul_pd ( _mm512_movedup_pd ( in1 ), in2 );
+  __m512d temp2 = _mm512_mul_pd ( _mm512_permute_pd ( in1, 0xFF ), _mm512_permute_pd ( in2, 0x55 ) );
+
+  // add in the real elements, subtract in the imaginary elements
+  // a0c0+b0d0, b0c0-a0d0, a1c1+b1d1, b1c1-a1d1, ...
+  return _mm512_mask_sub_pd ( _mm512_add_pd ( temp1, temp2 ), 0xAA, temp2, temp1 );
+}
+
+// amp: A0,...,A7, phase: p0,...,p7; out1: A0 cos(p0), A0 sin(p0), ..., A3 cos(p3), A3 sin(p3), out2: same for 4,...,7
+UNUSED static inline void
+local_cexp_pd ( __m512d amp, __m512d phase, __m512d *out1, __m512d *out2 )
+{
+  __m512d s, c;
+  sincos512_pd ( phase, &s, &c );
+  s = _mm512_mul_pd ( amp, s );
+  c = _mm512_mul_pd ( amp, c );
+  // c0,s0,c2,s2,c4,s4,c6,s6 and c1,s1,c3,s3,c5,s5,c7,s7
+  __m512d lo = _mm512_unpacklo_pd ( c, s );
+  __m512d hi = _mm512_unpackhi_pd ( c, s );
+  (*out1) = _mm512_permutex2var_pd ( lo, _mm512_setr_epi64 ( 0, 1, 8, 9, 2, 3, 10, 11 ), hi );
+  (*out2) = _mm512_permutex2var_pd ( lo, _mm512_setr_epi64 ( 4, 5, 12, 13, 6, 7, 14, 15 ), hi );
+}
+
+// ========== internal generic AVX512F functions ==========
+
+//
+// The remaining terms at the end of each vector which do not fill a whole AVX-512 register are
+// handled using masked loads and stores, which never touch memory belonging to masked-out elements
+//
+
+// ---------- generic AVX512F operator with 1 REAL4 vector input to 1 INT4 vector output (S2I) ----------
+static inline int
+XLALVectorMath_S2I_AVX512F ( INT4 *out, const REAL4 *in, const UINT4 len, __m512i (*f)(__m512) )
+{
+
+  // walk through vector in blocks of 16
+  for ( UINT4 i16 = 0; i16 < len; i16 += 16 )
+    {
+      // deal with the remaining (<=15) terms with a partial mask
+      __mmask16 mask = ( len - i16 < 16 ) ? (__mmask16) ( ( 1U << ( len - i16 ) ) - 1 ) : (__mmask16) 0xFFFF;
+      __m512 in16p = _mm512_maskz_loadu_ps(mask, &in[i16]);
+      __m512i out16p = (*f)( in16p );
+      _mm512_mask_storeu_epi32(&out[i16], mask, out16p);
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_S2I_AVX512F()
+
+// ---------- generic AVX512F operator with 1 REAL4 vector input to 1 REAL4 vector output (S2S) ----------
+static inline int
+XLALVectorMath_S2S_AVX512F ( REAL4 *out, const REAL4 *in, const UINT4 len, __m512 (*f)(__m512) )
+{
+
+  // walk through vector in blocks of 16
+  for ( UINT4 i16 = 0; i16 < len; i16 += 16 )
+    {
+      // deal with the remaining (<=15) terms with a partial mask
+      __mmask16 mask = ( len - i16 < 16 ) ? (__mmask16) ( ( 1U << ( len - i16 ) ) - 1 ) : (__mmask16) 0xFFFF;
+      __m512 in16p = _mm512_maskz_loadu_ps(mask, &in[i16]);
+      __m512 out16p = (*f)( in16p );
+      _mm512_mask_storeu_ps(&out[i16], mask, out16p);
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_S2S_AVX512F()
+
+// ---------- generic AVX512F operator with 1 REAL4 vector input to 2 REAL4 vector outputs (S2SS) ----------
+static inline int
+XLALVectorMath_S2SS_AVX512F ( REAL4 *out1, REAL4 *out2, const REAL4 *in, const UINT4 len, void (*f)(__m512, __m512*, __m512*) )
+{
+
+  // walk through vector in blocks of 16
+  for ( UINT4 i16 = 0; i16 < len; i16 += 16 )
+    {
+      // deal with the remaining (<=15) terms with a partial mask
+      __mmask16 mask = ( len - i16 < 16 ) ? (__mmask16) ( ( 1U << ( len - i16 ) ) - 1 ) : (__mmask16) 0xFFFF;
+      __m512 in16p = _mm512_maskz_loadu_ps(mask, &in[i16]);
+      __m512 out16p_1, out16p_2;
+      (*f) ( in16p, &out16p_1, &out16p_2 );
+      _mm512_mask_storeu_ps(&out1[i16], mask, out16p_1);
+      _mm512_mask_storeu_ps(&out2[i16], mask, out16p_2);
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_S2SS_AVX512F()
+
+// ---------- generic AVX512F operator with 2 REAL4 vector inputs to 1 REAL4 vector output (SS2S) ----------
+static inline int
+XLALVectorMath_SS2S_AVX512F ( REAL4 *out, const REAL4 *in1, const REAL4 *in2, const UINT4 len, __m512 (*op)(__m512, __m512) )
+{
+
+  // walk through vector in blocks of 16
+  for ( UINT4 i16 = 0; i16 < len; i16 += 16 )
+    {
+      // deal with the remaining (<=15) terms with a partial mask
+      __mmask16 mask = ( len - i16 < 16 ) ? (__mmask16) ( ( 1U << ( len - i16 ) ) - 1 ) : (__mmask16) 0xFFFF;
+      __m512 in16p_1 = _mm512_maskz_loadu_ps(mask, &in1[i16]);
+      __m512 in16p_2 = _mm512_maskz_loadu_ps(mask, &in2[i16]);
+      __m512 out16p = (*op) ( in16p_1, in16p_2 );
+      _mm512_mask_storeu_ps(&out[i16], mask, out16p);
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_SS2S_AVX512F()
+
+// ---------- generic AVX512F operator with 1 REAL4 scalar and 1 REAL4 vector inputs to 1 REAL4 vector output (sS2S) ----------
+static inline int
+XLALVectorMath_sS2S_AVX512F ( REAL4 *out, REAL4 scalar, const REAL4 *in, const UINT4 len, __m512 (*op)(__m512, __m512) )
+{
+  const __m512 scalar16 = _mm512_set1_ps(scalar);
+
+  // walk through vector in blocks of 16
+  for ( UINT4 i16 = 0; i16 < len; i16 += 16 )
+    {
+      // deal with the remaining (<=15) terms with a partial mask
+      __mmask16 mask = ( len - i16 < 16 ) ? (__mmask16) ( ( 1U << ( len - i16 ) ) - 1 ) : (__mmask16) 0xFFFF;
+      __m512 in16p = _mm512_maskz_loadu_ps(mask, &in[i16]);
+      __m512 out16p = (*op) ( scalar16, in16p );
+      _mm512_mask_storeu_ps(&out[i16], mask, out16p);
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_sS2S_AVX512F()
+
+// ---------- generic AVX512F operator with 1 REAL8 scalar and 1 REAL8 vector inputs to 1 REAL8 vector output (dD2D) ----------
+static inline int
+XLALVectorMath_dD2D_AVX512F ( REAL8 *out, REAL8 scalar, const REAL8 *in, const UINT4 len, __m512d (*op)(__m512d, __m512d) )
+{
+  const __m512d scalar8 = _mm512_set1_pd(scalar);
+
+  // walk through vector in blocks of 8
+  for ( UINT4 i8 = 0; i8 < len; i8 += 8 )
+    {
+      // deal with the remaining (<=7) terms with a partial mask
+      __mmask8 mask = ( len - i8 < 8 ) ? (__mmask8) ( ( 1U << ( len - i8 ) ) - 1 ) : (__mmask8) 0xFF;
+      __m512d in8p = _mm512_maskz_loadu_pd(mask, &in[i8]);
+      __m512d out8p = (*op) ( scalar8, in8p );
+      _mm512_mask_storeu_pd(&out[i8], mask, out8p);
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_dD2D_AVX512F()
+
+// ---------- generic AVX512F operator with 2 REAL8 vector inputs to 1 REAL8 vector output (DD2D) ----------
+static inline int
+XLALVectorMath_DD2D_AVX512F ( REAL8 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len, __m512d (*op)(__m512d, __m512d) )
+{
+
+  // walk through vector in blocks of 8
+  for ( UINT4 i8 = 0; i8 < len; i8 += 8 )
+    {
+      // deal with the remaining (<=7) terms with a partial mask
+      __mmask8 mask = ( len - i8 < 8 ) ? (__mmask8) ( ( 1U << ( len - i8 ) ) - 1 ) : (__mmask8) 0xFF;
+      __m512d in8p_1 = _mm512_maskz_loadu_pd(mask, &in1[i8]);
+      __m512d in8p_2 = _mm512_maskz_loadu_pd(mask, &in2[i8]);
+      __m512d out8p = (*op) ( in8p_1, in8p_2 );
+      _mm512_mask_storeu_pd(&out[i8], mask, out8p);
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_DD2D_AVX512F()
+
+// ---------- generic AVX512F operator with 2 COMPLEX8 vector inputs to 1 COMPLEX8 vector output (CC2C) ----------
+static inline int
+XLALVectorMath_CC2C_AVX512F ( COMPLEX8 *out, const COMPLEX8 *in1, const COMPLEX8 *in2, const UINT4 len, __m512 (*op)(__m512, __m512) )
+{
+
+  // walk through vector in blocks of 8
+  for ( UINT4 i8 = 0; i8 < len; i8 += 8 )
+    {
+      // deal with the remaining (<=7) terms with a partial mask, covering both real and imaginary parts
+      __mmask16 mask = ( len - i8 < 8 ) ? (__mmask16) ( ( 1U << ( 2 * ( len - i8 ) ) ) - 1 ) : (__mmask16) 0xFFFF;
+      __m512 in16p_1 = _mm512_maskz_loadu_ps( mask, (const REAL4*)&in1[i8] );
+      __m512 in16p_2 = _mm512_maskz_loadu_ps( mask, (const REAL4*)&in2[i8] );
+      __m512 out16p = (*op) ( in16p_1, in16p_2 );
+      _mm512_mask_storeu_ps( (REAL4*)&out[i8], mask, out16p );
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_CC2C_AVX512F()
+
+// ---------- generic AVX512F operator with 1 COMPLEX8 scalar and 1 COMPLEX8 vector inputs to 1 COMPLEX8 vector output (cC2C) ----------
+static inline int
+XLALVectorMath_cC2C_AVX512F ( COMPLEX8 *out, COMPLEX8 scalar, const COMPLEX8 *in, const UINT4 len, __m512 (*op)(__m512, __m512) )
+{
+  const REAL4 re = crealf(scalar), im = cimagf(scalar);
+  const __m512 scalar16 = _mm512_setr_ps(re, im, re, im, re, im, re, im, re, im, re, im, re, im, re, im);
+
+  // walk through vector in blocks of 8
+  for ( UINT4 i8 = 0; i8 < len; i8 += 8 )
+    {
+      // deal with the remaining (<=7) terms with a partial mask, covering both real and imaginary parts
+      __mmask16 mask = ( len - i8 < 8 ) ? (__mmask16) ( ( 1U << ( 2 * ( len - i8 ) ) ) - 1 ) : (__mmask16) 0xFFFF;
+      __m512 in16p = _mm512_maskz_loadu_ps( mask, (const REAL4*)&in[i8] );
+      __m512 out16p = (*op) ( scalar16, in16p );
+      _mm512_mask_storeu_ps( (REAL4*)&out[i8], mask, out16p );
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_cC2C_AVX512F()
+
+// ---------- generic AVX512F operator with 1 REAL8 vector input to 1 REAL8 vector output (D2D) ----------
+static inline int
+XLALVectorMath_D2D_AVX512F ( REAL8 *out, const REAL8 *in, const UINT4 len, __m512d (*f)(__m512d) )
+{
+
+  // walk through vector in blocks of 8
+  for ( UINT4 i8 = 0; i8 < len; i8 += 8 )
+    {
+      // deal with the remaining (<=7) terms with a partial mask
+      __mmask8 mask = ( len - i8 < 8 ) ? (__mmask8) ( ( 1U << ( len - i8 ) ) - 1 ) : (__mmask8) 0xFF;
+      __m512d in8p = _mm512_maskz_loadu_pd(mask, &in[i8]);
+      __m512d out8p = (*f)( in8p );
+      _mm512_mask_storeu_pd(&out[i8], mask, out8p);
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_D2D_AVX512F()
+
+// ---------- generic AVX512F operator with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+static inline int
+XLALVectorMath_D2DD_AVX512F ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len, void (*f)(__m512d, __m512d*, __m512d*) )
+{
+
+  // walk through vector in blocks of 8
+  for ( UINT4 i8 = 0; i8 < len; i8 += 8 )
+    {
+      // deal with the remaining (<=7) terms with a partial mask
+      __mmask8 mask = ( len - i8 < 8 ) ? (__mmask8) ( ( 1U << ( len - i8 ) ) - 1 ) : (__mmask8) 0xFF;
+      __m512d in8p = _mm512_maskz_loadu_pd(mask, &in[i8]);
+      __m512d out8p_1, out8p_2;
+      (*f) ( in8p, &out8p_1, &out8p_2 );
+      _mm512_mask_storeu_pd(&out1[i8], mask, out8p_1);
+      _mm512_mask_storeu_pd(&out2[i8], mask, out8p_2);
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_D2DD_AVX512F()
+
+// ---------- generic AVX512F operator with 2 REAL8 vector inputs to 1 COMPLEX16 vector output (DD2Z) ----------
+static inline int
+XLALVectorMath_DD2Z_AVX512F ( COMPLEX16 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len, void (*op)(__m512d, __m512d, __m512d*, __m512d*) )
+{
+
+  // walk through vector in blocks of 8
+  for ( UINT4 i8 = 0; i8 < len; i8 += 8 )
+    {
+      // deal with the remaining (<=7) terms with partial masks; each output covers 4 real and imaginary parts
+      UINT4 rem = len - i8;
+      __mmask8 mask = ( rem < 8 ) ? (__mmask8) ( ( 1U << rem ) - 1 ) : (__mmask8) 0xFF;
+      __mmask8 mask_1 = ( rem < 4 ) ? (__mmask8) ( ( 1U << ( 2 * rem ) ) - 1 ) : (__mmask8) 0xFF;
+      __mmask8 mask_2 = ( rem < 8 ) ? (__mmask8) ( ( 1U << ( 2 * ( rem > 4 ? rem - 4 : 0 ) ) ) - 1 ) : (__mmask8) 0xFF;
+      __m512d in8p_1 = _mm512_maskz_loadu_pd(mask, &in1[i8]);
+      __m512d in8p_2 = _mm512_maskz_loadu_pd(mask, &in2[i8]);
+      __m512d out8p_1, out8p_2;
+      (*op) ( in8p_1, in8p_2, &out8p_1, &out8p_2 );
+      _mm512_mask_storeu_pd( (REAL8*)&out[i8], mask_1, out8p_1 );
+      _mm512_mask_storeu_pd( (REAL8*)&out[i8+4], mask_2, out8p_2 );
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_DD2Z_AVX512F()
+
+// ---------- generic AVX512F operator with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+static inline int
+XLALVectorMath_ZZ2Z_AVX512F ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len, __m512d (*op)(__m512d, __m512d) )
+{
+
+  // walk through vector in blocks of 4
+  for ( UINT4 i4 = 0; i4 < len; i4 += 4 )
+    {
+      // deal with the remaining (<=3) terms with a partial mask, covering both real and imaginary parts
+      __mmask8 mask = ( len - i4 < 4 ) ? (__mmask8) ( ( 1U << ( 2 * ( len - i4 ) ) ) - 1 ) : (__mmask8) 0xFF;
+      __m512d in8p_1 = _mm512_maskz_loadu_pd( mask, (const REAL8*)&in1[i4] );
+      __m512d in8p_2 = _mm512_maskz_loadu_pd( mask, (const REAL8*)&in2[i4] );
+      __m512d out8p = (*op) ( in8p_1, in8p_2 );
+      _mm512_mask_storeu_pd( (REAL8*)&out[i4], mask, out8p );
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_ZZ2Z_AVX512F()
+
+// ---------- generic AVX512F operator with 2 COMPLEX16 vector inputs, summed to 1 COMPLEX16 scalar output (ZZ2z) ----------
+static inline int
+XLALVectorMath_ZZ2z_AVX512F ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len, __m512d (*op)(__m512d, __m512d) )
+{
+
+  // walk through vector in blocks of 4
+  __m512d sum8p = _mm512_setzero_pd();
+  for ( UINT4 i4 = 0; i4 < len; i4 += 4 )
+    {
+      // deal with the remaining (<=3) terms with a partial mask; masked-out elements are zero and do not contribute to the sum
+      __mmask8 mask = ( len - i4 < 4 ) ? (__mmask8) ( ( 1U << ( 2 * ( len - i4 ) ) ) - 1 ) : (__mmask8) 0xFF;
+      __m512d in8p_1 = _mm512_maskz_loadu_pd( mask, (const REAL8*)&in1[i4] );
+      __m512d in8p_2 = _mm512_maskz_loadu_pd( mask, (const REAL8*)&in2[i4] );
+      sum8p = _mm512_add_pd( sum8p, (*op) ( in8p_1, in8p_2 ) );
+    }
+
+  REAL8 sum8[8];
+  _mm512_storeu_pd( sum8, sum8p );
+  (*out) = crect( ( sum8[0] + sum8[2] ) + ( sum8[4] + sum8[6] ), ( sum8[1] + sum8[3] ) + ( sum8[5] + sum8[7] ) );
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_ZZ2z_AVX512F()
+
+// ---------- AVX512F weighted inner products of a COMPLEX16 vector with a time-shifted COMPLEX16 vector ----------
+static inline int
+XLALVectorMath_TimeShiftedInnerProducts_AVX512F ( COMPLEX16 *dh, REAL8 *hh, REAL8 *dd, REAL8 *rr, const COMPLEX16 *d, const COMPLEX16 *h, const REAL8 *w, const REAL8 phi0, const REAL8 dphi, const UINT4 len )
+{
+
+  // phase factors of elements 0,...,3, and their increment over 4 elements, using cos(x) - 1 = -2 sin(x/2)^2
+  __m512d s8p = _mm512_setr_pd( cos ( phi0 ), sin ( phi0 ), cos ( phi0 + dphi ), sin ( phi0 + dphi ),
+                                cos ( phi0 + 2.0 * dphi ), sin ( phi0 + 2.0 * dphi ), cos ( phi0 + 3.0 * dphi ), sin ( phi0 + 3.0 * dphi ) );
+  const REAL8 dre = -2.0 * sin ( 2.0 * dphi ) * sin ( 2.0 * dphi ), dim = sin ( 4.0 * dphi );
+  const __m512d ds8p = _mm512_setr_pd( dre, dim, dre, dim, dre, dim, dre, dim );
+
+  // w0,w0,w1,w1,w2,w2,w3,w3
+  const __m512i widx = _mm512_setr_epi64( 0, 0, 1, 1, 2, 2, 3, 3 );
+
+  // walk through vector in blocks of 4
+  __m512d dh8p = _mm512_setzero_pd(), hh8p = _mm512_setzero_pd(), dd8p = _mm512_setzero_pd(), rr8p = _mm512_setzero_pd();
+  for ( UINT4 i4 = 0; i4 < len; i4 += 4 )
+    {
+      // deal with the remaining (<=3) terms with a partial mask; masked-out elements are zero and do not contribute to the sums
+      const UINT4 n = ( len - i4 < 4 ) ? len - i4 : 4;
+      __mmask8 mask = (__mmask8) ( ( 1U << ( 2 * n ) ) - 1 );
+      __mmask8 wmask = (__mmask8) ( ( 1U << n ) - 1 );
+      __m512d d8p = _mm512_maskz_loadu_pd( mask, (const REAL8*)&d[i4] );
+      __m512d h8p = _mm512_maskz_loadu_pd( mask, (const REAL8*)&h[i4] );
+      __m512d w8p = _mm512_permutexvar_pd( widx, _mm512_maskz_loadu_pd( wmask, &w[i4] ) );
+
+      __m512d t8p = local_cmul_pd ( h8p, s8p );
+      __m512d r8p = _mm512_sub_pd( d8p, t8p );
+      dh8p = _mm512_add_pd( dh8p, local_cmulconj_pd ( _mm512_mul_pd( w8p, d8p ), t8p ) );
+      hh8p = _mm512_add_pd( hh8p, _mm512_mul_pd( w8p, _mm512_mul_pd( h8p, h8p ) ) );
+      dd8p = _mm512_add_pd( dd8p, _mm512_mul_pd( w8p, _mm512_mul_pd( d8p, d8p ) ) );
+      rr8p = _mm512_add_pd( rr8p, _mm512_mul_pd( w8p, _mm512_mul_pd( r8p, r8p ) ) );
+
+      s8p = _mm512_add_pd( s8p, local_cmul_pd ( s8p, ds8p ) );
+    }
+
+  REAL8 dh8[8], hh8[8], dd8[8], rr8[8];
+  _mm512_storeu_pd( dh8, dh8p );
+  _mm512_storeu_pd( hh8, hh8p );
+  _mm512_storeu_pd( dd8, dd8p );
+  _mm512_storeu_pd( rr8, rr8p );
+  (*dh) = crect( ( dh8[0] + dh8[2] ) + ( dh8[4] + dh8[6] ), ( dh8[1] + dh8[3] ) + ( dh8[5] + dh8[7] ) );
+  (*hh) = ( ( hh8[0] + hh8[1] ) + ( hh8[2] + hh8[3] ) ) + ( ( hh8[4] + hh8[5] ) + ( hh8[6] + hh8[7] ) );
+  (*dd) = ( ( dd8[0] + dd8[1] ) + ( dd8[2] + dd8[3] ) ) + ( ( dd8[4] + dd8[5] ) + ( dd8[6] + dd8[7] ) );
+  (*rr) = ( ( rr8[0] + rr8[1] ) + ( rr8[2] + rr8[3] ) ) + ( ( rr8[4] + rr8[5] ) + ( rr8[6] + rr8[7] ) );
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_TimeShiftedInnerProducts_AVX512F()
+
+// ========== internal AVX512F vector math functions ==========
+
+// ---------- define vector math functions with 1 REAL4 vector input to 1 INT4 vector output (S2I) ----------
+#define DEFINE_VECTORMATH_S2I(NAME, AVX512_OP)                          \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_S2I_AVX512F, NAME ## REAL4, ( INT4 *out, const REAL4 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, AVX512_OP ) )
+
+DEFINE_VECTORMATH_S2I(INT4From, local_cast_to_INT4)
+
+// ---------- define vector math functions with 1 REAL4 vector input to 1 REAL4 vector output (S2S) ----------
+#define DEFINE_VECTORMATH_S2S(NAME, AVX512_OP)                          \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_S2S_AVX512F, NAME ## REAL4, ( REAL4 *out, const REAL4 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, AVX512_OP ) )
+
+DEFINE_VECTORMATH_S2S(Sin, sin512_ps)
+DEFINE_VECTORMATH_S2S(Cos, cos512_ps)
+DEFINE_VECTORMATH_S2S(Exp, exp512_ps)
+DEFINE_VECTORMATH_S2S(Log, log512_ps)
+DEFINE_VECTORMATH_S2S(Round, local_round_ps)
+
+// ---------- define vector math functions with 1 REAL4 vector input to 2 REAL4 vector outputs (S2SS) ----------
+#define DEFINE_VECTORMATH_S2SS(NAME, AVX512_OP)                         \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_S2SS_AVX512F, NAME ## REAL4, ( REAL4 *out1, REAL4 *out2, const REAL4 *in, const UINT4 len ), ( (out1 != NULL) && (out2 != NULL) && (in != NULL) ), ( out1, out2, in, len, AVX512_OP ) )
+
+DEFINE_VECTORMATH_S2SS(SinCos, sincos512_ps)
+DEFINE_VECTORMATH_S2SS(SinCos2Pi, sincos512_ps_2pi)
+
+// ---------- define vector math functions with 2 REAL4 vector inputs to 1 REAL4 vector output (SS2S) ----------
+#define DEFINE_VECTORMATH_SS2S(NAME, AVX512_OP)                         \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_SS2S_AVX512F, NAME ## REAL4, ( REAL4 *out, const REAL4 *in1, const REAL4 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, AVX512_OP ) )
+
+DEFINE_VECTORMATH_SS2S(Add, local_add_ps)
+DEFINE_VECTORMATH_SS2S(Sub, local_sub_ps)
+DEFINE_VECTORMATH_SS2S(Multiply, local_mul_ps)
+DEFINE_VECTORMATH_SS2S(Max, local_max_ps)
+
+// ---------- define vector math functions with 1 REAL4 scalar and 1 REAL4 vector inputs to 1 REAL4 vector output (sS2S) ----------
+#define DEFINE_VECTORMATH_sS2S(NAME, AVX512_OP)                         \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_sS2S_AVX512F, NAME ## REAL4, ( REAL4 *out, REAL4 scalar, const REAL4 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, scalar, in, len, AVX512_OP ) )
+
+DEFINE_VECTORMATH_sS2S(Shift, local_add_ps)
+DEFINE_VECTORMATH_sS2S(Scale, local_mul_ps)
+
+// ---------- define vector math functions with 1 REAL8 scalar and 1 REAL8 vector inputs to 1 REAL8 vector output (dD2D) ----------
+#define DEFINE_VECTORMATH_dD2D(NAME, AVX512_OP)                         \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_dD2D_AVX512F, NAME ## REAL8, ( REAL8 *out, REAL8 scalar, const REAL8 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, scalar, in, len, AVX512_OP ) )
+
+DEFINE_VECTORMATH_dD2D(Scale, local_mul_pd)
+DEFINE_VECTORMATH_dD2D(Shift, local_add_pd)
+
+// ---------- define vector math functions with 2 REAL8 vector inputs to 1 REAL8 vector output (DD2D) ----------
+#define DEFINE_VECTORMATH_DD2D(NAME, AVX512_OP)                         \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_DD2D_AVX512F, NAME ## REAL8, ( REAL8 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, AVX512_OP ) )
+
+DEFINE_VECTORMATH_DD2D(Add, local_add_pd)
+DEFINE_VECTORMATH_DD2D(Sub, local_sub_pd)
+DEFINE_VECTORMATH_DD2D(Multiply, local_mul_pd)
+DEFINE_VECTORMATH_DD2D(Max, local_max_pd)
+
+// ---------- define vector math functions with 2 COMPLEX8 vector inputs to 1 COMPLEX8 vector output (CC2C) ----------
+#define DEFINE_VECTORMATH_CC2C(NAME, AVX512_OP)                         \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_CC2C_AVX512F, NAME ## COMPLEX8, ( COMPLEX8 *out, const COMPLEX8 *in1, const COMPLEX8 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, AVX512_OP ) )
+
+DEFINE_VECTORMATH_CC2C(Multiply, local_cmul_ps)
+DEFINE_VECTORMATH_CC2C(Add, local_add_ps)
+
+// ---------- define vector math functions with 1 COMPLEX8 scalar and 1 COMPLEX8 vector inputs to 1 COMPLEX8 vector output (cC2C) ----------
+#define DEFINE_VECTORMATH_cC2C(NAME, AVX512_OP)                         \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_cC2C_AVX512F, NAME ## COMPLEX8, ( COMPLEX8 *out, COMPLEX8 scalar, const COMPLEX8 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, scalar, in, len, AVX512_OP ) )
+
+DEFINE_VECTORMATH_cC2C(Scale, local_cmul_ps)
+DEFINE_VECTORMATH_cC2C(Shift, local_add_ps)
+
+// ---------- define vector math functions with 1 REAL8 vector input to 1 REAL8 vector output (D2D) ----------
+#define DEFINE_VECTORMATH_D2D(NAME, AVX512_OP)                          \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_D2D_AVX512F, NAME ## REAL8, ( REAL8 *out, const REAL8 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, AVX512_OP ) )
+
+DEFINE_VECTORMATH_D2D(Round, local_round_pd)
+DEFINE_VECTORMATH_D2D(Exp, exp512_pd)
+
+// ---------- define vector math functions with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+#define DEFINE_VECTORMATH_D2DD(NAME, AVX512_OP)                         \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_D2DD_AVX512F, NAME ## REAL8, ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len ), ( (out1 != NULL) && (out2 != NULL) && (in != NULL) ), ( out1, out2, in, len, AVX512_OP ) )
+
+DEFINE_VECTORMATH_D2DD(SinCos, sincos512_pd)
+
+// ---------- define vector math functions with 2 REAL8 vector inputs to 1 COMPLEX16 vector output (DD2Z) ----------
+#define DEFINE_VECTORMATH_DD2Z(NAME, AVX512_OP)                         \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_DD2Z_AVX512F, NAME ## COMPLEX16, ( COMPLEX16 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, AVX512_OP ) )
+
+DEFINE_VECTORMATH_DD2Z(CExp, local_cexp_pd)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+#define DEFINE_VECTORMATH_ZZ2Z(NAME, AVX512_OP)                         \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZ2Z_AVX512F, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, AVX512_OP ) )
+
+DEFINE_VECTORMATH_ZZ2Z(Multiply, local_cmul_pd)
+DEFINE_VECTORMATH_ZZ2Z(MultiplyConj, local_cmulconj_pd)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector inputs, summed to 1 COMPLEX16 scalar output (ZZ2z) ----------
+#define DEFINE_VECTORMATH_ZZ2z(NAME, AVX512_OP)                         \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZ2z_AVX512F, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, AVX512_OP ) )
+
+DEFINE_VECTORMATH_ZZ2z(DotProduct, local_cmulconj_pd)
+
+// ---------- define vector math function computing the weighted inner products of a COMPLEX16 vector with a time-shifted COMPLEX16 vector ----------
+DEFINE_VECTORMATH_ANY( XLALVectorMath_TimeShiftedInnerProducts_AVX512F, TimeShiftedInnerProductsCOMPLEX16,
+                       ( COMPLEX16 *dh, REAL8 *hh, REAL8 *dd, REAL8 *rr, const COMPLEX16 *d, const COMPLEX16 *h, const REAL8 *w, const REAL8 phi0, const REAL8 dphi, const UINT4 len ),
+                       ( (dh != NULL) && (hh != NULL) && (dd != NULL) && (rr != NULL) && (d != NULL) && (h != NULL) && (w != NULL) ),
+                       ( dh, hh, dd, rr, d, h, w, phi0, dphi, len ) )
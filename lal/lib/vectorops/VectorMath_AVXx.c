@@ -35,6 +35,31 @@
 
 #include "VectorMath_avx_mathfun.h"
 
+// ---------- double-precision sincos256_pd() and exp256_pd(); these require AVX2 integer instructions ----------
+#ifdef __AVX2__
+#define PD_MATHFUN(name)	name##256_pd
+#define PD_V			__m256d
+#define PD_VI			__m256i
+#define PD_SET1			_mm256_set1_pd
+#define PD_SET1_EPI64		_mm256_set1_epi64x
+#define PD_ADD			_mm256_add_pd
+#define PD_SUB			_mm256_sub_pd
+#define PD_MUL			_mm256_mul_pd
+#define PD_DIV			_mm256_div_pd
+#define PD_MIN			_mm256_min_pd
+#define PD_MAX			_mm256_max_pd
+#define PD_CASTPD_SI		_mm256_castpd_si256
+#define PD_CASTSI_PD		_mm256_castsi256_pd
+#define PD_AND_SI		_mm256_and_si256
+#define PD_ANDNOT_SI		_mm256_andnot_si256
+#define PD_OR_SI		_mm256_or_si256
+#define PD_XOR_SI		_mm256_xor_si256
+#define PD_ADD_EPI64		_mm256_add_epi64
+#define PD_SUB_EPI64		_mm256_sub_epi64
+#define PD_SLLI_EPI64		_mm256_slli_epi64
+#include "VectorMath_pd_mathfun.h"
+#endif
+
 // ---------- local operators and operator-wrappers ----------
 UNUSED static inline __m256
 local_add_ps ( __m256 in1, __m256 in2 )
@@ -184,6 +209,47 @@ local_cmul_ps ( __m256 in1, __m256 in2 )
   return _mm256_permute_ps(in2, 0xd8);
 }
 
+// in1: a0,b0,a1,b1 in2: c0,d0,c1,d1
+UNUSED static inline __m256d
+local_cmul_pd ( __m256d in1, __m256d in2 )
+{
+  // a0c0, a0d0, a1c1, a1d1
+  __m256d temp1 = _mm256_mul_pd ( _mm256_movedup_pd ( in1 ), in2 );
+  // b0d0, b0c0, b1d1, b1c1
+  __m256d temp2 = _mm256_mul_pd ( _mm256_permute_pd ( in1, 0xF ), _mm256_permute_pd ( in2, 0x5 ) );
+  // a0c0 - b0d0, a0d0 + b0c0, ...
+  return _mm256_addsub_pd ( temp1, temp2 );
+}
+
+// in1: a0,b0,a1,b1 in2: c0,d0,c1,d1; returns in1 * conj(in2)
+UNUSED static inline __m256d
+local_cmulconj_pd ( __m256d in1, __m256d in2 )
+{
+  // a0c0, a0d0, a1c1, a1d1
+  __m256d temp1 = _mm256_mul_pd ( _mm256_movedup_pd ( in1 ), in2 );
+  // b0d0, b0c0, b1d1, b1c1
+  __m256d temp2 = _mm256_mul_pd ( _mm256_permute_pd ( in1, 0xF ), _mm256_permute_pd ( in2, 0x5 ) );
+  // b0d0 + a0c0, b0c0 - a0d0, ...
+  return _mm256_add_pd ( temp2, _mm256_xor_pd ( temp1, _mm256_setr_pd ( 0.0, -0.0, 0.0, -0.0 ) ) );
+}
+
+#ifdef __AVX2__
+// amp: A0,...,A3, phase: p0,...,p3; out1: A0 cos(p0), A0 sin(p0), A1 cos(p1), A1 sin(p1), out2: same for 2,3
+UNUSED static inline void
+local_cexp_pd ( __m256d amp, __m256d phase, __m256d *out1, __m256d *out2 )
+{
+  __m256d s, c;
+  sincos256_pd ( phase, &s, &c );
+  s = _mm256_mul_pd ( amp, s );
+  c = _mm256_mul_pd ( amp, c );
+  // c0,s0,c2,s2 and c1,s1,c3,s3
+  __m256d lo = _mm256_unpacklo_pd ( c, s );
+  __m256d hi = _mm256_unpackhi_pd ( c, s );
+  (*out1) = _mm256_permute2f128_pd ( lo, hi, 0x20 );
+  (*out2) = _mm256_permute2f128_pd ( lo, hi, 0x31 );
+}
+#endif
+
 // ========== internal generic AVXx functions ==========
 
 // ---------- generic AVXx operator with 1 REAL4 vector input to 1 REAL4 vector output (S2S) ----------
@@ -468,6 +534,195 @@ XLALVectorMath_D2D_AVXx ( REAL8 *out, const REAL8 *in, const UINT4 len, __m256d
 
 } // XLALVectorMath_D2D_AVXx()
 
+// ---------- generic AVXx operator with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+static inline int
+XLALVectorMath_D2DD_AVXx ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len, void (*f)(__m256d, __m256d*, __m256d*) )
+{
+
+  // walk through vector in blocks of 4
+  UINT4 i4Max = len - ( len % 4 );
+  for ( UINT4 i4 = 0; i4 < i4Max; i4 += 4 )
+    {
+      __m256d in4p = _mm256_loadu_pd(&in[i4]);
+      __m256d out4p_1, out4p_2;
+      (*f) ( in4p, &out4p_1, &out4p_2 );
+      _mm256_storeu_pd(&out1[i4], out4p_1);
+      _mm256_storeu_pd(&out2[i4], out4p_2);
+    }
+
+  // deal with the remaining (<=3) terms separately
+  V4SD in4 = {.f={0,0,0,0}}, out4_1, out4_2;
+  for ( UINT4 i = i4Max,j=0; i < len; i ++, j++ ) {
+    in4.f[j] = in[i];
+  }
+  (*f) ( in4.v, &out4_1.v, &out4_2.v );
+  for ( UINT4 i = i4Max,j=0; i < len; i ++, j++ ) {
+    out1[i] = out4_1.f[j];
+    out2[i] = out4_2.f[j];
+  }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_D2DD_AVXx()
+
+// ---------- generic AVXx operator with 2 REAL8 vector inputs to 1 COMPLEX16 vector output (DD2Z) ----------
+static inline int
+XLALVectorMath_DD2Z_AVXx ( COMPLEX16 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len, void (*op)(__m256d, __m256d, __m256d*, __m256d*) )
+{
+
+  // walk through vector in blocks of 4
+  UINT4 i4Max = len - ( len % 4 );
+  for ( UINT4 i4 = 0; i4 < i4Max; i4 += 4 )
+    {
+      __m256d in4p_1 = _mm256_loadu_pd(&in1[i4]);
+      __m256d in4p_2 = _mm256_loadu_pd(&in2[i4]);
+      __m256d out4p_1, out4p_2;
+      (*op) ( in4p_1, in4p_2, &out4p_1, &out4p_2 );
+      _mm256_storeu_pd( (REAL8*)&out[i4], out4p_1 );
+      _mm256_storeu_pd( (REAL8*)&out[i4+2], out4p_2 );
+    }
+
+  // deal with the remaining (<=3) terms separately
+  V4SD in4_1 = {.f={0,0,0,0}};
+  V4SD in4_2 = {.f={0,0,0,0}};
+  V4SD out4[2];
+  for ( UINT4 i = i4Max,j=0; i < len; i ++, j++ ) {
+    in4_1.f[j] = in1[i];
+    in4_2.f[j] = in2[i];
+  }
+  (*op) ( in4_1.v, in4_2.v, &out4[0].v, &out4[1].v );
+  for ( UINT4 i = i4Max,j=0; i < len; i ++, j++ ) {
+    out[i] = crect( out4[j/2].f[2*(j%2)], out4[j/2].f[2*(j%2)+1] );
+  }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_DD2Z_AVXx()
+
+// ---------- generic AVXx operator with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+static inline int
+XLALVectorMath_ZZ2Z_AVXx ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len, __m256d (*op)(__m256d, __m256d) )
+{
+
+  // walk through vector in blocks of 2
+  UINT4 i2Max = len - ( len % 2 );
+  for ( UINT4 i2 = 0; i2 < i2Max; i2 += 2 )
+    {
+      __m256d in4p_1 = _mm256_loadu_pd( (const REAL8*)&in1[i2] );
+      __m256d in4p_2 = _mm256_loadu_pd( (const REAL8*)&in2[i2] );
+      __m256d out4p = (*op) ( in4p_1, in4p_2 );
+      _mm256_storeu_pd( (REAL8*)&out[i2], out4p );
+    }
+
+  // deal with the remaining (<=1) term separately
+  if ( i2Max < len ) {
+    V4SD in4_1 = {.f={creal(in1[i2Max]),cimag(in1[i2Max]),0,0}};
+    V4SD in4_2 = {.f={creal(in2[i2Max]),cimag(in2[i2Max]),0,0}};
+    V4SD out4;
+    out4.v = (*op) ( in4_1.v, in4_2.v );
+    out[i2Max] = crect( out4.f[0], out4.f[1] );
+  }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_ZZ2Z_AVXx()
+
+// ---------- generic AVXx operator with 2 COMPLEX16 vector inputs, summed to 1 COMPLEX16 scalar output (ZZ2z) ----------
+static inline int
+XLALVectorMath_ZZ2z_AVXx ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len, __m256d (*op)(__m256d, __m256d) )
+{
+
+  // walk through vector in blocks of 2
+  __m256d sum4p = _mm256_setzero_pd();
+  UINT4 i2Max = len - ( len % 2 );
+  for ( UINT4 i2 = 0; i2 < i2Max; i2 += 2 )
+    {
+      __m256d in4p_1 = _mm256_loadu_pd( (const REAL8*)&in1[i2] );
+      __m256d in4p_2 = _mm256_loadu_pd( (const REAL8*)&in2[i2] );
+      sum4p = _mm256_add_pd( sum4p, (*op) ( in4p_1, in4p_2 ) );
+    }
+
+  // deal with the remaining (<=1) term separately; zero padding does not contribute to the sum
+  if ( i2Max < len ) {
+    V4SD in4_1 = {.f={creal(in1[i2Max]),cimag(in1[i2Max]),0,0}};
+    V4SD in4_2 = {.f={creal(in2[i2Max]),cimag(in2[i2Max]),0,0}};
+    sum4p = _mm256_add_pd( sum4p, (*op) ( in4_1.v, in4_2.v ) );
+  }
+
+  V4SD sum4;
+  sum4.v = sum4p;
+  (*out) = crect( sum4.f[0] + sum4.f[2], sum4.f[1] + sum4.f[3] );
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_ZZ2z_AVXx()
+
+// ---------- AVXx weighted inner products of a COMPLEX16 vector with a time-shifted COMPLEX16 vector ----------
+static inline int
+XLALVectorMath_TimeShiftedInnerProducts_AVXx ( COMPLEX16 *dh, REAL8 *hh, REAL8 *dd, REAL8 *rr, const COMPLEX16 *d, const COMPLEX16 *h, const REAL8 *w, const REAL8 phi0, const REAL8 dphi, const UINT4 len )
+{
+
+  // phase factors of elements 0,1, and their increment over 2 elements, using cos(x) - 1 = -2 sin(x/2)^2
+  __m256d s4p = _mm256_setr_pd( cos ( phi0 ), sin ( phi0 ), cos ( phi0 + dphi ), sin ( phi0 + dphi ) );
+  const REAL8 dre = -2.0 * sin ( dphi ) * sin ( dphi ), dim = sin ( 2.0 * dphi );
+  const __m256d ds4p = _mm256_setr_pd( dre, dim, dre, dim );
+
+  // walk through vector in blocks of 2
+  __m256d dh4p = _mm256_setzero_pd(), hh4p = _mm256_setzero_pd(), dd4p = _mm256_setzero_pd(), rr4p = _mm256_setzero_pd();
+  UINT4 i2Max = len - ( len % 2 );
+  for ( UINT4 i2 = 0; i2 < i2Max; i2 += 2 )
+    {
+      __m256d d4p = _mm256_loadu_pd( (const REAL8*)&d[i2] );
+      __m256d h4p = _mm256_loadu_pd( (const REAL8*)&h[i2] );
+
+      // w0,w0,w1,w1
+      __m128d w2p = _mm_loadu_pd( &w[i2] );
+      __m256d w4p = _mm256_insertf128_pd( _mm256_castpd128_pd256( _mm_unpacklo_pd( w2p, w2p ) ), _mm_unpackhi_pd( w2p, w2p ), 1 );
+
+      __m256d t4p = local_cmul_pd ( h4p, s4p );
+      __m256d r4p = _mm256_sub_pd( d4p, t4p );
+      dh4p = _mm256_add_pd( dh4p, local_cmulconj_pd ( _mm256_mul_pd( w4p, d4p ), t4p ) );
+      hh4p = _mm256_add_pd( hh4p, _mm256_mul_pd( w4p, _mm256_mul_pd( h4p, h4p ) ) );
+      dd4p = _mm256_add_pd( dd4p, _mm256_mul_pd( w4p, _mm256_mul_pd( d4p, d4p ) ) );
+      rr4p = _mm256_add_pd( rr4p, _mm256_mul_pd( w4p, _mm256_mul_pd( r4p, r4p ) ) );
+
+      s4p = _mm256_add_pd( s4p, local_cmul_pd ( s4p, ds4p ) );
+    }
+
+  V4SD dh4, hh4, dd4, rr4;
+  dh4.v = dh4p;
+  hh4.v = hh4p;
+  dd4.v = dd4p;
+  rr4.v = rr4p;
+  REAL8 sum_dh_re = dh4.f[0] + dh4.f[2], sum_dh_im = dh4.f[1] + dh4.f[3];
+  REAL8 sum_hh = ( hh4.f[0] + hh4.f[1] ) + ( hh4.f[2] + hh4.f[3] );
+  REAL8 sum_dd = ( dd4.f[0] + dd4.f[1] ) + ( dd4.f[2] + dd4.f[3] );
+  REAL8 sum_rr = ( rr4.f[0] + rr4.f[1] ) + ( rr4.f[2] + rr4.f[3] );
+
+  // deal with the remaining (<=1) term separately, using the next phase factor
+  if ( i2Max < len ) {
+    V4SD s4;
+    s4.v = s4p;
+    const REAL8 d_re = creal ( d[i2Max] ), d_im = cimag ( d[i2Max] );
+    const REAL8 h_re = creal ( h[i2Max] ), h_im = cimag ( h[i2Max] );
+    const REAL8 t_re = h_re * s4.f[0] - h_im * s4.f[1], t_im = h_re * s4.f[1] + h_im * s4.f[0];
+    const REAL8 r_re = d_re - t_re, r_im = d_im - t_im;
+    sum_dh_re += w[i2Max] * ( d_re * t_re + d_im * t_im );
+    sum_dh_im += w[i2Max] * ( d_im * t_re - d_re * t_im );
+    sum_hh += w[i2Max] * ( h_re * h_re + h_im * h_im );
+    sum_dd += w[i2Max] * ( d_re * d_re + d_im * d_im );
+    sum_rr += w[i2Max] * ( r_re * r_re + r_im * r_im );
+  }
+
+  (*dh) = crect( sum_dh_re, sum_dh_im );
+  (*hh) = sum_hh;
+  (*dd) = sum_dd;
+  (*rr) = sum_rr;
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_TimeShiftedInnerProducts_AVXx()
+
 // ========== internal AVXx vector math functions ==========
 
 // ---------- define vector math functions with 1 REAL4 vector input to 1 REAL4 vector output (S2S) ----------
@@ -538,3 +793,40 @@ DEFINE_VECTORMATH_cC2C(Shift, local_add_ps)
   DEFINE_VECTORMATH_ANY( XLALVectorMath_D2D_AVXx, NAME ## REAL8, ( REAL8 *out, const REAL8 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, AVX_OP ) )
 
 DEFINE_VECTORMATH_D2D(Round, local_round_pd)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+#define DEFINE_VECTORMATH_ZZ2Z(NAME, AVX_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZ2Z_AVXx, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, AVX_OP ) )
+
+DEFINE_VECTORMATH_ZZ2Z(Multiply, local_cmul_pd)
+DEFINE_VECTORMATH_ZZ2Z(MultiplyConj, local_cmulconj_pd)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector inputs, summed to 1 COMPLEX16 scalar output (ZZ2z) ----------
+#define DEFINE_VECTORMATH_ZZ2z(NAME, AVX_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZ2z_AVXx, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, AVX_OP ) )
+
+DEFINE_VECTORMATH_ZZ2z(DotProduct, local_cmulconj_pd)
+
+// ---------- define vector math function computing the weighted inner products of a COMPLEX16 vector with a time-shifted COMPLEX16 vector ----------
+DEFINE_VECTORMATH_ANY( XLALVectorMath_TimeShiftedInnerProducts_AVXx, TimeShiftedInnerProductsCOMPLEX16,
+                       ( COMPLEX16 *dh, REAL8 *hh, REAL8 *dd, REAL8 *rr, const COMPLEX16 *d, const COMPLEX16 *h, const REAL8 *w, const REAL8 phi0, const REAL8 dphi, const UINT4 len ),
+                       ( (dh != NULL) && (hh != NULL) && (dd != NULL) && (rr != NULL) && (d != NULL) && (h != NULL) && (w != NULL) ),
+                       ( dh, hh, dd, rr, d, h, w, phi0, dphi, len ) )
+
+#ifdef __AVX2__
+
+DEFINE_VECTORMATH_D2D(Exp, exp256_pd)
+
+// ---------- define vector math functions with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+#define DEFINE_VECTORMATH_D2DD(NAME, AVX_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_D2DD_AVXx, NAME ## REAL8, ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len ), ( (out1 != NULL) && (out2 != NULL) && (in != NULL) ), ( out1, out2, in, len, AVX_OP ) )
+
+DEFINE_VECTORMATH_D2DD(SinCos, sincos256_pd)
+
+// ---------- define vector math functions with 2 REAL8 vector inputs to 1 COMPLEX16 vector output (DD2Z) ----------
+#define DEFINE_VECTORMATH_DD2Z(NAME, AVX_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_DD2Z_AVXx, NAME ## COMPLEX16, ( COMPLEX16 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, AVX_OP ) )
+
+DEFINE_VECTORMATH_DD2Z(CExp, local_cexp_pd)
+
+#endif // __AVX2__
@@ -84,6 +84,27 @@ static inline REAL4 local_fmaxf ( REAL4 x, REAL4 y ) {
   return (x > y) ? x : y;
 }
 
+static inline void local_sincos(REAL8 in, REAL8 *out1, REAL8 *out2) {
+  *out1 = sin ( in );
+  *out2 = cos ( in );
+}
+
+static inline COMPLEX16 local_cexp ( REAL8 amp, REAL8 phase )
+{
+  return crect ( amp * cos ( phase ), amp * sin ( phase ) );
+}
+
+// written out explicitly, to avoid the special-case handling of infinities by C99 complex multiplication
+static inline COMPLEX16 local_cmul ( COMPLEX16 x, COMPLEX16 y )
+{
+  return crect ( creal(x) * creal(y) - cimag(x) * cimag(y), creal(x) * cimag(y) + cimag(x) * creal(y) );
+}
+
+static inline COMPLEX16 local_cmulconj ( COMPLEX16 x, COMPLEX16 y )
+{
+  return crect ( creal(x) * creal(y) + cimag(x) * cimag(y), cimag(x) * creal(y) - creal(x) * cimag(y) );
+}
+
 // ========== internal generic functions ==========
 
 // ---------- generic operator with 1 REAL4 vector input to 1 INT4 vector output (S2I) ----------
@@ -196,6 +217,88 @@ XLALVectorMath_D2D_GEN ( REAL8 *out, const REAL8 *in, const UINT4 len, REAL8 (*o
   return XLAL_SUCCESS;
 }
 
+// ---------- generic operator with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+static inline int
+XLALVectorMath_D2DD_GEN ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len, void (*op)(REAL8, REAL8*, REAL8*) )
+{
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      (*op) ( in[i], &(out1[i]), &(out2[i]) );
+    }
+  return XLAL_SUCCESS;
+}
+
+// ---------- generic operator with 2 REAL8 vector inputs to 1 COMPLEX16 vector output (DD2Z) ----------
+static inline int
+XLALVectorMath_DD2Z_GEN ( COMPLEX16 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len, COMPLEX16 (*op)(REAL8, REAL8) )
+{
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      out[i] = (*op) ( in1[i], in2[i] );
+    }
+  return XLAL_SUCCESS;
+}
+
+// ---------- generic operator with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+static inline int
+XLALVectorMath_ZZ2Z_GEN ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len, COMPLEX16 (*op)(COMPLEX16, COMPLEX16) )
+{
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      out[i] = (*op) ( in1[i], in2[i] );
+    }
+  return XLAL_SUCCESS;
+}
+
+// ---------- generic operator with 2 COMPLEX16 vector inputs, summed to 1 COMPLEX16 scalar output (ZZ2z) ----------
+static inline int
+XLALVectorMath_ZZ2z_GEN ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len, COMPLEX16 (*op)(COMPLEX16, COMPLEX16) )
+{
+  COMPLEX16 sum = 0;
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      sum += (*op) ( in1[i], in2[i] );
+    }
+  (*out) = sum;
+  return XLAL_SUCCESS;
+}
+
+// ---------- generic weighted inner products of a COMPLEX16 vector with a time-shifted COMPLEX16 vector ----------
+static inline int
+XLALVectorMath_TimeShiftedInnerProducts_GEN ( COMPLEX16 *dh, REAL8 *hh, REAL8 *dd, REAL8 *rr, const COMPLEX16 *d, const COMPLEX16 *h, const REAL8 *w, const REAL8 phi0, const REAL8 dphi, const UINT4 len )
+{
+
+  // phase factor of element 0, and its increment per element, using cos(x) - 1 = -2 sin(x/2)^2
+  REAL8 re = cos ( phi0 ), im = sin ( phi0 );
+  const REAL8 dre = -2.0 * sin ( 0.5 * dphi ) * sin ( 0.5 * dphi ), dim = sin ( dphi );
+
+  REAL8 sum_dh_re = 0, sum_dh_im = 0, sum_hh = 0, sum_dd = 0, sum_rr = 0;
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      const REAL8 d_re = creal ( d[i] ), d_im = cimag ( d[i] );
+      const REAL8 h_re = creal ( h[i] ), h_im = cimag ( h[i] );
+      const REAL8 t_re = h_re * re - h_im * im, t_im = h_re * im + h_im * re;
+      const REAL8 r_re = d_re - t_re, r_im = d_im - t_im;
+      sum_dh_re += w[i] * ( d_re * t_re + d_im * t_im );
+      sum_dh_im += w[i] * ( d_im * t_re - d_re * t_im );
+      sum_hh += w[i] * ( h_re * h_re + h_im * h_im );
+      sum_dd += w[i] * ( d_re * d_re + d_im * d_im );
+      sum_rr += w[i] * ( r_re * r_re + r_im * r_im );
+      const REAL8 new_re = re + re * dre - im * dim;
+      const REAL8 new_im = im + re * dim + im * dre;
+      re = new_re;
+      im = new_im;
+    }
+
+  (*dh) = crect ( sum_dh_re, sum_dh_im );
+  (*hh) = sum_hh;
+  (*dd) = sum_dd;
+  (*rr) = sum_rr;
+
+  return XLAL_SUCCESS;
+
+}
+
 // ========== internal vector math functions ==========
 
 // ---------- define vector math functions with 1 REAL4 vector input to 1 INT4 vector output (S2I) ----------
@@ -272,3 +375,35 @@ DEFINE_VECTORMATH_cC2C(Shift, local_caddf)
   DEFINE_VECTORMATH_ANY( XLALVectorMath_D2D_GEN, NAME ## REAL8, ( REAL8 *out, const REAL8 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, GEN_OP ) )
 
 DEFINE_VECTORMATH_D2D(Round, round)
+DEFINE_VECTORMATH_D2D(Exp, exp)
+
+// ---------- define vector math functions with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+#define DEFINE_VECTORMATH_D2DD(NAME, GEN_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_D2DD_GEN, NAME ## REAL8, ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len ), ( (out1 != NULL) && (out2 != NULL) && (in != NULL) ), ( out1, out2, in, len, GEN_OP ) )
+
+DEFINE_VECTORMATH_D2DD(SinCos, local_sincos)
+
+// ---------- define vector math functions with 2 REAL8 vector inputs to 1 COMPLEX16 vector output (DD2Z) ----------
+#define DEFINE_VECTORMATH_DD2Z(NAME, GEN_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_DD2Z_GEN, NAME ## COMPLEX16, ( COMPLEX16 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, GEN_OP ) )
+
+DEFINE_VECTORMATH_DD2Z(CExp, local_cexp)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+#define DEFINE_VECTORMATH_ZZ2Z(NAME, GEN_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZ2Z_GEN, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, GEN_OP ) )
+
+DEFINE_VECTORMATH_ZZ2Z(Multiply, local_cmul)
+DEFINE_VECTORMATH_ZZ2Z(MultiplyConj, local_cmulconj)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector inputs, summed to 1 COMPLEX16 scalar output (ZZ2z) ----------
+#define DEFINE_VECTORMATH_ZZ2z(NAME, GEN_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZ2z_GEN, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, GEN_OP ) )
+
+DEFINE_VECTORMATH_ZZ2z(DotProduct, local_cmulconj)
+
+// ---------- define vector math function computing the weighted inner products of a COMPLEX16 vector with a time-shifted COMPLEX16 vector ----------
+DEFINE_VECTORMATH_ANY( XLALVectorMath_TimeShiftedInnerProducts_GEN, TimeShiftedInnerProductsCOMPLEX16,
+                       ( COMPLEX16 *dh, REAL8 *hh, REAL8 *dd, REAL8 *rr, const COMPLEX16 *d, const COMPLEX16 *h, const REAL8 *w, const REAL8 phi0, const REAL8 dphi, const UINT4 len ),
+                       ( (dh != NULL) && (hh != NULL) && (dd != NULL) && (rr != NULL) && (d != NULL) && (h != NULL) && (w != NULL) ),
+                       ( dh, hh, dd, rr, d, h, w, phi0, dphi, len ) )
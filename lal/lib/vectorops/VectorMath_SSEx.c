@@ -36,6 +36,29 @@
 
 #include "VectorMath_sse_mathfun.h"
 
+// ---------- double-precision sincos_pd() and exp_pd() ----------
+#define PD_MATHFUN(name)	name##_pd
+#define PD_V			__m128d
+#define PD_VI			__m128i
+#define PD_SET1			_mm_set1_pd
+#define PD_SET1_EPI64		_mm_set1_epi64x
+#define PD_ADD			_mm_add_pd
+#define PD_SUB			_mm_sub_pd
+#define PD_MUL			_mm_mul_pd
+#define PD_DIV			_mm_div_pd
+#define PD_MIN			_mm_min_pd
+#define PD_MAX			_mm_max_pd
+#define PD_CASTPD_SI		_mm_castpd_si128
+#define PD_CASTSI_PD		_mm_castsi128_pd
+#define PD_AND_SI		_mm_and_si128
+#define PD_ANDNOT_SI		_mm_andnot_si128
+#define PD_OR_SI		_mm_or_si128
+#define PD_XOR_SI		_mm_xor_si128
+#define PD_ADD_EPI64		_mm_add_epi64
+#define PD_SUB_EPI64		_mm_sub_epi64
+#define PD_SLLI_EPI64		_mm_slli_epi64
+#include "VectorMath_pd_mathfun.h"
+
 // ---------- local operators and operator-wrappers ----------
 UNUSED static inline __m128i
 local_cast_to_INT4 ( __m128 in1 )
@@ -118,6 +141,42 @@ local_cmul_ps ( __m128 in1, __m128 in2 )
   return _mm_shuffle_ps(result, result,0b11011000);
 }
 
+// in1: a0,b0, in2: c0,d0
+UNUSED static inline __m128d
+local_cmul_pd ( __m128d in1, __m128d in2 )
+{
+  // a0c0, a0d0
+  __m128d temp1 = _mm_mul_pd ( _mm_unpacklo_pd ( in1, in1 ), in2 );
+  // b0d0, b0c0
+  __m128d temp2 = _mm_mul_pd ( _mm_unpackhi_pd ( in1, in1 ), _mm_shuffle_pd ( in2, in2, 1 ) );
+  // a0c0 - b0d0, a0d0 + b0c0
+  return _mm_add_pd ( temp1, _mm_xor_pd ( temp2, _mm_setr_pd ( -0.0, 0.0 ) ) );
+}
+
+// in1: a0,b0, in2: c0,d0; returns in1 * conj(in2)
+UNUSED static inline __m128d
+local_cmulconj_pd ( __m128d in1, __m128d in2 )
+{
+  // a0c0, a0d0
+  __m128d temp1 = _mm_mul_pd ( _mm_unpacklo_pd ( in1, in1 ), in2 );
+  // b0d0, b0c0
+  __m128d temp2 = _mm_mul_pd ( _mm_unpackhi_pd ( in1, in1 ), _mm_shuffle_pd ( in2, in2, 1 ) );
+  // b0d0 + a0c0, b0c0 - a0d0
+  return _mm_add_pd ( temp2, _mm_xor_pd ( temp1, _mm_setr_pd ( 0.0, -0.0 ) ) );
+}
+
+// amp: A0,A1, phase: p0,p1; out1: A0 cos(p0), A0 sin(p0), out2: A1 cos(p1), A1 sin(p1)
+UNUSED static inline void
+local_cexp_pd ( __m128d amp, __m128d phase, __m128d *out1, __m128d *out2 )
+{
+  __m128d s, c;
+  sincos_pd ( phase, &s, &c );
+  s = _mm_mul_pd ( amp, s );
+  c = _mm_mul_pd ( amp, c );
+  (*out1) = _mm_unpacklo_pd ( c, s );
+  (*out2) = _mm_unpackhi_pd ( c, s );
+}
+
 // ========== internal generic SSEx functions ==========
 
 // ---------- generic SSEx operator with 1 REAL4 vector input to 1 INT4 vector output (S2I) ----------
@@ -401,6 +460,142 @@ XLALVectorMath_cC2C_SSEx ( COMPLEX8 *out, COMPLEX8 scalar, const COMPLEX8 *in, c
 
 } // XLALVectorMath_cC2C_SSEx()
 
+// ---------- generic SSEx operator with 1 REAL8 vector input to 1 REAL8 vector output (D2D) ----------
+static inline int
+XLALVectorMath_D2D_SSEx ( REAL8 *out, const REAL8 *in, const UINT4 len, __m128d (*f)(__m128d) )
+{
+
+  // walk through vector in blocks of 2
+  UINT4 i2Max = len - ( len % 2 );
+  for ( UINT4 i2 = 0; i2 < i2Max; i2 += 2 )
+    {
+      __m128d in2p = _mm_loadu_pd(&in[i2]);
+      __m128d out2p = (*f)( in2p );
+      _mm_storeu_pd(&out[i2], out2p);
+    }
+
+  // deal with the remaining (<=1) terms separately
+  V2SF in2 = {.f={0,0}}, out2;
+  for ( UINT4 i = i2Max,j=0; i < len; i ++, j++ ) {
+    in2.f[j] = in[i];
+  }
+  out2.v = (*f)( in2.v );
+  for ( UINT4 i = i2Max,j=0; i < len; i ++, j++ ) {
+    out[i] = out2.f[j];
+  }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_D2D_SSEx()
+
+// ---------- generic SSEx operator with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+static inline int
+XLALVectorMath_D2DD_SSEx ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len, void (*f)(__m128d, __m128d*, __m128d*) )
+{
+
+  // walk through vector in blocks of 2
+  UINT4 i2Max = len - ( len % 2 );
+  for ( UINT4 i2 = 0; i2 < i2Max; i2 += 2 )
+    {
+      __m128d in2p = _mm_loadu_pd(&in[i2]);
+      __m128d out2p_1, out2p_2;
+      (*f) ( in2p, &out2p_1, &out2p_2 );
+      _mm_storeu_pd(&out1[i2], out2p_1);
+      _mm_storeu_pd(&out2[i2], out2p_2);
+    }
+
+  // deal with the remaining (<=1) terms separately
+  V2SF in2 = {.f={0,0}}, out2_1, out2_2;
+  for ( UINT4 i = i2Max,j=0; i < len; i ++, j++ ) {
+    in2.f[j] = in[i];
+  }
+  (*f) ( in2.v, &out2_1.v, &out2_2.v );
+  for ( UINT4 i = i2Max,j=0; i < len; i ++, j++ ) {
+    out1[i] = out2_1.f[j];
+    out2[i] = out2_2.f[j];
+  }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_D2DD_SSEx()
+
+// ---------- generic SSEx operator with 2 REAL8 vector inputs to 1 COMPLEX16 vector output (DD2Z) ----------
+static inline int
+XLALVectorMath_DD2Z_SSEx ( COMPLEX16 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len, void (*op)(__m128d, __m128d, __m128d*, __m128d*) )
+{
+
+  // walk through vector in blocks of 2
+  UINT4 i2Max = len - ( len % 2 );
+  for ( UINT4 i2 = 0; i2 < i2Max; i2 += 2 )
+    {
+      __m128d in2p_1 = _mm_loadu_pd(&in1[i2]);
+      __m128d in2p_2 = _mm_loadu_pd(&in2[i2]);
+      __m128d out2p_1, out2p_2;
+      (*op) ( in2p_1, in2p_2, &out2p_1, &out2p_2 );
+      _mm_storeu_pd( (REAL8*)&out[i2], out2p_1 );
+      _mm_storeu_pd( (REAL8*)&out[i2+1], out2p_2 );
+    }
+
+  // deal with the remaining (<=1) term separately
+  if ( i2Max < len ) {
+    V2SF in2_1 = {.f={in1[i2Max],0}};
+    V2SF in2_2 = {.f={in2[i2Max],0}};
+    V2SF out2_1, out2_2;
+    (*op) ( in2_1.v, in2_2.v, &out2_1.v, &out2_2.v );
+    out[i2Max] = crect( out2_1.f[0], out2_1.f[1] );
+  }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_DD2Z_SSEx()
+
+// ---------- generic SSEx operator with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+static inline int
+XLALVectorMath_ZZ2Z_SSEx ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len, __m128d (*op)(__m128d, __m128d) )
+{
+
+  // one COMPLEX16 fills a whole SSE register, so there are no remaining terms
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      __m128d in2p_1 = _mm_loadu_pd( (const REAL8*)&in1[i] );
+      __m128d in2p_2 = _mm_loadu_pd( (const REAL8*)&in2[i] );
+      __m128d out2p = (*op) ( in2p_1, in2p_2 );
+      _mm_storeu_pd( (REAL8*)&out[i], out2p );
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_ZZ2Z_SSEx()
+
+// ---------- generic SSEx operator with 2 COMPLEX16 vector inputs, summed to 1 COMPLEX16 scalar output (ZZ2z) ----------
+static inline int
+XLALVectorMath_ZZ2z_SSEx ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len, __m128d (*op)(__m128d, __m128d) )
+{
+
+  // accumulate even and odd terms separately, to shorten the dependency chain of the additions
+  __m128d sum2p_0 = _mm_setzero_pd();
+  __m128d sum2p_1 = _mm_setzero_pd();
+  UINT4 i2Max = len - ( len % 2 );
+  for ( UINT4 i2 = 0; i2 < i2Max; i2 += 2 )
+    {
+      sum2p_0 = _mm_add_pd( sum2p_0, (*op) ( _mm_loadu_pd( (const REAL8*)&in1[i2] ), _mm_loadu_pd( (const REAL8*)&in2[i2] ) ) );
+      sum2p_1 = _mm_add_pd( sum2p_1, (*op) ( _mm_loadu_pd( (const REAL8*)&in1[i2+1] ), _mm_loadu_pd( (const REAL8*)&in2[i2+1] ) ) );
+    }
+
+  // deal with the remaining (<=1) terms separately
+  for ( UINT4 i = i2Max; i < len; i ++ )
+    {
+      sum2p_0 = _mm_add_pd( sum2p_0, (*op) ( _mm_loadu_pd( (const REAL8*)&in1[i] ), _mm_loadu_pd( (const REAL8*)&in2[i] ) ) );
+    }
+
+  V2SF sum2;
+  sum2.v = _mm_add_pd( sum2p_0, sum2p_1 );
+  (*out) = crect( sum2.f[0], sum2.f[1] );
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_ZZ2z_SSEx()
+
 // ========== internal SSEx vector math functions ==========
 
 // ---------- define vector math functions with 1 REAL4 vector input to 1 INT4 vector output (S2I) ----------
@@ -469,3 +664,34 @@ DEFINE_VECTORMATH_CC2C(Add, local_add_ps)
 
 DEFINE_VECTORMATH_cC2C(Scale, local_cmul_ps)
 DEFINE_VECTORMATH_cC2C(Shift, local_add_ps)
+
+// ---------- define vector math functions with 1 REAL8 vector input to 1 REAL8 vector output (D2D) ----------
+#define DEFINE_VECTORMATH_D2D(NAME, SSE_OP)                             \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_D2D_SSEx, NAME ## REAL8, ( REAL8 *out, const REAL8 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, SSE_OP ) )
+
+DEFINE_VECTORMATH_D2D(Exp, exp_pd)
+
+// ---------- define vector math functions with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+#define DEFINE_VECTORMATH_D2DD(NAME, SSE_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_D2DD_SSEx, NAME ## REAL8, ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len ), ( (out1 != NULL) && (out2 != NULL) && (in != NULL) ), ( out1, out2, in, len, SSE_OP ) )
+
+DEFINE_VECTORMATH_D2DD(SinCos, sincos_pd)
+
+// ---------- define vector math functions with 2 REAL8 vector inputs to 1 COMPLEX16 vector output (DD2Z) ----------
+#define DEFINE_VECTORMATH_DD2Z(NAME, SSE_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_DD2Z_SSEx, NAME ## COMPLEX16, ( COMPLEX16 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, SSE_OP ) )
+
+DEFINE_VECTORMATH_DD2Z(CExp, local_cexp_pd)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+#define DEFINE_VECTORMATH_ZZ2Z(NAME, SSE_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZ2Z_SSEx, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, SSE_OP ) )
+
+DEFINE_VECTORMATH_ZZ2Z(Multiply, local_cmul_pd)
+DEFINE_VECTORMATH_ZZ2Z(MultiplyConj, local_cmulconj_pd)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector inputs, summed to 1 COMPLEX16 scalar output (ZZ2z) ----------
+#define DEFINE_VECTORMATH_ZZ2z(NAME, SSE_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZ2z_SSEx, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, SSE_OP ) )
+
+DEFINE_VECTORMATH_ZZ2z(DotProduct, local_cmulconj_pd)
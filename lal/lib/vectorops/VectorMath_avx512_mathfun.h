@@ -0,0 +1,548 @@
+/*
+   AVX-512 implementation of sin, cos, sincos, exp and log
+
+   Based on "avx_mathfun.h", by Giovanni Garberoglio, which is in turn
+   based on "sse_mathfun.h", by Julien Pommier
+   http://gruntthepeon.free.fr/ssemath/
+
+   Copyright (C) 2012 Giovanni Garberoglio
+   Interdisciplinary Laboratory for Computational Science (LISC)
+   Fondazione Bruno Kessler and University of Trento
+   via Sommarive, 18
+   I-38123 Trento (Italy)
+
+   Altered 2026 for AVX-512: 16-wide vectors, and the comparison results
+   are held in mask registers instead of all-ones/all-zeros vectors.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+
+  (this is the zlib license)
+*/
+
+#include <immintrin.h>
+
+#ifdef _MSC_VER /* visual c++ */
+# define ALIGN64_BEG __declspec(align(64))
+# define ALIGN64_END
+#else /* gcc or icc */
+# define ALIGN64_BEG
+# define ALIGN64_END __attribute__((aligned(64)))
+#endif
+
+typedef __m512  v16sf; // vector of 16 float (avx512)
+typedef __m512d v8sd;  // vector of 8 double (avx512)
+typedef __m512i v16si; // vector of 16 int   (avx512)
+
+typedef ALIGN64_BEG union {
+  float f[16];
+  int i[16];
+  v16sf  v;
+  v16si  vi;
+} ALIGN64_END V16SF;
+
+typedef ALIGN64_BEG union {
+  double f[8];
+  v8sd  v;
+  v16si vi;
+} ALIGN64_END V8SD;
+
+
+// ---------- Prototypes ----------
+static v16sf sin512_ps(v16sf x);
+static v16sf cos512_ps(v16sf x);
+static v16sf exp512_ps(v16sf x);
+static v16sf log512_ps(v16sf x);
+static void sincos512_ps(v16sf x, v16sf *s, v16sf *c);
+static void sincos512_ps_2pi(v16sf xx, v16sf *s, v16sf *c);
+// --------------------------------
+
+
+#define _PS512_CONST(Name, Val)                                         \
+  static const V16SF _ps512_##Name = { .f={Val, Val, Val, Val, Val, Val, Val, Val, Val, Val, Val, Val, Val, Val, Val, Val} }
+#define _PI32_CONST512(Name, Val)                                       \
+  static const V16SF _pi32_512_##Name = { .i={Val, Val, Val, Val, Val, Val, Val, Val, Val, Val, Val, Val, Val, Val, Val, Val} }
+#define _PS512_CONST_INT(Name, Val)                                     \
+  static const V16SF _ps512_##Name = { .i={Val, Val, Val, Val, Val, Val, Val, Val, Val, Val, Val, Val, Val, Val, Val, Val} }
+
+_PS512_CONST(1  , 1.0f);
+_PS512_CONST(0p5, 0.5f);
+/* the smallest non denormalized float number */
+_PS512_CONST_INT(min_norm_pos, 0x00800000);
+_PS512_CONST_INT(mant_mask, 0x7f800000);
+_PS512_CONST_INT(inv_mant_mask, ~0x7f800000);
+_PS512_CONST_INT(all_ones, ~0);
+
+_PS512_CONST_INT(sign_mask, 0x80000000);
+_PS512_CONST_INT(inv_sign_mask, ~0x80000000);
+
+_PI32_CONST512(0, 0);
+_PI32_CONST512(1, 1);
+_PI32_CONST512(inv1, ~1);
+_PI32_CONST512(2, 2);
+_PI32_CONST512(4, 4);
+_PI32_CONST512(0x7f, 0x7f);
+
+_PS512_CONST(cephes_SQRTHF, 0.707106781186547524);
+_PS512_CONST(cephes_log_p0, 7.0376836292E-2);
+_PS512_CONST(cephes_log_p1, - 1.1514610310E-1);
+_PS512_CONST(cephes_log_p2, 1.1676998740E-1);
+_PS512_CONST(cephes_log_p3, - 1.2420140846E-1);
+_PS512_CONST(cephes_log_p4, + 1.4249322787E-1);
+_PS512_CONST(cephes_log_p5, - 1.6668057665E-1);
+_PS512_CONST(cephes_log_p6, + 2.0000714765E-1);
+_PS512_CONST(cephes_log_p7, - 2.4999993993E-1);
+_PS512_CONST(cephes_log_p8, + 3.3333331174E-1);
+_PS512_CONST(cephes_log_q1, -2.12194440e-4);
+_PS512_CONST(cephes_log_q2, 0.693359375);
+
+#ifdef __AVX512DQ__
+
+#define _mathfun_mm512_and_ps _mm512_and_ps
+#define _mathfun_mm512_or_ps _mm512_or_ps
+#define _mathfun_mm512_xor_ps _mm512_xor_ps
+
+#else
+
+/* AVX-512F only provides bitwise operations on integer vectors;
+   the floating-point variants are part of AVX-512DQ */
+#define AVX512DQ_BITOP_USING_AVX512F(fn) \
+static inline v16sf _mathfun_mm512_##fn##_ps(v16sf x, v16sf y) \
+{ \
+  return _mm512_castsi512_ps(_mm512_##fn##_si512(_mm512_castps_si512(x), _mm512_castps_si512(y))); \
+}
+
+AVX512DQ_BITOP_USING_AVX512F(and)
+AVX512DQ_BITOP_USING_AVX512F(or)
+AVX512DQ_BITOP_USING_AVX512F(xor)
+
+#endif /* __AVX512DQ__ */
+
+
+/* natural logarithm computed for 16 simultaneous float
+   return NaN for x <= 0
+*/
+v16sf log512_ps(v16sf x) {
+  v16si imm0;
+  v16sf one = _ps512_1.v;
+
+  __mmask16 invalid_mask = _mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_LE_OS);
+
+  x = _mm512_max_ps(x, _ps512_min_norm_pos.v);  /* cut off denormalized stuff */
+
+  imm0 = _mm512_srli_epi32(_mm512_castps_si512(x), 23);
+
+  /* keep only the fractional part */
+  x = _mathfun_mm512_and_ps(x, _ps512_inv_mant_mask.v);
+  x = _mathfun_mm512_or_ps(x, _ps512_0p5.v);
+
+  imm0 = _mm512_sub_epi32(imm0, _pi32_512_0x7f.vi);
+  v16sf e = _mm512_cvtepi32_ps(imm0);
+
+  e = _mm512_add_ps(e, one);
+
+  /* part2:
+     if( x < SQRTHF ) {
+       e -= 1;
+       x = x + x - 1.0;
+     } else { x = x - 1.0; }
+  */
+  __mmask16 mask = _mm512_cmp_ps_mask(x, _ps512_cephes_SQRTHF.v, _CMP_LT_OS);
+  v16sf tmp = _mm512_maskz_mov_ps(mask, x);
+  x = _mm512_sub_ps(x, one);
+  e = _mm512_mask_sub_ps(e, mask, e, one);
+  x = _mm512_add_ps(x, tmp);
+
+  v16sf z = _mm512_mul_ps(x,x);
+
+  v16sf y = _ps512_cephes_log_p0.v;
+  y = _mm512_mul_ps(y, x);
+  y = _mm512_add_ps(y, _ps512_cephes_log_p1.v);
+  y = _mm512_mul_ps(y, x);
+  y = _mm512_add_ps(y, _ps512_cephes_log_p2.v);
+  y = _mm512_mul_ps(y, x);
+  y = _mm512_add_ps(y, _ps512_cephes_log_p3.v);
+  y = _mm512_mul_ps(y, x);
+  y = _mm512_add_ps(y, _ps512_cephes_log_p4.v);
+  y = _mm512_mul_ps(y, x);
+  y = _mm512_add_ps(y, _ps512_cephes_log_p5.v);
+  y = _mm512_mul_ps(y, x);
+  y = _mm512_add_ps(y, _ps512_cephes_log_p6.v);
+  y = _mm512_mul_ps(y, x);
+  y = _mm512_add_ps(y, _ps512_cephes_log_p7.v);
+  y = _mm512_mul_ps(y, x);
+  y = _mm512_add_ps(y, _ps512_cephes_log_p8.v);
+  y = _mm512_mul_ps(y, x);
+
+  y = _mm512_mul_ps(y, z);
+
+  tmp = _mm512_mul_ps(e, _ps512_cephes_log_q1.v);
+  y = _mm512_add_ps(y, tmp);
+
+
+  tmp = _mm512_mul_ps(z, _ps512_0p5.v);
+  y = _mm512_sub_ps(y, tmp);
+
+  tmp = _mm512_mul_ps(e, _ps512_cephes_log_q2.v);
+  x = _mm512_add_ps(x, y);
+  x = _mm512_add_ps(x, tmp);
+  x = _mm512_mask_mov_ps(x, invalid_mask, _ps512_all_ones.v); // negative arg will be NAN
+  return x;
+}
+
+_PS512_CONST(exp_hi,	88.3762626647949f);
+_PS512_CONST(exp_lo,	-88.3762626647949f);
+
+_PS512_CONST(cephes_LOG2EF, 1.44269504088896341);
+_PS512_CONST(cephes_exp_C1, 0.693359375);
+_PS512_CONST(cephes_exp_C2, -2.12194440e-4);
+
+_PS512_CONST(cephes_exp_p0, 1.9875691500E-4);
+_PS512_CONST(cephes_exp_p1, 1.3981999507E-3);
+_PS512_CONST(cephes_exp_p2, 8.3334519073E-3);
+_PS512_CONST(cephes_exp_p3, 4.1665795894E-2);
+_PS512_CONST(cephes_exp_p4, 1.6666665459E-1);
+_PS512_CONST(cephes_exp_p5, 5.0000001201E-1);
+
+v16sf exp512_ps(v16sf x) {
+  v16sf tmp, fx;
+  v16si imm0;
+  v16sf one = _ps512_1.v;
+
+  x = _mm512_min_ps(x, _ps512_exp_hi.v);
+  x = _mm512_max_ps(x, _ps512_exp_lo.v);
+
+  /* express exp(x) as exp(g + n*log(2)) */
+  fx = _mm512_mul_ps(x, _ps512_cephes_LOG2EF.v);
+  fx = _mm512_add_ps(fx, _ps512_0p5.v);
+
+  tmp = _mm512_roundscale_ps(fx, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+
+  /* if greater, substract 1 */
+  __mmask16 mask = _mm512_cmp_ps_mask(tmp, fx, _CMP_GT_OS);
+  fx = _mm512_mask_sub_ps(tmp, mask, tmp, one);
+
+  tmp = _mm512_mul_ps(fx, _ps512_cephes_exp_C1.v);
+  v16sf z = _mm512_mul_ps(fx, _ps512_cephes_exp_C2.v);
+  x = _mm512_sub_ps(x, tmp);
+  x = _mm512_sub_ps(x, z);
+
+  z = _mm512_mul_ps(x,x);
+
+  v16sf y = _ps512_cephes_exp_p0.v;
+  y = _mm512_mul_ps(y, x);
+  y = _mm512_add_ps(y, _ps512_cephes_exp_p1.v);
+  y = _mm512_mul_ps(y, x);
+  y = _mm512_add_ps(y, _ps512_cephes_exp_p2.v);
+  y = _mm512_mul_ps(y, x);
+  y = _mm512_add_ps(y, _ps512_cephes_exp_p3.v);
+  y = _mm512_mul_ps(y, x);
+  y = _mm512_add_ps(y, _ps512_cephes_exp_p4.v);
+  y = _mm512_mul_ps(y, x);
+  y = _mm512_add_ps(y, _ps512_cephes_exp_p5.v);
+  y = _mm512_mul_ps(y, z);
+  y = _mm512_add_ps(y, x);
+  y = _mm512_add_ps(y, one);
+
+  /* build 2^n */
+  imm0 = _mm512_cvttps_epi32(fx);
+  imm0 = _mm512_add_epi32(imm0, _pi32_512_0x7f.vi);
+  imm0 = _mm512_slli_epi32(imm0, 23);
+  v16sf pow2n = _mm512_castsi512_ps(imm0);
+  y = _mm512_mul_ps(y, pow2n);
+  return y;
+}
+
+_PS512_CONST(minus_cephes_DP1, -0.78515625);
+_PS512_CONST(minus_cephes_DP2, -2.4187564849853515625e-4);
+_PS512_CONST(minus_cephes_DP3, -3.77489497744594108e-8);
+_PS512_CONST(sincof_p0, -1.9515295891E-4);
+_PS512_CONST(sincof_p1,  8.3321608736E-3);
+_PS512_CONST(sincof_p2, -1.6666654611E-1);
+_PS512_CONST(coscof_p0,  2.443315711809948E-005);
+_PS512_CONST(coscof_p1, -1.388731625493765E-003);
+_PS512_CONST(coscof_p2,  4.166664568298827E-002);
+_PS512_CONST(cephes_FOPI, 1.27323954473516); // 4 / M_PI
+
+
+/* evaluation of 16 sines at onces using AVX-512 intrisics
+
+   The code is the exact rewriting of the cephes sinf function.
+   Precision is excellent as long as x < 8192 (I did not bother to
+   take into account the special handling they have for greater values
+   -- it does not return garbage for arguments over 8192, though, but
+   the extra precision is missing).
+
+   Note that it is such that sinf((float)M_PI) = 8.74e-8, which is the
+   surprising but correct result.
+
+*/
+v16sf sin512_ps(v16sf x) { // any x
+  v16sf xmm1, xmm2, xmm3, sign_bit, y;
+  v16si imm0, imm2;
+
+  sign_bit = x;
+  /* take the absolute value */
+  x = _mathfun_mm512_and_ps(x, _ps512_inv_sign_mask.v);
+  /* extract the sign bit (upper one) */
+  sign_bit = _mathfun_mm512_and_ps(sign_bit, _ps512_sign_mask.v);
+
+  /* scale by 4/Pi */
+  y = _mm512_mul_ps(x, _ps512_cephes_FOPI.v);
+
+  /* store the integer part of y in mm0 */
+  imm2 = _mm512_cvttps_epi32(y);
+  /* j=(j+1) & (~1) (see the cephes sources) */
+  imm2 = _mm512_add_epi32(imm2, _pi32_512_1.vi);
+  imm2 = _mm512_and_si512(imm2, _pi32_512_inv1.vi);
+  y = _mm512_cvtepi32_ps(imm2);
+
+  /* get the swap sign flag */
+  imm0 = _mm512_and_si512(imm2, _pi32_512_4.vi);
+  imm0 = _mm512_slli_epi32(imm0, 29);
+  /* get the polynom selection mask
+     there is one polynom for 0 <= x <= Pi/4
+     and another one for Pi/4<x<=Pi/2
+
+     Both branches will be computed.
+  */
+  imm2 = _mm512_and_si512(imm2, _pi32_512_2.vi);
+  __mmask16 poly_mask = _mm512_cmpeq_epi32_mask(imm2, _pi32_512_0.vi);
+
+  v16sf swap_sign_bit = _mm512_castsi512_ps(imm0);
+  sign_bit = _mathfun_mm512_xor_ps(sign_bit, swap_sign_bit);
+
+  /* The magic pass: "Extended precision modular arithmetic"
+     x = ((x - y * DP1) - y * DP2) - y * DP3; */
+  xmm1 = _ps512_minus_cephes_DP1.v;
+  xmm2 = _ps512_minus_cephes_DP2.v;
+  xmm3 = _ps512_minus_cephes_DP3.v;
+  xmm1 = _mm512_mul_ps(y, xmm1);
+  xmm2 = _mm512_mul_ps(y, xmm2);
+  xmm3 = _mm512_mul_ps(y, xmm3);
+  x = _mm512_add_ps(x, xmm1);
+  x = _mm512_add_ps(x, xmm2);
+  x = _mm512_add_ps(x, xmm3);
+
+  /* Evaluate the first polynom  (0 <= x <= Pi/4) */
+  y = _ps512_coscof_p0.v;
+  v16sf z = _mm512_mul_ps(x,x);
+
+  y = _mm512_mul_ps(y, z);
+  y = _mm512_add_ps(y, _ps512_coscof_p1.v);
+  y = _mm512_mul_ps(y, z);
+  y = _mm512_add_ps(y, _ps512_coscof_p2.v);
+  y = _mm512_mul_ps(y, z);
+  y = _mm512_mul_ps(y, z);
+  v16sf tmp = _mm512_mul_ps(z, _ps512_0p5.v);
+  y = _mm512_sub_ps(y, tmp);
+  y = _mm512_add_ps(y, _ps512_1.v);
+
+  /* Evaluate the second polynom  (Pi/4 <= x <= 0) */
+
+  v16sf y2 = _ps512_sincof_p0.v;
+  y2 = _mm512_mul_ps(y2, z);
+  y2 = _mm512_add_ps(y2, _ps512_sincof_p1.v);
+  y2 = _mm512_mul_ps(y2, z);
+  y2 = _mm512_add_ps(y2, _ps512_sincof_p2.v);
+  y2 = _mm512_mul_ps(y2, z);
+  y2 = _mm512_mul_ps(y2, x);
+  y2 = _mm512_add_ps(y2, x);
+
+  /* select the correct result from the two polynoms */
+  y = _mm512_mask_blend_ps(poly_mask, y, y2);
+  /* update the sign */
+  y = _mathfun_mm512_xor_ps(y, sign_bit);
+
+  return y;
+}
+
+/* almost the same as sin_ps */
+v16sf cos512_ps(v16sf x) { // any x
+  v16sf xmm1, xmm2, xmm3, y;
+  v16si imm0, imm2;
+
+  /* take the absolute value */
+  x = _mathfun_mm512_and_ps(x, _ps512_inv_sign_mask.v);
+
+  /* scale by 4/Pi */
+  y = _mm512_mul_ps(x, _ps512_cephes_FOPI.v);
+
+  /* store the integer part of y in mm0 */
+  imm2 = _mm512_cvttps_epi32(y);
+  /* j=(j+1) & (~1) (see the cephes sources) */
+  imm2 = _mm512_add_epi32(imm2, _pi32_512_1.vi);
+  imm2 = _mm512_and_si512(imm2, _pi32_512_inv1.vi);
+  y = _mm512_cvtepi32_ps(imm2);
+  imm2 = _mm512_sub_epi32(imm2, _pi32_512_2.vi);
+
+  /* get the swap sign flag */
+  imm0 = _mm512_andnot_si512(imm2, _pi32_512_4.vi);
+  imm0 = _mm512_slli_epi32(imm0, 29);
+  /* get the polynom selection mask */
+  imm2 = _mm512_and_si512(imm2, _pi32_512_2.vi);
+  __mmask16 poly_mask = _mm512_cmpeq_epi32_mask(imm2, _pi32_512_0.vi);
+
+  v16sf sign_bit = _mm512_castsi512_ps(imm0);
+
+  /* The magic pass: "Extended precision modular arithmetic"
+     x = ((x - y * DP1) - y * DP2) - y * DP3; */
+  xmm1 = _ps512_minus_cephes_DP1.v;
+  xmm2 = _ps512_minus_cephes_DP2.v;
+  xmm3 = _ps512_minus_cephes_DP3.v;
+  xmm1 = _mm512_mul_ps(y, xmm1);
+  xmm2 = _mm512_mul_ps(y, xmm2);
+  xmm3 = _mm512_mul_ps(y, xmm3);
+  x = _mm512_add_ps(x, xmm1);
+  x = _mm512_add_ps(x, xmm2);
+  x = _mm512_add_ps(x, xmm3);
+
+  /* Evaluate the first polynom  (0 <= x <= Pi/4) */
+  y = _ps512_coscof_p0.v;
+  v16sf z = _mm512_mul_ps(x,x);
+
+  y = _mm512_mul_ps(y, z);
+  y = _mm512_add_ps(y, _ps512_coscof_p1.v);
+  y = _mm512_mul_ps(y, z);
+  y = _mm512_add_ps(y, _ps512_coscof_p2.v);
+  y = _mm512_mul_ps(y, z);
+  y = _mm512_mul_ps(y, z);
+  v16sf tmp = _mm512_mul_ps(z, _ps512_0p5.v);
+  y = _mm512_sub_ps(y, tmp);
+  y = _mm512_add_ps(y, _ps512_1.v);
+
+  /* Evaluate the second polynom  (Pi/4 <= x <= 0) */
+
+  v16sf y2 = _ps512_sincof_p0.v;
+  y2 = _mm512_mul_ps(y2, z);
+  y2 = _mm512_add_ps(y2, _ps512_sincof_p1.v);
+  y2 = _mm512_mul_ps(y2, z);
+  y2 = _mm512_add_ps(y2, _ps512_sincof_p2.v);
+  y2 = _mm512_mul_ps(y2, z);
+  y2 = _mm512_mul_ps(y2, x);
+  y2 = _mm512_add_ps(y2, x);
+
+  /* select the correct result from the two polynoms */
+  y = _mm512_mask_blend_ps(poly_mask, y, y2);
+  /* update the sign */
+  y = _mathfun_mm512_xor_ps(y, sign_bit);
+
+  return y;
+}
+
+/* since sin512_ps and cos512_ps are almost identical, sincos512_ps could replace both of them..
+   it is almost as fast, and gives you a free cosine with your sine */
+void sincos512_ps(v16sf x, v16sf *s, v16sf *c) {
+
+  v16sf xmm1, xmm2, xmm3, sign_bit_sin, y;
+  v16si imm0, imm2, imm4;
+
+  sign_bit_sin = x;
+  /* take the absolute value */
+  x = _mathfun_mm512_and_ps(x, _ps512_inv_sign_mask.v);
+  /* extract the sign bit (upper one) */
+  sign_bit_sin = _mathfun_mm512_and_ps(sign_bit_sin, _ps512_sign_mask.v);
+
+  /* scale by 4/Pi */
+  y = _mm512_mul_ps(x, _ps512_cephes_FOPI.v);
+
+  /* store the integer part of y in imm2 */
+  imm2 = _mm512_cvttps_epi32(y);
+
+  /* j=(j+1) & (~1) (see the cephes sources) */
+  imm2 = _mm512_add_epi32(imm2, _pi32_512_1.vi);
+  imm2 = _mm512_and_si512(imm2, _pi32_512_inv1.vi);
+
+  y = _mm512_cvtepi32_ps(imm2);
+  imm4 = imm2;
+
+  /* get the swap sign flag for the sine */
+  imm0 = _mm512_and_si512(imm2, _pi32_512_4.vi);
+  imm0 = _mm512_slli_epi32(imm0, 29);
+  v16sf swap_sign_bit_sin = _mm512_castsi512_ps(imm0);
+
+  /* get the polynom selection mask for the sine*/
+  imm2 = _mm512_and_si512(imm2, _pi32_512_2.vi);
+  __mmask16 poly_mask = _mm512_cmpeq_epi32_mask(imm2, _pi32_512_0.vi);
+
+  /* The magic pass: "Extended precision modular arithmetic"
+     x = ((x - y * DP1) - y * DP2) - y * DP3; */
+  xmm1 = _ps512_minus_cephes_DP1.v;
+  xmm2 = _ps512_minus_cephes_DP2.v;
+  xmm3 = _ps512_minus_cephes_DP3.v;
+  xmm1 = _mm512_mul_ps(y, xmm1);
+  xmm2 = _mm512_mul_ps(y, xmm2);
+  xmm3 = _mm512_mul_ps(y, xmm3);
+  x = _mm512_add_ps(x, xmm1);
+  x = _mm512_add_ps(x, xmm2);
+  x = _mm512_add_ps(x, xmm3);
+
+  imm4 = _mm512_sub_epi32(imm4, _pi32_512_2.vi);
+  imm4 = _mm512_andnot_si512(imm4, _pi32_512_4.vi);
+  imm4 = _mm512_slli_epi32(imm4, 29);
+
+  v16sf sign_bit_cos = _mm512_castsi512_ps(imm4);
+
+  sign_bit_sin = _mathfun_mm512_xor_ps(sign_bit_sin, swap_sign_bit_sin);
+
+  /* Evaluate the first polynom  (0 <= x <= Pi/4) */
+  v16sf z = _mm512_mul_ps(x,x);
+  y = _ps512_coscof_p0.v;
+
+  y = _mm512_mul_ps(y, z);
+  y = _mm512_add_ps(y, _ps512_coscof_p1.v);
+  y = _mm512_mul_ps(y, z);
+  y = _mm512_add_ps(y, _ps512_coscof_p2.v);
+  y = _mm512_mul_ps(y, z);
+  y = _mm512_mul_ps(y, z);
+  v16sf tmp = _mm512_mul_ps(z, _ps512_0p5.v);
+  y = _mm512_sub_ps(y, tmp);
+  y = _mm512_add_ps(y, _ps512_1.v);
+
+  /* Evaluate the second polynom  (Pi/4 <= x <= 0) */
+
+  v16sf y2 = _ps512_sincof_p0.v;
+  y2 = _mm512_mul_ps(y2, z);
+  y2 = _mm512_add_ps(y2, _ps512_sincof_p1.v);
+  y2 = _mm512_mul_ps(y2, z);
+  y2 = _mm512_add_ps(y2, _ps512_sincof_p2.v);
+  y2 = _mm512_mul_ps(y2, z);
+  y2 = _mm512_mul_ps(y2, x);
+  y2 = _mm512_add_ps(y2, x);
+
+  /* select the correct result from the two polynoms */
+  xmm1 = _mm512_mask_blend_ps(poly_mask, y, y2);
+  xmm2 = _mm512_mask_blend_ps(poly_mask, y2, y);
+
+  /* update the sign */
+  *s = _mathfun_mm512_xor_ps(xmm1, sign_bit_sin);
+  *c = _mathfun_mm512_xor_ps(xmm2, sign_bit_cos);
+}
+
+/* sincos2pi() variant of sincos512_ps() above, computing
+ * sin(2pi*x) and cos(2pi*x) of input 'x', which is often used in our F-stat codes
+ */
+_PS512_CONST(2pi, 6.28318530717959f);	// LAL_TWOPI
+void
+sincos512_ps_2pi(v16sf xx, v16sf *s, v16sf *c)
+{
+  // convert from input 'xx' to actual angle '2pi * xx', the rest follows unchanged
+  v16sf x = _mm512_mul_ps ( xx, _ps512_2pi.v );
+
+  sincos512_ps ( x, s, c );
+
+  return;
+} // sincos512_ps_2pi
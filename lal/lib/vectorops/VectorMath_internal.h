@@ -53,86 +53,115 @@
 #define DECLARE_VECTORMATH_S2I(NAME, ...)                                    \
   DECLARE_VECTORMATH_ANY( NAME ## REAL4, ( INT4 *out, const REAL4 *in, const UINT4 len ), __VA_ARGS__ )
 
-DECLARE_VECTORMATH_S2I(INT4From, SSE2, NONE, NONE, NONE)
+DECLARE_VECTORMATH_S2I(INT4From, AVX512F, SSE2, NONE, NONE)
 
 /* declare internal prototypes of SIMD-specific vector math functions with 1 REAL4 vector input to 1 REAL4 vector output (S2S) */
 #define DECLARE_VECTORMATH_S2S(NAME, ...)                                    \
   DECLARE_VECTORMATH_ANY( NAME ## REAL4, ( REAL4 *out, const REAL4 *in, const UINT4 len ), __VA_ARGS__ )
 
-DECLARE_VECTORMATH_S2S(Sin, AVX2, AVX, SSE2, NONE)
-DECLARE_VECTORMATH_S2S(Cos, AVX2, AVX, SSE2, NONE)
-DECLARE_VECTORMATH_S2S(Exp, AVX2, AVX, SSE2, NONE)
-DECLARE_VECTORMATH_S2S(Log, AVX2, AVX, SSE2, NONE)
-DECLARE_VECTORMATH_S2S(Round, AVX2, AVX, NONE, NONE)
+DECLARE_VECTORMATH_S2S(Sin, AVX512F, AVX2, AVX, SSE2)
+DECLARE_VECTORMATH_S2S(Cos, AVX512F, AVX2, AVX, SSE2)
+DECLARE_VECTORMATH_S2S(Exp, AVX512F, AVX2, AVX, SSE2)
+DECLARE_VECTORMATH_S2S(Log, AVX512F, AVX2, AVX, SSE2)
+DECLARE_VECTORMATH_S2S(Round, AVX512F, AVX2, AVX, NONE)
 
 /* declare internal prototypes of SIMD-specific vector math functions with 1 REAL4 vector input to 2 REAL4 vector outputs (S2SS) */
 #define DECLARE_VECTORMATH_S2SS(NAME, ...)                                   \
   DECLARE_VECTORMATH_ANY( NAME ## REAL4, ( REAL4 *out1, REAL4 *out2, const REAL4 *in, const UINT4 len ), __VA_ARGS__ )
 
-DECLARE_VECTORMATH_S2SS(SinCos, AVX2, AVX, SSE2, NONE)
-DECLARE_VECTORMATH_S2SS(SinCos2Pi, AVX2, AVX, SSE2, NONE)
+DECLARE_VECTORMATH_S2SS(SinCos, AVX512F, AVX2, AVX, SSE2)
+DECLARE_VECTORMATH_S2SS(SinCos2Pi, AVX512F, AVX2, AVX, SSE2)
 
 /* declare internal prototypes of SIMD-specific vector math functions with 2 REAL4 vector inputs to 1 REAL4 vector output (SS2S) */
 #define DECLARE_VECTORMATH_SS2S(NAME, ...)                                   \
   DECLARE_VECTORMATH_ANY( NAME ## REAL4, ( REAL4 *out, const REAL4 *in1, const REAL4 *in2, const UINT4 len ), __VA_ARGS__ )
 
-DECLARE_VECTORMATH_SS2S(Add, AVX2, AVX, SSE2, NONE)
-DECLARE_VECTORMATH_SS2S(Sub, AVX2, AVX, SSE2, NONE)
-DECLARE_VECTORMATH_SS2S(Multiply, AVX2, AVX, SSE2, NONE)
-DECLARE_VECTORMATH_SS2S(Max, AVX2, AVX, SSE2, NONE)
+DECLARE_VECTORMATH_SS2S(Add, AVX512F, AVX2, AVX, SSE2)
+DECLARE_VECTORMATH_SS2S(Sub, AVX512F, AVX2, AVX, SSE2)
+DECLARE_VECTORMATH_SS2S(Multiply, AVX512F, AVX2, AVX, SSE2)
+DECLARE_VECTORMATH_SS2S(Max, AVX512F, AVX2, AVX, SSE2)
 
 /* declare internal prototypes of SIMD-specific vector math functions with 1 REAL4 scalar and 1 REAL4 vector input to 1 REAL4 vector output (sS2S) */
 #define DECLARE_VECTORMATH_sS2S(NAME, ...) \
   DECLARE_VECTORMATH_ANY( NAME ## REAL4, ( REAL4 *out, REAL4 scalar, const REAL4 *in, const UINT4 len ), __VA_ARGS__ )
 
-DECLARE_VECTORMATH_sS2S(Shift, AVX2, AVX, SSE2, NONE)
-DECLARE_VECTORMATH_sS2S(Scale, AVX2, AVX, SSE2, NONE)
+DECLARE_VECTORMATH_sS2S(Shift, AVX512F, AVX2, AVX, SSE2)
+DECLARE_VECTORMATH_sS2S(Scale, AVX512F, AVX2, AVX, SSE2)
 
 /* declare internal prototypes of SIMD-specific vector math functions with 2 REAL4 vector inputs to 1 UINT4 scalar and 1 UINT4 vector output (SS2uU) */
 #define DECLARE_VECTORMATH_SS2uU(NAME, ...)                            \
   DECLARE_VECTORMATH_ANY( NAME ## REAL4, ( UINT4* count, UINT4 *out, const REAL4 *in1, const REAL4 *in2, const UINT4 len ), __VA_ARGS__ )
 
-DECLARE_VECTORMATH_SS2uU(FindVectorLessEqual, AVX2, SSSE3, NONE, NONE)
+DECLARE_VECTORMATH_SS2uU(FindVectorLessEqual, AVX512F, AVX2, SSSE3, NONE)
 
 /* declare internal prototypes of SIMD-specific vector math functions with 1 REAL4 scalar and 1 REAL4 vector inputs to 1 UINT4 scalar and 1 UINT4 vector output (sS2uU) */
 #define DECLARE_VECTORMATH_sS2uU(NAME, ...)                            \
   DECLARE_VECTORMATH_ANY( NAME ## REAL4, ( UINT4* count, UINT4 *out, REAL4 scalar, const REAL4 *in, const UINT4 len ), __VA_ARGS__ )
 
-DECLARE_VECTORMATH_sS2uU(FindScalarLessEqual, AVX2, SSSE3, NONE, NONE)
+DECLARE_VECTORMATH_sS2uU(FindScalarLessEqual, AVX512F, AVX2, SSSE3, NONE)
 
 
 /* declare internal prototypes of SIMD-specific vector math functions with 1 REAL8 scalar and 1 REAL8 vector input to 1 REAL8 vector output (dD2D) */
 #define DECLARE_VECTORMATH_dD2D(NAME, ...) \
   DECLARE_VECTORMATH_ANY( NAME ## REAL8, ( REAL8 *out, REAL8 scalar, const REAL8 *in, const UINT4 len ), __VA_ARGS__ )
 
-DECLARE_VECTORMATH_dD2D(Scale, AVX2, AVX, SSE2, NONE)
-DECLARE_VECTORMATH_dD2D(Shift, AVX2, AVX, SSE2, NONE)
+DECLARE_VECTORMATH_dD2D(Scale, AVX512F, AVX2, AVX, SSE2)
+DECLARE_VECTORMATH_dD2D(Shift, AVX512F, AVX2, AVX, SSE2)
 
 /* declare internal prototypes of SIMD-specific vector math functions with 2 REAL8 vector inputs to 1 REAL8 vector output (DD2D) */
 #define DECLARE_VECTORMATH_DD2D(NAME, ...)                                   \
   DECLARE_VECTORMATH_ANY( NAME ## REAL8, ( REAL8 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len ), __VA_ARGS__ )
 
-DECLARE_VECTORMATH_DD2D(Add, AVX2, AVX, SSE2, NONE)
-DECLARE_VECTORMATH_DD2D(Sub, AVX2, AVX, SSE2, NONE)
-DECLARE_VECTORMATH_DD2D(Multiply, AVX2, AVX, SSE2, NONE)
-DECLARE_VECTORMATH_DD2D(Max, AVX2, AVX, NONE, NONE)
+DECLARE_VECTORMATH_DD2D(Add, AVX512F, AVX2, AVX, SSE2)
+DECLARE_VECTORMATH_DD2D(Sub, AVX512F, AVX2, AVX, SSE2)
+DECLARE_VECTORMATH_DD2D(Multiply, AVX512F, AVX2, AVX, SSE2)
+DECLARE_VECTORMATH_DD2D(Max, AVX512F, AVX2, AVX, NONE)
 
 /* declare internal prototypes of SIMD-specific vector math functions with 2 COMPLEX8 vector inputs to 1 COMPLEX8 vector output (CC2C) */
 #define DECLARE_VECTORMATH_CC2C(NAME, ...)                                   \
   DECLARE_VECTORMATH_ANY( NAME ## COMPLEX8, ( COMPLEX8 *out, const COMPLEX8 *in1, const COMPLEX8 *in2, const UINT4 len ), __VA_ARGS__ )
 
-DECLARE_VECTORMATH_CC2C(Multiply, AVX2, AVX, SSE2, NONE)
-DECLARE_VECTORMATH_CC2C(Add, AVX2, AVX, SSE2, NONE)
+DECLARE_VECTORMATH_CC2C(Multiply, AVX512F, AVX2, AVX, SSE2)
+DECLARE_VECTORMATH_CC2C(Add, AVX512F, AVX2, AVX, SSE2)
 
 /* declare internal prototypes of SIMD-specific vector math functions with 1 COMPLEX8 scalar and 1 COMPLEX8 vector input to 1 COMPLEX8 vector output (cC2C) */
 #define DECLARE_VECTORMATH_cC2C(NAME, ...) \
   DECLARE_VECTORMATH_ANY( NAME ## COMPLEX8, ( COMPLEX8 *out, COMPLEX8 scalar, const COMPLEX8 *in, const UINT4 len ), __VA_ARGS__ )
 
-DECLARE_VECTORMATH_cC2C(Scale, AVX2, AVX, SSE2, NONE)
-DECLARE_VECTORMATH_cC2C(Shift, AVX2, AVX, SSE2, NONE)
+DECLARE_VECTORMATH_cC2C(Scale, AVX512F, AVX2, AVX, SSE2)
+DECLARE_VECTORMATH_cC2C(Shift, AVX512F, AVX2, AVX, SSE2)
 
 /* declare internal prototypes of SIMD-specific vector math functions with 1 REAL8 vector input to 1 REAL8 vector output (D2D) */
 #define DECLARE_VECTORMATH_D2D(NAME, ...)                                    \
   DECLARE_VECTORMATH_ANY( NAME ## REAL8, ( REAL8 *out, const REAL8 *in, const UINT4 len ), __VA_ARGS__ )
 
-DECLARE_VECTORMATH_D2D(Round, AVX2, AVX, NONE, NONE)
+DECLARE_VECTORMATH_D2D(Round, AVX512F, AVX2, AVX, NONE)
+DECLARE_VECTORMATH_D2D(Exp, AVX512F, AVX2, SSE2, NONE)
+
+/* declare internal prototypes of SIMD-specific vector math functions with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) */
+#define DECLARE_VECTORMATH_D2DD(NAME, ...)                                   \
+  DECLARE_VECTORMATH_ANY( NAME ## REAL8, ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len ), __VA_ARGS__ )
+
+DECLARE_VECTORMATH_D2DD(SinCos, AVX512F, AVX2, SSE2, NONE)
+
+/* declare internal prototypes of SIMD-specific vector math functions with 2 REAL8 vector inputs to 1 COMPLEX16 vector output (DD2Z) */
+#define DECLARE_VECTORMATH_DD2Z(NAME, ...)                                   \
+  DECLARE_VECTORMATH_ANY( NAME ## COMPLEX16, ( COMPLEX16 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len ), __VA_ARGS__ )
+
+DECLARE_VECTORMATH_DD2Z(CExp, AVX512F, AVX2, SSE2, NONE)
+
+/* declare internal prototypes of SIMD-specific vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) */
+#define DECLARE_VECTORMATH_ZZ2Z(NAME, ...)                                   \
+  DECLARE_VECTORMATH_ANY( NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), __VA_ARGS__ )
+
+DECLARE_VECTORMATH_ZZ2Z(Multiply, AVX512F, AVX2, AVX, SSE2)
+DECLARE_VECTORMATH_ZZ2Z(MultiplyConj, AVX512F, AVX2, AVX, SSE2)
+
+/* declare internal prototypes of SIMD-specific vector math functions with 2 COMPLEX16 vector inputs, summed to 1 COMPLEX16 scalar output (ZZ2z) */
+#define DECLARE_VECTORMATH_ZZ2z(NAME, ...)                                   \
+  DECLARE_VECTORMATH_ANY( NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), __VA_ARGS__ )
+
+DECLARE_VECTORMATH_ZZ2z(DotProduct, AVX512F, AVX2, AVX, SSE2)
+
+/* declare internal prototypes of SIMD-specific vector math functions computing the weighted inner products of a COMPLEX16 vector with a time-shifted COMPLEX16 vector */
+DECLARE_VECTORMATH_ANY( TimeShiftedInnerProductsCOMPLEX16, ( COMPLEX16 *dh, REAL8 *hh, REAL8 *dd, REAL8 *rr, const COMPLEX16 *d, const COMPLEX16 *h, const REAL8 *w, const REAL8 phi0, const REAL8 dphi, const UINT4 len ), AVX512F, AVX2, AVX, NONE )
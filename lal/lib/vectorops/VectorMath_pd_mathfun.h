@@ -0,0 +1,152 @@
+//
+// Copyright (C) 2026
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+//
+// Double-precision sincos() and exp() for SIMD vectors of any width.
+//
+// This file is a template: the including source must first define the vector types and operations below
+// for its instruction set, and PD_MATHFUN(name) to give the names of the resulting functions, e.g.
+//   #define PD_MATHFUN(name) name##256_pd
+// defines sincos256_pd() and exp256_pd(). Only operations available in SSE2, AVX2 and AVX512F are required.
+//
+// The polynomial and rational approximations are those of the Cephes math library [sin.c, exp.c] by
+// Stephen L. Moshier, evaluated on all elements of a vector without branches.
+//
+// sincos(): the argument is reduced to r = x - n*pi/2, |r| <= pi/4, with a 3-part Cody-Waite reduction,
+// and the quadrant n mod 4 is extracted from the bit pattern of the rounded x*2/pi. The absolute error
+// is below 2.5e-16 for |x| < 2^28 (approx. 2.7e8); for larger |x| the reduction gradually loses accuracy,
+// and for |x| >= 2^51 the result is meaningless.
+//
+// exp(): the argument is reduced to r = x - n*log(2), |r| <= log(2)/2, and exp(r) is evaluated by a
+// Pade-type rational approximation. The result is scaled by 2^n in two steps so that results in the
+// subnormal range, and overflow to +inf, are handled correctly. The relative error is below 3.5e-16 for
+// results in the normal range, and subnormal results are within 1 unit in the last place. NaN is propagated.
+//
+// Required definitions:
+//   PD_V, PD_VI                   vector of doubles, and of 64-bit integers, of the same width
+//   PD_SET1(x), PD_SET1_EPI64(x)  broadcast a double / 64-bit integer
+//   PD_ADD, PD_SUB, PD_MUL, PD_DIV, PD_MIN, PD_MAX
+//   PD_CASTPD_SI, PD_CASTSI_PD    reinterpret the bits of a vector of doubles / integers
+//   PD_AND_SI, PD_ANDNOT_SI, PD_OR_SI, PD_XOR_SI, PD_ADD_EPI64, PD_SUB_EPI64, PD_SLLI_EPI64
+//
+
+#ifndef PD_MATHFUN
+#error "PD_MATHFUN() must be defined before including VectorMath_pd_mathfun.h"
+#endif
+
+// 1.5 * 2^52: adding this to |y| < 2^51 rounds y to the nearest integer n, which appears in the low bits of the sum
+#define PD_ROUND_MAGIC 6755399441055744.0
+
+// ---------- sincos() ----------
+
+static inline void
+PD_MATHFUN(sincos) ( PD_V x, PD_V *s, PD_V *c )
+{
+  const PD_V magic = PD_SET1( PD_ROUND_MAGIC );
+
+  // n = round(x * 2/pi); the low 2 bits of t are the quadrant n mod 4
+  PD_V t = PD_ADD( PD_MUL( x, PD_SET1( 6.36619772367581382433E-1 ) ), magic );
+  PD_V n = PD_SUB( t, magic );
+  PD_VI q = PD_CASTPD_SI( t );
+
+  // r = x - n * pi/2, with pi/2 split into 3 parts; n * DP1 is exact for |n| < 2^29
+  PD_V r = PD_SUB( x, PD_MUL( n, PD_SET1( 1.57079625129699707031E0 ) ) );
+  r = PD_SUB( r, PD_MUL( n, PD_SET1( 7.54978941586159635335E-8 ) ) );
+  r = PD_SUB( r, PD_MUL( n, PD_SET1( 5.39030285815811905290E-15 ) ) );
+  PD_V z = PD_MUL( r, r );
+
+  // sin(r) = r + r^3 P(r^2)
+  PD_V ps = PD_SET1( 1.58962301576546568060E-10 );
+  ps = PD_ADD( PD_MUL( ps, z ), PD_SET1( -2.50507477628578072866E-8 ) );
+  ps = PD_ADD( PD_MUL( ps, z ), PD_SET1( 2.75573136213857245213E-6 ) );
+  ps = PD_ADD( PD_MUL( ps, z ), PD_SET1( -1.98412698295895385996E-4 ) );
+  ps = PD_ADD( PD_MUL( ps, z ), PD_SET1( 8.33333333332211858878E-3 ) );
+  ps = PD_ADD( PD_MUL( ps, z ), PD_SET1( -1.66666666666666307295E-1 ) );
+  ps = PD_ADD( r, PD_MUL( PD_MUL( ps, z ), r ) );
+
+  // cos(r) = 1 - r^2/2 + r^4 Q(r^2)
+  PD_V pc = PD_SET1( -1.13585365213876817300E-11 );
+  pc = PD_ADD( PD_MUL( pc, z ), PD_SET1( 2.08757008419747316778E-9 ) );
+  pc = PD_ADD( PD_MUL( pc, z ), PD_SET1( -2.75573141792967388112E-7 ) );
+  pc = PD_ADD( PD_MUL( pc, z ), PD_SET1( 2.48015872888517045348E-5 ) );
+  pc = PD_ADD( PD_MUL( pc, z ), PD_SET1( -1.38888888888730564116E-3 ) );
+  pc = PD_ADD( PD_MUL( pc, z ), PD_SET1( 4.16666666666665929218E-2 ) );
+  pc = PD_ADD( PD_SUB( PD_SET1( 1.0 ), PD_MUL( PD_SET1( 0.5 ), z ) ), PD_MUL( PD_MUL( pc, z ), z ) );
+
+  // swap sin(r) and cos(r) in odd quadrants
+  const PD_VI one = PD_SET1_EPI64( 1 ), two = PD_SET1_EPI64( 2 );
+  PD_VI swap = PD_SUB_EPI64( PD_SET1_EPI64( 0 ), PD_AND_SI( q, one ) );
+  PD_VI psi = PD_CASTPD_SI( ps ), pci = PD_CASTPD_SI( pc );
+  PD_VI si = PD_OR_SI( PD_AND_SI( swap, pci ), PD_ANDNOT_SI( swap, psi ) );
+  PD_VI ci = PD_OR_SI( PD_AND_SI( swap, psi ), PD_ANDNOT_SI( swap, pci ) );
+
+  // sin(x) is negative in quadrants 2,3, cos(x) in quadrants 1,2
+  PD_VI sign_s = PD_SLLI_EPI64( PD_AND_SI( q, two ), 62 );
+  PD_VI sign_c = PD_SLLI_EPI64( PD_AND_SI( PD_ADD_EPI64( q, one ), two ), 62 );
+  *s = PD_CASTSI_PD( PD_XOR_SI( si, sign_s ) );
+  *c = PD_CASTSI_PD( PD_XOR_SI( ci, sign_c ) );
+
+}
+
+// ---------- exp() ----------
+
+static inline PD_V
+PD_MATHFUN(exp) ( PD_V x )
+{
+  const PD_V magic = PD_SET1( PD_ROUND_MAGIC );
+
+  // clamp x to a range where exp() underflows to 0 or overflows to +inf; the order of operands propagates NaN
+  x = PD_MIN( PD_SET1( 710.0 ), x );
+  x = PD_MAX( PD_SET1( -746.0 ), x );
+
+  // n = round(x / log(2))
+  PD_V t = PD_ADD( PD_MUL( x, PD_SET1( 1.4426950408889634073599 ) ), magic );
+  PD_V n = PD_SUB( t, magic );
+  PD_VI ni = PD_SUB_EPI64( PD_CASTPD_SI( t ), PD_CASTPD_SI( magic ) );
+
+  // r = x - n * log(2), with log(2) split into 2 parts
+  PD_V r = PD_SUB( x, PD_MUL( n, PD_SET1( 6.93145751953125E-1 ) ) );
+  r = PD_SUB( r, PD_MUL( n, PD_SET1( 1.42860682030941723212E-6 ) ) );
+  PD_V z = PD_MUL( r, r );
+
+  // exp(r) = 1 + 2 r P(r^2) / ( Q(r^2) - r P(r^2) )
+  PD_V px = PD_SET1( 1.26177193074810590878E-4 );
+  px = PD_ADD( PD_MUL( px, z ), PD_SET1( 3.02994407707441961300E-2 ) );
+  px = PD_ADD( PD_MUL( px, z ), PD_SET1( 9.99999999999999999910E-1 ) );
+  px = PD_MUL( px, r );
+  PD_V qx = PD_SET1( 3.00198505138664455042E-6 );
+  qx = PD_ADD( PD_MUL( qx, z ), PD_SET1( 2.52448340349684104192E-3 ) );
+  qx = PD_ADD( PD_MUL( qx, z ), PD_SET1( 2.27265548208155028766E-1 ) );
+  qx = PD_ADD( PD_MUL( qx, z ), PD_SET1( 2.00000000000000000009E0 ) );
+  PD_V e = PD_DIV( px, PD_SUB( qx, px ) );
+  e = PD_ADD( PD_SET1( 1.0 ), PD_ADD( e, e ) );
+
+  // multiply by 2^n = 2^n1 * 2^n2, with n1 = round(n/2) and n2 = n - n1, so that both factors are normal numbers
+  PD_V t1 = PD_ADD( PD_MUL( n, PD_SET1( 0.5 ) ), magic );
+  PD_VI n1 = PD_SUB_EPI64( PD_CASTPD_SI( t1 ), PD_CASTPD_SI( magic ) );
+  PD_VI n2 = PD_SUB_EPI64( ni, n1 );
+  const PD_VI bias = PD_SET1_EPI64( 1023 );
+  PD_V scale1 = PD_CASTSI_PD( PD_SLLI_EPI64( PD_ADD_EPI64( n1, bias ), 52 ) );
+  PD_V scale2 = PD_CASTSI_PD( PD_SLLI_EPI64( PD_ADD_EPI64( n2, bias ), 52 ) );
+
+  return PD_MUL( PD_MUL( e, scale1 ), scale2 );
+
+}
+
+#undef PD_ROUND_MAGIC
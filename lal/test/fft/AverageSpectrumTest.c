@@ -17,11 +17,15 @@
 *  MA  02111-1307  USA
 */
 
+#include <float.h>
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <lal/LALStdlib.h>
 #include <lal/AVFactories.h>
+#include <lal/FrequencySeries.h>
+#include <lal/Units.h>
 #include <lal/TimeFreqFFT.h>
 #include <lal/RealFFT.h>
 #include <lal/Window.h>
@@ -31,6 +35,102 @@
   if ( (s)->statusCode ) { REPORTSTATUS( s ); exit( 1 ); } else \
 ((void)0)
 
+static int compare( const void *p1, const void *p2 )
+{
+  REAL4 x1 = *(const REAL4 *)p1;
+  REAL4 x2 = *(const REAL4 *)p2;
+  return (x1 > x2) - (x1 < x2);
+}
+
+/* check the median-mean spectrum against medians found by sorting the
+ * periodograms of the even and odd segments in each bin */
+/*
+ * relative tolerance of the median-mean test; the reference periodograms
+ * are computed with XLALREAL4ModifiedPeriodogram() and the medians by
+ * sorting, so the spectra should agree to the last bit, but the reference
+ * median-mean is formed in double precision and rounded once, which can
+ * differ from the single-precision arithmetic of the library by an ulp or
+ * two of a REAL4
+ */
+#define MEDIAN_MEAN_RELTOL ( 4 * FLT_EPSILON )
+
+static int test_median_mean( UINT4 seglen, UINT4 numseg )
+{
+  const UINT4 stride = seglen / 2;
+  const UINT4 half = numseg / 2;
+  const UINT4 numbin = seglen / 2 + 1;
+  REAL4TimeSeries tseries;
+  REAL4FrequencySeries *spectrum;
+  REAL4FrequencySeries *work;
+  REAL4Sequence segment;
+  REAL4Vector *periodograms;
+  REAL4 bin[2][half];
+  RandomParams *randpar;
+  REAL4FFTPlan *plan;
+  REAL4Window *window;
+  REAL4 biasfac;
+  REAL4 normfac;
+  UINT4 seg, k, j;
+
+  memset( &tseries, 0, sizeof( tseries ) );
+  tseries.deltaT = 1;
+  tseries.data = XLALCreateREAL4Vector( (numseg - 1) * stride + seglen );
+  spectrum = XLALCreateREAL4FrequencySeries( NULL, &tseries.epoch, 0, 0, &lalDimensionlessUnit, numbin );
+  work = XLALCreateREAL4FrequencySeries( NULL, &tseries.epoch, 0, 0, &lalDimensionlessUnit, numbin );
+  periodograms = XLALCreateREAL4Vector( numseg * numbin );
+  randpar = XLALCreateRandomParams( 2 );
+  plan = XLALCreateForwardREAL4FFTPlan( seglen, 0 );
+  window = XLALCreateHannREAL4Window( seglen );
+  XLAL_CHECK( tseries.data && spectrum && work && periodograms && randpar && plan && window, XLAL_EFUNC );
+  XLAL_CHECK( XLALNormalDeviates( tseries.data, randpar ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  XLAL_CHECK( XLALREAL4AverageSpectrumMedianMean( spectrum, &tseries, seglen, stride, window, plan ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* reference periodograms */
+  segment.length = seglen;
+  for ( seg = 0; seg < numseg; ++seg )
+  {
+    REAL4TimeSeries tsegment = tseries;
+    segment.data = tseries.data->data + seg * stride;
+    tsegment.data = &segment;
+    XLAL_CHECK( XLALREAL4ModifiedPeriodogram( work, &tsegment, window, plan ) == XLAL_SUCCESS, XLAL_EFUNC );
+    memcpy( periodograms->data + seg * numbin, work->data->data, numbin * sizeof( REAL4 ) );
+  }
+
+  /* results must agree with sorting to within MEDIAN_MEAN_RELTOL */
+  biasfac = XLALMedianBias( half );
+  normfac = 1.0 / ( 2.0 * biasfac );
+  for ( k = 0; k < numbin; ++k )
+  {
+    REAL4 median[2];
+    for ( j = 0; j < 2; ++j )
+    {
+      for ( seg = 0; seg < half; ++seg )
+        bin[j][seg] = periodograms->data[(2 * seg + j) * numbin + k];
+      qsort( bin[j], half, sizeof( REAL4 ), compare );
+      if ( half % 2 )
+        median[j] = bin[j][half/2];
+      else
+        median[j] = 0.5*(bin[j][half/2-1] + bin[j][half/2]);
+    }
+    {
+      const REAL8 expect = normfac * (median[0] + median[1]);
+      const REAL8 err = fabs( spectrum->data->data[k] - expect );
+      XLAL_CHECK( err <= MEDIAN_MEAN_RELTOL * fabs( expect ), XLAL_ETOL, "Median-mean spectrum differs at bin %u: %g != %g", k, spectrum->data->data[k], expect );
+    }
+  }
+
+  XLALDestroyREAL4Vector( tseries.data );
+  XLALDestroyREAL4FrequencySeries( spectrum );
+  XLALDestroyREAL4FrequencySeries( work );
+  XLALDestroyREAL4Vector( periodograms );
+  XLALDestroyRandomParams( randpar );
+  XLALDestroyREAL4FFTPlan( plan );
+  XLALDestroyREAL4Window( window );
+
+  return XLAL_SUCCESS;
+}
+
 int main( void )
 {
   const UINT4 n = 65536;
@@ -94,6 +194,11 @@ int main( void )
   fprintf( stdout, "mean:\t%e\terror:\t%f%%\n", ave, fabs( ave - 2.0 ) / 0.02 );
 
 
+  /* median-mean spectra with numbers of segments below and above the
+   * sorting threshold, and with odd and even numbers of medians */
+  if ( test_median_mean( 256, 10 ) != XLAL_SUCCESS || test_median_mean( 256, 44 ) != XLAL_SUCCESS || test_median_mean( 128, 70 ) != XLAL_SUCCESS )
+    return 1;
+
   /* cleanup */
   XLALDestroyREAL4Window( window );
   XLALDestroyREAL4FFTPlan( plan );
@@ -0,0 +1,170 @@
+/*
+ *  Copyright (C) 2026
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <complex.h>
+#include <lal/LALStdlib.h>
+#include <lal/AVFactories.h>
+#include <lal/SeqFactories.h>
+#include <lal/RealFFT.h>
+#include <lal/ComplexFFT.h>
+
+/* compare a batched real-to-complex transform with single transforms; element
+ * j of transform i is at j * istride + i * idist */
+static int test_real_many( UINT4 n, UINT4 howmany, UINT4 stride )
+{
+  const UINT4 m = n / 2 + 1;
+  const UINT4 dist = stride == 1 ? n : 1;
+  const UINT4 cdist = stride == 1 ? m : 1;
+  const UINT4 istride = stride == 1 ? 1 : stride;
+
+  REAL8FFTPlan *fwd = XLALCreateForwardREAL8FFTPlan( n, 0 );
+  REAL8FFTPlan *rev = XLALCreateReverseREAL8FFTPlan( n, 0 );
+  REAL8FFTPlan *fwdmany = XLALCreateREAL8FFTPlanMany( n, howmany, stride, 1, 0 );
+  REAL8FFTPlan *revmany = XLALCreateREAL8FFTPlanMany( n, howmany, stride, 0, 0 );
+  XLAL_CHECK( fwd && rev && fwdmany && revmany, XLAL_EFUNC );
+
+  REAL8VectorSequence *x = stride == 1 ? XLALCreateREAL8VectorSequence( howmany, n ) : XLALCreateREAL8VectorSequence( n, stride );
+  REAL8VectorSequence *y = stride == 1 ? XLALCreateREAL8VectorSequence( howmany, n ) : XLALCreateREAL8VectorSequence( n, stride );
+  COMPLEX16VectorSequence *z = stride == 1 ? XLALCreateCOMPLEX16VectorSequence( howmany, m ) : XLALCreateCOMPLEX16VectorSequence( m, stride );
+  REAL8Vector *x1 = XLALCreateREAL8Vector( n );
+  REAL8Vector *y1 = XLALCreateREAL8Vector( n );
+  COMPLEX16Vector *z1 = XLALCreateCOMPLEX16Vector( m );
+  XLAL_CHECK( x && y && z && x1 && y1 && z1, XLAL_EFUNC );
+
+  for ( UINT4 i = 0; i < x->length * x->vectorLength; ++i ) {
+    x->data[i] = sin( 0.37 * i ) + cos( 0.011 * i * i );
+  }
+
+  /* batched plans must be rejected by the single-transform routines */
+  int errnum;
+  XLAL_TRY_SILENT( XLALREAL8ForwardFFT( z1, x1, fwdmany ), errnum );
+  XLAL_CHECK( errnum == XLAL_EINVAL, XLAL_EFAILED, "Single transform accepted a batched plan" );
+
+  XLAL_CHECK( XLALREAL8ForwardFFTMany( z, x, fwdmany ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALREAL8ReverseFFTMany( y, z, revmany ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  for ( UINT4 i = 0; i < howmany; ++i ) {
+    for ( UINT4 j = 0; j < n; ++j ) {
+      x1->data[j] = x->data[j * istride + i * dist];
+    }
+    XLAL_CHECK( XLALREAL8ForwardFFT( z1, x1, fwd ) == XLAL_SUCCESS, XLAL_EFUNC );
+    for ( UINT4 k = 0; k < m; ++k ) {
+      XLAL_CHECK( cabs( z->data[k * istride + i * cdist] - z1->data[k] ) < 1e-10 * n, XLAL_ETOL, "Forward transform %u differs at bin %u", i, k );
+    }
+    XLAL_CHECK( XLALREAL8ReverseFFT( y1, z1, rev ) == XLAL_SUCCESS, XLAL_EFUNC );
+    for ( UINT4 j = 0; j < n; ++j ) {
+      XLAL_CHECK( fabs( y->data[j * istride + i * dist] - y1->data[j] ) < 1e-10 * n, XLAL_ETOL, "Reverse transform %u differs at sample %u", i, j );
+    }
+  }
+
+  XLALDestroyREAL8FFTPlan( fwd );
+  XLALDestroyREAL8FFTPlan( rev );
+  XLALDestroyREAL8FFTPlan( fwdmany );
+  XLALDestroyREAL8FFTPlan( revmany );
+  XLALDestroyREAL8VectorSequence( x );
+  XLALDestroyREAL8VectorSequence( y );
+  XLALDestroyCOMPLEX16VectorSequence( z );
+  XLALDestroyREAL8Vector( x1 );
+  XLALDestroyREAL8Vector( y1 );
+  XLALDestroyCOMPLEX16Vector( z1 );
+
+  return XLAL_SUCCESS;
+}
+
+/* compare a batched complex transform with single transforms */
+static int test_complex_many( UINT4 n, UINT4 howmany, UINT4 stride )
+{
+  const UINT4 dist = stride == 1 ? n : 1;
+  const UINT4 istride = stride == 1 ? 1 : stride;
+
+  COMPLEX8FFTPlan *plan = XLALCreateForwardCOMPLEX8FFTPlan( n, 0 );
+  COMPLEX8FFTPlan *many = XLALCreateCOMPLEX8FFTPlanMany( n, howmany, stride, 1, 0 );
+  XLAL_CHECK( plan && many, XLAL_EFUNC );
+
+  COMPLEX8VectorSequence *x = stride == 1 ? XLALCreateCOMPLEX8VectorSequence( howmany, n ) : XLALCreateCOMPLEX8VectorSequence( n, stride );
+  COMPLEX8VectorSequence *y = stride == 1 ? XLALCreateCOMPLEX8VectorSequence( howmany, n ) : XLALCreateCOMPLEX8VectorSequence( n, stride );
+  COMPLEX8Vector *x1 = XLALCreateCOMPLEX8Vector( n );
+  COMPLEX8Vector *y1 = XLALCreateCOMPLEX8Vector( n );
+  XLAL_CHECK( x && y && x1 && y1, XLAL_EFUNC );
+
+  for ( UINT4 i = 0; i < x->length * x->vectorLength; ++i ) {
+    x->data[i] = crectf( sinf( 0.37 * i ), cosf( 0.011 * i * i ) );
+  }
+
+  XLAL_CHECK( XLALCOMPLEX8VectorFFTMany( y, x, many ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  for ( UINT4 i = 0; i < howmany; ++i ) {
+    for ( UINT4 j = 0; j < n; ++j ) {
+      x1->data[j] = x->data[j * istride + i * dist];
+    }
+    XLAL_CHECK( XLALCOMPLEX8VectorFFT( y1, x1, plan ) == XLAL_SUCCESS, XLAL_EFUNC );
+    for ( UINT4 k = 0; k < n; ++k ) {
+      XLAL_CHECK( cabsf( y->data[k * istride + i * dist] - y1->data[k] ) < 1e-4 * n, XLAL_ETOL, "Transform %u differs at bin %u", i, k );
+    }
+  }
+
+  XLALDestroyCOMPLEX8FFTPlan( plan );
+  XLALDestroyCOMPLEX8FFTPlan( many );
+  XLALDestroyCOMPLEX8VectorSequence( x );
+  XLALDestroyCOMPLEX8VectorSequence( y );
+  XLALDestroyCOMPLEX8Vector( x1 );
+  XLALDestroyCOMPLEX8Vector( y1 );
+
+  return XLAL_SUCCESS;
+}
+
+int main( void )
+{
+
+  /* Turn off buffering to sync standard output and error printing */
+  setvbuf( stdout, NULL, _IONBF, 0 );
+  setvbuf( stderr, NULL, _IONBF, 0 );
+
+  /* Skip test if batched transforms are not supported by the FFT backend */
+  REAL8FFTPlan *plan = NULL;
+  int errnum;
+  XLAL_TRY_SILENT( plan = XLALCreateREAL8FFTPlanMany( 16, 2, 1, 1, 0 ), errnum );
+  if ( errnum == XLAL_EFAILED ) {
+    fprintf( stderr, "Batched FFTs are not supported; skipping test\n" );
+    return 77;
+  }
+  XLAL_CHECK_MAIN( plan != NULL, XLAL_EFUNC );
+  XLALDestroyREAL8FFTPlan( plan );
+
+  /* Contiguous and strided layouts, with even and odd lengths, and numbers
+   * of transforms which do and do not divide evenly between threads */
+  XLAL_CHECK_MAIN( test_real_many( 64, 7, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_real_many( 63, 16, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_real_many( 64, 7, 9 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_real_many( 63, 5, 5 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_complex_many( 64, 7, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_complex_many( 45, 3, 11 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* Invalid arguments */
+  XLAL_TRY_SILENT( plan = XLALCreateREAL8FFTPlanMany( 16, 0, 1, 1, 0 ), errnum );
+  XLAL_CHECK_MAIN( plan == NULL && errnum == XLAL_EBADLEN, XLAL_EFAILED );
+  XLAL_TRY_SILENT( plan = XLALCreateREAL8FFTPlanMany( 16, 4, 3, 1, 0 ), errnum );
+  XLAL_CHECK_MAIN( plan == NULL && errnum == XLAL_EINVAL, XLAL_EFAILED );
+
+  LALCheckMemoryLeaks();
+
+  return 0;
+}
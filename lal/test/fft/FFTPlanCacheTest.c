@@ -0,0 +1,104 @@
+/*
+ *  Copyright (C) 2026
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <lal/LALStdlib.h>
+#include <lal/AVFactories.h>
+#include <lal/RealFFT.h>
+#include <lal/ComplexFFT.h>
+#include <lal/FFTPlanCache.h>
+
+int main( void )
+{
+
+  /* Turn off buffering to sync standard output and error printing */
+  setvbuf( stdout, NULL, _IONBF, 0 );
+  setvbuf( stderr, NULL, _IONBF, 0 );
+
+  const UINT4 n = 64;
+
+  /* Identical requests must return the same plan */
+  REAL8FFTPlan *fwd1 = XLALGetCachedREAL8FFTPlan( n, 1, 0 );
+  XLAL_CHECK_MAIN( fwd1 != NULL, XLAL_EFUNC );
+  REAL8FFTPlan *fwd2 = XLALGetCachedREAL8FFTPlan( n, 2, 0 );
+  XLAL_CHECK_MAIN( fwd2 == fwd1, XLAL_EFAILED, "Equivalent cached plans are not shared" );
+
+  /* Requests differing in direction, size, measurement level, or type must not */
+  REAL8FFTPlan *rev = XLALGetCachedREAL8FFTPlan( n, 0, 0 );
+  XLAL_CHECK_MAIN( rev != NULL && rev != fwd1, XLAL_EFAILED );
+  REAL8FFTPlan *fwd3 = XLALGetCachedREAL8FFTPlan( 2 * n, 1, 0 );
+  XLAL_CHECK_MAIN( fwd3 != NULL && fwd3 != fwd1, XLAL_EFAILED );
+  REAL8FFTPlan *fwd4 = XLALGetCachedREAL8FFTPlan( n, 1, 1 );
+  XLAL_CHECK_MAIN( fwd4 != NULL && fwd4 != fwd1, XLAL_EFAILED );
+  COMPLEX16FFTPlan *cfwd = XLALGetCachedCOMPLEX16FFTPlan( n, 1, 0 );
+  XLAL_CHECK_MAIN( cfwd != NULL && ( void * ) cfwd != ( void * ) fwd1, XLAL_EFAILED );
+
+  /* Cached plans must perform transforms */
+  REAL8Vector *x = XLALCreateREAL8Vector( n );
+  REAL8Vector *y = XLALCreateREAL8Vector( n );
+  COMPLEX16Vector *z = XLALCreateCOMPLEX16Vector( n / 2 + 1 );
+  XLAL_CHECK_MAIN( x != NULL && y != NULL && z != NULL, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < n; ++i ) {
+    x->data[i] = sin( 0.1 * i );
+  }
+  XLAL_CHECK_MAIN( XLALREAL8ForwardFFT( z, x, fwd1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALREAL8ReverseFFT( y, z, rev ) == XLAL_SUCCESS, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < n; ++i ) {
+    XLAL_CHECK_MAIN( fabs( y->data[i] / n - x->data[i] ) < 1e-12, XLAL_ETOL, "Round-trip transform failed at sample %u", i );
+  }
+  XLALDestroyREAL8Vector( x );
+  XLALDestroyREAL8Vector( y );
+  XLALDestroyCOMPLEX16Vector( z );
+
+  /* Release all references; a released plan is re-used by a later request */
+  XLALReleaseCachedREAL8FFTPlan( fwd1 );
+  XLALReleaseCachedREAL8FFTPlan( fwd2 );
+  fwd2 = XLALGetCachedREAL8FFTPlan( n, 1, 0 );
+  XLAL_CHECK_MAIN( fwd2 == fwd1, XLAL_EFAILED, "Released plan was not re-used" );
+  XLALReleaseCachedREAL8FFTPlan( fwd2 );
+  XLALReleaseCachedREAL8FFTPlan( rev );
+  XLALReleaseCachedREAL8FFTPlan( fwd3 );
+  XLALReleaseCachedREAL8FFTPlan( fwd4 );
+  XLALReleaseCachedCOMPLEX16FFTPlan( cfwd );
+
+  /* Batched plans are cached separately from single-transform plans, and
+   * by batch size */
+  REAL8FFTPlan *many1 = XLALGetCachedREAL8FFTPlanMany( n, 4, 1, 1, 0 );
+  XLAL_CHECK_MAIN( many1 != NULL && many1 != fwd1, XLAL_EFAILED );
+  REAL8FFTPlan *many2 = XLALGetCachedREAL8FFTPlanMany( n, 4, 1, 1, 0 );
+  XLAL_CHECK_MAIN( many2 == many1, XLAL_EFAILED, "Equivalent cached batched plans are not shared" );
+  REAL8FFTPlan *many3 = XLALGetCachedREAL8FFTPlanMany( n, 8, 1, 1, 0 );
+  XLAL_CHECK_MAIN( many3 != NULL && many3 != many1, XLAL_EFAILED );
+  XLALReleaseCachedREAL8FFTPlan( many1 );
+  XLALReleaseCachedREAL8FFTPlan( many2 );
+  XLALReleaseCachedREAL8FFTPlan( many3 );
+
+  /* Releasing a plan which is not held must fail */
+  int errnum;
+  XLAL_TRY_SILENT( XLALReleaseCachedREAL8FFTPlan( fwd1 ), errnum );
+  XLAL_CHECK_MAIN( errnum == XLAL_EINVAL, XLAL_EFAILED, "Expected XLAL_EINVAL, got %i", errnum );
+
+  /* Clear the cache and check for memory leaks */
+  XLALClearFFTPlanCache();
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
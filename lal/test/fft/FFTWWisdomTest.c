@@ -0,0 +1,166 @@
+/*
+ *  Copyright (C) 2026
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConfig.h>
+#include <lal/RealFFT.h>
+#include <lal/ComplexFFT.h>
+#include <lal/FFTWWisdom.h>
+
+#ifdef LAL_FFTW3_ENABLED
+
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <fftw3.h>
+
+#define ENV_WISDOM_LENGTH 2048
+
+#ifdef LAL_FFTW3_MEMALIGN_ENABLED
+#define ENV_WISDOM_FLAGS ( FFTW_MEASURE | FFTW_WISDOM_ONLY )
+#else
+#define ENV_WISDOM_FLAGS ( FFTW_MEASURE | FFTW_UNALIGNED | FFTW_WISDOM_ONLY )
+#endif
+
+/* Return non-zero if FFTW has wisdom for the plan measured by save_env_wisdom() */
+static int have_env_wisdom( void )
+{
+  double *in = fftw_malloc( ENV_WISDOM_LENGTH * sizeof( *in ) );
+  double *out = fftw_malloc( ENV_WISDOM_LENGTH * sizeof( *out ) );
+  fftw_plan p = fftw_plan_r2r_1d( ENV_WISDOM_LENGTH, in, out, FFTW_R2HC, ENV_WISDOM_FLAGS );
+  int have = ( p != NULL );
+  if ( p ) {
+    fftw_destroy_plan( p );
+  }
+  fftw_free( in );
+  fftw_free( out );
+  return have;
+}
+
+/* Measure a plan with LAL_FFTW_WISDOM set; the wisdom should be saved at exit */
+static int save_env_wisdom( const char *fname )
+{
+  XLAL_CHECK( setenv( "LAL_FFTW_WISDOM", fname, 1 ) == 0, XLAL_ESYS );
+  REAL8FFTPlan *plan = XLALCreateForwardREAL8FFTPlan( ENV_WISDOM_LENGTH, 1 );
+  XLAL_CHECK( plan != NULL, XLAL_EFUNC );
+  XLALDestroyREAL8FFTPlan( plan );
+  XLAL_CHECK( have_env_wisdom(), XLAL_EFAILED, "Measured plan did not leave any wisdom" );
+  return XLAL_SUCCESS;
+}
+
+/* Create an estimated plan with LAL_FFTW_WISDOM set; the saved wisdom should be imported */
+static int load_env_wisdom( const char *fname )
+{
+  XLAL_CHECK( !have_env_wisdom(), XLAL_EFAILED, "Wisdom present before it was imported" );
+  XLAL_CHECK( setenv( "LAL_FFTW_WISDOM", fname, 1 ) == 0, XLAL_ESYS );
+  REAL8FFTPlan *plan = XLALCreateForwardREAL8FFTPlan( 16, 0 );
+  XLAL_CHECK( plan != NULL, XLAL_EFUNC );
+  XLALDestroyREAL8FFTPlan( plan );
+  XLAL_CHECK( have_env_wisdom(), XLAL_EFAILED, "Wisdom was not imported from '%s'", fname );
+  return XLAL_SUCCESS;
+}
+
+/* Run a function in a child process, which exits normally so that any
+ * wisdom is saved at exit, and return its exit status */
+static int run_child( int ( *func )( const char * ), const char *fname )
+{
+  pid_t pid = fork();
+  XLAL_CHECK( pid >= 0, XLAL_ESYS, "fork() failed" );
+  if ( pid == 0 ) {
+    exit( func( fname ) == XLAL_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE );
+  }
+  int status;
+  XLAL_CHECK( waitpid( pid, &status, 0 ) == pid, XLAL_ESYS, "waitpid() failed" );
+  return ( WIFEXITED( status ) && WEXITSTATUS( status ) == EXIT_SUCCESS ) ? XLAL_SUCCESS : XLAL_FAILURE;
+}
+
+#endif /* LAL_FFTW3_ENABLED */
+
+int main( void )
+{
+
+  /* Turn off buffering to sync standard output and error printing */
+  setvbuf( stdout, NULL, _IONBF, 0 );
+  setvbuf( stderr, NULL, _IONBF, 0 );
+
+#ifndef LAL_FFTW3_ENABLED
+  /* Wisdom is only meaningful for the FFTW backend */
+  return 77;
+#else
+
+  const char *fname = "FFTWWisdomTest_double.out";
+  const char *fnamef = "FFTWWisdomTest_single.out";
+  const char *fnameenv = "FFTWWisdomTest_env.out";
+
+  /* Remove any wisdom files left over from previous runs */
+  remove( fname );
+  remove( fnamef );
+  remove( fnameenv );
+
+  /* Wisdom is saved at exit to the file named by LAL_FFTW_WISDOM, and
+   * imported from it by the next process; each runs in a child process,
+   * before this process accumulates any wisdom which the children would
+   * inherit */
+  XLAL_CHECK_MAIN( run_child( save_env_wisdom, fnameenv ) == XLAL_SUCCESS, XLAL_EFAILED, "Saving wisdom at exit failed" );
+  struct stat st;
+  XLAL_CHECK_MAIN( stat( fnameenv, &st ) == 0 && st.st_size > 0, XLAL_EFAILED, "Wisdom was not saved to '%s' at exit", fnameenv );
+  XLAL_CHECK_MAIN( run_child( load_env_wisdom, fnameenv ) == XLAL_SUCCESS, XLAL_EFAILED, "Importing wisdom from LAL_FFTW_WISDOM failed" );
+  XLAL_CHECK_MAIN( XLALFFTWImportWisdomFromFilename( fnameenv ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* Importing from a non-existent file must fail */
+  int errnum;
+  XLAL_TRY_SILENT( XLALFFTWImportWisdomFromFilename( fname ), errnum );
+  XLAL_CHECK_MAIN( errnum == XLAL_EIO, XLAL_EFAILED, "Expected XLAL_EIO, got %i", errnum );
+
+  /* Accumulate some wisdom in both precisions */
+  REAL8FFTPlan *plan = XLALCreateForwardREAL8FFTPlan( 1024, 1 );
+  XLAL_CHECK_MAIN( plan != NULL, XLAL_EFUNC );
+  COMPLEX8FFTPlan *planf = XLALCreateReverseCOMPLEX8FFTPlan( 1000, 1 );
+  XLAL_CHECK_MAIN( planf != NULL, XLAL_EFUNC );
+
+  /* Export wisdom; exporting a second time exercises merging with the existing file */
+  for ( int i = 0; i < 2; ++i ) {
+    XLAL_CHECK_MAIN( XLALFFTWExportWisdomToFilename( fname ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALFFTWFExportWisdomToFilename( fnamef ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  /* Re-import the exported wisdom */
+  XLAL_CHECK_MAIN( XLALFFTWImportWisdomFromFilename( fname ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALFFTWFImportWisdomFromFilename( fnamef ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* Plans created from wisdom must still be valid */
+  XLALDestroyREAL8FFTPlan( plan );
+  XLALDestroyCOMPLEX8FFTPlan( planf );
+  plan = XLALCreateForwardREAL8FFTPlan( 1024, 1 );
+  XLAL_CHECK_MAIN( plan != NULL, XLAL_EFUNC );
+  planf = XLALCreateReverseCOMPLEX8FFTPlan( 1000, 1 );
+  XLAL_CHECK_MAIN( planf != NULL, XLAL_EFUNC );
+  XLALDestroyREAL8FFTPlan( plan );
+  XLALDestroyCOMPLEX8FFTPlan( planf );
+
+  /* Check for memory leaks */
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+#endif
+
+}
@@ -38,6 +38,7 @@
 #define Relerr(dx,x) (fabsf(x)>0 ? fabsf((dx)/(x)) : fabsf(dx) )
 #define Relerrd(dx,x) (fabs(x)>0 ? fabs((dx)/(x)) : fabs(dx) )
 #define cRelerr(dx,x) (cabsf(x)>0 ? cabsf((dx)/(x)) : fabsf(dx) )
+#define cRelerrd(dx,x) (cabs(x)>0 ? cabs((dx)/(x)) : fabs(dx) )
 
 // ----- test and benchmark operators with 1 REAL4 vector input and 1 INT4 vector output (S2I) ----------
 #define TESTBENCH_VECTORMATH_S2I(name,in)                               \
@@ -200,8 +201,8 @@
     maxErr = maxRelerr = 0;                                             \
     for ( UINT4 i = 0; i < Ntrials; i ++ )                              \
     {                                                                   \
-      REAL8 err = fabs ( xOut[i] - xOutRef[i] );                      \
-      REAL8 relerr = Relerrd ( err, xOutRef[i] );                       \
+      REAL8 err = fabs ( xOutD[i] - xOutRefD[i] );                    \
+      REAL8 relerr = Relerrd ( err, xOutRefD[i] );                     \
       maxErr    = fmax ( err, maxErr );                                \
       maxRelerr = fmax ( relerr, maxRelerr );                          \
     }                                                                   \
@@ -211,6 +212,97 @@
     XLAL_CHECK ( (maxRelerr <= (reltol)), XLAL_ETOL, "%s: relative error (%g) exceeds tolerance (%g)\n", #name "REAL8", maxRelerr, reltol ); \
   }
 
+// ----- test and benchmark operators with 1 REAL8 vector input and 2 REAL8 vector outputs (D2DD) ----------
+#define TESTBENCH_VECTORMATH_D2DD(name,in)                              \
+  {                                                                     \
+    XLAL_CHECK ( XLALVector##name##REAL8_GEN( xOutRefD, xOutRef2D, in, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    tic = XLALGetCPUTime();                                             \
+    for (UINT4 l=0; l < Nruns; l ++ ) {                                 \
+      XLAL_CHECK ( XLALVector##name##REAL8( xOutD, xOut2D, in, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    }                                                                   \
+    toc = XLALGetCPUTime();                                             \
+    maxErr = maxRelerr = 0;                                             \
+    for ( UINT4 i = 0; i < Ntrials; i ++ ) {                            \
+      REAL8 err1 = fabs ( xOutD[i] - xOutRefD[i] );                     \
+      REAL8 err2 = fabs ( xOut2D[i] - xOutRef2D[i] );                   \
+      REAL8 relerr1 = Relerrd ( err1, xOutRefD[i] );                    \
+      REAL8 relerr2 = Relerrd ( err2, xOutRef2D[i] );                   \
+      maxErr    = fmax ( err1, maxErr );                                \
+      maxErr    = fmax ( err2, maxErr );                                \
+      maxRelerr = fmax ( relerr1, maxRelerr );                          \
+      maxRelerr = fmax ( relerr2, maxRelerr );                          \
+    }                                                                   \
+    XLALPrintInfo ( "%-32s: %4.0f Mops/sec [maxErr = %7.2g (tol=%7.2g), maxRelerr = %7.2g (tol=%7.2g)]\n", \
+                    XLALVector##name##REAL8_name, (REAL8)Ntrials * Nruns / (toc - tic)/1e6, maxErr, (abstol), maxRelerr, (reltol) ); \
+    XLAL_CHECK ( (maxErr <= (abstol)), XLAL_ETOL, "%s: absolute error (%g) exceeds tolerance (%g)\n", #name "REAL8", maxErr, abstol ); \
+    XLAL_CHECK ( (maxRelerr <= (reltol)), XLAL_ETOL, "%s: relative error (%g) exceeds tolerance (%g)\n", #name "REAL8", maxRelerr, reltol ); \
+  }
+
+// ----- test and benchmark operators with 2 REAL8 vector inputs and 1 COMPLEX16 vector output (DD2Z) ----------
+#define TESTBENCH_VECTORMATH_DD2Z(name,in1,in2)                         \
+  {                                                                     \
+    XLAL_CHECK ( XLALVector##name##COMPLEX16_GEN( xOutRefZ, in1, in2, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    tic = XLALGetCPUTime();                                             \
+    for (UINT4 l=0; l < Nruns; l ++ ) {                                 \
+      XLAL_CHECK ( XLALVector##name##COMPLEX16( xOutZ, in1, in2, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    }                                                                   \
+    toc = XLALGetCPUTime();                                             \
+    maxErr = maxRelerr = 0;                                             \
+    for ( UINT4 i = 0; i < Ntrials; i ++ )                              \
+    {                                                                   \
+      REAL8 err = cabs ( xOutZ[i] - xOutRefZ[i] );                      \
+      REAL8 relerr = cRelerrd ( err, xOutRefZ[i] );                     \
+      maxErr    = fmax ( err, maxErr );                                 \
+      maxRelerr = fmax ( relerr, maxRelerr );                           \
+    }                                                                   \
+    XLALPrintInfo ( "%-32s: %4.0f Mops/sec [maxErr = %7.2g (tol=%7.2g), maxRelerr = %7.2g (tol=%7.2g)]\n", \
+                    XLALVector##name##COMPLEX16_name, (REAL8)Ntrials * Nruns / (toc - tic)/1e6, maxErr, (abstol), maxRelerr, (reltol) ); \
+    XLAL_CHECK ( (maxErr <= (abstol)), XLAL_ETOL, "%s: absolute error (%g) exceeds tolerance (%g)\n", #name "COMPLEX16", maxErr, abstol ); \
+    XLAL_CHECK ( (maxRelerr <= (reltol)), XLAL_ETOL, "%s: relative error (%g) exceeds tolerance (%g)\n", #name "COMPLEX16", maxRelerr, reltol ); \
+  }
+
+// ----- test and benchmark operators with 2 COMPLEX16 vector inputs and 1 COMPLEX16 vector output (ZZ2Z) ----------
+#define TESTBENCH_VECTORMATH_ZZ2Z(name,in1,in2)                         \
+  TESTBENCH_VECTORMATH_DD2Z(name,in1,in2)
+
+// ----- test and benchmark operators with 2 COMPLEX16 vector inputs summed to 1 COMPLEX16 scalar output (ZZ2z) ----------
+#define TESTBENCH_VECTORMATH_ZZ2z(name,in1,in2)                         \
+  {                                                                     \
+    COMPLEX16 xOutZ0 = 0, xOutRefZ0 = 0;                                \
+    XLAL_CHECK ( XLALVector##name##COMPLEX16_GEN( &xOutRefZ0, in1, in2, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    tic = XLALGetCPUTime();                                             \
+    for (UINT4 l=0; l < Nruns; l ++ ) {                                 \
+      XLAL_CHECK ( XLALVector##name##COMPLEX16( &xOutZ0, in1, in2, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    }                                                                   \
+    toc = XLALGetCPUTime();                                             \
+    maxErr = cabs ( xOutZ0 - xOutRefZ0 );                               \
+    maxRelerr = cRelerrd ( maxErr, xOutRefZ0 );                         \
+    XLALPrintInfo ( "%-32s: %4.0f Mops/sec [maxErr = %7.2g (tol=%7.2g), maxRelerr = %7.2g (tol=%7.2g)]\n", \
+                    XLALVector##name##COMPLEX16_name, (REAL8)Ntrials * Nruns / (toc - tic)/1e6, maxErr, (abstol), maxRelerr, (reltol) ); \
+    XLAL_CHECK ( (maxErr <= (abstol)), XLAL_ETOL, "%s: absolute error (%g) exceeds tolerance (%g)\n", #name "COMPLEX16", maxErr, abstol ); \
+    XLAL_CHECK ( (maxRelerr <= (reltol)), XLAL_ETOL, "%s: relative error (%g) exceeds tolerance (%g)\n", #name "COMPLEX16", maxRelerr, reltol ); \
+  }
+
+// ----- test and benchmark weighted inner products of a COMPLEX16 vector with a time-shifted COMPLEX16 vector ----------
+#define TESTBENCH_VECTORMATH_TIMESHIFTEDINNERPRODUCTS(d,h,w,phi0,dphi)  \
+  {                                                                     \
+    COMPLEX16 dh = 0, dhRef = 0;                                        \
+    REAL8 hh = 0, hhRef = 0, dd = 0, ddRef = 0, rr = 0, rrRef = 0;      \
+    XLAL_CHECK ( XLALVectorTimeShiftedInnerProductsCOMPLEX16_GEN( &dhRef, &hhRef, &ddRef, &rrRef, d, h, w, phi0, dphi, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    tic = XLALGetCPUTime();                                             \
+    for (UINT4 l=0; l < Nruns; l ++ ) {                                 \
+      XLAL_CHECK ( XLALVectorTimeShiftedInnerProductsCOMPLEX16( &dh, &hh, &dd, &rr, d, h, w, phi0, dphi, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    }                                                                   \
+    toc = XLALGetCPUTime();                                             \
+    maxRelerr = cRelerrd ( cabs ( dh - dhRef ), dhRef );                \
+    maxRelerr = fmax ( Relerrd ( fabs ( hh - hhRef ), hhRef ), maxRelerr ); \
+    maxRelerr = fmax ( Relerrd ( fabs ( dd - ddRef ), ddRef ), maxRelerr ); \
+    maxRelerr = fmax ( Relerrd ( fabs ( rr - rrRef ), rrRef ), maxRelerr ); \
+    XLALPrintInfo ( "%-32s: %4.0f Mops/sec [maxRelerr = %7.2g (tol=%7.2g)]\n", \
+                    XLALVectorTimeShiftedInnerProductsCOMPLEX16_name, (REAL8)Ntrials * Nruns / (toc - tic)/1e6, maxRelerr, (reltol) ); \
+    XLAL_CHECK ( (maxRelerr <= (reltol)), XLAL_ETOL, "%s: relative error (%g) exceeds tolerance (%g)\n", "TimeShiftedInnerProductsCOMPLEX16", maxRelerr, reltol ); \
+  }
+
 // local types
 typedef struct
 {
@@ -276,17 +368,21 @@ main ( int argc, char *argv[] )
   REAL4 *xOutRef  = xOutRef_a->data;
   REAL4 *xOutRef2 = xOutRef2_a->data;
 
-  REAL8VectorAligned *xInD_a, *xIn2D_a, *xOutD_a, *xOutRefD_a;
+  REAL8VectorAligned *xInD_a, *xIn2D_a, *xOutD_a, *xOut2D_a, *xOutRefD_a, *xOutRef2D_a;
   XLAL_CHECK ( ( xInD_a   = XLALCreateREAL8VectorAligned ( Ntrials, uvar->inAlign )) != NULL, XLAL_EFUNC );
   XLAL_CHECK ( ( xIn2D_a  = XLALCreateREAL8VectorAligned ( Ntrials, uvar->inAlign )) != NULL, XLAL_EFUNC );
   XLAL_CHECK ( ( xOutD_a  = XLALCreateREAL8VectorAligned ( Ntrials, uvar->outAlign )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( ( xOut2D_a = XLALCreateREAL8VectorAligned ( Ntrials, uvar->outAlign )) != NULL, XLAL_EFUNC );
   XLAL_CHECK ( (xOutRefD_a= XLALCreateREAL8VectorAligned ( Ntrials, uvar->outAlign )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( (xOutRef2D_a= XLALCreateREAL8VectorAligned ( Ntrials, uvar->outAlign )) != NULL, XLAL_EFUNC );
 
   // extract aligned REAL8 vectors from these
   REAL8 *xInD      = xInD_a->data;
   REAL8 *xIn2D     = xIn2D_a->data;
   REAL8 *xOutD     = xOutD_a->data;
+  REAL8 *xOut2D    = xOut2D_a->data;
   REAL8 *xOutRefD  = xOutRefD_a->data;
+  REAL8 *xOutRef2D = xOutRef2D_a->data;
 
   COMPLEX8VectorAligned *xInC_a, *xIn2C_a, *xOutC_a, *xOutRefC_a;
   XLAL_CHECK ( ( xInC_a   = XLALCreateCOMPLEX8VectorAligned ( Ntrials, uvar->inAlign )) != NULL, XLAL_EFUNC );
@@ -300,6 +396,18 @@ main ( int argc, char *argv[] )
   COMPLEX8 *xOutC     = xOutC_a->data;
   COMPLEX8 *xOutRefC  = xOutRefC_a->data;
 
+  COMPLEX16VectorAligned *xInZ_a, *xIn2Z_a, *xOutZ_a, *xOutRefZ_a;
+  XLAL_CHECK ( ( xInZ_a   = XLALCreateCOMPLEX16VectorAligned ( Ntrials, uvar->inAlign )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( ( xIn2Z_a  = XLALCreateCOMPLEX16VectorAligned ( Ntrials, uvar->inAlign )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( ( xOutZ_a  = XLALCreateCOMPLEX16VectorAligned ( Ntrials, uvar->outAlign )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( (xOutRefZ_a  = XLALCreateCOMPLEX16VectorAligned ( Ntrials, uvar->outAlign )) != NULL, XLAL_EFUNC );
+
+  // extract aligned COMPLEX16 vectors from these
+  COMPLEX16 *xInZ      = xInZ_a->data;
+  COMPLEX16 *xIn2Z     = xIn2Z_a->data;
+  COMPLEX16 *xOutZ     = xOutZ_a->data;
+  COMPLEX16 *xOutRefZ  = xOutRefZ_a->data;
+
   REAL8 tic, toc;
   REAL4 maxErr = 0, maxRelerr = 0;
   REAL4 abstol, reltol;
@@ -383,6 +491,49 @@ main ( int argc, char *argv[] )
   TESTBENCH_VECTORMATH_CC2C(Scale,xInC[0],xIn2C);
   TESTBENCH_VECTORMATH_CC2C(Shift,xInC[0],xIn2C);
 
+  // ==================== REAL8 SINCOS(), EXP(), COMPLEX16 CEXP() ====================
+  XLALPrintInfo ("\nTesting REAL8 sin(x), cos(x), and COMPLEX16 a*exp(i*x) for x in [-100000, 100000], a in [0, 100]\n");
+  for ( UINT4 i = 0; i < Ntrials; i ++ ) {
+    xInD[i]  = 200000.0 * ( frand() - 0.5 );
+    xIn2D[i] = 100.0 * frand();
+  } // for i < Ntrials
+  abstol = 5e-14, reltol = 1e-13;
+
+  TESTBENCH_VECTORMATH_D2DD(SinCos,xInD);
+  TESTBENCH_VECTORMATH_DD2Z(CExp,xIn2D,xInD);
+
+  XLALPrintInfo ("\nTesting REAL8 exp(x) for x in [-10, 10]\n");
+  for ( UINT4 i = 0; i < Ntrials; i ++ ) {
+    xInD[i] = 20.0 * ( frand() - 0.5 );
+  } // for i < Ntrials
+  abstol = 1e-11, reltol = 5e-16;
+
+  TESTBENCH_VECTORMATH_D2D(Exp,xInD);
+
+  // ==================== COMPLEX16 MULTIPLY, DOTPRODUCT ====================
+  XLALPrintInfo ("\nTesting COMPLEX16 multiply, dot-product(x,y) for x,y in (-10000, 10000]\n");
+  for ( UINT4 i = 0; i < Ntrials; i ++ ) {
+    xInZ[i] = -10000.0 + 20000.0 * frand() + 1e-6 + ( -10000.0 + 20000.0 * frand() + 1e-6 ) * _Complex_I;
+    xIn2Z[i]= -10000.0 + 20000.0 * frand() + 1e-6 + ( -10000.0 + 20000.0 * frand() + 1e-6 ) * _Complex_I;
+  } // for i < Ntrials
+  abstol = 1e-7, reltol = 1e-15;
+
+  TESTBENCH_VECTORMATH_ZZ2Z(Multiply,xInZ,xIn2Z);
+  TESTBENCH_VECTORMATH_ZZ2Z(MultiplyConj,xInZ,xIn2Z);
+
+  // summation order differs between implementations
+  abstol = 1e-1, reltol = 1e-12;
+  TESTBENCH_VECTORMATH_ZZ2z(DotProduct,xInZ,xIn2Z);
+
+  // ==================== COMPLEX16 TIME-SHIFTED INNER PRODUCTS ====================
+  XLALPrintInfo ("\nTesting COMPLEX16 time-shifted inner products of x,y in (-10000, 10000] with weights in [0, 1]\n");
+  for ( UINT4 i = 0; i < Ntrials; i ++ ) {
+    xInD[i] = frand();
+  } // for i < Ntrials
+  // phase factors are computed by a recurrence with a different step for each instruction set
+  reltol = 1e-11;
+  TESTBENCH_VECTORMATH_TIMESHIFTEDINNERPRODUCTS(xInZ,xIn2Z,xInD,0.3,-1e-3);
+
   // ==================== FIND ====================
   for ( UINT4 i = 0; i < Ntrials; i ++ ) {
     xIn[i]  = -10000.0f + 20000.0f * frand() + 1e-6;
@@ -414,13 +565,20 @@ main ( int argc, char *argv[] )
   XLALDestroyREAL8VectorAligned ( xInD_a );
   XLALDestroyREAL8VectorAligned ( xIn2D_a );
   XLALDestroyREAL8VectorAligned ( xOutD_a );
+  XLALDestroyREAL8VectorAligned ( xOut2D_a );
   XLALDestroyREAL8VectorAligned ( xOutRefD_a );
+  XLALDestroyREAL8VectorAligned ( xOutRef2D_a );
 
   XLALDestroyCOMPLEX8VectorAligned ( xInC_a );
   XLALDestroyCOMPLEX8VectorAligned ( xIn2C_a );
   XLALDestroyCOMPLEX8VectorAligned ( xOutC_a );
   XLALDestroyCOMPLEX8VectorAligned ( xOutRefC_a );
 
+  XLALDestroyCOMPLEX16VectorAligned ( xInZ_a );
+  XLALDestroyCOMPLEX16VectorAligned ( xIn2Z_a );
+  XLALDestroyCOMPLEX16VectorAligned ( xOutZ_a );
+  XLALDestroyCOMPLEX16VectorAligned ( xOutRefZ_a );
+
   XLALDestroyUserVars();
 
   LALCheckMemoryLeaks();
@@ -43,6 +43,7 @@
 #include <lal/BandPassTimeSeries.h>
 #include <lal/Date.h>
 #include <lal/EPSearch.h>
+#include <lal/FFTPlanCache.h>
 #include <lal/LALFrStream.h>
 #include <lal/FrequencySeries.h>
 #include <lal/GenerateBurst.h>
@@ -1583,6 +1584,7 @@ int main(int argc, char *argv[])
 	if(options->diagnostics)
 		XLALCloseLIGOLwXMLFile(options->diagnostics);
 	options_free(options);
+	XLALClearFFTPlanCache();
 
 	LALCheckMemoryLeaks();
 	exit(0);
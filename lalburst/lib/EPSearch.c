@@ -31,6 +31,10 @@
 #include <math.h>
 
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_vector.h>
@@ -38,6 +42,7 @@
 
 #include <lal/Date.h>
 #include <lal/EPSearch.h>
+#include <lal/FFTPlanCache.h>
 #include <lal/FrequencySeries.h>
 #include <lal/LALChisq.h>
 #include <lal/LALDatatypes.h>
@@ -46,6 +51,7 @@
 #include <lal/LIGOLwXMLArray.h>
 #include <lal/LIGOMetadataTables.h>
 #include <lal/RealFFT.h>
+#include <lal/SeqFactories.h>
 #include <lal/SnglBurstUtils.h>
 #include <lal/TimeFreqFFT.h>
 #include <lal/TimeSeries.h>
@@ -377,9 +383,9 @@ typedef struct tagREAL8TimeFrequencyPlane {
 	double fseries_deltaF;		/**< input frequency series' resolution */
 	double deltaF;			/**< TF plane's frequency resolution (channel spacing) */
 	double flow;			/**< low frequency boundary of TF plane */
-	gsl_matrix *channel_data;   	/**< channel data.  each channel is placed into its own column.  channel_data[i * channels + j] corresponds to time epoch + i * deltaT and the frequency band [flow + j * deltaF, flow + (j + 1) * deltaF) */
-	REAL8Sequence *channel_buffer;	/**< re-usable holding area for the data for a single channel */
-	REAL8Sequence *unwhitened_channel_buffer;	/**< UNDOCUMENTED */
+	gsl_matrix *channel_data;   	/**< channel data.  each channel is placed into its own row.  channel_data[j * tseries_length + i] corresponds to time epoch + i * deltaT and the frequency band [flow + j * deltaF, flow + (j + 1) * deltaF) */
+	COMPLEX16VectorSequence *fcorr_buffer;	/**< re-usable holding areas, one block of rows per thread, for the filtered frequency series of a block of channels.  zero outside of the filters' pass bands */
+	REAL8FFTPlan *channel_plan;	/**< batched reverse plan transforming a block of channels at once, or NULL if batched transforms are not available */
 	REAL8TimeFrequencyPlaneTiles tiles;	/**< time-frequency plane's tiling information */
 	REAL8Window *window;		/**< time-domain window applied to input time series for tapering edges to 0 */
 	int window_shift;		/**< by how many samples a window's start should be shifted from the start of the window preceding it */
@@ -387,6 +393,50 @@ typedef struct tagREAL8TimeFrequencyPlane {
 } REAL8TimeFrequencyPlane;
 
 
+/*
+ * Number of channels whose time series are computed together by a single
+ * batched inverse FFT.  If it does not divide the number of channels, the
+ * last block is shorter and its channels are transformed one at a time.
+ */
+
+
+static unsigned channel_block_length(unsigned channels)
+{
+	return channels < 32 ? channels : 32;
+}
+
+
+/*
+ * Number of blocks of channels, including a shorter last block.
+ */
+
+
+static unsigned channel_blocks(unsigned channels)
+{
+	const unsigned block = channel_block_length(channels);
+	return (channels + block - 1) / block;
+}
+
+
+/*
+ * Number of threads among which the channel blocks are shared.  Each
+ * thread gets its own block of frequency-domain buffers.
+ */
+
+
+static unsigned channel_threads(unsigned channels)
+{
+#ifdef _OPENMP
+	unsigned blocks = channel_blocks(channels);
+	unsigned threads = omp_get_max_threads();
+	return threads < blocks ? threads : blocks;
+#else
+	(void) channels;
+	return 1;
+#endif
+}
+
+
 /**
  * Create and initialize a time-frequency plane object.
  */
@@ -405,8 +455,10 @@ static REAL8TimeFrequencyPlane *XLALCreateTFPlane(
 {
 	REAL8TimeFrequencyPlane *plane;
 	gsl_matrix *channel_data;
-	REAL8Sequence *channel_buffer;
-	REAL8Sequence *unwhitened_channel_buffer;
+	COMPLEX16VectorSequence *fcorr_buffer;
+	REAL8FFTPlan *channel_plan;
+	unsigned block;
+	int errnum;
 	REAL8Window *tukey;
 	REAL8Sequence *correlation;
 
@@ -504,22 +556,32 @@ static REAL8TimeFrequencyPlane *XLALCreateTFPlane(
 	 * Allocate memory.
 	 */
 
+	block = channel_block_length(channels);
 	plane = XLALMalloc(sizeof(*plane));
-	channel_data = gsl_matrix_alloc(tseries_length, channels);
-	channel_buffer = XLALCreateREAL8Sequence(tseries_length);
-	unwhitened_channel_buffer = XLALCreateREAL8Sequence(tseries_length);
+	channel_data = gsl_matrix_alloc(channels, tseries_length);
+	fcorr_buffer = XLALCreateCOMPLEX16VectorSequence(channel_threads(channels) * block, tseries_length / 2 + 1);
+	/* the filters only touch their own pass bands, so the buffers
+	 * must start out zeroed */
+	if(fcorr_buffer)
+		memset(fcorr_buffer->data, 0, fcorr_buffer->length * fcorr_buffer->vectorLength * sizeof(*fcorr_buffer->data));
+	/* batched transforms are not supported by all FFT backends;  if
+	 * the batched plan cannot be created, fall back to transforming
+	 * one channel at a time */
+	XLAL_TRY_SILENT(channel_plan = XLALCreateREAL8FFTPlanMany(tseries_length, block, 1, 0, 1), errnum);
+	if(errnum)
+		XLALPrintInfo("%s(): batched FFTs not available, transforming channels one at a time\n", __func__);
 	tukey = XLALCreateTukeyREAL8Window(tseries_length, (tseries_length - tiling_length) / (double) tseries_length);
 	if(tukey)
 		correlation = XLALREAL8WindowTwoPointSpectralCorrelation(tukey, plan);
 	else
 		/* error path */
 		correlation = NULL;
-	if(!plane || !channel_data || !channel_buffer || !unwhitened_channel_buffer || !tukey || !correlation) {
+	if(!plane || !channel_data || !fcorr_buffer || !tukey || !correlation) {
 		XLALFree(plane);
 		if(channel_data)
 			gsl_matrix_free(channel_data);
-		XLALDestroyREAL8Sequence(channel_buffer);
-		XLALDestroyREAL8Sequence(unwhitened_channel_buffer);
+		XLALDestroyCOMPLEX16VectorSequence(fcorr_buffer);
+		XLALDestroyREAL8FFTPlan(channel_plan);
 		XLALDestroyREAL8Window(tukey);
 		XLALDestroyREAL8Sequence(correlation);
 		XLAL_ERROR_NULL(XLAL_EFUNC);
@@ -536,8 +598,8 @@ static REAL8TimeFrequencyPlane *XLALCreateTFPlane(
 	plane->deltaF = deltaF;
 	plane->flow = flow;
 	plane->channel_data = channel_data;
-	plane->channel_buffer = channel_buffer;
-	plane->unwhitened_channel_buffer = unwhitened_channel_buffer;
+	plane->fcorr_buffer = fcorr_buffer;
+	plane->channel_plan = channel_plan;
 	plane->tiles.max_length = max_length;
 	plane->tiles.min_channels = min_channels;
 	plane->tiles.max_channels = max_channels;
@@ -569,8 +631,8 @@ static void XLALDestroyTFPlane(
 	if(plane) {
 		if(plane->channel_data)
 			gsl_matrix_free(plane->channel_data);
-		XLALDestroyREAL8Sequence(plane->channel_buffer);
-		XLALDestroyREAL8Sequence(plane->unwhitened_channel_buffer);
+		XLALDestroyCOMPLEX16VectorSequence(plane->fcorr_buffer);
+		XLALDestroyREAL8FFTPlan(plane->channel_plan);
 		XLALDestroyREAL8Window(plane->window);
 		XLALDestroyREAL8Sequence(plane->two_point_spectral_correlation);
 	}
@@ -588,14 +650,14 @@ static void XLALDestroyTFPlane(
 
 
 /*
- * Multiply the data by the filter.  The check that the frequency
- * resolutions and units are compatible is omitted because it is implied by
- * the calling code.
+ * Find the range of frequency bins [*first, *last) of the input series
+ * spanned by a filter.  The range is empty if they don't intersect.
  */
 
 
-static COMPLEX16Sequence *apply_filter(
-	COMPLEX16Sequence *outputseq,
+static void filter_band(
+	unsigned *first,
+	unsigned *last,
 	const COMPLEX16FrequencySeries *inputseries,
 	const COMPLEX16FrequencySeries *filterseries
 )
@@ -603,26 +665,58 @@ static COMPLEX16Sequence *apply_filter(
 	/* find bounds of common frequencies */
 	const double flo = max(filterseries->f0, inputseries->f0);
 	const double fhi = min(filterseries->f0 + filterseries->data->length * filterseries->deltaF, inputseries->f0 + inputseries->data->length * inputseries->deltaF);
-	double complex *output = outputseq->data + (int) round((flo - inputseries->f0) / inputseries->deltaF);
-	double complex *last = outputseq->data + (int) round((fhi - inputseries->f0) / inputseries->deltaF);
-	const double complex *input = inputseries->data->data + (int) round((flo - inputseries->f0) / inputseries->deltaF);
-	const double complex *filter = filterseries->data->data + (int) round((flo - filterseries->f0) / filterseries->deltaF);
-
-	if(outputseq->length != inputseries->data->length)
-		XLAL_ERROR_NULL(XLAL_EBADLEN);
+	const int lo = round((flo - inputseries->f0) / inputseries->deltaF);
+	const int hi = round((fhi - inputseries->f0) / inputseries->deltaF);
 
-	if(((unsigned) (output - outputseq->data) > outputseq->length) || (last - outputseq->data < 0))
+	if(lo < 0 || (unsigned) lo > inputseries->data->length || hi <= lo)
 		/* inputseries and filterseries don't intersect */
-		memset(outputseq->data, 0, outputseq->length * sizeof(*outputseq->data));
+		*first = *last = 0;
 	else {
+		*first = lo;
+		*last = hi;
+	}
+}
+
+
+/*
+ * Multiply the data by the filter.  The filters are narrow, so only the
+ * band of outputseq spanned by the filter is written;  the rest of
+ * outputseq must already be zero, and clear_filter() returns the band to
+ * zero afterwards.  The check that the frequency resolutions and units
+ * are compatible is omitted because it is implied by the calling code.
+ */
+
+
+static void apply_filter(
+	COMPLEX16Sequence *outputseq,
+	const COMPLEX16FrequencySeries *inputseries,
+	const COMPLEX16FrequencySeries *filterseries
+)
+{
+	unsigned first, last, k;
+	filter_band(&first, &last, inputseries, filterseries);
+	if(first < last) {
+		double complex *output = outputseq->data + first;
+		const double complex *input = inputseries->data->data + first;
+		const double complex *filter = filterseries->data->data + (int) round((inputseries->f0 + first * inputseries->deltaF - filterseries->f0) / filterseries->deltaF);
+
 		/* output = inputseries * conj(filter) */
-		memset(outputseq->data, 0, (output - outputseq->data) * sizeof(*outputseq->data));
-		for(; output < last; output++, input++, filter++)
-			*output = *input * conj(*filter);
-		memset(last, 0, (outputseq->length - (last - outputseq->data)) * sizeof(*outputseq->data));
+		for(k = first; k < last; k++)
+			*output++ = *input++ * conj(*filter++);
 	}
+}
+
 
-	return outputseq;
+static void clear_filter(
+	COMPLEX16Sequence *outputseq,
+	const COMPLEX16FrequencySeries *inputseries,
+	const COMPLEX16FrequencySeries *filterseries
+)
+{
+	unsigned first, last;
+	filter_band(&first, &last, inputseries, filterseries);
+	if(first < last)
+		memset(outputseq->data + first, 0, (last - first) * sizeof(*outputseq->data));
 }
 
 
@@ -638,8 +732,12 @@ static int XLALFreqSeriesToTFPlane(
 	const REAL8FFTPlan *reverseplan
 )
 {
-	COMPLEX16Sequence *fcorr;
-	unsigned i;
+	COMPLEX16VectorSequence *fcorr = plane->fcorr_buffer;
+	const unsigned channels = plane->channel_data->size1;
+	const unsigned block = channel_block_length(channels);
+	const unsigned blocks = channel_blocks(channels);
+	int failed = 0;
+	int i;
 
 	/* check input parameters */
 	if((fmod(plane->deltaF, fseries->deltaF) != 0.0) ||
@@ -648,20 +746,20 @@ static int XLALFreqSeriesToTFPlane(
 
 	/* make sure the frequency series spans an appropriate band */
 	if((plane->flow < fseries->f0) ||
-	   (plane->flow + plane->channel_data->size2 * plane->deltaF > fseries->f0 + fseries->data->length * fseries->deltaF))
+	   (plane->flow + channels * plane->deltaF > fseries->f0 + fseries->data->length * fseries->deltaF))
 		XLAL_ERROR(XLAL_EDATA);
 
-	/* create temporary vectors */
-	fcorr = XLALCreateCOMPLEX16Sequence(fseries->data->length);
-	if(!fcorr)
-		XLAL_ERROR(XLAL_EFUNC);
+	/* make sure the frequency series and the plane's buffers agree */
+	if((fcorr->vectorLength != fseries->data->length) ||
+	   (fcorr->vectorLength != plane->channel_data->size2 / 2 + 1))
+		XLAL_ERROR(XLAL_EBADLEN);
 
 #if 0
 	/* diagnostic code to dump data for the \hat{s}_{k} histogram */
 	{
 	unsigned k;
 	FILE *f = fopen("sk.dat", "a");
-	for(k = plane->flow / fseries->deltaF; k < (plane->flow + plane->channel_data->size2 * plane->deltaF) / fseries->deltaF; k++)
+	for(k = plane->flow / fseries->deltaF; k < (plane->flow + plane->channel_data->size1 * plane->deltaF) / fseries->deltaF; k++)
 		fprintf(f, "%g\n%g\n", fseries->data->data[k].re, fseries->data->data[k].im);
 	fclose(f);
 	}
@@ -675,7 +773,7 @@ static int XLALFreqSeriesToTFPlane(
 	for(dk = 0; dk < 100; dk++) {
 		double avg_r = 0;
 		double avg_i = 0;
-	for(k = plane->flow / fseries->deltaF; k + dk < (plane->flow + plane->channel_data->size2 * plane->deltaF) / fseries->deltaF; k++) {
+	for(k = plane->flow / fseries->deltaF; k + dk < (plane->flow + plane->channel_data->size1 * plane->deltaF) / fseries->deltaF; k++) {
 		double dr = fseries->data->data[k].re;
 		double di = fseries->data->data[k].im;
 		double dkr = fseries->data->data[k + dk].re;
@@ -691,27 +789,49 @@ static int XLALFreqSeriesToTFPlane(
 	}
 #endif
 
-	/* loop over the time-frequency plane's channels */
-	for(i = 0; i < plane->channel_data->size2; i++) {
-		unsigned j;
+	/* loop over the time-frequency plane's channels a block at a time.
+	 * the blocks are shared among the threads, each of which has its
+	 * own block of frequency-domain buffers.  the time series of each
+	 * block of channels are written directly into contiguous rows of
+	 * channel_data.  the last block may be shorter than the others, in
+	 * which case the batched plan does not fit it and its channels are
+	 * transformed one at a time */
+#pragma omp parallel for schedule(dynamic) num_threads(fcorr->length / block) reduction(|:failed)
+	for(i = 0; i < (int) blocks; i++) {
+		const unsigned length = channels - i * block < block ? channels - i * block : block;
+#ifdef _OPENMP
+		COMPLEX16VectorSequence fcorr_block = {.length = length, .vectorLength = fcorr->vectorLength, .data = fcorr->data + omp_get_thread_num() * block * fcorr->vectorLength};
+#else
+		COMPLEX16VectorSequence fcorr_block = {.length = length, .vectorLength = fcorr->vectorLength, .data = fcorr->data};
+#endif
+		REAL8VectorSequence channel_block = {.length = length, .vectorLength = plane->channel_data->size2, .data = plane->channel_data->data + i * block * plane->channel_data->tda};
+		unsigned k;
 		/* cross correlate the input data against the channel
-		 * filter by taking their product in the frequency domain
+		 * filters by taking their product in the frequency domain
 		 * and then inverse transforming to the time domain to
-		 * obtain an SNR time series.  Note that
+		 * obtain SNR time series.  Note that
 		 * XLALREAL8ReverseFFT() omits the factor of 1 / (N Delta
 		 * t) in the inverse transform. */
-		apply_filter(fcorr, fseries, filter_bank->basis_filters[i].fseries);
-		if(XLALREAL8ReverseFFT(plane->channel_buffer, fcorr, reverseplan)) {
-			XLALDestroyCOMPLEX16Sequence(fcorr);
-			XLAL_ERROR(XLAL_EFUNC);
+		for(k = 0; k < length; k++) {
+			COMPLEX16Sequence fcorr_k = {.length = fcorr_block.vectorLength, .data = fcorr_block.data + k * fcorr_block.vectorLength};
+			apply_filter(&fcorr_k, fseries, filter_bank->basis_filters[i * block + k].fseries);
+		}
+		if(plane->channel_plan && length == block)
+			failed |= XLALREAL8ReverseFFTMany(&channel_block, &fcorr_block, plane->channel_plan) != 0;
+		else
+			for(k = 0; k < length; k++) {
+				COMPLEX16Vector fcorr_k = {.length = fcorr_block.vectorLength, .data = fcorr_block.data + k * fcorr_block.vectorLength};
+				REAL8Vector channel_k = {.length = channel_block.vectorLength, .data = channel_block.data + k * plane->channel_data->tda};
+				failed |= XLALREAL8ReverseFFT(&channel_k, &fcorr_k, reverseplan) != 0;
+			}
+		/* return the buffers to zero for the next block */
+		for(k = 0; k < length; k++) {
+			COMPLEX16Sequence fcorr_k = {.length = fcorr_block.vectorLength, .data = fcorr_block.data + k * fcorr_block.vectorLength};
+			clear_filter(&fcorr_k, fseries, filter_bank->basis_filters[i * block + k].fseries);
 		}
-		/* interleave the result into the channel_data array */
-		for(j = 0; j < plane->channel_buffer->length; j++)
-			gsl_matrix_set(plane->channel_data, j, i, plane->channel_buffer->data[j]);
 	}
-
-	/* clean up */
-	XLALDestroyCOMPLEX16Sequence(fcorr);
+	if(failed)
+		XLAL_ERROR(XLAL_EFUNC);
 
 	/* set the name and epoch of the TF plane */
 	strncpy(plane->name, fseries->name, LALNameLength);
@@ -802,7 +922,7 @@ static SnglBurst *XLALComputeExcessPower(
 {
 	gsl_vector filter_output = {
 		.size = plane->tiles.tiling_end - plane->tiles.tiling_start,
-		.stride = plane->channel_data->size2,
+		.stride = 1,
 		.data = NULL,
 		.block = NULL,
 		.owner = 0
@@ -844,7 +964,7 @@ static SnglBurst *XLALComputeExcessPower(
 		 * (wide) channel */
 		const unsigned stride = round(1.0 / (channels * plane->tiles.dof_per_pixel));
 
-	for(channel_end = (channel = 0) + channels; channel_end <= plane->channel_data->size2; channel_end = (channel += channels / plane->tiles.inv_fractional_stride) + channels) {
+	for(channel_end = (channel = 0) + channels; channel_end <= plane->channel_data->size1; channel_end = (channel += channels / plane->tiles.inv_fractional_stride) + channels) {
 		/* the root mean square of the "virtual channel",
 		 * \sqrt{\mu^{2}} in the algorithm description */
 		const double sample_rms = sqrt(channels * plane->deltaF / plane->fseries_deltaF + XLALREAL8SequenceSum(filter_bank->twice_channel_overlap, channel, channels - 1));
@@ -869,12 +989,12 @@ static SnglBurst *XLALComputeExcessPower(
 		 * for this (possibly multi-filter) channel.  both time
 		 * series are normalized so that each sample has a mean
 		 * square of 1 */
-		filter_output.data = plane->channel_data->data + filter_output.stride * plane->tiles.tiling_start + channel;
+		filter_output.data = plane->channel_data->data + channel * plane->channel_data->tda + plane->tiles.tiling_start;
 		filter_output_view = gsl_vector_subvector_with_stride(&filter_output, 0, stride, filter_output.size / stride);
 		gsl_vector_set_zero(channel_buffer);
 		gsl_vector_set_zero(unwhitened_channel_buffer);
 		channel_buffer->size = unwhitened_channel_buffer->size = filter_output_view.vector.size;
-		for(i = channel; i < channel_end; filter_output_view.vector.data++, i++) {
+		for(i = channel; i < channel_end; filter_output_view.vector.data += plane->channel_data->tda, i++) {
 			gsl_blas_daxpy(1.0 / sample_rms, &filter_output_view.vector, channel_buffer);
 			gsl_blas_daxpy(filter_bank->basis_filters[i].unwhitened_rms * sqrt(plane->fseries_deltaF / plane->deltaF) / uwsample_rms, &filter_output_view.vector, unwhitened_channel_buffer);
 		}
@@ -997,8 +1117,8 @@ SnglBurst *XLALEPSearch(
 	 * later, so it doesn't all have to be correct here.
 	 */
 
-	fplan = XLALCreateForwardREAL8FFTPlan(window->data->length, 1);
-	rplan = XLALCreateReverseREAL8FFTPlan(window->data->length, 1);
+	fplan = XLALGetCachedREAL8FFTPlan(window->data->length, 1, 1);
+	rplan = XLALGetCachedREAL8FFTPlan(window->data->length, 0, 1);
 	psd = XLALCreateREAL8FrequencySeries("PSD", &tseries->epoch, 0, 0, &lalDimensionlessUnit, window->data->length / 2 + 1);
 	fseries = XLALCreateCOMPLEX16FrequencySeries(tseries->name, &tseries->epoch, 0, 0, &lalDimensionlessUnit, window->data->length / 2 + 1);
 	if(fplan)
@@ -1052,7 +1172,7 @@ SnglBurst *XLALEPSearch(
 	 */
 
 	XLALPrintInfo("%s(): constructing channel filters\n", __func__);
-	filter_bank = XLALCreateExcessPowerFilterBank(psd->deltaF, plane->flow, plane->deltaF, plane->channel_data->size2, psd, plane->two_point_spectral_correlation);
+	filter_bank = XLALCreateExcessPowerFilterBank(psd->deltaF, plane->flow, plane->deltaF, plane->channel_data->size1, psd, plane->two_point_spectral_correlation);
 	if(!filter_bank) {
 		errorcode = XLAL_EFUNC;
 		goto error;
@@ -1150,8 +1270,8 @@ SnglBurst *XLALEPSearch(
 	XLALPrintInfo("%s(): done\n", __func__);
 
 	error:
-	XLALDestroyREAL8FFTPlan(fplan);
-	XLALDestroyREAL8FFTPlan(rplan);
+	XLALReleaseCachedREAL8FFTPlan(fplan);
+	XLALReleaseCachedREAL8FFTPlan(rplan);
 	XLALDestroyREAL8FrequencySeries(psd);
 	XLALDestroyREAL8TimeSeries(cuttseries);
 	XLALDestroyCOMPLEX16FrequencySeries(fseries);
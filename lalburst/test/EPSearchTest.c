@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+/*
+ * Test XLALEPSearch() with a number of channels that is not a multiple of
+ * the length of the blocks of channels transformed together.  With tiles
+ * one channel wide, each channel is analyzed independently of the others,
+ * so the events found in a prime number of channels must be those found
+ * by separate searches of the first channels and of the remaining ones.
+ */
+
+
+#include <math.h>
+#include <stdlib.h>
+#include <lal/Date.h>
+#include <lal/EPSearch.h>
+#include <lal/LALStdlib.h>
+#include <lal/Random.h>
+#include <lal/SnglBurstUtils.h>
+#include <lal/TimeSeries.h>
+#include <lal/Units.h>
+#include <lal/Window.h>
+#include <lal/XLALError.h>
+
+
+/* sample rate, and length of the windows analyzed by the search */
+#define SAMPLE_RATE 1024
+#define WINDOW_LENGTH 16384
+/* a prime number of 1 Hz channels, more than one block of them */
+#define CHANNELS 37
+#define CHANNELS_LOW 32
+#define FLOW 64.0
+
+/* the batched and single-channel transforms are allowed to round
+ * differently */
+#define EVENT_RELTOL 1e-10
+
+
+static int compare_events(const SnglBurst * const *a, const SnglBurst * const *b)
+{
+	int result = XLALGPSCmp(&(*a)->peak_time, &(*b)->peak_time);
+	if(result)
+		return result;
+	if((*a)->central_freq < (*b)->central_freq)
+		return -1;
+	return (*a)->central_freq > (*b)->central_freq;
+}
+
+
+static int agree(double a, double b)
+{
+	return fabs(a - b) <= EVENT_RELTOL * fabs(a);
+}
+
+
+static SnglBurst *search(const REAL8TimeSeries *tseries, REAL8Window *window, double flow, unsigned channels)
+{
+	/* 1 s tiles one channel wide */
+	SnglBurst *events = XLALEPSearch(NULL, tseries, window, flow, channels, 0, 1, 1, 1);
+	if(!events)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	XLALSortSnglBurst(&events, compare_events);
+	return events;
+}
+
+
+int main(void)
+{
+	int window_shift, window_pad, tiling_length;
+	REAL8TimeSeries *tseries;
+	REAL8Window *window;
+	RandomParams *randpar;
+	SnglBurst *all, *low, *high, *event, *last;
+	unsigned i;
+
+	XLAL_CHECK_MAIN(XLALEPGetTimingParameters(WINDOW_LENGTH, SAMPLE_RATE, 1, NULL, NULL, &window_shift, &window_pad, &tiling_length) == 0, XLAL_EFUNC);
+
+	/* white Gaussian noise, three windows long */
+	tseries = XLALCreateREAL8TimeSeries("H1:TEST", &(LIGOTimeGPS) {1000000000, 0}, 0, 1.0 / SAMPLE_RATE, &lalDimensionlessUnit, WINDOW_LENGTH + 2 * window_shift);
+	window = XLALCreateRectangularREAL8Window(WINDOW_LENGTH);
+	randpar = XLALCreateRandomParams(1234);
+	XLAL_CHECK_MAIN(tseries && window && randpar, XLAL_EFUNC);
+	for(i = 0; i < tseries->data->length; i++)
+		tseries->data->data[i] = XLALNormalDeviate(randpar);
+
+	/* search the prime number of channels, and the same channels in
+	 * two separate searches */
+	all = search(tseries, window, FLOW, CHANNELS);
+	low = search(tseries, window, FLOW, CHANNELS_LOW);
+	high = search(tseries, window, FLOW + CHANNELS_LOW, CHANNELS - CHANNELS_LOW);
+	XLAL_CHECK_MAIN(all && low && high, XLAL_EFUNC);
+
+	/* events above the first channels must have come from the short
+	 * last block */
+	for(event = all; event; event = event->next)
+		if(event->central_freq > FLOW + CHANNELS_LOW)
+			break;
+	XLAL_CHECK_MAIN(event, XLAL_EFAILED, "no events found in the last block of channels");
+
+	/* the events of the separate searches must be those of the
+	 * search of all channels */
+	for(last = low; last->next; last = last->next);
+	last->next = high;
+	high = NULL;
+	XLALSortSnglBurst(&low, compare_events);
+	XLAL_CHECK_MAIN(XLALSnglBurstTableLength(all) == XLALSnglBurstTableLength(low), XLAL_EFAILED, "found %d events in %d channels, but %d in separate searches", XLALSnglBurstTableLength(all), CHANNELS, XLALSnglBurstTableLength(low));
+	for(event = all, last = low; event; event = event->next, last = last->next) {
+		XLAL_CHECK_MAIN(XLALGPSCmp(&event->peak_time, &last->peak_time) == 0 && event->central_freq == last->central_freq && event->duration == last->duration && event->bandwidth == last->bandwidth, XLAL_EFAILED, "events differ in tile at %g Hz", event->central_freq);
+		XLAL_CHECK_MAIN(agree(event->snr, last->snr) && agree(event->confidence, last->confidence) && agree(event->amplitude, last->amplitude), XLAL_EFAILED, "events at %g Hz differ: snr %g != %g, confidence %g != %g, amplitude %g != %g", event->central_freq, event->snr, last->snr, event->confidence, last->confidence, event->amplitude, last->amplitude);
+	}
+
+	XLALDestroySnglBurstTable(all);
+	XLALDestroySnglBurstTable(low);
+	XLALDestroyRandomParams(randpar);
+	XLALDestroyREAL8Window(window);
+	XLALDestroyREAL8TimeSeries(tseries);
+	LALCheckMemoryLeaks();
+
+	return 0;
+}
@@ -124,8 +124,17 @@ int main(int argc, char *argv[]){
 
      }
 
-  /* Set up the threads */
-  LALInferenceInitCBCThreads(state,1);
+  /* Set up the threads, one for each live point replaced concurrently */
+  INT4 nthreads=1;
+  ProcessParamsTable *ppt=NULL;
+  if (state && (ppt=LALInferenceGetProcParamVal(state->commandLine,"--Nthreads"))){
+    nthreads=atoi(ppt->value);
+    if (nthreads < 1) {
+      fprintf(stderr, "ERROR: --Nthreads must be a positive integer. Exiting...\n");
+      exit(1);
+    }
+  }
+  LALInferenceInitCBCThreads(state,nthreads);
 
   /* Init the prior */
   LALInferenceInitCBCPrior(state);
@@ -159,6 +168,9 @@ int main(int argc, char *argv[]){
   /* Call nested sampling algorithm */
   state->algorithm(state);
 
+  for(INT4 i=0;i<state->nthreads;i++)
+    LALInferenceClearThreadBuffers(&state->threads[i]);
+
   /* end */
   return(0);
 }
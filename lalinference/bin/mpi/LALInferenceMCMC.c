@@ -102,6 +102,8 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
     (--temp-skip N)     Number of steps between temperature swap proposals (100)\n\
     (--tempKill N)      Iteration number to stop temperature swapping (Niter)\n\
     (--ntemps N)         Number of temperature chains in ladder (as many as needed)\n\
+                        The chains of each MPI process are stepped concurrently when\n\
+                        built with OpenMP, using up to OMP_NUM_THREADS threads\n\
     (--temp-min T)      Lowest temperature for parallel tempering (1.0)\n\
     (--temp-max T)      Highest temperature for parallel tempering (50.0)\n\
     (--anneal)          Anneal hot temperature linearly to T=1.0\n\
@@ -666,13 +668,16 @@ ProcessParamsTable *LALInferenceContinueMCMC(char *infileName) {
 
 
 int main(int argc, char *argv[]){
-    INT4 mpirank;
+    INT4 i, mpirank, mpithreads;
     ProcessParamsTable *procParams = NULL, *ppt = NULL;
     LALInferenceRunState *runState = NULL;
     LALInferenceIFOData *data = NULL;
 
-    MPI_Init(&argc, &argv);
+    /* Local chains are stepped in OpenMP threads, but MPI is only called from the main thread */
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &mpithreads);
     MPI_Comm_rank(MPI_COMM_WORLD, &mpirank);
+    if (mpithreads < MPI_THREAD_FUNNELED && mpirank == 0)
+        fprintf(stderr, "WARNING: MPI library does not support MPI_THREAD_FUNNELED.\n");
 
     if (mpirank == 0) fprintf(stdout," ========== LALInference_MCMC ==========\n");
 
@@ -732,6 +737,9 @@ int main(int argc, char *argv[]){
     if (mpirank == 0) printf("sampling...\n");
     runState->algorithm(runState);
 
+    for (i=0; i<runState->nthreads; i++)
+        LALInferenceClearThreadBuffers(&runState->threads[i]);
+
     if (mpirank == 0) printf(" ========== main(): finished. ==========\n");
     MPI_Finalize();
 
@@ -26,6 +26,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <signal.h>
+#include <errno.h>
 #include <sys/times.h>
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
@@ -54,6 +55,10 @@
 #include <lal/LALInferenceVCSInfo.h>
 #include <lal/LALStdlib.h>
 
+#if defined(LAL_PTHREAD_LOCK)
+#include <pthread.h>
+#endif
+
 #define PROGRAM_NAME "LALInferenceMCMCSampler.c"
 #define CVS_ID_STRING "$Id$"
 #define CVS_REVISION "$Revision$"
@@ -67,70 +72,29 @@
 #define UNUSED
 #endif
 
-static void
-thinDifferentialEvolutionPoints(LALInferenceThreadState *thread) {
-    size_t i;
-    size_t newSize;
-
-    /* Delete all the even-index points. */
-    for (i = 0; i < thread->differentialPointsLength; i += 2) {
-        LALInferenceClearVariables(thread->differentialPoints[i]);
-        XLALFree(thread->differentialPoints[i]);
-        thread->differentialPoints[i] = NULL;
-    }
-
-    /* Copy the odd points into the first part of the array. */
-    for (i = 1; i < thread->differentialPointsLength; i += 2) {
-        thread->differentialPoints[i/2] = thread->differentialPoints[i];
-        thread->differentialPoints[i] = NULL;
-    }
-
-    newSize = thread->differentialPointsLength / 2;
-
-    /* Now shrink the buffer down. */
-    thread->differentialPoints = XLALRealloc(thread->differentialPoints, 2*newSize*sizeof(LALInferenceVariables *));
-    thread->differentialPointsSize = 2*newSize;
-    thread->differentialPointsLength = newSize;
-    thread->differentialPointsSkip *= 2;
-}
-
 static void
 accumulateDifferentialEvolutionSample(LALInferenceThreadState *thread, size_t buffer_limit) {
-    if (thread->differentialPointsSize == thread->differentialPointsLength) {
-        size_t newSize = thread->differentialPointsSize*2;
-
-        if (buffer_limit < newSize) {
-            /* Then thin, and record sample. */
-            thinDifferentialEvolutionPoints(thread);
-            return accumulateDifferentialEvolutionSample(thread, buffer_limit);
-        } else {
-            thread->differentialPoints = XLALRealloc(thread->differentialPoints, newSize*sizeof(LALInferenceVariables *));
-            thread->differentialPointsSize = newSize;
-        }
-    }
-
-    thread->differentialPoints[thread->differentialPointsLength] = XLALCalloc(1, sizeof(LALInferenceVariables));
-    LALInferenceCopyVariables(thread->currentParams, thread->differentialPoints[thread->differentialPointsLength]);
+    /* Thin rather than grow the buffer beyond its limit */
+    if (thread->differentialPointsSize == thread->differentialPointsLength &&
+        buffer_limit < 2*thread->differentialPointsSize)
+        LALInferenceThinDifferentialPoints(thread);
 
-    thread->differentialPointsLength += 1;
+    if (LALInferenceAppendDifferentialPoint(thread, thread->currentParams) != XLAL_SUCCESS)
+        XLAL_ERROR_VOID(XLAL_EFUNC);
 }
 
 static void
 resetDifferentialEvolutionBuffer(LALInferenceThreadState *thread) {
-    size_t i;
-
-    for (i = 0; i < thread->differentialPointsLength; i++) {
-        LALInferenceClearVariables(thread->differentialPoints[i]);
-        XLALFree(thread->differentialPoints[i]);
-        thread->differentialPoints[i] = NULL;
-    }
-
-    thread->differentialPoints = XLALRealloc(thread->differentialPoints, sizeof(LALInferenceVariables *));
-    thread->differentialPointsLength = 0;
-    thread->differentialPointsSize = 1;
+    LALInferenceClearDifferentialPoints(thread);
     thread->differentialPointsSkip = LALInferenceGetINT4Variable(thread->proposalArgs, "de_skip");
 }
 
+static void print_swap_latency(LALInferenceRunState *runState);
+
+/* Background writing of checkpoint and sample files */
+static void queueMCMCCheckpoint(LALInferenceRunState *runState);
+static void flushMCMCCheckpoint(void);
+
 /* This is checked by the main loop to determine when to checkpoint */
 static volatile sig_atomic_t __master_saveStateFlag = 0;
 /* This indicates the main loop should terminate */
@@ -330,7 +294,10 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
 		LALInferenceSortVariablesByName(runState->threads[t].currentParams);
     }
     LALInferenceNameOutputs(runState);
-    LALInferenceResumeMCMC(runState);
+    int resume_errnum;
+    XLAL_TRY(LALInferenceResumeMCMC(runState), resume_errnum);
+    if (resume_errnum != XLAL_SUCCESS)
+        XLAL_ERROR_VOID(resume_errnum, "Unable to resume the run");
     
     if (benchmark) {
         struct timeval start_tv;
@@ -374,7 +341,12 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
     // iterate:
     step_last_acl_check = runState->threads[0].step;
     while (!runComplete) {
-        #pragma omp parallel for private(thread)
+        /* Step the local chains concurrently.  Each chain has its own model (with
+         * waveform cache and template buffers), proposal state and random number
+         * generator, and shares the data with the others; no MPI calls are made
+         * from inside this loop.  Chains at different temperatures may take
+         * different times per step, so they are handed out one at a time. */
+        #pragma omp parallel for private(thread) schedule(dynamic, 1)
         for (t = 0; t < n_local_threads; t++) {
             FILE *outfile = NULL;
             char outfilename[256];
@@ -462,46 +434,16 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
 		}
 		MPI_Bcast(&local_saveStateFlag, 1, MPI_INT, 0, MPI_COMM_WORLD);
 		MPI_Bcast(&local_exitFlag, 1, MPI_INT, 0, MPI_COMM_WORLD);
-        INT4 saveattempts=0;
-        INT4 retrydelay=5; /* 5 seconds before initial retry */
-        INT4 retcode=XLAL_SUCCESS;
-        /* The following checkpoint code is wrapped in do {} while loops
-         * to allow 10 retries, in case of filesystem congestion
-         */
 		if(local_saveStateFlag!=0)
 		{
-            do
-            {
-                XLAL_TRY(LALInferenceCheckpointMCMC(runState), retcode);
-                if(retcode!=XLAL_SUCCESS) 
-                {
-                    saveattempts+=1;
-                    fprintf(stderr,"Process %i failed to write checkpoint file %s \
-                    at attempt %i, waiting to retry\n",MPIrank, runState->resumeOutFileName, saveattempts);
-                    sleep(retrydelay*saveattempts); /* In case of IO failure wait progressively longer */
-                }
-            } while (retcode!=XLAL_SUCCESS && saveattempts<10);
-            if(retcode!=XLAL_SUCCESS) {fprintf(stderr,"Process %i failed to checkpoint\n", MPIrank);}
-            saveattempts=0;
-            do
-            {
-                XLAL_TRY(LALInferenceWriteMCMCSamples(runState), retcode);
-                if(retcode!=XLAL_SUCCESS) 
-                {
-                    saveattempts+=1;
-                    fprintf(stderr,"Process %i failed to write samples file %s \
-                    at attempt %i, waiting to retry\n",MPIrank, runState->outFileName, saveattempts);
-                    sleep(retrydelay*saveattempts); /* In case of IO failure wait progressively longer */
-                }
-            } while (retcode!=XLAL_SUCCESS && saveattempts<10);
-            if(retcode!=XLAL_SUCCESS) {fprintf(stderr,"Process %i failed to checkpoint\n", MPIrank);}
-            /* Wait for all processes to save */
-			MPI_Barrier(MPI_COMM_WORLD);
+            /* Checkpoint files are written in the background while sampling continues */
+            queueMCMCCheckpoint(runState);
 			__master_saveStateFlag=0;
             local_saveStateFlag=0;
 		}
 		if(local_exitFlag) {
-				/* Wait for all processes to be ready to exit */
+				/* Wait for all processes to finish writing and be ready to exit */
+				flushMCMCCheckpoint();
 				MPI_Barrier(MPI_COMM_WORLD);
 				exit(CondorExitCode);
 		}
@@ -563,6 +505,9 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
         /* Broadcast the root's decision on run completion */
         MPI_Bcast(&runComplete, 1, MPI_INT, 0, MPI_COMM_WORLD);
     }// while (!runComplete)
+    if (benchmark)
+        print_swap_latency(runState);
+    flushMCMCCheckpoint();
     LALInferenceWriteMCMCSamples(runState);
     MPI_Barrier(MPI_COMM_WORLD);
 }
@@ -594,15 +539,12 @@ void record_likelihoods(LALInferenceThreadState *thread) {
 
 void mcmc_step(LALInferenceRunState *runState, LALInferenceThreadState *thread) {
     // Metropolis-Hastings sampler.
-    INT4 MPIrank;
     REAL8 logPriorCurrent, logPriorProposed;
     REAL8 logLikelihoodCurrent, logLikelihoodProposed;
     REAL8 logProposalRatio = 0.0;  // = log(P(backward)/P(forward))
     REAL8 logAcceptanceProbability;
     REAL8 targetAcceptance = 0.234;
 
-    MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
-
     INT4 outputSNRs = LALInferenceGetINT4Variable(runState->algorithmParams, "output_snrs");
     INT4 propTrack = LALInferenceGetINT4Variable(runState->algorithmParams, "prop_track");
 
@@ -765,20 +707,76 @@ void LALInferenceAdaptLadder(LALInferenceRunState *runState) {
 //-----------------------------------------
 // Swap routines:
 //-----------------------------------------
+/*
+ * Parallel tempering swaps alternate between the even and the odd rungs of
+ * the ladder.  The pairs of chains in each round are disjoint, so all of them
+ * are proposed at once: chains on different processes exchange their state in
+ * a single nonblocking message each way, and swaps between chains on the same
+ * process are made while those messages are in flight.  Both ends of an
+ * exchange make the same acceptance decision, using a uniform deviate drawn by
+ * the colder chain and sent with its state.
+ */
+
+/* Layout of the message exchanged between the chains of a swap */
+enum {
+    PT_MSG_TEMPERATURE,
+    PT_MSG_LIKELIHOOD,
+    PT_MSG_PRIOR,
+    PT_MSG_UNIFORM,
+    PT_MSG_PARAMS
+};
+
+typedef struct tagPTExchange {
+    INT4 cold_ind;
+    INT4 is_cold;
+    INT4 peer_rank;
+    LALInferenceThreadState *thread;
+    INT4 nPar; /* number of parameters packed from and unpacked into thread */
+    REAL8 *send;
+    REAL8 *recv;
+    MPI_Request request;
+    double start;
+} PTExchange;
+
+/* Swap round counter, identical on all processes */
+static UINT4 pt_swap_round = 0;
+
+/* Accumulated swap latency per rung, for rungs whose colder chain is local */
+static REAL8 *pt_swap_latency = NULL;
+static INT4 *pt_swap_count = NULL;
+
+static void record_swap(LALInferenceThreadState *cold_thread, INT4 swapAccepted) {
+    cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter] = swapAccepted;
+    cold_thread->temp_swap_counter = (cold_thread->temp_swap_counter + 1) % cold_thread->temp_swap_window;
+}
+
+static void print_swap(FILE *swapfile, LALInferenceThreadState *cold_thread, INT4 cold_ind,
+                       REAL8 hot_temperature, REAL8 logThreadSwap, REAL8 cold_likelihood,
+                       REAL8 hot_likelihood, INT4 swapAccepted) {
+    REAL8 acc_frac = 0.0;
+    for (INT4 i=0; i<cold_thread->temp_swap_window; i++)
+        acc_frac += (REAL8)cold_thread->temp_swap_accepts[i] / cold_thread->temp_swap_window;
+    fprintf(swapfile, "%d\t%d\t%f\t%d\t%f\t%f\t%f\t%f\t%i\t%f\n",
+            cold_thread->step, cold_ind, cold_thread->temperature,
+            cold_ind+1, hot_temperature,
+            logThreadSwap, cold_likelihood,
+            hot_likelihood, swapAccepted, acc_frac);
+}
+
 void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile) {
     INT4 MPIrank, MPIsize;
-    MPI_Status MPIstatus;
-    INT4 nPar, adjNPar, n_local_threads, ntemps;
-    INT4 low;
-    INT4 ind, cold_ind, hot_ind;
+    INT4 n_local_threads, ntemps;
+    INT4 cold_ind, hot_ind;
     INT4 cold_rank, hot_rank;
     INT4 swapAccepted;
-    INT4 *cold_inds;
-    REAL8 adjCurrentLikelihood, adjCurrentPrior;
-    REAL8 logThreadSwap, temp_prior, temp_like, cold_temp;
-    LALInferenceThreadState *cold_thread = &runState->threads[0];
+    INT4 k, nExchanges = 0;
+    INT4 parity;
+    REAL8 logThreadSwap, temp_prior, temp_like;
+    LALInferenceThreadState *cold_thread;
     LALInferenceThreadState *hot_thread;
     LALInferenceVariables *temp_params;
+    PTExchange exchanges[2];
+    double start = 0.0;
 
     MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
     MPI_Comm_size(MPI_COMM_WORLD, &MPIsize);
@@ -790,177 +788,172 @@ void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile) {
     if (ntemps == 1)
         return;
 
-    cold_inds = XLALCalloc(ntemps-1, sizeof(INT4));
-
-    /* Have the root process choose a random order of ladder swaps and share it */
-    if (MPIrank == 0) {
-        for (low = 0; low < ntemps-1; low++)
-            cold_inds[low] = low;
-
-        gsl_ran_shuffle(runState->GSLrandom, cold_inds, ntemps-1, sizeof(INT4));
+    INT4 benchmark = LALInferenceGetINT4Variable(runState->algorithmParams, "benchmark");
+    if (benchmark && !pt_swap_latency) {
+        pt_swap_latency = XLALCalloc(ntemps-1, sizeof(REAL8));
+        pt_swap_count = XLALCalloc(ntemps-1, sizeof(INT4));
     }
 
-    MPI_Bcast(cold_inds, ntemps-1, MPI_INT, 0, MPI_COMM_WORLD);
+    parity = pt_swap_round % 2;
+    pt_swap_round++;
 
-    for (ind=0; ind < ntemps-1; ind++) {
-        cold_ind = cold_inds[ind];
+    /* Post the exchanges with chains on other processes.  Each process holds a
+     * contiguous block of the ladder, so it takes part in at most two. */
+    for (cold_ind = parity; cold_ind < ntemps-1; cold_ind += 2) {
         hot_ind = cold_ind+1;
-
-        /* Check if cold chain is handled by this thread */
         cold_rank = cold_ind/n_local_threads;
         hot_rank = hot_ind/n_local_threads;
 
-        if (cold_rank == hot_rank) {
-            if (MPIrank == cold_rank) {
-                cold_thread = &runState->threads[cold_ind % n_local_threads];
-                hot_thread = &runState->threads[hot_ind % n_local_threads];
-
-                /* Determine if swap is accepted and tell the other chain */
-                logThreadSwap = 1.0/cold_thread->temperature - 1.0/hot_thread->temperature;
-                logThreadSwap *= hot_thread->currentLikelihood - cold_thread->currentLikelihood;
-
-                if ((logThreadSwap > 0) || (log(gsl_rng_uniform(runState->GSLrandom)) < logThreadSwap ))
-                    swapAccepted = 1;
-                else
-                    swapAccepted = 0;
-                cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter] = swapAccepted;
-                cold_thread->temp_swap_counter = (cold_thread->temp_swap_counter + 1) % cold_thread->temp_swap_window;
-
-                /* Print to file if verbose is chosen */
-                if (swapfile != NULL) {
-                    REAL8 acc_frac = 0.0;
-                    for (INT4 i=0; i<cold_thread->temp_swap_window; i++)
-                        acc_frac += (REAL8)cold_thread->temp_swap_accepts[i] / cold_thread->temp_swap_window;
-                    cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter % cold_thread->temp_swap_window] = swapAccepted;
-                    fprintf(swapfile, "%d\t%d\t%f\t%d\t%f\t%f\t%f\t%f\t%i\t%f\n",
-                            cold_thread->step, cold_ind, cold_thread->temperature,
-                            hot_ind, hot_thread->temperature,
-                            logThreadSwap, cold_thread->currentLikelihood,
-                            hot_thread->currentLikelihood, swapAccepted, acc_frac);
-                }
+        if (cold_rank == hot_rank || (MPIrank != cold_rank && MPIrank != hot_rank))
+            continue;
+
+        PTExchange *ex = &exchanges[nExchanges++];
+        ex->cold_ind = cold_ind;
+        ex->is_cold = (MPIrank == cold_rank);
+        ex->peer_rank = ex->is_cold ? hot_rank : cold_rank;
+        ex->thread = &runState->threads[(ex->is_cold ? cold_ind : hot_ind) % n_local_threads];
+        ex->start = MPI_Wtime();
+
+        /* The local chain of the exchange may vary a different number of
+         * parameters from the other chains of this process */
+        ex->nPar = LALInferenceGetVariableDimensionNonFixed(ex->thread->currentParams);
+        ex->send = XLALMalloc((PT_MSG_PARAMS + ex->nPar) * sizeof(REAL8));
+        ex->send[PT_MSG_TEMPERATURE] = ex->thread->temperature;
+        ex->send[PT_MSG_LIKELIHOOD] = ex->thread->currentLikelihood;
+        ex->send[PT_MSG_PRIOR] = ex->thread->currentPrior;
+        ex->send[PT_MSG_UNIFORM] = ex->is_cold ? gsl_rng_uniform(runState->GSLrandom) : 0.0;
+        LALInferenceCopyVariablesToArray(ex->thread->currentParams, ex->send + PT_MSG_PARAMS);
+
+        MPI_Isend(ex->send, PT_MSG_PARAMS + ex->nPar, MPI_DOUBLE, ex->peer_rank, PT_COM, MPI_COMM_WORLD, &ex->request);
+    }
 
-                if (swapAccepted) {
-                    temp_params = hot_thread->currentParams;
-                    temp_prior = hot_thread->currentPrior;
-                    temp_like = hot_thread->currentLikelihood;
+    /* Swap chains on this process while the messages are in flight */
+    for (cold_ind = parity; cold_ind < ntemps-1; cold_ind += 2) {
+        hot_ind = cold_ind+1;
+        cold_rank = cold_ind/n_local_threads;
+        hot_rank = hot_ind/n_local_threads;
 
-                    hot_thread->currentParams = cold_thread->currentParams;
-                    hot_thread->currentPrior = cold_thread->currentPrior;
-                    hot_thread->currentLikelihood = cold_thread->currentLikelihood;
+        if (cold_rank != hot_rank || MPIrank != cold_rank)
+            continue;
 
-                    cold_thread->currentParams = temp_params;
-                    cold_thread->currentPrior = temp_prior;
-                    cold_thread->currentLikelihood = temp_like;
-                }
+        if (benchmark)
+            start = MPI_Wtime();
 
-            }
-        } else {
-            if (MPIrank == cold_rank) {
-                cold_thread = &runState->threads[cold_ind % n_local_threads];
-
-                /* Send current likelihood for swap proposal */
-                MPI_Send(&(cold_thread->temperature), 1, MPI_DOUBLE, hot_rank, PT_COM, MPI_COMM_WORLD);
-                MPI_Send(&(cold_thread->currentLikelihood), 1, MPI_DOUBLE, hot_rank, PT_COM, MPI_COMM_WORLD);
-
-                /* Determine if swap was accepted */
-                MPI_Recv(&swapAccepted, 1, MPI_INT, hot_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-                cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter] = swapAccepted;
-                cold_thread->temp_swap_counter = (cold_thread->temp_swap_counter + 1) % cold_thread->temp_swap_window;
-
-                /* Perform Swap */
-                if (swapAccepted) {
-                    /* Set new likelihood */
-                    MPI_Recv(&adjCurrentLikelihood, 1, MPI_DOUBLE, hot_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-                    cold_thread->currentLikelihood = adjCurrentLikelihood;
-
-                    /* Exchange current prior values */
-                    MPI_Send(&(cold_thread->currentPrior), 1, MPI_DOUBLE, hot_rank, PT_COM, MPI_COMM_WORLD);
-                    MPI_Recv(&adjCurrentPrior, 1, MPI_DOUBLE, hot_rank, 0, MPI_COMM_WORLD, &MPIstatus);
-                    cold_thread->currentPrior = adjCurrentPrior;
-
-                    /* Package and send parameters */
-                    nPar = LALInferenceGetVariableDimensionNonFixed(cold_thread->currentParams);
-                    MPI_Send(&nPar, 1, MPI_INT, hot_rank, PT_COM, MPI_COMM_WORLD);
-                    MPI_Recv(&adjNPar, 1, MPI_INT, hot_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-
-                    REAL8 *parameters = XLALMalloc(nPar * sizeof(REAL8));
-                    LALInferenceCopyVariablesToArray(cold_thread->currentParams, parameters);
-                    MPI_Send(parameters, nPar, MPI_DOUBLE, hot_rank, PT_COM, MPI_COMM_WORLD);
-
-                    /* Recieve and unpack parameters */
-                    REAL8 *adjParameters = XLALMalloc(adjNPar * sizeof(REAL8));
-                    MPI_Recv(adjParameters, adjNPar, MPI_DOUBLE, hot_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-                    LALInferenceCopyArrayToVariables(adjParameters, cold_thread->currentParams);
-
-                    XLALFree(parameters);
-                    XLALFree(adjParameters);
-                }
-            } else if (MPIrank == hot_rank) {
-                hot_thread = &runState->threads[hot_ind % n_local_threads];
-
-                MPI_Recv(&cold_temp, 1, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-
-                /* Receive adjacent likelilhood */
-                MPI_Recv(&adjCurrentLikelihood, 1, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-
-                /* Determine if swap is accepted and tell the other chain */
-                logThreadSwap = 1.0/cold_temp - 1.0/hot_thread->temperature;
-                logThreadSwap *= hot_thread->currentLikelihood - adjCurrentLikelihood;
-                if ((logThreadSwap > 0) || (log(gsl_rng_uniform(runState->GSLrandom)) < logThreadSwap ))
-                    swapAccepted = 1;
-                else
-                    swapAccepted = 0;
-
-                MPI_Send(&swapAccepted, 1, MPI_INT, cold_rank, PT_COM, MPI_COMM_WORLD);
-
-                /* Print to file if verbose is chosen */
-                if (swapfile != NULL) {
-                    fprintf(swapfile, "%d%f\t%f\t\t%f\t%f\t%f\t%i\n",
-                            hot_thread->step, cold_temp, hot_thread->temperature,
-                            logThreadSwap, adjCurrentLikelihood,
-                            hot_thread->currentLikelihood, swapAccepted);
-                    fflush(swapfile);
-                }
+        cold_thread = &runState->threads[cold_ind % n_local_threads];
+        hot_thread = &runState->threads[hot_ind % n_local_threads];
 
-                /* Perform Swap */
-                if (swapAccepted) {
-                    /* Swap likelihoods */
-                    MPI_Send(&(hot_thread->currentLikelihood), 1, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD);
-                    hot_thread->currentLikelihood = adjCurrentLikelihood;
+        /* Determine if swap is accepted */
+        logThreadSwap = 1.0/cold_thread->temperature - 1.0/hot_thread->temperature;
+        logThreadSwap *= hot_thread->currentLikelihood - cold_thread->currentLikelihood;
+
+        if ((logThreadSwap > 0) || (log(gsl_rng_uniform(runState->GSLrandom)) < logThreadSwap ))
+            swapAccepted = 1;
+        else
+            swapAccepted = 0;
+        record_swap(cold_thread, swapAccepted);
+
+        /* Print to file if verbose is chosen */
+        if (swapfile != NULL)
+            print_swap(swapfile, cold_thread, cold_ind, hot_thread->temperature, logThreadSwap,
+                       cold_thread->currentLikelihood, hot_thread->currentLikelihood, swapAccepted);
+
+        if (swapAccepted) {
+            temp_params = hot_thread->currentParams;
+            temp_prior = hot_thread->currentPrior;
+            temp_like = hot_thread->currentLikelihood;
+
+            hot_thread->currentParams = cold_thread->currentParams;
+            hot_thread->currentPrior = cold_thread->currentPrior;
+            hot_thread->currentLikelihood = cold_thread->currentLikelihood;
+
+            cold_thread->currentParams = temp_params;
+            cold_thread->currentPrior = temp_prior;
+            cold_thread->currentLikelihood = temp_like;
+        }
 
-                    /* Exchange current prior values */
-                    MPI_Recv(&adjCurrentPrior, 1, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-                    MPI_Send(&(hot_thread->currentPrior), 1, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD);
-                    hot_thread->currentPrior = adjCurrentPrior;
+        if (benchmark) {
+            pt_swap_latency[cold_ind] += MPI_Wtime() - start;
+            pt_swap_count[cold_ind] += 1;
+        }
+    }
 
-                    /* Package parameters */
-                    nPar = LALInferenceGetVariableDimensionNonFixed(hot_thread->currentParams);
-                    MPI_Recv(&adjNPar, 1, MPI_INT, cold_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-                    MPI_Send(&nPar, 1, MPI_INT, cold_rank, PT_COM, MPI_COMM_WORLD);
+    /* Complete the exchanges; both ends reach the same decision */
+    for (k = 0; k < nExchanges; k++) {
+        PTExchange *ex = &exchanges[k];
+        MPI_Status status;
+        INT4 count = 0;
+
+        /* The adjacent chain may vary a different number of parameters, so
+         * size the receive buffer from its message */
+        MPI_Probe(ex->peer_rank, PT_COM, MPI_COMM_WORLD, &status);
+        MPI_Get_count(&status, MPI_DOUBLE, &count);
+        ex->recv = XLALMalloc(count * sizeof(REAL8));
+        MPI_Recv(ex->recv, count, MPI_DOUBLE, ex->peer_rank, PT_COM, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        MPI_Wait(&ex->request, MPI_STATUS_IGNORE);
+
+        const REAL8 *cold = ex->is_cold ? ex->send : ex->recv;
+        const REAL8 *hot = ex->is_cold ? ex->recv : ex->send;
+
+        logThreadSwap = 1.0/cold[PT_MSG_TEMPERATURE] - 1.0/hot[PT_MSG_TEMPERATURE];
+        logThreadSwap *= hot[PT_MSG_LIKELIHOOD] - cold[PT_MSG_LIKELIHOOD];
+
+        /* Each end checks the length of the other's message against its own
+         * chain before unpacking it, so both reject a swap between chains
+         * with different numbers of parameters */
+        if (count != PT_MSG_PARAMS + ex->nPar)
+            swapAccepted = 0; /* Parameter layouts differ between the chains */
+        else if ((logThreadSwap > 0) || (log(cold[PT_MSG_UNIFORM]) < logThreadSwap))
+            swapAccepted = 1;
+        else
+            swapAccepted = 0;
 
-                    REAL8 *parameters = XLALMalloc(nPar * sizeof(REAL8));
-                    LALInferenceCopyVariablesToArray(hot_thread->currentParams, parameters);
+        if (ex->is_cold) {
+            record_swap(ex->thread, swapAccepted);
 
-                    /* Swap parameters */
-                    REAL8 *adjParameters = XLALMalloc(adjNPar * sizeof(REAL8));
-                    MPI_Recv(adjParameters, adjNPar, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-                    MPI_Send(parameters, nPar, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD);
+            if (swapfile != NULL)
+                print_swap(swapfile, ex->thread, ex->cold_ind, hot[PT_MSG_TEMPERATURE], logThreadSwap,
+                           cold[PT_MSG_LIKELIHOOD], hot[PT_MSG_LIKELIHOOD], swapAccepted);
+        }
 
-                    /* Unpack parameters */
-                    LALInferenceCopyArrayToVariables(adjParameters, hot_thread->currentParams);
+        /* Take the adjacent chain's state */
+        if (swapAccepted) {
+            ex->thread->currentLikelihood = ex->recv[PT_MSG_LIKELIHOOD];
+            ex->thread->currentPrior = ex->recv[PT_MSG_PRIOR];
+            LALInferenceCopyArrayToVariables(ex->recv + PT_MSG_PARAMS, ex->thread->currentParams);
+        }
 
-                    XLALFree(parameters);
-                    XLALFree(adjParameters);
-                }
-            }
+        if (benchmark && ex->is_cold) {
+            pt_swap_latency[ex->cold_ind] += MPI_Wtime() - ex->start;
+            pt_swap_count[ex->cold_ind] += 1;
         }
-    }
 
-    XLALFree(cold_inds);
+        XLALFree(ex->send);
+        XLALFree(ex->recv);
+    }
 
     return;
 }
 
+/* Report the mean swap latency of each rung whose colder chain is on this process */
+static void print_swap_latency(LALInferenceRunState *runState) {
+    INT4 MPIrank, MPIsize, n_local_threads, ntemps, cold_ind;
+
+    if (!pt_swap_latency)
+        return;
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
+    MPI_Comm_size(MPI_COMM_WORLD, &MPIsize);
+    n_local_threads = runState->nthreads;
+    ntemps = MPIsize*n_local_threads;
+
+    for (cold_ind = 0; cold_ind < ntemps-1; cold_ind++) {
+        if (cold_ind/n_local_threads != MPIrank || pt_swap_count[cold_ind] == 0)
+            continue;
+        printf("Temperature swap %i <-> %i: mean latency %g s over %i swaps\n", cold_ind, cold_ind+1,
+               pt_swap_latency[cold_ind] / pt_swap_count[cold_ind], pt_swap_count[cold_ind]);
+    }
+}
+
 
 // UINT4 LALInferenceMCMCMCswap(LALInferenceRunState *runState, REAL8 *ladder, INT4 i, FILE *swapfile) {
 //     INT4 MPIrank;
@@ -1296,63 +1289,185 @@ void LALInferenceResumeMCMC(LALInferenceRunState *runState) {
             access(runState->resumeOutFileName, R_OK) ==0) {
         /* Then file already exists for reading, and we're going to resume
         from it, so don't write the header. */
-        LALInferenceReadMCMCCheckpoint(runState);
+        int errnum;
+        XLAL_TRY(LALInferenceReadMCMCCheckpoint(runState), errnum);
+        if (errnum != XLAL_SUCCESS)
+            XLAL_ERROR_VOID(errnum, "Unable to resume from %s", runState->resumeOutFileName);
     }
 
     return;
 }
 
-/* Store the MCMC run state to HDF5 for use by --resume */
-void LALInferenceCheckpointMCMC(LALInferenceRunState *runState) {
-    //ProcessParamsTable *ppt;
-    INT4 i, t, n_local_threads;
-    INT4 MPIrank;
-    LALH5File *resume_file = NULL;
-    LALInferenceThreadState *thread;
+/*
+ * Checkpoint and sample files are written from a snapshot of the run state,
+ * so that they can be written by a background thread while sampling
+ * continues.  The samples logged to each chain's output array are never
+ * modified once logged, so the snapshot shares them rather than copying.
+ */
+typedef struct tagMCMCChainSnapshot {
+    char name[VARNAME_MAX];
+    LALInferenceVariables *proposalArgs;
+    LALInferenceVariables *currentParams;
+    REAL8 *differentialPoints; /* packed as the varying parameters of currentParams */
+    size_t differentialPointsLength;
+    INT4 differentialPointsSkip;
+    REAL8 temperature;
+    INT4 step;
+    INT4 effective_sample_size;
+    REAL8 temp_acc_rate;
+    LALInferenceVariables **samples; /* not owned */
+    UINT4 nSamples;
+} MCMCChainSnapshot;
+
+typedef struct tagMCMCSnapshot {
+    char runID[VARNAME_MAX];
+    char *commandLine;
+    LALInferenceVariables *injParams;
+    INT4 nchains;
+    MCMCChainSnapshot *chains;
+} MCMCSnapshot;
+
+static void destroyMCMCSnapshot(MCMCSnapshot *snap) {
+    INT4 t;
 
-    MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
+    if (!snap)
+        return;
 
-    resume_file = XLALH5FileOpen(runState->resumeOutFileName, "w");
-    if(resume_file == NULL){
-        XLALErrorHandler = XLALExitErrorHandler;
-        XLALPrintError("Output file error. Please check that the specified path exists. (in %s, line %d)\n",__FILE__, __LINE__);
-        XLAL_ERROR_VOID(XLAL_EIO);
+    for (t = 0; t < snap->nchains; t++) {
+        MCMCChainSnapshot *chain = &snap->chains[t];
+        if (chain->proposalArgs) {
+            LALInferenceClearVariables(chain->proposalArgs);
+            XLALFree(chain->proposalArgs);
+        }
+        if (chain->currentParams) {
+            LALInferenceClearVariables(chain->currentParams);
+            XLALFree(chain->currentParams);
+        }
+        XLALFree(chain->differentialPoints);
+        XLALFree(chain->samples);
+    }
+    XLALFree(snap->chains);
+    if (snap->injParams) {
+        LALInferenceClearVariables(snap->injParams);
+        XLALFree(snap->injParams);
     }
+    XLALFree(snap->commandLine);
+    XLALFree(snap);
+}
 
-    LALH5File *group = LALInferenceH5CreateGroupStructure(resume_file, "lalinference", runState->runID);
+static MCMCSnapshot *createMCMCSnapshot(LALInferenceRunState *runState) {
+    INT4 i, t;
+    LALInferenceThreadState *thread;
 
-    n_local_threads = runState->nthreads;
-    for (t = 0; t < n_local_threads; t++) {
+    MCMCSnapshot *snap = XLALCalloc(1, sizeof(*snap));
+    if (!snap)
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+
+    snprintf(snap->runID, sizeof(snap->runID), "%s", runState->runID);
+    snap->commandLine = LALInferencePrintCommandLine(runState->commandLine);
+    snap->injParams = LALInferencePrintInjectionSample(runState);
+
+    snap->nchains = runState->nthreads;
+    snap->chains = XLALCalloc(snap->nchains, sizeof(MCMCChainSnapshot));
+    if (!snap->chains) {
+        destroyMCMCSnapshot(snap);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+
+    for (t = 0; t < snap->nchains; t++) {
+        MCMCChainSnapshot *chain = &snap->chains[t];
         thread = &runState->threads[t];
 
-        char chain_group_name[1024];
-        snprintf(chain_group_name, sizeof(chain_group_name), "%s-checkpoint", thread->name);
-        LALH5File *chain_group = XLALH5GroupOpen(group, chain_group_name);
-        /*
-         * FIXME: use GNUism asprintf or fall back to libiberty
-         *
+        snprintf(chain->name, sizeof(chain->name), "%s", thread->name);
 
-        char *chain_group_name = NULL;
-        asprintf(&chain_group_name, "%s-checkpoint", thread->name);
-        LALH5File *chain_group = XLALH5GroupOpen(group, chain_group_name);
-        free(chain_group_name);
-        */
+        chain->proposalArgs = XLALCalloc(1, sizeof(LALInferenceVariables));
+        chain->currentParams = XLALCalloc(1, sizeof(LALInferenceVariables));
+        if (!chain->proposalArgs || !chain->currentParams) {
+            destroyMCMCSnapshot(snap);
+            XLAL_ERROR_NULL(XLAL_ENOMEM);
+        }
+        LALInferenceCopyVariables(thread->proposalArgs, chain->proposalArgs);
+        LALInferenceCopyVariables(thread->currentParams, chain->currentParams);
+
+        /* The differential evolution buffer is stored as points laid out like the current parameters */
+        if (thread->differentialPointsArray && thread->differentialPointsLength > 0) {
+            if (!LALInferenceVariablesMatchSchema(thread->differentialPointsSchema, thread->currentParams)) {
+                destroyMCMCSnapshot(snap);
+                XLAL_ERROR_NULL(XLAL_EINVAL, "Differential evolution buffer of chain %s does not match its current parameters", thread->name);
+            }
+            size_t size = thread->differentialPointsLength * thread->differentialPointsSchema->length * sizeof(REAL8);
+            chain->differentialPoints = XLALMalloc(size);
+            if (!chain->differentialPoints) {
+                destroyMCMCSnapshot(snap);
+                XLAL_ERROR_NULL(XLAL_ENOMEM);
+            }
+            memcpy(chain->differentialPoints, thread->differentialPointsArray, size);
+            chain->differentialPointsLength = thread->differentialPointsLength;
+        }
+        chain->differentialPointsSkip = thread->differentialPointsSkip;
 
-        /* Create run identifier group */
-        LALInferenceH5VariablesArrayToDataset(chain_group, thread->differentialPoints, thread->differentialPointsLength, "differential_points");
-        LALInferenceH5VariablesArrayToDataset(chain_group, &(thread->proposalArgs), 1, "proposal_arguments");
-        LALInferenceH5VariablesArrayToDataset(chain_group, &(thread->currentParams), 1, "current_parameters");
-        XLALH5FileAddScalarAttribute(chain_group, "temperature", &(thread->temperature), LAL_D_TYPE_CODE);
-        XLALH5FileAddScalarAttribute(chain_group, "last_step", &(thread->step), LAL_I4_TYPE_CODE);
-        XLALH5FileAddScalarAttribute(chain_group, "effective_sample_size", &(thread->effective_sample_size), LAL_I4_TYPE_CODE);
-        XLALH5FileAddScalarAttribute(chain_group, "differential_point_skip", &(thread->differentialPointsSkip), LAL_I4_TYPE_CODE);
+        chain->temperature = thread->temperature;
+        chain->step = thread->step;
+        chain->effective_sample_size = thread->effective_sample_size;
 
         /* Store the total number of temperature swaps accepted over the stored window */
-        REAL8 temp_acc_rate = 0;
+        chain->temp_acc_rate = 0;
         for (i=0; i<thread->temp_swap_window; i++)
-            temp_acc_rate += thread->temp_swap_accepts[i];
-        temp_acc_rate /= thread->temp_swap_window;
-        XLALH5FileAddScalarAttribute(chain_group, "temperature_swap_acceptance_rate", &(temp_acc_rate), LAL_D_TYPE_CODE);
+            chain->temp_acc_rate += thread->temp_swap_accepts[i];
+        chain->temp_acc_rate /= thread->temp_swap_window;
+
+        if(LALInferenceCheckVariable(thread->algorithmParams, "outputarray")
+                && LALInferenceCheckVariable(thread->algorithmParams, "N_outputarray") ) {
+            LALInferenceVariables **output_array=*(LALInferenceVariables ***)LALInferenceGetVariable(thread->algorithmParams,"outputarray");
+            chain->nSamples=*(UINT4 *)LALInferenceGetVariable(thread->algorithmParams,"N_outputarray");
+            chain->samples = XLALMalloc((chain->nSamples ? chain->nSamples : 1) * sizeof(LALInferenceVariables *));
+            if (!chain->samples) {
+                destroyMCMCSnapshot(snap);
+                XLAL_ERROR_NULL(XLAL_ENOMEM);
+            }
+            memcpy(chain->samples, output_array, chain->nSamples * sizeof(LALInferenceVariables *));
+        }
+    }
+
+    return snap;
+}
+
+/* Store a snapshot of the MCMC run state to HDF5 for use by --resume */
+static int writeMCMCCheckpoint(const MCMCSnapshot *snap, const char *filename) {
+    INT4 t;
+    LALH5File *resume_file = NULL;
+
+    resume_file = XLALH5FileOpen(filename, "w");
+    if(resume_file == NULL){
+        XLALPrintError("Output file error. Please check that the specified path exists. (in %s, line %d)\n",__FILE__, __LINE__);
+        XLAL_ERROR(XLAL_EIO);
+    }
+
+    LALH5File *group = LALInferenceH5CreateGroupStructure(resume_file, "lalinference", snap->runID);
+
+    for (t = 0; t < snap->nchains; t++) {
+        const MCMCChainSnapshot *chain = &snap->chains[t];
+
+        char chain_group_name[1024];
+        snprintf(chain_group_name, sizeof(chain_group_name), "%s-checkpoint", chain->name);
+        LALH5File *chain_group = XLALH5GroupOpen(group, chain_group_name);
+
+        /* Expand the packed differential evolution buffer for storage */
+        if (chain->differentialPointsLength > 0 &&
+            LALInferenceH5PackedArrayToDataset(chain_group, chain->currentParams, chain->differentialPoints,
+                                               chain->differentialPointsLength, "differential_points") != XLAL_SUCCESS) {
+            XLALH5FileClose(chain_group);
+            XLALH5FileClose(group);
+            XLALH5FileClose(resume_file);
+            XLAL_ERROR(XLAL_EFUNC);
+        }
+        LALInferenceH5VariablesArrayToDataset(chain_group, &(chain->proposalArgs), 1, "proposal_arguments");
+        LALInferenceH5VariablesArrayToDataset(chain_group, &(chain->currentParams), 1, "current_parameters");
+        XLALH5FileAddScalarAttribute(chain_group, "temperature", &(chain->temperature), LAL_D_TYPE_CODE);
+        XLALH5FileAddScalarAttribute(chain_group, "last_step", &(chain->step), LAL_I4_TYPE_CODE);
+        XLALH5FileAddScalarAttribute(chain_group, "effective_sample_size", &(chain->effective_sample_size), LAL_I4_TYPE_CODE);
+        XLALH5FileAddScalarAttribute(chain_group, "differential_point_skip", &(chain->differentialPointsSkip), LAL_I4_TYPE_CODE);
+        XLALH5FileAddScalarAttribute(chain_group, "temperature_swap_acceptance_rate", &(chain->temp_acc_rate), LAL_D_TYPE_CODE);
 
         /* TODO: Write metadata */
         XLALH5FileClose(chain_group);
@@ -1360,7 +1475,63 @@ void LALInferenceCheckpointMCMC(LALInferenceRunState *runState) {
     XLALH5FileClose(group);
 
     XLALH5FileClose(resume_file);
-    LALInferencePrintCheckpointFileInfo(runState->resumeOutFileName);
+
+    return XLAL_SUCCESS;
+}
+
+/* Write the samples in a snapshot of the MCMC run state to HDF5 */
+static int writeMCMCSamples(const MCMCSnapshot *snap, const char *filename) {
+    INT4 t;
+    LALH5File *output = NULL;
+
+    output = XLALH5FileOpen(filename, "w");
+    if(output == NULL){
+        XLALPrintError("Output file error. Please check that the specified path exists. (in %s, line %d)\n",__FILE__, __LINE__);
+        XLAL_ERROR(XLAL_EIO);
+    }
+
+    LALH5File *group = LALInferenceH5CreateGroupStructure(output, "lalinference", snap->runID);
+    /* Print injection parameters if there are any */
+    if (snap->injParams)
+        LALInferenceH5VariablesArrayToDataset(group, &(snap->injParams), 1, "injection_params");
+
+    for (t = 0; t < snap->nchains; t++) {
+        const MCMCChainSnapshot *chain = &snap->chains[t];
+
+        /* Create run identifier group */
+        if (chain->samples)
+            LALInferenceH5VariablesArrayToDataset(group, chain->samples, chain->nSamples, chain->name);
+    }
+    XLALH5FileAddStringAttribute(group,"CommandLine",snap->commandLine);
+    XLALH5FileClose(group);
+    XLALH5FileClose(output);
+    return XLAL_SUCCESS;
+}
+
+/* Write to a temporary file and rename it over the target once complete,
+ * so that an interrupted write never leaves a truncated file behind */
+static int writeMCMCFile(int (*write)(const MCMCSnapshot *, const char *), const MCMCSnapshot *snap, char *filename) {
+    char tmpname[strlen(filename) + 5];
+    snprintf(tmpname, sizeof(tmpname), "%s.tmp", filename);
+
+    XLAL_CHECK(write(snap, tmpname) == XLAL_SUCCESS, XLAL_EFUNC);
+    if (rename(tmpname, filename) != 0)
+        XLAL_ERROR(XLAL_EIO, "Could not rename %s to %s: %s", tmpname, filename, strerror(errno));
+
+    LALInferencePrintCheckpointFileInfo(filename);
+    return XLAL_SUCCESS;
+}
+
+/* Store the MCMC run state to HDF5 for use by --resume */
+void LALInferenceCheckpointMCMC(LALInferenceRunState *runState) {
+    MCMCSnapshot *snap = createMCMCSnapshot(runState);
+    if (!snap)
+        XLAL_ERROR_VOID(XLAL_EFUNC);
+
+    int retval = writeMCMCFile(writeMCMCCheckpoint, snap, runState->resumeOutFileName);
+    destroyMCMCSnapshot(snap);
+    if (retval != XLAL_SUCCESS)
+        XLAL_ERROR_VOID(XLAL_EFUNC);
 
     return;
 }
@@ -1395,7 +1566,6 @@ void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
         fprintf(stderr,"Resuming from %s\n",runState->resumeOutFileName);
     }
     if(resume_file == NULL){
-        XLALErrorHandler = XLALExitErrorHandler;
         XLALPrintError("Output file error. Please check that the specified path exists. (in %s, line %d)\n",__FILE__, __LINE__);
         XLAL_ERROR_VOID(XLAL_EIO);
     }
@@ -1406,7 +1576,6 @@ void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
         return;
     }
     if(output == NULL){
-        XLALErrorHandler = XLALExitErrorHandler;
         XLALPrintError("Output file error. Please check that the specified path exists. (in %s, line %d)\n",__FILE__, __LINE__);
         XLAL_ERROR_VOID(XLAL_EIO);
     }
@@ -1427,8 +1596,28 @@ void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
         XLAL_TRY(de_group = XLALH5DatasetRead(chain_group, "differential_points"), retcode);
         if (retcode==XLAL_SUCCESS)
         {
-            LALInferenceH5DatasetToVariablesArray(de_group, &(thread->differentialPoints), (UINT4 *)&(thread->differentialPointsLength));
-            thread->differentialPointsSize = thread->differentialPointsLength;
+            LALInferenceVariables **dePts = NULL;
+            UINT4 nPts = 0;
+            int de_failed = 0;
+            LALInferenceH5DatasetToVariablesArray(de_group, &dePts, &nPts);
+            LALInferenceClearDifferentialPoints(thread);
+            for (k = 0; k < nPts; k++) {
+                if (!de_failed && LALInferenceAppendDifferentialPoint(thread, dePts[k]) != XLAL_SUCCESS)
+                    de_failed = 1;
+                LALInferenceClearVariables(dePts[k]);
+                XLALFree(dePts[k]);
+            }
+            XLALFree(dePts);
+            if (de_failed) {
+                LALInferenceClearDifferentialPoints(thread);
+                XLALH5DatasetFree(de_group);
+                XLALH5FileClose(chain_group);
+                XLALH5FileClose(group);
+                XLALH5FileClose(li_group);
+                XLALH5FileClose(resume_file);
+                XLALH5FileClose(output);
+                XLAL_ERROR_VOID(XLAL_EFUNC, "Unable to restore the differential evolution buffer of chain %s", thread->name);
+            }
         }
 
         /* Restore proposal arguments, most importantly adaptation settings */
@@ -1521,55 +1710,150 @@ void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
 
 
 void LALInferenceWriteMCMCSamples(LALInferenceRunState *runState) {
-    //ProcessParamsTable *ppt;
-    INT4 MPIrank;
-    INT4 t, n_local_threads;
-    LALH5File *output = NULL;
-    LALInferenceThreadState *thread;
+    MCMCSnapshot *snap = createMCMCSnapshot(runState);
+    if (!snap)
+        XLAL_ERROR_VOID(XLAL_EFUNC);
 
-    MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
+    int retval = writeMCMCFile(writeMCMCSamples, snap, runState->outFileName);
+    destroyMCMCSnapshot(snap);
+    if (retval != XLAL_SUCCESS)
+        XLAL_ERROR_VOID(XLAL_EFUNC);
 
-    output = XLALH5FileOpen(runState->outFileName, "w");
-    if(output == NULL){
-        XLALErrorHandler = XLALExitErrorHandler;
-        XLALPrintError("Output file error. Please check that the specified path exists. (in %s, line %d)\n",__FILE__, __LINE__);
-        XLAL_ERROR_VOID(XLAL_EIO);
-    }
+    return;
+}
 
-    LALH5File *group = LALInferenceH5CreateGroupStructure(output, "lalinference", runState->runID);
-    /* Print injection parameters if there are any */
-    LALInferenceVariables *injParams = NULL;
-    if ( (injParams=LALInferencePrintInjectionSample(runState)) )
+
+/* Write the files in a snapshot, retrying in case of filesystem congestion */
+static void writeMCMCSnapshot(const MCMCSnapshot *snap, char *resumeFileName, char *outFileName) {
+    INT4 saveattempts=0;
+    INT4 retrydelay=5; /* 5 seconds before initial retry */
+    INT4 retcode=XLAL_SUCCESS;
+
+    do
+    {
+        XLAL_TRY(writeMCMCFile(writeMCMCCheckpoint, snap, resumeFileName), retcode);
+        if(retcode!=XLAL_SUCCESS)
+        {
+            saveattempts+=1;
+            fprintf(stderr,"Failed to write checkpoint file %s at attempt %i, waiting to retry\n",
+                    resumeFileName, saveattempts);
+            sleep(retrydelay*saveattempts); /* In case of IO failure wait progressively longer */
+        }
+    } while (retcode!=XLAL_SUCCESS && saveattempts<10);
+    if(retcode!=XLAL_SUCCESS) {fprintf(stderr,"Failed to checkpoint\n");}
+    saveattempts=0;
+    do
     {
-        LALInferenceH5VariablesArrayToDataset(group, &injParams, 1, "injection_params");
-        LALInferenceClearVariables(injParams);
-        XLALFree(injParams);
+        XLAL_TRY(writeMCMCFile(writeMCMCSamples, snap, outFileName), retcode);
+        if(retcode!=XLAL_SUCCESS)
+        {
+            saveattempts+=1;
+            fprintf(stderr,"Failed to write samples file %s at attempt %i, waiting to retry\n",
+                    outFileName, saveattempts);
+            sleep(retrydelay*saveattempts); /* In case of IO failure wait progressively longer */
+        }
+    } while (retcode!=XLAL_SUCCESS && saveattempts<10);
+    if(retcode!=XLAL_SUCCESS) {fprintf(stderr,"Failed to checkpoint\n");}
+}
+
+#if defined(LAL_PTHREAD_LOCK)
+
+/*
+ * The writer thread takes snapshots from a single pending slot.  A snapshot
+ * queued while the previous one is still pending replaces it, so the writer
+ * never falls more than one checkpoint behind, and at most two snapshots
+ * (one pending, one being written) exist at any time.
+ */
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    pthread_t thread;
+    int started;
+    int busy;
+    MCMCSnapshot *pending;
+    char *resumeFileName;
+    char *outFileName;
+} checkpoint_writer = { .lock = PTHREAD_MUTEX_INITIALIZER, .cond = PTHREAD_COND_INITIALIZER };
+
+static void *checkpointWriterThread(void UNUSED *arg) {
+    MCMCSnapshot *snap;
+
+    for (;;) {
+        pthread_mutex_lock(&checkpoint_writer.lock);
+        while (!checkpoint_writer.pending)
+            pthread_cond_wait(&checkpoint_writer.cond, &checkpoint_writer.lock);
+        snap = checkpoint_writer.pending;
+        checkpoint_writer.pending = NULL;
+        checkpoint_writer.busy = 1;
+        pthread_mutex_unlock(&checkpoint_writer.lock);
+
+        writeMCMCSnapshot(snap, checkpoint_writer.resumeFileName, checkpoint_writer.outFileName);
+        destroyMCMCSnapshot(snap);
+
+        pthread_mutex_lock(&checkpoint_writer.lock);
+        checkpoint_writer.busy = 0;
+        pthread_cond_broadcast(&checkpoint_writer.cond);
+        pthread_mutex_unlock(&checkpoint_writer.lock);
     }
 
-    n_local_threads = runState->nthreads;
-    for (t = 0; t < n_local_threads; t++) {
-        thread = &runState->threads[t];
+    return NULL;
+}
 
-        LALInferenceVariables **output_array=NULL;
-        UINT4 N_output_array=0;
-        if(LALInferenceCheckVariable(thread->algorithmParams, "outputarray")
-                && LALInferenceCheckVariable(thread->algorithmParams, "N_outputarray") ) {
-            output_array=*(LALInferenceVariables ***)LALInferenceGetVariable(thread->algorithmParams,"outputarray");
-            N_output_array=*(UINT4 *)LALInferenceGetVariable(thread->algorithmParams,"N_outputarray");
+static void queueMCMCCheckpoint(LALInferenceRunState *runState) {
+    MCMCSnapshot *snap = createMCMCSnapshot(runState);
+    if (!snap) {
+        fprintf(stderr,"Failed to snapshot run state for checkpoint\n");
+        return;
+    }
 
-            /* Create run identifier group */
-            LALInferenceH5VariablesArrayToDataset(group, output_array, N_output_array, thread->name);
+    pthread_mutex_lock(&checkpoint_writer.lock);
+    if (!checkpoint_writer.started) {
+        checkpoint_writer.resumeFileName = runState->resumeOutFileName;
+        checkpoint_writer.outFileName = runState->outFileName;
+        if (pthread_create(&checkpoint_writer.thread, NULL, checkpointWriterThread, NULL) == 0) {
+            pthread_detach(checkpoint_writer.thread);
+            checkpoint_writer.started = 1;
         }
     }
-    char *cl=NULL;
-    cl=LALInferencePrintCommandLine(runState->commandLine);
-    XLALH5FileAddStringAttribute(group,"CommandLine",cl);
-    XLALH5FileClose(group);
-    XLALH5FileClose(output);
-    LALInferencePrintCheckpointFileInfo(runState->outFileName);
+    if (!checkpoint_writer.started) {
+        /* No writer thread: write in the foreground */
+        pthread_mutex_unlock(&checkpoint_writer.lock);
+        writeMCMCSnapshot(snap, runState->resumeOutFileName, runState->outFileName);
+        destroyMCMCSnapshot(snap);
+        return;
+    }
+    destroyMCMCSnapshot(checkpoint_writer.pending);
+    checkpoint_writer.pending = snap;
+    pthread_cond_broadcast(&checkpoint_writer.cond);
+    pthread_mutex_unlock(&checkpoint_writer.lock);
+}
+
+/* Wait until all queued checkpoints have been written */
+static void flushMCMCCheckpoint(void) {
+    pthread_mutex_lock(&checkpoint_writer.lock);
+    while (checkpoint_writer.pending || checkpoint_writer.busy)
+        pthread_cond_wait(&checkpoint_writer.cond, &checkpoint_writer.lock);
+    pthread_mutex_unlock(&checkpoint_writer.lock);
+}
+
+#else /* !defined(LAL_PTHREAD_LOCK) */
+
+static void queueMCMCCheckpoint(LALInferenceRunState *runState) {
+    MCMCSnapshot *snap = createMCMCSnapshot(runState);
+    if (!snap) {
+        fprintf(stderr,"Failed to snapshot run state for checkpoint\n");
+        return;
+    }
+    writeMCMCSnapshot(snap, runState->resumeOutFileName, runState->outFileName);
+    destroyMCMCSnapshot(snap);
+}
+
+static void flushMCMCCheckpoint(void) {
     return;
 }
 
+#endif /* defined(LAL_PTHREAD_LOCK) */
+
 
 void LALInferencePrintPTMCMCHeaderFile(LALInferenceRunState *runState, LALInferenceThreadState *thread, FILE *threadoutput) {
     INT4 MPIrank, nthreads;
@@ -1971,7 +2255,7 @@ void LALInferencePrintAdaptationSettings(FILE *outfile, LALInferenceThreadState
 void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model) {
     char filename[FILENAME_MAX];
     FILE *out;
-    UINT4 ui;
+    UINT4 ui, ifo;
 
     snprintf(filename, sizeof(filename), "freqTemplatehPlus.dat");
     out = fopen(filename, "w");
@@ -1993,14 +2277,14 @@ void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model) {
     }
     fclose(out);
 
-    while (data != NULL) {
+    for (ifo = 0; data != NULL; ifo++) {
         snprintf(filename, sizeof(filename), "%s-freqTemplateStrain.dat", data->name);
         out = fopen(filename, "w");
         for (ui = 0; ui < model->freqhCross->data->length; ui++) {
             REAL8 f = model->freqhCross->deltaF * ui;
             COMPLEX16 d;
-            d = data->fPlus * model->freqhPlus->data->data[ui] +
-            data->fCross * model->freqhCross->data->data[ui];
+            d = model->ifo_fPlus[ifo] * model->freqhPlus->data->data[ui] +
+            model->ifo_fCross[ifo] * model->freqhCross->data->data[ui];
 
             fprintf(out, "%g %g %g\n", f, creal(d), cimag(d) );
         }
@@ -2010,9 +2294,9 @@ void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model) {
         out = fopen(filename, "w");
         for (ui = 0; ui < model->timehCross->data->length; ui++) {
             REAL8 tt = XLALGPSGetREAL8(&(model->timehCross->epoch)) +
-            data->timeshift + ui*model->timehCross->deltaT;
-            REAL8 d = data->fPlus*model->timehPlus->data->data[ui] +
-            data->fCross*model->timehCross->data->data[ui];
+            model->ifo_timeshifts[ifo] + ui*model->timehCross->deltaT;
+            REAL8 d = model->ifo_fPlus[ifo]*model->timehPlus->data->data[ui] +
+            model->ifo_fCross[ifo]*model->timehCross->data->data[ui];
 
             fprintf(out, "%.6f %g\n", tt, d);
         }
@@ -26,6 +26,8 @@
 #include <stdlib.h>
 #include <math.h>
 #include <lal/LALInference.h>
+#include <lal/LALInferenceLikelihood.h>
+#include <lal/LALInferenceMultibanding.h>
 #include <lal/Units.h>
 #include <lal/FrequencySeries.h>
 #include <lal/Sequence.h>
@@ -146,6 +148,38 @@ LALInferenceThreadState *LALInferenceInitThreads(INT4 nthreads) {
     return threads;
 }
 
+const LALInferenceVariablesSchema *LALInferenceGetThreadSchema(LALInferenceThreadState *thread, const LALInferenceVariables *params) {
+    if (!thread || !params)
+        XLAL_ERROR_NULL(XLAL_EFAULT);
+
+    if (!thread->schema || !LALInferenceVariablesMatchSchema(thread->schema, params)) {
+        LALInferenceClearDifferentialColumns(thread);
+        LALInferenceDestroyVariablesSchema(thread->schema);
+        thread->schema = LALInferenceCreateVariablesSchema(params);
+        if (!thread->schema)
+            XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+
+    return thread->schema;
+}
+
+void LALInferenceClearThreadBuffers(LALInferenceThreadState *thread) {
+    if (!thread)
+        return;
+
+    LALInferenceClearDifferentialColumns(thread);
+    LALInferenceDestroyVariablesSchema(thread->schema);
+    thread->schema = NULL;
+    if (thread->differentialPointsArray)
+        LALInferenceClearDifferentialPoints(thread);
+    if (thread->model) {
+        LALInferenceDestroyExtrinsicCache(thread->model->extrinsicCache);
+        thread->model->extrinsicCache = NULL;
+        LALInferenceDestroyMultibandModel(thread->model->multiband);
+        thread->model->multiband = NULL;
+    }
+}
+
 
 /* ============ Accessor functions for the Variable structure: ========== */
 
@@ -555,6 +589,60 @@ void LALInferenceClearVariables(LALInferenceVariables *vars)
   return;
 }
 
+/* Returns 1 if the items of "target" have the same names and types, in the
+ * same order, as those of "origin" */
+static int LALInferenceVariablesLayoutMatch(const LALInferenceVariables *origin, const LALInferenceVariables *target)
+{
+  const LALInferenceVariableItem *a, *b;
+  if (origin->dimension != target->dimension) return 0;
+  for (a = origin->head, b = target->head; a && b; a = a->next, b = b->next)
+    if (a->type != b->type || strcmp(a->name, b->name)) return 0;
+  return (a == NULL && b == NULL);
+}
+
+/* Copy the value of "origin" into the existing item "target" of the same
+ * name and type, reusing the memory of vectors and matrices of equal size */
+static void LALInferenceCopyItemValue(const LALInferenceVariableItem *origin, LALInferenceVariableItem *target)
+{
+  target->vary = origin->vary;
+  switch (origin->type)
+  {
+    case LALINFERENCE_gslMatrix_t:
+    {
+      gsl_matrix *old=*(gsl_matrix **)origin->value;
+      gsl_matrix **new=(gsl_matrix **)target->value;
+      if ((*new)->size1 != old->size1 || (*new)->size2 != old->size2) {
+        gsl_matrix_free(*new);
+        *new=gsl_matrix_alloc(old->size1,old->size2);
+        if(!*new) XLAL_ERROR_VOID(XLAL_ENOMEM,"Unable to create %zux%zu matrix\n",old->size1,old->size2);
+      }
+      gsl_matrix_memcpy(*new,old);
+      break;
+    }
+#define COPY_VECTOR_VALUE(TYPE)                                           \
+    case LALINFERENCE_##TYPE##_t:                                         \
+    {                                                                     \
+      TYPE *old=*(TYPE **)origin->value;                                  \
+      TYPE **new=(TYPE **)target->value;                                  \
+      if ((*new)->length != old->length) {                                \
+        XLALDestroy##TYPE(*new);                                          \
+        *new=XLALCreate##TYPE(old->length);                               \
+        if(!*new) XLAL_ERROR_VOID(XLAL_ENOMEM,"Unable to copy vector!\n"); \
+      }                                                                   \
+      memcpy((*new)->data,old->data,old->length*sizeof(old->data[0]));    \
+      break;                                                              \
+    }
+    COPY_VECTOR_VALUE(INT4Vector)
+    COPY_VECTOR_VALUE(UINT4Vector)
+    COPY_VECTOR_VALUE(REAL8Vector)
+    COPY_VECTOR_VALUE(COMPLEX16Vector)
+#undef COPY_VECTOR_VALUE
+    default:
+      memcpy(target->value,origin->value,LALInferenceTypeSize[origin->type]);
+      break;
+  }
+}
+
 void LALInferenceCopyVariables(LALInferenceVariables *origin, LALInferenceVariables *target)
 /*  copy contents of "origin" over to "target"  */
 {
@@ -572,18 +660,39 @@ void LALInferenceCopyVariables(LALInferenceVariables *origin, LALInferenceVariab
   /* Make sure the structure is initialised */
   if(!target) XLAL_ERROR_VOID(XLAL_EFAULT, "Unable to copy to uninitialised LALInferenceVariables structure.");
 
+  /* If the target has the same layout, e.g. when copying between the
+     current and proposed parameters, copy the values in place */
+  if (target->dimension > 0 && LALInferenceVariablesLayoutMatch(origin, target)) {
+    LALInferenceVariableItem *tptr;
+    for (ptr = origin->head, tptr = target->head; ptr; ptr = ptr->next, tptr = tptr->next) {
+      if(!ptr->value || !tptr->value){
+        XLAL_ERROR_VOID(XLAL_EFAULT, "Badly formed LALInferenceVariableItem structure!");
+      }
+      LALInferenceCopyItemValue(ptr, tptr);
+    }
+    return;
+  }
+
   /* First clear the target */
   LALInferenceClearVariables(target);
 
   /* Now add the variables in reverse order, to preserve the
    * ordering */
   dims = LALInferenceGetVariableDimension( origin );
+  if (dims == 0) return;
+
+  /* collect the elements of "origin" in a single pass over the list */
+  LALInferenceVariableItem *items[dims];
+  for ( i = 0, ptr = origin->head; ptr && i < dims; ptr = ptr->next, i++ )
+    items[i] = ptr;
+  for ( ; i < dims; i++ )
+    items[i] = NULL;
 
   /* then copy over elements of "origin" - due to how elements are added by
      LALInferenceAddVariable this has to be done in reverse order to preserve
      the ordering of "origin"  */
   for ( i = dims; i > 0; i-- ){
-    ptr = LALInferenceGetItemNr(origin, i);
+    ptr = items[i-1];
 
     if(!ptr)
     {
@@ -655,6 +764,117 @@ void LALInferenceCopyVariables(LALInferenceVariables *origin, LALInferenceVariab
   return;
 }
 
+/* Sampling parameters are the REAL8 items which are varied */
+static int LALInferenceIsSamplingItem(const LALInferenceVariableItem *item)
+{
+  return item->type == LALINFERENCE_REAL8_t &&
+    (item->vary == LALINFERENCE_PARAM_LINEAR || item->vary == LALINFERENCE_PARAM_CIRCULAR);
+}
+
+LALInferenceVariablesSchema *LALInferenceCreateVariablesSchema(const LALInferenceVariables *vars)
+{
+  const LALInferenceVariableItem *ptr;
+
+  if (!vars)
+    XLAL_ERROR_NULL(XLAL_EFAULT);
+
+  LALInferenceVariablesSchema *schema = XLALCalloc(1, sizeof(*schema));
+  if (!schema)
+    XLAL_ERROR_NULL(XLAL_ENOMEM);
+
+  for (ptr = vars->head; ptr; ptr = ptr->next) {
+    if (LALInferenceIsSamplingItem(ptr)) {
+      schema->names = XLALAppendString2Vector(schema->names, ptr->name);
+      if (!schema->names) {
+        LALInferenceDestroyVariablesSchema(schema);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+      }
+      schema->length++;
+    }
+  }
+
+  return schema;
+}
+
+void LALInferenceDestroyVariablesSchema(LALInferenceVariablesSchema *schema)
+{
+  if (!schema)
+    return;
+  XLALDestroyStringVector(schema->names);
+  XLALFree(schema);
+}
+
+int LALInferenceVariablesMatchSchema(const LALInferenceVariablesSchema *schema, const LALInferenceVariables *vars)
+{
+  const LALInferenceVariableItem *ptr;
+  UINT4 j = 0;
+
+  if (!schema || !vars)
+    return 0;
+
+  for (ptr = vars->head; ptr; ptr = ptr->next) {
+    if (LALInferenceIsSamplingItem(ptr)) {
+      if (j >= schema->length || strcmp(ptr->name, schema->names->data[j]))
+        return 0;
+      j++;
+    }
+  }
+
+  return (j == schema->length);
+}
+
+INT4 LALInferenceVariablesSchemaIndex(const LALInferenceVariablesSchema *schema, const char *name)
+{
+  UINT4 j;
+
+  if (!schema || !name)
+    XLAL_ERROR(XLAL_EFAULT);
+
+  for (j = 0; j < schema->length; j++)
+    if (!strcmp(schema->names->data[j], name))
+      return (INT4)j;
+
+  return -1;
+}
+
+/* The sampling parameters appear in the list in the order of the schema, so
+ * packing and unpacking walk the list once without looking up any names */
+int LALInferencePackVariables(REAL8 *array, const LALInferenceVariablesSchema *schema, const LALInferenceVariables *vars)
+{
+  const LALInferenceVariableItem *ptr;
+  UINT4 j = 0;
+
+  XLAL_CHECK(array != NULL && schema != NULL && vars != NULL, XLAL_EFAULT);
+
+  for (ptr = vars->head; ptr; ptr = ptr->next) {
+    if (LALInferenceIsSamplingItem(ptr)) {
+      XLAL_CHECK(j < schema->length, XLAL_EINVAL, "Variables do not match schema");
+      array[j++] = *(REAL8 *)ptr->value;
+    }
+  }
+  XLAL_CHECK(j == schema->length, XLAL_EINVAL, "Variables do not match schema");
+
+  return XLAL_SUCCESS;
+}
+
+int LALInferenceUnpackVariables(LALInferenceVariables *vars, const LALInferenceVariablesSchema *schema, const REAL8 *array)
+{
+  LALInferenceVariableItem *ptr;
+  UINT4 j = 0;
+
+  XLAL_CHECK(array != NULL && schema != NULL && vars != NULL, XLAL_EFAULT);
+
+  for (ptr = vars->head; ptr; ptr = ptr->next) {
+    if (LALInferenceIsSamplingItem(ptr)) {
+      XLAL_CHECK(j < schema->length, XLAL_EINVAL, "Variables do not match schema");
+      *(REAL8 *)ptr->value = array[j++];
+    }
+  }
+  XLAL_CHECK(j == schema->length, XLAL_EINVAL, "Variables do not match schema");
+
+  return XLAL_SUCCESS;
+}
+
 
 void LALInferenceCopyUnsetREAL8Variables(LALInferenceVariables *origin, LALInferenceVariables *target, ProcessParamsTable *commandLine) {
 /*  Copy REAL8s from "origin" to "target" if they weren't set on the command line */
@@ -1594,6 +1814,13 @@ INT4 LALInferenceThinnedBufferToArray(LALInferenceThreadState *thread, REAL8** D
     INT4 i=0, p=0;
 
     INT4 nPoints = thread->differentialPointsLength;
+    if (thread->differentialPointsArray) {
+        UINT4 nPar = thread->differentialPointsSchema->length;
+        for (i = 0; i < nPoints; i+=step)
+            memcpy(DEarray[i/step], thread->differentialPointsArray + i*nPar, nPar*sizeof(REAL8));
+        return nPoints/step;
+    }
+
     for (i = 0; i < nPoints; i+=step) {
         ptr=thread->differentialPoints[i]->head;
         p=0;
@@ -1617,6 +1844,118 @@ INT4 LALInferenceBufferToArray(LALInferenceThreadState *thread, REAL8** DEarray)
 }
 
 
+int LALInferenceAppendDifferentialPoint(LALInferenceThreadState *thread, const LALInferenceVariables *params) {
+    XLAL_CHECK(thread != NULL && params != NULL, XLAL_EFAULT);
+
+    if (!thread->differentialPointsArray) {
+        XLAL_CHECK(thread->differentialPointsLength == 0, XLAL_EINVAL, "Differential points are already stored as variables");
+
+        LALInferenceClearDifferentialColumns(thread);
+        LALInferenceDestroyVariablesSchema(thread->differentialPointsSchema);
+        thread->differentialPointsSchema = LALInferenceCreateVariablesSchema(params);
+        XLAL_CHECK(thread->differentialPointsSchema != NULL, XLAL_EFUNC);
+        XLAL_CHECK(thread->differentialPointsSchema->length > 0, XLAL_EINVAL, "No varying parameters to store");
+
+        if (thread->differentialPointsSize < 1)
+            thread->differentialPointsSize = 1;
+        thread->differentialPointsArray = XLALMalloc(thread->differentialPointsSize * thread->differentialPointsSchema->length * sizeof(REAL8));
+        XLAL_CHECK(thread->differentialPointsArray != NULL, XLAL_ENOMEM);
+    } else if (thread->differentialPointsLength == thread->differentialPointsSize) {
+        size_t newSize = 2*thread->differentialPointsSize;
+        REAL8 *newArray = XLALRealloc(thread->differentialPointsArray, newSize * thread->differentialPointsSchema->length * sizeof(REAL8));
+        XLAL_CHECK(newArray != NULL, XLAL_ENOMEM);
+        thread->differentialPointsArray = newArray;
+        thread->differentialPointsSize = newSize;
+    }
+
+    REAL8 *row = thread->differentialPointsArray + thread->differentialPointsLength * thread->differentialPointsSchema->length;
+    XLAL_CHECK(LALInferencePackVariables(row, thread->differentialPointsSchema, params) == XLAL_SUCCESS, XLAL_EFUNC);
+    thread->differentialPointsLength += 1;
+
+    return XLAL_SUCCESS;
+}
+
+
+/* Keep the odd-index points, so the most recent point is retained */
+void LALInferenceThinDifferentialPoints(LALInferenceThreadState *thread) {
+    size_t i;
+
+    if (!thread->differentialPointsArray)
+        XLAL_ERROR_VOID(XLAL_EINVAL, "Differential points are not packed");
+
+    const UINT4 nPar = thread->differentialPointsSchema->length;
+    REAL8 *array = thread->differentialPointsArray;
+    for (i = 1; i < thread->differentialPointsLength; i += 2)
+        memmove(array + (i/2)*nPar, array + i*nPar, nPar*sizeof(REAL8));
+
+    thread->differentialPointsLength /= 2;
+    thread->differentialPointsSkip *= 2;
+}
+
+
+void LALInferenceClearDifferentialPoints(LALInferenceThreadState *thread) {
+    if (!thread)
+        return;
+
+    LALInferenceClearDifferentialColumns(thread);
+    XLALFree(thread->differentialPointsArray);
+    thread->differentialPointsArray = NULL;
+    LALInferenceDestroyVariablesSchema(thread->differentialPointsSchema);
+    thread->differentialPointsSchema = NULL;
+    thread->differentialPointsLength = 0;
+    thread->differentialPointsSize = 1;
+}
+
+
+const LALInferenceVariablesSchema *LALInferenceGetDifferentialPointsSchema(LALInferenceThreadState *thread) {
+    if (!thread || thread->differentialPointsLength == 0)
+        return NULL;
+
+    if (!thread->differentialPointsArray && !thread->differentialPointsSchema) {
+        if (!thread->differentialPoints || !thread->differentialPoints[0])
+            return NULL;
+        LALInferenceClearDifferentialColumns(thread);
+        thread->differentialPointsSchema = LALInferenceCreateVariablesSchema(thread->differentialPoints[0]);
+        if (!thread->differentialPointsSchema)
+            XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+
+    return thread->differentialPointsSchema;
+}
+
+
+void LALInferenceClearDifferentialColumns(LALInferenceThreadState *thread) {
+    LALInferenceDifferentialColumns *map;
+
+    if (!thread)
+        return;
+
+    while ((map = thread->differentialColumns) != NULL) {
+        thread->differentialColumns = map->next;
+        XLALDestroyStringVector(map->names);
+        XLALFree(map->cols);
+        XLALFree(map->params);
+        XLALFree(map);
+    }
+}
+
+
+const REAL8 *LALInferenceGetDifferentialPoint(LALInferenceThreadState *thread, size_t i, REAL8 *row) {
+    const LALInferenceVariablesSchema *schema = LALInferenceGetDifferentialPointsSchema(thread);
+
+    if (!schema || i >= thread->differentialPointsLength)
+        XLAL_ERROR_NULL(XLAL_EINVAL);
+
+    if (thread->differentialPointsArray)
+        return thread->differentialPointsArray + i*schema->length;
+
+    if (LALInferencePackVariables(row, schema, thread->differentialPoints[i]) != XLAL_SUCCESS)
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+
+    return row;
+}
+
+
 void LALInferenceCopyVariablesToArray(LALInferenceVariables *origin, REAL8 *target) {
   gsl_matrix *m = NULL; //for dealing with noise parameters
   REAL8Vector *v8 = NULL;
@@ -4324,37 +4663,32 @@ int LALInferenceSplineCalibrationFactor(REAL8Vector *logfreqs,
   }
 }
 
-int LALInferenceSplineCalibrationFactorROQ(REAL8Vector *logfreqs,
+int LALInferenceSplineCalibrationFactorNodes(REAL8Vector *logfreqs,
 					REAL8Vector *deltaAmps,
 					REAL8Vector *deltaPhases,
-					REAL8Sequence *freqNodesLin,
-					COMPLEX16Sequence **calFactorROQLin,
-					REAL8Sequence *freqNodesQuad,
-					COMPLEX16Sequence **calFactorROQQuad) {
+					REAL8Sequence *freqNodes,
+					COMPLEX16Sequence *calFactor) {
 
   gsl_interp_accel *ampAcc = NULL, *phaseAcc = NULL;
   gsl_interp *ampInterp = NULL, *phaseInterp = NULL;
- 
+
   int status = XLAL_SUCCESS;
   const char *fmt = "";
 
   size_t N = 0;
-  
-  /* should I check that calFactorROQ = NULL as well? */
 
-  if (logfreqs == NULL || deltaAmps == NULL || deltaPhases == NULL || freqNodesLin == NULL || freqNodesQuad == NULL) {
+  if (logfreqs == NULL || deltaAmps == NULL || deltaPhases == NULL || freqNodes == NULL || calFactor == NULL) {
     status = XLAL_EINVAL;
     fmt = "bad input";
     goto cleanup;
   }
 
-  if (logfreqs->length != deltaAmps->length || deltaAmps->length != deltaPhases->length || freqNodesLin->length != (*calFactorROQLin)->length || freqNodesQuad->length != (*calFactorROQQuad)->length) {
+  if (logfreqs->length != deltaAmps->length || deltaAmps->length != deltaPhases->length || freqNodes->length != calFactor->length) {
     status = XLAL_EINVAL;
     fmt = "input lengths differ";
     goto cleanup;
   }
-  
-  
+
   N = logfreqs->length;
 
   ampInterp = gsl_interp_alloc(gsl_interp_cspline, N);
@@ -4381,22 +4715,9 @@ int LALInferenceSplineCalibrationFactorROQ(REAL8Vector *logfreqs,
   REAL8 lowf = exp(logfreqs->data[0]);
   REAL8 highf = exp(logfreqs->data[N-1]);
   REAL8 dA = 0.0, dPhi = 0.0;
-  
-  for (unsigned int i = 0; i < freqNodesLin->length; i++) {
-    REAL8 f = freqNodesLin->data[i];
-    if (f < lowf || f > highf) {
-      dA = 0.0;
-      dPhi = 0.0;
-    } else {
-      dA = gsl_interp_eval(ampInterp, logfreqs->data, deltaAmps->data, log(f), ampAcc);
-      dPhi = gsl_interp_eval(phaseInterp, logfreqs->data, deltaPhases->data, log(f), phaseAcc);
-    }
-    
-    (*calFactorROQLin)->data[i] = (1.0 + dA)*(2.0 + I*dPhi)/(2.0 - I*dPhi);
-  }
-  
-  for (unsigned int j = 0; j < freqNodesQuad->length; j++) {
-    REAL8 f = freqNodesQuad->data[j];
+
+  for (unsigned int i = 0; i < freqNodes->length; i++) {
+    REAL8 f = freqNodes->data[i];
     if (f < lowf || f > highf) {
       dA = 0.0;
       dPhi = 0.0;
@@ -4405,8 +4726,7 @@ int LALInferenceSplineCalibrationFactorROQ(REAL8Vector *logfreqs,
       dPhi = gsl_interp_eval(phaseInterp, logfreqs->data, deltaPhases->data, log(f), phaseAcc);
     }
 
-    (*calFactorROQQuad)->data[j] = (1.0 + dA)*(2.0 + I*dPhi)/(2.0 - I*dPhi);
-
+    calFactor->data[i] = (1.0 + dA)*(2.0 + I*dPhi)/(2.0 - I*dPhi);
   }
 
  cleanup:
@@ -4422,6 +4742,26 @@ int LALInferenceSplineCalibrationFactorROQ(REAL8Vector *logfreqs,
   }
 }
 
+int LALInferenceSplineCalibrationFactorROQ(REAL8Vector *logfreqs,
+					REAL8Vector *deltaAmps,
+					REAL8Vector *deltaPhases,
+					REAL8Sequence *freqNodesLin,
+					COMPLEX16Sequence **calFactorROQLin,
+					REAL8Sequence *freqNodesQuad,
+					COMPLEX16Sequence **calFactorROQQuad) {
+
+  if (calFactorROQLin == NULL || calFactorROQQuad == NULL) {
+    XLAL_ERROR(XLAL_EINVAL, "bad input");
+  }
+
+  if (LALInferenceSplineCalibrationFactorNodes(logfreqs, deltaAmps, deltaPhases, freqNodesLin, *calFactorROQLin) != XLAL_SUCCESS
+      || LALInferenceSplineCalibrationFactorNodes(logfreqs, deltaAmps, deltaPhases, freqNodesQuad, *calFactorROQQuad) != XLAL_SUCCESS) {
+    XLAL_ERROR(XLAL_EFUNC);
+  }
+
+  return XLAL_SUCCESS;
+}
+
 void LALInferenceFprintSplineCalibrationHeader(FILE *output, LALInferenceThreadState *thread) {
     INT4 i, nifo;
     char **ifo_names = NULL;
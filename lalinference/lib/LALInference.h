@@ -179,6 +179,38 @@ tagLALInferenceVariables
   LALHashTbl        *hash_table;
 } LALInferenceVariables;
 
+/**
+ * A compiled layout of the sampling parameters of a LALInferenceVariables
+ * structure, i.e. its REAL8 items of vary type LINEAR or CIRCULAR, in list order.
+ * The names are resolved once when the schema is created, after which a set of
+ * parameters with the same layout can be packed to and unpacked from a plain
+ * REAL8 array.  The variables remain the primary storage; the packed form is
+ * used by the single-parameter, covariance eigenvector, differential evolution
+ * and ensemble proposals, and by the differential evolution buffer.
+ */
+typedef struct
+tagLALInferenceVariablesSchema
+{
+  UINT4 length;                 /** Number of packed parameters */
+  LALStringVector *names;       /** Names of the packed parameters, in list order */
+} LALInferenceVariablesSchema;
+
+/**
+ * Map from the columns of the differential evolution buffer to the sampling
+ * parameters of a thread, for one list of parameter names.  The differential
+ * evolution and ensemble proposals build it once per thread and reuse it until
+ * either parameter set changes.
+ */
+typedef struct
+tagLALInferenceDifferentialColumns
+{
+  LALStringVector *names;       /** Names the map was built for, or NULL for every column */
+  UINT4 length;                 /** Number of columns in the map */
+  UINT4 *cols;                  /** Columns of the differential evolution buffer */
+  UINT4 *params;                /** Matching indices in the thread schema */
+  struct tagLALInferenceDifferentialColumns *next; /** Map for another list of names */
+} LALInferenceDifferentialColumns;
+
 /**
  * Phase of MCMC run (depending on burn-in status, different actions
  * are performed during the run, and this tag controls the activity).
@@ -314,9 +346,37 @@ int LALInferenceCheckVariableToPrint(LALInferenceVariables *vars, const char *na
  */
 void LALInferenceClearVariables(LALInferenceVariables *vars);
 
-/** Deep copy the variables from one to another LALInferenceVariables structure */
+/**
+ * Deep copy the variables from one to another LALInferenceVariables structure.
+ * If \c target already holds items with the same names and types, in the same
+ * order, as \c origin, the values are copied in place without reallocating.
+ */
 void LALInferenceCopyVariables(LALInferenceVariables *origin, LALInferenceVariables *target);
 
+/** Create the schema of the sampling parameters of \c vars */
+LALInferenceVariablesSchema *LALInferenceCreateVariablesSchema(const LALInferenceVariables *vars);
+
+/** Destroy a schema created by LALInferenceCreateVariablesSchema() */
+void LALInferenceDestroyVariablesSchema(LALInferenceVariablesSchema *schema);
+
+/** Returns 1 if the sampling parameters of \c vars are those of \c schema, in the same order, and 0 otherwise */
+int LALInferenceVariablesMatchSchema(const LALInferenceVariablesSchema *schema, const LALInferenceVariables *vars);
+
+/** Returns the index of parameter \c name in \c schema, or -1 if it is not present */
+INT4 LALInferenceVariablesSchemaIndex(const LALInferenceVariablesSchema *schema, const char *name);
+
+/**
+ * Copy the sampling parameters of \c vars, which must match \c schema, to the
+ * \c schema->length elements of \c array
+ */
+int LALInferencePackVariables(REAL8 *array, const LALInferenceVariablesSchema *schema, const LALInferenceVariables *vars);
+
+/**
+ * Copy the \c schema->length elements of \c array to the sampling parameters
+ * of \c vars, which must match \c schema
+ */
+int LALInferenceUnpackVariables(LALInferenceVariables *vars, const LALInferenceVariablesSchema *schema, const REAL8 *array);
+
 /*  Copy REAL8s from "origin" to "target" if they weren't set on the command line */
 void LALInferenceCopyUnsetREAL8Variables(LALInferenceVariables *origin, LALInferenceVariables *target, ProcessParamsTable *commandLine);
 
@@ -359,6 +419,17 @@ int LALInferenceSplineCalibrationFactor(REAL8Vector *freqs,
 					REAL8Vector *deltaPhases,
 					COMPLEX16FrequencySeries *calFactor);
 
+ /** Modified version of LALInferenceSplineCalibrationFactor to compute the
+ *	calibration factors at an arbitrary set of frequency nodes, such as the
+ *	frequencies of a multibanded template.
+ */
+
+int LALInferenceSplineCalibrationFactorNodes(REAL8Vector *logfreqs,
+					REAL8Vector *deltaAmps,
+					REAL8Vector *deltaPhases,
+					REAL8Sequence *freqNodes,
+					COMPLEX16Sequence *calFactor);
+
  /** Modified version of LALInferenceSplineCalibrationFactor to compute the 
  *	calibration factors for the specific frequency nodes used for 
  *	Reduced Order Quadrature likelihoods.
@@ -453,6 +524,9 @@ typedef struct tagLALInferenceModel
   REAL8                        SNR; /** Network SNR at *params* */
   REAL8*                       ifo_loglikelihoods; /** Array of single-IFO likelihoods at *params* */
   REAL8*                       ifo_SNRs; /** Array of single-IFO SNRs at *params* */
+  REAL8*                       ifo_fPlus; /** Array of single-IFO plus polarisation responses at *params* */
+  REAL8*                       ifo_fCross; /** Array of single-IFO cross polarisation responses at *params* */
+  REAL8*                       ifo_timeshifts; /** Array of single-IFO template time shifts at *params* */
 
   REAL8                        fLow;   /** Start frequency for waveform generation */
   REAL8                        fHigh;   /** End frequency for waveform generation */
@@ -471,6 +545,8 @@ typedef struct tagLALInferenceModel
   REAL8                        padding; /** The padding of the above window */
   struct tagLALInferenceROQModel *roq; /** ROQ data */
   int roq_flag;               /** Is ROQ enabled */
+  struct tagLALInferenceExtrinsicCache *extrinsicCache; /** Cached inner products for extrinsic-only likelihood evaluations */
+  struct tagLALInferenceMultibandModel *multiband; /** Frequency bands and template of the multibanded likelihood, NULL if disabled */
   LALSimNeutronStarFamily     *eos_fam; /** Neutron Star equation of state family */
 
 } LALInferenceModel;
@@ -574,6 +650,12 @@ tagLALInferenceThreadState
                                         Can also be removed. */
     size_t differentialPointsSkip; /** When the DE buffer gets too long, start storing
                                        only every n-th output point; this counter stores n */
+    REAL8 *differentialPointsArray; /** Differential points packed row-major, one row of
+                                        differentialPointsSchema->length values per point.
+                                        When set, this is used instead of differentialPoints,
+                                        and differentialPointsSize counts its rows */
+    LALInferenceVariablesSchema *differentialPointsSchema; /** Parameters stored in each row of
+                                                               the differential points */
     REAL8 *currentIFOSNRs; /** Array storing single-IFO SNRs of current sample */
     REAL8 *currentIFOLikelihoods; /** Array storing single-IFO likelihoods of current sample */
     REAL8 currentSNR; /** Array storing network SNR of current sample */
@@ -588,6 +670,9 @@ tagLALInferenceThreadState
     INT4 *temp_swap_accepts;
     INT4 temp_swap_window;
     INT4 temp_swap_counter;
+    LALInferenceVariablesSchema *schema; /** Layout of the sampling parameters; use LALInferenceGetThreadSchema() */
+    LALInferenceDifferentialColumns *differentialColumns; /** Cached column maps of the differential
+                                                              evolution and ensemble proposals */
 } LALInferenceThreadState;
 
 
@@ -643,8 +728,8 @@ tagLALInferenceIFOData
      that value is copied into acceptedloglikelihood, which is the
      quantity that is actually output in the output files. */
   REAL8                      nullloglikelihood;
-  REAL8                      fPlus, fCross; /** Detector responses */
-  REAL8                      timeshift;     /** What is this? */
+  REAL8                      fPlus, fCross; /** Detector responses to the injection; see LALInferenceModel for those of a template */
+  REAL8                      timeshift;     /** Time shift of the injection; see LALInferenceModel for that of a template */
   COMPLEX16FrequencySeries  *freqData,      /** Buffer for frequency domain data */
                             *whiteFreqData; /* Over-white. */
   COMPLEX16TimeSeries       *compTimeData;  /** Complex time series data buffers */
@@ -665,6 +750,7 @@ tagLALInferenceIFOData
   UINT4                     likeli_counter; /** counts how many time the likelihood has been calculated */
   UINT4                     templa_counter; /** counts how many time the template has been calculated */
   struct tagLALInferenceROQData *roq; /** ROQ data */
+  struct tagLALInferenceMultibandData *multiband; /** Data products of the multibanded likelihood */
 
   struct tagLALInferenceIFOData      *next;     /** A pointer to the next set of data for linked list */
 } LALInferenceIFOData;
@@ -672,16 +758,18 @@ tagLALInferenceIFOData
 typedef struct
 tagLALInferenceROQData
 {
-  COMPLEX16 *weightsLinear; /** weights for <d|h>: NOTE: needs to be stored from data read from command line */
+  COMPLEX16 *weightsLinear; /** weights for <d|h> at each time step, stored as n_time_steps rows of n_basis_linear weights */
   REAL8 *weightsQuadratic; /** weights for calculating <h|h>*/
   REAL8 time_weights_width;
-  REAL8 time_step_size;
+  REAL8 time_step_size; /** spacing of the time steps of weightsLinear */
+  REAL8 time_step_start; /** time shift of the first time step of weightsLinear */
   int n_time_steps;
+  UINT4 n_basis_linear; /** number of linear weights per time step */
   FILE *weightsFileLinear;
   FILE *weightsFileQuadratic;
 
 
-  struct tagLALInferenceROQSplineWeightsLinear *weights_linear;
+  struct tagLALInferenceROQSplineWeightsLinear *weights_linear; /** Deprecated: no longer filled, weightsLinear is interpolated directly */
 
  
   /* Deprecated functions that should be removed at some point */ 
@@ -722,6 +810,8 @@ tagLALInferenceROQModel
 
   COMPLEX16Sequence *calFactorQuadratic;
 
+  COMPLEX16Sequence *templateLinear; /** buffer for the projected template at the linear frequency nodes */
+
   REAL8Sequence  * frequencyNodesLinear; /** empirical frequency nodes for the likelihood. NOTE: needs to be stored from data read from command line */
   REAL8Sequence * frequencyNodesQuadratic;
   REAL8 trigtime;
@@ -740,6 +830,45 @@ tagLALInferenceROQModel
 
 } LALInferenceROQModel;
 
+/**
+ * Structure to contain model-related quantities of the multibanded likelihood.
+ * The frequency range is split into bands whose windows taper into each other
+ * and sum to one.  Band b is sampled at nodes spaced by 2^shift[b] frequency
+ * bins of the data, which is fine enough to resolve the part of the signal in
+ * the band, so the template is only generated at the nodes of all bands.
+ */
+typedef struct
+tagLALInferenceMultibandModel
+{
+  REAL8Sequence *frequencies; /** nodes of all bands, in increasing order */
+  UINT4 nbands;               /** number of bands */
+  UINT4 *shift;               /** log2 of the node spacing of each band, in frequency bins of the data */
+  UINT4 *first_bin;           /** frequency bin of the first node of each band */
+  UINT4 *band_offset;         /** offset of the nodes of each band in node_index and window (nbands+1 entries) */
+  UINT4 *node_index;          /** index in frequencies of each node of each band */
+  REAL8 *window;              /** window of each band at each of its nodes */
+  REAL8 *band_limits;         /** start and end of the rising and of the falling taper of each band (4 entries per band) */
+  UINT4 length;               /** number of time samples in the data */
+  REAL8 deltaT;               /** sampling interval of the data */
+  REAL8 time_reference;       /** time shift about which the bands are laid out */
+  REAL8 time_margin;          /** largest allowed offset of the time shift from time_reference */
+  COMPLEX16FrequencySeries *hptilde, *hctilde; /** template at the nodes */
+  COMPLEX16Sequence *calFactor; /** calibration factor at the nodes */
+  COMPLEX16Sequence *template; /** buffer for the projected template at the nodes of one band, as long as the longest band */
+} LALInferenceMultibandModel;
+
+/**
+ * Structure to contain data-related quantities of the multibanded likelihood,
+ * indexed like the window of LALInferenceMultibandModel.
+ */
+typedef struct
+tagLALInferenceMultibandData
+{
+  COMPLEX16 *weightsLinear;   /** weights for <d|h> at the nodes of each band */
+  REAL8 *weightsQuadratic;    /** weights for <h|h> at the nodes of each band */
+  REAL8 dd;                   /** <d|d> */
+} LALInferenceMultibandData;
+
 /**
  * Structure to contain data-related Reduced Order Quadrature quantities
  */
@@ -749,6 +878,20 @@ LALInferenceThreadState *LALInferenceInitThread(LALInferenceThreadState *thread)
 /* Initialize a bunch of threads using LALInferenceInitThread */
 LALInferenceThreadState *LALInferenceInitThreads(INT4 nthreads);
 
+/**
+ * Returns the schema of the sampling parameters \c params of \c thread,
+ * rebuilding the cached schema if the parameters have changed (e.g. after a
+ * reversible-jump proposal)
+ */
+const LALInferenceVariablesSchema *LALInferenceGetThreadSchema(LALInferenceThreadState *thread, const LALInferenceVariables *params);
+
+/**
+ * Frees the parameter schema and the packed differential evolution buffer
+ * held by \c thread, and the likelihood caches and multiband layout of its
+ * model.  The thread can be used again afterwards.
+ */
+void LALInferenceClearThreadBuffers(LALInferenceThreadState *thread);
+
 /** Returns the element of the process params table with "name" */
 ProcessParamsTable *LALInferenceGetProcParamVal(ProcessParamsTable *procparams,const char *name);
 
@@ -851,6 +994,42 @@ void LALInferenceSortVariablesByName(LALInferenceVariables *vars);
 INT4 LALInferenceThinnedBufferToArray(LALInferenceThreadState *thread, REAL8** DEarray, INT4 step);
 INT4 LALInferenceBufferToArray(LALInferenceThreadState *thread, REAL8** DEarray);
 
+/**
+ * Appends \a params to the packed differential evolution buffer of \a thread,
+ * growing the buffer as needed.  The parameters stored are fixed by the first
+ * point appended to an empty buffer.
+ */
+int LALInferenceAppendDifferentialPoint(LALInferenceThreadState *thread, const LALInferenceVariables *params);
+
+/**
+ * Halves the packed differential evolution buffer by keeping every second
+ * point, and doubles differentialPointsSkip.
+ */
+void LALInferenceThinDifferentialPoints(LALInferenceThreadState *thread);
+
+/** Empties the packed differential evolution buffer and frees its memory */
+void LALInferenceClearDifferentialPoints(LALInferenceThreadState *thread);
+
+/**
+ * Frees the cached column maps of \a thread; called whenever the thread schema
+ * or the parameters of the differential evolution buffer change.
+ */
+void LALInferenceClearDifferentialColumns(LALInferenceThreadState *thread);
+
+/**
+ * Returns the parameters stored in each row of the differential evolution
+ * buffer, or \c NULL if the buffer is empty.  For a buffer of variables the
+ * schema is built from its first point.
+ */
+const LALInferenceVariablesSchema *LALInferenceGetDifferentialPointsSchema(LALInferenceThreadState *thread);
+
+/**
+ * Returns the packed parameters of differential point \a i.  A packed buffer
+ * is returned in place; a point stored as variables is packed into \a row,
+ * which must hold the schema length.  Returns \c NULL on error.
+ */
+const REAL8 *LALInferenceGetDifferentialPoint(LALInferenceThreadState *thread, size_t i, REAL8 *row);
+
 /** LALInference variables to an array, and vica versa */
 void LALInferenceCopyVariablesToArray(LALInferenceVariables *origin, REAL8 *target);
 
@@ -88,6 +88,15 @@ COMPLEX16Array *complex_B_matrix(gsl_matrix_complex *V, gsl_matrix_complex *RB);
 /* find the index of the absolute maximum value for a complex vector */
 int complex_vector_maxabs_index( gsl_vector_complex *c );
 
+/* weighted complex conjugates of a set of basis vectors, for use with complex_project_rows */
+void complex_weighted_conjugate(const gsl_vector *weight, const gsl_matrix_complex *RB, gsl_matrix_complex *V);
+
+/* project a set of complex waveforms onto a set of weighted complex conjugate basis vectors */
+void complex_project_rows(const gsl_matrix_complex *TS, const gsl_matrix_complex *V, gsl_matrix_complex *C);
+
+/* number of training set waveforms projected onto the basis in each BLAS call */
+#define ROQ_PROJECTION_BLOCK 256
+
 
 /** \brief Function to project the training set onto a given basis vector
  *
@@ -504,6 +513,64 @@ int complex_vector_maxabs_index( gsl_vector_complex *c ){
 }
 
 
+/** \brief Get the weighted complex conjugates of a set of complex basis vectors
+ *
+ * Sets \c V(b,i) = w_i conj(RB(b,i)), so that the complex weighted dot product of basis
+ * vector \c b with a waveform \c h (as given by \c complex_weighted_dot_product) is the
+ * plain (unconjugated) dot product of row \c b of \c V with \c h.
+ *
+ * @param[in] weight The weighting(s) in the dot product (e.g. time of frequency step(s) between points)
+ * @param[in] RB The set of basis vectors (as rows)
+ * @param[out] V A matrix of the same size as \c RB returning the weighted complex conjugate basis vectors
+ */
+void complex_weighted_conjugate(const gsl_vector *weight, const gsl_matrix_complex *RB, gsl_matrix_complex *V){
+  XLAL_CHECK_VOID( RB->size1 == V->size1 && RB->size2 == V->size2, XLAL_EFUNC, "Basis and output matrices are different sizes." );
+  XLAL_CHECK_VOID( weight->size == 1 || weight->size == RB->size2, XLAL_EFUNC, "Vector of weights must either contain a single value, or be the same length as the other input vectors." );
+
+  for ( size_t b = 0; b < RB->size1; b++ ){
+    for ( size_t i = 0; i < RB->size2; i++ ){
+      const double w = gsl_vector_get(weight, weight->size == 1 ? 0 : i);
+      const gsl_complex rb = gsl_matrix_complex_get(RB, b, i);
+      gsl_complex v;
+      GSL_SET_COMPLEX(&v, w*GSL_REAL(rb), -w*GSL_IMAG(rb));
+      gsl_matrix_complex_set(V, b, i, v);
+    }
+  }
+}
+
+
+/** \brief Project a set of complex waveforms onto a set of basis vectors
+ *
+ * Computes the matrix of projection coefficients \c C = \c TS \c V^T, i.e. \c C(r,b) is the
+ * complex weighted dot product of basis vector \c b with waveform \c r, where \c V contains the
+ * weighted complex conjugate basis vectors returned by \c complex_weighted_conjugate. The
+ * product is performed as a set of level-3 BLAS calls (\c zgemm) on blocks of
+ * \c ROQ_PROJECTION_BLOCK waveforms, which are shared between OpenMP threads if available.
+ *
+ * @param[in] TS The set of waveforms (as rows)
+ * @param[in] V The weighted complex conjugate basis vectors (as rows)
+ * @param[out] C A \c TS->size1 by \c V->size1 matrix returning the projection coefficients
+ */
+void complex_project_rows(const gsl_matrix_complex *TS, const gsl_matrix_complex *V, gsl_matrix_complex *C){
+  XLAL_CHECK_VOID( TS->size2 == V->size2, XLAL_EFUNC, "Waveforms and basis vectors are different lengths." );
+  XLAL_CHECK_VOID( C->size1 == TS->size1 && C->size2 == V->size1, XLAL_EFUNC, "Output matrix is the wrong size." );
+
+  const size_t nblocks = (TS->size1 + ROQ_PROJECTION_BLOCK - 1)/ROQ_PROJECTION_BLOCK;
+  int errors = 0;
+
+  #pragma omp parallel for schedule(dynamic) reduction(+:errors)
+  for ( size_t b = 0; b < nblocks; b++ ){
+    const size_t r0 = b*ROQ_PROJECTION_BLOCK;
+    const size_t nr = ( r0 + ROQ_PROJECTION_BLOCK < TS->size1 ) ? ROQ_PROJECTION_BLOCK : TS->size1 - r0;
+    gsl_matrix_complex_const_view ts = gsl_matrix_complex_const_submatrix(TS, r0, 0, nr, TS->size2);
+    gsl_matrix_complex_view c = gsl_matrix_complex_submatrix(C, r0, 0, nr, C->size2);
+    if ( gsl_blas_zgemm(CblasNoTrans, CblasTrans, GSL_COMPLEX_ONE, &ts.matrix, V, GSL_COMPLEX_ZERO, &c.matrix) != GSL_SUCCESS ){ errors++; }
+  }
+
+  XLAL_CHECK_VOID( errors == 0, XLAL_EFUNC, "Projection of the training set onto the basis failed." );
+}
+
+
 /** \brief Modified Gram-Schmidt algorithm for complex data
  *
  * A modified Gram-Schmidt algorithm taken from the
@@ -989,8 +1056,8 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
   UINT4 worst_app = 0;      /* worst error stored */
   gsl_complex tmpc;         /* worst error temp */
 
-  gsl_vector_complex *ts_el, *last_rb, *ortho_basis, *ru;
-  gsl_matrix_complex *R_matrix;
+  gsl_vector_complex *ts_el, *ortho_basis, *ru;
+  gsl_matrix_complex *R_matrix, *last_rb, *projection_coeffs;
   REAL8 A_row_norms2[rows];              // || A(i,:) ||^2
   REAL8 projection_norms2[rows];
   REAL8 errors[rows];                    // approximation errors at i^{th} sweep
@@ -1001,12 +1068,11 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
   
   /* this memory should be freed here */
   ts_el         = gsl_vector_complex_alloc(cols);
-  last_rb       = gsl_vector_complex_alloc(cols);
+  last_rb       = gsl_matrix_complex_alloc(1, cols);
   ortho_basis   = gsl_vector_complex_alloc(cols);
   ru            = gsl_vector_complex_alloc(max_RB);
 
-  //project_coeff = gsl_matrix_complex_alloc(max_RB,rows);
-  gsl_complex projection_coeff;
+  projection_coeffs = gsl_matrix_complex_alloc(rows, 1);
   R_matrix = gsl_matrix_complex_alloc(max_RB, max_RB);
 
   /* initialise projection norms with zeros */
@@ -1042,12 +1108,14 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
 
   /* loop to find reduced basis */
   while( 1 ){
-    gsl_matrix_complex_get_row(last_rb, &RBview.matrix, dim_RB-1); /* previous basis */
+    /* previous basis */
+    gsl_matrix_complex_const_view rb_new = gsl_matrix_complex_const_submatrix(&RBview.matrix, dim_RB-1, 0, 1, cols);
+    complex_weighted_conjugate(&deltaview.vector, &rb_new.matrix, last_rb);
 
     /* Compute overlaps of pieces of training set with rb_new */
+    complex_project_rows(&TSview.matrix, last_rb, projection_coeffs);
     for(size_t i = 0; i < rows; i++){
-      gsl_matrix_complex_get_row(ts_el, &TSview.matrix, i);
-      projection_coeff = complex_weighted_dot_product(&deltaview.vector, last_rb, ts_el);
+      gsl_complex projection_coeff = gsl_matrix_complex_get(projection_coeffs, i, 0);
       projection_norms2[i] += (projection_coeff.dat[0]*projection_coeff.dat[0] + projection_coeff.dat[1]*projection_coeff.dat[1]);
       errors[i] = A_row_norms2[i] - projection_norms2[i];
     }
@@ -1124,15 +1192,172 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
 
   XLALDestroyUINT4Vector(dims);
   gsl_vector_complex_free(ts_el);
-  gsl_vector_complex_free(last_rb);
+  gsl_matrix_complex_free(last_rb);
   gsl_vector_complex_free(ortho_basis);
   gsl_vector_complex_free(ru);
   gsl_matrix_complex_free(R_matrix);
+  gsl_matrix_complex_free(projection_coeffs);
 
   return worst_err;
 }
 
 
+/**
+ * \brief Create a complex orthonormal basis set from a training set produced in chunks
+ *
+ * This function creates a reduced basis in the same way as
+ * \c LALInferenceGenerateCOMPLEX16OrthonormalBasis, but without ever holding the whole
+ * training set in memory. The training set is requested in chunks from the function
+ * \c generate. Each chunk is normalised and projected onto the current basis (with
+ * \c zgemm over blocks of waveforms), and then the greedy algorithm adds the worst
+ * represented waveforms of that chunk to the basis until all waveforms in the chunk
+ * meet the tolerance. The chunk is then freed and the next one requested.
+ *
+ * As each chunk only sees the basis built from the previous chunks, the basis can
+ * differ slightly from (and be somewhat larger than) that produced from the whole
+ * training set at once, but every training waveform is represented to within the
+ * given tolerance.
+ *
+ * @param[out] RBin A \c COMPLEX16Array to return the reduced basis.
+ * @param[in] delta The time/frequency step(s) in the training set used to normalise the models.
+ * This can be a vector containing just one value.
+ * @param[in] tolerance The tolerance used as a stopping criteria for the basis generation.
+ * @param[in] generate The function returning the chunks of the training set.
+ * @param[in] context A pointer passed to \c generate.
+ * @param[out] greedypoints A \c UINT4Vector to return the indices of the training set rows that
+ * have been used to form the reduced basis, counting over all chunks.
+ *
+ * @return A \c REAL8 with the maximum projection error of the training waveforms when their
+ * chunk was completed.
+ *
+ * \sa LALInferenceGenerateCOMPLEX16OrthonormalBasis
+ */
+REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasisStreaming(COMPLEX16Array **RBin,
+                                                             const REAL8Vector *delta,
+                                                             REAL8 tolerance,
+                                                             LALInferenceROQCOMPLEX16TrainingFunction generate,
+                                                             void *context,
+                                                             UINT4Vector **greedypoints){
+  XLAL_CHECK_REAL8( delta != NULL, XLAL_EFUNC, "Vector of 'delta' values is NULL!" );
+  XLAL_CHECK_REAL8( generate != NULL, XLAL_EFUNC, "Training set function is NULL!" );
+  XLAL_CHECK_REAL8( tolerance > 0, XLAL_EFUNC, "Tolerance is less than, or equal to, zero!" );
+
+  COMPLEX16Array *RB = NULL;
+  UINT4Vector *gpts = NULL;
+  UINT4Vector *dims = XLALCreateUINT4Vector( 2 );
+  size_t cols = 0, dim_RB = 0, offset = 0;
+  REAL8 maxprojerr = 0.;
+
+  gsl_vector_view deltaview;
+  XLAL_CALLGSL( deltaview = gsl_vector_view_array(delta->data, delta->length) );
+
+  for ( UINT4 chunk = 0; ; chunk++ ){
+    COMPLEX16Array *ts = NULL;
+    XLAL_CHECK_REAL8( generate(&ts, chunk, context) == XLAL_SUCCESS, XLAL_EFUNC, "Failed to generate chunk %u of the training set", chunk );
+    if ( ts == NULL ){ break; }
+
+    XLAL_CHECK_REAL8( ts->dimLength->length == 2, XLAL_EFUNC, "Training set chunk does not have 2 dimensions!" );
+    size_t rows = ts->dimLength->data[0];
+    if ( cols == 0 ){ cols = ts->dimLength->data[1]; }
+    XLAL_CHECK_REAL8( ts->dimLength->data[1] == cols, XLAL_EFUNC, "Training set chunk contains waveforms of different length to the previous chunks!" );
+
+    gsl_matrix_complex_view TSview;
+    XLAL_CALLGSL( TSview = gsl_matrix_complex_view_array((double *)ts->data, rows, cols) );
+    complex_normalise_training_set(&deltaview.vector, &TSview.matrix);
+
+    REAL8 *errors = XLALCalloc(rows, sizeof(REAL8));
+    XLAL_CHECK_REAL8( errors != NULL, XLAL_ENOMEM );
+    for ( size_t i = 0; i < rows; i++ ){
+      gsl_vector_complex_view row = gsl_matrix_complex_row(&TSview.matrix, i);
+      REAL8 nrm = complex_normalisation(&deltaview.vector, &row.vector);
+      errors[i] = nrm*nrm;
+    }
+
+    /* project the chunk onto the basis from the previous chunks */
+    if ( dim_RB > 0 ){
+      gsl_matrix_complex_view RBview = gsl_matrix_complex_view_array((double *)RB->data, dim_RB, cols);
+      gsl_matrix_complex *V = gsl_matrix_complex_alloc(dim_RB, cols);
+      gsl_matrix_complex *C = gsl_matrix_complex_alloc(rows, dim_RB);
+      complex_weighted_conjugate(&deltaview.vector, &RBview.matrix, V);
+      complex_project_rows(&TSview.matrix, V, C);
+      for ( size_t i = 0; i < rows; i++ ){
+        gsl_vector_complex_view crow = gsl_matrix_complex_row(C, i);
+        REAL8 pnrm = gsl_blas_dznrm2(&crow.vector);
+        errors[i] -= pnrm*pnrm;
+      }
+      gsl_matrix_complex_free(V);
+      gsl_matrix_complex_free(C);
+    }
+
+    gsl_vector_complex *ortho_basis = gsl_vector_complex_alloc(cols);
+    gsl_matrix_complex *last_rb = gsl_matrix_complex_alloc(1, cols);
+    gsl_matrix_complex *coeffs = gsl_matrix_complex_alloc(rows, 1);
+    REAL8 worst_err = 0.;
+
+    /* add the worst represented waveforms of this chunk to the basis */
+    for ( size_t added = 0; added < rows; added++ ){
+      size_t worst_app = 0;
+      worst_err = 0.;
+      for ( size_t i = 0; i < rows; i++ ){
+        if ( worst_err < errors[i] ){
+          worst_err = errors[i];
+          worst_app = i;
+        }
+      }
+      if ( dim_RB > 0 && worst_err < tolerance ){ break; }
+
+      gsl_matrix_complex_get_row(ortho_basis, &TSview.matrix, worst_app);
+      if ( dim_RB > 0 ){
+        gsl_matrix_complex_view RBview = gsl_matrix_complex_view_array((double *)RB->data, dim_RB, cols);
+        gsl_vector_complex *ru = gsl_vector_complex_alloc(dim_RB+1);
+        iterated_modified_gm_complex(ru, ortho_basis, &RBview.matrix, &deltaview.vector, dim_RB); /* use IMGS */
+        int isnan_ru = gsl_isnan(GSL_REAL(gsl_vector_complex_get(ru, dim_RB)));
+        gsl_vector_complex_free(ru);
+        /* new basis has zero residual with the current basis, so do not add it */
+        if ( isnan_ru ){ break; }
+      }
+
+      /* add to reduced basis */
+      dims->data[0] = dim_RB+1;
+      dims->data[1] = cols;
+      RB = ( RB == NULL ) ? XLALCreateCOMPLEX16Array( dims ) : XLALResizeCOMPLEX16Array( RB, dims );
+      gpts = XLALResizeUINT4Vector( gpts, dim_RB+1 );
+      XLAL_CHECK_REAL8( RB != NULL && gpts != NULL, XLAL_ENOMEM );
+      gsl_matrix_complex_view RBview = gsl_matrix_complex_view_array((double *)RB->data, dim_RB+1, cols);
+      gsl_matrix_complex_set_row(&RBview.matrix, dim_RB, ortho_basis);
+      gpts->data[dim_RB] = offset + worst_app;
+      ++dim_RB;
+
+      /* update the projection errors of the chunk with the new basis */
+      gsl_matrix_complex_const_view rb_new = gsl_matrix_complex_const_submatrix(&RBview.matrix, dim_RB-1, 0, 1, cols);
+      complex_weighted_conjugate(&deltaview.vector, &rb_new.matrix, last_rb);
+      complex_project_rows(&TSview.matrix, last_rb, coeffs);
+      for ( size_t i = 0; i < rows; i++ ){
+        gsl_complex c = gsl_matrix_complex_get(coeffs, i, 0);
+        errors[i] -= GSL_REAL(c)*GSL_REAL(c) + GSL_IMAG(c)*GSL_IMAG(c);
+      }
+    }
+
+    if ( worst_err > maxprojerr ){ maxprojerr = worst_err; }
+    offset += rows;
+
+    gsl_vector_complex_free(ortho_basis);
+    gsl_matrix_complex_free(last_rb);
+    gsl_matrix_complex_free(coeffs);
+    XLALFree(errors);
+    XLALDestroyCOMPLEX16Array(ts);
+  }
+
+  XLALDestroyUINT4Vector( dims );
+  XLAL_CHECK_REAL8( RB != NULL, XLAL_EFUNC, "The training set was empty!" );
+
+  *RBin = RB;
+  *greedypoints = gpts;
+
+  return maxprojerr;
+}
+
+
 /**
  * \brief Validate the real reduced basis against another set of waveforms
  *
@@ -1423,9 +1648,8 @@ void LALInferenceValidateCOMPLEX16OrthonormalBasis(REAL8Vector **projerr,
   COMPLEX16Array *tm = NULL;
   tm = *testmodels;
 
-  size_t dlength = RB->dimLength->data[1], nts = tm->dimLength->data[0];
-  size_t k = 0, j = 0;
-  gsl_vector_complex *r_tmp, *testrow;
+  size_t dlength = RB->dimLength->data[1], nts = tm->dimLength->data[0], nrb = RB->dimLength->data[0];
+  size_t k = 0;
 
   /* normalise the test set */
   gsl_vector_view deltaview;
@@ -1435,56 +1659,41 @@ void LALInferenceValidateCOMPLEX16OrthonormalBasis(REAL8Vector **projerr,
   complex_normalise_training_set(&deltaview.vector, &testmodelsview.matrix);
 
   gsl_matrix_complex_view RBview;
-  RBview = gsl_matrix_complex_view_array((double *)RB->data, RB->dimLength->data[0], dlength);
+  RBview = gsl_matrix_complex_view_array((double *)RB->data, nrb, dlength);
 
-  XLAL_CALLGSL( testrow = gsl_vector_complex_alloc(dlength) );
-  XLAL_CALLGSL( r_tmp = gsl_vector_complex_alloc(RB->dimLength->data[0]) );
+  /* weighted complex conjugate of the basis, so the projections are a plain matrix product */
+  gsl_matrix_complex *V = NULL;
+  XLAL_CALLGSL( V = gsl_matrix_complex_alloc(nrb, dlength) );
+  complex_weighted_conjugate(&deltaview.vector, &RBview.matrix, V);
 
   REAL8Vector *pe = NULL;
   pe = XLALCreateREAL8Vector( nts );
   *projerr = pe;
 
-  /* get projection errors for each test model */
-  for ( k = 0; k < nts; k++ ){
-    pe->data[k] = 0.;
-    REAL8 r_tmp_nrm = 0.;
-
-    XLAL_CALLGSL( gsl_matrix_complex_get_row(testrow, &testmodelsview.matrix, k) );
-
-    REAL8 nrm = complex_normalisation(&deltaview.vector, testrow); // normalisation (should be 1 as test models are normalised)
-
-    // un-scale testrow (gsl_vector_complex_mul doesn't work when delta is a real vector)
-    if ( delta->length == 1 || testrow->size == deltaview.vector.size ){
-      for ( j = 0; j < dlength; j++ ){
-        gsl_complex ctmp;
-        XLAL_CALLGSL( ctmp = gsl_vector_complex_get( testrow, j ) );
-        if ( delta->length == 1 ){
-          XLAL_CALLGSL( ctmp = gsl_complex_mul_real( ctmp, delta->data[0] ) );
-        }
-        else{
-          XLAL_CALLGSL( ctmp = gsl_complex_mul_real( ctmp, delta->data[j] ) );
-        }
-        XLAL_CALLGSL( gsl_vector_complex_set( testrow, j, ctmp ) );
-      }
+  /* get projection errors for each test model, projecting blocks of test models at a time to bound the memory used */
+  const size_t chunk = 16*ROQ_PROJECTION_BLOCK;
+  gsl_matrix_complex *C = NULL;
+  XLAL_CALLGSL( C = gsl_matrix_complex_alloc(nts < chunk ? nts : chunk, nrb) );
+  for ( size_t k0 = 0; k0 < nts; k0 += chunk ){
+    size_t nk = ( k0 + chunk < nts ) ? chunk : nts - k0;
+    gsl_matrix_complex_view tmblock = gsl_matrix_complex_submatrix(&testmodelsview.matrix, k0, 0, nk, dlength);
+    gsl_matrix_complex_view Cblock = gsl_matrix_complex_submatrix(C, 0, 0, nk, nrb);
+    complex_project_rows(&tmblock.matrix, V, &Cblock.matrix);
+
+    for ( k = k0; k < k0 + nk; k++ ){
+      gsl_vector_complex_view testrow = gsl_matrix_complex_row(&testmodelsview.matrix, k);
+      gsl_vector_complex_view r_tmp = gsl_matrix_complex_row(&Cblock.matrix, k - k0);
+
+      REAL8 nrm = complex_normalisation(&deltaview.vector, &testrow.vector); // normalisation (should be 1 as test models are normalised)
+      REAL8 r_tmp_nrm = gsl_blas_dznrm2(&r_tmp.vector);
+      pe->data[k] = nrm - r_tmp_nrm*r_tmp_nrm;
+
+      if ( pe->data[k] < 0. ) { pe->data[k] = 1.0e-16; } // floating point error can trigger this
     }
-    else{
-      XLAL_ERROR_VOID( XLAL_EFUNC, "Vector of weights must either contain a single value, or be the same length as the other input vectors." );
-    }
-    
-    // get complex conjugate
-    for ( j = 0; j < testrow->size; j++ ){ testrow->data[2*j+1] = -testrow->data[2*j+1]; }
-
-    // get projections
-    XLAL_CALLGSL( gsl_blas_zgemv( CblasNoTrans, GSL_COMPLEX_ONE, &RBview.matrix, testrow, GSL_COMPLEX_ZERO, r_tmp ) );
-
-    r_tmp_nrm = gsl_blas_dznrm2(r_tmp);
-    pe->data[k] = nrm - r_tmp_nrm*r_tmp_nrm;
-
-    if ( pe->data[k] < 0. ) { pe->data[k] = 1.0e-16; } // floating point error can trigger this
   }
 
-  XLAL_CALLGSL( gsl_vector_complex_free( testrow ) );
-  XLAL_CALLGSL( gsl_vector_complex_free( r_tmp ) );
+  XLAL_CALLGSL( gsl_matrix_complex_free( V ) );
+  XLAL_CALLGSL( gsl_matrix_complex_free( C ) );
 }
 
 
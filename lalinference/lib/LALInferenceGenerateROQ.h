@@ -52,6 +52,15 @@ typedef struct tagLALInferenceCOMPLEXROQInterpolant{
   UINT4 *nodes;           /**< The nodes (indices) for the interpolation */
 }LALInferenceCOMPLEXROQInterpolant;
 
+/**
+ * Function type for producing the training set in chunks for
+ * \c LALInferenceGenerateCOMPLEX16OrthonormalBasisStreaming. On each call it
+ * should set \c TS to a newly allocated array containing chunk number \c chunk
+ * of the training set (waveforms as rows), or to \c NULL when there are no
+ * further chunks.
+ */
+typedef INT4 (*LALInferenceROQCOMPLEX16TrainingFunction)(COMPLEX16Array **TS, UINT4 chunk, void *context);
+
 /* function to create or enrich a real orthonormal basis set from a training set of models */
 REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RB,
                                                 const REAL8Vector *delta,
@@ -65,6 +74,13 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RB,
                                                     COMPLEX16Array **TS,
                                                     UINT4Vector **greedypoints);
 
+REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasisStreaming(COMPLEX16Array **RB,
+                                                             const REAL8Vector *delta,
+                                                             REAL8 tolerance,
+                                                             LALInferenceROQCOMPLEX16TrainingFunction generate,
+                                                             void *context,
+                                                             UINT4Vector **greedypoints);
+
 /* functions to test the basis */
 void LALInferenceValidateREAL8OrthonormalBasis(REAL8Vector **projerr,
                                                const REAL8Vector *delta,
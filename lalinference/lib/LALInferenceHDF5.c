@@ -323,6 +323,62 @@ int LALInferenceH5VariablesArrayToDataset(
 }
 
 
+int LALInferenceH5PackedArrayToDataset(
+    LALH5File *h5file, LALInferenceVariables *vars, const REAL8 *array,
+    UINT4 N, const char *TableName)
+{
+    int retval = XLAL_SUCCESS;
+
+    if (!vars || !array)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (N == 0)
+        return 0;
+
+    LALInferenceVariablesSchema *schema =
+        LALInferenceCreateVariablesSchema(vars);
+    if (!schema)
+        XLAL_ERROR(XLAL_EFUNC);
+
+    /* Expand each row onto a copy of vars */
+    LALInferenceVariables **varsArray = XLALCalloc(
+        N, sizeof(LALInferenceVariables *));
+    for (UINT4 i = 0; varsArray && i < N && retval == XLAL_SUCCESS; i ++)
+    {
+        varsArray[i] = XLALCalloc(1, sizeof(LALInferenceVariables));
+        if (!varsArray[i])
+        {
+            retval = XLAL_ENOMEM;
+            break;
+        }
+        LALInferenceCopyVariables(vars, varsArray[i]);
+        if (LALInferenceUnpackVariables(
+                varsArray[i], schema, array + i*schema->length) != XLAL_SUCCESS)
+            retval = XLAL_EFUNC;
+    }
+    if (!varsArray)
+        retval = XLAL_ENOMEM;
+
+    if (retval == XLAL_SUCCESS && LALInferenceH5VariablesArrayToDataset(
+            h5file, varsArray, N, TableName) != XLAL_SUCCESS)
+        retval = XLAL_EFUNC;
+
+    for (UINT4 i = 0; varsArray && i < N; i ++)
+    {
+        if (varsArray[i])
+        {
+            LALInferenceClearVariables(varsArray[i]);
+            XLALFree(varsArray[i]);
+        }
+    }
+    XLALFree(varsArray);
+    LALInferenceDestroyVariablesSchema(schema);
+
+    if (retval != XLAL_SUCCESS)
+        XLAL_ERROR(retval);
+    return XLAL_SUCCESS;
+}
+
+
 static void LALInferenceH5VariableToAttribute(
     LALH5Generic gdataset, LALInferenceVariables *vars, char *name)
 {
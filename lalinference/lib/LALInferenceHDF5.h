@@ -40,6 +40,15 @@ int LALInferenceH5VariablesArrayToDataset(
 int LALInferenceH5DatasetToVariablesArray(
     LALH5Dataset *dataset, LALInferenceVariables ***varsArray, UINT4 *N);
 
+/**
+ * Write \c N rows of sampling parameters, packed with the schema of \c vars
+ * (see LALInferencePackVariables()), as a dataset of copies of \c vars
+ * which can be read back with LALInferenceH5DatasetToVariablesArray()
+ */
+int LALInferenceH5PackedArrayToDataset(
+    LALH5File *h5file, LALInferenceVariables *vars, const REAL8 *array,
+    UINT4 N, const char *TableName);
+
 /**
  * Create a HDF5 heirarchy in the given LALH5File reference
  * /codename/runID/
@@ -38,6 +38,7 @@
 #include <lal/LALInferenceReadData.h>
 #include <lal/LALInferenceInit.h>
 #include <lal/LALInferenceCalibrationErrors.h>
+#include <lal/LALInferenceMultibanding.h>
 #include <lal/LALSimNeutronStar.h>
 
 static int checkParamInList(const char *list, const char *param);
@@ -245,6 +246,14 @@ void LALInferenceInitCBCThreads(LALInferenceRunState *run_state, INT4 nthreads)
       thread->model->roq_flag=0;
     }
 
+    /* Setup the multibanded likelihood */
+    if (LALInferenceGetProcParamVal(commandLine, "--multiband-likelihood")){
+      if (LALInferenceSetupMultibandModel(thread->model, run_state->data, run_state->priorArgs) != XLAL_SUCCESS){
+        fprintf(stderr, "Error: could not set up the multibanded likelihood\n");
+        exit(1);
+      }
+    }
+
     LALInferenceCopyVariables(thread->model->params, thread->currentParams);
     LALInferenceCopyVariables(run_state->proposalArgs, thread->proposalArgs);
 
@@ -299,6 +308,10 @@ LALInferenceTemplateFunction LALInferenceInitCBCTemplate(LALInferenceRunState *r
                     --template LALGenerateInspiral (for time-domain templates)\n\
                     --template LAL (for frequency-domain templates)\n");
   }
+  else if(LALInferenceGetProcParamVal(commandLine,"--multiband-likelihood")){
+    templt=&LALInferenceMultibandWrapperForXLALSimInspiralChooseFDWaveformSequence;
+    fprintf(stdout,"Template function called is \"LALInferenceMultibandWrapperForXLALSimInspiralChooseFDWaveformSequence\"\n");
+  }
   else if(LALInferenceGetProcParamVal(commandLine,"--roqtime_steps")){
   templt=&LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence;
         fprintf(stderr, "template is \"LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence\"\n");
@@ -750,6 +763,9 @@ LALInferenceModel *LALInferenceInitCBCModel(LALInferenceRunState *state) {
     (--tidalOrder PNorder)          Specify twice the PN order (e.g. 10 <==> 5PN) of tidal effects to use, only for LALSimulation (default: -1 <==> Use all tidal effects).\n\
     (--numreldata FileName)         Location of NR data file for NR waveforms (with NR_hdf5 approx).\n\
     (--modeldomain)                 domain the waveform template will be computed in (\"time\" or \"frequency\"). If not given will use LALSim to decide\n\
+    (--multiband-likelihood)        Compute the likelihood from the template at a reduced set of frequencies in bands of\n\
+                                    decreasing time-to-merger (frequency-domain approximants, Gaussian or --margphi only,\n\
+                                    not with --roqtime_steps).\n\
     (--spinAligned or --aligned-spin)  template will assume spins aligned with the orbital angular momentum.\n\
     (--singleSpin)                  template will assume only the spin of the most massive binary component exists.\n\
     (--noSpin, --disable-spin)      template will assume no spins (giving this will void spinOrder!=0) \n\
@@ -930,6 +946,8 @@ LALInferenceModel *LALInferenceInitCBCModel(LALInferenceRunState *state) {
   model->params = XLALCalloc(1, sizeof(LALInferenceVariables));
   memset(model->params, 0, sizeof(LALInferenceVariables));
   model->eos_fam = NULL;
+  model->extrinsicCache = NULL;
+  model->multiband = NULL;
 
   UINT4 signal_flag=1;
   ppt = LALInferenceGetProcParamVal(commandLine, "--noiseonly");
@@ -1630,6 +1648,9 @@ LALInferenceModel *LALInferenceInitCBCModel(LALInferenceRunState *state) {
   /* Create arrays for holding single-IFO likelihoods, etc. */
   model->ifo_loglikelihoods = XLALCalloc(nifo, sizeof(REAL8));
   model->ifo_SNRs = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fPlus = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fCross = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_timeshifts = XLALCalloc(nifo, sizeof(REAL8));
 
   /* Choose proper template */
   model->templt = LALInferenceInitCBCTemplate(state);
@@ -1678,6 +1699,9 @@ LALInferenceModel *LALInferenceInitModelReviewEvidence(LALInferenceRunState *sta
     /* Create arrays for holding single-IFO likelihoods, etc. */
     model->ifo_loglikelihoods = XLALCalloc(nifo, sizeof(REAL8));
     model->ifo_SNRs = XLALCalloc(nifo, sizeof(REAL8));
+    model->ifo_fPlus = XLALCalloc(nifo, sizeof(REAL8));
+    model->ifo_fCross = XLALCalloc(nifo, sizeof(REAL8));
+    model->ifo_timeshifts = XLALCalloc(nifo, sizeof(REAL8));
 
 	i=0;
 
@@ -1724,6 +1748,9 @@ LALInferenceModel *LALInferenceInitModelReviewEvidence_bimod(LALInferenceRunStat
   /* Create arrays for holding single-IFO likelihoods, etc. */
   model->ifo_loglikelihoods = XLALCalloc(nifo, sizeof(REAL8));
   model->ifo_SNRs = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fPlus = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fCross = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_timeshifts = XLALCalloc(nifo, sizeof(REAL8));
 
   i=0;
 
@@ -1769,6 +1796,9 @@ LALInferenceModel *LALInferenceInitModelReviewEvidence_banana(LALInferenceRunSta
   /* Create arrays for holding single-IFO likelihoods, etc. */
   model->ifo_loglikelihoods = XLALCalloc(nifo, sizeof(REAL8));
   model->ifo_SNRs = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fPlus = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fCross = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_timeshifts = XLALCalloc(nifo, sizeof(REAL8));
 
   i=0;
 
@@ -2013,6 +2043,11 @@ void LALInferenceCheckOptionsConsistency(ProcessParamsTable *commandLine)
     exit(1);
   }
 
+  if (LALInferenceGetProcParamVal(commandLine, "--multiband-likelihood") && LALInferenceGetProcParamVal(commandLine, "--roqtime_steps")) {
+    fprintf(stderr, "ERROR: cannot use the multibanded and the ROQ likelihood together.  Pick either '--multiband-likelihood' OR '--roqtime_steps'");
+    exit(1);
+  }
+
   /* Check for small sample rates when margtime-ing. */
   if (LALInferenceGetProcParamVal(commandLine, "--margtime") || LALInferenceGetProcParamVal(commandLine, "--margtimephi")) {
     ppt = LALInferenceGetProcParamVal(commandLine, "--srate");
@@ -33,13 +33,16 @@
 #include <lal/Sequence.h>
 #include <lal/FrequencySeries.h>
 #include <lal/TimeFreqFFT.h>
+#include <lal/FFTPlanCache.h>
 #include <lal/LALInferenceDistanceMarg.h>
+#include <lal/VectorMath.h>
 
 #include <gsl/gsl_sf_bessel.h>
 #include <gsl/gsl_sf_dawson.h>
 #include <gsl/gsl_sf_erf.h>
 #include <gsl/gsl_complex_math.h>
 #include <lal/LALInferenceTemplate.h>
+#include <lal/LALInferenceMultibanding.h>
 
 #include "logaddexp.h"
 
@@ -73,6 +76,46 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 
 static double integrate_interpolated_log(double h, REAL8 *log_ys, size_t n, double *imean, size_t *imax);
 
+static int FreqDomainInnerProducts(COMPLEX16 *dh, REAL8 *hh, REAL8 *dd, REAL8 *rr,
+                                   const COMPLEX16 *dtilde, const COMPLEX16 *hptilde, const COMPLEX16 *hctilde,
+                                   const COMPLEX16 *calF, const REAL8 *psd, REAL8 Fplus, REAL8 Fcross,
+                                   REAL8 twopit, REAL8 deltaF, REAL8 deltaT, REAL8 TwoDeltaToverN,
+                                   UINT4 lower, UINT4 upper, INT4 nthreads);
+
+/* Oversampling of the cached <d|h> time series relative to the data sampling rate */
+#define EXTRINSIC_CACHE_OVERSAMPLING 4
+
+/* Inner products of one detector for the extrinsic-only likelihood */
+typedef struct tagExtrinsicCacheIFO
+{
+  COMPLEX16Vector *dhplus, *dhcross; /* <d|h+>, <d|hx> as a function of time shift */
+  REAL8 hplushplus, hcrosshcross, hplushcross, dd;
+  REAL8 deltaF;
+} ExtrinsicCacheIFO;
+
+/*
+ * Cache used by --fast-extrinsic-likelihood: the inner products of the plus
+ * and cross polarisations of one waveform with the data and with each other,
+ * from which the likelihood of any sky position, polarisation, time and
+ * distance is computed without regenerating the waveform.
+ */
+typedef struct tagLALInferenceExtrinsicCache
+{
+  LALInferenceVariables intrinsic; /* intrinsic parameters of the cached waveform */
+  REAL8 logdistance;               /* log distance of the cached waveform */
+  REAL8 time;                      /* time at which the cached waveform is placed */
+  int valid;                       /* are the inner products filled */
+  int template_valid;              /* do the model buffers hold the waveform of model->params */
+  UINT4 nifo;
+  ExtrinsicCacheIFO *ifo;
+} LALInferenceExtrinsicCache;
+
+static int ExtrinsicCacheLookup(LALInferenceModel *model, LALInferenceVariables *currentParams,
+                                LALInferenceIFOData *data, UINT4 spcal_active);
+static void ExtrinsicCacheInnerProducts(COMPLEX16 *dh, REAL8 *hh, REAL8 *dd, REAL8 *rr,
+                                        const ExtrinsicCacheIFO *cache, REAL8 Fplus, REAL8 Fcross,
+                                        REAL8 timeshift, REAL8 ampscale);
+
 static int get_calib_spline(LALInferenceVariables *vars, const char *ifoname, REAL8Vector **logfreqs, REAL8Vector **amps, REAL8Vector **phases);
 static int get_calib_spline(LALInferenceVariables *vars, const char *ifoname, REAL8Vector **logfreqs, REAL8Vector **amps, REAL8Vector **phases)
 {
@@ -117,6 +160,12 @@ void LALInferenceInitLikelihood(LALInferenceRunState *runState)
     (--margtimephi)                  Using marginalised in time and phase likelihood\n\
     (--margdist)                     Using marginalisation in distance with d^2 prior (compatible with --margphi and --margtimephi)\n\
     (--margdist-comoving)            Using marginalisation in distance with uniform-in-comoving-volume prior (compatible with --margphi and --margtimephi)\n\
+    (--vectorised-likelihood)        Sum the frequency bins of each detector with the SIMD kernel from VectorMath\n\
+                                     (Gaussian and --margphi likelihoods without PSD or glitch fitting only)\n\
+    (--likelihood-threads N)         Share the sums of --vectorised-likelihood between N OpenMP threads (default 1;\n\
+                                     results do not depend on N)\n\
+    (--fast-extrinsic-likelihood)    Re-use the inner products of the last waveform when only sky position, polarisation,\n\
+                                     time or distance change (Gaussian and --margphi likelihoods only)\n\
     \n";
 
     /* Print command line arguments if help requested */
@@ -141,6 +190,33 @@ void LALInferenceInitLikelihood(LALInferenceRunState *runState)
 
     REAL8 nullLikelihood = 0.0; // Populated if such a thing exists
 
+   if (LALInferenceGetProcParamVal(commandLine, "--vectorised-likelihood")) {
+     for (INT4 c=0; c < runState->nthreads; c++)
+       LALInferenceAddINT4Variable(runState->threads[c].currentParams, "vectorised_likelihood", 1, LALINFERENCE_PARAM_FIXED);
+   }
+
+   ProcessParamsTable *ppt=LALInferenceGetProcParamVal(commandLine, "--likelihood-threads");
+   if (ppt) {
+     if (!LALInferenceGetProcParamVal(commandLine, "--vectorised-likelihood"))
+       fprintf(stderr, "WARNING: --likelihood-threads has no effect without --vectorised-likelihood.\n");
+     INT4 nthreads = atoi(ppt->value);
+     if (nthreads < 1) {
+       fprintf(stderr, "ERROR: --likelihood-threads must be a positive integer. Exiting...\n");
+       exit(1);
+     }
+#ifndef _OPENMP
+     if (nthreads > 1)
+       fprintf(stderr, "WARNING: --likelihood-threads has no effect, as LALInference was built without OpenMP.\n");
+#endif
+     for (INT4 c=0; c < runState->nthreads; c++)
+       LALInferenceAddINT4Variable(runState->threads[c].currentParams, "likelihood_threads", nthreads, LALINFERENCE_PARAM_FIXED);
+   }
+
+   if (LALInferenceGetProcParamVal(commandLine, "--fast-extrinsic-likelihood")) {
+     for (INT4 c=0; c < runState->nthreads; c++)
+       LALInferenceAddINT4Variable(runState->threads[c].currentParams, "extrinsic_cache", 1, LALINFERENCE_PARAM_FIXED);
+   }
+
    if (LALInferenceGetProcParamVal(commandLine, "--zeroLogLike")) {
     /* Use zero log(L) */
     runState->likelihood=&LALInferenceZeroLogLikelihood;
@@ -394,6 +470,10 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
   if (LALInferenceCheckVariable(currentParams, "constantcal_active") && (*(UINT4 *)LALInferenceGetVariable(currentParams, "constantcal_active"))) {
    constantcal_active = 1;
   }
+  int vectorised_likelihood = LALInferenceCheckVariable(currentParams, "vectorised_likelihood");
+  INT4 likelihood_threads = 1;
+  if (LALInferenceCheckVariable(currentParams, "likelihood_threads"))
+    likelihood_threads = LALInferenceGetINT4Variable(currentParams, "likelihood_threads");
   if (spcal_active && constantcal_active){
     fprintf(stderr,"ERROR: cannot use spline and constant calibration error marginalization together. Exiting...\n");
     exit(1);
@@ -582,6 +662,27 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
   XLALGPSSetREAL8(&GPSlal, GPSdouble);
   gmst=XLALGreenwichMeanSiderealTime(&GPSlal);
 
+  /* If only extrinsic parameters have changed since the waveform was last
+     generated, the inner products are computed from the extrinsic cache */
+  int use_extrinsic_cache = 0;
+  REAL8 cache_ampscale = 1.0;
+  if (signalFlag && !psdFlag && !glitchFlag && !constantcal_active && !model->roq_flag && !model->multiband &&
+      (marginalisationflags==GAUSSIAN || marginalisationflags==MARGPHI) &&
+      LALInferenceCheckVariable(currentParams, "extrinsic_cache") &&
+      LALInferenceGetINT4Variable(currentParams, "extrinsic_cache"))
+  {
+    use_extrinsic_cache = ExtrinsicCacheLookup(model, currentParams, data, spcal_active);
+    if (use_extrinsic_cache < 0) XLAL_ERROR_REAL8(XLAL_EFUNC);
+    if (use_extrinsic_cache && LALInferenceCheckVariable(currentParams, "logdistance"))
+      cache_ampscale = exp(model->extrinsicCache->logdistance - LALInferenceGetREAL8Variable(currentParams, "logdistance"));
+  }
+
+  /* The multibanded likelihood only provides the sums over frequency */
+  if (signalFlag && model->multiband &&
+      (psdFlag || glitchFlag || constantcal_active ||
+       !(marginalisationflags==GAUSSIAN || marginalisationflags==MARGPHI)))
+    XLAL_ERROR_REAL8(XLAL_EINVAL, "Multibanded likelihood does not support noise or glitch fitting, constant calibration or time marginalisation");
+
   chisquared = 0.0;
   REAL8 loglikelihood = 0.0;
 
@@ -626,7 +727,7 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
       /* Check to see if this buffer has already been filled with the signal.
        Different dataPtrs can share the same signal buffer to avoid repeated
        calls to template */
-      if(!checkItemAndAdd((void *)(model->freqhPlus), generatedFreqModels))
+      if(!use_extrinsic_cache && !checkItemAndAdd((void *)(model->freqhPlus), generatedFreqModels))
       {
         /* Compare parameter values with parameter values corresponding  */
         /* to currently stored template; ignore "time" variable:         */
@@ -641,6 +742,7 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
         if(LALInferenceCheckVariable(model->params,"time")) LALInferenceRemoveVariable(model->params,"time");
         LALInferenceAddVariable(model->params, "time", &timeTmp, LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_LINEAR);
 
+        if (model->extrinsicCache) model->extrinsicCache->template_valid = 0;
         XLAL_TRY(model->templt(model),errnum);
         errnum&=~XLAL_EFUNC;
         if(errnum!=XLAL_SUCCESS)
@@ -675,13 +777,14 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
           /* TD --> FD. */
           LALInferenceExecuteFT(model);
         }
+        if (model->extrinsicCache) model->extrinsicCache->template_valid = 1;
       }
 
         /* Template is now in model->timeFreqhPlus and hCross */
 
         /* Calibration stuff if necessary */
         /*spline*/
-        if (spcal_active) {
+        if (spcal_active && !use_extrinsic_cache) {
           logfreqs = NULL;
           amps = NULL;
           phases = NULL;
@@ -695,6 +798,11 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 						model->roq->frequencyNodesQuadratic,
 						&(model->roq->calFactorQuadratic));
 	  }
+	  else if (model->multiband) {
+             LALInferenceSplineCalibrationFactorNodes(logfreqs, amps, phases,
+						model->multiband->frequencies,
+						model->multiband->calFactor);
+	  }
 
 	  else{
 	    if (calFactor == NULL) {
@@ -740,6 +848,8 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 	      freq-domain signal to have tC = epoch, so we shift it
 	      from the model's "time" parameter to epoch */
           timeshift =  (epoch - (*(REAL8 *) LALInferenceGetVariable(model->params, "time"))) + timedelay;
+        else if (use_extrinsic_cache)
+          timeshift =  (GPSdouble - model->extrinsicCache->time) + timedelay;
         else
           timeshift =  (GPSdouble - (*(REAL8*) LALInferenceGetVariable(model->params, "time"))) + timedelay;
         twopit    = LAL_TWOPI * timeshift;
@@ -748,9 +858,9 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
         Fplus*=amp_prefactor;
         Fcross*=amp_prefactor;
 
-        dataPtr->fPlus = Fplus;
-        dataPtr->fCross = Fcross;
-        dataPtr->timeshift = timeshift;
+        model->ifo_fPlus[ifo] = Fplus;
+        model->ifo_fCross[ifo] = Fcross;
+        model->ifo_timeshifts[ifo] = timeshift;
     }//end signalFlag condition
 
     /* determine frequency range & loop over frequency bins: */
@@ -799,37 +909,26 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 
     if (model->roq_flag) {
 
-	double complex weight_iii;
+	/* template at the linear nodes, with calibration if necessary */
+	const UINT4 nlinear = model->roq->frequencyNodesLinear->length;
+	COMPLEX16 *template_linear = model->roq->templateLinear->data;
+	for(unsigned int iii=0; iii < nlinear; iii++){
+		template_linear[iii] = Fplus*model->roq->hptildeLinear->data->data[iii] + Fcross*model->roq->hctildeLinear->data->data[iii];
+		if (spcal_active) template_linear[iii] *= model->roq->calFactorLinear->data[iii];
+	}
+	if (LALInferenceROQLinearInnerProduct(&this_ifo_d_inner_h, dataPtr->roq, template_linear, nlinear, timeshift) != XLAL_SUCCESS)
+		XLAL_ERROR_REAL8(XLAL_EFUNC);
 
 	if (spcal_active){
 
-	    for(unsigned int iii=0; iii < model->roq->frequencyNodesLinear->length; iii++){
-
-			complex double template_EI = model->roq->calFactorLinear->data[iii] * (dataPtr->fPlus*model->roq->hptildeLinear->data->data[iii] + dataPtr->fCross*model->roq->hctildeLinear->data->data[iii] );
-
-			weight_iii = gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_real_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_real_weight_linear) + I*gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_imag_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_imag_weight_linear);
-
-			this_ifo_d_inner_h += ( weight_iii * ( conj( template_EI ) ) );
-		}
-
 		for(unsigned int jjj=0; jjj < model->roq->frequencyNodesQuadratic->length; jjj++){
 
-			this_ifo_s += dataPtr->roq->weightsQuadratic[jjj] * creal( conj( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*dataPtr->fPlus + model->roq->hctildeQuadratic->data->data[jjj]*dataPtr->fCross) ) * ( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*dataPtr->fPlus + model->roq->hctildeQuadratic->data->data[jjj]*dataPtr->fCross) ) );
+			this_ifo_s += dataPtr->roq->weightsQuadratic[jjj] * creal( conj( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*Fplus + model->roq->hctildeQuadratic->data->data[jjj]*Fcross) ) * ( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*Fplus + model->roq->hctildeQuadratic->data->data[jjj]*Fcross) ) );
 		}
 	}
 
 	else{
 
-		for(unsigned int iii=0; iii < model->roq->frequencyNodesLinear->length; iii++){
-
-			complex double template_EI = dataPtr->fPlus*model->roq->hptildeLinear->data->data[iii] + dataPtr->fCross*model->roq->hctildeLinear->data->data[iii];
-
-			weight_iii = gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_real_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_real_weight_linear) + I*gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_imag_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_imag_weight_linear);
-
-			this_ifo_d_inner_h += weight_iii*conj(template_EI) ;
-
-		}
-
 		for(unsigned int jjj=0; jjj < model->roq->frequencyNodesQuadratic->length; jjj++){
 			complex double template_EI = model->roq->hptildeQuadratic->data->data[jjj]*Fplus + model->roq->hctildeQuadratic->data->data[jjj]*Fcross;
 
@@ -898,6 +997,45 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
     REAL8 this_ifo_S=0.0;
     COMPLEX16 this_ifo_Rcplx=0.0;
 
+    /* Without noise or glitch fitting, constant calibration, or time
+       marginalisation, the likelihood only needs sums over the frequency
+       bins, which are taken from the extrinsic cache or the multibanded
+       grids, or, if requested, computed with the SIMD kernel from VectorMath. */
+    if (signalFlag && !psdFlag && !glitchFlag && !constantcal_active &&
+        (marginalisationflags==GAUSSIAN || marginalisationflags==MARGPHI) &&
+        (use_extrinsic_cache || model->multiband || vectorised_likelihood))
+    {
+      COMPLEX16 dh=0.0;
+      REAL8 hh=0.0, dd=0.0, rr=0.0;
+      if (use_extrinsic_cache)
+        ExtrinsicCacheInnerProducts(&dh, &hh, &dd, &rr, &model->extrinsicCache->ifo[ifo],
+                                    Fplus, Fcross, timeshift, cache_ampscale);
+      else if (model->multiband)
+      {
+        if (LALInferenceMultibandInnerProducts(&dh, &hh, model->multiband, dataPtr->multiband,
+                                               Fplus, Fcross, spcal_active ? model->multiband->calFactor->data : NULL,
+                                               timeshift) != XLAL_SUCCESS)
+          XLAL_ERROR_REAL8(XLAL_EFUNC);
+        dd = dataPtr->multiband->dd;
+        rr = dd + hh - 2.0*creal(dh);
+      }
+      else if (FreqDomainInnerProducts(&dh, &hh, &dd, &rr,
+                                  dataPtr->freqData->data->data, model->freqhPlus->data->data,
+                                  model->freqhCross->data->data, spcal_active ? calFactor->data->data : NULL,
+                                  dataPtr->oneSidedNoisePowerSpectrum->data->data, Fplus, Fcross,
+                                  twopit, deltaF, deltaT, TwoDeltaToverN, lower, upper, likelihood_threads) != XLAL_SUCCESS)
+        XLAL_ERROR_REAL8(XLAL_EFUNC);
+      D+=dd;
+      this_ifo_S+=hh;
+      this_ifo_Rcplx+=dh;
+      Rcplx+=dh;
+      if (marginalisationflags==GAUSSIAN)
+      {
+        chisquared += rr;
+        model->ifo_loglikelihoods[ifo] -= rr;
+      }
+    }
+    else
     for (i=lower,chisq=0.0,re = cos(twopit*deltaF*i),im = -sin(twopit*deltaF*i);
          i<=upper;
          i++, psd++, hptilde++, hctilde++, dtilde++,
@@ -1432,7 +1570,6 @@ double LALInferenceMarginalDistanceLogLikelihood(double dist_min, double dist_ma
                 log_norm = log_radial_integrator_eval(integrator, 0, 0, -INFINITY, -INFINITY);
             }
         }
-        #pragma omp barrier
         if (!integrator) XLAL_ERROR(XLAL_EFUNC, "Unable to initialise distance marginalisation integrator");
         
         if (isnan(OptimalSNR) || isnan(d_inner_h) || pmax<OptimalSNR)
@@ -1478,6 +1615,367 @@ double LALInferenceMarginalDistanceLogLikelihood(double dist_min, double dist_ma
 /*        frequencies)                                         */
 /***************************************************************/
 
+/* Length of the blocks of frequency bins summed by FreqDomainInnerProducts() */
+#define INNER_PRODUCT_BLOCK_LENGTH 1024
+
+/* Number of blocks whose sums FreqDomainInnerProducts() holds at a time */
+#define INNER_PRODUCT_GROUP_LENGTH 64
+
+/*
+ * Computes the sums over frequency bins lower..upper of the likelihood
+ * terms of one detector: with template h = calF*(Fplus*hptilde + Fcross*hctilde)
+ * shifted by exp(-i*twopit*f), and sigmasq = psd*deltaT^2,
+ *   dh = TwoDeltaToverN * sum d * conj(h) / sigmasq
+ *   hh = TwoDeltaToverN * sum |h|^2 / sigmasq
+ *   dd = TwoDeltaToverN * sum |d|^2 / sigmasq
+ *   rr = TwoDeltaToverN * sum |d - h|^2 / sigmasq
+ * calF may be NULL if there is no calibration correction.
+ *
+ * The bins are summed in blocks of INNER_PRODUCT_BLOCK_LENGTH by
+ * XLALVectorTimeShiftedInnerProductsCOMPLEX16(), which restarts the
+ * time-shift recurrence at the exact phase of the first bin of each block.
+ * With nthreads > 1 each group of INNER_PRODUCT_GROUP_LENGTH blocks is
+ * shared between OpenMP threads; the sums of each block are always added in
+ * block order, so that the result is identical for any number of threads.
+ */
+static int FreqDomainInnerProducts(COMPLEX16 *dh, REAL8 *hh, REAL8 *dd, REAL8 *rr,
+                                   const COMPLEX16 *dtilde, const COMPLEX16 *hptilde, const COMPLEX16 *hctilde,
+                                   const COMPLEX16 *calF, const REAL8 *psd, REAL8 Fplus, REAL8 Fcross,
+                                   REAL8 twopit, REAL8 deltaF, REAL8 deltaT, REAL8 TwoDeltaToverN,
+                                   UINT4 lower, UINT4 upper, INT4 nthreads)
+{
+  *dh = 0.0;
+  *hh = *dd = *rr = 0.0;
+  if (upper < lower) return XLAL_SUCCESS;
+
+  const UINT4 nblocks = (upper - lower + INNER_PRODUCT_BLOCK_LENGTH) / INNER_PRODUCT_BLOCK_LENGTH;
+  COMPLEX16 group_dh[INNER_PRODUCT_GROUP_LENGTH];
+  REAL8 group_sums[3*INNER_PRODUCT_GROUP_LENGTH];
+  if (nthreads < 1) nthreads = 1;
+
+  int errors = 0;
+  for (UINT4 b0 = 0; b0 < nblocks && errors == 0; b0 += INNER_PRODUCT_GROUP_LENGTH)
+  {
+    const UINT4 ngroup = (nblocks - b0 < INNER_PRODUCT_GROUP_LENGTH) ? nblocks - b0 : INNER_PRODUCT_GROUP_LENGTH;
+
+#pragma omp parallel for schedule(static) num_threads(nthreads) if(nthreads > 1) reduction(+:errors)
+    for (UINT4 g = 0; g < ngroup; g++)
+    {
+      COMPLEX16 template[INNER_PRODUCT_BLOCK_LENGTH];
+      REAL8 weight[INNER_PRODUCT_BLOCK_LENGTH];
+      const UINT4 b = b0 + g;
+      const UINT4 start = lower + b*INNER_PRODUCT_BLOCK_LENGTH;
+      const UINT4 len = (b + 1 < nblocks) ? INNER_PRODUCT_BLOCK_LENGTH : upper + 1 - start;
+
+      for (UINT4 k = 0; k < len; k++)
+      {
+        template[k] = Fplus*hptilde[start+k] + Fcross*hctilde[start+k];
+        if (calF) template[k] *= calF[start+k];
+        weight[k] = TwoDeltaToverN/(psd[start+k]*deltaT*deltaT);
+      }
+
+      if (XLALVectorTimeShiftedInnerProductsCOMPLEX16(&group_dh[g], &group_sums[3*g], &group_sums[3*g+1], &group_sums[3*g+2],
+                                                      &dtilde[start], template, weight,
+                                                      -twopit*deltaF*start, -twopit*deltaF, len) != XLAL_SUCCESS)
+        errors++;
+    }
+
+    for (UINT4 g = 0; g < ngroup; g++)
+    {
+      *dh += group_dh[g];
+      *hh += group_sums[3*g];
+      *dd += group_sums[3*g+1];
+      *rr += group_sums[3*g+2];
+    }
+  }
+
+  XLAL_CHECK(errors == 0, XLAL_EFUNC);
+
+  return XLAL_SUCCESS;
+}
+
+/*
+ * The weights are interpolated in time with a 4-point cubic, so that <d|h>
+ * is the same combination of the dot products of the template with the
+ * weights at the 4 nearest time steps; these are evaluated with the SIMD
+ * kernel from VectorMath.
+ */
+int LALInferenceROQLinearInnerProduct(COMPLEX16 *dh, const LALInferenceROQData *roq, const COMPLEX16 *template_linear,
+                                      UINT4 nlinear, REAL8 timeshift)
+{
+  XLAL_CHECK(nlinear == roq->n_basis_linear, XLAL_EBADLEN, "Template has %u linear nodes, but the weights have %u", nlinear, roq->n_basis_linear);
+
+  const INT4 nsteps = roq->n_time_steps;
+  const REAL8 u = (timeshift - roq->time_step_start)/roq->time_step_size;
+  XLAL_CHECK(u >= 0 && u <= nsteps - 1, XLAL_EDOM, "Time shift %g is outside the range of the ROQ weights", timeshift);
+
+  /* first of the 4 time steps; at the ends of the grid the stencil is
+     shifted inwards and the cubic is evaluated off-centre */
+  INT4 j = (INT4)floor(u) - 1;
+  if (j < 0) j = 0;
+  if (j > nsteps - 4) j = nsteps - 4;
+  const REAL8 x = u - j;
+
+  /* Lagrange coefficients for the time steps j .. j+3 */
+  const REAL8 c[4] = { -(x-1.0)*(x-2.0)*(x-3.0)/6.0,
+                       x*(x-2.0)*(x-3.0)/2.0,
+                       -x*(x-1.0)*(x-3.0)/2.0,
+                       x*(x-1.0)*(x-2.0)/6.0 };
+
+  *dh = 0.0;
+  for (UINT4 m = 0; m < 4; m++)
+  {
+    COMPLEX16 wh;
+    XLAL_CHECK(XLALVectorDotProductCOMPLEX16(&wh, &roq->weightsLinear[(j + m)*nlinear], template_linear, nlinear) == XLAL_SUCCESS, XLAL_EFUNC);
+    *dh += c[m]*wh;
+  }
+
+  return XLAL_SUCCESS;
+}
+
+/* Parameters on which the cached inner products do not depend */
+static const char *extrinsic_cache_params[] = {"rightascension", "declination", "polarisation", "time",
+                                               "t0", "cosalpha", "azimuth", "logdistance",
+                                               "hrss", "loghrss", NULL};
+
+/* Is item a sampled parameter which changes the waveform? */
+static int ExtrinsicCacheIsIntrinsic(const LALInferenceVariableItem *item)
+{
+  if (item->type != LALINFERENCE_REAL8_t) return 0;
+  if (item->vary != LALINFERENCE_PARAM_LINEAR && item->vary != LALINFERENCE_PARAM_CIRCULAR) return 0;
+  for (UINT4 i = 0; extrinsic_cache_params[i]; i++)
+    if (!strcmp(item->name, extrinsic_cache_params[i])) return 0;
+  return 1;
+}
+
+/* Do the intrinsic parameters in params have the values stored in key? */
+static int ExtrinsicCacheMatch(LALInferenceVariables *key, LALInferenceVariables *params)
+{
+  INT4 n = 0;
+  for (LALInferenceVariableItem *item = params->head; item; item = item->next)
+  {
+    if (!ExtrinsicCacheIsIntrinsic(item)) continue;
+    if (!LALInferenceCheckVariable(key, item->name)) return 0;
+    if (LALInferenceGetREAL8Variable(key, item->name) != *(REAL8 *)item->value) return 0;
+    n++;
+  }
+  return n == key->dimension;
+}
+
+/*
+ * Fills the cache from the waveform in the model buffers.  For each
+ * detector, with h = calF*h+ (or calF*hx) and a_k = w_k d_k conj(h_k),
+ * w_k = TwoDeltaToverN/(psd_k*deltaT^2), one inverse FFT gives
+ *   <d|h>(tau) = sum_k a_k exp(2 pi i k deltaF tau)
+ * at tau = j/(EXTRINSIC_CACHE_OVERSAMPLING*N*deltaF), which is the dh sum of
+ * FreqDomainInnerProducts() for a time shift tau.  The <h|h> sums do not
+ * depend on the time shift.
+ */
+static int ExtrinsicCacheBuild(LALInferenceExtrinsicCache *cache, LALInferenceModel *model,
+                               LALInferenceVariables *currentParams, LALInferenceIFOData *data,
+                               UINT4 spcal_active)
+{
+  LALInferenceIFOData *dataPtr;
+  UINT4 nifo = 0;
+
+  cache->valid = 0;
+  for (dataPtr = data; dataPtr; dataPtr = dataPtr->next) nifo++;
+  if (cache->nifo != nifo)
+  {
+    for (UINT4 i = 0; i < cache->nifo; i++)
+    {
+      XLALDestroyCOMPLEX16Vector(cache->ifo[i].dhplus);
+      XLALDestroyCOMPLEX16Vector(cache->ifo[i].dhcross);
+    }
+    XLALFree(cache->ifo);
+    cache->nifo = 0;
+    cache->ifo = XLALCalloc(nifo, sizeof(*cache->ifo));
+    XLAL_CHECK(cache->ifo, XLAL_ENOMEM);
+    cache->nifo = nifo;
+  }
+
+  UINT4 ifo;
+  for (dataPtr = data, ifo = 0; dataPtr; dataPtr = dataPtr->next, ifo++)
+  {
+    ExtrinsicCacheIFO *c = &cache->ifo[ifo];
+    const REAL8 deltaT = dataPtr->timeData->deltaT;
+    const UINT4 time_length = dataPtr->timeData->data->length;
+    const UINT4 N = EXTRINSIC_CACHE_OVERSAMPLING*time_length;
+    const REAL8 deltaF = 1.0 / (((double)time_length) * deltaT);
+    const UINT4 lower = (UINT4)ceil(dataPtr->fLow / deltaF);
+    const UINT4 upper = (UINT4)floor(dataPtr->fHigh / deltaF);
+    const REAL8 TwoDeltaToverN = 2.0 * deltaT / ((double) time_length);
+    const COMPLEX16 *dtilde = dataPtr->freqData->data->data;
+    const COMPLEX16 *hptilde = model->freqhPlus->data->data;
+    const COMPLEX16 *hctilde = model->freqhCross->data->data;
+    const REAL8 *psd = dataPtr->oneSidedNoisePowerSpectrum->data->data;
+
+    if (c->dhplus == NULL || c->dhplus->length != N)
+    {
+      XLALDestroyCOMPLEX16Vector(c->dhplus);
+      XLALDestroyCOMPLEX16Vector(c->dhcross);
+      c->dhplus = XLALCreateCOMPLEX16Vector(N);
+      c->dhcross = XLALCreateCOMPLEX16Vector(N);
+      XLAL_CHECK(c->dhplus && c->dhcross, XLAL_ENOMEM);
+    }
+    c->deltaF = deltaF;
+    c->hplushplus = c->hcrosshcross = c->hplushcross = c->dd = 0.0;
+
+    COMPLEX16FrequencySeries *calFactor = NULL;
+    if (spcal_active)
+    {
+      REAL8Vector *logfreqs = NULL, *amps = NULL, *phases = NULL;
+      calFactor = XLALCreateCOMPLEX16FrequencySeries("calibration factors", &(dataPtr->freqData->epoch),
+                                                     0, dataPtr->freqData->deltaF, &lalDimensionlessUnit,
+                                                     dataPtr->freqData->data->length);
+      XLAL_CHECK(calFactor, XLAL_EFUNC);
+      get_calib_spline(currentParams, dataPtr->name, &logfreqs, &amps, &phases);
+      LALInferenceSplineCalibrationFactor(logfreqs, amps, phases, calFactor);
+      XLALDestroyREAL8Vector(logfreqs);
+      XLALDestroyREAL8Vector(amps);
+      XLALDestroyREAL8Vector(phases);
+    }
+
+    COMPLEX16Vector *aplus = XLALCreateCOMPLEX16Vector(N);
+    COMPLEX16Vector *across = XLALCreateCOMPLEX16Vector(N);
+    COMPLEX16FFTPlan *plan = XLALGetCachedCOMPLEX16FFTPlan(N, 0, 0);
+    if (aplus == NULL || across == NULL || plan == NULL)
+    {
+      XLALDestroyCOMPLEX16Vector(aplus);
+      XLALDestroyCOMPLEX16Vector(across);
+      XLALReleaseCachedCOMPLEX16FFTPlan(plan);
+      XLALDestroyCOMPLEX16FrequencySeries(calFactor);
+      XLAL_ERROR(XLAL_EFUNC);
+    }
+    memset(aplus->data, 0, N*sizeof(*aplus->data));
+    memset(across->data, 0, N*sizeof(*across->data));
+
+    for (UINT4 k = lower; k <= upper; k++)
+    {
+      const REAL8 w = TwoDeltaToverN/(psd[k]*deltaT*deltaT);
+      COMPLEX16 hp = hptilde[k], hc = hctilde[k];
+      if (calFactor)
+      {
+        hp *= calFactor->data->data[k];
+        hc *= calFactor->data->data[k];
+      }
+      aplus->data[k] = w*dtilde[k]*conj(hp);
+      across->data[k] = w*dtilde[k]*conj(hc);
+      c->hplushplus += w*(creal(hp)*creal(hp) + cimag(hp)*cimag(hp));
+      c->hcrosshcross += w*(creal(hc)*creal(hc) + cimag(hc)*cimag(hc));
+      c->hplushcross += w*creal(hp*conj(hc));
+      c->dd += w*(creal(dtilde[k])*creal(dtilde[k]) + cimag(dtilde[k])*cimag(dtilde[k]));
+    }
+
+    int errnum = XLAL_SUCCESS;
+    if (XLALCOMPLEX16VectorFFT(c->dhplus, aplus, plan) != XLAL_SUCCESS ||
+        XLALCOMPLEX16VectorFFT(c->dhcross, across, plan) != XLAL_SUCCESS)
+      errnum = XLAL_EFUNC;
+
+    XLALDestroyCOMPLEX16Vector(aplus);
+    XLALDestroyCOMPLEX16Vector(across);
+    XLALReleaseCachedCOMPLEX16FFTPlan(plan);
+    XLALDestroyCOMPLEX16FrequencySeries(calFactor);
+    XLAL_CHECK(errnum == XLAL_SUCCESS, errnum);
+  }
+
+  LALInferenceClearVariables(&cache->intrinsic);
+  for (LALInferenceVariableItem *item = currentParams->head; item; item = item->next)
+    if (ExtrinsicCacheIsIntrinsic(item))
+      LALInferenceAddVariable(&cache->intrinsic, item->name, item->value, item->type, item->vary);
+  cache->logdistance = 0.0;
+  if (LALInferenceCheckVariable(model->params, "logdistance"))
+    cache->logdistance = LALInferenceGetREAL8Variable(model->params, "logdistance");
+  cache->time = LALInferenceGetREAL8Variable(model->params, "time");
+  cache->valid = 1;
+
+  return XLAL_SUCCESS;
+}
+
+/*
+ * Returns 1 if the likelihood of currentParams can be computed from the
+ * extrinsic cache of the model, building the cache from the model buffers
+ * if they hold a waveform with the same intrinsic parameters, and 0 if the
+ * waveform has to be generated.  The cache is allocated on first use.
+ */
+static int ExtrinsicCacheLookup(LALInferenceModel *model, LALInferenceVariables *currentParams,
+                                LALInferenceIFOData *data, UINT4 spcal_active)
+{
+  if (model->extrinsicCache == NULL)
+  {
+    model->extrinsicCache = XLALCalloc(1, sizeof(*model->extrinsicCache));
+    XLAL_CHECK(model->extrinsicCache, XLAL_ENOMEM);
+  }
+  LALInferenceExtrinsicCache *cache = model->extrinsicCache;
+
+  if (cache->valid && ExtrinsicCacheMatch(&cache->intrinsic, currentParams))
+    return 1;
+
+  /* Only build the cache when the same waveform is requested a second
+     time, so that points which are only visited once cost no FFTs */
+  if (!cache->template_valid || !LALInferenceCheckVariable(model->params, "time"))
+    return 0;
+  LALInferenceVariables key;
+  memset(&key, 0, sizeof(key));
+  for (LALInferenceVariableItem *item = model->params->head; item; item = item->next)
+    if (ExtrinsicCacheIsIntrinsic(item))
+      LALInferenceAddVariable(&key, item->name, item->value, item->type, item->vary);
+  const int match = ExtrinsicCacheMatch(&key, currentParams);
+  LALInferenceClearVariables(&key);
+  if (!match)
+    return 0;
+
+  XLAL_CHECK(ExtrinsicCacheBuild(cache, model, currentParams, data, spcal_active) == XLAL_SUCCESS, XLAL_EFUNC);
+  return 1;
+}
+
+void LALInferenceDestroyExtrinsicCache(LALInferenceExtrinsicCache *cache)
+{
+  if (cache == NULL) return;
+  for (UINT4 i = 0; i < cache->nifo; i++)
+  {
+    XLALDestroyCOMPLEX16Vector(cache->ifo[i].dhplus);
+    XLALDestroyCOMPLEX16Vector(cache->ifo[i].dhcross);
+  }
+  XLALFree(cache->ifo);
+  LALInferenceClearVariables(&cache->intrinsic);
+  XLALFree(cache);
+}
+
+/* Lagrange interpolation of the periodic series z at fractional index u */
+static COMPLEX16 ExtrinsicCacheInterpolate(const COMPLEX16Vector *z, REAL8 u)
+{
+  const UINT4 N = z->length;
+  u = fmod(u, (REAL8)N);
+  if (u < 0) u += N;
+  UINT4 j = (UINT4)floor(u);
+  const REAL8 x = u - j;
+  const UINT4 jm = (j + N - 1) % N, j0 = j % N, j1 = (j + 1) % N, j2 = (j + 2) % N;
+  return - x*(x-1.0)*(x-2.0)/6.0 * z->data[jm]
+         + (x+1.0)*(x-1.0)*(x-2.0)/2.0 * z->data[j0]
+         - (x+1.0)*x*(x-2.0)/2.0 * z->data[j1]
+         + (x+1.0)*x*(x-1.0)/6.0 * z->data[j2];
+}
+
+/*
+ * Computes the sums of FreqDomainInnerProducts() from the cache, for a
+ * waveform time-shifted by timeshift relative to the cached one and with
+ * amplitude scaled by ampscale.  The time shift is interpolated between the
+ * samples of the oversampled <d|h> series with a cubic; the relative error
+ * of dh is below 1e-5 at 300 Hz and 5e-4 at 1 kHz for 4096 Hz data.
+ */
+static void ExtrinsicCacheInnerProducts(COMPLEX16 *dh, REAL8 *hh, REAL8 *dd, REAL8 *rr,
+                                        const ExtrinsicCacheIFO *cache, REAL8 Fplus, REAL8 Fcross,
+                                        REAL8 timeshift, REAL8 ampscale)
+{
+  const REAL8 u = timeshift * cache->deltaF * cache->dhplus->length;
+  *dh = ampscale*(Fplus*ExtrinsicCacheInterpolate(cache->dhplus, u) + Fcross*ExtrinsicCacheInterpolate(cache->dhcross, u));
+  *hh = ampscale*ampscale*(Fplus*Fplus*cache->hplushplus + Fcross*Fcross*cache->hcrosshcross
+                           + 2.0*Fplus*Fcross*cache->hplushcross);
+  *dd = cache->dd;
+  *rr = *dd + *hh - 2.0*creal(*dh);
+}
+
 REAL8 LALInferenceFreqDomainStudentTLogLikelihood(LALInferenceVariables *currentParams,
                                                     LALInferenceIFOData *data,
                                                     LALInferenceModel *model)
@@ -1805,9 +2303,9 @@ REAL8 LALInferenceFastSineGaussianLogLikelihood(LALInferenceVariables *currentPa
       Fplus*=amp_prefactor;
       Fcross*=amp_prefactor;
 
-      dataPtr->fPlus = Fplus;
-      dataPtr->fCross = Fcross;
-      dataPtr->timeshift = timeshift;
+      model->ifo_fPlus[ifo] = Fplus;
+      model->ifo_fCross[ifo] = Fcross;
+      model->ifo_timeshifts[ifo] = timeshift;
 
 
       /* determine frequency range & loop over frequency bins: */
@@ -2032,8 +2530,8 @@ void LALInferenceNetworkSNR(LALInferenceVariables *currentParams,
     /* determine beam pattern response (F_plus and F_cross) for given Ifo: */
     XLALComputeDetAMResponse(&Fplus, &Fcross, (const REAL4(*)[3])dataPtr->detector->response, ra, dec, psi, gmst);
 
-    dataPtr->fPlus = Fplus;
-    dataPtr->fCross = Fcross;
+    model->ifo_fPlus[ifo] = Fplus;
+    model->ifo_fCross[ifo] = Fcross;
 
     /* determine frequency range & loop over frequency bins: */
     deltaT = dataPtr->timeData->deltaT;
@@ -207,8 +207,20 @@ REAL8 LALInferenceFastSineGaussianLogLikelihood(LALInferenceVariables *currentPa
                                                         LALInferenceIFOData *data,
                                                         LALInferenceModel *model);
 
+/**
+ * Compute the ROQ approximation to <d|h> for the time shift \c timeshift,
+ * from the template at the \c nlinear linear frequency nodes and the linear
+ * weights of \c roq, which are tabulated on a uniform grid of time shifts.
+ * Returns XLAL_EDOM if \c timeshift is outside the grid.
+ */
+int LALInferenceROQLinearInnerProduct(COMPLEX16 *dh, const LALInferenceROQData *roq, const COMPLEX16 *template_linear,
+                                      UINT4 nlinear, REAL8 timeshift);
+
 /** Calculate the SNR across the network */
 void LALInferenceNetworkSNR(LALInferenceVariables *currentParams, LALInferenceIFOData *data, LALInferenceModel *model);
+
+/** Free the inner products cached for --fast-extrinsic-likelihood in LALInferenceModel::extrinsicCache */
+void LALInferenceDestroyExtrinsicCache(struct tagLALInferenceExtrinsicCache *cache);
 /** @} */
 
 #endif
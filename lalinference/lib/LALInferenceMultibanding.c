@@ -7,6 +7,8 @@
 //
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <lal/Date.h>
 #include <lal/GenerateInspiral.h>
 #include <lal/LALInference.h>
@@ -18,6 +20,19 @@
 #include <lal/LALDatatypes.h>
 #include <lal/Sequence.h>
 #include <lal/LALInferenceMultibanding.h>
+#include <lal/LALInferencePrior.h>
+#include <lal/ComplexFFT.h>
+#include <lal/FFTPlanCache.h>
+#include <lal/VectorMath.h>
+#include <lal/LALConstants.h>
+#include <complex.h>
+#include <math.h>
+
+/* Width (Hz) of the tapers over which neighbouring bands of the multibanded likelihood overlap.
+   The taper spreads the part of the signal in a band over about 4/MULTIBAND_TAPER_WIDTH in
+   time, which is allowed for when choosing the node spacing of each band. */
+#define MULTIBAND_TAPER_WIDTH 8.0
+#define MULTIBAND_TAPER_TIME (4.0/MULTIBAND_TAPER_WIDTH)
 
 
 /** F(t) and T(f) for newtonian waveform */
@@ -137,3 +152,398 @@ REAL8Sequence *LALInferenceMultibandFrequencies(int NBands, double f_min, double
     return(Frequencies);
     
 }
+
+
+/* Time to merger (seconds, with the safety factor above) and its inverse, for chirp mass mc (seconds) */
+static double MultibandChirpTime(double mc, double f)
+{
+    return -LALInferenceTimeFrequencyRelation(mc, f, 0);
+}
+
+static double MultibandChirpFrequency(double mc, double t)
+{
+    return 1.1*LALInferenceTimeFrequencyRelation(mc, -t, 1);
+}
+
+/* Window of a band which rises over [limits[0], limits[1]] and falls over [limits[2], limits[3]].
+   The windows of neighbouring bands taper as sin^2 and cos^2, so they sum to one. */
+static REAL8 MultibandWindow(const REAL8 *limits, REAL8 f)
+{
+    if (f <= limits[0] || f >= limits[3]) return 0.0;
+    if (f < limits[1]) {
+        REAL8 x = sin(0.5*LAL_PI*(f - limits[0])/(limits[1] - limits[0]));
+        return x*x;
+    }
+    if (f > limits[2]) {
+        REAL8 x = cos(0.5*LAL_PI*(f - limits[2])/(limits[3] - limits[2]));
+        return x*x;
+    }
+    return 1.0;
+}
+
+static int MultibandCompareBins(const void *a, const void *b)
+{
+    UINT4 x = *(const UINT4 *)a, y = *(const UINT4 *)b;
+    return (x > y) - (x < y);
+}
+
+/*
+ * The multibanded likelihood (see S. Morisaki, Phys. Rev. D 104, 044062 (2021)) splits the
+ * template into bands h_b = w_b h with windows w_b summing to one.  If the time shift differs
+ * by delta from time_reference, h_b shifted by delta lasts less than T/2^n_b before the merger
+ * plus the post-merger margin.  Inside that time window the shifted h_b is then determined by
+ * its values at every 2^n_b-th frequency bin, so <d|h_b> is a sum over those nodes only, with
+ * weights obtained from the data once.  <h_b|h_b> is computed by interpolating |h|^2 linearly
+ * between the nodes, as it does not oscillate.
+ */
+LALInferenceMultibandModel *LALInferenceCreateMultibandModel(REAL8 f_min, REAL8 f_max, REAL8 deltaT, UINT4 length,
+                                                             REAL8 mc_min, REAL8 time_reference, REAL8 time_margin)
+{
+    XLAL_CHECK_NULL(length > 0 && deltaT > 0.0, XLAL_EINVAL, "Invalid data length %u or sampling interval %g", length, deltaT);
+    XLAL_CHECK_NULL(f_min > 0.0 && f_max > f_min && f_max + MULTIBAND_TAPER_WIDTH < 1.0/deltaT, XLAL_EINVAL,
+                    "Invalid frequency range [%g, %g] Hz", f_min, f_max);
+    XLAL_CHECK_NULL(mc_min > 0.0 && time_margin >= 0.0, XLAL_EINVAL, "Invalid chirp mass %g or time margin %g", mc_min, time_margin);
+
+    const REAL8 T = length*deltaT;
+    const REAL8 deltaF = 1.0/T;
+    const REAL8 mc = mc_min*LAL_MTSUN_SI;
+    /* each band covers the time after the merger plus the time margin and the spread due to the
+       tapers, and the same before the start of the signal in the band */
+    const REAL8 t_extra = 2.0*(time_margin + MULTIBAND_TAPER_TIME);
+    /* the taper below f_min must not reach zero frequency */
+    const REAL8 taper_low = fmin(MULTIBAND_TAPER_WIDTH, 0.5*f_min);
+
+    /* the node spacing 2^n bins must divide the data length */
+    UINT4 nmax = 0;
+    while (nmax < 31 && length % (2u << nmax) == 0) nmax++;
+
+    UINT4 shift[32];
+    REAL8 edge[33];
+    UINT4 nbands = 1;
+    shift[0] = 0;
+    while (shift[0] < nmax && T/(2u << shift[0]) >= MultibandChirpTime(mc, f_min - taper_low) + t_extra) shift[0]++;
+    edge[0] = f_min - taper_low;
+    while (shift[nbands-1] < nmax) {
+        REAL8 Tnext = T/(2u << shift[nbands-1]);
+        if (Tnext <= t_extra) break;
+        REAL8 F = MultibandChirpFrequency(mc, Tnext - t_extra);
+        REAL8 flat = nbands == 1 ? f_min : edge[nbands-1] + MULTIBAND_TAPER_WIDTH;
+        if (F < flat) F = flat;
+        if (F + MULTIBAND_TAPER_WIDTH >= f_max) break;
+        edge[nbands] = F;
+        shift[nbands] = shift[nbands-1] + 1;
+        nbands++;
+    }
+
+    LALInferenceMultibandModel *mb = XLALCalloc(1, sizeof(*mb));
+    XLAL_CHECK_NULL(mb != NULL, XLAL_ENOMEM);
+    mb->nbands = nbands;
+    mb->length = length;
+    mb->deltaT = deltaT;
+    mb->time_reference = time_reference;
+    mb->time_margin = time_margin;
+    mb->shift = XLALMalloc(nbands*sizeof(UINT4));
+    mb->first_bin = XLALMalloc(nbands*sizeof(UINT4));
+    mb->band_offset = XLALMalloc((nbands + 1)*sizeof(UINT4));
+    mb->band_limits = XLALMalloc(4*nbands*sizeof(REAL8));
+    if (mb->shift == NULL || mb->first_bin == NULL || mb->band_offset == NULL || mb->band_limits == NULL) {
+        LALInferenceDestroyMultibandModel(mb);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+
+    /* nodes of each band, covering the support of its window */
+    mb->band_offset[0] = 0;
+    for (UINT4 b = 0; b < nbands; b++) {
+        REAL8 *limits = &mb->band_limits[4*b];
+        limits[0] = edge[b];
+        limits[1] = b == 0 ? f_min : edge[b] + MULTIBAND_TAPER_WIDTH;
+        limits[2] = b + 1 < nbands ? edge[b+1] : f_max;
+        limits[3] = limits[2] + MULTIBAND_TAPER_WIDTH;
+
+        const UINT4 step = 1u << shift[b];
+        UINT4 k0 = (UINT4)floor(limits[0]/(deltaF*step));
+        UINT4 k1 = (UINT4)ceil(limits[3]/(deltaF*step));
+        if (k0 == 0) k0 = 1;
+        if (k1*step >= length) k1 = (length - 1)/step;
+        mb->shift[b] = shift[b];
+        mb->first_bin[b] = k0*step;
+        mb->band_offset[b+1] = mb->band_offset[b] + (k1 - k0 + 1);
+    }
+
+    const UINT4 nnodes = mb->band_offset[nbands];
+    UINT4 *bins = XLALMalloc(nnodes*sizeof(UINT4));
+    mb->node_index = XLALMalloc(nnodes*sizeof(UINT4));
+    mb->window = XLALMalloc(nnodes*sizeof(REAL8));
+    if (bins == NULL || mb->node_index == NULL || mb->window == NULL) {
+        XLALFree(bins);
+        LALInferenceDestroyMultibandModel(mb);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+    for (UINT4 b = 0; b < nbands; b++)
+        for (UINT4 m = mb->band_offset[b]; m < mb->band_offset[b+1]; m++) {
+            bins[m] = mb->first_bin[b] + ((m - mb->band_offset[b]) << mb->shift[b]);
+            mb->window[m] = MultibandWindow(&mb->band_limits[4*b], bins[m]*deltaF);
+        }
+
+    /* the bands overlap, so the template is generated at the union of their nodes */
+    UINT4 *sorted = XLALMalloc(nnodes*sizeof(UINT4));
+    if (sorted == NULL) {
+        XLALFree(bins);
+        LALInferenceDestroyMultibandModel(mb);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+    memcpy(sorted, bins, nnodes*sizeof(UINT4));
+    qsort(sorted, nnodes, sizeof(UINT4), MultibandCompareBins);
+    UINT4 nfreq = 0;
+    for (UINT4 m = 0; m < nnodes; m++)
+        if (nfreq == 0 || sorted[m] != sorted[nfreq-1]) sorted[nfreq++] = sorted[m];
+    for (UINT4 m = 0; m < nnodes; m++)
+        mb->node_index[m] = (UINT4)((UINT4 *)bsearch(&bins[m], sorted, nfreq, sizeof(UINT4), MultibandCompareBins) - sorted);
+
+    UINT4 maxcount = 0;
+    for (UINT4 b = 0; b < nbands; b++)
+        if (mb->band_offset[b+1] - mb->band_offset[b] > maxcount) maxcount = mb->band_offset[b+1] - mb->band_offset[b];
+
+    mb->frequencies = XLALCreateREAL8Sequence(nfreq);
+    mb->calFactor = XLALCreateCOMPLEX16Sequence(nfreq);
+    mb->template = XLALCreateCOMPLEX16Sequence(maxcount);
+    if (mb->frequencies == NULL || mb->calFactor == NULL || mb->template == NULL) {
+        XLALFree(bins);
+        XLALFree(sorted);
+        LALInferenceDestroyMultibandModel(mb);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+    for (UINT4 i = 0; i < nfreq; i++) {
+        mb->frequencies->data[i] = sorted[i]*deltaF;
+        mb->calFactor->data[i] = 1.0;
+    }
+    XLALFree(bins);
+    XLALFree(sorted);
+
+    printf("MULTIBANDED LIKELIHOOD ACTIVATED: %u bands, template computed at %u frequencies instead of %u\n",
+           nbands, nfreq, (UINT4)(floor(f_max/deltaF) - ceil(f_min/deltaF)) + 1);
+
+    return mb;
+}
+
+void LALInferenceDestroyMultibandModel(LALInferenceMultibandModel *mb)
+{
+    if (mb == NULL) return;
+    if (mb->frequencies) XLALDestroyREAL8Sequence(mb->frequencies);
+    if (mb->calFactor) XLALDestroyCOMPLEX16Sequence(mb->calFactor);
+    if (mb->template) XLALDestroyCOMPLEX16Sequence(mb->template);
+    if (mb->hptilde) XLALDestroyCOMPLEX16FrequencySeries(mb->hptilde);
+    if (mb->hctilde) XLALDestroyCOMPLEX16FrequencySeries(mb->hctilde);
+    XLALFree(mb->shift);
+    XLALFree(mb->first_bin);
+    XLALFree(mb->band_offset);
+    XLALFree(mb->node_index);
+    XLALFree(mb->window);
+    XLALFree(mb->band_limits);
+    XLALFree(mb);
+}
+
+LALInferenceMultibandData *LALInferenceCreateMultibandData(const LALInferenceMultibandModel *mb, const LALInferenceIFOData *data)
+{
+    XLAL_CHECK_NULL(mb != NULL && data != NULL, XLAL_EFAULT);
+    XLAL_CHECK_NULL(data->timeData->data->length == mb->length && fabs(data->timeData->deltaT - mb->deltaT) <= 1e-9*mb->deltaT,
+                    XLAL_EBADLEN, "Data of %s do not match the multiband layout", data->name);
+
+    const UINT4 N = mb->length;
+    const REAL8 deltaT = mb->deltaT;
+    const REAL8 deltaF = 1.0/(N*deltaT);
+    const REAL8 TwoDeltaToverN = 2.0*deltaT/((REAL8)N);
+    const UINT4 lower = (UINT4)ceil(data->fLow/deltaF);
+    UINT4 upper = (UINT4)floor(data->fHigh/deltaF);
+    if (upper >= data->freqData->data->length) upper = data->freqData->data->length - 1;
+    const REAL8 *psd = data->oneSidedNoisePowerSpectrum->data->data;
+    const COMPLEX16 *dtilde = data->freqData->data->data;
+    /* number of samples after the merger in the time window of each band */
+    const UINT4 npost = (UINT4)ceil((mb->time_margin + MULTIBAND_TAPER_TIME)/deltaT);
+    const UINT4 nnodes = mb->band_offset[mb->nbands];
+
+    LALInferenceMultibandData *mbdata = XLALCalloc(1, sizeof(*mbdata));
+    COMPLEX16Vector *a = XLALCreateCOMPLEX16Vector(N);
+    COMPLEX16Vector *ahat = XLALCreateCOMPLEX16Vector(N);
+    COMPLEX16FFTPlan *plan = XLALGetCachedCOMPLEX16FFTPlan(N, 0, 0);
+    if (mbdata == NULL || a == NULL || ahat == NULL || plan == NULL) {
+        XLALFree(mbdata);
+        if (a) XLALDestroyCOMPLEX16Vector(a);
+        if (ahat) XLALDestroyCOMPLEX16Vector(ahat);
+        if (plan) XLALReleaseCachedCOMPLEX16FFTPlan(plan);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+    mbdata->weightsLinear = XLALCalloc(nnodes, sizeof(COMPLEX16));
+    mbdata->weightsQuadratic = XLALCalloc(nnodes, sizeof(REAL8));
+    if (mbdata->weightsLinear == NULL || mbdata->weightsQuadratic == NULL) {
+        XLALDestroyCOMPLEX16Vector(a);
+        XLALDestroyCOMPLEX16Vector(ahat);
+        XLALReleaseCachedCOMPLEX16FFTPlan(plan);
+        LALInferenceDestroyMultibandData(mbdata);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+
+    /* Weighted data, shifted by the reference time shift, and its inverse Fourier transform */
+    memset(a->data, 0, N*sizeof(COMPLEX16));
+    mbdata->dd = 0.0;
+    for (UINT4 i = lower; i <= upper; i++) {
+        REAL8 weight = TwoDeltaToverN/(psd[i]*deltaT*deltaT);
+        mbdata->dd += weight*(creal(dtilde[i])*creal(dtilde[i]) + cimag(dtilde[i])*cimag(dtilde[i]));
+        a->data[i] = weight*dtilde[i]*cexp(I*LAL_TWOPI*deltaF*i*mb->time_reference);
+    }
+    int status = XLALCOMPLEX16VectorFFT(ahat, a, plan);
+    XLALReleaseCachedCOMPLEX16FFTPlan(plan);
+    XLALDestroyCOMPLEX16Vector(a);
+    if (status != XLAL_SUCCESS) {
+        XLALDestroyCOMPLEX16Vector(ahat);
+        LALInferenceDestroyMultibandData(mbdata);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+
+    for (UINT4 b = 0; b < mb->nbands && status == XLAL_SUCCESS; b++) {
+        const UINT4 n = mb->shift[b];
+        const UINT4 L = N >> n;
+        const UINT4 off = mb->band_offset[b];
+        const UINT4 count = mb->band_offset[b+1] - off;
+        const REAL8 *limits = &mb->band_limits[4*b];
+        if (npost >= L) {
+            XLAL_PRINT_ERROR("Band %u of %g s is too short for the time margin", b, L*deltaT);
+            status = XLAL_EDOM;
+            break;
+        }
+
+        /* <d|h> only involves the data in the time window of the band, which is resolved by the
+           nodes: fold the window into L samples and transform back at the node spacing */
+        COMPLEX16Vector *z = XLALCreateCOMPLEX16Vector(L);
+        COMPLEX16Vector *zhat = XLALCreateCOMPLEX16Vector(L);
+        COMPLEX16FFTPlan *bandplan = XLALGetCachedCOMPLEX16FFTPlan(L, 1, 0);
+        if (z == NULL || zhat == NULL || bandplan == NULL) status = XLAL_EFUNC;
+        if (status == XLAL_SUCCESS) {
+            memset(z->data, 0, L*sizeof(COMPLEX16));
+            for (UINT4 j = 0; j < npost; j++) z->data[j % L] += ahat->data[j];
+            for (UINT4 j = N - (L - npost); j < N; j++) z->data[j % L] += ahat->data[j];
+            status = XLALCOMPLEX16VectorFFT(zhat, z, bandplan);
+        }
+        if (status == XLAL_SUCCESS)
+            for (UINT4 m = 0; m < count; m++) {
+                UINT4 k = (mb->first_bin[b] >> n) + m;
+                mbdata->weightsLinear[off + m] = zhat->data[k % L]/L;
+            }
+        if (z) XLALDestroyCOMPLEX16Vector(z);
+        if (zhat) XLALDestroyCOMPLEX16Vector(zhat);
+        if (bandplan) XLALReleaseCachedCOMPLEX16FFTPlan(bandplan);
+
+        /* <h|h>, interpolating |h|^2 linearly between the nodes */
+        const UINT4 step = 1u << n;
+        const UINT4 last_bin = mb->first_bin[b] + (count - 1)*step;
+        for (UINT4 i = lower; i <= upper; i++) {
+            REAL8 w = MultibandWindow(limits, i*deltaF);
+            if (w == 0.0) continue;
+            REAL8 weight = w*TwoDeltaToverN/(psd[i]*deltaT*deltaT);
+            if (i <= mb->first_bin[b]) mbdata->weightsQuadratic[off] += weight;
+            else if (i >= last_bin) mbdata->weightsQuadratic[off + count - 1] += weight;
+            else {
+                UINT4 m = (i - mb->first_bin[b]) >> n;
+                REAL8 x = (REAL8)((i - mb->first_bin[b]) & (step - 1))/step;
+                mbdata->weightsQuadratic[off + m] += (1.0 - x)*weight;
+                mbdata->weightsQuadratic[off + m + 1] += x*weight;
+            }
+        }
+    }
+    XLALDestroyCOMPLEX16Vector(ahat);
+    if (status != XLAL_SUCCESS) {
+        LALInferenceDestroyMultibandData(mbdata);
+        XLAL_ERROR_NULL(status);
+    }
+
+    return mbdata;
+}
+
+void LALInferenceDestroyMultibandData(LALInferenceMultibandData *mbdata)
+{
+    if (mbdata == NULL) return;
+    XLALFree(mbdata->weightsLinear);
+    XLALFree(mbdata->weightsQuadratic);
+    XLALFree(mbdata);
+}
+
+int LALInferenceMultibandInnerProducts(COMPLEX16 *dh, REAL8 *hh, LALInferenceMultibandModel *mb,
+                                       const LALInferenceMultibandData *mbdata, REAL8 Fplus, REAL8 Fcross,
+                                       const COMPLEX16 *calFactor, REAL8 timeshift)
+{
+    XLAL_CHECK(mb != NULL && mbdata != NULL && mb->hptilde != NULL && mb->hctilde != NULL && mb->template != NULL, XLAL_EFAULT);
+    const REAL8 delta = timeshift - mb->time_reference;
+    XLAL_CHECK(fabs(delta) <= mb->time_margin, XLAL_EDOM,
+               "Time shift %g s is more than %g s from the multiband reference %g s", timeshift, mb->time_margin, mb->time_reference);
+
+    const REAL8 deltaF = 1.0/(mb->length*mb->deltaT);
+    const COMPLEX16 *hp = mb->hptilde->data->data;
+    const COMPLEX16 *hc = mb->hctilde->data->data;
+    COMPLEX16 *template = mb->template->data;
+
+    *dh = 0.0;
+    *hh = 0.0;
+    int status = XLAL_SUCCESS;
+    for (UINT4 b = 0; b < mb->nbands && status == XLAL_SUCCESS; b++) {
+        const UINT4 off = mb->band_offset[b];
+        const UINT4 count = mb->band_offset[b+1] - off;
+        for (UINT4 m = 0; m < count; m++) {
+            UINT4 idx = mb->node_index[off + m];
+            template[m] = Fplus*hp[idx] + Fcross*hc[idx];
+            if (calFactor) template[m] *= calFactor[idx];
+            *hh += mbdata->weightsQuadratic[off + m]*(creal(template[m])*creal(template[m]) + cimag(template[m])*cimag(template[m]));
+        }
+        /* the nodes of the band are uniformly spaced, so the time shift is a phase ramp */
+        COMPLEX16 band_dh;
+        REAL8 unused_hh, unused_dd, unused_rr;
+        const REAL8 dphi = -LAL_TWOPI*delta*deltaF*(1u << mb->shift[b]);
+        status = XLALVectorTimeShiftedInnerProductsCOMPLEX16(&band_dh, &unused_hh, &unused_dd, &unused_rr,
+                                                             &mbdata->weightsLinear[off], template, &mb->window[off],
+                                                             -LAL_TWOPI*delta*deltaF*mb->first_bin[b], dphi, count);
+        *dh += band_dh;
+    }
+    XLAL_CHECK(status == XLAL_SUCCESS, XLAL_EFUNC);
+
+    return XLAL_SUCCESS;
+}
+
+int LALInferenceSetupMultibandModel(LALInferenceModel *model, LALInferenceIFOData *data, LALInferenceVariables *priorArgs)
+{
+    XLAL_CHECK(model != NULL && data != NULL, XLAL_EFAULT);
+    XLAL_CHECK(model->domain == LAL_SIM_DOMAIN_FREQUENCY, XLAL_EINVAL, "The multibanded likelihood needs a frequency-domain approximant");
+
+    REAL8 f_min = INFINITY, f_max = 0.0;
+    for (LALInferenceIFOData *ifo = data; ifo; ifo = ifo->next) {
+        XLAL_CHECK(ifo->timeData->data->length == data->timeData->data->length && ifo->timeData->deltaT == data->timeData->deltaT,
+                   XLAL_EBADLEN, "The multibanded likelihood needs the same data length and sampling rate in all detectors");
+        f_min = fmin(f_min, ifo->fLow);
+        f_max = fmax(f_max, ifo->fHigh);
+    }
+
+    /* Layout is good for the smallest chirp mass of the prior, or a 1-1 binary if there is none */
+    REAL8 mc_min = 1.0/pow(2, 0.2), mc_max;
+    if (priorArgs && LALInferenceCheckMinMaxPrior(priorArgs, "chirpmass"))
+        LALInferenceGetMinMaxPrior(priorArgs, "chirpmass", &mc_min, &mc_max);
+
+    /* Time shifts cover the time prior, or the likelihood's default time if there is none, plus the
+       largest delay from the geocentre to a detector (with a safety factor of 2) */
+    const UINT4 N = data->timeData->data->length;
+    const REAL8 deltaT = data->timeData->deltaT;
+    const REAL8 epoch = XLALGPSGetREAL8(&(data->freqData->epoch));
+    REAL8 time_min = epoch + (N - 1)*deltaT - 2.0 - 0.1, time_max = time_min + 0.2;
+    if (priorArgs && LALInferenceCheckMinMaxPrior(priorArgs, "time"))
+        LALInferenceGetMinMaxPrior(priorArgs, "time", &time_min, &time_max);
+    const REAL8 time_reference = 0.5*(time_min + time_max) - epoch;
+    const REAL8 time_margin = 0.5*(time_max - time_min) + 2.0*LAL_REARTH_SI/LAL_C_SI;
+
+    model->multiband = LALInferenceCreateMultibandModel(f_min, f_max, deltaT, N, mc_min, time_reference, time_margin);
+    XLAL_CHECK(model->multiband != NULL, XLAL_EFUNC);
+
+    for (LALInferenceIFOData *ifo = data; ifo; ifo = ifo->next)
+        if (ifo->multiband == NULL) {
+            ifo->multiband = LALInferenceCreateMultibandData(model->multiband, ifo);
+            XLAL_CHECK(ifo->multiband != NULL, XLAL_EFUNC);
+        }
+
+    return XLAL_SUCCESS;
+}
@@ -9,8 +9,49 @@
 #ifndef _LALInferenceFVectorMultiBanding_Flat_h
 #define _LALInferenceFVectorMultiBanding_Flat_h
 
+#include <lal/LALInference.h>
+
 /** Create a list of frequencies to use in multiband template generation, between f_min and f_max
  mc is minimum allowable chirp mass (sets freq evolution assumption ) */
 REAL8Sequence *LALInferenceMultibandFrequencies(int NBands, double f_min, double f_max, double deltaF0, double mc);
 
+/**
+ * Lay out the frequency bands of the multibanded likelihood between f_min and f_max, for data
+ * of length samples with sampling interval deltaT.  Each band is sampled finely enough to
+ * resolve the signal of chirp mass mc_min (solar masses) or larger above the start of the band,
+ * when its time shift differs by at most time_margin from time_reference.
+ */
+LALInferenceMultibandModel *LALInferenceCreateMultibandModel(REAL8 f_min, REAL8 f_max, REAL8 deltaT, UINT4 length,
+                                                             REAL8 mc_min, REAL8 time_reference, REAL8 time_margin);
+
+/** Free a multiband model created by LALInferenceCreateMultibandModel() */
+void LALInferenceDestroyMultibandModel(LALInferenceMultibandModel *mb);
+
+/**
+ * Compute the data products of the multibanded likelihood for one detector: the weights with
+ * which the template at the nodes of mb enters <d|h> and <h|h>, and <d|d>.  The time shift
+ * time_reference of mb is applied to the data once, here.
+ */
+LALInferenceMultibandData *LALInferenceCreateMultibandData(const LALInferenceMultibandModel *mb, const LALInferenceIFOData *data);
+
+/** Free multiband data created by LALInferenceCreateMultibandData() */
+void LALInferenceDestroyMultibandData(LALInferenceMultibandData *mbdata);
+
+/**
+ * Compute <d|h> and <h|h> for the template Fplus*hptilde + Fcross*hctilde at the nodes of mb,
+ * multiplied by calFactor if it is not NULL, and shifted in time by timeshift.
+ * Fails with XLAL_EDOM if timeshift is further than the time margin from the time reference of mb.
+ * The template of each band is projected into the buffer of mb, so mb must not be shared between threads.
+ */
+int LALInferenceMultibandInnerProducts(COMPLEX16 *dh, REAL8 *hh, LALInferenceMultibandModel *mb,
+                                       const LALInferenceMultibandData *mbdata, REAL8 Fplus, REAL8 Fcross,
+                                       const COMPLEX16 *calFactor, REAL8 timeshift);
+
+/**
+ * Set up the multibanded likelihood for model: lay out the bands from the frequency range of
+ * the detectors in data and the chirp mass and time priors in priorArgs, and compute the data
+ * products of each detector which does not have them yet.
+ */
+int LALInferenceSetupMultibandModel(LALInferenceModel *model, LALInferenceIFOData *data, LALInferenceVariables *priorArgs);
+
 #endif
@@ -43,6 +43,10 @@
 #define UNUSED
 #endif
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 static int __chainfile_iter;
 
 /**
@@ -312,6 +316,7 @@ static double logsubexp(double a, double b)
 }
 
 static void SetupEigenProposals(LALInferenceRunState *runState);
+static void SetupThreadEigenProposals(LALInferenceThreadState *threadState, const gsl_matrix *cvm);
 
 /**
  * Update the internal state of the integrator after receiving the lowest logL
@@ -359,6 +364,66 @@ static void printAdaptiveJumpSizes(FILE *file, LALInferenceThreadState *threadSt
     }
 }
 
+/* Algorithm parameters which the sampler reads or adapts while evolving a
+ replacement point, and which each concurrent replacement needs its own copy of */
+static const char *workerAlgorithmParams[]={"logLmin","Nmcmc","sloppyfraction","accept_rate","sub_accept_rate","logZnoise","verbose"};
+
+/* Create a view of the run state for evolving a replacement live point in
+ thread t. The view shares the live points, data, prior and likelihood
+ with runState, but has its own thread, random number generator and copy of
+ the algorithm parameters used by the sampler. Thread 0 uses runState itself,
+ so with a single thread the algorithm behaves as before. */
+static LALInferenceRunState *createReplacementWorker(LALInferenceRunState *runState, INT4 t);
+static LALInferenceRunState *createReplacementWorker(LALInferenceRunState *runState, INT4 t)
+{
+  if(t==0) return(runState);
+  LALInferenceRunState *worker=XLALMalloc(sizeof(LALInferenceRunState));
+  *worker=*runState;
+  worker->threads=&runState->threads[t];
+  worker->nthreads=1;
+  worker->GSLrandom=runState->threads[t].GSLrandom;
+  worker->algorithmParams=XLALCalloc(1,sizeof(LALInferenceVariables));
+  for(UINT4 i=0;i<sizeof(workerAlgorithmParams)/sizeof(workerAlgorithmParams[0]);i++)
+  {
+    const char *name=workerAlgorithmParams[i];
+    if(LALInferenceCheckVariable(runState->algorithmParams,name))
+      LALInferenceAddVariable(worker->algorithmParams,name,LALInferenceGetVariable(runState->algorithmParams,name),
+                              LALInferenceGetVariableType(runState->algorithmParams,name),
+                              LALInferenceGetVariableVaryType(runState->algorithmParams,name));
+  }
+  return(worker);
+}
+
+static void destroyReplacementWorker(LALInferenceRunState *runState, LALInferenceRunState *worker);
+static void destroyReplacementWorker(LALInferenceRunState *runState, LALInferenceRunState *worker)
+{
+  if(worker==runState) return;
+  LALInferenceClearVariables(worker->algorithmParams);
+  XLALFree(worker->algorithmParams);
+  XLALFree(worker);
+}
+
+/* Evolve a copy of a randomly chosen surviving live point in the given
+ worker until its likelihood exceeds logLmin. Live points with replace[j]
+ set are being removed, and are not used as starting points. Returns the
+ number of attempts needed. */
+static UINT4 evolveReplacement(LALInferenceRunState *worker, UINT4 Nlive, const UINT4 *replace, const REAL8 *logLikelihoods, REAL8 logLmin);
+static UINT4 evolveReplacement(LALInferenceRunState *worker, UINT4 Nlive, const UINT4 *replace, const REAL8 *logLikelihoods, REAL8 logLmin)
+{
+  LALInferenceThreadState *threadState = &worker->threads[0];
+  UINT4 itercounter=0,j;
+  do{ /* This loop is here in case it is necessary to find a different sample */
+    /* Clone an old live point and evolve it */
+    while(replace[j=gsl_rng_uniform_int(worker->GSLrandom,Nlive)]){};
+    LALInferenceCopyVariables(worker->livePoints[j],threadState->currentParams);
+    threadState->currentLikelihood = logLikelihoods[j];
+    LALInferenceSetVariable(worker->algorithmParams,"logLmin",(void *)&logLmin);
+    worker->evolve(worker);
+    itercounter++;
+  }while( threadState->currentLikelihood<=logLmin ||  *(REAL8*)LALInferenceGetVariable(worker->algorithmParams,"accept_rate")==0.0);
+  return(itercounter);
+}
+
 
 /* Create Internal arrays for sampling the integral */
 static NSintegralState *initNSintegralState(UINT4 Nruns, UINT4 Nlive);
@@ -435,9 +500,9 @@ static UINT4 UpdateNMCMC(LALInferenceRunState *runState){
         }
         LALInferenceSetVariable(runState->algorithmParams,"Nmcmc",&max);
     }
-    /* Single threaded here */
     if (LALInferenceGetProcParamVal(runState->commandLine,"--proposal-kde"))
-        LALInferenceSetupClusteredKDEProposalFromDEBuffer(&runState->threads[0]);
+        for(INT4 t=0;t<runState->nthreads;t++)
+            LALInferenceSetupClusteredKDEProposalFromDEBuffer(&runState->threads[t]);
     return(max);
 }
 
@@ -586,6 +651,8 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
     (--sloppyratio S)                Number of sub-samples of the prior for every sample from the\n\
                                      limited prior\n\
     (--Nruns R)                      Number of parallel samples from logt to use(1)\n\
+    (--Nthreads K)                   Replace the K lowest likelihood live points at each iteration,\n\
+                                     evolving each new point in its own thread (1)\n\
     (--tolerance dZ)                 Tolerance of nested sampling algorithm (0.1)\n\
     (--randomseed seed)              Random seed of sampling distribution\n\
     (--prior )                       Set the prior to use (InspiralNormalised,SkyLoc,malmquist)\n\
@@ -725,8 +792,8 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
 
 void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
 {
-  UINT4 iter=0,i,j,minpos;
-  /* Single thread here */
+  UINT4 iter=0,i,j,k,minpos;
+  /* Thread 0 is used for the single threaded parts of the algorithm */
   LALInferenceThreadState *threadState = &runState->threads[0];
   UINT4 HDFOUTPUT=1;
   UINT4 Nlive=*(UINT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nlive");
@@ -777,6 +844,14 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   if(LALInferenceCheckVariable(runState->algorithmParams,"Nruns"))
     Nruns = *(UINT4 *) LALInferenceGetVariable(runState->algorithmParams,"Nruns");
 
+  /* Replace one live point per thread at each iteration */
+  UINT4 Nreplace = runState->nthreads>0 ? (UINT4) runState->nthreads : 1;
+  if(Nreplace>=Nlive)
+  {
+    fprintf(stderr,"Error, number of threads (%u) must be less than the number of live points (%u)\n",Nreplace,Nlive);
+    exit(1);
+  }
+
   /* Create workspace for arrays */
   NSintegralState *s=NULL;
 
@@ -943,43 +1018,56 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   {
       install_resume_handler(CondorExitCode);
   }
+  /* Set up the concurrent replacements */
+  LALInferenceRunState *workers[Nreplace];
+  UINT4 replacepos[Nreplace],itercounters[Nreplace];
+  UINT4 *replace=XLALCalloc(Nlive,sizeof(UINT4));
+  for(k=0;k<Nreplace;k++) workers[k]=createReplacementWorker(runState,k);
+  UINT4 updateinterval=Nlive/10>0 ? Nlive/10 : 1;
   /* Iterate until termination condition is met */
   do {
-    /* Find minimum likelihood sample to replace */
-    minpos=0;
-    for(i=1;i<Nlive;i++){
-      if(logLikelihoods[i]<logLikelihoods[minpos])
-	minpos=i;
+    /* Find the Nreplace minimum likelihood samples to replace, in order of increasing likelihood */
+    for(k=0;k<Nreplace;k++){
+      minpos=0;
+      while(replace[minpos]) minpos++;
+      for(i=minpos+1;i<Nlive;i++){
+        if(!replace[i] && logLikelihoods[i]<logLikelihoods[minpos])
+	  minpos=i;
+      }
+      replace[minpos]=1;
+      replacepos[k]=minpos;
+
+      /* The k-th removed point leaves Nlive-k live points, as at the end of the run */
+      logZnew=incrementEvidenceSamples(runState->GSLrandom, Nlive-k, logLikelihoods[minpos], s);
+      //deltaZ=logZnew-logZ; - set but not used
+      if(runState->logsample) runState->logsample(runState->algorithmParams,runState->livePoints[minpos]);
     }
-    logLmin=logLikelihoods[minpos];
+    /* New points must lie above the highest of the removed likelihoods */
+    logLmin=logLikelihoods[replacepos[Nreplace-1]];
     if(samplePrior) logLmin=-INFINITY;
-
-    logZnew=incrementEvidenceSamples(runState->GSLrandom, Nlive, logLikelihoods[minpos], s);
-    //deltaZ=logZnew-logZ; - set but not used
     H=mean(Harray,Nruns);
     logZ=logZnew;
-    if(runState->logsample) runState->logsample(runState->algorithmParams,runState->livePoints[minpos]);
-    UINT4 itercounter=0;
-
-    /* Generate a new live point */
-    do{ /* This loop is here in case it is necessary to find a different sample */
-      /* Clone an old live point and evolve it */
-      while((j=gsl_rng_uniform_int(runState->GSLrandom,Nlive))==minpos){};
-      LALInferenceCopyVariables(runState->livePoints[j],threadState->currentParams);
-      threadState->currentLikelihood = logLikelihoods[j];
-      LALInferenceSetVariable(runState->algorithmParams,"logLmin",(void *)&logLmin);
-      runState->evolve(runState);
-      itercounter++;
-    }while( threadState->currentLikelihood<=logLmin ||  *(REAL8*)LALInferenceGetVariable(runState->algorithmParams,"accept_rate")==0.0);
-
-    LALInferenceCopyVariables(threadState->currentParams,runState->livePoints[minpos]);
-    logLikelihoods[minpos]=threadState->currentLikelihood;
-
-  if (threadState->currentLikelihood>logLmax)
-    logLmax=threadState->currentLikelihood;
-
-  logw=mean(logwarray,Nruns);
-  LALInferenceAddVariable(runState->livePoints[minpos],"logw",&logw,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
+
+    /* Generate the new live points, each in its own thread */
+    for(k=1;k<Nreplace;k++)
+      LALInferenceSetVariable(workers[k]->algorithmParams,"Nmcmc",LALInferenceGetVariable(runState->algorithmParams,"Nmcmc"));
+    #pragma omp parallel for schedule(dynamic,1) num_threads(Nreplace) if(Nreplace>1)
+    for(k=0;k<Nreplace;k++)
+      itercounters[k]=evolveReplacement(workers[k],Nlive,replace,logLikelihoods,logLmin);
+
+    logw=mean(logwarray,Nruns);
+    for(k=0;k<Nreplace;k++){
+      minpos=replacepos[k];
+      LALInferenceCopyVariables(runState->threads[k].currentParams,runState->livePoints[minpos]);
+      logLikelihoods[minpos]=runState->threads[k].currentLikelihood;
+      replace[minpos]=0;
+
+      if (runState->threads[k].currentLikelihood>logLmax)
+        logLmax=runState->threads[k].currentLikelihood;
+
+      LALInferenceAddVariable(runState->livePoints[minpos],"logw",&logw,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
+    }
+  UINT4 itercounter=itercounters[0];
   dZ=logaddexp(logZ,logLmax-((double) iter)/((double)Nlive))-logZ;
   sloppyfrac=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
   if(displayprogress) fprintf(stderr,"%i: accpt: %1.3f Nmcmc: %i sub_accpt: %1.3f slpy: %2.1f%% H: %3.2lf nats logL:%.3lf ->%.3lf logZ: %.3lf deltalogLmax: %.2lf dZ: %.3lf Zratio: %.3lf \n",\
@@ -996,7 +1084,7 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     dZ,\
     ( logZ - LALInferenceGetREAL8Variable(runState->algorithmParams,"logZnoise"))\
   );
-  iter++;
+  iter+=Nreplace;
 
   /* Save progress */
   if(__ns_saveStateFlag!=0)
@@ -1012,7 +1100,7 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   }
 
   /* Update the proposal */
-  if(!(iter%(Nlive/10))) {
+  if(iter/updateinterval != (iter-Nreplace)/updateinterval) {
     /* Update the covariance matrix */
     if ( LALInferenceCheckVariable( threadState->proposalArgs,"covarianceMatrix" ) ){
       SetupEigenProposals(runState);
@@ -1036,6 +1124,9 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   }
   while(samplePrior?((Nlive+iter)<samplePrior):( iter <= Nlive ||  dZ> TOLERANCE)); /* End of NS loop! */
 
+  for(k=0;k<Nreplace;k++) destroyReplacementWorker(runState,workers[k]);
+  XLALFree(replace);
+
   /* Sort the remaining points (not essential, just nice)*/
   for(i=0;i<Nlive-1;i++){
     minpos=i;
@@ -1647,8 +1738,30 @@ void LALInferenceSetupLivePointsArray(LALInferenceRunState *runState){
 		fprintf(stderr,"Unable to allocate memory for %i live points\n",Nlive);
 		exit(1);
 	}
-	threadState->differentialPoints=runState->livePoints;
-	threadState->differentialPointsLength=(size_t) Nlive;
+	/* All threads use the live points as differential evolution points.
+	 * Destroy the points each thread held before, taking care of threads
+	 * which share an array, e.g. the live points of an earlier call */
+	LALInferenceVariables **oldPoints[runState->nthreads];
+	for(INT4 t=0;t<runState->nthreads;t++)
+	{
+	    LALInferenceThreadState *thread=&runState->threads[t];
+	    INT4 s;
+	    oldPoints[t]=thread->differentialPoints;
+	    for(s=0;s<t && oldPoints[s]!=oldPoints[t];s++);
+	    if(s==t && oldPoints[t] && !thread->differentialPointsArray)
+	    {
+	        for(size_t j=0;j<thread->differentialPointsLength;j++)
+	        {
+	            if(!oldPoints[t][j]) continue;
+	            LALInferenceClearVariables(oldPoints[t][j]);
+	            XLALFree(oldPoints[t][j]);
+	        }
+	    }
+	    if(s==t) XLALFree(oldPoints[t]);
+	    LALInferenceClearDifferentialPoints(thread);
+	    thread->differentialPoints=runState->livePoints;
+	    thread->differentialPointsLength=(size_t) Nlive;
+	}
 	logLs=XLALCreateREAL8Vector(Nlive);
 
 	LALInferenceAddVariable(runState->algorithmParams,"logLikelihoods",&logLs,LALINFERENCE_REAL8Vector_t,LALINFERENCE_PARAM_FIXED);
@@ -1678,25 +1791,32 @@ void LALInferenceSetupLivePointsArray(LALInferenceRunState *runState){
 
 static void SetupEigenProposals(LALInferenceRunState *runState)
 {
-  /* Single thread here */
-  LALInferenceThreadState *threadState = &runState->threads[0];
-  gsl_matrix *eVectors=NULL;
-  gsl_vector *eValues =NULL;
-  REAL8Vector *eigenValues=NULL;
-  /* Check for existing covariance matrix */
-  gsl_matrix **cvm=NULL;
-  if(LALInferenceCheckVariable(threadState->proposalArgs,"covarianceMatrix"))
-    LALInferenceRemoveVariable(threadState->proposalArgs,"covarianceMatrix");
-//    cvm=(gsl_matrix **)LALInferenceGetVariable(threadState->proposalArgs,"covarianceMatrix");
-  cvm=XLALCalloc(1,sizeof(gsl_matrix *));
+  gsl_matrix *cvm=NULL;
 
   /* Add the covariance matrix for proposal distribution */
   UINT4 *Nlive=LALInferenceGetVariable(runState->algorithmParams,"Nlive");
   /* Sort the variables to ensure consistent order */
   for(UINT4 i=0;i<*Nlive;i++) LALInferenceSortVariablesByName(runState->livePoints[i]);
-  LALInferenceNScalcCVM(cvm,runState->livePoints,*Nlive);
-  UINT4 N=(*cvm)->size1;
+  LALInferenceNScalcCVM(&cvm,runState->livePoints,*Nlive);
+
+  /* Each thread owns its proposal arguments */
+  for(INT4 t=0;t<runState->nthreads;t++)
+    SetupThreadEigenProposals(&runState->threads[t],cvm);
 
+  gsl_matrix_free(cvm);
+}
+
+static void SetupThreadEigenProposals(LALInferenceThreadState *threadState, const gsl_matrix *cvm)
+{
+  gsl_matrix *eVectors=NULL;
+  gsl_vector *eValues =NULL;
+  REAL8Vector *eigenValues=NULL;
+  UINT4 N=cvm->size1;
+  /* Check for existing covariance matrix */
+  if(LALInferenceCheckVariable(threadState->proposalArgs,"covarianceMatrix"))
+    LALInferenceRemoveVariable(threadState->proposalArgs,"covarianceMatrix");
+  gsl_matrix *threadCvm=gsl_matrix_alloc(N,N);
+  gsl_matrix_memcpy(threadCvm,cvm);
 
   /* Check for the eigenvectors and values */
   if(LALInferenceCheckVariable(threadState->proposalArgs,"covarianceEigenvectors"))
@@ -1714,7 +1834,7 @@ static void SetupEigenProposals(LALInferenceRunState *runState)
   eValues = gsl_vector_alloc(N);
   gsl_eigen_symmv_workspace *ws = gsl_eigen_symmv_alloc(N);
   int gsl_status;
-  gsl_matrix_memcpy(covCopy, *cvm);
+  gsl_matrix_memcpy(covCopy, cvm);
 
   if ((gsl_status = gsl_eigen_symmv(covCopy, eValues, eVectors, ws)) != GSL_SUCCESS) {
     XLALPrintError("Error in gsl_eigen_symmv (in %s, line %d): %d: %s\n", __FILE__, __LINE__, gsl_status, gsl_strerror(gsl_status));
@@ -1729,12 +1849,11 @@ static void SetupEigenProposals(LALInferenceRunState *runState)
     LALInferenceAddVariable(threadState->proposalArgs, "covarianceEigenvectors", &eVectors, LALINFERENCE_gslMatrix_t, LALINFERENCE_PARAM_FIXED);
   if(!LALInferenceCheckVariable(threadState->proposalArgs,"covarianceEigenvalues"))
     LALInferenceAddVariable(threadState->proposalArgs, "covarianceEigenvalues", &eigenValues, LALINFERENCE_REAL8Vector_t, LALINFERENCE_PARAM_FIXED);
-  LALInferenceAddVariable(threadState->proposalArgs,"covarianceMatrix",cvm,LALINFERENCE_gslMatrix_t,LALINFERENCE_PARAM_OUTPUT);
+  LALInferenceAddVariable(threadState->proposalArgs,"covarianceMatrix",&threadCvm,LALINFERENCE_gslMatrix_t,LALINFERENCE_PARAM_OUTPUT);
 
   gsl_matrix_free(covCopy);
   gsl_vector_free(eValues);
   gsl_eigen_symmv_free(ws);
-  XLALFree(cvm);
 }
 
 
@@ -599,10 +599,10 @@ LALInferenceProposalCycle* LALInferenceSetupDefaultInspiralProposalCycle(LALInfe
 REAL8 LALInferenceSingleAdaptProposal(LALInferenceThreadState *thread,
                                       LALInferenceVariables *currentParams,
                                       LALInferenceVariables *proposedParams) {
-    INT4 dim, varNr;
     REAL8 logPropRatio, sqrttemp, mu, sigma;
     char tmpname[MAX_STRLEN] = "";
     LALInferenceVariableItem *param = NULL;
+    const LALInferenceVariablesSchema *schema;
 
     LALInferenceCopyVariables(currentParams, proposedParams);
     LALInferenceVariables *args = thread->proposalArgs;
@@ -613,12 +613,14 @@ REAL8 LALInferenceSingleAdaptProposal(LALInferenceThreadState *thread,
             LALInferenceSetupAdaptiveProposals(args, currentParams);
 
         sqrttemp = sqrt(thread->temperature);
-        dim = proposedParams->dimension;
 
-        do {
-            varNr = 1 + gsl_rng_uniform_int(rng, dim);
-            param = LALInferenceGetItemNr(proposedParams, varNr);
-        } while (!LALInferenceCheckVariableNonFixed(proposedParams, param->name) || param->type != LALINFERENCE_REAL8_t);
+        /* Draw directly from the varying REAL8 parameters */
+        schema = LALInferenceGetThreadSchema(thread, proposedParams);
+        if (!schema || schema->length == 0) {
+            fprintf(stderr, "No varying REAL8 parameters to propose (in %s, %d)\n", __FILE__, __LINE__);
+            exit(1);
+        }
+        param = LALInferenceGetItem(proposedParams, schema->names->data[gsl_rng_uniform_int(rng, schema->length)]);
 
         if (param->type != LALINFERENCE_REAL8_t) {
             fprintf(stderr, "Attempting to set non-REAL8 parameter with numerical sigma (in %s, %d)\n",
@@ -678,7 +680,7 @@ REAL8 LALInferenceSingleProposal(LALInferenceThreadState *thread,
     LALInferenceVariables *args = thread->proposalArgs;
     gsl_rng * GSLrandom = thread->GSLrandom;
     REAL8 sigma, big_sigma;
-    INT4 dim, varNr;
+    const LALInferenceVariablesSchema *schema;
 
     LALInferenceCopyVariables(currentParams, proposedParams);
 
@@ -690,12 +692,13 @@ REAL8 LALInferenceSingleProposal(LALInferenceThreadState *thread,
     if (gsl_ran_ugaussian(GSLrandom) < 1.0e-4)
         big_sigma = 1.0e2;    //Every 1e4 iterations, take a 100x larger jump in a parameter
 
-    dim = proposedParams->dimension;
-
-    do {
-        varNr = 1 + gsl_rng_uniform_int(GSLrandom, dim);
-        param = LALInferenceGetItemNr(proposedParams, varNr);
-    } while (!LALInferenceCheckVariableNonFixed(proposedParams, param->name) || param->type != LALINFERENCE_REAL8_t);
+    /* Draw directly from the varying REAL8 parameters */
+    schema = LALInferenceGetThreadSchema(thread, proposedParams);
+    if (!schema || schema->length == 0) {
+        fprintf(stderr, "No varying REAL8 parameters to propose (in %s, %d)\n", __FILE__, __LINE__);
+        exit(1);
+    }
+    param = LALInferenceGetItem(proposedParams, schema->names->data[gsl_rng_uniform_int(GSLrandom, schema->length)]);
 
     /* Scale jumps proposal appropriately for prior sampling */
     if (LALInferenceGetINT4Variable(args, "sampling_prior")) {
@@ -757,11 +760,11 @@ REAL8 LALInferenceSingleProposal(LALInferenceThreadState *thread,
 REAL8 LALInferenceCovarianceEigenvectorJump(LALInferenceThreadState *thread,
                                             LALInferenceVariables *currentParams,
                                             LALInferenceVariables *proposedParams) {
-    LALInferenceVariableItem *proposeIterator;
     REAL8Vector *eigenvalues;
     gsl_matrix *eigenvectors;
-    REAL8 jumpSize, tmp, inc;
+    REAL8 jumpSize;
     REAL8 logPropRatio = 0.0;
+    const LALInferenceVariablesSchema *schema;
     INT4 N, i, j;
 
     LALInferenceCopyVariables(currentParams, proposedParams);
@@ -777,27 +780,21 @@ REAL8 LALInferenceCovarianceEigenvectorJump(LALInferenceThreadState *thread,
     i = gsl_rng_uniform_int(rng, N);
     jumpSize = sqrt(thread->temperature * eigenvalues->data[i]) * gsl_ran_ugaussian(rng);
 
-    j = 0;
-    proposeIterator = proposedParams->head;
-    if (proposeIterator == NULL) {
+    schema = LALInferenceGetThreadSchema(thread, proposedParams);
+    if (schema == NULL || schema->length == 0) {
         fprintf(stderr, "Bad proposed params in %s, line %d\n",
                 __FILE__, __LINE__);
         exit(1);
     }
 
-    do {
-        if (LALInferenceCheckVariableNonFixed(proposedParams, proposeIterator->name) &&
-            proposeIterator->type==LALINFERENCE_REAL8_t) {
-            tmp = LALInferenceGetREAL8Variable(proposedParams, proposeIterator->name);
-            inc = jumpSize * gsl_matrix_get(eigenvectors, j, i);
-
-            tmp += inc;
-
-            LALInferenceSetVariable(proposedParams, proposeIterator->name, &tmp);
-
-            j++;
-        }
-    } while ((proposeIterator = proposeIterator->next) != NULL && j < N);
+    /* Step along the eigenvector in the packed parameter array */
+    REAL8 x[schema->length];
+    if (LALInferencePackVariables(x, schema, proposedParams) != XLAL_SUCCESS)
+        XLAL_ERROR_REAL8(XLAL_EFUNC);
+    for (j = 0; j < N && j < (INT4)schema->length; j++)
+        x[j] += jumpSize * gsl_matrix_get(eigenvectors, j, i);
+    if (LALInferenceUnpackVariables(proposedParams, schema, x) != XLAL_SUCCESS)
+        XLAL_ERROR_REAL8(XLAL_EFUNC);
 
     return logPropRatio;
 }
@@ -864,6 +861,108 @@ REAL8 LALInferenceEnsembleStretchExtrinsic(LALInferenceThreadState *thread,
     return logPropRatio;
 }
 
+/* Does the cached column map of thread belong to the list of names? */
+static int differential_columns_match(const LALInferenceDifferentialColumns *map, const char **names) {
+    UINT4 i;
+
+    if (!names || !map->names)
+        return !names && !map->names;
+    for (i = 0; i < map->names->length && names[i] != NULL; i++)
+        if (strcmp(map->names->data[i], names[i]))
+            return 0;
+    return i == map->names->length && names[i] == NULL;
+}
+
+/* Build the map from names onto the columns of the differential evolution
+ * buffer and the matching sampling parameters of the thread; with names ==
+ * NULL every column is used.  Names which are not varied in both the buffer
+ * and the thread are ignored, so the buffer may hold a different set of
+ * parameters from the current point. */
+static LALInferenceDifferentialColumns *differential_columns_create(const LALInferenceVariablesSchema *schema,
+                                                                    const LALInferenceVariablesSchema *paramSchema,
+                                                                    const char **names) {
+    LALInferenceDifferentialColumns *map;
+    INT4 col, par;
+    UINT4 k;
+    size_t i;
+
+    map = XLALCalloc(1, sizeof(*map));
+    if (map == NULL)
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    map->cols = XLALMalloc(schema->length * sizeof(*map->cols));
+    map->params = XLALMalloc(schema->length * sizeof(*map->params));
+    if (names)
+        map->names = XLALCreateEmptyStringVector(0);
+    if (map->cols == NULL || map->params == NULL || (names && map->names == NULL)) {
+        XLALDestroyStringVector(map->names);
+        XLALFree(map->cols);
+        XLALFree(map->params);
+        XLALFree(map);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+
+    for (i = 0; names ? names[i] != NULL : i < schema->length; i++) {
+        if (names && (map->names = XLALAppendString2Vector(map->names, names[i])) == NULL) {
+            XLALFree(map->cols);
+            XLALFree(map->params);
+            XLALFree(map);
+            XLAL_ERROR_NULL(XLAL_EFUNC);
+        }
+        col = names ? LALInferenceVariablesSchemaIndex(schema, names[i]) : (INT4)i;
+        if (col < 0)
+            continue;
+        par = LALInferenceVariablesSchemaIndex(paramSchema, schema->names->data[col]);
+        if (par < 0)
+            continue;
+        for (k = 0; k < map->length && map->cols[k] != (UINT4)col; k++);
+        if (k < map->length)
+            continue;
+        map->cols[map->length] = col;
+        map->params[map->length] = par;
+        map->length++;
+    }
+
+    return map;
+}
+
+/* Map parameter names onto the columns of the differential evolution buffer
+ * and the matching varying REAL8 values of params, returning the number of
+ * columns, or -1 on error.  The map is cached in thread, so that only the
+ * values need to be found on later calls. */
+static INT4 differential_point_columns(LALInferenceThreadState *thread, const LALInferenceVariablesSchema *schema,
+                                       const char **names, LALInferenceVariables *params,
+                                       const UINT4 **cols, REAL8 **vals) {
+    const LALInferenceVariablesSchema *paramSchema;
+    LALInferenceDifferentialColumns *map;
+    LALInferenceVariableItem *item;
+    UINT4 j = 0, k;
+
+    paramSchema = LALInferenceGetThreadSchema(thread, params);
+    if (paramSchema == NULL)
+        XLAL_ERROR(XLAL_EFUNC);
+
+    for (map = thread->differentialColumns; map && !differential_columns_match(map, names); map = map->next);
+    if (map == NULL) {
+        map = differential_columns_create(schema, paramSchema, names);
+        if (map == NULL)
+            XLAL_ERROR(XLAL_EFUNC);
+        map->next = thread->differentialColumns;
+        thread->differentialColumns = map;
+    }
+
+    /* the sampling parameters of params are those of the thread schema, in order */
+    REAL8 *values[paramSchema->length > 0 ? paramSchema->length : 1];
+    for (item = params->head; item; item = item->next)
+        if (item->type == LALINFERENCE_REAL8_t &&
+            (item->vary == LALINFERENCE_PARAM_LINEAR || item->vary == LALINFERENCE_PARAM_CIRCULAR))
+            values[j++] = (REAL8 *)item->value;
+    for (k = 0; k < map->length; k++)
+        vals[k] = values[map->params[k]];
+
+    *cols = map->cols;
+    return map->length;
+}
+
 /* This jump uses the current sample 'A' and another randomly
  * drawn 'B' from the ensemble of live points, and proposes
  * C = B+Z(A-B) where Z is a scale factor */
@@ -871,59 +970,41 @@ REAL8 LALInferenceEnsembleStretchNames(LALInferenceThreadState *thread,
                                        LALInferenceVariables *currentParams,
                                        LALInferenceVariables *proposedParams,
                                        const char **names) {
-    size_t i, N, Ndim, nPts;
+    size_t i, k, Ndim, nPts;
     REAL8 logPropRatio;
     REAL8 maxScale, Y, logmax, X, scale;
-    REAL8 cur, other, x;
-    LALInferenceVariableItem *item;
-    LALInferenceVariables **dePts;
-    LALInferenceVariables *ptI;
-
-    N = LALInferenceGetVariableDimension(currentParams) + 1; /* More names than we need. */
-    const char* local_names[N];
-    if (names == NULL) {
-        names = local_names;
-
-        item = currentParams->head;
-        i = 0;
-        while (item != NULL) {
-            if (item->vary != LALINFERENCE_PARAM_FIXED && item->vary != LALINFERENCE_PARAM_OUTPUT && item->type==LALINFERENCE_REAL8_t ) {
-                names[i] = item->name;
-                i++;
-            }
-            item = item->next;
-        }
-        names[i]=NULL; /* Terminate */
-    }
-
-    Ndim = 0;
-    for(Ndim=0,i=0; names[i] != NULL; i++ ) {
-        if(LALInferenceCheckVariableNonFixed(currentParams,names[i]))
-        Ndim++;
-    }
+    const LALInferenceVariablesSchema *schema;
+    const REAL8 *ptI;
 
     LALInferenceCopyVariables(currentParams, proposedParams);
 
-    Ndim = 0;
-    for(Ndim=0, i=0; names[i] != NULL; i++ ) {
-        if (LALInferenceCheckVariableNonFixed(proposedParams, names[i]))
-            Ndim++;
-    }
-
-    dePts = thread->differentialPoints;
     nPts = thread->differentialPointsLength;
+    schema = LALInferenceGetDifferentialPointsSchema(thread);
 
-    if (dePts == NULL || nPts <= 1) {
+    if (schema == NULL || nPts <= 1) {
         logPropRatio = 0.0;
         return logPropRatio; /* Quit now, since we don't have any points to use. */
     }
 
+    const UINT4 *cols;
+    REAL8 *x[schema->length], row[schema->length];
+    INT4 nCols = differential_point_columns(thread, schema, names, proposedParams, &cols, x);
+    if (nCols < 0)
+        XLAL_ERROR_REAL8(XLAL_EFUNC);
+    Ndim = nCols;
+    if (Ndim == 0) {
+        logPropRatio = 0.0;
+        return logPropRatio; /* No parameters in common with the buffer. */
+    }
+
     /* Choose a different sample */
     do {
         i = gsl_rng_uniform_int(thread->GSLrandom, nPts);
-    } while (!LALInferenceCompareVariables(currentParams, dePts[i]));
-
-    ptI = dePts[i];
+        ptI = LALInferenceGetDifferentialPoint(thread, i, row);
+        if (ptI == NULL)
+            XLAL_ERROR_REAL8(XLAL_EFUNC);
+        for (k = 0; k < Ndim && ptI[cols[k]] == *x[k]; k++);
+    } while (k == Ndim);
 
     /* Scale z is chosen according to be symmetric under z -> 1/z */
     /* so p(x) \propto 1/z between 1/a and a */
@@ -937,17 +1018,8 @@ REAL8 LALInferenceEnsembleStretchNames(LALInferenceThreadState *thread,
     X = 2.0*logmax*Y - logmax;
     scale = exp(X);
 
-    for (i = 0; names[i] != NULL; i++) {
-        /* Ignore variable if it's not in each of the params. */
-        if (LALInferenceCheckVariableNonFixed(proposedParams, names[i]) &&
-            LALInferenceCheckVariableNonFixed(ptI, names[i])) {
-                cur = LALInferenceGetREAL8Variable(proposedParams, names[i]);
-                other= LALInferenceGetREAL8Variable(ptI, names[i]);
-                x = other + scale*(cur-other);
-
-                LALInferenceSetVariable(proposedParams, names[i], &x);
-        }
-    }
+    for (k = 0; k < Ndim; k++)
+        *x[k] = ptI[cols[k]] + scale*(*x[k] - ptI[cols[k]]);
 
     if (scale < maxScale && scale > (1.0/maxScale))
         logPropRatio = log(scale)*((REAL8)Ndim);
@@ -984,76 +1056,60 @@ REAL8 LALInferenceEnsembleWalkNames(LALInferenceThreadState *thread,
                                     LALInferenceVariables *currentParams,
                                     LALInferenceVariables *proposedParams,
                                     const char **names) {
-  size_t i;
-  LALInferenceVariableItem *item;
+  size_t i, k, Ndim;
   REAL8 logPropRatio = 0.0;
+  const LALInferenceVariablesSchema *schema;
 
-  size_t N = LALInferenceGetVariableDimension(currentParams) + 1; /* More names than we need. */
-  const char* local_names[N];
-  if (names == NULL) {
-    names = local_names;
-
-    item = currentParams->head;
-    i = 0;
-    while (item != NULL) {
-      if (item->vary != LALINFERENCE_PARAM_FIXED && item->vary != LALINFERENCE_PARAM_OUTPUT && item->type==LALINFERENCE_REAL8_t ) {
-        names[i] = item->name;
-        i++;
-      }
-
-      item = item->next;
-    }
-    names[i]=NULL; /* Terminate */
-  }
-
-
-  size_t Ndim = 0;
-  for(Ndim=0,i=0; names[i] != NULL; i++ ) {
-    if(LALInferenceCheckVariableNonFixed(currentParams,names[i]))
-      Ndim++;
-  }
-
-  LALInferenceVariables **pointsPool = thread->differentialPoints;
-  size_t k=0;
   size_t sample_size=3;
 
-  LALInferenceVariables **dePts = thread->differentialPoints;
   size_t nPts = thread->differentialPointsLength;
+  schema = LALInferenceGetDifferentialPointsSchema(thread);
 
-  if (dePts == NULL || nPts <= 1) {
+  if (schema == NULL || nPts < sample_size) {
     logPropRatio = 0.0;
     return logPropRatio; /* Quit now, since we don't have any points to use. */
   }
 
   LALInferenceCopyVariables(currentParams, proposedParams);
 
-  UINT4 indices[sample_size];
-  UINT4 all_indices[nPts];
+  const UINT4 *cols;
+  REAL8 *x[schema->length], rows[sample_size][schema->length];
+  const REAL8 *pts[sample_size];
+  INT4 nCols = differential_point_columns(thread, schema, names, proposedParams, &cols, x);
+  if (nCols < 0)
+    XLAL_ERROR_REAL8(XLAL_EFUNC);
+  Ndim = nCols;
 
-  for (i=0;i<nPts;i++) all_indices[i]=i;
-  gsl_ran_choose(thread->GSLrandom,indices, sample_size, all_indices, nPts, sizeof(UINT4));
+  /* Choose distinct points from the buffer */
+  UINT4 indices[sample_size];
+  for (i=0;i<sample_size;i++) {
+    do {
+      indices[i] = gsl_rng_uniform_int(thread->GSLrandom, nPts);
+      for (k=0;k<i && indices[k]!=indices[i];k++);
+    } while (k < i);
+    pts[i] = LALInferenceGetDifferentialPoint(thread, indices[i], rows[i]);
+    if (pts[i] == NULL)
+      XLAL_ERROR_REAL8(XLAL_EFUNC);
+  }
 
   double w=0.0;
   double univariate_normals[sample_size];
   for(i=0;i<sample_size;i++) univariate_normals[i] = gsl_ran_ugaussian(thread->GSLrandom);
 
-  /* Note: Simplified this loop on master 2015-08-12, take this version when rebasing */
-  for(k=0;names[k]!=NULL;k++)
+  for(k=0;k<Ndim;k++)
   {
-    if(!LALInferenceCheckVariableNonFixed(proposedParams,names[k]) || LALInferenceGetVariableType(proposedParams,names[k])!=LALINFERENCE_REAL8_t) continue;
     REAL8 centre_of_mass=0.0;
     /* Compute centre of mass */
     for(i=0;i<sample_size;i++)
     {
-      centre_of_mass+=LALInferenceGetREAL8Variable(pointsPool[indices[i]],names[k])/((REAL8)sample_size);
+      centre_of_mass+=pts[i][cols[k]]/((REAL8)sample_size);
     }
     /* Compute offset */
     for(i=0,w=0.0;i<sample_size;i++)
     {
-      w+= univariate_normals[i] * (LALInferenceGetREAL8Variable(pointsPool[indices[i]],names[k]) - centre_of_mass);
+      w+= univariate_normals[i] * (pts[i][cols[k]] - centre_of_mass);
     }
-    REAL8 tmp = LALInferenceGetREAL8Variable(proposedParams,names[k]) + w;
-    LALInferenceSetVariable(proposedParams,names[k],&tmp);
+    *x[k] += w;
   }
 
   logPropRatio = 0.0;
@@ -1065,58 +1121,39 @@ REAL8 LALInferenceDifferentialEvolutionNames(LALInferenceThreadState *thread,
                                     LALInferenceVariables *currentParams,
                                     LALInferenceVariables *proposedParams,
                                     const char **names) {
-    size_t i, j, N, Ndim, nPts;
-    LALInferenceVariableItem *item;
-    LALInferenceVariables **dePts;
-    LALInferenceVariables *ptI, *ptJ;
+    size_t i, j, k, Ndim, nPts;
+    const LALInferenceVariablesSchema *schema;
+    const REAL8 *ptI, *ptJ;
     REAL8 logPropRatio = 0.0;
-    REAL8 scale, x;
+    REAL8 scale;
 
 
     gsl_rng *rng = thread->GSLrandom;
 
-    if (names == NULL) {
-        N = LALInferenceGetVariableDimension(currentParams) + 1; /* More names than we need. */
-        names = alloca(N * sizeof(char *)); /* Hope we have alloca---saves
-                                               having to deallocate after
-                                               proposal. */
-
-        item = currentParams->head;
-        i = 0;
-        while (item != NULL) {
-            if (LALInferenceCheckVariableNonFixed(currentParams, item->name) && item->type==LALINFERENCE_REAL8_t ) {
-                names[i] = item->name;
-                i++;
-            }
-
-            item = item->next;
-        }
-        names[i]=NULL; /* Terminate */
-    }
-
-
-    Ndim = 0;
-    for (Ndim=0, i=0; names[i] != NULL; i++ ) {
-        if (LALInferenceCheckVariableNonFixed(currentParams, names[i]))
-            Ndim++;
-    }
-
-    dePts = thread->differentialPoints;
     nPts = thread->differentialPointsLength;
+    schema = LALInferenceGetDifferentialPointsSchema(thread);
 
-    if (dePts == NULL || nPts <= 1)
+    if (schema == NULL || nPts <= 1)
         return logPropRatio; /* Quit now, since we don't have any points to use. */
 
     LALInferenceCopyVariables(currentParams, proposedParams);
 
+    const UINT4 *cols;
+    REAL8 *x[schema->length], rowI[schema->length], rowJ[schema->length];
+    INT4 nCols = differential_point_columns(thread, schema, names, proposedParams, &cols, x);
+    if (nCols < 0)
+        XLAL_ERROR_REAL8(XLAL_EFUNC);
+    Ndim = nCols;
 
     i = gsl_rng_uniform_int(rng, nPts);
     do {
         j = gsl_rng_uniform_int(rng, nPts);
     } while (j == i);
 
-    ptI = dePts[i];
-    ptJ = dePts[j];
+    ptI = LALInferenceGetDifferentialPoint(thread, i, rowI);
+    ptJ = LALInferenceGetDifferentialPoint(thread, j, rowJ);
+    if (ptI == NULL || ptJ == NULL)
+        XLAL_ERROR_REAL8(XLAL_EFUNC);
 
     const REAL8 modeHoppingFrac = 0.5;
     /* Some fraction of the time, we do a "mode hopping" jump,
@@ -1129,18 +1166,8 @@ REAL8 LALInferenceDifferentialEvolutionNames(LALInferenceThreadState *thread,
         scale = 2.38/sqrt(Ndim) * exp(log(0.1) + log(100.0) * gsl_rng_uniform(rng));
     }
 
-    for (i = 0; names[i] != NULL; i++) {
-        if (!LALInferenceCheckVariableNonFixed(currentParams, names[i]) ||
-            !LALInferenceCheckVariable(ptJ, names[i]) ||
-            !LALInferenceCheckVariable(ptI, names[i])) {
-        /* Ignore variable if it's not in each of the params. */
-        } else {
-            x = LALInferenceGetREAL8Variable(currentParams, names[i]);
-            x += scale * LALInferenceGetREAL8Variable(ptJ, names[i]);
-            x -= scale * LALInferenceGetREAL8Variable(ptI, names[i]);
-            LALInferenceSetVariable(proposedParams, names[i], &x);
-        }
-    }
+    for (k = 0; k < Ndim; k++)
+        *x[k] += scale * (ptJ[cols[k]] - ptI[cols[k]]);
 
     return logPropRatio;
 }
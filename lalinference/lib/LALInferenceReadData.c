@@ -34,6 +34,7 @@
 #include <lal/LALCache.h>
 #include <lal/LALFrStream.h>
 #include <lal/TimeFreqFFT.h>
+#include <lal/FFTPlanCache.h>
 #include <lal/LALDetectors.h>
 #include <lal/AVFactories.h>
 #include <lal/ResampleTimeSeries.h>
@@ -767,12 +768,13 @@ LALInferenceIFOData *LALInferenceReadData(ProcessParamsTable *commandLine)
 
     /* Set up FFT structures and window */
     for (i=0;i<Nifo;i++){
-        /* Create FFT plans (flag 1 to measure performance) */
-        IFOdata[i].timeToFreqFFTPlan = XLALCreateForwardREAL8FFTPlan((UINT4) seglen, 1 );
+        /* Get FFT plans (flag 1 to measure performance); plans of the same
+         * length are shared between detectors through the plan cache */
+        IFOdata[i].timeToFreqFFTPlan = XLALGetCachedREAL8FFTPlan((UINT4) seglen, 1, 1 );
         if(!IFOdata[i].timeToFreqFFTPlan) XLAL_ERROR_NULL(XLAL_ENOMEM);
-        IFOdata[i].freqToTimeFFTPlan = XLALCreateReverseREAL8FFTPlan((UINT4) seglen, 1 );
+        IFOdata[i].freqToTimeFFTPlan = XLALGetCachedREAL8FFTPlan((UINT4) seglen, 0, 1 );
         if(!IFOdata[i].freqToTimeFFTPlan) XLAL_ERROR_NULL(XLAL_ENOMEM);
-        IFOdata[i].margFFTPlan = XLALCreateReverseREAL8FFTPlan((UINT4) seglen, 1);
+        IFOdata[i].margFFTPlan = XLALGetCachedREAL8FFTPlan((UINT4) seglen, 0, 1);
         if(!IFOdata[i].margFFTPlan) XLAL_ERROR_NULL(XLAL_ENOMEM);
         /* Setup windows */
         ppt=LALInferenceGetProcParamVal(commandLine,"--padding");
@@ -2478,6 +2480,7 @@ void LALInferenceSetupROQmodel(LALInferenceModel *model, ProcessParamsTable *com
           model->roq->frequencyNodesQuadratic = XLALCreateREAL8Sequence(n_basis_quadratic);
           model->roq->calFactorLinear = XLALCreateCOMPLEX16Sequence(model->roq->frequencyNodesLinear->length);
           model->roq->calFactorQuadratic = XLALCreateCOMPLEX16Sequence(model->roq->frequencyNodesQuadratic->length);
+          model->roq->templateLinear = XLALCreateCOMPLEX16Sequence(model->roq->frequencyNodesLinear->length);
 
 	  if(LALInferenceGetProcParamVal(commandLine,"--roqnodesLinear")){
 	    ppt=LALInferenceGetProcParamVal(commandLine,"--roqnodesLinear");
@@ -2592,7 +2595,7 @@ void LALInferenceSetupROQdata(LALInferenceIFOData *IFOdata, ProcessParamsTable *
     while (thisData) {
       thisData->roq = XLALMalloc(sizeof(LALInferenceROQData));
 
-      thisData->roq->weights_linear = XLALMalloc(n_basis_linear*sizeof(LALInferenceROQSplineWeights));
+      thisData->roq->weights_linear = NULL;
 
       sprintf(tmp, "--%s-roqweightsLinear", thisData->name);
       ppt = LALInferenceGetProcParamVal(commandLine,tmp);
@@ -2604,19 +2607,21 @@ void LALInferenceSetupROQdata(LALInferenceIFOData *IFOdata, ProcessParamsTable *
 	fprintf(stderr, "Error code %i: %s\n", errsave, strerror(errsave));
 	exit(errsave);
       }
-      thisData->roq->weightsLinear = (double complex*)malloc(n_basis_linear*time_steps*(sizeof(double complex)));
+      thisData->roq->weightsLinear = XLALMalloc(n_basis_linear*time_steps*(sizeof(COMPLEX16)));
+      thisData->roq->n_basis_linear = n_basis_linear;
 
       //0.045 comes from the diameter of the earth in light seconds: the maximum time-delay between earth-based observatories
       thisData->roq->time_weights_width = 2*dt + 2*0.045;
-      thisData->roq->time_step_size = thisData->roq->time_weights_width/time_steps;
       thisData->roq->n_time_steps = time_steps;
 
 
       fprintf(stderr, "basis_size = %d\n", n_basis_linear);
       fprintf(stderr, "time steps = %d\n", time_steps);
 
-      double *tmp_real_weight = malloc(time_steps*(sizeof(double)));
-      double *tmp_imag_weight = malloc(time_steps*(sizeof(double)));
+      if (time_steps < 4) {
+	fprintf(stderr, "Error: at least 4 ROQ time steps are needed to interpolate the weights\n");
+	exit(1);
+      }
 
       double *tmp_tcs = malloc(time_steps*(sizeof(double)));
 
@@ -2635,23 +2640,30 @@ void LALInferenceSetupROQdata(LALInferenceIFOData *IFOdata, ProcessParamsTable *
 	fread(&(tmp_tcs[gg]), sizeof(double), 1, tcFile);
       }
 
+      /* the time steps are uniformly spaced, so the weights can be interpolated without a search */
+      thisData->roq->time_step_start = tmp_tcs[0];
+      thisData->roq->time_step_size = (tmp_tcs[time_steps-1] - tmp_tcs[0])/(time_steps - 1);
+      for(unsigned int gg=1;gg < time_steps; gg++){
+	if (fabs(tmp_tcs[gg] - tmp_tcs[0] - gg*thisData->roq->time_step_size) > 1e-6*thisData->roq->time_step_size) {
+	  fprintf(stderr, "Error: the ROQ time steps in %s are not uniformly spaced\n", ppt->value);
+	  exit(1);
+	}
+      }
+      free(tmp_tcs);
+
+      /* the weights file holds the weights of each basis element for all time steps; store
+         them transposed, so the weights of all basis elements at one time step are contiguous */
+      COMPLEX16 *tmp_weights = malloc(time_steps*(sizeof(COMPLEX16)));
       for(unsigned int ii=0; ii<n_basis_linear;ii++){
+	if (fread(tmp_weights, sizeof(COMPLEX16), time_steps, thisData->roq->weightsFileLinear) != time_steps) {
+	  fprintf(stderr, "Error: could not read the ROQ linear weights for %s\n", thisData->name);
+	  exit(1);
+	}
 	for(unsigned int jj=0; jj<time_steps;jj++){
-	  fread(&(thisData->roq->weightsLinear[ii*time_steps + jj]), sizeof(double complex), 1, thisData->roq->weightsFileLinear);
-	  tmp_real_weight[jj] = creal(thisData->roq->weightsLinear[ii*time_steps + jj]);
-	  tmp_imag_weight[jj] = cimag(thisData->roq->weightsLinear[ii*time_steps + jj]);
+	  thisData->roq->weightsLinear[jj*n_basis_linear + ii] = tmp_weights[jj];
 	}
-  //gsl_interp_accel is not thread-safe, and each OpenMP thread will need its
-  //own gsl_interp_accel object.
-	thisData->roq->weights_linear[ii].acc_real_weight_linear = NULL;
- 	thisData->roq->weights_linear[ii].acc_imag_weight_linear = NULL;
-
-	thisData->roq->weights_linear[ii].spline_real_weight_linear = gsl_spline_alloc (gsl_interp_cspline, time_steps);
-        gsl_spline_init(thisData->roq->weights_linear[ii].spline_real_weight_linear, tmp_tcs, tmp_real_weight, time_steps);
-
-        thisData->roq->weights_linear[ii].spline_imag_weight_linear = gsl_spline_alloc (gsl_interp_cspline, time_steps);
-        gsl_spline_init(thisData->roq->weights_linear[ii].spline_imag_weight_linear, tmp_tcs, tmp_imag_weight, time_steps);
       }
+      free(tmp_weights);
       fclose(thisData->roq->weightsFileLinear);
       thisData->roq->weightsFileLinear = NULL;
       fclose(tcFile);
@@ -59,6 +59,10 @@
 #define UNUSED
 #endif
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 /* Max amplitude orders found in LALSimulation (not accessible from outside of LALSim) */
 #define MAX_NONPRECESSING_AMP_PN_ORDER 6
 #define MAX_PRECESSING_AMP_PN_ORDER 3
@@ -222,15 +226,18 @@ static void q2masses(double mc, double q, double *m1, double *m2)
   return;
 }
 
-void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model){
-/*************************************************************************************************************************/
+/* Generates the template for the parameters in model->params at each of the nseq sequences of
+   frequencies, with XLALSimInspiralChooseFDWaveformSequence.  All sequences are generated even
+   if one fails, in which case the (positive) error number of the first failure is returned.
+   Returns XLAL_FAILURE if the model parameters are incomplete. */
+static int ChooseFDWaveformSequences(LALInferenceModel *model, UINT4 nseq, REAL8Sequence **frequencies,
+                                     COMPLEX16FrequencySeries **hptilde, COMPLEX16FrequencySeries **hctilde)
+{
   Approximant approximant = (Approximant) 0;
 
   int ret=0;
   INT4 errnum=0;
 
-  model->roq->hptildeLinear=NULL, model->roq->hctildeLinear=NULL;
-  model->roq->hptildeQuadratic=NULL, model->roq->hctildeQuadratic=NULL;
   REAL8 mc;
   REAL8 phi0, m1, m2, distance, inclination;
 
@@ -240,14 +247,14 @@ void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferen
     approximant = *(Approximant*) LALInferenceGetVariable(model->params, "LAL_APPROXIMANT");
   else {
     XLALPrintError(" ERROR in templateLALGenerateInspiral(): (INT4) \"LAL_APPROXIMANT\" parameter not provided!\n");
-    XLAL_ERROR_VOID(XLAL_EDATA);
+    XLAL_ERROR(XLAL_EDATA);
   }
 
   if (LALInferenceCheckVariable(model->params, "LAL_PNORDER"))
     XLALSimInspiralWaveformParamsInsertPNPhaseOrder(model->LALpars, *(INT4 *) LALInferenceGetVariable(model->params, "LAL_PNORDER"));
   else {
     XLALPrintError(" ERROR in templateLALGenerateInspiral(): (INT4) \"LAL_PNORDER\" parameter not provided!\n");
-    XLAL_ERROR_VOID(XLAL_EDATA);
+    XLAL_ERROR(XLAL_EDATA);
   }
 
   /* Explicitly set the default amplitude order if one is not specified.
@@ -351,7 +358,7 @@ void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferen
       if (ret == XLAL_FAILURE)
       {
         XLALPrintError(" ERROR in XLALSimInspiralTransformPrecessingNewInitialConditions(): error converting angles. errnum=%d\n",errnum );
-        return;
+        return errnum;
       }
   }
 
@@ -452,16 +459,71 @@ void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferen
   /* ==== Call the waveform generator ==== */
     /* Correct distance to account for renormalisation of data due to window RMS */
     double corrected_distance = distance * sqrt(model->window->sumofsquares/model->window->data->length);
-    XLAL_TRY(ret=XLALSimInspiralChooseFDWaveformSequence (&(model->roq->hptildeLinear), &(model->roq->hctildeLinear), phi0, m1*LAL_MSUN_SI, m2*LAL_MSUN_SI,
-                spin1x, spin1y, spin1z, spin2x, spin2y, spin2z, f_ref, corrected_distance, inclination, model->LALpars, approximant, (model->roq->frequencyNodesLinear)), errnum);
+    INT4 status = XLAL_SUCCESS;
+    for (UINT4 s = 0; s < nseq; s++) {
+      XLAL_TRY(ret=XLALSimInspiralChooseFDWaveformSequence (&(hptilde[s]), &(hctilde[s]), phi0, m1*LAL_MSUN_SI, m2*LAL_MSUN_SI,
+                spin1x, spin1y, spin1z, spin2x, spin2y, spin2z, f_ref, corrected_distance, inclination, model->LALpars, approximant, frequencies[s]), errnum);
+      if (ret != XLAL_SUCCESS && status == XLAL_SUCCESS) status = errnum ? errnum : XLAL_EFAILED;
+    }
 
-    XLAL_TRY(ret=XLALSimInspiralChooseFDWaveformSequence (&(model->roq->hptildeQuadratic), &(model->roq->hctildeQuadratic), phi0, m1*LAL_MSUN_SI, m2*LAL_MSUN_SI,
-							spin1x, spin1y, spin1z, spin2x, spin2y, spin2z, f_ref, corrected_distance, inclination, model->LALpars, approximant, (model->roq->frequencyNodesQuadratic)), errnum);
+    return status;
+}
 
-    REAL8 instant = model->freqhPlus->epoch.gpsSeconds + 1e-9*model->freqhPlus->epoch.gpsNanoSeconds;
-    LALInferenceSetVariable(model->params, "time", &instant);
+void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model){
+/*************************************************************************************************************************/
+  model->roq->hptildeLinear=NULL, model->roq->hctildeLinear=NULL;
+  model->roq->hptildeQuadratic=NULL, model->roq->hctildeQuadratic=NULL;
 
-        return;
+  REAL8Sequence *frequencies[2] = {model->roq->frequencyNodesLinear, model->roq->frequencyNodesQuadratic};
+  COMPLEX16FrequencySeries *hptilde[2] = {NULL, NULL};
+  COMPLEX16FrequencySeries *hctilde[2] = {NULL, NULL};
+  if (ChooseFDWaveformSequences(model, 2, frequencies, hptilde, hctilde) == XLAL_FAILURE)
+    XLAL_ERROR_VOID(XLAL_EFUNC);
+  model->roq->hptildeLinear = hptilde[0];
+  model->roq->hctildeLinear = hctilde[0];
+  model->roq->hptildeQuadratic = hptilde[1];
+  model->roq->hctildeQuadratic = hctilde[1];
+
+  REAL8 instant = model->freqhPlus->epoch.gpsSeconds + 1e-9*model->freqhPlus->epoch.gpsNanoSeconds;
+  LALInferenceSetVariable(model->params, "time", &instant);
+
+  return;
+}
+
+void LALInferenceMultibandWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model)
+{
+  LALInferenceMultibandModel *mb = model->multiband;
+  INT4 errnum;
+
+  if ( mb->hptilde ) XLALDestroyCOMPLEX16FrequencySeries(mb->hptilde);
+  if ( mb->hctilde ) XLALDestroyCOMPLEX16FrequencySeries(mb->hctilde);
+  mb->hptilde = mb->hctilde = NULL;
+
+  errnum = ChooseFDWaveformSequences(model, 1, &mb->frequencies, &mb->hptilde, &mb->hctilde);
+  if (errnum == XLAL_FAILURE)
+    XLAL_ERROR_VOID(XLAL_EFUNC);
+  if (errnum != XLAL_SUCCESS) {
+    if ( mb->hptilde ) XLALDestroyCOMPLEX16FrequencySeries(mb->hptilde);
+    if ( mb->hctilde ) XLALDestroyCOMPLEX16FrequencySeries(mb->hctilde);
+    mb->hptilde = mb->hctilde = NULL;
+    errnum&=~XLAL_EFUNC; /* Mask out the internal function failure bit */
+    if (errnum == XLAL_EDOM)
+      /* The waveform was called outside its domain. Return an empty template but not an error */
+      XLAL_ERROR_VOID(XLAL_EUSR0);
+    XLALSetErrno(errnum);
+    XLAL_ERROR_VOID(errnum, "%s: Template generation failed in XLALSimInspiralChooseFDWaveformSequence", __func__);
+  }
+
+  if (mb->hptilde==NULL || mb->hptilde->data==NULL || mb->hptilde->data->length != mb->frequencies->length ||
+      mb->hctilde==NULL || mb->hctilde->data==NULL || mb->hctilde->data->length != mb->frequencies->length) {
+    XLALPrintError(" ERROR in %s: template is not generated at all of the multiband frequencies.\n",__func__);
+    XLAL_ERROR_VOID(XLAL_EFAULT);
+  }
+
+  REAL8 instant = model->freqhPlus->epoch.gpsSeconds + 1e-9*model->freqhPlus->epoch.gpsNanoSeconds;
+  LALInferenceSetVariable(model->params, "time", &instant);
+
+  return;
 }
 
 void LALInferenceTemplateSineGaussian(LALInferenceModel *model)
@@ -1515,12 +1577,15 @@ void LALInferenceTemplateXLALSimInspiralChooseWaveformPhaseInterpolated(LALInfer
     INT4 Nbands=-1; /* Use optimum number of bands */
     double mc_min=1.0/pow(2,0.2); /* For min 1.0-1.0 waveform */
 
-    /* Vector of frequencies at which to compute FD template */
+    /* Vector of frequencies at which to compute FD template, shared between threads */
     static REAL8Sequence *frequencies = NULL;
 
     /* ==== Call the waveform generator ==== */
     if(model->domain == LAL_SIM_DOMAIN_FREQUENCY) {
-        if(!frequencies) frequencies = LALInferenceMultibandFrequencies(Nbands,f_start,0.5/deltaT, model->deltaF, mc_min);
+        #pragma omp critical (LALInferenceMultibandFrequencies)
+        {
+            if(!frequencies) frequencies = LALInferenceMultibandFrequencies(Nbands,f_start,0.5/deltaT, model->deltaF, mc_min);
+        }
         double corrected_distance = distance * sqrt(model->window->sumofsquares/model->window->data->length);
 
 
@@ -123,6 +123,13 @@ void LALInferenceTemplateNullTimedomain(LALInferenceModel *model);
 void LALInferenceTemplateSineGaussian(LALInferenceModel *model);
 
 void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model);
+
+/**
+ * Template for the multibanded likelihood: generates the frequency-domain waveform with
+ * XLALSimInspiralChooseFDWaveformSequence only at the frequencies in \c model->multiband,
+ * which is set up by LALInferenceSetupMultibandModel().
+ */
+void LALInferenceMultibandWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model);
 /**
  * Damped Sinusoid template.
  *
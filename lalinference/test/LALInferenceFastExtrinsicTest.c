@@ -0,0 +1,160 @@
+/*
+ *  LALInferenceFastExtrinsicTest.c:  Compare the fast extrinsic and the exact likelihood
+ *
+ *  Copyright (C) 2026
+ *
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <lal/LALInference.h>
+#include <lal/LALInferenceInit.h>
+#include <lal/LALInferenceReadData.h>
+#include <lal/LALInferenceCalibrationErrors.h>
+#include <lal/LALInferenceLikelihood.h>
+#include <lal/LALInferencePrior.h>
+#include <lal/LALInferenceProposal.h>
+
+const char HELPSTR[]=\
+"LALInferenceFastExtrinsicTest: Unit test for consistency between the likelihood computed from the\n\
+ inner products cached by --fast-extrinsic-likelihood and the likelihood computed from the waveform.\n\
+ Example (for H1 and L1 with seglen 8, srate 1024): \n\
+ $ ./LALInferenceFastExtrinsicTest --psdlength 256 --psdstart 1 --seglen 8 --srate 1024 --trigtime 0 --ifo H1 --ifo L1 --H1-channel LALSimAdLIGO --H1-cache LALSimAdLIGO --L1-channel LALSimAdLIGO --L1-cache LALSimAdLIGO --dataseed 1324 --randomseed 1324 --approximant TaylorF2 --amporder 0 --fast-extrinsic-likelihood\n\n\n\
+";
+
+/* Allowed error in log-likelihood from the interpolation of the cached
+ <d|h>, relative to 1 + <h|h> */
+#define FAST_EXTRINSIC_TOLERANCE 1e-3
+
+/* A move of the extrinsic parameters, applied to each parameter present */
+typedef struct
+{
+  const char *name;
+  const char *params[3];
+  REAL8 shifts[3];
+} ExtrinsicMove;
+
+static const ExtrinsicMove moves[]={
+  {"sky", {"rightascension","declination",NULL}, {0.3,-0.2,0}},
+  {"polarisation", {"polarisation",NULL,NULL}, {0.4,0,0}},
+  {"time", {"time",NULL,NULL}, {1.3e-3,0,0}},
+  {"distance", {"logdistance",NULL,NULL}, {0.4,0,0}},
+  {"all", {"rightascension","polarisation","time"}, {-0.5,0.7,-2.1e-3}},
+  {"all", {"declination","logdistance","time"}, {0.3,-0.3,0.6e-3}}
+};
+
+static void shift_params(LALInferenceVariables *params, const ExtrinsicMove *move);
+static void shift_params(LALInferenceVariables *params, const ExtrinsicMove *move)
+{
+  for(UINT4 i=0;i<3 && move->params[i];i++)
+    if(LALInferenceCheckVariable(params,move->params[i]))
+    {
+      REAL8 value=LALInferenceGetREAL8Variable(params,move->params[i])+move->shifts[i];
+      LALInferenceSetVariable(params,move->params[i],&value);
+    }
+}
+
+/* Compares the likelihood of moves away from a drawn point computed by
+ thread 0, which uses the cache built for the waveform of the drawn point,
+ with the likelihood computed by thread 1 from the waveform of each point */
+int compare_extrinsic(LALInferenceRunState *runState, UINT4 Nrounds);
+int compare_extrinsic(LALInferenceRunState *runState, UINT4 Nrounds)
+{
+  LALInferenceModel *fastModel=runState->threads[0].model;
+  LALInferenceModel *exactModel=runState->threads[1].model;
+  LALInferenceVariables fast, exact;
+  INT4 nocache=0;
+  int result=1;
+
+  memset(&fast,0,sizeof(fast));
+  memset(&exact,0,sizeof(exact));
+
+  for(UINT4 round=0;round<Nrounds;round++)
+  {
+    LALInferenceDrawThreads(runState);
+    LALInferenceVariables *point=runState->threads[0].currentParams;
+
+    /* Generate the waveform of the drawn point, from which the cache is built */
+    runState->likelihood(point,runState->data,fastModel);
+
+    for(UINT4 m=0;m<sizeof(moves)/sizeof(moves[0]);m++)
+    {
+      LALInferenceCopyVariables(point,&fast);
+      shift_params(&fast,&moves[m]);
+      LALInferenceCopyVariables(&fast,&exact);
+      LALInferenceSetVariable(&exact,"extrinsic_cache",&nocache);
+
+      REAL8 fastLogL=runState->likelihood(&fast,runState->data,fastModel);
+      REAL8 exactLogL=runState->likelihood(&exact,runState->data,exactModel);
+      REAL8 tolerance=FAST_EXTRINSIC_TOLERANCE*(1.0+exactModel->SNR*exactModel->SNR);
+
+      int pass=fabs(fastLogL-exactLogL)<=tolerance;
+      fprintf(stdout,"Round %u, %s move: logL = %.6f (fast), %.6f (exact), tolerance %.3e: %s\n",
+              round,moves[m].name,fastLogL,exactLogL,tolerance,pass?"passed":"failed");
+      result&=pass;
+    }
+  }
+
+  LALInferenceClearVariables(&fast);
+  LALInferenceClearVariables(&exact);
+
+  fprintf(stdout,"Fast extrinsic likelihood test result: %s\n",result?"passed":"failed");
+  return(result);
+}
+
+int main(int argc, char *argv[]){
+  ProcessParamsTable *procParams = NULL;
+  LALInferenceRunState *runState=NULL;
+
+  procParams=LALInferenceParseCommandLine(argc,argv);
+  if(LALInferenceGetProcParamVal(procParams,"--help"))
+  {
+    fprintf(stdout,"%s",HELPSTR);
+    return(EXIT_SUCCESS);
+  }
+  if(!LALInferenceGetProcParamVal(procParams,"--fast-extrinsic-likelihood"))
+  {
+    fprintf(stderr,"--fast-extrinsic-likelihood is required\n");
+    return(EXIT_FAILURE);
+  }
+
+  runState = LALInferenceInitRunState(procParams);
+  if(!runState)
+  {
+    fprintf(stderr,"Unable to set up the data\n");
+    return(EXIT_FAILURE);
+  }
+
+  LALInferenceInjectInspiralSignal(runState->data,runState->commandLine);
+  LALInferenceApplyCalibrationErrors(runState->data,runState->commandLine);
+  runState->proposalArgs = LALInferenceParseProposalArgs(runState);
+
+  /* Thread 0 evaluates the fast likelihood, thread 1 the exact one */
+  LALInferenceInitCBCThreads(runState,2);
+  LALInferenceInitCBCPrior(runState);
+  LALInferenceInitLikelihood(runState);
+
+  int result = compare_extrinsic(runState, 3);
+
+  for(INT4 t=0;t<runState->nthreads;t++)
+    LALInferenceClearThreadBuffers(&runState->threads[t]);
+
+  return(result ? EXIT_SUCCESS : EXIT_FAILURE);
+}
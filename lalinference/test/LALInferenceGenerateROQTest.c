@@ -31,6 +31,17 @@ double real_model(double frequency, double Mchirp, double modperiod);
 /* model for a complex frequency domain inspiral-like signal */
 COMPLEX16 imag_model(double frequency, double Mchirp, double modperiod);
 
+/* number of chunks the training set is split into for the streaming basis generation */
+#define NCHUNKS 4
+
+/* produce chunks of a training set of complex waveforms for the streaming basis generation */
+typedef struct tagChunkContext {
+  size_t wl;
+  double fmin, fmax, Mcmin, Mcmax, modperiod;
+} ChunkContext;
+
+INT4 complex_training_chunk(COMPLEX16Array **TS, UINT4 chunk, void *context);
+
 double calc_phase(double frequency, double Mchirp){
   return (-0.25*LAL_PI + ( 3./( 128. * pow(Mchirp*LAL_MTSUN_SI*LAL_PI*frequency, 5./3.) ) ) );
 }
@@ -43,6 +54,31 @@ COMPLEX16 imag_model(double frequency, double Mchirp, double modperiod){
   return ( pow(frequency, -7./6.) * pow(Mchirp*LAL_MTSUN_SI,5./6.) * cexp(I*calc_phase(frequency,Mchirp)) )*sin(LAL_TWOPI*frequency/modperiod);
 }
 
+INT4 complex_training_chunk(COMPLEX16Array **TS, UINT4 chunk, void *context){
+  ChunkContext *c = (ChunkContext *)context;
+  size_t nrows = TSSIZE/NCHUNKS;
+
+  *TS = NULL;
+  if ( chunk >= NCHUNKS ){ return XLAL_SUCCESS; }
+
+  UINT4Vector *dims = XLALCreateUINT4Vector( 2 );
+  dims->data[0] = nrows;
+  dims->data[1] = c->wl;
+  *TS = XLALCreateCOMPLEX16Array( dims );
+  XLALDestroyUINT4Vector( dims );
+
+  for ( size_t k=0; k < nrows; k++ ){
+    size_t n = chunk*nrows + k;
+    double Mc = pow(pow(c->Mcmin, 5./3.) + (double)n*(pow(c->Mcmax, 5./3.)-pow(c->Mcmin, 5./3.))/((double)TSSIZE-1), 3./5.);
+    for ( size_t j=0; j < c->wl; j++ ){
+      double f0 = c->fmin + (double)j*(c->fmax-c->fmin)/((double)c->wl-1.);
+      (*TS)->data[k*c->wl + j] = imag_model(f0, Mc, c->modperiod);
+    }
+  }
+
+  return XLAL_SUCCESS;
+}
+
 int main(void) {
   REAL8Array *TS = NULL, *TSquad = NULL, *cTSquad = NULL;  /* the training set of real waveforms (and quadratic model) */
   COMPLEX16Array *cTS = NULL;              /* the training set of complex waveforms */
@@ -128,6 +164,24 @@ int main(void) {
   maxprojerr = LALInferenceGenerateCOMPLEX16OrthonormalBasis(&cRBlinear, fweights, tolerance, &cTS, &gdpts);
   XLALDestroyUINT4Vector( gdpts );
   fprintf(stderr, "No. linear nodes (complex) = %d, %d x %d; Maximum projection err. = %le\n", cRBlinear->dimLength->data[0], cRBlinear->dimLength->data[0], cRBlinear->dimLength->data[1], maxprojerr);
+
+  /* create a complex reduced basis from a training set produced in chunks */
+  COMPLEX16Array *cRBstream = NULL;
+  ChunkContext chunkcontext = { wl, fmin0, fmax0, Mcmin, Mcmax, 1./100. };
+  maxprojerr = LALInferenceGenerateCOMPLEX16OrthonormalBasisStreaming(&cRBstream, fweights, tolerance, complex_training_chunk, &chunkcontext, &gdpts);
+  XLALDestroyUINT4Vector( gdpts );
+  fprintf(stderr, "No. linear nodes (complex, streamed) = %d, %d x %d; Maximum projection err. = %le\n", cRBstream->dimLength->data[0], cRBstream->dimLength->data[0], cRBstream->dimLength->data[1], maxprojerr);
+
+  /* all of the streamed training waveforms must be represented by the basis */
+  for ( k=0; k < NCHUNKS; k++ ){
+    COMPLEX16Array *chunkTS = NULL;
+    complex_training_chunk(&chunkTS, k, &chunkcontext);
+    INT4 streamtest = LALInferenceTestCOMPLEX16OrthonormalBasis(fweights, tolerance, cRBstream, &chunkTS);
+    XLALDestroyCOMPLEX16Array( chunkTS );
+    if ( streamtest != XLAL_SUCCESS ) { return 1; }
+  }
+  XLALDestroyCOMPLEX16Array( cRBstream );
+
   maxprojerr = LALInferenceGenerateREAL8OrthonormalBasis(&RBquad, fweights, tolerance, &TSquad, &gdpts);
   XLALDestroyUINT4Vector( gdpts );
   fprintf(stderr, "No. quadratic nodes (real)  = %d, %d x %d; Maximum projection err. = %le\n", RBquad->dimLength->data[0], RBquad->dimLength->data[0], RBquad->dimLength->data[1], maxprojerr);
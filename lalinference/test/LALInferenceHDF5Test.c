@@ -1,3 +1,4 @@
+#include <string.h>
 #include <lal/XLALError.h>
 #include <lal/LALInferenceHDF5.h>
 #include <gsl/gsl_test.h>
@@ -113,6 +114,69 @@ int main(int argc, char **argv)
   /* Close file. */
   XLALH5FileClose(file);
 
+  /* Fill a packed differential evolution buffer, as a checkpoint does. */
+  LALInferenceThreadState thread;
+  memset(&thread, 0, sizeof(thread));
+  LALInferenceVariables *current = XLALCalloc(1, sizeof(LALInferenceVariables));
+  LALInferenceAddREAL8Variable(current, "abc", 0, LALINFERENCE_PARAM_LINEAR);
+  LALInferenceAddREAL8Variable(current, "def", 0, LALINFERENCE_PARAM_CIRCULAR);
+  LALInferenceAddREAL8Variable(current, "ghi", 5, LALINFERENCE_PARAM_FIXED);
+  LALInferenceAddINT4Variable (current, "lmn", 0, LALINFERENCE_PARAM_LINEAR);
+  for (UINT4 i = 0; i < N; i ++)
+  {
+    REAL8 x = 0.5 * i;
+    LALInferenceSetVariable(current, "abc", &x);
+    x = -0.25 * i;
+    LALInferenceSetVariable(current, "def", &x);
+    LALInferenceAppendDifferentialPoint(&thread, current);
+  }
+  const UINT4 nPar = thread.differentialPointsSchema->length;
+  REAL8 *saved = XLALMalloc(N * nPar * sizeof(REAL8));
+  memcpy(saved, thread.differentialPointsArray, N * nPar * sizeof(REAL8));
+
+  /* Write the buffer, expanded onto the current parameters. */
+  file = XLALH5FileOpen("test.hdf5", "w");
+  group = LALInferenceH5CreateGroupStructure(
+    file, "lalinference", "lalinference_mcmc");
+  LALInferenceH5PackedArrayToDataset(
+    group, current, thread.differentialPointsArray, N, "differential_points");
+  XLALH5FileClose(group);
+  XLALH5FileClose(file);
+
+  /* Read it back and restore the buffer, as a resumed run does. */
+  file = XLALH5FileOpen("test.hdf5", "r");
+  dataset = XLALH5DatasetRead(
+    file, "lalinference/lalinference_mcmc/differential_points");
+  UINT4 nPts = 0;
+  vars_array = NULL;
+  LALInferenceH5DatasetToVariablesArray(dataset, &vars_array, &nPts);
+  LALInferenceClearDifferentialPoints(&thread);
+  for (UINT4 i = 0; i < nPts; i ++)
+  {
+    LALInferenceAppendDifferentialPoint(&thread, vars_array[i]);
+    LALInferenceClearVariables(vars_array[i]);
+    XLALFree(vars_array[i]);
+  }
+  XLALFree(vars_array);
+  XLALH5DatasetFree(dataset);
+  XLALH5FileClose(file);
+
+  gsl_test_int(nPts, N, "number of differential points read back");
+  gsl_test_int(thread.differentialPointsLength, N,
+    "number of differential points restored");
+  gsl_test_int(thread.differentialPointsSchema->length, nPar,
+    "number of differential point columns restored");
+  gsl_test_int(LALInferenceVariablesMatchSchema(
+      thread.differentialPointsSchema, current), 1,
+    "layout of differential points restored");
+  gsl_test_int(memcmp(saved, thread.differentialPointsArray,
+      N * nPar * sizeof(REAL8)), 0, "values of differential points restored");
+
+  XLALFree(saved);
+  LALInferenceClearDifferentialPoints(&thread);
+  LALInferenceClearVariables(current);
+  XLALFree(current);
+
   /* Check for memory leaks. */
   LALCheckMemoryLeaks();
 
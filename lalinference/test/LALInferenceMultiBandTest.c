@@ -21,13 +21,21 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
 #include <lal/LALInference.h>
 #include <lal/LALInferenceInit.h>
 #include <lal/LALInferenceReadData.h>
 #include <lal/LALInferenceCalibrationErrors.h>
 #include <lal/LALInferenceTemplate.h>
 #include <lal/LALInferenceLikelihood.h>
+#include <lal/LALInferenceMultibanding.h>
+#include <lal/LALConstants.h>
 #include <sys/resource.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_test.h>
 
 #ifdef __GNUC__
 #define UNUSED __attribute__ ((unused))
@@ -36,13 +44,164 @@
 #endif
 
 const char HELPSTR[]=\
-"LALInferenceMultiBandTest: Unit test for consistency between multiband and regular template functions.\n\
+"LALInferenceMultiBandTest: Unit test for consistency between multiband and regular template and likelihood functions.\n\
+ Without arguments, compares the multibanded inner products with those over the full frequency grid on synthetic data.\n\
  Example (for 1.4-1.4 binary with seglen 32, srate 4096): \n\
  $ ./LALInferenceMultiBandTest --psdlength 1000 --psdstart 1 --seglen 32 --srate 4096 --trigtime 0 --ifo H1 --H1-channel LALSimAdLIGO --H1-cache LALSimAdLIGO --dataseed 1324 --fix-chirpmass 1.218 --fix-q 1.0 --margphi\n\n\n\
 ";
 
 COMPLEX16 compute_mismatch(LALInferenceIFOData *data, COMPLEX16FrequencySeries *a, COMPLEX16FrequencySeries *b);
 
+/* Layout of the synthetic data: sampling rate, duration and frequency range */
+#define SYNTH_SRATE 1024.0
+#define SYNTH_SEGLEN 32
+#define SYNTH_FLOW 20.0
+#define SYNTH_FHIGH 400.0
+
+/* Chirp mass of the synthetic signal and the smallest one of the layout,
+   time of the merger after the start of the data, and allowed offset */
+#define SYNTH_MC 5.0
+#define SYNTH_MC_MIN 4.5
+#define SYNTH_TIME 28.0
+#define SYNTH_MARGIN 0.05
+
+/* Optimal SNR of the synthetic signal, and the allowed error of <d|h> and
+   <h|h> (which is the error in the log-likelihood) */
+#define SYNTH_SNR 20.0
+#define SYNTH_TOLERANCE 1e-2
+
+static REAL8 synthetic_psd(REAL8 f)
+{
+  REAL8 x = f/100.0;
+  return f > 0.0 ? 1.0/(x*x*x*x) + 2.0 + x*x : 1.0;
+}
+
+/* Newtonian stationary phase approximation of an inspiral merging at time
+   zero, which the time shift of the likelihood moves into the data */
+static COMPLEX16 synthetic_signal(REAL8 f)
+{
+  const REAL8 mc = SYNTH_MC*LAL_MTSUN_SI;
+  return pow(f, -7.0/6.0)*cexp(-I*(3.0/128.0*pow(LAL_PI*mc*f, -5.0/3.0) - LAL_PI_4));
+}
+
+/* Compares <d|h> and <h|h> of the multibanded likelihood with the sums over
+   all frequency bins which the likelihood computes without multibanding,
+   for a synthetic signal in Gaussian noise, at several time shifts */
+int compare_inner_products(void);
+int compare_inner_products(void)
+{
+  const UINT4 N = (UINT4)(SYNTH_SEGLEN*SYNTH_SRATE);
+  const REAL8 deltaT = 1.0/SYNTH_SRATE;
+  const REAL8 deltaF = 1.0/SYNTH_SEGLEN;
+  const REAL8 TwoDeltaToverN = 2.0*deltaT/((REAL8)N);
+  const REAL8 Fplus = 0.6, Fcross = -0.3;
+  const REAL8 shifts[] = {-0.9*SYNTH_MARGIN, -0.013, 0.0, 0.021, 0.9*SYNTH_MARGIN};
+  LIGOTimeGPS epoch = LIGOTIMEGPSZERO;
+  int result = 1;
+
+  LALInferenceIFOData data;
+  memset(&data, 0, sizeof(data));
+  snprintf(data.name, DETNAMELEN, "H1");
+  data.fLow = SYNTH_FLOW;
+  data.fHigh = SYNTH_FHIGH;
+  data.timeData = XLALCreateREAL8TimeSeries("synthetic data", &epoch, 0.0, deltaT, &lalDimensionlessUnit, N);
+  data.freqData = XLALCreateCOMPLEX16FrequencySeries("synthetic data", &epoch, 0.0, deltaF, &lalDimensionlessUnit, N/2 + 1);
+  data.oneSidedNoisePowerSpectrum = XLALCreateREAL8FrequencySeries("synthetic PSD", &epoch, 0.0, deltaF, &lalDimensionlessUnit, N/2 + 1);
+
+  /* Scale the signal to the requested SNR */
+  const UINT4 lower = (UINT4)ceil(SYNTH_FLOW/deltaF), upper = (UINT4)floor(SYNTH_FHIGH/deltaF);
+  REAL8 norm = 0.0;
+  for (UINT4 i = lower; i <= upper; i++)
+  {
+    REAL8 f = i*deltaF;
+    norm += TwoDeltaToverN/(synthetic_psd(f)*deltaT*deltaT)*pow(cabs((Fplus - I*Fcross)*synthetic_signal(f)), 2);
+  }
+  const REAL8 amplitude = SYNTH_SNR/sqrt(norm);
+
+  /* Signal at the reference time in noise whose variance per bin is half
+     the inverse weight of the inner products */
+  gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+  gsl_rng_set(rng, 1324);
+  for (UINT4 i = 0; i <= N/2; i++)
+  {
+    REAL8 f = i*deltaF;
+    REAL8 psd = synthetic_psd(f);
+    REAL8 sigma = sqrt(0.5*psd*deltaT*deltaT/TwoDeltaToverN);
+    data.oneSidedNoisePowerSpectrum->data->data[i] = psd;
+    data.freqData->data->data[i] = gsl_ran_gaussian(rng, sigma) + I*gsl_ran_gaussian(rng, sigma);
+    if (i > 0)
+      data.freqData->data->data[i] += amplitude*(Fplus - I*Fcross)*synthetic_signal(f)*cexp(-I*LAL_TWOPI*f*SYNTH_TIME);
+  }
+  gsl_rng_free(rng);
+
+  LALInferenceMultibandModel *mb = LALInferenceCreateMultibandModel(SYNTH_FLOW, SYNTH_FHIGH, deltaT, N, SYNTH_MC_MIN,
+                                                                    SYNTH_TIME, SYNTH_MARGIN);
+  LALInferenceMultibandData *mbdata = mb ? LALInferenceCreateMultibandData(mb, &data) : NULL;
+  if (!mbdata)
+  {
+    fprintf(stderr, "Unable to set up the multibanded likelihood\n");
+    return(0);
+  }
+
+  /* The template at the nodes, with the cross polarisation lagging by a quarter cycle */
+  const UINT4 nfreq = mb->frequencies->length;
+  mb->hptilde = XLALCreateCOMPLEX16FrequencySeries("mbtemplate", &epoch, 0.0, deltaF, &lalDimensionlessUnit, nfreq);
+  mb->hctilde = XLALCreateCOMPLEX16FrequencySeries("mbtemplate", &epoch, 0.0, deltaF, &lalDimensionlessUnit, nfreq);
+  for (UINT4 i = 0; i < nfreq; i++)
+  {
+    mb->hptilde->data->data[i] = amplitude*synthetic_signal(mb->frequencies->data[i]);
+    mb->hctilde->data->data[i] = -I*mb->hptilde->data->data[i];
+  }
+
+  for (UINT4 k = 0; k < sizeof(shifts)/sizeof(shifts[0]); k++)
+  {
+    const REAL8 timeshift = SYNTH_TIME + shifts[k];
+    COMPLEX16 dh = 0.0, mbdh;
+    REAL8 hh = 0.0, mbhh;
+
+    for (UINT4 i = lower; i <= upper; i++)
+    {
+      REAL8 f = i*deltaF;
+      REAL8 weight = TwoDeltaToverN/(data.oneSidedNoisePowerSpectrum->data->data[i]*deltaT*deltaT);
+      COMPLEX16 h = amplitude*(Fplus - I*Fcross)*synthetic_signal(f)*cexp(-I*LAL_TWOPI*f*timeshift);
+      dh += weight*data.freqData->data->data[i]*conj(h);
+      hh += weight*(creal(h)*creal(h) + cimag(h)*cimag(h));
+    }
+
+    if (LALInferenceMultibandInnerProducts(&mbdh, &mbhh, mb, mbdata, Fplus, Fcross, NULL, timeshift) != XLAL_SUCCESS)
+    {
+      fprintf(stderr, "Multibanded inner products failed at time shift %g\n", timeshift);
+      result = 0;
+      continue;
+    }
+
+    int pass = cabs(mbdh - dh) <= SYNTH_TOLERANCE && fabs(mbhh - hh) <= SYNTH_TOLERANCE;
+    fprintf(stdout, "Time shift %+.3f s: <d|h> = %.6f%+.6fi (full), %.6f%+.6fi (mb); <h|h> = %.6f (full), %.6f (mb): %s\n",
+            shifts[k], creal(dh), cimag(dh), creal(mbdh), cimag(mbdh), hh, mbhh, pass ? "passed" : "failed");
+    result &= pass;
+  }
+
+  /* Time shifts beyond the margin of the layout are rejected */
+  COMPLEX16 mbdh;
+  REAL8 mbhh;
+  int errnum;
+  XLAL_TRY(LALInferenceMultibandInnerProducts(&mbdh, &mbhh, mb, mbdata, Fplus, Fcross, NULL, SYNTH_TIME + 2.0*SYNTH_MARGIN), errnum);
+  if (errnum != XLAL_EDOM)
+  {
+    fprintf(stderr, "Time shift outside the margin was not rejected\n");
+    result = 0;
+  }
+
+  LALInferenceDestroyMultibandData(mbdata);
+  LALInferenceDestroyMultibandModel(mb);
+  XLALDestroyREAL8TimeSeries(data.timeData);
+  XLALDestroyCOMPLEX16FrequencySeries(data.freqData);
+  XLALDestroyREAL8FrequencySeries(data.oneSidedNoisePowerSpectrum);
+
+  fprintf(stdout, "Inner product test result: %s\n", result ? "passed" : "failed");
+  return(result);
+}
+
 
 void LALInferenceTemplateNoop(UNUSED LALInferenceModel *model);
 void LALInferenceTemplateNoop(UNUSED LALInferenceModel *model)
@@ -130,6 +289,39 @@ int compare_template(LALInferenceRunState *runState)
   return(result);
 }
 
+int compare_likelihood(LALInferenceRunState *runState);
+int compare_likelihood(LALInferenceRunState *runState)
+{
+  LALInferenceModel *model = runState->threads[0].model;
+  REAL8 tolerance = 0.1; /* Error in log-likelihood */
+
+  if(!model->multiband && LALInferenceSetupMultibandModel(model, runState->data, runState->priorArgs)!=XLAL_SUCCESS)
+  {
+    fprintf(stderr,"Unable to set up the multibanded likelihood\n");
+    return(0);
+  }
+  LALInferenceMultibandModel *mb = model->multiband;
+
+  /* Full frequency grid */
+  model->multiband = NULL;
+  model->templt=&LALInferenceTemplateXLALSimInspiralChooseWaveform;
+  REAL8 logL = runState->likelihood(model->params, runState->data, model);
+
+  /* Multibanded */
+  model->multiband = mb;
+  model->templt=&LALInferenceMultibandWrapperForXLALSimInspiralChooseFDWaveformSequence;
+  REAL8 mbLogL = runState->likelihood(model->params, runState->data, model);
+
+  int result = fabs(mbLogL-logL) < tolerance;
+
+  fprintf(stdout,"\n\n");
+  fprintf(stdout,"logL    = %lf\n",logL);
+  fprintf(stdout,"logL mb = %lf\n",mbLogL);
+  fprintf(stdout,"Tolerance = %le\n",tolerance);
+  fprintf(stdout,"Likelihood test result: %s\n",result?"passed":"failed");
+  return(result);
+}
+
 /* Computes <a-b|a-b> */
 COMPLEX16 compute_mismatch(LALInferenceIFOData *data, COMPLEX16FrequencySeries *a, COMPLEX16FrequencySeries *b)
 {
@@ -141,35 +333,44 @@ COMPLEX16 compute_mismatch(LALInferenceIFOData *data, COMPLEX16FrequencySeries *
 }
 
 int main(int argc, char *argv[]){
-  
-  //#define default_command_line_len 18
-  //char * const default_command_line[default_command_line_len];
-  
-  //"--psdlength","1000","--psdstart","1","--seglen","64","--srate","4096","--trigtime","0","--ifo","H1","--H1-channel","LALSimAdLIGO","--H1-cache","LALSimAdLIGO","--dataseed","1234"};
-
-  
   ProcessParamsTable *procParams = NULL;
   LALInferenceRunState *runState=NULL;
-  
-  procParams=LALInferenceParseCommandLine(argc,argv);
 
-  runState = LALInferenceInitRunState(procParams);
-  
-  if(runState) {
+  gsl_test(!compare_inner_products(), "multibanded inner products on synthetic data");
+
+  /* The template and likelihood comparisons need data from the command line */
+  if(argc > 1)
+  {
+    procParams=LALInferenceParseCommandLine(argc,argv);
+    if(LALInferenceGetProcParamVal(procParams,"--help"))
+    {
+      fprintf(stdout,"%s",HELPSTR);
+      return(EXIT_SUCCESS);
+    }
+
+    runState = LALInferenceInitRunState(procParams);
+    if(!runState)
+    {
+      fprintf(stderr,"Unable to set up the data\n");
+      return(EXIT_FAILURE);
+    }
     LALInferenceInjectInspiralSignal(runState->data,runState->commandLine);
 
     /* Simulate calibration errors */
     LALInferenceApplyCalibrationErrors(runState->data,runState->commandLine);
+
+    /* Set up the template and likelihood functions */
+    LALInferenceInitCBCThreads(runState,1);
+    LALInferenceInitLikelihood(runState);
+
+    /* Disable waveform caching */
+    runState->threads[0].model->waveformCache=NULL;
+
+    gsl_test(!compare_template(runState), "phase interpolated template");
+    gsl_test(!compare_likelihood(runState), "multibanded likelihood");
+
+    LALInferenceClearThreadBuffers(&runState->threads[0]);
   }
-  
-  /* Set up the template and likelihood functions */
-  LALInferenceInitCBCThreads(runState,1);
-  LALInferenceInitLikelihood(runState);
 
-  /* Disable waveform caching */
-  runState->threads[0].model->waveformCache=NULL;
-  
-  int result = compare_template(runState);
-  
-  return(result);
+  return gsl_test_summary();
 }
@@ -0,0 +1,126 @@
+#include <math.h>
+#include <string.h>
+#include <lal/XLALError.h>
+#include <lal/LALConstants.h>
+#include <lal/LALInferenceLikelihood.h>
+#include <gsl/gsl_spline.h>
+#include <gsl/gsl_test.h>
+
+/* number of linear basis elements */
+#define NBASIS 64
+
+/* number, start and spacing of the time steps of the weights */
+#define NSTEPS 101
+#define TSTART -0.01
+#define TSTEP 2e-4
+
+/* allowed interpolation error of <d|h>, relative to sum |w||h| */
+#define INTERPTOL 1e-4
+
+/* weight of basis element k at time shift t, shaped like the weights of a
+ signal which is time shifted by t */
+static COMPLEX16 weight(UINT4 k, REAL8 t)
+{
+  const REAL8 f = 20.0 + 80.0*k/NBASIS;
+  return (1.0 + 0.5*sin(0.7*k)) * cexp(I*(0.3*k - LAL_TWOPI*f*t));
+}
+
+/* <d|h> from the weights stored one basis element at a time, interpolated
+ with a natural cubic spline per element, as the ROQ likelihood did before
+ the weights were stored one time step at a time */
+static COMPLEX16 spline_inner_product(gsl_spline **re, gsl_spline **im, const COMPLEX16 *template_linear, REAL8 t)
+{
+  COMPLEX16 dh = 0.0;
+  for (UINT4 k = 0; k < NBASIS; k++)
+    dh += (gsl_spline_eval(re[k], t, NULL) + I*gsl_spline_eval(im[k], t, NULL)) * conj(template_linear[k]);
+  return dh;
+}
+
+int main(int argc, char **argv)
+{
+  /* Not used */
+  (void)argc;
+  (void)argv;
+  XLALSetErrorHandler(XLALExitErrorHandler);
+
+  COMPLEX16 template_linear[NBASIS];
+  REAL8 tcs[NSTEPS], wre[NSTEPS], wim[NSTEPS];
+  gsl_spline *re[NBASIS], *im[NBASIS];
+  REAL8 scale = 0.0;
+
+  LALInferenceROQData roq;
+  memset(&roq, 0, sizeof(roq));
+  roq.weightsLinear = XLALMalloc(NSTEPS*NBASIS*sizeof(COMPLEX16));
+  roq.n_basis_linear = NBASIS;
+  roq.n_time_steps = NSTEPS;
+  roq.time_step_start = TSTART;
+  roq.time_step_size = TSTEP;
+
+  for (UINT4 j = 0; j < NSTEPS; j++)
+    tcs[j] = TSTART + j*TSTEP;
+  for (UINT4 k = 0; k < NBASIS; k++)
+  {
+    template_linear[k] = cos(0.2*k) + I*sin(0.45*k);
+    scale += cabs(weight(k, 0.0))*cabs(template_linear[k]);
+
+    /* weights of all time steps of one basis element, as in the weights file */
+    for (UINT4 j = 0; j < NSTEPS; j++)
+    {
+      wre[j] = creal(weight(k, tcs[j]));
+      wim[j] = cimag(weight(k, tcs[j]));
+      roq.weightsLinear[j*NBASIS + k] = weight(k, tcs[j]);
+    }
+    re[k] = gsl_spline_alloc(gsl_interp_cspline, NSTEPS);
+    im[k] = gsl_spline_alloc(gsl_interp_cspline, NSTEPS);
+    gsl_spline_init(re[k], tcs, wre, NSTEPS);
+    gsl_spline_init(im[k], tcs, wim, NSTEPS);
+  }
+
+  /* The interpolation is exact at the time steps, including the ends */
+  for (UINT4 j = 0; j < NSTEPS; j += 25)
+  {
+    COMPLEX16 dh, exact = 0.0;
+    for (UINT4 k = 0; k < NBASIS; k++)
+      exact += weight(k, tcs[j])*conj(template_linear[k]);
+    LALInferenceROQLinearInnerProduct(&dh, &roq, template_linear, NBASIS, tcs[j]);
+    gsl_test_abs(cabs(dh - exact), 0.0, 1e-12*scale, "<d|h> at time step %u", j);
+  }
+
+  /* Between the time steps the time-major interpolation agrees with the
+   splines of the old layout, away from the ends where the natural splines
+   are less accurate, and with the weights it interpolates */
+  for (UINT4 i = 0; i < 40; i++)
+  {
+    const REAL8 t = TSTART + (10.0 + 0.2317*i)*TSTEP;
+    COMPLEX16 dh, exact = 0.0;
+    for (UINT4 k = 0; k < NBASIS; k++)
+      exact += weight(k, t)*conj(template_linear[k]);
+    LALInferenceROQLinearInnerProduct(&dh, &roq, template_linear, NBASIS, t);
+    gsl_test_abs(cabs(dh - spline_inner_product(re, im, template_linear, t)), 0.0, INTERPTOL*scale,
+                 "<d|h> at time shift %g against the spline of the old layout", t);
+    gsl_test_abs(cabs(dh - exact), 0.0, INTERPTOL*scale, "<d|h> at time shift %g against the exact weights", t);
+  }
+
+  /* Time shifts outside the grid and mismatched templates are rejected */
+  int errnum;
+  COMPLEX16 dh;
+  XLAL_TRY(LALInferenceROQLinearInnerProduct(&dh, &roq, template_linear, NBASIS, TSTART - 0.5*TSTEP), errnum);
+  gsl_test_int(errnum, XLAL_EDOM, "time shift before the first time step");
+  XLAL_TRY(LALInferenceROQLinearInnerProduct(&dh, &roq, template_linear, NBASIS, TSTART + NSTEPS*TSTEP), errnum);
+  gsl_test_int(errnum, XLAL_EDOM, "time shift after the last time step");
+  XLAL_TRY(LALInferenceROQLinearInnerProduct(&dh, &roq, template_linear, NBASIS - 1, 0.0), errnum);
+  gsl_test_int(errnum, XLAL_EBADLEN, "template with the wrong number of nodes");
+
+  for (UINT4 k = 0; k < NBASIS; k++)
+  {
+    gsl_spline_free(re[k]);
+    gsl_spline_free(im[k]);
+  }
+  XLALFree(roq.weightsLinear);
+
+  /* Check for memory leaks. */
+  LALCheckMemoryLeaks();
+
+  /* Done! */
+  return gsl_test_summary();
+}
@@ -37,6 +37,7 @@
 #include <lal/LALInferenceLikelihood.h>
 #include <lal/LALInferenceTemplate.h>
 #include <lal/LALInferencePrior.h>
+#include <lal/LALInferenceProposal.h>
 
 #include "LALInferenceTest.h"
 
@@ -59,6 +60,13 @@ int LALInferenceProcessParamLine_TEST_CHARFILE(void);
 /*  LALInferenceExecuteFT tests */
 int LALInferenceExecuteFTTEST_NULLPLAN(void);
 
+/*  LALInferenceVariablesSchema tests */
+int LALInferenceVariablesSchema_TEST(void);
+
+/*  Differential evolution buffer tests */
+int LALInferenceDifferentialPoints_TEST(void);
+int LALInferenceDifferentialPointsMismatch_TEST(void);
+
 int main(void){
     
 	int failureCount = 0;
@@ -77,6 +85,12 @@ int main(void){
 	printf("\n");
 	failureCount += LALInferenceExecuteFTTEST_NULLPLAN();
 	printf("\n");
+	failureCount += LALInferenceVariablesSchema_TEST();
+	printf("\n");
+	failureCount += LALInferenceDifferentialPoints_TEST();
+	printf("\n");
+	failureCount += LALInferenceDifferentialPointsMismatch_TEST();
+	printf("\n");
 	printf("Test results: %i failure(s).\n", failureCount);
 
 	return failureCount;
@@ -356,6 +370,253 @@ int LALInferenceExecuteFTTEST_NULLPLAN(void){
 
 }
 
+/*****************     TEST CODE for LALInferenceVariablesSchema     *****************/
+
+/* The schema holds the varying REAL8 parameters, in list order */
+int LALInferenceVariablesSchema_TEST(void){
+    TEST_HEADER();
+    int errnum;
+    REAL8 x = 1.0;
+    INT4 n = 3;
+
+    LALInferenceVariables *vars = XLALCalloc(1, sizeof(LALInferenceVariables));
+    LALInferenceAddREAL8Variable(vars, "distance", x, LALINFERENCE_PARAM_LINEAR);
+    LALInferenceAddREAL8Variable(vars, "psd_scale", x, LALINFERENCE_PARAM_FIXED);
+    LALInferenceAddINT4Variable(vars, "nlines", n, LALINFERENCE_PARAM_LINEAR);
+    LALInferenceAddREAL8Variable(vars, "phase", x, LALINFERENCE_PARAM_CIRCULAR);
+    LALInferenceAddREAL8Variable(vars, "logl", x, LALINFERENCE_PARAM_OUTPUT);
+
+    LALInferenceVariablesSchema *schema = LALInferenceCreateVariablesSchema(vars);
+    if (schema == NULL)
+    {
+        TEST_FAIL("Could not create schema; XLAL error: %s.", XLALErrorString(xlalErrno));
+        TEST_FOOTER();
+    }
+
+    if (schema->length != 2)
+        TEST_FAIL("Schema has %u parameters, expected 2.", schema->length);
+    if (LALInferenceVariablesSchemaIndex(schema, "distance") != 1 || LALInferenceVariablesSchemaIndex(schema, "phase") != 0)
+        TEST_FAIL("Schema parameters are not in list order.");
+    if (LALInferenceVariablesSchemaIndex(schema, "psd_scale") != -1 || LALInferenceVariablesSchemaIndex(schema, "nlines") != -1 ||
+        LALInferenceVariablesSchemaIndex(schema, "logl") != -1 || LALInferenceVariablesSchemaIndex(schema, "foo") != -1)
+        TEST_FAIL("Schema contains parameters which are not varying REAL8s.");
+    XLAL_TRY(LALInferenceVariablesSchemaIndex(schema, NULL), errnum);
+    if (errnum != XLAL_EFAULT)
+        TEST_FAIL("Looking up a NULL name should fail with XLAL_EFAULT.");
+
+    if (!LALInferenceVariablesMatchSchema(schema, vars))
+        TEST_FAIL("Variables do not match their own schema.");
+
+    /* Changing non-sampling parameters keeps the layout */
+    LALInferenceAddREAL8Variable(vars, "logprior", x, LALINFERENCE_PARAM_OUTPUT);
+    LALInferenceSetVariable(vars, "distance", &x);
+    if (!LALInferenceVariablesMatchSchema(schema, vars))
+        TEST_FAIL("Adding an output parameter changed the layout.");
+
+    /* Adding, fixing or reordering sampling parameters does not */
+    LALInferenceVariables *copy = XLALCalloc(1, sizeof(LALInferenceVariables));
+    LALInferenceCopyVariables(vars, copy);
+    LALInferenceAddREAL8Variable(copy, "time", x, LALINFERENCE_PARAM_LINEAR);
+    if (LALInferenceVariablesMatchSchema(schema, copy))
+        TEST_FAIL("Variables with an extra parameter match the schema.");
+    LALInferenceClearVariables(copy);
+    LALInferenceCopyVariables(vars, copy);
+    LALInferenceGetItem(copy, "phase")->vary = LALINFERENCE_PARAM_FIXED;
+    if (LALInferenceVariablesMatchSchema(schema, copy))
+        TEST_FAIL("Variables with a fixed parameter match the schema.");
+    LALInferenceClearVariables(copy);
+    LALInferenceAddREAL8Variable(copy, "phase", x, LALINFERENCE_PARAM_CIRCULAR);
+    LALInferenceAddREAL8Variable(copy, "distance", x, LALINFERENCE_PARAM_LINEAR);
+    if (LALInferenceVariablesMatchSchema(schema, copy))
+        TEST_FAIL("Reordered variables match the schema.");
+    if (LALInferenceVariablesMatchSchema(NULL, vars) || LALInferenceVariablesMatchSchema(schema, NULL))
+        TEST_FAIL("NULL arguments match.");
+
+    /* The thread schema is rebuilt when the layout changes */
+    LALInferenceThreadState *thread = LALInferenceInitThread(NULL);
+    const LALInferenceVariablesSchema *threadSchema = LALInferenceGetThreadSchema(thread, vars);
+    if (threadSchema == NULL || threadSchema->length != 2)
+        TEST_FAIL("Thread schema does not hold the varying REAL8 parameters.");
+    if (LALInferenceGetThreadSchema(thread, vars) != threadSchema)
+        TEST_FAIL("Thread schema was rebuilt for an unchanged layout.");
+    threadSchema = LALInferenceGetThreadSchema(thread, copy);
+    if (threadSchema == NULL || LALInferenceVariablesSchemaIndex(threadSchema, "distance") != 0)
+        TEST_FAIL("Thread schema was not rebuilt for a changed layout.");
+    LALInferenceClearThreadBuffers(thread);
+    if (thread->schema != NULL)
+        TEST_FAIL("Thread schema was not freed.");
+
+    LALInferenceDestroyVariablesSchema(schema);
+    LALInferenceClearVariables(copy);
+    LALInferenceClearVariables(vars);
+    XLALFree(copy);
+    XLALFree(vars);
+
+    TEST_FOOTER();
+}
+
+/*****************     TEST CODE for the differential evolution buffer     *****************/
+
+/* Points are packed in the order of the buffer schema, and thinning keeps the odd points */
+int LALInferenceDifferentialPoints_TEST(void){
+    TEST_HEADER();
+    int errnum;
+    UINT4 i;
+    const UINT4 nPts = 5;
+    REAL8 x = 0.0;
+
+    LALInferenceVariables *vars = XLALCalloc(1, sizeof(LALInferenceVariables));
+    LALInferenceAddREAL8Variable(vars, "a", x, LALINFERENCE_PARAM_LINEAR);
+    LALInferenceAddREAL8Variable(vars, "fixed", x, LALINFERENCE_PARAM_FIXED);
+    LALInferenceAddREAL8Variable(vars, "b", x, LALINFERENCE_PARAM_CIRCULAR);
+
+    /* Pack and unpack the sampling parameters */
+    LALInferenceVariablesSchema *schema = LALInferenceCreateVariablesSchema(vars);
+    REAL8 packed[2] = {1.0, 2.0};
+    XLAL_TRY(LALInferenceUnpackVariables(vars, schema, packed), errnum);
+    if (errnum != XLAL_SUCCESS || LALInferenceGetREAL8Variable(vars, "b") != 1.0 || LALInferenceGetREAL8Variable(vars, "a") != 2.0)
+        TEST_FAIL("Unpacking did not set the sampling parameters in schema order.");
+    packed[0] = packed[1] = 0.0;
+    XLAL_TRY(LALInferencePackVariables(packed, schema, vars), errnum);
+    if (errnum != XLAL_SUCCESS || packed[0] != 1.0 || packed[1] != 2.0)
+        TEST_FAIL("Packing did not return the sampling parameters in schema order.");
+
+    /* Append points, growing the buffer */
+    LALInferenceThreadState *thread = LALInferenceInitThread(NULL);
+    for (i = 0; i < nPts; i++) {
+        x = i;
+        LALInferenceSetVariable(vars, "a", &x);
+        x = 10.0 + i;
+        LALInferenceSetVariable(vars, "b", &x);
+        XLAL_TRY(LALInferenceAppendDifferentialPoint(thread, vars), errnum);
+        if (errnum != XLAL_SUCCESS)
+            TEST_FAIL("Could not append point %u; XLAL error: %s.", i, XLALErrorString(errnum));
+    }
+    if (thread->differentialPointsLength != nPts || thread->differentialPointsSize < nPts)
+        TEST_FAIL("Buffer holds %zu of %zu points, expected %u.", thread->differentialPointsLength, thread->differentialPointsSize, nPts);
+
+    const LALInferenceVariablesSchema *deSchema = LALInferenceGetDifferentialPointsSchema(thread);
+    if (deSchema == NULL || !LALInferenceVariablesMatchSchema(deSchema, vars)) {
+        TEST_FAIL("Buffer schema does not match the appended points.");
+    } else {
+        INT4 ia = LALInferenceVariablesSchemaIndex(deSchema, "a"), ib = LALInferenceVariablesSchemaIndex(deSchema, "b");
+        for (i = 0; i < nPts; i++) {
+            const REAL8 *pt = LALInferenceGetDifferentialPoint(thread, i, NULL);
+            if (pt == NULL || pt[ia] != i || pt[ib] != 10.0 + i)
+                TEST_FAIL("Point %u was not stored.", i);
+        }
+    }
+
+    /* Thinning keeps the most recent point */
+    LALInferenceThinDifferentialPoints(thread);
+    if (thread->differentialPointsLength != nPts/2 || thread->differentialPointsSkip != 2)
+        TEST_FAIL("Thinned buffer holds %zu points with skip %zu, expected %u and 2.", thread->differentialPointsLength, thread->differentialPointsSkip, nPts/2);
+    for (i = 0; i < thread->differentialPointsLength; i++) {
+        const REAL8 *pt = LALInferenceGetDifferentialPoint(thread, i, NULL);
+        if (pt == NULL || pt[LALInferenceVariablesSchemaIndex(deSchema, "a")] != 2*i + 1)
+            TEST_FAIL("Thinned point %u is not point %u.", i, 2*i + 1);
+    }
+
+    /* Variables with a different layout can be neither packed nor appended */
+    LALInferenceAddREAL8Variable(vars, "c", x, LALINFERENCE_PARAM_LINEAR);
+    REAL8 mismatched[3] = {0.0, 0.0, 0.0};
+    XLAL_TRY(LALInferencePackVariables(mismatched, schema, vars), errnum);
+    if (errnum != XLAL_EINVAL)
+        TEST_FAIL("Packing mismatched variables should fail with XLAL_EINVAL.");
+    XLAL_TRY(LALInferenceUnpackVariables(vars, schema, mismatched), errnum);
+    if (errnum != XLAL_EINVAL)
+        TEST_FAIL("Unpacking to mismatched variables should fail with XLAL_EINVAL.");
+    size_t length = thread->differentialPointsLength;
+    XLAL_TRY(LALInferenceAppendDifferentialPoint(thread, vars), errnum);
+    if (errnum == XLAL_SUCCESS || thread->differentialPointsLength != length)
+        TEST_FAIL("Appending a mismatched point should fail.");
+
+    LALInferenceClearThreadBuffers(thread);
+    if (thread->differentialPointsArray != NULL || thread->differentialPointsLength != 0)
+        TEST_FAIL("Buffer was not cleared.");
+
+    LALInferenceDestroyVariablesSchema(schema);
+    LALInferenceClearVariables(vars);
+    XLALFree(vars);
+
+    TEST_FOOTER();
+}
+
+/* The differential evolution and ensemble proposals only move the
+ * parameters which the current point shares with the buffer */
+int LALInferenceDifferentialPointsMismatch_TEST(void){
+    TEST_HEADER();
+    int errnum;
+    UINT4 i, j;
+    REAL8 x = 0.0;
+
+    LALInferenceThreadState *thread = LALInferenceInitThread(NULL);
+    thread->GSLrandom = gsl_rng_alloc(gsl_rng_mt19937);
+    gsl_rng_set(thread->GSLrandom, 1234);
+
+    LALInferenceVariables *vars = XLALCalloc(1, sizeof(LALInferenceVariables));
+    LALInferenceAddREAL8Variable(vars, "a", x, LALINFERENCE_PARAM_LINEAR);
+    LALInferenceAddREAL8Variable(vars, "b", x, LALINFERENCE_PARAM_LINEAR);
+    for (i = 0; i < 10; i++) {
+        x = i;
+        LALInferenceSetVariable(vars, "a", &x);
+        x = -1.0*i*i;
+        LALInferenceSetVariable(vars, "b", &x);
+        LALInferenceAppendDifferentialPoint(thread, vars);
+    }
+
+    /* The current point lacks "b" and has "c", which is not in the buffer */
+    LALInferenceVariables *current = XLALCalloc(1, sizeof(LALInferenceVariables));
+    LALInferenceVariables *proposed = XLALCalloc(1, sizeof(LALInferenceVariables));
+    x = 0.5;
+    LALInferenceAddREAL8Variable(current, "a", x, LALINFERENCE_PARAM_LINEAR);
+    LALInferenceAddREAL8Variable(current, "c", x, LALINFERENCE_PARAM_LINEAR);
+
+    LALInferenceProposalFunction proposals[] = {
+        LALInferenceDifferentialEvolutionFull, LALInferenceEnsembleStretchFull, LALInferenceEnsembleWalkFull
+    };
+    for (j = 0; j < XLAL_NUM_ELEM(proposals); j++) {
+        for (i = 0; i < 10; i++) {
+            XLAL_TRY(proposals[j](thread, current, proposed), errnum);
+            if (errnum != XLAL_SUCCESS) {
+                TEST_FAIL("Proposal %u failed; XLAL error: %s.", j, XLALErrorString(errnum));
+            } else if (LALInferenceGetREAL8Variable(proposed, "c") != 0.5 || LALInferenceCheckVariable(proposed, "b")) {
+                TEST_FAIL("Proposal %u changed parameters which are not in the buffer.", j);
+            } else if (!isfinite(LALInferenceGetREAL8Variable(proposed, "a"))) {
+                TEST_FAIL("Proposal %u did not propose a finite value.", j);
+            }
+        }
+    }
+
+    /* The proposals share one cached column map, which is rebuilt when the
+     * parameters of the current point change */
+    const LALInferenceDifferentialColumns *map = thread->differentialColumns;
+    if (map == NULL || map->next != NULL || map->length != 1 || map->cols[0] != 0)
+        TEST_FAIL("Proposals did not cache a single column map for \"a\".");
+    LALInferenceDifferentialEvolutionFull(thread, current, proposed);
+    if (thread->differentialColumns != map)
+        TEST_FAIL("Column map was rebuilt for unchanged parameters.");
+    x = 0.5;
+    LALInferenceAddREAL8Variable(current, "b", x, LALINFERENCE_PARAM_LINEAR);
+    LALInferenceDifferentialEvolutionFull(thread, current, proposed);
+    map = thread->differentialColumns;
+    if (map == NULL || map->next != NULL || map->length != 2)
+        TEST_FAIL("Column map was not rebuilt for changed parameters.");
+    LALInferenceClearThreadBuffers(thread);
+    if (thread->differentialColumns != NULL)
+        TEST_FAIL("Column maps were not freed.");
+
+    gsl_rng_free(thread->GSLrandom);
+    LALInferenceClearVariables(vars);
+    LALInferenceClearVariables(current);
+    LALInferenceClearVariables(proposed);
+    XLALFree(vars);
+    XLALFree(current);
+    XLALFree(proposed);
+
+    TEST_FOOTER();
+}
+
 
 /******************************************
  * 
@@ -0,0 +1,195 @@
+/*
+ *  LALInferenceThreadsTest.c:  Compare concurrent and serial likelihood evaluations
+ *
+ *  Copyright (C) 2026
+ *
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <lal/LALInference.h>
+#include <lal/LALInferenceInit.h>
+#include <lal/LALInferenceReadData.h>
+#include <lal/LALInferenceCalibrationErrors.h>
+#include <lal/LALInferenceLikelihood.h>
+#include <lal/LALInferencePrior.h>
+#include <lal/LALInferenceProposal.h>
+
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
+const char HELPSTR[]=\
+"LALInferenceThreadsTest: Unit test for consistency between likelihoods evaluated concurrently\n\
+ in several threads and one at a time in a single thread.\n\
+ Example (for H1 and L1 with seglen 8, srate 1024): \n\
+ $ ./LALInferenceThreadsTest --Nthreads 4 --psdlength 256 --psdstart 1 --seglen 8 --srate 1024 --trigtime 0 --ifo H1 --ifo L1 --H1-channel LALSimAdLIGO --H1-cache LALSimAdLIGO --L1-channel LALSimAdLIGO --L1-cache LALSimAdLIGO --dataseed 1324 --randomseed 1324 --approximant TaylorF2 --amporder 0\n\n\n\
+";
+
+/* Number of per-IFO quantities recorded for each likelihood evaluation */
+#define NIFOVALUES 5
+
+static int compare_value(const char *name, UINT4 t, UINT4 ifo, REAL8 concurrent, REAL8 serial);
+static int compare_value(const char *name, UINT4 t, UINT4 ifo, REAL8 concurrent, REAL8 serial)
+{
+  REAL8 tolerance = 1e-9*fmax(1.0, fabs(serial));
+  if(fabs(concurrent-serial) <= tolerance || (isinf(concurrent) && concurrent==serial))
+    return(1);
+  fprintf(stderr,"Thread %u, IFO %u: %s = %.12e concurrently, %.12e serially\n",t,ifo,name,concurrent,serial);
+  return(0);
+}
+
+static void record_values(REAL8 *values, LALInferenceModel *model, UINT4 nifo);
+static void record_values(REAL8 *values, LALInferenceModel *model, UINT4 nifo)
+{
+  for(UINT4 i=0;i<nifo;i++)
+  {
+    values[NIFOVALUES*i]=model->ifo_loglikelihoods[i];
+    values[NIFOVALUES*i+1]=model->ifo_SNRs[i];
+    values[NIFOVALUES*i+2]=model->ifo_fPlus[i];
+    values[NIFOVALUES*i+3]=model->ifo_fCross[i];
+    values[NIFOVALUES*i+4]=model->ifo_timeshifts[i];
+  }
+}
+
+/* Draws a new point for every thread, evaluates their likelihoods
+ concurrently, each thread with its own model as in the nested sampler's
+ replacement loop, and compares them with the likelihoods of the same points
+ evaluated one at a time with the model of thread 0 */
+int compare_threads(LALInferenceRunState *runState, UINT4 Nrounds);
+int compare_threads(LALInferenceRunState *runState, UINT4 Nrounds)
+{
+  static const char *names[NIFOVALUES]={"logL","SNR","fPlus","fCross","timeshift"};
+  UINT4 nthreads=runState->nthreads;
+  UINT4 nifo=0;
+  int result=1;
+
+  for(LALInferenceIFOData *dataPtr=runState->data;dataPtr;dataPtr=dataPtr->next) nifo++;
+
+  REAL8 *logL=XLALCalloc(nthreads,sizeof(REAL8));
+  REAL8 *values=XLALCalloc(nthreads*nifo*NIFOVALUES,sizeof(REAL8));
+  REAL8 *serial=XLALCalloc(nifo*NIFOVALUES,sizeof(REAL8));
+
+  for(UINT4 round=0;round<Nrounds;round++)
+  {
+    LALInferenceDrawThreads(runState);
+
+    #pragma omp parallel for schedule(dynamic,1) num_threads(nthreads)
+    for(UINT4 t=0;t<nthreads;t++)
+    {
+      LALInferenceThreadState *thread=&runState->threads[t];
+      logL[t]=runState->likelihood(thread->currentParams,runState->data,thread->model);
+      record_values(&values[t*nifo*NIFOVALUES],thread->model,nifo);
+    }
+
+    for(UINT4 t=0;t<nthreads;t++)
+    {
+      LALInferenceModel *model=runState->threads[0].model;
+      REAL8 serialLogL=runState->likelihood(runState->threads[t].currentParams,runState->data,model);
+      record_values(serial,model,nifo);
+      result&=compare_value("network logL",t,0,logL[t],serialLogL);
+      for(UINT4 i=0;i<nifo*NIFOVALUES;i++)
+        result&=compare_value(names[i%NIFOVALUES],t,i/NIFOVALUES,values[t*nifo*NIFOVALUES+i],serial[i]);
+    }
+  }
+
+  XLALFree(logL);
+  XLALFree(values);
+  XLALFree(serial);
+
+  fprintf(stdout,"Compared %u likelihoods evaluated in %u threads\n",Nrounds*nthreads,nthreads);
+  fprintf(stdout,"Threads test result: %s\n",result?"passed":"failed");
+  return(result);
+}
+
+/* Evaluates the likelihood of the same point in every thread concurrently,
+ as the chains of lalinference_mcmc may do when they share a position, so
+ that all models generate the same template and use any shared tables at
+ the same time, and compares each with the serial likelihood */
+int compare_same_point(LALInferenceRunState *runState);
+int compare_same_point(LALInferenceRunState *runState)
+{
+  UINT4 nthreads=runState->nthreads;
+  REAL8 *logL=XLALCalloc(nthreads,sizeof(REAL8));
+  int result=1;
+
+  for(UINT4 t=1;t<nthreads;t++)
+    LALInferenceCopyVariables(runState->threads[0].currentParams,runState->threads[t].currentParams);
+
+  #pragma omp parallel for schedule(dynamic,1) num_threads(nthreads)
+  for(UINT4 t=0;t<nthreads;t++)
+  {
+    LALInferenceThreadState *thread=&runState->threads[t];
+    logL[t]=runState->likelihood(thread->currentParams,runState->data,thread->model);
+  }
+
+  REAL8 serialLogL=runState->likelihood(runState->threads[0].currentParams,runState->data,runState->threads[0].model);
+  for(UINT4 t=0;t<nthreads;t++)
+    result&=compare_value("network logL",t,0,logL[t],serialLogL);
+
+  XLALFree(logL);
+
+  fprintf(stdout,"Same point test result: %s\n",result?"passed":"failed");
+  return(result);
+}
+
+int main(int argc, char *argv[]){
+  ProcessParamsTable *procParams = NULL, *ppt = NULL;
+  LALInferenceRunState *runState=NULL;
+  INT4 nthreads=4;
+
+  procParams=LALInferenceParseCommandLine(argc,argv);
+  if(LALInferenceGetProcParamVal(procParams,"--help"))
+  {
+    fprintf(stdout,"%s",HELPSTR);
+    return(EXIT_SUCCESS);
+  }
+
+  runState = LALInferenceInitRunState(procParams);
+  if(!runState)
+  {
+    fprintf(stderr,"Unable to set up the data\n");
+    return(EXIT_FAILURE);
+  }
+
+  LALInferenceInjectInspiralSignal(runState->data,runState->commandLine);
+  LALInferenceApplyCalibrationErrors(runState->data,runState->commandLine);
+  runState->proposalArgs = LALInferenceParseProposalArgs(runState);
+
+  if((ppt=LALInferenceGetProcParamVal(runState->commandLine,"--Nthreads")))
+    nthreads=atoi(ppt->value);
+  if(nthreads<1)
+  {
+    fprintf(stderr,"--Nthreads must be a positive integer\n");
+    return(EXIT_FAILURE);
+  }
+
+  /* Set up the models, prior and likelihood as lalinference_nest does */
+  LALInferenceInitCBCThreads(runState,nthreads);
+  LALInferenceInitCBCPrior(runState);
+  LALInferenceInitLikelihood(runState);
+
+  int result = compare_threads(runState, 4);
+  result = compare_same_point(runState) && result;
+
+  for(INT4 t=0;t<runState->nthreads;t++)
+    LALInferenceClearThreadBuffers(&runState->threads[t]);
+
+  return(result ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,13 @@
+#!/usr/bin/env bash
+
+# Exit with failure as soon as a test fails
+set -e
+
+common="--psdlength 256 --psdstart 1 --seglen 8 --srate 1024 --trigtime 0 --ifo H1 --ifo L1 --H1-channel LALSimAdLIGO --H1-cache LALSimAdLIGO --L1-channel LALSimAdLIGO --L1-cache LALSimAdLIGO --dataseed 1324 --randomseed 1324 --amporder 0 --H1-flow 30 --L1-flow 30 --fast-extrinsic-likelihood"
+
+echo "Testing fast extrinsic likelihood: TaylorF2"
+./LALInferenceFastExtrinsicTest ${common} --approximant TaylorF2
+
+echo "-------------------------------------------"
+echo "Testing fast extrinsic likelihood: IMRPhenomPv2, phase marginalised"
+./LALInferenceFastExtrinsicTest ${common} --approximant IMRPhenomPv2 --margphi
@@ -22,6 +22,7 @@
 #include <complex.h>
 #include <lal/AVFactories.h>
 #include <lal/ComplexFFT.h>
+#include <lal/FFTPlanCache.h>
 #include <lal/XLALError.h>
 #include <lal/FrequencySeries.h>
 #include <lal/LALInspiralSBankOverlap.h>
@@ -44,7 +45,7 @@ void XLALDestroySBankWorkspaceCache(WS *workspace_cache) {
     size_t k = MAX_NUM_WS;
     for (;k--;) {
         if (workspace_cache[k].n) {
-            XLALDestroyCOMPLEX8FFTPlan(workspace_cache[k].plan);
+            XLALReleaseCachedCOMPLEX8FFTPlan(workspace_cache[k].plan);
             XLALDestroyCOMPLEX8Vector(workspace_cache[k].zf);
             XLALDestroyCOMPLEX8Vector(workspace_cache[k].zt);
         }
@@ -75,7 +76,7 @@ static WS *get_workspace(WS *workspace_cache, const size_t n) {
     memset(ptr->zt->data, 0, n * sizeof(COMPLEX8));
 
     ptr->n = n;
-    ptr->plan = XLALCreateReverseCOMPLEX8FFTPlan(n, 1);
+    ptr->plan = XLALGetCachedCOMPLEX8FFTPlan(n, 0, 1);
     CHECK_OOM(ptr->plan, "unable to allocate plan");
 
     return ptr;
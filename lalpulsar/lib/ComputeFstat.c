@@ -24,6 +24,9 @@
 #include <stdio.h>
 #include <math.h>
 #include <gsl/gsl_math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "ComputeFstat_internal.h"
 
@@ -35,6 +38,12 @@
 
 // ---------- Internal struct definitions ---------- //
 
+// Per-thread copy of input data, used by XLALComputeFstatParallel() and XLALComputeFstatBatch()
+typedef struct {
+  FstatCommon common;					// Copy of common input data, with its own workspace
+  void *method_data;					// Copy of method data, sharing the read-only input data of the original
+} FstatThreadCopy;
+
 // Internal definition of input data structure
 struct tagFstatInput {
   REAL8 Tsft;						// Length of input SFTs (for maximum length checking)
@@ -46,11 +55,16 @@ struct tagFstatInput {
   int *workspace_refcount;				// Reference counter for the shared workspace 'common.workspace'
   FstatMethodFuncs method_funcs;			// Function pointers for F-statistic method
   void *method_data;					// F-statistic method data
+  UINT4 numThreadCopies;				// Number of per-thread copies of common and method data
+  FstatThreadCopy *threadCopies;			// Per-thread copies of common and method data, created on demand for threads other than the first
 };
 
 // ---------- Internal prototypes ---------- //
 
 static int XLALSelectBestFstatMethod ( FstatMethodType *method );
+static int XLALPrepareFstatResults ( FstatResults **Fstats, const FstatInput *input, const PulsarDopplerParams *doppler, const UINT4 numFreqBins, const FstatQuantities whatToCompute );
+static int XLALFstatInputThreadCopies ( FstatInput *input, const UINT4 numThreads );
+static void XLALDestroyFstatInputThreadCopies ( FstatInput *input );
 
 int XLALSetupFstatDemod  ( void **method_data, FstatCommon *common, FstatMethodFuncs* funcs, MultiSFTVector *multiSFTs, const FstatOptionalArgs *optArgs );
 int XLALSetupFstatResamp ( void **method_data, FstatCommon *common, FstatMethodFuncs* funcs, MultiSFTVector *multiSFTs, const FstatOptionalArgs *optArgs );
@@ -62,6 +76,8 @@ static const char *const FstatMethodNames[FMETHOD_END] = {
   [FMETHOD_DEMOD_OPTC]		= "DemodOptC",
   [FMETHOD_DEMOD_ALTIVEC]	= "DemodAltivec",
   [FMETHOD_DEMOD_SSE]		= "DemodSSE",
+  [FMETHOD_DEMOD_AVX2]		= "DemodAVX2",
+  [FMETHOD_DEMOD_AVX512]	= "DemodAVX512",
   [FMETHOD_DEMOD_BEST]		= "DemodBest",
 
   [FMETHOD_RESAMP_GENERIC]	= "ResampGeneric",
@@ -411,6 +427,13 @@ XLALCreateFstatInput ( const SFTCatalog *SFTcatalog,              ///< [in] Cata
     setupFuncMethod = XLALSetupFstatDemod;
     break;
 
+  case FMETHOD_DEMOD_AVX2:		// Demod: AVX2 hotloop
+  case FMETHOD_DEMOD_AVX512:		// Demod: AVX-512 hotloop
+    XLAL_CHECK_NULL ( optArgs.Dterms > 0, XLAL_EINVAL );
+    extraBinsMethod = optArgs.Dterms;
+    setupFuncMethod = XLALSetupFstatDemod;
+    break;
+
   case FMETHOD_RESAMP_GENERIC:		// Resamp: generic implementation
     extraBinsMethod = 8;   // use 8 extra bins to give better agreement with Demod(w Dterms=8) near the boundaries
     setupFuncMethod = XLALSetupFstatResamp;
@@ -502,9 +525,21 @@ XLALCreateFstatInput ( const SFTCatalog *SFTcatalog,              ///< [in] Cata
 
   // Load SFTs, if required, and extract detectors and timestamps
   MultiSFTVector *multiSFTs = NULL;
-  if (loadSFTs)
+  MultiPSDVector *runningMedian = NULL;
+  if (loadSFTs && !generateSFTs)
     {
-      // Load all SFTs at once
+      // Load all SFTs at once, normalising each SFT as soon as it is loaded, using either running median or assumed PSDs
+      XLAL_CHECK_NULL ( XLALLoadNormalizedMultiSFTs ( &multiSFTs, &runningMedian, SFTcatalog, input->minFreqFull, input->maxFreqFull,
+                                                      optArgs.runningMedianWindow, optArgs.assumeSqrtSX, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Extract detectors and timestamps from SFTs
+      XLAL_CHECK_NULL ( XLALMultiLALDetectorFromMultiSFTs ( &common->detectors, multiSFTs ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_NULL ( ( common->multiTimestamps = XLALExtractMultiTimestampsFromSFTs ( multiSFTs ) ) != NULL,  XLAL_EFUNC );
+
+    }
+  else if (loadSFTs)
+    {
+      // Load all SFTs at once; these are normalised below, after generated SFTs have been added to them
       XLAL_CHECK_NULL ( ( multiSFTs = XLALLoadMultiSFTs(SFTcatalog, input->minFreqFull, input->maxFreqFull) ) != NULL, XLAL_EFUNC );
 
       // Extract detectors and timestamps from SFTs
@@ -567,9 +602,10 @@ XLALCreateFstatInput ( const SFTCatalog *SFTcatalog,              ///< [in] Cata
     XLAL_CHECK_NULL ( multiSFTs->data[X]->length > 1, XLAL_EINVAL, "Need more than 1 SFTs per Detector!\n" );
   }
 
-  // Normalise SFTs using either running median or assumed PSDs
-  MultiPSDVector *runningMedian;
-  XLAL_CHECK_NULL ( (runningMedian = XLALNormalizeMultiSFTVect ( multiSFTs, optArgs.runningMedianWindow, optArgs.assumeSqrtSX )) != NULL, XLAL_EFUNC );
+  // Normalise SFTs using either running median or assumed PSDs, unless already done while loading them
+  if ( runningMedian == NULL ) {
+    XLAL_CHECK_NULL ( (runningMedian = XLALNormalizeMultiSFTVect ( multiSFTs, optArgs.runningMedianWindow, optArgs.assumeSqrtSX )) != NULL, XLAL_EFUNC );
+  }
 
   // Calculate SFT noise weights from PSD
   XLAL_CHECK_NULL ( (common->multiNoiseWeights = XLALComputeMultiNoiseWeights ( runningMedian, optArgs.runningMedianWindow, 0 )) != NULL, XLAL_EFUNC );
@@ -733,124 +769,189 @@ XLALComputeFstat ( FstatResults **Fstats,               ///< [in/out] Address of
                    const FstatQuantities whatToCompute  ///< [in] Bit-field of which \f$\mathcal{F}\f$-statistic quantities to compute.
                    )
 {
-  // Check input
-  XLAL_CHECK ( Fstats != NULL, XLAL_EINVAL);
-  XLAL_CHECK ( input != NULL, XLAL_EINVAL);
-  XLAL_CHECK ( doppler != NULL, XLAL_EINVAL);
-  XLAL_CHECK ( doppler->asini >= 0, XLAL_EINVAL);
-  XLAL_CHECK ( numFreqBins > 0, XLAL_EINVAL);
-  XLAL_CHECK ( !input->singleFreqBin || numFreqBins == 1, XLAL_EINVAL, "numFreqBins must be 1 if XLALCreateFstatInput() was passed zero dFreq" );
-  XLAL_CHECK ( whatToCompute < FSTATQ_LAST, XLAL_EINVAL);
+  // Check input and prepare results struct
+  XLAL_CHECK ( XLALPrepareFstatResults ( Fstats, input, doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-  // Check that SFT length is within allowed maximum
-  {
-    const REAL8 maxFreq = doppler->fkdot[0] + input->common.dFreq * numFreqBins;
-    XLAL_CHECK ( XLALFstatCheckSFTLengthMismatch ( input->Tsft, maxFreq, doppler->asini, doppler->period, input->common.allowedMismatchFromSFTLength ) == XLAL_SUCCESS, XLAL_EFUNC );
-  }
+  // Call the appropriate method function to compute the F-statistic
+  XLAL_CHECK ( (input->method_funcs.compute_func) ( *Fstats, &input->common, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-  // Allocate results struct, if needed
-  if ( (*Fstats) == NULL ) {
-    XLAL_CHECK ( ((*Fstats) = XLALCalloc ( 1, sizeof(**Fstats) )) != NULL, XLAL_ENOMEM );
-  }
+  // Record the internal reference time used, which is required to compute a correct global signal phase
+  (*Fstats)->refTimePhase = (*Fstats)->doppler.refTime;
+  (*Fstats)->doppler = (*doppler);
 
-  // Get constant pointer to common input data
-  const FstatCommon *common = &input->common;
-  const UINT4 numDetectors = common->detectors.length;
+  return XLAL_SUCCESS;
 
-  // Enlarge result arrays if they are too small
-  const BOOLEAN moreFreqBins = (numFreqBins > (*Fstats)->internalalloclen);
-  const BOOLEAN moreDetectors = (numDetectors > (*Fstats)->numDetectors);
-  if (moreFreqBins || moreDetectors)
-    {
-      // Enlarge multi-detector 2F array
-      if ( (whatToCompute & FSTATQ_2F) && moreFreqBins )
-        {
-          (*Fstats)->twoF = XLALRealloc ( (*Fstats)->twoF, numFreqBins*sizeof((*Fstats)->twoF[0]) );
-          XLAL_CHECK ( (*Fstats)->twoF != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->twoF to length %u", numFreqBins );
-        }
+} // XLALComputeFstat()
 
-      // Enlarge multi-detector Fa & Fb array
-      if ( (whatToCompute & FSTATQ_FAFB) && moreFreqBins )
-        {
-          (*Fstats)->Fa = XLALRealloc( (*Fstats)->Fa, numFreqBins * sizeof((*Fstats)->Fa[0]) );
-          XLAL_CHECK ( (*Fstats)->Fa != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->Fa to length %u", numFreqBins );
-          (*Fstats)->Fb = XLALRealloc( (*Fstats)->Fb, numFreqBins * sizeof((*Fstats)->Fb[0]) );
-          XLAL_CHECK ( (*Fstats)->Fb != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->Fb to length %u", numFreqBins );
-        }
+///
+/// Compute the \f$\mathcal{F}\f$-statistic over a band of frequencies, sharing the frequency
+/// bins between the threads of an OpenMP thread pool.  The arguments and results are as for
+/// XLALComputeFstat(), up to floating-point rounding of the frequencies of each bin.
+///
+/// All threads share the SFTs, detector states and noise weights held by \p input, so that one
+/// process can use all the cores of a node without duplicating the SFTs in memory.  Each thread
+/// other than the first works on its own copy of the method's buffers and workspace; these copies
+/// are created the first time they are needed, and are kept in \p input for re-use by subsequent
+/// calls.  The same \p input must not be passed to two calls running concurrently.
+///
+/// The \a Resamp methods compute all frequency bins with a single FFT, and so are not split between
+/// threads by this function; use XLALComputeFstatBatch() to share Doppler points between threads
+/// instead.  If LAL was compiled without OpenMP support, this function is equivalent to
+/// XLALComputeFstat().
+///
+int
+XLALComputeFstatParallel ( FstatResults **Fstats,               ///< [in/out] Address of a pointer to a #FstatResults results structure; if \c NULL, allocate here.
+                           FstatInput *input,                   ///< [in] Input data structure created by one of the setup functions.
+                           const PulsarDopplerParams *doppler,  ///< [in] Doppler parameters, including starting frequency, at which to compute \f$2\mathcal{F}\f$
+                           const UINT4 numFreqBins,             ///< [in] Number of frequencies at which the \f$2\mathcal{F}\f$ are to be computed. Must be 1 if XLALCreateFstatInput() was passed zero \c dFreq.
+                           const FstatQuantities whatToCompute  ///< [in] Bit-field of which \f$\mathcal{F}\f$-statistic quantities to compute.
+                           )
+{
+  XLAL_CHECK ( input != NULL, XLAL_EINVAL );
 
-      // Enlarge 2F per detector arrays
-      if ( (whatToCompute & FSTATQ_2F_PER_DET) && (moreFreqBins || moreDetectors) )
-        {
-          for ( UINT4 X = 0; X < numDetectors; ++X )
-            {
-              (*Fstats)->twoFPerDet[X] = XLALRealloc ( (*Fstats)->twoFPerDet[X], numFreqBins * sizeof((*Fstats)->twoFPerDet[X][0]) );
-              XLAL_CHECK ( (*Fstats)->twoFPerDet[X] != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->twoFPerDet[%u] to length %u", X, numFreqBins );
-            }
-        }
+  // Determine number of chunks of frequency bins to share between threads
+  UINT4 numChunks = 1;
+#ifdef _OPENMP
+  numChunks = omp_get_max_threads();
+#endif
+  if ( numChunks > numFreqBins ) {
+    numChunks = numFreqBins;
+  }
+  if ( numChunks <= 1 || input->method >= FMETHOD_RESAMP_GENERIC ) {
+    XLAL_CHECK ( XLALComputeFstat ( Fstats, input, doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+    return XLAL_SUCCESS;
+  }
 
-      // Enlarge Fa & Fb per detector arrays
-      if ( ( whatToCompute & FSTATQ_FAFB_PER_DET) && (moreFreqBins || moreDetectors) )
-        {
-          for ( UINT4 X = 0; X < numDetectors; ++X )
-            {
-              (*Fstats)->FaPerDet[X] = XLALRealloc ( (*Fstats)->FaPerDet[X], numFreqBins*sizeof((*Fstats)->FaPerDet[X][0]) );
-              XLAL_CHECK( (*Fstats)->FaPerDet[X] != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->FaPerDet[%u] to length %u", X, numFreqBins );
-              (*Fstats)->FbPerDet[X] = XLALRealloc ( (*Fstats)->FbPerDet[X], numFreqBins*sizeof((*Fstats)->FbPerDet[X][0]) );
-              XLAL_CHECK( (*Fstats)->FbPerDet[X] != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->FbPerDet[%u] to length %u", X, numFreqBins );
-            }
+  // Check input and prepare results struct
+  XLAL_CHECK ( XLALPrepareFstatResults ( Fstats, input, doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Create per-thread copies of input data, if needed
+  XLAL_CHECK ( XLALFstatInputThreadCopies ( input, numChunks ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Each chunk computes a contiguous range of frequency bins, writing its results through a
+  // results struct which points into the arrays of the full results struct
+  FstatResults *chunks;
+  XLAL_CHECK ( ( chunks = XLALCalloc ( numChunks, sizeof(*chunks) ) ) != NULL, XLAL_ENOMEM );
+  int errors = 0;
+#pragma omp parallel for schedule(static,1) num_threads(numChunks) reduction(+:errors)
+  for ( INT4 c = 0; c < (INT4) numChunks; ++c )
+    {
+      const UINT4 kStart = ( ( (UINT8) c ) * numFreqBins ) / numChunks;
+      const UINT4 kEnd = ( ( (UINT8) c + 1 ) * numFreqBins ) / numChunks;
+      FstatResults *chunk = &chunks[c];
+      (*chunk) = (**Fstats);
+      chunk->doppler.fkdot[0] += kStart * (*Fstats)->dFreq;
+      chunk->numFreqBins = chunk->internalalloclen = kEnd - kStart;
+      if ( whatToCompute & FSTATQ_2F ) {
+        chunk->twoF = (*Fstats)->twoF + kStart;
+      }
+      if ( whatToCompute & FSTATQ_FAFB ) {
+        chunk->Fa = (*Fstats)->Fa + kStart;
+        chunk->Fb = (*Fstats)->Fb + kStart;
+      }
+      for ( UINT4 X = 0; X < (*Fstats)->numDetectors; ++X ) {
+        if ( whatToCompute & FSTATQ_2F_PER_DET ) {
+          chunk->twoFPerDet[X] = (*Fstats)->twoFPerDet[X] + kStart;
+        }
+        if ( whatToCompute & FSTATQ_FAFB_PER_DET ) {
+          chunk->FaPerDet[X] = (*Fstats)->FaPerDet[X] + kStart;
+          chunk->FbPerDet[X] = (*Fstats)->FbPerDet[X] + kStart;
         }
+      }
+      if ( whatToCompute & FSTATQ_ATOMS_PER_DET ) {
+        chunk->multiFatoms = (*Fstats)->multiFatoms + kStart;
+      }
 
-      // Enlarge F-atoms per detector arrays, and initialise to NULL
-      if ( (whatToCompute & FSTATQ_ATOMS_PER_DET) && moreFreqBins )
-        {
-          UINT4 kPrev = 0;
-          if ( (*Fstats)->multiFatoms != NULL ) {
-            kPrev = (*Fstats)->internalalloclen; // leave previously-used frequency-bins untouched
-          }
+      // The first chunk uses the original input data, the others use per-thread copies
+      const FstatCommon *common = ( c == 0 ) ? &input->common : &input->threadCopies[c - 1].common;
+      void *method_data = ( c == 0 ) ? input->method_data : input->threadCopies[c - 1].method_data;
+      if ( (input->method_funcs.compute_func) ( chunk, common, method_data ) != XLAL_SUCCESS ) {
+        ++errors;
+      }
+    }
 
-          (*Fstats)->multiFatoms = XLALRealloc ( (*Fstats)->multiFatoms, numFreqBins*sizeof((*Fstats)->multiFatoms[0]) );
-          XLAL_CHECK ( (*Fstats)->multiFatoms != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->multiFatoms to length %u", numFreqBins );
+  // Return antenna-pattern matrices, which are the same for all chunks
+  if ( errors == 0 ) {
+    (*Fstats)->Mmunu = chunks[0].Mmunu;
+    memcpy ( (*Fstats)->MmunuX, chunks[0].MmunuX, sizeof((*Fstats)->MmunuX) );
+  }
+  XLALFree ( chunks );
+  XLAL_CHECK ( errors == 0, XLAL_EFUNC, "F-statistic computation failed in %i threads", errors );
 
-          for ( UINT4 k = kPrev; k < numFreqBins; ++k ) {
-            (*Fstats)->multiFatoms[k] = NULL;
-          }
+  // Record the internal reference time used, which is required to compute a correct global signal phase
+  (*Fstats)->refTimePhase = (*Fstats)->doppler.refTime;
+  (*Fstats)->doppler = (*doppler);
 
-        } // if Atoms_per_det to enlarge
+  return XLAL_SUCCESS;
 
-      // Update allocated length of arrays
-      (*Fstats)->internalalloclen = numFreqBins;
+} // XLALComputeFstatParallel()
 
-    } // if (moreFreqBins || moreDetectors)
+///
+/// Compute the \f$\mathcal{F}\f$-statistic over a band of frequencies for each of a batch of
+/// Doppler points, sharing the Doppler points between the threads of an OpenMP thread pool.
+/// For each Doppler point the arguments and results are as for XLALComputeFstat().
+///
+/// As for XLALComputeFstatParallel(), all threads share the SFTs, detector states and noise weights
+/// held by \p input, while each thread other than the first works on its own copy of the method's
+/// buffers and workspace.  Each thread is given a contiguous range of Doppler points, so batches
+/// ordered by sky position make the best use of the buffered sky-position-dependent quantities.
+///
+int
+XLALComputeFstatBatch ( FstatResults **Fstats,                  ///< [in/out] Array of \p numDopplers pointers to #FstatResults results structures; any which are \c NULL are allocated here.
+                        FstatInput *input,                      ///< [in] Input data structure created by one of the setup functions.
+                        const PulsarDopplerParams *dopplers,    ///< [in] Array of \p numDopplers Doppler parameters, including starting frequencies, at which to compute \f$2\mathcal{F}\f$
+                        const UINT4 numDopplers,                ///< [in] Number of Doppler points in the batch.
+                        const UINT4 numFreqBins,                ///< [in] Number of frequencies at which the \f$2\mathcal{F}\f$ are to be computed. Must be 1 if XLALCreateFstatInput() was passed zero \c dFreq.
+                        const FstatQuantities whatToCompute     ///< [in] Bit-field of which \f$\mathcal{F}\f$-statistic quantities to compute.
+                        )
+{
+  XLAL_CHECK ( Fstats != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( input != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( dopplers != NULL, XLAL_EINVAL );
 
-  // Extrapolate parameters in 'doppler' to SFT mid-time
-  PulsarDopplerParams midDoppler = (*doppler);
-  {
-    const REAL8 dtau = XLALGPSDiff ( &common->midTime, &doppler->refTime );
-    XLAL_CHECK ( XLALExtrapolatePulsarSpins ( midDoppler.fkdot, midDoppler.fkdot, dtau ) == XLAL_SUCCESS, XLAL_EFUNC );
+  // Determine number of threads to share Doppler points between
+  UINT4 numThreads = 1;
+#ifdef _OPENMP
+  numThreads = omp_get_max_threads();
+#endif
+  if ( numThreads > numDopplers ) {
+    numThreads = numDopplers;
   }
-  midDoppler.refTime = common->midTime;
 
-  // Initialise result struct parameters
-  (*Fstats)->doppler      = midDoppler;
-  (*Fstats)->dFreq        = input->singleFreqBin ? 0 : common->dFreq;
-  (*Fstats)->numFreqBins  = numFreqBins;
-  (*Fstats)->numDetectors = numDetectors;
-  XLAL_INIT_MEM ( (*Fstats)->detectorNames);
-  for (UINT4 X = 0; X < numDetectors; ++X) {
-    strncpy ( (*Fstats)->detectorNames[X], common->detectors.sites[X].frDetector.prefix, 2 );
+  // Check input and prepare results structs
+  for ( UINT4 i = 0; i < numDopplers; ++i ) {
+    XLAL_CHECK ( XLALPrepareFstatResults ( &Fstats[i], input, &dopplers[i], numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
   }
-  (*Fstats)->whatWasComputed = whatToCompute;
 
-  // Call the appropriate method function to compute the F-statistic
-  XLAL_CHECK ( (input->method_funcs.compute_func) ( *Fstats, common, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
+  // Create per-thread copies of input data, if needed
+  XLAL_CHECK ( XLALFstatInputThreadCopies ( input, numThreads ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  int errors = 0;
+#pragma omp parallel for schedule(static) num_threads(numThreads) reduction(+:errors)
+  for ( INT4 i = 0; i < (INT4) numDopplers; ++i )
+    {
+      // The first thread uses the original input data, the others use per-thread copies
+      UINT4 t = 0;
+#ifdef _OPENMP
+      t = omp_get_thread_num();
+#endif
+      const FstatCommon *common = ( t == 0 ) ? &input->common : &input->threadCopies[t - 1].common;
+      void *method_data = ( t == 0 ) ? input->method_data : input->threadCopies[t - 1].method_data;
+      if ( (input->method_funcs.compute_func) ( Fstats[i], common, method_data ) != XLAL_SUCCESS ) {
+        ++errors;
+      }
+    }
+  XLAL_CHECK ( errors == 0, XLAL_EFUNC, "F-statistic computation failed for %i Doppler points", errors );
 
-  (*Fstats)->doppler = (*doppler);
   // Record the internal reference time used, which is required to compute a correct global signal phase
-  (*Fstats)->refTimePhase = midDoppler.refTime;
+  for ( UINT4 i = 0; i < numDopplers; ++i ) {
+    Fstats[i]->refTimePhase = Fstats[i]->doppler.refTime;
+    Fstats[i]->doppler = dopplers[i];
+  }
 
   return XLAL_SUCCESS;
 
-} // XLALComputeFstat()
+} // XLALComputeFstatBatch()
 
 ///
 /// Free all memory associated with a \c FstatInput structure.
@@ -866,12 +967,15 @@ XLALDestroyFstatInput ( FstatInput* input       ///< [in] \c FstatInput structur
     {
       XLAL_CHECK_VOID ( input->method < FMETHOD_RESAMP_GENERIC, XLAL_EINVAL,
                         "Something is wrong: 'isTimeslice==TRUE' for non-LALDemod F-stat method '%s' is not supported!\n", XLALGetFstatInputMethodName(input));
+      XLALDestroyFstatInputThreadCopies ( input );
       XLALDestroyFstatInputTimeslice_common ( &input->common );
       XLALDestroyFstatInputTimeslice_Demod ( input->method_data);
       XLALFree ( input );
       return;
     }
 
+  XLALDestroyFstatInputThreadCopies ( input );
+
   XLALDestroyMultiTimestamps ( input->common.multiTimestamps );
   XLALDestroyMultiNoiseWeights ( input->common.multiNoiseWeights );
   XLALDestroyMultiDetectorStateSeries ( input->common.multiDetectorStates );
@@ -1055,6 +1159,183 @@ XLALComputeFstatFromAtoms ( const MultiFstatAtomVector *multiFstatAtoms,   ///<
 
 } // XLALComputeFstatFromAtoms()
 
+///
+/// Check the arguments to XLALComputeFstat() and prepare the results structure, extrapolating
+/// the Doppler parameters stored in it to the SFT mid-time.
+///
+static int
+XLALPrepareFstatResults ( FstatResults **Fstats,
+                          const FstatInput *input,
+                          const PulsarDopplerParams *doppler,
+                          const UINT4 numFreqBins,
+                          const FstatQuantities whatToCompute
+                          )
+{
+  // Check input
+  XLAL_CHECK ( Fstats != NULL, XLAL_EINVAL);
+  XLAL_CHECK ( input != NULL, XLAL_EINVAL);
+  XLAL_CHECK ( doppler != NULL, XLAL_EINVAL);
+  XLAL_CHECK ( doppler->asini >= 0, XLAL_EINVAL);
+  XLAL_CHECK ( numFreqBins > 0, XLAL_EINVAL);
+  XLAL_CHECK ( !input->singleFreqBin || numFreqBins == 1, XLAL_EINVAL, "numFreqBins must be 1 if XLALCreateFstatInput() was passed zero dFreq" );
+  XLAL_CHECK ( whatToCompute < FSTATQ_LAST, XLAL_EINVAL);
+
+  // Check that SFT length is within allowed maximum
+  {
+    const REAL8 maxFreq = doppler->fkdot[0] + input->common.dFreq * numFreqBins;
+    XLAL_CHECK ( XLALFstatCheckSFTLengthMismatch ( input->Tsft, maxFreq, doppler->asini, doppler->period, input->common.allowedMismatchFromSFTLength ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Allocate results struct, if needed
+  if ( (*Fstats) == NULL ) {
+    XLAL_CHECK ( ((*Fstats) = XLALCalloc ( 1, sizeof(**Fstats) )) != NULL, XLAL_ENOMEM );
+  }
+
+  // Get constant pointer to common input data
+  const FstatCommon *common = &input->common;
+  const UINT4 numDetectors = common->detectors.length;
+
+  // Enlarge result arrays if they are too small
+  const BOOLEAN moreFreqBins = (numFreqBins > (*Fstats)->internalalloclen);
+  const BOOLEAN moreDetectors = (numDetectors > (*Fstats)->numDetectors);
+  if (moreFreqBins || moreDetectors)
+    {
+      // Enlarge multi-detector 2F array
+      if ( (whatToCompute & FSTATQ_2F) && moreFreqBins )
+        {
+          (*Fstats)->twoF = XLALRealloc ( (*Fstats)->twoF, numFreqBins*sizeof((*Fstats)->twoF[0]) );
+          XLAL_CHECK ( (*Fstats)->twoF != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->twoF to length %u", numFreqBins );
+        }
+
+      // Enlarge multi-detector Fa & Fb array
+      if ( (whatToCompute & FSTATQ_FAFB) && moreFreqBins )
+        {
+          (*Fstats)->Fa = XLALRealloc( (*Fstats)->Fa, numFreqBins * sizeof((*Fstats)->Fa[0]) );
+          XLAL_CHECK ( (*Fstats)->Fa != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->Fa to length %u", numFreqBins );
+          (*Fstats)->Fb = XLALRealloc( (*Fstats)->Fb, numFreqBins * sizeof((*Fstats)->Fb[0]) );
+          XLAL_CHECK ( (*Fstats)->Fb != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->Fb to length %u", numFreqBins );
+        }
+
+      // Enlarge 2F per detector arrays
+      if ( (whatToCompute & FSTATQ_2F_PER_DET) && (moreFreqBins || moreDetectors) )
+        {
+          for ( UINT4 X = 0; X < numDetectors; ++X )
+            {
+              (*Fstats)->twoFPerDet[X] = XLALRealloc ( (*Fstats)->twoFPerDet[X], numFreqBins * sizeof((*Fstats)->twoFPerDet[X][0]) );
+              XLAL_CHECK ( (*Fstats)->twoFPerDet[X] != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->twoFPerDet[%u] to length %u", X, numFreqBins );
+            }
+        }
+
+      // Enlarge Fa & Fb per detector arrays
+      if ( ( whatToCompute & FSTATQ_FAFB_PER_DET) && (moreFreqBins || moreDetectors) )
+        {
+          for ( UINT4 X = 0; X < numDetectors; ++X )
+            {
+              (*Fstats)->FaPerDet[X] = XLALRealloc ( (*Fstats)->FaPerDet[X], numFreqBins*sizeof((*Fstats)->FaPerDet[X][0]) );
+              XLAL_CHECK( (*Fstats)->FaPerDet[X] != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->FaPerDet[%u] to length %u", X, numFreqBins );
+              (*Fstats)->FbPerDet[X] = XLALRealloc ( (*Fstats)->FbPerDet[X], numFreqBins*sizeof((*Fstats)->FbPerDet[X][0]) );
+              XLAL_CHECK( (*Fstats)->FbPerDet[X] != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->FbPerDet[%u] to length %u", X, numFreqBins );
+            }
+        }
+
+      // Enlarge F-atoms per detector arrays, and initialise to NULL
+      if ( (whatToCompute & FSTATQ_ATOMS_PER_DET) && moreFreqBins )
+        {
+          UINT4 kPrev = 0;
+          if ( (*Fstats)->multiFatoms != NULL ) {
+            kPrev = (*Fstats)->internalalloclen; // leave previously-used frequency-bins untouched
+          }
+
+          (*Fstats)->multiFatoms = XLALRealloc ( (*Fstats)->multiFatoms, numFreqBins*sizeof((*Fstats)->multiFatoms[0]) );
+          XLAL_CHECK ( (*Fstats)->multiFatoms != NULL, XLAL_EINVAL, "Failed to (re)allocate (*Fstats)->multiFatoms to length %u", numFreqBins );
+
+          for ( UINT4 k = kPrev; k < numFreqBins; ++k ) {
+            (*Fstats)->multiFatoms[k] = NULL;
+          }
+
+        } // if Atoms_per_det to enlarge
+
+      // Update allocated length of arrays
+      (*Fstats)->internalalloclen = numFreqBins;
+
+    } // if (moreFreqBins || moreDetectors)
+
+  // Extrapolate parameters in 'doppler' to SFT mid-time
+  PulsarDopplerParams midDoppler = (*doppler);
+  {
+    const REAL8 dtau = XLALGPSDiff ( &common->midTime, &doppler->refTime );
+    XLAL_CHECK ( XLALExtrapolatePulsarSpins ( midDoppler.fkdot, midDoppler.fkdot, dtau ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  midDoppler.refTime = common->midTime;
+
+  // Initialise result struct parameters
+  (*Fstats)->doppler      = midDoppler;
+  (*Fstats)->dFreq        = input->singleFreqBin ? 0 : common->dFreq;
+  (*Fstats)->numFreqBins  = numFreqBins;
+  (*Fstats)->numDetectors = numDetectors;
+  XLAL_INIT_MEM ( (*Fstats)->detectorNames);
+  for (UINT4 X = 0; X < numDetectors; ++X) {
+    strncpy ( (*Fstats)->detectorNames[X], common->detectors.sites[X].frDetector.prefix, 2 );
+  }
+  (*Fstats)->whatWasComputed = whatToCompute;
+
+  return XLAL_SUCCESS;
+
+} // XLALPrepareFstatResults()
+
+///
+/// Ensure that \p input holds per-thread copies of its common and method data for \p numThreads
+/// threads.  The first thread always uses the original data.
+///
+static int
+XLALFstatInputThreadCopies ( FstatInput *input,
+                             const UINT4 numThreads
+                             )
+{
+  if ( numThreads <= input->numThreadCopies + 1 ) {
+    return XLAL_SUCCESS;
+  }
+  XLAL_CHECK ( input->method_funcs.thread_copy_func != NULL, XLAL_EFAILED, "F-statistic method '%s' does not support multiple threads", XLALGetFstatInputMethodName ( input ) );
+
+  XLAL_CHECK ( ( input->threadCopies = XLALRealloc ( input->threadCopies, ( numThreads - 1 ) * sizeof(input->threadCopies[0]) ) ) != NULL, XLAL_ENOMEM );
+  while ( input->numThreadCopies + 1 < numThreads )
+    {
+      FstatThreadCopy *copy = &input->threadCopies[input->numThreadCopies];
+      copy->common = input->common;
+      copy->common.workspace = NULL;
+      copy->method_data = (input->method_funcs.thread_copy_func) ( input->method_data, &input->common, &copy->common );
+      if ( copy->method_data == NULL ) {
+        if ( copy->common.workspace != NULL ) {
+          (input->method_funcs.workspace_destroy_func) ( copy->common.workspace );
+        }
+        XLAL_ERROR ( XLAL_EFUNC );
+      }
+      ++input->numThreadCopies;
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALFstatInputThreadCopies()
+
+///
+/// Free the per-thread copies of common and method data held by \p input.
+///
+static void
+XLALDestroyFstatInputThreadCopies ( FstatInput *input )
+{
+  for ( UINT4 t = 0; t < input->numThreadCopies; ++t )
+    {
+      (input->method_funcs.thread_copy_destroy_func) ( input->threadCopies[t].method_data );
+      if ( input->threadCopies[t].common.workspace != NULL ) {
+        (input->method_funcs.workspace_destroy_func) ( input->threadCopies[t].common.workspace );
+      }
+    }
+  XLALFree ( input->threadCopies );
+  input->threadCopies = NULL;
+  input->numThreadCopies = 0;
+
+} // XLALDestroyFstatInputThreadCopies()
+
 ///
 /// If user asks for a 'best' #FstatMethodType, find and select it
 ///
@@ -1124,6 +1405,24 @@ XLALFstatMethodIsAvailable ( FstatMethodType method )
     return 0;
 #endif
 
+  case FMETHOD_DEMOD_AVX2:
+    // This method is available only if compiled with AVX2 support,
+    // and AVX2 is available on the current execution machine
+#ifdef HAVE_AVX2_COMPILER
+    return LAL_HAVE_AVX2_RUNTIME();
+#else
+    return 0;
+#endif
+
+  case FMETHOD_DEMOD_AVX512:
+    // This method is available only if compiled with AVX-512 support,
+    // and AVX-512 is available on the current execution machine
+#ifdef HAVE_AVX512F_COMPILER
+    return LAL_HAVE_AVX512F_RUNTIME();
+#else
+    return 0;
+#endif
+
   default:
     return 0;
 
@@ -1408,6 +1707,8 @@ XLALFstatInputTimeslice ( FstatInput ** slice,                ///< [out] Address
   memcpy ( (*slice), input, sizeof ( *input ) );
 
   (*slice)->common.isTimeslice         = (1==1); // This is a timeslice
+  (*slice)->numThreadCopies            = 0;       // Per-thread copies are not shared with 'input'
+  (*slice)->threadCopies               = NULL;
   (*slice)->common.midTime             = midTimeSlice;
   (*slice)->common.multiTimestamps     = multiTimestamps;
   (*slice)->common.multiDetectorStates = multiDetectorStates;
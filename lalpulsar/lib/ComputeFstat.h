@@ -49,6 +49,11 @@ extern "C" {
 /// XLALComputeFstat(), which computes the \f$\mathcal{F}\f$-statistic using the chosen method, and
 /// fills a \c FstatResults structure with the results.
 ///
+/// A single \c FstatInput structure may be shared by all cores of a node: XLALComputeFstatParallel()
+/// shares the frequency bins of one call, and XLALComputeFstatBatch() the Doppler points of a batch of
+/// calls, between the threads of an OpenMP thread pool.  The SFTs and other input data are shared
+/// read-only between threads; each thread works with its own buffers, which are created on demand.
+///
 /// \note The \f$\mathcal{F}\f$-statistic method codes are partly descended from earlier
 /// implementations found in:
 /// - <tt>LALDemod.[ch]</tt> by Jolien Creighton, Maria Alessandra Papa, Reinhard Prix, Steve
@@ -116,6 +121,8 @@ typedef enum tagFstatMethodType {
   FMETHOD_DEMOD_OPTC,		///< \a Demod: gptimized C hotloop using Akos' algorithm, only works for \f$\text{Dterms} \lesssim 20\f$
   FMETHOD_DEMOD_ALTIVEC,	///< \a Demod: Altivec hotloop variant, uses fixed \f$\text{Dterms} = 8\f$
   FMETHOD_DEMOD_SSE,		///< \a Demod: SSE hotloop with precalc divisors, uses fixed \f$\text{Dterms} = 8\f$
+  FMETHOD_DEMOD_AVX2,		///< \a Demod: AVX2 hotloop, works for any number of Dirichlet kernel terms \f$\text{Dterms}\f$
+  FMETHOD_DEMOD_AVX512,		///< \a Demod: AVX-512 hotloop, works for any number of Dirichlet kernel terms \f$\text{Dterms}\f$
   FMETHOD_DEMOD_BEST,		///< \a Demod: best guess of the fastest available hotloop
 
   FMETHOD_RESAMP_GENERIC,	///< \a Resamp: generic implementation
@@ -358,6 +365,13 @@ SWIGLAL(INOUT_STRUCTS(FstatResults**, Fstats));
 #endif
 int XLALComputeFstat ( FstatResults **Fstats, FstatInput *input, const PulsarDopplerParams *doppler,
                        const UINT4 numFreqBins, const FstatQuantities whatToCompute );
+int XLALComputeFstatParallel ( FstatResults **Fstats, FstatInput *input, const PulsarDopplerParams *doppler,
+                               const UINT4 numFreqBins, const FstatQuantities whatToCompute );
+
+#ifndef SWIG // exclude from SWIG interface
+int XLALComputeFstatBatch ( FstatResults **Fstats, FstatInput *input, const PulsarDopplerParams *dopplers, const UINT4 numDopplers,
+                            const UINT4 numFreqBins, const FstatQuantities whatToCompute );
+#endif // SWIG
 
 void XLALDestroyFstatInput ( FstatInput* input );
 void XLALDestroyFstatResults ( FstatResults* Fstats );
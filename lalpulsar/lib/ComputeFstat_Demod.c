@@ -75,6 +75,7 @@ typedef struct {
   REAL8 prevAlpha, prevDelta;			// buffering: previous skyposition computed
   LIGOTimeGPS prevRefTime;			// buffering: keep track of previous refTime for SSBtimes buffering
   MultiSSBtimes *prevMultiSSBtimes;		// buffering: previous multiSSB times, unique to skypos + SFTs
+  MultiSSBskyCoeffs *multiSSBskyCoeffs;		// buffering: sky-independent part of SSB timing, unique to SFTs
   MultiAMCoeffs *prevMultiAMcoef;		// buffering: previous AM-coeffs, unique to skypos + SFTs
 
   // ----- timing -----
@@ -104,6 +105,16 @@ int XLALComputeFaFb_SSE     ( COMPLEX8 *Fa, COMPLEX8 *Fb, FstatAtomVector **Fsta
                               const PulsarSpins fkdot, const SSBtimes *tSSB, const AMCoeffs *amcoe, const UINT4 Dterms );
 #endif
 
+#ifdef HAVE_AVX2_COMPILER
+int XLALComputeFaFb_AVX2    ( COMPLEX8 *Fa, COMPLEX8 *Fb, FstatAtomVector **FstatAtoms, const SFTVector *sfts,
+                              const PulsarSpins fkdot, const SSBtimes *tSSB, const AMCoeffs *amcoe, const UINT4 Dterms );
+#endif
+
+#ifdef HAVE_AVX512F_COMPILER
+int XLALComputeFaFb_AVX512  ( COMPLEX8 *Fa, COMPLEX8 *Fb, FstatAtomVector **FstatAtoms, const SFTVector *sfts,
+                              const PulsarSpins fkdot, const SSBtimes *tSSB, const AMCoeffs *amcoe, const UINT4 Dterms );
+#endif
+
 // ----- local function definitions ----------
 static int
 XLALComputeFstatDemod ( FstatResults* Fstats,
@@ -164,12 +175,17 @@ XLALComputeFstatDemod ( FstatResults* Fstats,
       skypos.system = COORDINATESYSTEM_EQUATORIAL;
       skypos.longitude = thisPoint.Alpha;
       skypos.latitude  = thisPoint.Delta;
-      XLAL_CHECK ( (multiSSB = XLALGetMultiSSBtimes ( multiDetStates, skypos, thisPoint.refTime, common->SSBprec )) != NULL, XLAL_EFUNC );
+
+      // compute SSB times into the buffer, from their sky-independent part which is only computed once
+      if ( demod->multiSSBskyCoeffs == NULL ) {
+        XLAL_CHECK ( (demod->multiSSBskyCoeffs = XLALCreateMultiSSBskyCoeffs ( multiDetStates, common->SSBprec )) != NULL, XLAL_EFUNC );
+      }
+      demod->prevAlpha = demod->prevDelta = NAN;	// invalidate buffer until it is recomputed
+      XLAL_CHECK ( XLALGetMultiSSBtimesSky ( &demod->prevMultiSSBtimes, demod->multiSSBskyCoeffs, &skypos, 1, thisPoint.refTime ) == XLAL_SUCCESS, XLAL_EFUNC );
+      multiSSB = demod->prevMultiSSBtimes;
       XLAL_CHECK ( (multiAMcoef = XLALComputeMultiAMCoeffs ( multiDetStates, multiWeights, skypos )) != NULL, XLAL_EFUNC );
 
       // store these for possible later re-use in buffer
-      XLALDestroyMultiSSBtimes ( demod->prevMultiSSBtimes );
-      demod->prevMultiSSBtimes = multiSSB;
       demod->prevRefTime = thisPoint.refTime;
       XLALDestroyMultiAMCoeffs ( demod->prevMultiAMcoef );
       demod->prevMultiAMcoef = multiAMcoef;
@@ -362,11 +378,59 @@ XLALDestroyDemodMethodData ( void* method_data )
 
   XLALDestroyMultiSFTVector ( demod->multiSFTs);
   XLALDestroyMultiSSBtimes  ( demod->prevMultiSSBtimes );
+  XLALDestroyMultiSSBskyCoeffs ( demod->multiSSBskyCoeffs );
   XLALDestroyMultiAMCoeffs  ( demod->prevMultiAMcoef );
   XLALFree ( demod );
 
 } // XLALDestroyDemodMethodData()
 
+// Create a per-thread copy of the Demod method data: the copy shares the SFTs
+// of the original, but has its own buffered SSB times and AM coefficients
+static void *
+XLALFstatInputThreadCopy_Demod ( const void *method_data,
+                                 const FstatCommon *common,
+                                 FstatCommon *thread_common
+                                 )
+{
+  XLAL_CHECK_NULL ( method_data != NULL, XLAL_EINVAL );
+  XLAL_CHECK_NULL ( common != NULL, XLAL_EINVAL );
+  XLAL_CHECK_NULL ( thread_common != NULL, XLAL_EINVAL );
+
+  const DemodMethodData *demod = (const DemodMethodData*) method_data;
+
+  DemodMethodData *demod_copy;
+  XLAL_CHECK_NULL ( ( demod_copy = XLALCalloc ( 1, sizeof(*demod_copy) ) ) != NULL, XLAL_ENOMEM );
+  demod_copy->computefafb_func = demod->computefafb_func;
+  demod_copy->Dterms = demod->Dterms;
+  demod_copy->multiSFTs = demod->multiSFTs;
+
+  // buffers start out empty, and timing is only collected by the original method data
+  demod_copy->prevMultiSSBtimes = NULL;
+  demod_copy->multiSSBskyCoeffs = NULL;
+  demod_copy->prevMultiAMcoef = NULL;
+  demod_copy->collectTiming = 0;
+
+  return demod_copy;
+
+} // XLALFstatInputThreadCopy_Demod()
+
+static void
+XLALDestroyFstatInputThreadCopy_Demod ( void *method_data )
+{
+  if ( !method_data ) {
+    return;
+  }
+
+  DemodMethodData *demod = (DemodMethodData*) method_data;
+
+  // SFTs are owned by the original method data
+  XLALDestroyMultiSSBtimes  ( demod->prevMultiSSBtimes );
+  XLALDestroyMultiSSBskyCoeffs ( demod->multiSSBskyCoeffs );
+  XLALDestroyMultiAMCoeffs  ( demod->prevMultiAMcoef );
+  XLALFree ( demod );
+
+} // XLALDestroyFstatInputThreadCopy_Demod()
+
 int
 XLALSetupFstatDemod ( void **method_data,
                       FstatCommon *common,
@@ -390,6 +454,8 @@ XLALSetupFstatDemod ( void **method_data,
   funcs->compute_func = XLALComputeFstatDemod;
   funcs->method_data_destroy_func = XLALDestroyDemodMethodData;
   funcs->workspace_destroy_func = NULL;
+  funcs->thread_copy_func = XLALFstatInputThreadCopy_Demod;
+  funcs->thread_copy_destroy_func = XLALDestroyFstatInputThreadCopy_Demod;
 
   // Save pointer to SFTs
   demod->multiSFTs = multiSFTs;
@@ -397,6 +463,9 @@ XLALSetupFstatDemod ( void **method_data,
   // Save Dterms
   demod->Dterms = optArgs->Dterms;
 
+  // initialize sin/cos lookuptable here, before any threads are started, as some hotloops use that directly
+  XLALSinCosLUTInit();
+
   // turn on timing collection if requested
   demod->collectTiming = optArgs->collectTiming;
 
@@ -431,6 +500,16 @@ XLALSetupFstatDemod ( void **method_data,
   case FMETHOD_DEMOD_SSE:
     demod->computefafb_func = XLALComputeFaFb_SSE;
     break;
+#endif
+#ifdef HAVE_AVX2_COMPILER
+  case FMETHOD_DEMOD_AVX2:
+    demod->computefafb_func = XLALComputeFaFb_AVX2;
+    break;
+#endif
+#ifdef HAVE_AVX512F_COMPILER
+  case FMETHOD_DEMOD_AVX512:
+    demod->computefafb_func = XLALComputeFaFb_AVX512;
+    break;
 #endif
   default:
     XLAL_ERROR ( XLAL_EINVAL, "Invalid Demod hotloop optArgs->FstatMethod='%d'", optArgs->FstatMethod );
@@ -524,6 +603,7 @@ XLALFstatInputTimeslice_Demod ( const void *method_data,
   demod_slice->prevDelta = 0;
   XLAL_INIT_MEM(demod_slice->prevRefTime);
   demod_slice->prevMultiSSBtimes = NULL;
+  demod_slice->multiSSBskyCoeffs = NULL;
   demod_slice->prevMultiAMcoef = NULL;
 
   // reset timing counters
@@ -547,6 +627,7 @@ XLALDestroyFstatInputTimeslice_Demod ( void *method_data )
   DemodMethodData *demod = (DemodMethodData*) method_data;
 
   XLALDestroyMultiSSBtimes  ( demod->prevMultiSSBtimes );
+  XLALDestroyMultiSSBskyCoeffs ( demod->multiSSBskyCoeffs );
   XLALDestroyMultiAMCoeffs  ( demod->prevMultiAMcoef );
 
   for ( UINT4 X=0; X < demod->multiSFTs->length; X ++ ) {
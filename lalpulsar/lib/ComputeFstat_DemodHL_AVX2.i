@@ -0,0 +1,75 @@
+//
+// Copyright (C) 2026
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+
+/// [hotloop]
+{
+  /* AVX2 version of the generic hotloop, for unrestricted Dterms.
+   *
+   * The Dirichlet kernel is P_alpha_k = ( s_alpha + i c_alpha ) / x_k, with
+   * x_k = kappa_star + Dterms - 1 - l real, so that
+   *   sum_k P_alpha_k X_alpha_k = ( s_alpha + i c_alpha ) sum_k X_alpha_k / x_k ;
+   * only the complex sum over X_alpha_k / x_k needs to be vectorised. This is
+   * done for 4 frequency bins at a time: the divisors are computed in double
+   * precision, as in the generic hotloop, and each is then duplicated so as to
+   * scale both the real and imaginary parts of an interleaved COMPLEX8.
+   */
+  REAL4 s_alpha, c_alpha;   /* sin(2pi kappa_alpha) and (cos(2pi kappa_alpha)-1) */
+  XLALSinCos2PiLUTtrimmed ( &s_alpha, &c_alpha, kappa_star);
+  c_alpha -= 1.0f;
+
+  const REAL8 kappa_max = kappa_star + 1.0 * Dterms - 1.0;
+  const UINT4 numTerms = 2 * Dterms;
+  const UINT4 numTermsVec = numTerms & ~3U;
+  const REAL4 *Xa = (const REAL4 *) Xalpha_l;
+
+  const __m256d one = _mm256_set1_pd ( 1.0 );
+  const __m256d four = _mm256_set1_pd ( 4.0 );
+  const __m256i dup = _mm256_set_epi32 ( 3, 3, 2, 2, 1, 1, 0, 0 );
+  __m256d x0 = _mm256_set_pd ( kappa_max - 3.0, kappa_max - 2.0, kappa_max - 1.0, kappa_max );
+  __m256 XSum = _mm256_setzero_ps();
+
+  UINT4 l = 0;
+  for ( ; l < numTermsVec; l += 4 )
+    {
+      __m256d xinv = _mm256_div_pd ( one, x0 );
+      __m256 xinv2 = _mm256_permutevar8x32_ps ( _mm256_castps128_ps256 ( _mm256_cvtpd_ps ( xinv ) ), dup );
+      XSum = _mm256_add_ps ( XSum, _mm256_mul_ps ( xinv2, _mm256_loadu_ps ( Xa + 2*l ) ) );
+      x0 = _mm256_sub_pd ( x0, four );
+    }
+
+  /* add up the real (even) and imaginary (odd) elements of XSum */
+  __m128 XSum2 = _mm_add_ps ( _mm256_castps256_ps128 ( XSum ), _mm256_extractf128_ps ( XSum, 1 ) );
+  XSum2 = _mm_add_ps ( XSum2, _mm_movehl_ps ( XSum2, XSum2 ) );
+  REAL4 realXSum = _mm_cvtss_f32 ( XSum2 );
+  REAL4 imagXSum = _mm_cvtss_f32 ( _mm_shuffle_ps ( XSum2, XSum2, _MM_SHUFFLE(0, 0, 0, 1) ) );
+
+  /* remaining terms, if 2*Dterms is not a multiple of 4 */
+  for ( REAL8 x = kappa_max - l; l < numTerms; l ++, x -= 1.0 )
+    {
+      REAL4 xinv = 1.0 / x;
+      realXSum += xinv * crealf(Xalpha_l[l]);
+      imagXSum += xinv * cimagf(Xalpha_l[l]);
+    }
+
+  realXP = s_alpha * realXSum - c_alpha * imagXSum;
+  imagXP = c_alpha * realXSum + s_alpha * imagXSum;
+
+  /* real- and imaginary part of e^{i 2 pi lambda_alpha } */
+  XLALSinCos2PiLUT ( &imagQ, &realQ, lambda_alpha );
+}
+/// [hotloop]
@@ -0,0 +1,65 @@
+//
+// Copyright (C) 2026
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+
+/// [hotloop]
+{
+  /* AVX-512 version of the generic hotloop, for unrestricted Dterms.
+   *
+   * As in the AVX2 hotloop, the Dirichlet kernel is factored as
+   *   sum_k P_alpha_k X_alpha_k = ( s_alpha + i c_alpha ) sum_k X_alpha_k / x_k ,
+   * and the complex sum over X_alpha_k / x_k is computed for 8 frequency bins
+   * at a time. The final partial vector is handled with masked loads, so that
+   * no bins beyond the end of the sum are read.
+   */
+  REAL4 s_alpha, c_alpha;   /* sin(2pi kappa_alpha) and (cos(2pi kappa_alpha)-1) */
+  XLALSinCos2PiLUTtrimmed ( &s_alpha, &c_alpha, kappa_star);
+  c_alpha -= 1.0f;
+
+  const REAL8 kappa_max = kappa_star + 1.0 * Dterms - 1.0;
+  const UINT4 numTerms = 2 * Dterms;
+  const REAL4 *Xa = (const REAL4 *) Xalpha_l;
+
+  const __m512d one = _mm512_set1_pd ( 1.0 );
+  const __m512d eight = _mm512_set1_pd ( 8.0 );
+  const __m512i dup = _mm512_set_epi32 ( 7, 7, 6, 6, 5, 5, 4, 4, 3, 3, 2, 2, 1, 1, 0, 0 );
+  __m512d x0 = _mm512_set_pd ( kappa_max - 7.0, kappa_max - 6.0, kappa_max - 5.0, kappa_max - 4.0,
+                               kappa_max - 3.0, kappa_max - 2.0, kappa_max - 1.0, kappa_max );
+  __m512 XSum = _mm512_setzero_ps();
+
+  for ( UINT4 l = 0; l < numTerms; l += 8 )
+    {
+      const UINT4 n = ( numTerms - l < 8 ) ? ( numTerms - l ) : 8;
+      const __mmask8 dmask = (__mmask8) ( ( 1U << n ) - 1 );
+      const __mmask16 smask = (__mmask16) ( ( 1U << ( 2*n ) ) - 1 );
+      __m512d xinv = _mm512_maskz_div_pd ( dmask, one, x0 );
+      __m512 xinv2 = _mm512_permutexvar_ps ( dup, _mm512_castps256_ps512 ( _mm512_cvtpd_ps ( xinv ) ) );
+      XSum = _mm512_add_ps ( XSum, _mm512_mul_ps ( xinv2, _mm512_maskz_loadu_ps ( smask, Xa + 2*l ) ) );
+      x0 = _mm512_sub_pd ( x0, eight );
+    }
+
+  /* add up the real (even) and imaginary (odd) elements of XSum */
+  REAL4 realXSum = _mm512_mask_reduce_add_ps ( 0x5555, XSum );
+  REAL4 imagXSum = _mm512_mask_reduce_add_ps ( 0xAAAA, XSum );
+
+  realXP = s_alpha * realXSum - c_alpha * imagXSum;
+  imagXP = c_alpha * realXSum + s_alpha * imagXSum;
+
+  /* real- and imaginary part of e^{i 2 pi lambda_alpha } */
+  XLALSinCos2PiLUT ( &imagQ, &realQ, lambda_alpha );
+}
+/// [hotloop]
@@ -147,6 +147,7 @@ typedef struct
   PulsarDopplerParams prev_doppler;			// buffering: previous phase-evolution ("doppler") parameters
   MultiAMCoeffs *multiAMcoef;				// buffered antenna-pattern functions
   MultiSSBtimes *multiSSBtimes;				// buffered SSB times, including *only* sky-position corrections, not binary
+  MultiSSBskyCoeffs *multiSSBskyCoeffs;			// buffered sky-independent part of SSB times
   MultiSSBtimes *multiBinaryTimes;			// buffered SRC times, including both sky- and binary corrections [to avoid re-allocating this]
 
   AntennaPatternMatrix Mmunu;				// combined multi-IFO antenna-pattern coefficients {A,B,C,E}
@@ -229,6 +230,25 @@ XLALDestroyResampWorkspace ( void *workspace )
 
 } // XLALDestroyResampWorkspace()
 
+static ResampWorkspace *
+XLALCreateResampWorkspace ( UINT4 numSamplesMax_SRC,	// maximal length of a single-detector SRC-frame timeseries
+                            UINT4 numSamplesFFT		// length of zero-padded SRC-frame timeseries
+                            )
+{
+  ResampWorkspace *ws;
+  XLAL_CHECK_NULL ( (ws = XLALCalloc ( 1, sizeof(*ws))) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_NULL ( (ws->TStmp1_SRC   = XLALCreateCOMPLEX8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_NULL ( (ws->TStmp2_SRC   = XLALCreateCOMPLEX8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_NULL ( (ws->SRCtimes_DET = XLALCreateREAL8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
+
+  XLAL_CHECK_NULL ( (ws->FabX_Raw = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_NULL ( (ws->TS_FFT   = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+  ws->numSamplesFFTAlloc = numSamplesFFT;
+
+  return ws;
+
+} // XLALCreateResampWorkspace()
+
 // ---------- internal functions ----------
 static void
 XLALDestroyResampMethodData ( void* method_data )
@@ -243,6 +263,7 @@ XLALDestroyResampMethodData ( void* method_data )
   XLALDestroyMultiCOMPLEX8TimeSeries ( resamp->multiTimeSeries_SRC_b );
   XLALDestroyMultiAMCoeffs ( resamp->multiAMcoef );
   XLALDestroyMultiSSBtimes ( resamp->multiSSBtimes );
+  XLALDestroyMultiSSBskyCoeffs ( resamp->multiSSBskyCoeffs );
   XLALDestroyMultiSSBtimes ( resamp->multiBinaryTimes );
 
   LAL_FFTW_WISDOM_LOCK;
@@ -253,6 +274,87 @@ XLALDestroyResampMethodData ( void* method_data )
 
 } // XLALDestroyResampMethodData()
 
+static void
+XLALDestroyFstatInputThreadCopy_Resamp ( void *method_data )
+{
+  if ( !method_data ) {
+    return;
+  }
+
+  ResampMethodData *resamp = (ResampMethodData*) method_data;
+
+  // detector-frame timeseries and FFT plan are owned by the original method data
+  XLALDestroyMultiCOMPLEX8TimeSeries ( resamp->multiTimeSeries_SRC_a );
+  XLALDestroyMultiCOMPLEX8TimeSeries ( resamp->multiTimeSeries_SRC_b );
+  XLALDestroyMultiAMCoeffs ( resamp->multiAMcoef );
+  XLALDestroyMultiSSBtimes ( resamp->multiSSBtimes );
+  XLALDestroyMultiSSBskyCoeffs ( resamp->multiSSBskyCoeffs );
+  XLALDestroyMultiSSBtimes ( resamp->multiBinaryTimes );
+
+  XLALFree ( resamp );
+
+} // XLALDestroyFstatInputThreadCopy_Resamp()
+
+// Create a per-thread copy of the Resamp method data: the copy shares the detector-frame
+// timeseries and FFT plan of the original, but has its own SRC-frame timeseries, buffered
+// quantities, and workspace
+static void *
+XLALFstatInputThreadCopy_Resamp ( const void *method_data,
+                                  const FstatCommon *common,
+                                  FstatCommon *thread_common
+                                  )
+{
+  XLAL_CHECK_NULL ( method_data != NULL, XLAL_EINVAL );
+  XLAL_CHECK_NULL ( common != NULL && common->workspace != NULL, XLAL_EINVAL );
+  XLAL_CHECK_NULL ( thread_common != NULL, XLAL_EINVAL );
+
+  const ResampMethodData *resamp = (const ResampMethodData*) method_data;
+  const ResampWorkspace *ws = (const ResampWorkspace*) common->workspace;
+  UINT4 numDetectors = resamp->multiTimeSeries_DET->length;
+
+  ResampMethodData *resamp_copy;
+  XLAL_CHECK_NULL ( ( resamp_copy = XLALCalloc ( 1, sizeof(*resamp_copy) ) ) != NULL, XLAL_ENOMEM );
+  resamp_copy->Dterms = resamp->Dterms;
+  resamp_copy->multiTimeSeries_DET = resamp->multiTimeSeries_DET;
+  resamp_copy->numSamplesFFT = resamp->numSamplesFFT;
+  resamp_copy->decimateFFT = resamp->decimateFFT;
+  resamp_copy->fftplan = resamp->fftplan;
+
+  // buffers start out empty; make sure the first call recomputes them
+  resamp_copy->prev_doppler.Alpha = NAN;
+
+  // timing is only collected by the original method data
+  resamp_copy->collectTiming = 0;
+
+  // SRC-frame timeseries buffers, with the same layout as the original
+  XLAL_CHECK_FAIL ( (resamp_copy->multiTimeSeries_SRC_a = XLALCalloc ( 1, sizeof(MultiCOMPLEX8TimeSeries)) ) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_FAIL ( (resamp_copy->multiTimeSeries_SRC_a->data = XLALCalloc ( numDetectors, sizeof(COMPLEX8TimeSeries) )) != NULL, XLAL_ENOMEM );
+  resamp_copy->multiTimeSeries_SRC_a->length = numDetectors;
+
+  XLAL_CHECK_FAIL ( (resamp_copy->multiTimeSeries_SRC_b = XLALCalloc ( 1, sizeof(MultiCOMPLEX8TimeSeries)) ) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_FAIL ( (resamp_copy->multiTimeSeries_SRC_b->data = XLALCalloc ( numDetectors, sizeof(COMPLEX8TimeSeries) )) != NULL, XLAL_ENOMEM );
+  resamp_copy->multiTimeSeries_SRC_b->length = numDetectors;
+
+  for ( UINT4 X = 0; X < numDetectors; X ++ )
+    {
+      const COMPLEX8TimeSeries *TimeSeriesX_SRC = resamp->multiTimeSeries_SRC_a->data[X];
+      XLAL_CHECK_FAIL ( (resamp_copy->multiTimeSeries_SRC_a->data[X] = XLALCreateCOMPLEX8TimeSeries ( TimeSeriesX_SRC->name, &TimeSeriesX_SRC->epoch, TimeSeriesX_SRC->f0, TimeSeriesX_SRC->deltaT, &TimeSeriesX_SRC->sampleUnits, TimeSeriesX_SRC->data->length )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK_FAIL ( (resamp_copy->multiTimeSeries_SRC_b->data[X] = XLALCreateCOMPLEX8TimeSeries ( TimeSeriesX_SRC->name, &TimeSeriesX_SRC->epoch, TimeSeriesX_SRC->f0, TimeSeriesX_SRC->deltaT, &TimeSeriesX_SRC->sampleUnits, TimeSeriesX_SRC->data->length )) != NULL, XLAL_EFUNC );
+    }
+
+  // workspace of the same size as the shared workspace; the FFT plan is executed with
+  // fftwf_execute_dft() on these arrays, so they must have the same alignment as those
+  // the plan was created with, which fftw_malloc() guarantees
+  XLAL_CHECK_FAIL ( (thread_common->workspace = XLALCreateResampWorkspace ( ws->TStmp1_SRC->length, ws->numSamplesFFTAlloc )) != NULL, XLAL_EFUNC );
+
+  return resamp_copy;
+
+XLAL_FAIL:
+  XLALDestroyFstatInputThreadCopy_Resamp ( resamp_copy );
+  return NULL;
+
+} // XLALFstatInputThreadCopy_Resamp()
+
 int
 XLALSetupFstatResamp ( void **method_data,
                        FstatCommon *common,
@@ -278,6 +380,8 @@ XLALSetupFstatResamp ( void **method_data,
   funcs->compute_func = XLALComputeFstatResamp;
   funcs->method_data_destroy_func = XLALDestroyResampMethodData;
   funcs->workspace_destroy_func = XLALDestroyResampWorkspace;
+  funcs->thread_copy_func = XLALFstatInputThreadCopy_Resamp;
+  funcs->thread_copy_destroy_func = XLALDestroyFstatInputThreadCopy_Resamp;
 
   // Extra band needed for resampling: Hamming-windowed sinc used for interpolation has a transition bandwith of
   // TB=(4/L)*fSamp, where L=2*Dterms+1 is the window-length, and here fSamp=Band (i.e. the full SFT frequency band)
@@ -394,15 +498,7 @@ XLALSetupFstatResamp ( void **method_data,
     } // end: if shared workspace given
   else
     {
-      XLAL_CHECK ( (ws = XLALCalloc ( 1, sizeof(*ws))) != NULL, XLAL_ENOMEM );
-      XLAL_CHECK ( (ws->TStmp1_SRC   = XLALCreateCOMPLEX8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
-      XLAL_CHECK ( (ws->TStmp2_SRC   = XLALCreateCOMPLEX8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
-      XLAL_CHECK ( (ws->SRCtimes_DET = XLALCreateREAL8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
-
-      XLAL_CHECK ( (ws->FabX_Raw = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-      XLAL_CHECK ( (ws->TS_FFT   = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-      ws->numSamplesFFTAlloc = numSamplesFFT;
-
+      XLAL_CHECK ( (ws = XLALCreateResampWorkspace ( numSamplesMax_SRC, numSamplesFFT )) != NULL, XLAL_EFUNC );
       common->workspace = ws;
     } // end: if we create our own workspace
 
@@ -969,8 +1065,12 @@ XLALBarycentricResampleMultiCOMPLEX8TimeSeries ( ResampMethodData *resamp,		// [
           resamp->MmunuX[X].Dd = resamp->multiAMcoef->data[X]->D;
         }
 
-      XLALDestroyMultiSSBtimes ( resamp->multiSSBtimes );
-      XLAL_CHECK ( (resamp->multiSSBtimes = XLALGetMultiSSBtimes ( common->multiDetectorStates, skypos, thisPoint->refTime, common->SSBprec )) != NULL, XLAL_EFUNC );
+      // compute SSB times into the buffer, from their sky-independent part which is only computed once
+      if ( resamp->multiSSBskyCoeffs == NULL ) {
+        XLAL_CHECK ( (resamp->multiSSBskyCoeffs = XLALCreateMultiSSBskyCoeffs ( common->multiDetectorStates, common->SSBprec )) != NULL, XLAL_EFUNC );
+      }
+      resamp->prev_doppler.Alpha = NAN;	// invalidate buffer until it is recomputed
+      XLAL_CHECK ( XLALGetMultiSSBtimesSky ( &resamp->multiSSBtimes, resamp->multiSSBskyCoeffs, &skypos, 1, thisPoint->refTime ) == XLAL_SUCCESS, XLAL_EFUNC );
 
     } // if cannot re-use buffered solution ie if !(same_skypos && same_binary)
 
@@ -68,6 +68,10 @@ typedef struct {
     );
   void (*method_data_destroy_func) ( void * );		// F-statistic method data destructor function
   void (*workspace_destroy_func) ( void * );		// Workspace destructor function
+  void *(*thread_copy_func) (				// Create a per-thread copy of method data, sharing its read-only input data;
+    const void *, const FstatCommon *, FstatCommon *	// any workspace needed by the copy is allocated in the given copy of the common data
+    );
+  void (*thread_copy_destroy_func) ( void * );		// Per-thread method data copy destructor
 } FstatMethodFuncs;
 
 // ---------- Shared internal functions ---------- //
@@ -339,7 +339,7 @@ XLALCreateDetectorStateSeries ( UINT4 length )		/**< number of entries */
  * Get the 'detector state' (ie detector-tensor, position, velocity, etc) for the given
  * vector of timestamps, shifted by a common time-shift \a tOffset.
  *
- * This function just calls XLALBarycenterEarth() and XLALBarycenter() for the
+ * This function just calls XLALBarycenterEarthBatch() and XLALBarycenter() for the
  * given vector of timestamps (shifted by tOffset) and returns the positions,
  * velocities and LMSTs of the detector, stored in a DetectorStateSeries.
  * There is also an entry containing the EarthState at each timestamp, which
@@ -381,28 +381,46 @@ XLALGetDetectorStates ( const LIGOTimeGPSVector *timestamps,	/**< array of GPS t
   else	/* Earth-based */
     ret->system = COORDINATESYSTEM_EQUATORIAL;
 
-  /* now fill all the vector-entries corresponding to different timestamps */
+  /* shift timestamps by tOffset, and get the earth-states for all of them at once */
+  LIGOTimeGPS *tgpsShifted = LALCalloc ( numSteps, sizeof(*tgpsShifted) );
+  EarthState *earthStates = LALCalloc ( numSteps, sizeof(*earthStates) );
+  if ( tgpsShifted == NULL || earthStates == NULL ) {
+    LALFree ( tgpsShifted );
+    LALFree ( earthStates );
+    XLALDestroyDetectorStateSeries ( ret );
+    XLALPrintError ("%s: failed to LALCalloc(%d, %zu + %zu)\n", __func__, numSteps, sizeof(*tgpsShifted), sizeof(*earthStates) );
+    XLAL_ERROR_NULL ( XLAL_ENOMEM );
+  }
   UINT4 i;
+  for ( i=0; i < numSteps; i++ )
+    {
+      tgpsShifted[i] = timestamps->data[i];
+      XLALGPSAdd(&tgpsShifted[i], tOffset);
+    }
+  int retn = XLALBarycenterEarthBatch ( earthStates, tgpsShifted, numSteps, edat, NULL, TIMECORRECTION_ORIGINAL );
+  for ( i=0; i < numSteps && retn == XLAL_SUCCESS; i++ )
+    {
+      ret->data[i].tGPS = tgpsShifted[i];
+      ret->data[i].earthState = earthStates[i];
+    }
+  LALFree ( tgpsShifted );
+  LALFree ( earthStates );
+  if ( retn != XLAL_SUCCESS ) {
+    XLALDestroyDetectorStateSeries ( ret );
+    XLALPrintError("%s: XLALBarycenterEarthBatch() failed with xlalErrno=%d\n", __func__, xlalErrno );
+    XLAL_ERROR_NULL ( XLAL_EFAILED );
+  }
+
+  /* now fill all the vector-entries corresponding to different timestamps */
   for ( i=0; i < numSteps; i++ )
     {
       BarycenterInput baryinput;
       EmissionTime emit;
       DetectorState *state = &(ret->data[i]);
       EarthState *earth = &(state->earthState);
-      LIGOTimeGPS tgps;
-
-      /* shift timestamp by tOffset */
-      tgps = timestamps->data[i];
-      XLALGPSAdd(&tgps, tOffset);
-
-      /*----- first get earth-state */
-      if ( XLALBarycenterEarth ( earth, &tgps, edat ) != XLAL_SUCCESS ) {
-        XLALDestroyDetectorStateSeries ( ret );
-        XLALPrintError("%s: XLALBarycenterEarth() failed with xlalErrno=%d\n", __func__, xlalErrno );
-        XLAL_ERROR_NULL ( XLAL_EFAILED );
-      }
+      LIGOTimeGPS tgps = state->tGPS;
 
-      /*----- then get detector-specific info */
+      /*----- get detector-specific info */
       baryinput.tgps = tgps;
       baryinput.site = (*detector);
       baryinput.site.location[0] /= LAL_C_SI;
@@ -429,9 +447,6 @@ XLALGetDetectorStates ( const LIGOTimeGPSVector *timestamps,	/**< array of GPS t
       state->LMST = earth->gmstRad + detector->frDetector.vertexLongitudeRadians;
       state->LMST = fmod (state->LMST, LAL_TWOPI );	/* normalize */
 
-      /* insert timestamp */
-      state->tGPS = tgps;
-
       /* compute the detector-tensor at this time-stamp in SSB-fixed Cartesian coordinates
        * [EQUATORIAL for Earth-based, ECLIPTIC for LISA]
        */
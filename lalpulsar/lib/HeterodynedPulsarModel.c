@@ -25,6 +25,9 @@
 /** Macro to square a value. */
 #define SQUARE(x) ( (x) * (x) )
 
+/** Number of times for which XLALHeterodynedPulsarGetSSBDelay() gets the earth's state at once. */
+#define SSB_EARTH_CHUNK 1024
+
  /**
  * \brief The phase evolution difference compared to a heterodyned phase (for a pulsar) 
  *
@@ -332,7 +335,7 @@ REAL8Vector *XLALHeterodynedPulsarPhaseDifference( PulsarParameters *params,
  * \return A vector of time delays in seconds
  *
  * \sa XLALBarycenter
- * \sa XLALBarycenterEarthNew
+ * \sa XLALBarycenterEarthBatch
  */
 REAL8Vector *XLALHeterodynedPulsarGetSSBDelay( PulsarParameters *pars,
                                                const LIGOTimeGPSVector *datatimes,
@@ -407,18 +410,31 @@ REAL8Vector *XLALHeterodynedPulsarGetSSBDelay( PulsarParameters *pars,
     ra = fmod(ra + (REAL8)nwrap*LAL_PI, LAL_TWOPI); /* move RA by pi */
   }
 
-  EarthState earth;
+  /* get the earth's state in chunks of SSB_EARTH_CHUNK times, so that the memory needed does not grow with the data length */
+  EarthState *earth = XLALCalloc( SSB_EARTH_CHUNK, sizeof(*earth) );
+  XLAL_CHECK_NULL( earth != NULL, XLAL_ENOMEM );
+
   EmissionTime emit;
   for( i=0; i<length; i++){
+    if ( i % SSB_EARTH_CHUNK == 0 ){
+      UINT4 nchunk = ( length - i < SSB_EARTH_CHUNK ) ? (UINT4)( length - i ) : SSB_EARTH_CHUNK;
+      if ( XLALBarycenterEarthBatch( earth, &datatimes->data[i], nchunk, ephem, tdat, ttype ) != XLAL_SUCCESS ){
+        XLALFree( earth );
+        XLAL_ERROR_NULL( XLAL_EFUNC, "Barycentring routine failed" );
+      }
+    }
+
     REAL8 realT = XLALGPSGetREAL8( &datatimes->data[i] );
 
     bary.tgps = datatimes->data[i];
     bary.delta = dec + ( realT - posepoch ) * pmdec;
     bary.alpha = ra + ( realT - posepoch ) * pmra / cos( bary.delta );
 
-    /* call barycentring routines */
-    XLAL_CHECK_NULL( XLALBarycenterEarthNew( &earth, &bary.tgps, ephem, tdat, ttype ) == XLAL_SUCCESS, XLAL_EFUNC, "Barycentring routine failed" );
-    XLAL_CHECK_NULL( XLALBarycenter( &emit, &bary, &earth ) == XLAL_SUCCESS, XLAL_EFUNC, "Barycentring routine failed" );
+    /* call barycentring routine */
+    if ( XLALBarycenter( &emit, &bary, &earth[i % SSB_EARTH_CHUNK] ) != XLAL_SUCCESS ){
+      XLALFree( earth );
+      XLAL_ERROR_NULL( XLAL_EFUNC, "Barycentring routine failed" );
+    }
 
     if ( cgw > 0.0 ){
       /* account for the speed of GWs not being the same a the speed of light
@@ -430,6 +446,8 @@ REAL8Vector *XLALHeterodynedPulsarGetSSBDelay( PulsarParameters *pars,
     }
   }
 
+  XLALFree( earth );
+
   return dts;
 }
 
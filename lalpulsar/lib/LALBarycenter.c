@@ -56,7 +56,68 @@ struct tagBarycenterBuffer
   BOOLEAN active;		/// switch set on TRUE of buffer has been filled
 }; // struct tagBarycenterBuffer
 
+/* Einstein delay: the terms of the expansion of TDB-TDT stolen from TEMPO, i.e. the approx 20 biggest
+ * terms followed by the NEXT biggest (2nd-tier) terms, as { amplitude [microsec], frequency [1/Julian
+ * millenium], phase } */
+static const REAL8 einsteinTerms[][3] = {
+  { 1656.674564e0, 6283.075849991e0, 6.240054195e0 },
+  { 22.417471e0, 5753.384884897e0, 4.296977442e0 },
+  { 13.839792e0, 12566.151699983e0, 6.196904410e0 },
+  { 4.770086e0, 529.690965095e0, 0.444401603e0 },
+  { 4.676740e0, 6069.776754553e0, 4.021195093e0 },
+  { 2.256707e0, 213.299095438e0, 5.543113262e0 },
+  { 1.694205e0, -3.523118349e0, 5.025132748e0 },
+  { 1.554905e0, 77713.771467920e0, 5.198467090e0 },
+  { 1.276839e0, 7860.419392439e0, 5.988822341e0 },
+  { 1.193379e0, 5223.693919802e0, 3.649823730e0 },
+  { 1.115322e0, 3930.209696220e0, 1.422745069e0 },
+  { 0.794185e0, 11506.769769794e0, 2.322313077e0 },
+  { 0.447061e0, 26.298319800e0, 3.615796498e0 },
+  { 0.435206e0, -398.149003408e0, 4.349338347e0 },
+  { 0.600309e0, 1577.343542448e0, 2.678271909e0 },
+  { 0.496817e0, 6208.294251424e0, 5.696701824e0 },
+  { 0.486306e0, 5884.926846583e0, 0.520007179e0 },
+  { 0.432392e0, 74.781598567e0, 2.435898309e0 },
+  { 0.468597e0, 6244.942814354e0, 5.866398759e0 },
+  { 0.375510e0, 5507.553238667e0, 4.103476804e0 },
+  /* 2nd-tier terms */
+  { 0.243085, -775.522611324, 3.651837925 },
+  { 0.173435, 18849.227549974, 6.153743485 },
+  { 0.230685, 5856.477659115, 4.773852582 },
+  { 0.203747, 12036.460734888, 4.333987818 },
+  { 0.143935, -796.298006816, 5.957517795 },
+  { 0.159080, 10977.078804699, 1.890075226 },
+  { 0.119979, 38.133035638, 4.551585768 },
+  { 0.118971, 5486.777843175, 1.914547226 },
+  { 0.116120, 1059.381930189, 0.873504123 },
+  { 0.137927, 11790.629088659, 1.135934669 },
+  { 0.098358, 2544.314419883, 0.092793886 },
+  { 0.101868, -5573.142801634, 5.984503847 },
+  { 0.080164, 206.185548437, 2.095377709 },
+  { 0.079645, 4694.002954708, 2.949233637 },
+  { 0.062617, 20.775395492, 2.654394814 },
+  { 0.075019, 2942.463423292, 4.980931759 },
+  { 0.064397, 5746.271337896, 1.280308748 },
+  { 0.063814, 5760.498431898, 4.167901731 },
+  { 0.048042, 2146.165416475, 1.495846011 },
+  { 0.048373, 155.420399434, 2.251573730 }
+};
+#define EINSTEIN_NUM_TERMS	( sizeof(einsteinTerms) / sizeof(einsteinTerms[0]) )
+#define EINSTEIN_NUM_TERMS_1ST	20
+
+/* terms of einsteinTerms (in ascending order) whose derivatives are added to deinstein; the others
+ * contribute less than around 10^{-12} to tDotBary, and the 2nd-tier terms are not added either */
+static const UINT4 deinsteinTerms[] = { 0, 1, 2, 4, 7 };
+#define DEINSTEIN_NUM_TERMS	( sizeof(deinsteinTerms) / sizeof(deinsteinTerms[0]) )
+
+/* maximum number of equal time-steps over which XLALBarycenterEarthBatch() updates the Einstein delay
+ * by rotating its terms, before evaluating them afresh */
+#define EINSTEIN_MAX_STEPS 64
+
 /* Internal functions */
+static int barycenter_earth ( EarthState *earth, const LIGOTimeGPS *tGPS, const EphemerisData *edat, BOOLEAN einstein );
+static void einstein_delay_terms ( REAL8 *S, REAL8 *C, const LIGOTimeGPS *tGPS, BOOLEAN allCosines );
+static void einstein_delay_sum ( EarthState *earth, const REAL8 *S, const REAL8 *C );
 static void precessionMatrix( REAL8 prn[3][3], REAL8 mjd, REAL8 dpsi, REAL8 deps );
 static void observatoryEarth( REAL8 obsearth[3], const LALDetector det, const LIGOTimeGPS *tgps, REAL8 gmst, REAL8 dpsi, REAL8 deps );
 
@@ -78,6 +139,17 @@ int
 XLALBarycenterEarth ( EarthState *earth, 		/**< [out] the earth's state at time tGPS */
                       const LIGOTimeGPS *tGPS, 		/**< [in] GPS time tgps */
                       const EphemerisData *edat) 	/**< [in] ephemeris-files */
+{
+  return barycenter_earth ( earth, tGPS, edat, 1 );
+} /* XLALBarycenterEarth() */
+
+
+/**
+ * Computes the position and orientation of the Earth for XLALBarycenterEarth() and
+ * XLALBarycenterEarthBatch(); the Einstein delay is only calculated if \a einstein is true.
+ */
+static int
+barycenter_earth ( EarthState *earth, const LIGOTimeGPS *tGPS, const EphemerisData *edat, BOOLEAN einstein )
 {
   REAL8 tgps[2];   /*I convert from two-integer representation to
                       two REAL8s (just because I initially wrote my code for
@@ -309,131 +381,10 @@ XLALBarycenterEarth ( EarthState *earth, 		/**< [out] the earth's state at time
      * Note the 51.184 s difference between TDT and GPS
      *-----------------------------------------------------------------------
      */
-    {
-    REAL8 jedtdt = -7300.5e0 + (tgps[0] + 51.184e0 + tgps[1]*1.e-9)/8.64e4;
-    REAL8 jt=jedtdt/3.6525e5; /*converting to TEMPO expansion param
-                               = Julian millenium, NOT Julian century */
-    earth->einstein = 1.e-6*(
-       1656.674564e0 * sin(6283.075849991e0*jt + 6.240054195e0 )+
-       22.417471e0 * sin(5753.384884897e0*jt + 4.296977442e0 )  +
-       13.839792e0 * sin(12566.151699983e0*jt + 6.196904410e0 )  +
-       4.770086e0 * sin(529.690965095e0*jt + 0.444401603e0 )   +
-       4.676740e0 * sin(6069.776754553e0 *jt + 4.021195093e0 )   +
-       2.256707e0 * sin(213.299095438e0 *jt + 5.543113262e0 )   +
-       1.694205e0 * sin(-3.523118349e0 *jt + 5.025132748e0 )   +
-       1.554905e0 * sin(77713.771467920e0 *jt + 5.198467090e0 )   +
-       1.276839e0 * sin(7860.419392439e0 *jt + 5.988822341e0 )   +
-       1.193379e0 * sin(5223.693919802e0 *jt + 3.649823730e0 )   +
-       1.115322e0 * sin(3930.209696220e0 *jt + 1.422745069e0 )   +
-       0.794185e0 * sin(11506.769769794e0 *jt + 2.322313077e0 )   +
-       0.447061e0 * sin(26.298319800e0 *jt + 3.615796498e0 )   +
-       0.435206e0 * sin(-398.149003408e0 *jt + 4.349338347e0 )   +
-       0.600309e0 * sin(1577.343542448e0 *jt + 2.678271909e0 )   +
-       0.496817e0 * sin(6208.294251424e0 *jt + 5.696701824e0 )   +
-       0.486306e0 * sin(5884.926846583e0 *jt + 0.520007179e0 )   +
-       0.432392e0 * sin(74.781598567e0 *jt + 2.435898309e0 )   +
-       0.468597e0 * sin(6244.942814354e0 *jt + 5.866398759e0 )   +
-       0.375510e0 * sin(5507.553238667e0 *jt + 4.103476804e0 )
-       );
-
-/* now adding NEXT biggest (2nd-tier) terms from Tempo */
-    earth->einstein = earth->einstein + 1.e-6*(
-      0.243085 * sin(-775.522611324 *jt + 3.651837925 )   +
-      0.173435 * sin(18849.227549974 *jt + 6.153743485 )   +
-      0.230685 * sin(5856.477659115 *jt + 4.773852582 )   +
-      0.203747 * sin(12036.460734888 *jt + 4.333987818 )   +
-      0.143935 * sin(-796.298006816 *jt + 5.957517795 )   +
-      0.159080 * sin(10977.078804699 *jt + 1.890075226 )   +
-      0.119979 * sin(38.133035638 *jt + 4.551585768 )   +
-      0.118971 * sin(5486.777843175 *jt + 1.914547226 )   +
-      0.116120 * sin(1059.381930189 *jt + 0.873504123 )   +
-      0.137927 * sin(11790.629088659 *jt + 1.135934669 )   +
-      0.098358 * sin(2544.314419883 *jt + 0.092793886 )   +
-      0.101868 * sin(-5573.142801634 *jt + 5.984503847 )   +
-      0.080164 * sin(206.185548437 *jt + 2.095377709 )   +
-      0.079645 * sin(4694.002954708 *jt + 2.949233637 )   +
-      0.062617 * sin(20.775395492 *jt + 2.654394814 )   +
-      0.075019 * sin(2942.463423292 *jt + 4.980931759 )   +
-      0.064397 * sin(5746.271337896 *jt + 1.280308748 )   +
-      0.063814 * sin(5760.498431898 *jt + 4.167901731 )   +
-      0.048042 * sin(2146.165416475 *jt + 1.495846011 )   +
-      0.048373 * sin(155.420399434 *jt + 2.251573730 )
-      );
-
-
-/* below, I've just taken derivative of above expression for einstein,
-   then commented out terms that contribute less than around 10^{-12}
-   to tDotBary */
-
-    earth->deinstein = 1.e-6*(
-       1656.674564e0*6283.075849991e0*
-                 cos(6283.075849991e0*jt + 6.240054195e0 )+
-
-       22.417471e0*5753.384884897e0*
-               cos(5753.384884897e0*jt + 4.296977442e0 )  +
-
-       13.839792e0*12566.151699983e0*
-               cos(12566.151699983e0*jt + 6.196904410e0 ) +
-
-/* neglect next term
-       4.770086e0*529.690965095e0*
-               cos(529.690965095e0*jt + 0.444401603e0 )   +
-*/
-       4.676740e0*6069.776754553e0*
-              cos(6069.776754553e0*jt + 4.021195093e0 )   +
-
-/* neglect next 2 terms
-       2.256707e0*213.299095438e0*
-              cos(213.299095438e0*jt + 5.543113262e0 )    +
-
-       1.694205e0*-3.523118349e0*
-              cos(-3.523118349e0*jt + 5.025132748e0 )     +
-*/
-
-       1.554905e0*77713.771467920e0*
-              cos(77713.771467920e0*jt + 5.198467090e0 )
-
-/* neglect all the rest
-       +   1.276839e0*7860.419392439e0*
-              cos(7860.419392439e0*jt + 5.988822341e0 )   +
-
-       1.193379e0*5223.693919802e0*
-              cos(5223.693919802e0*jt + 3.649823730e0 )   +
-
-       1.115322e0*3930.209696220e0*
-              cos(3930.209696220e0*jt + 1.422745069e0 )   +
-
-       0.794185e0*11506.769769794e0*
-              cos(11506.769769794e0 *jt + 2.322313077e0 )  +
-
-       0.447061e0*26.298319800e0*
-              cos(26.298319800e0*jt + 3.615796498e0 )     +
-
-       0.435206e0*-398.149003408e0*
-              cos(-398.149003408e0*jt + 4.349338347e0 )   +
-
-       0.600309e0*1577.343542448e0*
-              cos(1577.343542448e0*jt + 2.678271909e0 )   +
-
-       0.496817e0*6208.294251424e0*
-              cos(6208.294251424e0*jt + 5.696701824e0 )   +
-
-       0.486306e0*5884.926846583e0*
-              cos(5884.926846583e0*jt + 0.520007179e0 )   +
-
-       0.432392e0*74.781598567e0*
-              cos(74.781598567e0*jt + 2.435898309e0 )     +
-
-       0.468597e0*6244.942814354e0*
-              cos(6244.942814354e0*jt + 5.866398759e0 )   +
-
-       0.375510e0*5507.553238667e0*
-              cos(5507.553238667e0*jt + 4.103476804e0 )
-*/
-
-       )/(8.64e4*3.6525e5);
-
-/*Note I don't bother adding 2nd-tier terms to deinstein_tempo either */
+    if ( einstein ) {
+      REAL8 S[EINSTEIN_NUM_TERMS], C[EINSTEIN_NUM_TERMS];
+      einstein_delay_terms ( S, C, tGPS, 0 );
+      einstein_delay_sum ( earth, S, C );
     }
 
     /********************************************************************
@@ -465,7 +416,89 @@ XLALBarycenterEarth ( EarthState *earth, 		/**< [out] the earth's state at time
 
   return XLAL_SUCCESS;
 
-} /* XLALBarycenterEarth() */
+} /* barycenter_earth() */
+
+
+/**
+ * \brief Computes the position and orientation of the Earth, as XLALBarycenterEarth() or
+ * XLALBarycenterEarthNew(), for a whole vector of arrival times at once.
+ *
+ * With the original time corrections (\c TIMECORRECTION_ORIGINAL), the terms of the Einstein delay
+ * series are evaluated afresh only at the start of each run of equally-spaced timestamps (e.g. SFT
+ * timestamps, or samples of a heterodyned time series), and are then advanced from one timestamp to
+ * the next by rotating all terms at once through the time-step, which is much cheaper than evaluating
+ * them, and vectorises; the Einstein delay then agrees with that of XLALBarycenterEarth() to around
+ * 10^{-16} s. All other quantities, and the Einstein delay at timestamps which are not part of such
+ * a run, are identical to those of XLALBarycenterEarth().
+ * Other time corrections use the look-up table \a tdat, and are computed by XLALBarycenterEarthNew().
+ */
+int
+XLALBarycenterEarthBatch ( EarthState *earth,                  /**< [out] array of the earth's states at times tGPS */
+                           const LIGOTimeGPS *tGPS,            /**< [in] array of GPS times */
+                           UINT4 numTimes,                     /**< [in] number of GPS times */
+                           const EphemerisData *edat,          /**< [in] ephemeris-files */
+                           const TimeCorrectionData *tdat,     /**< [in] time correction file data; may be NULL for TIMECORRECTION_ORIGINAL */
+                           TimeCorrectionType ttype            /**< [in] time correction type */
+                           )
+{
+  XLAL_CHECK ( numTimes == 0 || ( earth != NULL && tGPS != NULL ), XLAL_EINVAL );
+  XLAL_CHECK ( edat != NULL && edat->ephemE != NULL && edat->ephemS != NULL, XLAL_EINVAL );
+
+  /* time corrections from a look-up table */
+  if ( ttype != TIMECORRECTION_ORIGINAL )
+    {
+      for ( UINT4 i = 0; i < numTimes; i ++ )
+        XLAL_CHECK ( XLALBarycenterEarthNew ( &earth[i], &tGPS[i], edat, tdat, ttype ) == XLAL_SUCCESS, XLAL_EFUNC );
+      return XLAL_SUCCESS;
+    }
+
+  /* original time corrections: over each run of equally-spaced timestamps, evaluate the terms of the
+     Einstein delay at the first timestamp, then rotate them by the time-step to get the terms at the
+     following timestamps */
+  REAL8 S[EINSTEIN_NUM_TERMS], C[EINSTEIN_NUM_TERMS], dS[EINSTEIN_NUM_TERMS], dC[EINSTEIN_NUM_TERMS];
+  for ( UINT4 i0 = 0, i1 = 0; i0 < numTimes; i0 = i1 )
+    {
+      /* find end 'i1' of run of equal time-steps 'stepNS' starting at 'i0' */
+      const INT8 stepNS = ( i0 + 1 < numTimes ) ? XLALGPSToINT8NS ( &tGPS[i0 + 1] ) - XLALGPSToINT8NS ( &tGPS[i0] ) : 0;
+      for ( i1 = i0 + 1; i1 < numTimes && i1 - i0 <= EINSTEIN_MAX_STEPS; i1 ++ )
+        if ( XLALGPSToINT8NS ( &tGPS[i1] ) - XLALGPSToINT8NS ( &tGPS[i1 - 1] ) != stepNS )
+          break;
+
+      /* rotating is only worthwhile if the rotation is used more than once */
+      if ( i1 - i0 < 3 )
+        {
+          i1 = i0 + 1;
+          XLAL_CHECK ( barycenter_earth ( &earth[i0], &tGPS[i0], edat, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+          continue;
+        }
+
+      for ( UINT4 i = i0; i < i1; i ++ )
+        XLAL_CHECK ( barycenter_earth ( &earth[i], &tGPS[i], edat, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      einstein_delay_terms ( S, C, &tGPS[i0], 1 );
+      einstein_delay_sum ( &earth[i0], S, C );
+
+      const REAL8 dt = stepNS * 1.e-9 / (8.64e4*3.6525e5); /* time-step in Julian millenia */
+      for ( UINT4 k = 0; k < EINSTEIN_NUM_TERMS; k ++ )
+        {
+          dS[k] = sin ( einsteinTerms[k][1] * dt );
+          dC[k] = cos ( einsteinTerms[k][1] * dt );
+        }
+      for ( UINT4 i = i0 + 1; i < i1; i ++ )
+        {
+          for ( UINT4 k = 0; k < EINSTEIN_NUM_TERMS; k ++ )
+            {
+              const REAL8 Sk = S[k], Ck = C[k];
+              S[k] = Sk * dC[k] + Ck * dS[k];
+              C[k] = Ck * dC[k] - Sk * dS[k];
+            }
+          einstein_delay_sum ( &earth[i], S, C );
+        }
+    }
+
+  return XLAL_SUCCESS;
+
+} /* XLALBarycenterEarthBatch() */
 
 
 /**
@@ -1461,6 +1494,170 @@ XLALBarycenterOpt ( EmissionTime *emit, 		/**< [out] emission-time information *
 
 } /* XLALBarycenterOpt() */
 
+/**
+ * Compute the sky-position independent part of XLALBarycenterOpt() for the arrival time and
+ * detector site in \a baryinput (\a baryinput->alpha and \a baryinput->delta are ignored).
+ *
+ * The Roemer delay and the Earth rotation delay, including luni-solar precession and nutation,
+ * are linear in the unit vector \f$\hat{n}\f$ pointing to the source, and are stored as the vectors
+ * of coefficients of \f$\hat{n}\f$; together with the Einstein delay, the observatory term and the
+ * Sun-Earth vector for the Shapiro delay, this allows XLALBarycenterSkyBlock() to compute the
+ * emission times for any number of sky-positions, at a fraction of the cost of XLALBarycenterOpt().
+ *
+ * The correction for a finite distance to the source is not linear in \f$\hat{n}\f$, and is
+ * not supported: \a baryinput->dInv must be zero.
+ */
+int
+XLALBarycenterSkyCoeffs ( BarycenterSkyCoeffs *coeffs,		/**< [out] sky-independent coefficients */
+                          const BarycenterInput *baryinput,	/**< [in] arrival time and detector site */
+                          const EarthState *earth		/**< [in] earth-state (from XLALBarycenterEarth()) */
+                          )
+{
+  XLAL_CHECK ( coeffs != NULL, XLAL_EINVAL, "Invalid input: coeffs == NULL");
+  XLAL_CHECK ( baryinput != NULL, XLAL_EINVAL, "Invalid input: baryinput == NULL");
+  XLAL_CHECK ( earth != NULL, XLAL_EINVAL, "Invalid input: earth == NULL");
+  XLAL_CHECK ( baryinput->dInv <= 1.0e-11, XLAL_EINVAL, "Finite-distance correction (dInv = %g) is not supported\n", baryinput->dInv );
+
+  // constants as in XLALBarycenterOpt()
+  const REAL8 OMEGA = 7.29211510e-5;  /* ang. vel. of Earth (rad/sec)*/
+  const REAL8 sinEps0 = 0.397777155931914; 	// sin ( eps0 );
+  const REAL8 cosEps0 = 0.917482062069182;	// cos ( eps0 );
+
+  // ---------- detector site-position dependent quantities, as in XLALBarycenterOpt()
+  REAL8 rd = sqrt( + baryinput->site.location[0]*baryinput->site.location[0]
+                   + baryinput->site.location[1]*baryinput->site.location[1]
+                   + baryinput->site.location[2]*baryinput->site.location[2] );
+  REAL8 longitude = atan2 ( baryinput->site.location[1], baryinput->site.location[0] );
+  REAL8 latitude;
+  if ( rd == 0.0 )
+    latitude = LAL_PI_2;	// avoid division by 0, for detector at center of earth
+  else
+    latitude = LAL_PI_2 - acos ( baryinput->site.location[2] / rd );
+  REAL8 rd_sinLat = rd * sin ( latitude );
+  REAL8 rd_cosLat = rd * cos ( latitude );
+
+  // ---------- get the observatory term (if in TDB)
+  REAL8 obsTerm = 0;
+  if ( earth->ttype != TIMECORRECTION_ORIGINAL )
+    {
+      REAL8 obsEarth[3];
+      observatoryEarth( obsEarth, baryinput->site, &baryinput->tgps, earth->gmstRad, earth->delpsi, earth->deleps );
+
+      for ( UINT4 j = 0; j < 3; j++ )
+        obsTerm += obsEarth[j] * earth->velNow[j];
+
+      obsTerm /= (1.0-IFTE_LC)*(REAL8)IFTE_K;
+    }
+
+  // ---------- Earth rotation, luni-solar precession and nutation: the expressions of
+  // XLALBarycenterOpt(), written in terms of n and evaluated for each unit vector n = e_j
+  REAL8 cosTzeA = cos ( earth->tzeA );
+  REAL8 sinTzeA = sin ( earth->tzeA );
+  REAL8 cosThetaA = cos ( earth->thetaA );
+  REAL8 sinThetaA = sin ( earth->thetaA );
+  REAL8 cosGastZA = cos ( earth->gastRad + longitude-earth->zA );
+  REAL8 sinGastZA = sin ( earth->gastRad + longitude-earth->zA );
+  REAL8 cosGastLong = cos ( earth->gastRad + longitude );
+  REAL8 sinGastLong = sin ( earth->gastRad + longitude );
+
+  for ( UINT4 j = 0; j < 3; j++ )
+    {
+      REAL8 n[3] = { 0, 0, 0 };
+      n[j] = 1;
+
+      REAL8 cosDeltaSinAlphaMinusZA = n[1] * cosTzeA + n[0] * sinTzeA;
+      REAL8 cosDeltaCosAlphaMinusZA = ( n[0] * cosTzeA - n[1] * sinTzeA ) * cosThetaA - sinThetaA * n[2];
+      REAL8 sinDeltaCurt = ( n[0] * cosTzeA - n[1] * sinTzeA ) * sinThetaA + cosThetaA * n[2];
+
+      REAL8 erot = rd_sinLat * sinDeltaCurt + rd_cosLat * ( cosGastZA * cosDeltaCosAlphaMinusZA + sinGastZA * cosDeltaSinAlphaMinusZA );
+      REAL8 derot = OMEGA * rd_cosLat * ( - sinGastZA * cosDeltaCosAlphaMinusZA + cosGastZA * cosDeltaSinAlphaMinusZA );
+
+      REAL8 delXNut = - earth->delpsi * ( n[1] * cosEps0 + n[2] * sinEps0 );
+      REAL8 delYNut = n[0] * cosEps0 * earth->delpsi - n[2] * earth->deleps;
+      REAL8 delZNut = n[0] * sinEps0 * earth->delpsi + n[1] * earth->deleps;
+
+      erot += rd_sinLat * delZNut + rd_cosLat * cosGastLong * delXNut + rd_cosLat * sinGastLong * delYNut;
+      derot += OMEGA * ( - rd_cosLat * sinGastLong * delXNut + rd_cosLat * cosGastLong * delYNut );
+
+      coeffs->deltaT[j] = earth->posNow[j] + erot;
+      coeffs->tDot[j] = earth->velNow[j] + derot;
+      coeffs->se[j] = earth->se[j];
+      coeffs->dse[j] = earth->dse[j];
+    }
+
+  coeffs->deltaT0 = earth->einstein + obsTerm;
+  coeffs->tDot0 = 1.0 + earth->deinstein;
+  coeffs->rse = earth->rse;
+  coeffs->drse = earth->drse;
+
+  return XLAL_SUCCESS;
+
+} /* XLALBarycenterSkyCoeffs() */
+
+/**
+ * Compute \f$t_e - t_a\f$ and \f$dt_e/dt_a\f$, as in the fields \c deltaT and \c tDot of
+ * ::EmissionTime, for \a numSky sky-positions with unit vectors (\a nx[s], \a ny[s], \a nz[s]),
+ * given the sky-independent coefficients from XLALBarycenterSkyCoeffs().
+ *
+ * The results agree with XLALBarycenterOpt() up to rounding, i.e. to better than a nanosecond.
+ * The loop over sky-positions has no branches, but calls log() for the Shapiro delay, so it is only
+ * vectorised by compilers which have a vector version of log() (e.g. from glibc's libmvec with
+ * -ffast-math); the rare case of a wave travelling through the interior of the Sun is handled in a
+ * separate loop.
+ */
+int
+XLALBarycenterSkyBlock ( REAL8 *deltaT,				/**< [out] \f$t_e - t_a\f$ for each sky-position */
+                         REAL8 *tDot,				/**< [out] \f$dt_e/dt_a\f$ for each sky-position */
+                         const BarycenterSkyCoeffs *coeffs,	/**< [in] sky-independent coefficients */
+                         const REAL8 *nx,			/**< [in] x-components of unit vectors to sources */
+                         const REAL8 *ny,			/**< [in] y-components of unit vectors to sources */
+                         const REAL8 *nz,			/**< [in] z-components of unit vectors to sources */
+                         UINT4 numSky				/**< [in] number of sky-positions */
+                         )
+{
+  XLAL_CHECK ( deltaT != NULL && tDot != NULL, XLAL_EINVAL, "Invalid input: deltaT == NULL or tDot == NULL");
+  XLAL_CHECK ( coeffs != NULL, XLAL_EINVAL, "Invalid input: coeffs == NULL");
+  XLAL_CHECK ( numSky == 0 || ( nx != NULL && ny != NULL && nz != NULL ), XLAL_EINVAL, "Invalid input: nx, ny or nz == NULL");
+
+  const REAL8 rsun = 2.322; /*radius of sun in sec */
+  const REAL8 AUbyC = LAL_AU_SI/LAL_C_SI;
+  const REAL8 c0 = coeffs->deltaT[0], c1 = coeffs->deltaT[1], c2 = coeffs->deltaT[2];
+  const REAL8 d0 = coeffs->tDot[0], d1 = coeffs->tDot[1], d2 = coeffs->tDot[2];
+  const REAL8 se0 = coeffs->se[0], se1 = coeffs->se[1], se2 = coeffs->se[2];
+  const REAL8 dse0 = coeffs->dse[0], dse1 = coeffs->dse[1], dse2 = coeffs->dse[2];
+  const REAL8 rse = coeffs->rse, drse = coeffs->drse;
+
+  /* usual expression for the Shapiro delay */
+  for ( UINT4 s = 0; s < numSky; s++ )
+    {
+      const REAL8 seDotN  = se0 * nx[s] + se1 * ny[s] + se2 * nz[s];
+      const REAL8 dseDotN = dse0 * nx[s] + dse1 * ny[s] + dse2 * nz[s];
+      const REAL8 shapiro = 9.852e-6 * log ( AUbyC / ( rse + seDotN ) );
+      const REAL8 dshapiro = -9.852e-6 * ( drse + dseDotN ) / ( rse + seDotN );
+      deltaT[s] = ( c0 * nx[s] + c1 * ny[s] + c2 * nz[s] ) + coeffs->deltaT0 - shapiro;
+      tDot[s] = coeffs->tDot0 + ( d0 * nx[s] + d1 * ny[s] + d2 * nz[s] ) - dshapiro;
+    }
+
+  /* if gw travels thru interior of Sun, replace Shapiro delay as in XLALBarycenterOpt() */
+  for ( UINT4 s = 0; s < numSky; s++ )
+    {
+      const REAL8 seDotN = se0 * nx[s] + se1 * ny[s] + se2 * nz[s];
+      if ( ( seDotN < 0 ) && ( rse * rse - seDotN * seDotN < rsun * rsun ) )
+        {
+          const REAL8 dseDotN = dse0 * nx[s] + dse1 * ny[s] + dse2 * nz[s];
+          const REAL8 b = sqrt ( rse * rse - seDotN * seDotN );
+          const REAL8 db = ( rse * drse - seDotN * dseDotN ) / b;
+          const REAL8 shapiro  = 9.852e-6 * log ( AUbyC / ( seDotN + sqrt ( rsun*rsun + seDotN*seDotN ) ) ) + 19.704e-6 * ( 1.0 - b / rsun );
+          const REAL8 dshapiro = - 19.704e-6 * db / rsun;
+          deltaT[s] = ( c0 * nx[s] + c1 * ny[s] + c2 * nz[s] ) + coeffs->deltaT0 - shapiro;
+          tDot[s] = coeffs->tDot0 + ( d0 * nx[s] + d1 * ny[s] + d2 * nz[s] ) - dshapiro;
+        }
+    }
+
+  return XLAL_SUCCESS;
+
+} /* XLALBarycenterSkyBlock() */
+
 /**
  * Function to calculate the precession matrix give Earth nutation values
  * depsilon and dpsi for a given MJD time.
@@ -1585,3 +1782,58 @@ void observatoryEarth( REAL8 obsEarth[3],     /**< [out] The x, y, z coordinates
   for ( j = 0; j < 3 ; j++ )
     obsEarth[j] = prn[j][0]*eeq[0] + prn[j][1]*eeq[1] + prn[j][2]*eeq[2];
 }
+
+
+/**
+ * Sines 'S' and cosines 'C' of the arguments of the terms of the Einstein delay at time 'tGPS';
+ * unless 'allCosines' is set, e.g. for rotating all terms, only the cosines used by einstein_delay_sum()
+ * are computed, i.e. those of the terms in deinsteinTerms, and the others are left unset
+ */
+static void
+einstein_delay_terms ( REAL8 *S, REAL8 *C, const LIGOTimeGPS *tGPS, BOOLEAN allCosines )
+{
+  /* see barycenter_earth() */
+  REAL8 jedtdt = -7300.5e0 + ((REAL8)tGPS->gpsSeconds + 51.184e0 + ((REAL8)tGPS->gpsNanoSeconds)*1.e-9)/8.64e4;
+  REAL8 jt=jedtdt/3.6525e5;
+
+  if ( allCosines )
+    {
+      for ( UINT4 k = 0; k < EINSTEIN_NUM_TERMS; k ++ )
+        {
+          const REAL8 arg = einsteinTerms[k][1]*jt + einsteinTerms[k][2];
+          S[k] = sin ( arg );
+          C[k] = cos ( arg );
+        }
+      return;
+    }
+
+  for ( UINT4 k = 0; k < EINSTEIN_NUM_TERMS; k ++ )
+    S[k] = sin ( einsteinTerms[k][1]*jt + einsteinTerms[k][2] );
+  for ( UINT4 l = 0; l < DEINSTEIN_NUM_TERMS; l ++ )
+    {
+      const UINT4 k = deinsteinTerms[l];
+      C[k] = cos ( einsteinTerms[k][1]*jt + einsteinTerms[k][2] );
+    }
+} /* einstein_delay_terms() */
+
+
+/** Einstein delay and its derivative from the sines 'S' and cosines 'C' of its terms */
+static void
+einstein_delay_sum ( EarthState *earth, const REAL8 *S, const REAL8 *C )
+{
+  REAL8 sum = 0, sum2 = 0, dsum = 0;
+  for ( UINT4 k = 0; k < EINSTEIN_NUM_TERMS_1ST; k ++ )
+    sum += einsteinTerms[k][0] * S[k];
+  for ( UINT4 k = EINSTEIN_NUM_TERMS_1ST; k < EINSTEIN_NUM_TERMS; k ++ )
+    sum2 += einsteinTerms[k][0] * S[k];
+  for ( UINT4 l = 0; l < DEINSTEIN_NUM_TERMS; l ++ )
+    {
+      const UINT4 k = deinsteinTerms[l];
+      dsum += einsteinTerms[k][0]*einsteinTerms[k][1] * C[k];
+    }
+
+  earth->einstein = 1.e-6*sum;
+  earth->einstein = earth->einstein + 1.e-6*sum2;
+  earth->deinstein = 1.e-6*dsum/(8.64e4*3.6525e5);
+
+} /* einstein_delay_sum() */
@@ -265,10 +265,31 @@ EmissionTime;
 /// internal (opaque) buffer type for optimized Barycentering function
 typedef struct tagBarycenterBuffer BarycenterBuffer;
 
+/**
+ * Sky-position independent part of XLALBarycenterOpt() at one arrival time and detector site,
+ * as computed by XLALBarycenterSkyCoeffs(). For a source in the direction of the unit vector
+ * \f$\hat{n}\f$, the emission time follows from these by a few dot products with \f$\hat{n}\f$
+ * and the Shapiro delay; see XLALBarycenterSkyBlock().
+ */
+typedef struct tagBarycenterSkyCoeffs
+{
+  REAL8 deltaT[3];      /**< Roemer delay plus Earth rotation delay (incl. precession and nutation) is deltaT . n */
+  REAL8 tDot[3];        /**< d(Roemer + Earth rotation delay)/d(tgps) is tDot . n */
+  REAL8 deltaT0;        /**< sky-independent delay: Einstein delay plus observatory term */
+  REAL8 tDot0;          /**< sky-independent part of tDot: 1 plus d(Einstein delay)/d(tgps) */
+  REAL8 se[3];          /**< vector from centre of Sun to centre of Earth, as in EarthState */
+  REAL8 dse[3];         /**< d(se)/d(tgps), as in EarthState */
+  REAL8 rse;            /**< length of se */
+  REAL8 drse;           /**< d(rse)/d(tgps) */
+}
+BarycenterSkyCoeffs;
+
 /* Function prototypes. */
 int XLALBarycenterEarth ( EarthState *earth, const LIGOTimeGPS *tGPS, const EphemerisData *edat);
 int XLALBarycenter ( EmissionTime *emit, const BarycenterInput *baryinput, const EarthState *earth);
 int XLALBarycenterOpt ( EmissionTime *emit, const BarycenterInput *baryinput, const EarthState *earth, BarycenterBuffer **buffer);
+int XLALBarycenterSkyCoeffs ( BarycenterSkyCoeffs *coeffs, const BarycenterInput *baryinput, const EarthState *earth );
+int XLALBarycenterSkyBlock ( REAL8 *deltaT, REAL8 *tDot, const BarycenterSkyCoeffs *coeffs, const REAL8 *nx, const REAL8 *ny, const REAL8 *nz, UINT4 numSky );
 
 /* Function that uses time delay look-up tables to calculate time delays */
 int XLALBarycenterEarthNew ( EarthState *earth,
@@ -277,6 +298,14 @@ int XLALBarycenterEarthNew ( EarthState *earth,
                              const TimeCorrectionData *tdat,
                              TimeCorrectionType ttype );
 
+/* Function that computes the Earth's state for a whole vector of arrival times */
+int XLALBarycenterEarthBatch ( EarthState *earth,
+                               const LIGOTimeGPS *tGPS,
+                               UINT4 numTimes,
+                               const EphemerisData *edat,
+                               const TimeCorrectionData *tdat,
+                               TimeCorrectionType ttype );
+
 /** @} */
 
 #ifdef  __cplusplus
@@ -18,6 +18,9 @@
 *  MA  02111-1307  USA
 */
 
+#include <sys/types.h>
+#include <sys/stat.h>
+
 #include <lal/FileIO.h>
 #include <lal/LALBarycenter.h>
 #include <lal/LALInitBarycenter.h>
@@ -25,6 +28,8 @@
 #include <lal/LALString.h>
 #include <lal/Date.h>
 
+#include "SharedMemoryCache_internal.h"
+
 /** \cond DONT_DOXYGEN */
 
 /* ----- defines and macros ---------- */
@@ -49,6 +54,23 @@ typedef struct
 }
 EphemerisVector;
 
+/**
+ * Header of a binary ephemeris-file written by XLALWriteBinaryEphemerisFile(), which is followed
+ * by the table of \a length PosVelAcc entries, in native byte-order.
+ */
+typedef struct
+{
+  CHAR magic[8];	/**< BINARY_EPHEMERIS_MAGIC */
+  UINT4 byteOrder;	/**< BINARY_EPHEMERIS_BYTEORDER, to detect files of different byte-order */
+  UINT4 length;		/**< number of ephemeris-data entries */
+  REAL8 dt;		/**< spacing in seconds between consecutive entries */
+}
+BinaryEphemerisHeader;
+
+#define BINARY_EPHEMERIS_MAGIC		"LALEPHB1"
+#define BINARY_EPHEMERIS_BYTEORDER	0x01020304
+#define BINARY_EPHEMERIS_EXT		".bin"
+
 /* ----- internal prototypes ---------- */
 EphemerisVector *XLALCreateEphemerisVector ( UINT4 length );
 void XLALDestroyEphemerisVector ( EphemerisVector *ephemV );
@@ -56,6 +78,16 @@ void XLALDestroyEphemerisVector ( EphemerisVector *ephemV );
 EphemerisVector * XLALReadEphemerisFile ( const CHAR *fname);
 int XLALCheckEphemerisRanges ( const EphemerisVector *ephemEarth, REAL8 avg[3], REAL8 range[3] );
 
+static EphemerisVector *read_ephemeris_file ( const CHAR *fname, BOOLEAN allowBinary );
+static char *resolve_ascii_ephemeris_file ( const CHAR *fname );
+static char *resolve_ephemeris_file ( const CHAR *fname );
+static char *binary_ephemeris_file_name ( const CHAR *fname );
+static BOOLEAN is_binary_ephemeris_file ( const CHAR *fname );
+static EphemerisVector *read_binary_ephemeris_file ( const CHAR *fname );
+static UINT8 ephemeris_cache_key ( const CHAR *earthEphemerisFile, const CHAR *sunEphemerisFile );
+static EphemerisData *attach_shared_ephemeris ( UINT8 key, const CHAR *earthEphemerisFile, const CHAR *sunEphemerisFile );
+static void publish_shared_ephemeris ( UINT8 key, const EphemerisData *edat );
+
 /* ----- function definitions ---------- */
 
 /* ========== exported API ========== */
@@ -192,6 +224,16 @@ XLALDestroyTimeCorrectionData ( TimeCorrectionData *tcd )
  * at that instant.  All in units of seconds; e.g. positions have
  * units of seconds, and accelerations have units 1/sec.
  *
+ * If a binary ephemeris-file written by XLALWriteBinaryEphemerisFile() is found alongside an ephemeris-file,
+ * i.e. <tt>&lt;fname&gt;.bin</tt> for <tt>&lt;fname&gt;[.gz]</tt>, it is read instead of parsing the ASCII table,
+ * unless the ASCII table is newer. A binary ephemeris-file may also be given directly.
+ *
+ * If the environment variable <tt>LALPULSAR_SHM_CACHE</tt> is set, the decoded ephemeris tables
+ * are cached in POSIX shared memory, in a segment whose name begins with the value of the variable:
+ * the first process to read a given pair of ephemeris files publishes them, and later processes
+ * on the same node (reading the same, unmodified files) attach to the tables read-only instead of
+ * reading the files again. If the cache cannot be used, the files are read as usual.
+ *
  * \ingroup LALBarycenter_h
  */
 EphemerisData *
@@ -240,6 +282,16 @@ XLALInitBarycenter ( const CHAR *earthEphemerisFile,         /**< File containin
   else
     etype = earth_etype;
 
+  /* attach to the tables in the shared-memory cache, if enabled and published by another process */
+  const UINT8 cacheKey = ephemeris_cache_key ( earthEphemerisFile, sunEphemerisFile );
+  if ( cacheKey != 0 )
+    {
+      EphemerisData *shared_edat = attach_shared_ephemeris ( cacheKey, earthEphemerisFile, sunEphemerisFile );
+      if ( shared_edat != NULL && shared_edat->etype == etype )
+        return shared_edat;
+      XLALDestroyEphemerisData ( shared_edat );
+    }
+
   EphemerisVector *ephemV;
   /* ----- read EARTH ephemeris file ---------- */
   if ( ( ephemV = XLALReadEphemerisFile ( earthEphemerisFile )) == NULL )
@@ -297,6 +349,10 @@ XLALInitBarycenter ( const CHAR *earthEphemerisFile,         /**< File containin
   edat->filenameE = XLALStringDuplicate( earthEphemerisFile );
   edat->filenameS = XLALStringDuplicate( sunEphemerisFile );
 
+  /* publish the tables in the shared-memory cache, if enabled */
+  if ( cacheKey != 0 )
+    publish_shared_ephemeris ( cacheKey, edat );
+
   /* return resulting ephemeris-data */
   return edat;
 
@@ -319,6 +375,13 @@ XLALDestroyEphemerisData ( EphemerisData *edat )
   if ( edat->filenameS )
     XLALFree ( edat->filenameS );
 
+  /* tables attached from the shared-memory cache are detached instead of freed */
+  if ( edat->ephemE && XLALSharedCacheContains ( edat->ephemE ) )
+    {
+      XLALSharedCacheDetach ( edat->ephemE );
+      edat->ephemE = edat->ephemS = NULL;
+    }
+
   if ( edat->ephemE )
     XLALFree ( edat->ephemE );
 
@@ -349,6 +412,9 @@ int XLALRestrictEphemerisData ( EphemerisData *edat, const LIGOTimeGPS *startGPS
   // Convert 'startGPS' and 'endGPS' to REAL8s
   const REAL8 start = XLALGPSGetREAL8(startGPS), end = XLALGPSGetREAL8(endGPS);
 
+  // Tables attached from the shared-memory cache are copied, and then detached instead of freed
+  const BOOLEAN shared = XLALSharedCacheContains(edat->ephemE);
+
   // Increase 'ephemE' and decrease 'nentriesE' to fit the range ['start', 'end']
   PosVelAcc *const old_ephemE = edat->ephemE;
   do {
@@ -367,7 +433,9 @@ int XLALRestrictEphemerisData ( EphemerisData *edat, const LIGOTimeGPS *startGPS
   XLAL_CHECK(new_ephemE != NULL, XLAL_ENOMEM);
   memcpy(new_ephemE, edat->ephemE, edat->nentriesE * sizeof(*new_ephemE));
   edat->ephemE = new_ephemE;
-  XLALFree(old_ephemE);
+  if (!shared) {
+    XLALFree(old_ephemE);
+  }
 
   // Increase 'ephemS' and decrease 'nentriesS' to fit the range ['start', 'end']
   PosVelAcc *const old_ephemS = edat->ephemS;
@@ -387,7 +455,11 @@ int XLALRestrictEphemerisData ( EphemerisData *edat, const LIGOTimeGPS *startGPS
   XLAL_CHECK(new_ephemS != NULL, XLAL_ENOMEM);
   memcpy(new_ephemS, edat->ephemS, edat->nentriesS * sizeof(*new_ephemS));
   edat->ephemS = new_ephemS;
-  XLALFree(old_ephemS);
+  if (!shared) {
+    XLALFree(old_ephemS);
+  } else {
+    XLALSharedCacheDetach(old_ephemE);
+  }
 
   return XLAL_SUCCESS;
 
@@ -451,32 +523,112 @@ XLALPulsarFileResolvePath ( const char *fname	  //!< [in] filename or file-path
  * NOTE: This function tries to read ephemeris from "<fname>" first, if that fails it also tries
  * to read "<fname>.gz" instead. This allows us to handle gzip-compressed ephemeris-files without having
  * to worry about the detailed filename extension used in the case of compression.
+ * If a binary ephemeris-file "<fname>.bin" (without any ".gz") exists, and is not older than the ASCII
+ * ephemeris-file, it is read instead.
  *
  * NOTE2: files are searches first locally, then in LAL_DATA_PATH, and finally in PKG_DATA_DIR
  * using XLALPulsarFileResolvePath()
  */
 EphemerisVector *
 XLALReadEphemerisFile ( const CHAR *fname )
+{
+  EphemerisVector *ephemV;
+  XLAL_CHECK_NULL ( (ephemV = read_ephemeris_file ( fname, 1 )) != NULL, XLAL_EFUNC );
+  return ephemV;
+} /* XLALReadEphemerisFile() */
+
+
+/**
+ * Convert an ASCII ephemeris-file <tt>fname[.gz]</tt> into a binary ephemeris-file \a binFname, which
+ * XLALInitBarycenter() reads much faster than the ASCII table. If \a binFname is NULL, the binary
+ * ephemeris-file is written alongside the ASCII ephemeris-file as <tt>&lt;fname&gt;.bin</tt>, where it
+ * is used automatically in place of the ASCII ephemeris-file.
+ *
+ * The binary ephemeris-file stores the decoded table in the native byte-order of the machine which
+ * writes it; on a machine of different byte-order it is rejected.
+ *
+ * \ingroup LALBarycenter_h
+ */
+int
+XLALWriteBinaryEphemerisFile ( const CHAR *binFname,	/**< [in] name of binary ephemeris-file to write, or NULL */
+                               const CHAR *fname	/**< [in] ASCII ephemeris-file to convert */
+                               )
+{
+  XLAL_CHECK ( fname != NULL, XLAL_EINVAL );
+
+  /* determine name of binary ephemeris-file */
+  char *out_fname = NULL;
+  if ( binFname != NULL )
+    {
+      XLAL_CHECK ( (out_fname = XLALStringDuplicate ( binFname )) != NULL, XLAL_EFUNC );
+    }
+  else
+    {
+      char *fname_path;
+      XLAL_CHECK ( (fname_path = resolve_ascii_ephemeris_file ( fname )) != NULL, XLAL_EINVAL, "Failed to find ephemeris-file '%s[.gz]'\n", fname );
+      out_fname = binary_ephemeris_file_name ( fname_path );
+      XLALFree ( fname_path );
+      XLAL_CHECK ( out_fname != NULL, XLAL_EFUNC );
+    }
+
+  /* read ASCII ephemeris-file */
+  EphemerisVector *ephemV;
+  if ( (ephemV = read_ephemeris_file ( fname, 0 )) == NULL )
+    {
+      XLALFree ( out_fname );
+      XLAL_ERROR ( XLAL_EFUNC );
+    }
+
+  /* write binary ephemeris-file */
+  BinaryEphemerisHeader XLAL_INIT_DECL(header);
+  memcpy ( header.magic, BINARY_EPHEMERIS_MAGIC, sizeof(header.magic) );
+  header.byteOrder = BINARY_EPHEMERIS_BYTEORDER;
+  header.length = ephemV->length;
+  header.dt = ephemV->dt;
+  FILE *fp = fopen ( out_fname, "wb" );
+  int errnum = XLAL_SUCCESS;
+  if ( fp == NULL
+       || fwrite ( &header, sizeof(header), 1, fp ) != 1
+       || fwrite ( ephemV->data, sizeof(ephemV->data[0]), ephemV->length, fp ) != ephemV->length )
+    errnum = XLAL_EIO;
+  if ( fp != NULL && fclose ( fp ) != 0 )
+    errnum = XLAL_EIO;
+  XLALDestroyEphemerisVector ( ephemV );
+  if ( errnum != XLAL_SUCCESS )
+    {
+      XLALPrintError ( "%s: failed to write binary ephemeris-file '%s'\n", __func__, out_fname );
+      XLALFree ( out_fname );
+      XLAL_ERROR ( errnum );
+    }
+
+  XLALFree ( out_fname );
+
+  return XLAL_SUCCESS;
+
+} /* XLALWriteBinaryEphemerisFile() */
+
+
+/**
+ * Read ephemeris-data from one file, for XLALReadEphemerisFile(); if \a allowBinary is false, only
+ * ASCII ephemeris-files are considered.
+ */
+static EphemerisVector *
+read_ephemeris_file ( const CHAR *fname, BOOLEAN allowBinary )
 {
   /* check input consistency */
   XLAL_CHECK_NULL ( fname != NULL, XLAL_EINVAL );
 
-  char *fname_path = NULL;
+  char *fname_path;
+  XLAL_CHECK_NULL ( (fname_path = ( allowBinary ? resolve_ephemeris_file ( fname ) : resolve_ascii_ephemeris_file ( fname ) )) != NULL, XLAL_EINVAL, "Failed to find ephemeris-file '%s[.gz]'\n", fname );
 
-  // first check if "<fname>" can be resolved ...
-  if ( (fname_path = XLALPulsarFileResolvePath ( fname )) == NULL )
+  // read a binary ephemeris-file
+  if ( is_binary_ephemeris_file ( fname_path ) )
     {
-      // if not, check if we can find "<fname>.gz" instead ...
-      char *fname_gz;
-      XLAL_CHECK_NULL ( (fname_gz = XLALMalloc ( strlen(fname) + strlen(".gz") + 1 )) != NULL, XLAL_ENOMEM );
-      sprintf ( fname_gz, "%s.gz", fname );
-      if ( (fname_path = XLALPulsarFileResolvePath ( fname_gz )) == NULL )
-        {
-          XLALFree ( fname_gz );
-          XLAL_ERROR_NULL ( XLAL_EINVAL, "Failed to find ephemeris-file '%s[.gz]'\n", fname );
-        } // if 'fname_gz' could not be resolved
-      XLALFree ( fname_gz );
-    } // if 'fname' couldn't be resolved
+      EphemerisVector *ephemV = read_binary_ephemeris_file ( fname_path );
+      XLALFree ( fname_path );
+      XLAL_CHECK_NULL ( ephemV != NULL, XLAL_EFUNC, "Failed to read binary ephemeris-file for '%s'\n", fname );
+      return ephemV;
+    }
 
   // if we're here, it means we found it
 
@@ -594,7 +746,7 @@ XLALReadEphemerisFile ( const CHAR *fname )
   /* return result */
   return ephemV;
 
-} /* XLALReadEphemerisFile() */
+} /* read_ephemeris_file() */
 
 
 /**
@@ -648,3 +800,221 @@ XLALCheckEphemerisRanges ( const EphemerisVector *ephemV, REAL8 avg[3], REAL8 ra
   return XLAL_SUCCESS;
 
 } /* XLALCheckEphemerisRanges() */
+
+/** Resolve the path to ASCII ephemeris-file "<fname>", or else "<fname>.gz"; returns NULL if neither can be found. */
+static char *
+resolve_ascii_ephemeris_file ( const CHAR *fname )
+{
+  char *fname_path;
+
+  // first check if "<fname>" can be resolved ...
+  if ( (fname_path = XLALPulsarFileResolvePath ( fname )) == NULL )
+    {
+      // if not, check if we can find "<fname>.gz" instead ...
+      char *fname_gz;
+      if ( (fname_gz = XLALMalloc ( strlen(fname) + strlen(".gz") + 1 )) == NULL )
+        return NULL;
+      sprintf ( fname_gz, "%s.gz", fname );
+      fname_path = XLALPulsarFileResolvePath ( fname_gz );
+      XLALFree ( fname_gz );
+    } // if 'fname' couldn't be resolved
+
+  return fname_path;
+
+} // resolve_ascii_ephemeris_file()
+
+/**
+ * Resolve the path to the ephemeris-file to read for "<fname>": the binary ephemeris-file "<fname>.bin"
+ * if it exists and is not older than the ASCII ephemeris-file, or else the ASCII ephemeris-file.
+ */
+static char *
+resolve_ephemeris_file ( const CHAR *fname )
+{
+  char *ascii_path = NULL, *bin_fname, *bin_path = NULL;
+
+  if ( is_binary_ephemeris_file ( fname ) )
+    return XLALPulsarFileResolvePath ( fname );
+
+  ascii_path = resolve_ascii_ephemeris_file ( fname );
+  if ( (bin_fname = binary_ephemeris_file_name ( fname )) != NULL )
+    {
+      bin_path = XLALPulsarFileResolvePath ( bin_fname );
+      XLALFree ( bin_fname );
+    }
+  if ( bin_path == NULL )
+    return ascii_path;
+
+  // ignore a binary ephemeris-file which is older than the ASCII ephemeris-file
+  struct stat ascii_st, bin_st;
+  if ( ascii_path != NULL && stat ( ascii_path, &ascii_st ) == 0 && stat ( bin_path, &bin_st ) == 0 && ascii_st.st_mtime > bin_st.st_mtime )
+    {
+      XLALPrintWarning ( "%s: ignoring binary ephemeris-file '%s', which is older than '%s'\n", __func__, bin_path, ascii_path );
+      XLALFree ( bin_path );
+      return ascii_path;
+    }
+
+  XLALFree ( ascii_path );
+  return bin_path;
+
+} // resolve_ephemeris_file()
+
+/** Return the name "<fname>.bin" of the binary ephemeris-file for "<fname>[.gz]" */
+static char *
+binary_ephemeris_file_name ( const CHAR *fname )
+{
+  size_t len = strlen ( fname );
+  if ( len >= 3 && strcmp ( fname + len - 3, ".gz" ) == 0 )
+    len -= 3;
+
+  char *bin_fname;
+  XLAL_CHECK_NULL ( (bin_fname = XLALMalloc ( len + strlen ( BINARY_EPHEMERIS_EXT ) + 1 )) != NULL, XLAL_ENOMEM );
+  memcpy ( bin_fname, fname, len );
+  strcpy ( bin_fname + len, BINARY_EPHEMERIS_EXT );
+
+  return bin_fname;
+
+} // binary_ephemeris_file_name()
+
+/** Return true if "<fname>" is the name of a binary ephemeris-file */
+static BOOLEAN
+is_binary_ephemeris_file ( const CHAR *fname )
+{
+  const size_t len = strlen ( fname ), extlen = strlen ( BINARY_EPHEMERIS_EXT );
+  return len > extlen && strcmp ( fname + len - extlen, BINARY_EPHEMERIS_EXT ) == 0;
+} // is_binary_ephemeris_file()
+
+/** Read a binary ephemeris-file written by XLALWriteBinaryEphemerisFile() */
+static EphemerisVector *
+read_binary_ephemeris_file ( const CHAR *fname )
+{
+  FILE *fp;
+  XLAL_CHECK_NULL ( (fp = fopen ( fname, "rb" )) != NULL, XLAL_EIO, "Failed to open binary ephemeris-file '%s'\n", fname );
+
+  // read and check header
+  BinaryEphemerisHeader header;
+  if ( fread ( &header, sizeof(header), 1, fp ) != 1 )
+    {
+      fclose ( fp );
+      XLAL_ERROR_NULL ( XLAL_EIO, "Failed to read header of binary ephemeris-file '%s'\n", fname );
+    }
+  if ( memcmp ( header.magic, BINARY_EPHEMERIS_MAGIC, sizeof(header.magic) ) != 0 || header.byteOrder != BINARY_EPHEMERIS_BYTEORDER
+       || header.length == 0 || !( header.dt > 0 ) )
+    {
+      fclose ( fp );
+      XLAL_ERROR_NULL ( XLAL_EIO, "Invalid header in binary ephemeris-file '%s' (or file has different byte-order)\n", fname );
+    }
+
+  // read table
+  EphemerisVector *ephemV;
+  if ( (ephemV = XLALCreateEphemerisVector ( header.length )) == NULL )
+    {
+      fclose ( fp );
+      XLAL_ERROR_NULL ( XLAL_EFUNC );
+    }
+  ephemV->dt = header.dt;
+  char extra;
+  if ( fread ( ephemV->data, sizeof(ephemV->data[0]), header.length, fp ) != header.length || fread ( &extra, 1, 1, fp ) != 0 )
+    {
+      fclose ( fp );
+      XLALDestroyEphemerisVector ( ephemV );
+      XLAL_ERROR_NULL ( XLAL_EIO, "Binary ephemeris-file '%s' has wrong length\n", fname );
+    }
+  fclose ( fp );
+
+  return ephemV;
+
+} // read_binary_ephemeris_file()
+
+/** Header of ephemeris tables in the shared-memory cache; followed by the earth and sun tables */
+typedef struct {
+  INT4 nentriesE;
+  INT4 nentriesS;
+  REAL8 dtEtable;
+  REAL8 dtStable;
+  INT4 etype;
+  INT4 padding;
+} EphemerisCacheHeader;
+
+/**
+ * Return the shared-memory cache key of the pair of ephemeris-files, which depends on the files
+ * actually read, and their sizes and modification times; returns 0 if the cache is disabled.
+ */
+static UINT8
+ephemeris_cache_key ( const CHAR *earthEphemerisFile, const CHAR *sunEphemerisFile )
+{
+  if ( !XLALSharedCacheEnabled() )
+    return 0;
+
+  UINT8 key = SHARED_CACHE_KEY_INIT;
+  const CHAR *files[2] = { earthEphemerisFile, sunEphemerisFile };
+  for ( UINT4 i = 0; i < 2 && key != 0; i ++ )
+    {
+      char *fname_path = resolve_ephemeris_file ( files[i] );
+      key = XLALSharedCacheHashFile ( key, fname_path );
+      XLALFree ( fname_path );
+    }
+
+  return key;
+
+} // ephemeris_cache_key()
+
+/** Attach to ephemeris tables in the shared-memory cache; returns NULL, without raising an error, if they have not been published. */
+static EphemerisData *
+attach_shared_ephemeris ( UINT8 key, const CHAR *earthEphemerisFile, const CHAR *sunEphemerisFile )
+{
+  size_t size = 0;
+  char *data = XLALSharedCacheAttach ( "ephem", key, 0, &size );
+  if ( data == NULL )
+    return NULL;
+
+  // check size of tables against header
+  const EphemerisCacheHeader *header = (const EphemerisCacheHeader *) data;
+  if ( size < sizeof(*header) || header->nentriesE <= 0 || header->nentriesS <= 0
+       || size != sizeof(*header) + ( (size_t) header->nentriesE + (size_t) header->nentriesS ) * sizeof(PosVelAcc) )
+    {
+      XLALSharedCacheDetach ( data );
+      return NULL;
+    }
+
+  EphemerisData *edat;
+  if ( (edat = XLALCalloc ( 1, sizeof(*edat) ) ) == NULL )
+    {
+      XLALSharedCacheDetach ( data );
+      return NULL;
+    }
+  edat->nentriesE = header->nentriesE;
+  edat->nentriesS = header->nentriesS;
+  edat->dtEtable  = header->dtEtable;
+  edat->dtStable  = header->dtStable;
+  edat->etype     = header->etype;
+  edat->ephemE    = (PosVelAcc *) ( data + sizeof(*header) );
+  edat->ephemS    = edat->ephemE + edat->nentriesE;
+  edat->filenameE = XLALStringDuplicate ( earthEphemerisFile );
+  edat->filenameS = XLALStringDuplicate ( sunEphemerisFile );
+  if ( edat->filenameE == NULL || edat->filenameS == NULL )
+    {
+      XLALDestroyEphemerisData ( edat );
+      return NULL;
+    }
+
+  return edat;
+
+} // attach_shared_ephemeris()
+
+/** Publish ephemeris tables in the shared-memory cache; failure is not an error. */
+static void
+publish_shared_ephemeris ( UINT8 key, const EphemerisData *edat )
+{
+  EphemerisCacheHeader header;
+  memset ( &header, 0, sizeof(header) );
+  header.nentriesE = edat->nentriesE;
+  header.nentriesS = edat->nentriesS;
+  header.dtEtable  = edat->dtEtable;
+  header.dtStable  = edat->dtStable;
+  header.etype     = edat->etype;
+
+  const void *parts[3] = { &header, edat->ephemE, edat->ephemS };
+  const size_t sizes[3] = { sizeof(header), edat->nentriesE * sizeof(PosVelAcc), edat->nentriesS * sizeof(PosVelAcc) };
+  XLALSharedCachePublish ( "ephem", key, parts, sizes, 3 );
+
+} // publish_shared_ephemeris()
@@ -34,6 +34,8 @@ void XLALDestroyEphemerisData ( EphemerisData *edat );
 
 int XLALRestrictEphemerisData ( EphemerisData *edat, const LIGOTimeGPS *startGPS, const LIGOTimeGPS *endGPS );
 
+int XLALWriteBinaryEphemerisFile ( const CHAR *binFname, const CHAR *fname );
+
 TimeCorrectionData *XLALInitTimeCorrections ( const CHAR *timeCorrectionFile );
 void XLALDestroyTimeCorrectionData( TimeCorrectionData *tcd );
 
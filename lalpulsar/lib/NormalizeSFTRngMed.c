@@ -18,8 +18,20 @@
 *  MA  02111-1307  USA
 */
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <lal/NormalizeSFTRngMed.h>
 
+#include "SharedMemoryCache_internal.h"
+
+#ifdef __GNUC__
+#define UNUSED __attribute__ ((unused))
+#else
+#define UNUSED
+#endif
+
 /**
  * \addtogroup NormalizeSFTRngMed_h
  * \author Badri Krishnan and Alicia Sintes
@@ -49,6 +61,7 @@
  * XLALNormalizeSFT ()
  * XLALNormalizeSFTVect ()
  * XLALNormalizeMultiSFTVect ()
+ * XLALLoadNormalizedMultiSFTs ()
  * \endcode
  *
  * The function XLALNormalizeSFTVect() takes as input a vector of SFTs and normalizes
@@ -57,7 +70,8 @@
  * XLALPeriodoToRngmed () which applies the running median algorithm to find a vector
  * of medians.  The function XLALNormalizeMultiSFTVect() normalizes a multi-IFO collection
  * of SFT vectors and also returns a collection of power-estimates for these vectors using
- * the Running median method.
+ * the Running median method.  The function XLALLoadNormalizedMultiSFTs() loads a multi-IFO
+ * collection of SFTs from an SFT catalog and normalizes each SFT as soon as it is read.
  *
  */
 
@@ -155,9 +169,73 @@ XLALNormalizeSFTVect ( SFTVector  *sftVect,		/**< [in/out] pointer to a vector o
 } /* XLALNormalizeSFTVect() */
 
 
+/* allocate a multi PSD-vector holding headers of 'numSFTs[X]' PSDs for each IFO X; the PSD data is allocated by normalize_SFT() */
+static MultiPSDVector *
+create_MultiPSDVector_headers ( const UINT4 numIFOs, const UINT4 *numSFTs )
+{
+  MultiPSDVector *multiPSD;
+  XLAL_CHECK_NULL ( ( multiPSD = XLALCalloc (1, sizeof(*multiPSD))) != NULL, XLAL_ENOMEM, "Failed to XLALCalloc(1, sizeof(*multiPSD))");
+
+  multiPSD->length = numIFOs;
+  if ( ( multiPSD->data = XLALCalloc ( numIFOs, sizeof(*multiPSD->data))) == NULL )
+    {
+      XLALDestroyMultiPSDVector ( multiPSD );
+      XLAL_ERROR_NULL ( XLAL_ENOMEM, "Failed to XLALCalloc ( %d, %zu)", numIFOs, sizeof(*multiPSD->data) );
+    }
+
+  for ( UINT4 X = 0; X < numIFOs; X++ )
+    {
+      if ( (multiPSD->data[X] = XLALCalloc(1, sizeof(*multiPSD->data[X]))) == NULL
+           || (multiPSD->data[X]->data = XLALCalloc ( numSFTs[X], sizeof(*(multiPSD->data[X]->data)))) == NULL )
+        {
+          XLALDestroyMultiPSDVector ( multiPSD );
+          XLAL_ERROR_NULL ( XLAL_ENOMEM, "Failed to XLALCalloc ( %d, %zu)", numSFTs[X], sizeof(*(multiPSD->data[X]->data)) );
+        }
+      multiPSD->data[X]->length = numSFTs[X];
+    }
+
+  return multiPSD;
+
+} /* create_MultiPSDVector_headers() */
+
+
+/* allocate the PSD data for a single SFT, and normalize the SFT; may be called concurrently for different SFTs */
+static int
+normalize_SFT ( REAL8FrequencySeries *psd, SFTtype *sft, UINT4 blockSize, const REAL8 assumeSqrtS )
+{
+  XLAL_CHECK ( (psd->data = XLALCreateREAL8Vector ( sft->data->length ) ) != NULL, XLAL_EFUNC, "XLALCreateREAL8Vector(%d) failed.", sft->data->length );
+  XLAL_CHECK ( XLALNormalizeSFT ( psd, sft, blockSize, assumeSqrtS ) == XLAL_SUCCESS, XLAL_EFUNC, "XLALNormalizeSFT() failed" );
+  return XLAL_SUCCESS;
+} /* normalize_SFT() */
+
+
+/* number of threads with which to process 'numTasks' SFTs, each needing 'taskMemory' bytes of temporary memory, within a budget of 'maxMemory' bytes (0 = unlimited) */
+static UINT4
+get_num_SFT_threads ( const UINT4 numTasks, const size_t taskMemory, const size_t maxMemory )
+{
+  UINT4 numThreads = 1;
+#ifdef _OPENMP
+  numThreads = omp_get_max_threads();
+#endif
+  if ( maxMemory > 0 && taskMemory > 0 && numThreads > maxMemory / taskMemory ) {
+    numThreads = maxMemory / taskMemory;
+  }
+  if ( numThreads > numTasks ) {
+    numThreads = numTasks;
+  }
+  if ( numThreads < 1 ) {
+    numThreads = 1;
+  }
+  return numThreads;
+} /* get_num_SFT_threads() */
+
+
 /**
  * Function for normalizing a multi vector of SFTs in a multi IFO search and
  * returns the running-median estimates of the power.
+ *
+ * If LAL was compiled with OpenMP support, the SFTs of all IFOs are shared between the threads
+ * of an OpenMP thread pool.
  */
 MultiPSDVector *
 XLALNormalizeMultiSFTVect ( MultiSFTVector *multsft,		/**< [in/out] multi-vector of SFTs which will be normalized */
@@ -169,46 +247,348 @@ XLALNormalizeMultiSFTVect ( MultiSFTVector *multsft,		/**< [in/out] multi-vector
   XLAL_CHECK_NULL ( multsft && multsft->data && multsft->length > 0, XLAL_EINVAL, "Invalid NULL or zero-length input 'multsft'");
   XLAL_CHECK_NULL ( assumeSqrtSX == NULL || assumeSqrtSX->length == multsft->length, XLAL_EINVAL );
 
+  UINT4 numifo = multsft->length;
+  UINT4 numSFTs[PULSAR_MAX_DETECTORS];
+  XLAL_CHECK_NULL ( numifo <= PULSAR_MAX_DETECTORS, XLAL_EINVAL, "Number of IFOs (%d) exceeds maximum (%d)", numifo, PULSAR_MAX_DETECTORS );
+
+  /* count SFTs over all ifos, and the largest SFT length */
+  UINT4 numTasks = 0;
+  UINT4 maxlengthsft = 0;
+  for ( UINT4 X = 0; X < numifo; X++ )
+    {
+      numSFTs[X] = multsft->data[X]->length;
+      numTasks += numSFTs[X];
+      for ( UINT4 j = 0; j < numSFTs[X]; j++ )
+        {
+          XLAL_CHECK_NULL ( multsft->data[X]->data[j].data != NULL, XLAL_EINVAL, "Invalid NULL data in SFT %d of IFO %d", j, X );
+          if ( multsft->data[X]->data[j].data->length > maxlengthsft ) {
+            maxlengthsft = multsft->data[X]->data[j].data->length;
+          }
+        }
+    }
+
   /* allocate multipsd structure */
   MultiPSDVector *multiPSD;
-  XLAL_CHECK_NULL ( ( multiPSD = XLALCalloc (1, sizeof(*multiPSD))) != NULL, XLAL_ENOMEM, "Failed to XLALCalloc(1, sizeof(*multiPSD))");
+  XLAL_CHECK_NULL ( ( multiPSD = create_MultiPSDVector_headers ( numifo, numSFTs ) ) != NULL, XLAL_EFUNC );
 
-  UINT4 numifo = multsft->length;
-  multiPSD->length = numifo;
-  XLAL_CHECK_NULL ( ( multiPSD->data = XLALCalloc ( numifo, sizeof(*multiPSD->data))) != NULL, XLAL_ENOMEM, "Failed to XLALCalloc ( %d, %zu)", numifo, sizeof(*multiPSD->data) );
+  /* loop over sfts of all ifos; each thread needs a periodogram as temporary memory */
+  UNUSED const UINT4 numThreads = get_num_SFT_threads ( numTasks, maxlengthsft * sizeof(REAL8), 0 );
+  int errors = 0;
+#pragma omp parallel for schedule(dynamic) num_threads(numThreads) reduction(+:errors)
+  for ( INT4 k = 0; k < (INT4) numTasks; k++ )
+    {
+      UINT4 X = 0, j = k;
+      while ( j >= numSFTs[X] ) {
+        j -= numSFTs[X++];
+      }
 
-  /* loop over ifos */
-  for ( UINT4 X = 0; X < numifo; X++ )
+      /* if assumeSqrtSX is not given, pass 0.0 to calculate PSD from running median */
+      const REAL8 assumeSqrtS = (assumeSqrtSX != NULL) ? assumeSqrtSX->sqrtSn[X] : 0.0;
+
+      if ( normalize_SFT ( &multiPSD->data[X]->data[j], &multsft->data[X]->data[j], blockSize, assumeSqrtS ) != XLAL_SUCCESS ) {
+        ++errors;
+      }
+
+    } /* for k < numTasks */
+
+  if ( errors > 0 )
     {
-      UINT4 numsft = multsft->data[X]->length;
+      XLALDestroyMultiPSDVector ( multiPSD );
+      XLAL_ERROR_NULL ( XLAL_EFUNC, "Normalization failed for %d SFTs", errors );
+    }
+
+  return multiPSD;
 
-      /* allocation of psd vector over SFTs for this detector X */
-      XLAL_CHECK_NULL ( (multiPSD->data[X] = XLALCalloc(1, sizeof(*multiPSD->data[X]))) != NULL, XLAL_ENOMEM, "Failed to XLALCalloc(1, %zu)", sizeof(*multiPSD->data[X]));
+} /* XLALNormalizeMultiSFTVect() */
 
-      multiPSD->data[X]->length = numsft;
-      XLAL_CHECK_NULL ( (multiPSD->data[X]->data = XLALCalloc ( numsft, sizeof(*(multiPSD->data[X]->data)))) != NULL, XLAL_ENOMEM, "Failed to XLALCalloc ( %d, %zu)", numsft, sizeof(*(multiPSD->data[X]->data)) );
 
-      /* loop over sfts for this IFO X */
-      for ( UINT4 j = 0; j < numsft; j++ )
+/* load the SFTs of a catalog through the shared-memory cache with XLALLoadMultiSFTsMapped(), and
+ * normalize private copies of them, so that the shared band is only ever read */
+static int
+load_normalized_shared_SFTs ( MultiSFTVector **multiSFTs, MultiPSDVector **multiPSD, const SFTCatalog *catalog,
+                              REAL8 fMin, REAL8 fMax, UINT4 blockSize, const MultiNoiseFloor *assumeSqrtSX, const size_t maxMemory )
+{
+  MappedMultiSFTVector *raw;
+  XLAL_CHECK ( ( raw = XLALLoadMultiSFTsMapped ( catalog, fMin, fMax ) ) != NULL, XLAL_EFUNC );
+  const MultiSFTVector *rawSFTs = raw->multiSFTs;
+  const UINT4 numifo = rawSFTs->length;
+
+  MultiSFTVector *SFTs = NULL;
+  MultiPSDVector *PSDs = NULL;
+
+#define LOADSHAREDERROR(eno, ...) do {		\
+    XLALDestroyMultiSFTVector ( SFTs );		\
+    XLALDestroyMultiPSDVector ( PSDs );		\
+    XLALDestroyMappedMultiSFTVector ( raw );	\
+    XLAL_ERROR ( eno, __VA_ARGS__ );		\
+  } while(0)
+
+  if ( numifo > PULSAR_MAX_DETECTORS ) {
+    LOADSHAREDERROR ( XLAL_EINVAL, "Number of IFOs (%d) exceeds maximum (%d)", numifo, PULSAR_MAX_DETECTORS );
+  }
+  if ( assumeSqrtSX != NULL && assumeSqrtSX->length != numifo ) {
+    LOADSHAREDERROR ( XLAL_EINVAL, "Number of IFOs in 'assumeSqrtSX' (%d) differs from SFT catalog (%d)", assumeSqrtSX->length, numifo );
+  }
+
+  /* one task per SFT; temporary memory is the periodogram for the running median */
+  UINT4 numSFTs[PULSAR_MAX_DETECTORS];
+  UINT4 numTasks = 0;
+  size_t taskMemory = 0;
+  for ( UINT4 X = 0; X < numifo; X++ )
+    {
+      numSFTs[X] = rawSFTs->data[X]->length;
+      numTasks += numSFTs[X];
+      for ( UINT4 j = 0; j < numSFTs[X]; j++ )
         {
-          SFTtype *sft = &multsft->data[X]->data[j];
+          const size_t memSFT = rawSFTs->data[X]->data[j].data->length * sizeof(REAL8);
+          if ( memSFT > taskMemory ) {
+            taskMemory = memSFT;
+          }
+        }
+    }
+
+  /* allocate output structures; SFT data is filled in by the copied SFTs */
+  if ( ( SFTs = XLALCalloc ( 1, sizeof(*SFTs) ) ) == NULL || ( SFTs->data = XLALCalloc ( numifo, sizeof(SFTs->data[0]) ) ) == NULL ) {
+    LOADSHAREDERROR ( XLAL_ENOMEM, "Failed to allocate multi SFT vector" );
+  }
+  SFTs->length = numifo;
+  for ( UINT4 X = 0; X < numifo; X++ )
+    {
+      if ( ( SFTs->data[X] = XLALCreateSFTVector ( numSFTs[X], 0 ) ) == NULL ) {
+        LOADSHAREDERROR ( XLAL_EFUNC, "XLALCreateSFTVector ( %d, 0 ) failed.", numSFTs[X] );
+      }
+    }
+  if ( ( PSDs = create_MultiPSDVector_headers ( numifo, numSFTs ) ) == NULL ) {
+    LOADSHAREDERROR ( XLAL_EFUNC, "create_MultiPSDVector_headers() failed" );
+  }
+
+  /* copy and normalize SFTs */
+  UNUSED const UINT4 numThreads = get_num_SFT_threads ( numTasks, taskMemory, maxMemory );
+  int errors = 0;
+#pragma omp parallel for schedule(dynamic) num_threads(numThreads) reduction(+:errors)
+  for ( INT4 k = 0; k < (INT4) numTasks; k++ )
+    {
+      UINT4 X = 0, j = k;
+      while ( j >= numSFTs[X] ) {
+        j -= numSFTs[X++];
+      }
+
+      if ( XLALCopySFT ( &SFTs->data[X]->data[j], &rawSFTs->data[X]->data[j] ) != XLAL_SUCCESS ) {
+        ++errors;
+        continue;
+      }
+
+      /* if assumeSqrtSX is not given, pass 0.0 to calculate PSD from running median */
+      const REAL8 assumeSqrtS = (assumeSqrtSX != NULL) ? assumeSqrtSX->sqrtSn[X] : 0.0;
 
-          /* memory allocation of psd vector for this SFT */
-          UINT4 lengthsft = sft->data->length;
-          XLAL_CHECK_NULL ( (multiPSD->data[X]->data[j].data = XLALCreateREAL8Vector ( lengthsft ) ) != NULL, XLAL_EFUNC, "XLALCreateREAL8Vector(%d) failed.", lengthsft );
+      if ( normalize_SFT ( &PSDs->data[X]->data[j], &SFTs->data[X]->data[j], blockSize, assumeSqrtS ) != XLAL_SUCCESS ) {
+        ++errors;
+      }
+
+    } /* for k < numTasks */
+
+  if ( errors > 0 ) {
+    LOADSHAREDERROR ( XLAL_EFUNC, "Copying or normalization failed for %d SFTs", errors );
+  }
+
+#undef LOADSHAREDERROR
+
+  /* detach from the shared band, and return */
+  XLALDestroyMappedMultiSFTVector ( raw );
+  (*multiSFTs) = SFTs;
+  if ( multiPSD != NULL ) {
+    (*multiPSD) = PSDs;
+  } else {
+    XLALDestroyMultiPSDVector ( PSDs );
+  }
+
+  return XLAL_SUCCESS;
 
-          /* if assumeSqrtSX is not given, pass 0.0 to calculate PSD from running median */
-          const REAL8 assumeSqrtS = (assumeSqrtSX != NULL) ? assumeSqrtSX->sqrtSn[X] : 0.0;
+} /* load_normalized_shared_SFTs() */
 
-          XLAL_CHECK_NULL( XLALNormalizeSFT ( &multiPSD->data[X]->data[j], sft, blockSize, assumeSqrtS ) == XLAL_SUCCESS, XLAL_EFUNC, "XLALNormalizeSFT() failed");
 
-        } /* for j < numsft */
+/**
+ * Load a catalog of SFTs from possibly different detectors, as XLALLoadMultiSFTs() does, and
+ * normalize them, as XLALNormalizeMultiSFTVect() does, returning the loaded and normalized
+ * SFTs in \a multiSFTs and the running-median estimates of the power in \a multiPSD.
+ *
+ * Instead of loading all SFTs before normalizing them, each SFT (possibly put together from
+ * several SFT segments) is read and normalized in turn; if LAL was compiled with OpenMP support,
+ * the SFTs of all IFOs are shared between the threads of an OpenMP thread pool.  Each thread
+ * needs temporary memory of about 16 bytes per SFT frequency bin for reading and normalizing
+ * an SFT, i.e. a COMPLEX8 read buffer and a REAL8 periodogram for the running median; if \a maxMemory is nonzero, the number of threads is reduced so that the temporary
+ * memory of all threads stays within \a maxMemory bytes.  The memory for the returned SFTs and
+ * PSDs is not counted against \a maxMemory.
+ *
+ * If the shared-memory cache is enabled (see XLALLoadMultiSFTsMapped()), the SFTs are instead loaded
+ * through the cache, so that processes on the same node share one copy of the raw band, and
+ * each SFT is copied from it before being normalized; each thread then needs only the 8 bytes
+ * per bin of the periodogram as temporary memory.
+ *
+ * The results are identical to calling XLALLoadMultiSFTs() followed by XLALNormalizeMultiSFTVect().
+ */
+int
+XLALLoadNormalizedMultiSFTs ( MultiSFTVector **multiSFTs,		/**< [out] multi-vector of loaded and normalized SFTs */
+                              MultiPSDVector **multiPSD,		/**< [out] running-median estimates of the power; may be NULL if not required */
+                              const SFTCatalog *catalog,		/**< [in] The 'catalogue' of SFTs to load */
+                              REAL8 fMin,				/**< [in] minumum requested frequency (-1 = read from lowest) */
+                              REAL8 fMax,				/**< [in] maximum requested frequency (-1 = read up to highest) */
+                              UINT4 blockSize,			/**< [in] Running median window size */
+                              const MultiNoiseFloor *assumeSqrtSX,	/**< [in] If !NULL, instead assume sqrt(S^X) values *instead* of calculating PSD from running median */
+                              const size_t maxMemory			/**< [in] Maximum temporary memory in bytes shared by all threads (0 = unlimited) */
+                              )
+{
+  /* check input argments */
+  XLAL_CHECK ( multiSFTs != NULL && (*multiSFTs) == NULL, XLAL_EINVAL );
+  XLAL_CHECK ( multiPSD == NULL || (*multiPSD) == NULL, XLAL_EINVAL );
+  XLAL_CHECK ( catalog != NULL && catalog->length > 0, XLAL_EINVAL, "Invalid NULL or empty input 'catalog'" );
+
+  /* share the raw band with other processes, if enabled */
+  if ( XLALSharedCacheEnabled() ) {
+    XLAL_CHECK ( load_normalized_shared_SFTs ( multiSFTs, multiPSD, catalog, fMin, fMax, blockSize, assumeSqrtSX, maxMemory ) == XLAL_SUCCESS, XLAL_EFUNC );
+    return XLAL_SUCCESS;
+  }
+
+  /* get the (alphabetically-sorted!) multiSFTCatalogView */
+  MultiSFTCatalogView *view;
+  XLAL_CHECK ( ( view = XLALGetMultiSFTCatalogView ( catalog ) ) != NULL, XLAL_EFUNC );
+  const UINT4 numifo = view->length;
+
+  /* one task per SFT, i.e. per different GPS timestamp: record its IFO and its segments in the (GPS-sorted) catalog of that IFO */
+  typedef struct { UINT4 X; UINT4 j; UINT4 catStart; UINT4 catLength; } LoadSFTTask;
+  LoadSFTTask *tasks = NULL;
+  UINT4 numTasks = 0;
+  UINT4 numSFTs[PULSAR_MAX_DETECTORS];
+  REAL8 fMinX[PULSAR_MAX_DETECTORS], fMaxX[PULSAR_MAX_DETECTORS];
+  size_t taskMemory = 0;
+  MultiSFTVector *SFTs = NULL;
+  MultiPSDVector *PSDs = NULL;
+
+#define LOADNORMALIZEDERROR(eno, ...) do {	\
+    XLALFree ( tasks );				\
+    XLALDestroyMultiSFTVector ( SFTs );		\
+    XLALDestroyMultiPSDVector ( PSDs );		\
+    XLALDestroyMultiSFTCatalogView ( view );	\
+    XLAL_ERROR ( eno, __VA_ARGS__ );		\
+  } while(0)
+
+  if ( numifo > PULSAR_MAX_DETECTORS ) {
+    LOADNORMALIZEDERROR ( XLAL_EINVAL, "Number of IFOs (%d) exceeds maximum (%d)", numifo, PULSAR_MAX_DETECTORS );
+  }
+  if ( assumeSqrtSX != NULL && assumeSqrtSX->length != numifo ) {
+    LOADNORMALIZEDERROR ( XLAL_EINVAL, "Number of IFOs in 'assumeSqrtSX' (%d) differs from SFT catalog (%d)", assumeSqrtSX->length, numifo );
+  }
+  if ( ( tasks = XLALCalloc ( catalog->length, sizeof(tasks[0]) ) ) == NULL ) {
+    LOADNORMALIZEDERROR ( XLAL_ENOMEM, "Failed to XLALCalloc ( %d, %zu)", catalog->length, sizeof(tasks[0]) );
+  }
 
+  for ( UINT4 X = 0; X < numifo; X++ )
+    {
+      const SFTCatalog *catX = &view->data[X];
+
+      /* XLALLoadSFTs() reads the same frequency bins from all SFTs it is given, which for
+         fMin/fMax = -1 depend on all SFTs of this IFO; so pass the frequencies of these bins explicitly */
+      const REAL8 deltaF = catX->data[0].header.deltaF;
+      UINT4 minbin = lround ( catX->data[0].header.f0 / deltaF );
+      UINT4 maxbin = minbin + catX->data[0].numBins - 1;
+      numSFTs[X] = 0;
+      for ( UINT4 i = 0; i < catX->length; i++ )
+        {
+          const UINT4 firstbin = lround ( catX->data[i].header.f0 / deltaF );
+          const UINT4 lastbin = firstbin + catX->data[i].numBins - 1;
+          if ( firstbin < minbin ) {
+            minbin = firstbin;
+          }
+          if ( lastbin > maxbin ) {
+            maxbin = lastbin;
+          }
+          if ( i == 0 || XLALGPSCmp ( &catX->data[i].header.epoch, &catX->data[i-1].header.epoch ) != 0 )
+            {
+              LoadSFTTask *task = &tasks[numTasks++];
+              task->X = X;
+              task->j = numSFTs[X]++;
+              task->catStart = i;
+            }
+          tasks[numTasks-1].catLength ++;
+        }
+      fMinX[X] = ( fMin < 0 ) ? minbin * deltaF : fMin;
+      fMaxX[X] = ( fMax < 0 ) ? maxbin * deltaF : fMax;
+
+      /* temporary memory: XLALLoadSFTs() read buffer, and periodogram for running median */
+      const UINT4 firstbin = XLALRoundFrequencyDownToSFTBin ( fMinX[X], deltaF );
+      const UINT4 lastbin = XLALRoundFrequencyUpToSFTBin ( fMaxX[X], deltaF );
+      if ( lastbin >= firstbin ) {
+        const size_t memX = ( lastbin - firstbin + 1 ) * ( sizeof(COMPLEX8) + sizeof(REAL8) );
+        if ( memX > taskMemory ) {
+          taskMemory = memX;
+        }
+      }
     } /* for X < numifo */
 
-  return multiPSD;
+  /* allocate output structures; SFT data is filled in by the loaded SFTs */
+  if ( ( SFTs = XLALCalloc ( 1, sizeof(*SFTs) ) ) == NULL || ( SFTs->data = XLALCalloc ( numifo, sizeof(SFTs->data[0]) ) ) == NULL ) {
+    LOADNORMALIZEDERROR ( XLAL_ENOMEM, "Failed to allocate multi SFT vector" );
+  }
+  SFTs->length = numifo;
+  for ( UINT4 X = 0; X < numifo; X++ )
+    {
+      if ( ( SFTs->data[X] = XLALCreateSFTVector ( numSFTs[X], 0 ) ) == NULL ) {
+        LOADNORMALIZEDERROR ( XLAL_EFUNC, "XLALCreateSFTVector ( %d, 0 ) failed.", numSFTs[X] );
+      }
+    }
+  if ( ( PSDs = create_MultiPSDVector_headers ( numifo, numSFTs ) ) == NULL ) {
+    LOADNORMALIZEDERROR ( XLAL_EFUNC, "create_MultiPSDVector_headers() failed" );
+  }
+
+  /* load and normalize SFTs */
+  UNUSED const UINT4 numThreads = get_num_SFT_threads ( numTasks, taskMemory, maxMemory );
+  int errors = 0;
+#pragma omp parallel for schedule(dynamic) num_threads(numThreads) reduction(+:errors)
+  for ( INT4 k = 0; k < (INT4) numTasks; k++ )
+    {
+      const LoadSFTTask *task = &tasks[k];
+      const UINT4 X = task->X;
+      SFTCatalog catSFT = { .length = task->catLength, .data = &view->data[X].data[task->catStart] };
+
+      /* load this SFT, and move it into the output vector */
+      SFTVector *loaded = XLALLoadSFTs ( &catSFT, fMinX[X], fMaxX[X] );
+      if ( loaded == NULL || loaded->length != 1 ) {
+        XLALDestroySFTVector ( loaded );
+        ++errors;
+        continue;
+      }
+      SFTs->data[X]->data[task->j] = loaded->data[0];
+      XLALFree ( loaded->data );
+      XLALFree ( loaded );
 
-} /* XLALNormalizeMultiSFTVect() */
+      /* if assumeSqrtSX is not given, pass 0.0 to calculate PSD from running median */
+      const REAL8 assumeSqrtS = (assumeSqrtSX != NULL) ? assumeSqrtSX->sqrtSn[X] : 0.0;
+
+      if ( normalize_SFT ( &PSDs->data[X]->data[task->j], &SFTs->data[X]->data[task->j], blockSize, assumeSqrtS ) != XLAL_SUCCESS ) {
+        ++errors;
+      }
+
+    } /* for k < numTasks */
+
+  if ( errors > 0 ) {
+    LOADNORMALIZEDERROR ( XLAL_EFUNC, "Loading or normalization failed for %d SFTs", errors );
+  }
+
+#undef LOADNORMALIZEDERROR
+
+  /* free memory and return */
+  XLALFree ( tasks );
+  XLALDestroyMultiSFTCatalogView ( view );
+  (*multiSFTs) = SFTs;
+  if ( multiPSD != NULL ) {
+    (*multiPSD) = PSDs;
+  } else {
+    XLALDestroyMultiPSDVector ( PSDs );
+  }
+
+  return XLAL_SUCCESS;
+
+} /* XLALLoadNormalizedMultiSFTs() */
 
 
 /**
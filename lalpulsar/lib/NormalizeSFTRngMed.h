@@ -59,6 +59,7 @@ int XLALPeriodoToRngmed ( REAL8FrequencySeries  *rngmed, const REAL8FrequencySer
 int XLALNormalizeSFT ( REAL8FrequencySeries *rngmed, SFTtype *sft, UINT4 blockSize, const REAL8 assumeSqrtS );
 int XLALNormalizeSFTVect ( SFTVector  *sftVect,	UINT4 blockSize, const REAL8 assumeSqrtS );
 MultiPSDVector * XLALNormalizeMultiSFTVect ( MultiSFTVector *multsft, UINT4 blockSize, const MultiNoiseFloor *assumeSqrtSX );
+int XLALLoadNormalizedMultiSFTs ( MultiSFTVector **multiSFTs, MultiPSDVector **multiPSD, const SFTCatalog *catalog, REAL8 fMin, REAL8 fMax, UINT4 blockSize, const MultiNoiseFloor *assumeSqrtSX, const size_t maxMemory );
 int XLALSFTstoCrossPeriodogram ( REAL8FrequencySeries *periodo, const COMPLEX8FrequencySeries *sft1, const COMPLEX8FrequencySeries *sft2 );
 
 /** @} */
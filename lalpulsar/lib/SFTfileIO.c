@@ -35,6 +35,7 @@
  */
 
 /*---------- INCLUDES ----------*/
+#include <config.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <errno.h>
@@ -48,6 +49,16 @@
 #include <io.h>
 #endif
 
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_MMAP)
+#include <fcntl.h>
+#include <sys/mman.h>
+#define SFTFILEIO_USE_MMAP 1
+#endif
+
 #include <lal/LALStdio.h>
 #include <lal/LALString.h>
 #include <lal/FileIO.h>
@@ -57,6 +68,8 @@
 #include <lal/ConfigFile.h>
 #include <lal/UserInputParse.h>
 #include <lal/LogPrintf.h>
+
+#include "SharedMemoryCache_internal.h"
 #include <lal/SFTutils.h>
 
 /*---------- DEFINES ----------*/
@@ -64,6 +77,9 @@
 #define MIN_SFT_VERSION 1
 #define MAX_SFT_VERSION 2
 
+/** prefix of an SFT-pattern which names a catalog index written by XLALWriteSFTCatalogIndex() */
+#define SFT_INDEX_PREFIX "index:"
+
 #define TRUE    1
 #define FALSE   0
 
@@ -127,6 +143,30 @@ typedef struct {
   struct tagSFTLocator *lastfrom;  /**< last bin read from this locator */
 } SFTReadSegment;
 
+/* memory-mapped SFT files, and which SFTs of a MappedMultiSFTVector point into them */
+struct tagSFTFileMaps
+{
+  UINT4 numMaps;	/* number of mapped files */
+  void **addr;		/* start of each mapping */
+  size_t *length;	/* length of each mapping */
+  UINT4 numIFOs;	/* number of detectors */
+  BOOLEAN **inplace;	/* per detector and SFT: SFT data point into a mapping */
+  void *shared;		/* shared-memory cache segment the SFT data point into, if any */
+};
+
+/* layout of SFTs in the shared-memory cache: a header, the number of SFTs per detector (padded to
+ * a multiple of 8 bytes), a record for each SFT, and then the frequency bins of each SFT */
+typedef struct
+{
+  UINT4 numIFOs;	/* number of detectors */
+  UINT4 numSFTs;	/* total number of SFTs */
+} SharedSFTsHeader;
+typedef struct
+{
+  SFTtype header;	/* SFT header, with data pointer set to NULL */
+  UINT8 numBins;	/* number of frequency bins */
+} SharedSFTRecord;
+
 /*---------- Global variables ----------*/
 static REAL8 fudge_up   = 1 + 10 * LAL_REAL8_EPS;	// about ~1 + 2e-15
 static REAL8 fudge_down = 1 - 10 * LAL_REAL8_EPS;	// about ~1 - 2e-15
@@ -139,6 +179,15 @@ static BOOLEAN is_pattern(const char*c); /* filename string is a glob-style patt
 
 static BOOLEAN consistent_mSFT_header ( SFTtype header1, UINT4 version1, UINT4 nsamples1, SFTtype header2, UINT4 version2, UINT4 nsamples2 );
 static BOOLEAN timestamp_in_list( LIGOTimeGPS timestamp, LIGOTimeGPSVector *list );
+static BOOLEAN SFT_satisfies_constraints ( SFTtype *header, const SFTConstraints *constraints );
+static int finalize_SFTCatalog ( SFTCatalog *catalog, const SFTConstraints *constraints, const CHAR *file_pattern );
+static int scan_SFTfile ( SFTCatalog *catalog, UINT4 *numAlloc, const CHAR *fname, const SFTConstraints *constraints );
+static SFTCatalog *read_SFTCatalogIndex ( const CHAR *fname, const SFTConstraints *constraints );
+static int map_SFTs ( SFTVector **sfts, BOOLEAN **inplace, struct tagSFTFileMaps *maps, const SFTCatalog *catalog, REAL8 fMin, REAL8 fMax );
+static UINT8 shared_SFTs_cache_key ( const MultiSFTCatalogView *multiCatalogView, REAL8 fMin, REAL8 fMax );
+static int attach_shared_SFTs ( BOOLEAN *attached, MappedMultiSFTVector *mapped, const MultiSFTCatalogView *multiCatalogView, UINT8 key );
+static void publish_shared_SFTs ( const MultiSFTVector *multiSFTs, UINT8 key );
+static COMPLEX8 *mapped_SFT_bins ( CHAR *addr, size_t length, const SFTDescriptor *desc, UINT4 firstbin, UINT4 numBins );
 static long get_file_len ( FILE *fp );
 
 static FILE * fopen_SFTLocator ( const struct tagSFTLocator *locator );
@@ -150,6 +199,7 @@ static int read_v1_header_from_fp ( FILE *fp, SFTtype *header, UINT4 *nsamples,
 
 int compareSFTdesc(const void *ptr1, const void *ptr2);
 static int compareSFTloc(const void *ptr1, const void *ptr2);
+static int compareSFTdescLocator(const void *ptr1, const void *ptr2);
 static int compareDetNameCatalogs ( const void *ptr1, const void *ptr2 );
 
 static UINT8 calc_crc64(const CHAR *data, UINT4 length, UINT8 crc);
@@ -230,6 +280,9 @@ UINT4 XLALRoundFrequencyUpToSFTBin( const REAL8 freq, const REAL8 df )
  *
  * The returned SFTs in the catalogue are sorted by increasing GPS-epochs !
  *
+ * If \a file_pattern is of the form <tt>index:<fname></tt>, the SFTs are instead taken from
+ * the catalog index \a fname written by XLALWriteSFTCatalogIndex(), without reading any SFT headers.
+ *
  */
 SFTCatalog *
 XLALSFTdataFind ( const CHAR *file_pattern,		/**< which SFT-files */
@@ -247,6 +300,14 @@ XLALSFTdataFind ( const CHAR *file_pattern,		/**< which SFT-files */
         }
     }
 
+  /* read a catalog index instead of scanning the SFT headers */
+  if ( strncmp ( file_pattern, SFT_INDEX_PREFIX, strlen(SFT_INDEX_PREFIX) ) == 0 )
+    {
+      SFTCatalog *ret;
+      XLAL_CHECK_NULL ( (ret = read_SFTCatalogIndex ( file_pattern + strlen(SFT_INDEX_PREFIX), constraints )) != NULL, XLAL_EFUNC );
+      return ret;
+    }
+
   /* prepare return-catalog */
   SFTCatalog *ret;
   XLAL_CHECK_NULL ( (ret = LALCalloc ( 1, sizeof (*ret) )) != NULL, XLAL_ENOMEM );
@@ -256,269 +317,375 @@ XLALSFTdataFind ( const CHAR *file_pattern,		/**< which SFT-files */
   XLAL_CHECK_NULL ( (fnames = XLALFindFiles (file_pattern)) != NULL, XLAL_EFUNC, "Failed to find filelist matching pattern '%s'.\n\n", file_pattern );
   UINT4 numFiles = fnames->length;
 
-  UINT4 numSFTs = 0;
   /* ----- main loop: parse all matching files */
+  UINT4 numAlloc = 0;
   for ( UINT4 i = 0; i < numFiles; i ++ )
     {
-      const CHAR *fname = fnames->data[i];
+      if ( scan_SFTfile ( ret, &numAlloc, fnames->data[i], constraints ) != XLAL_SUCCESS )
+        {
+          XLALDestroyStringVector ( fnames );
+          XLALDestroySFTCatalog ( ret );
+          XLAL_ERROR_NULL ( XLAL_EFUNC );
+        }
+    } /* for i < numFiles */
 
-      /* merged SFTs need to satisfy stronger consistency-constraints (-> see spec) */
-      BOOLEAN mfirst_block = TRUE;
-      UINT4   mprev_version = 0;
-      SFTtype XLAL_INIT_DECL( mprev_header );
-      REAL8   mprev_nsamples = 0;
+  /* free matched filenames */
+  XLALDestroyStringVector ( fnames );
 
-      FILE *fp;
-      if ( ( fp = fopen( fname, "rb" ) ) == NULL )
-	{
-          XLALPrintError ("ERROR: Failed to open matched file '%s'\n\n", fname );
-	  XLALDestroyStringVector ( fnames );
-	  XLALDestroySFTCatalog ( ret );
-	  XLAL_ERROR_NULL ( XLAL_EIO );
-	}
+  /* now realloc SFT-vector (alloc'ed blockwise) to its *actual size* */
+  int len;
+  if ( (ret->data = XLALRealloc ( ret->data, len = ret->length * sizeof( *(ret->data) ))) == NULL )
+    {
+      XLALDestroySFTCatalog ( ret );
+      XLAL_ERROR_NULL ( XLAL_ENOMEM, "XLALRecalloc ( %d ) failed.\n", len );
+    }
 
-      long file_len;
-      if ( (file_len = get_file_len(fp)) == 0 )
-	{
-          XLALPrintError ("ERROR: got file-len == 0 for '%s'\n\n", fname );
-	  XLALDestroyStringVector ( fnames );
-	  XLALDestroySFTCatalog ( ret );
-	  fclose(fp);
-	  XLAL_ERROR_NULL ( XLAL_EIO );
-	}
+  /* ----- final consistency-checks and sorting ----- */
+  if ( finalize_SFTCatalog ( ret, constraints, file_pattern ) != XLAL_SUCCESS )
+    {
+      XLALDestroySFTCatalog ( ret );
+      XLAL_ERROR_NULL ( XLAL_EFUNC );
+    }
 
-      /* go through SFT-blocks in fp */
-      while ( ftell(fp) < file_len )
-	{
-	  SFTtype this_header;
-	  UINT4 this_version;
-	  UINT4 this_nsamples;
-	  UINT8 this_crc;
-	  CHAR *this_comment = NULL;
-	  BOOLEAN endian;
-	  BOOLEAN want_this_block = FALSE;
-
-	  long this_filepos;
-	  if ( (this_filepos = ftell(fp)) == -1 )
-	    {
-              XLALPrintError ("ERROR: ftell() failed for '%s'\n\n", fname );
-	      XLALDestroyStringVector ( fnames );
-	      XLALDestroySFTCatalog ( ret );
-	      fclose (fp);
-	      XLAL_ERROR_NULL ( XLAL_EIO );
-	    }
+  /* return result catalog (=sft-vect and locator-vect) */
+  return ret;
 
-	  if ( read_sft_header_from_fp (fp, &this_header, &this_version, &this_crc, &endian, &this_comment, &this_nsamples ) != 0 )
-	    {
-              XLALPrintError ("ERROR: File-block '%s:%ld' is not a valid SFT!\n\n", fname, ftell(fp));
-	      XLALDestroyStringVector ( fnames );
-	      XLALFree ( this_comment );
-	      XLALDestroySFTCatalog ( ret );
-	      fclose(fp);
-	      XLAL_ERROR_NULL ( XLAL_EDATA );
-	    }
+} /* XLALSFTdataFind() */
 
-	  /* if merged-SFT: check consistency constraints */
-	  if ( !mfirst_block )
-	    {
-	      if ( ! consistent_mSFT_header ( mprev_header, mprev_version, mprev_nsamples, this_header, this_version, this_nsamples ) )
-		{
-                  XLALPrintError ( "ERROR: merged SFT-file '%s' contains inconsistent SFT-blocks!\n\n", fname);
-		  XLALFree ( this_comment );
-		  XLALDestroyStringVector ( fnames );
-		  XLALDestroySFTCatalog ( ret );
-		  fclose(fp);
-		  XLAL_ERROR_NULL ( XLAL_EDATA );
-		}
-	    } /* if !mfirst_block */
 
-	  mprev_header = this_header;
-	  mprev_version = this_version;
-	  mprev_nsamples = this_nsamples;
+/*
+ * Append the descriptors of the SFTs in the file \a fname which satisfy the constraints to \a catalog,
+ * whose data has room for \a numAlloc descriptors and is reallocated blockwise as needed.
+ * On failure, \a catalog holds only complete or zeroed descriptors and can be destroyed as usual.
+ */
+static int
+scan_SFTfile ( SFTCatalog *catalog, UINT4 *numAlloc, const CHAR *fname, const SFTConstraints *constraints )
+{
+  /* merged SFTs need to satisfy stronger consistency-constraints (-> see spec) */
+  BOOLEAN mfirst_block = TRUE;
+  UINT4   mprev_version = 0;
+  SFTtype XLAL_INIT_DECL( mprev_header );
+  REAL8   mprev_nsamples = 0;
 
-	  want_this_block = TRUE;	/* default */
-	  /* but does this SFT-block satisfy the user-constraints ? */
-	  if ( constraints )
-	    {
-	      if ( constraints->detector && strncmp(constraints->detector, "??", 2) )
-		{
-		  /* v1-SFTs have '??' as detector-name */
-		  if ( ! strncmp (this_header.name, "??", 2 ) ) {
-		    strncpy ( this_header.name, constraints->detector, 2 );	/* SET to constraint! */
-                  }
-		  else if ( strncmp( constraints->detector, this_header.name, 2) ) {
-		    want_this_block = FALSE;
-                  }
-		}
+  FILE *fp;
+  XLAL_CHECK ( ( fp = fopen( fname, "rb" ) ) != NULL, XLAL_EIO, "Failed to open matched file '%s'\n\n", fname );
 
-	      if ( XLALCWGPSinRange(this_header.epoch, constraints->minStartTime, constraints->maxStartTime) != 0 ) {
-		want_this_block = FALSE;
-              }
+  long file_len;
+  if ( (file_len = get_file_len(fp)) == 0 )
+    {
+      fclose(fp);
+      XLAL_ERROR ( XLAL_EIO, "got file-len == 0 for '%s'\n\n", fname );
+    }
 
-	      if ( constraints->timestamps && !timestamp_in_list(this_header.epoch, constraints->timestamps) ) {
-		want_this_block = FALSE;
-              }
+  /* go through SFT-blocks in fp */
+  while ( ftell(fp) < file_len )
+    {
+      SFTtype this_header;
+      UINT4 this_version;
+      UINT4 this_nsamples;
+      UINT8 this_crc;
+      CHAR *this_comment = NULL;
+      BOOLEAN endian;
 
-	    } /* if constraints */
+      long this_filepos;
+      if ( (this_filepos = ftell(fp)) == -1 )
+        {
+          fclose (fp);
+          XLAL_ERROR ( XLAL_EIO, "ftell() failed for '%s'\n\n", fname );
+        }
 
-	  if ( want_this_block )
-	    {
-	      numSFTs ++;
-
-	      /* do we need to alloc more memory for the SFTs? */
-	      if (  numSFTs > ret->length )
-		{
-		  /* we realloc SFT-memory blockwise in order to
-		   * improve speed in debug-mode (using LALMalloc/LALFree)
-		   */
-                  int len = (ret->length + SFTFILEIO_REALLOC_BLOCKSIZE) * sizeof( *(ret->data) );
-                  if ( (ret->data = LALRealloc ( ret->data, len )) == NULL )
-		    {
-                      XLALPrintError ("ERROR: SFT memory reallocation failed: nSFT:%d, len = %d\n", numSFTs, len );
-		      XLALDestroyStringVector ( fnames );
-		      XLALDestroySFTCatalog ( ret );
-		      XLALFree ( this_comment );
-		      fclose(fp);
-		      XLAL_ERROR_NULL ( XLAL_ENOMEM );
-		    }
-
-		  /* properly initialize data-fields pointers to NULL to avoid SegV when Freeing */
-		  for ( UINT4 j=0; j < SFTFILEIO_REALLOC_BLOCKSIZE; j ++ ) {
-		    memset ( &(ret->data[ret->length + j]), 0, sizeof( ret->data[0] ) );
-                  }
+      if ( read_sft_header_from_fp (fp, &this_header, &this_version, &this_crc, &endian, &this_comment, &this_nsamples ) != 0 )
+        {
+          XLALFree ( this_comment );
+          fclose(fp);
+          XLAL_ERROR ( XLAL_EDATA, "File-block '%s:%ld' is not a valid SFT!\n\n", fname, this_filepos );
+        }
 
-		  ret->length += SFTFILEIO_REALLOC_BLOCKSIZE;
-		} // if numSFTs > ret->length
+      /* if merged-SFT: check consistency constraints */
+      if ( !mfirst_block && ! consistent_mSFT_header ( mprev_header, mprev_version, mprev_nsamples, this_header, this_version, this_nsamples ) )
+        {
+          XLALFree ( this_comment );
+          fclose(fp);
+          XLAL_ERROR ( XLAL_EDATA, "merged SFT-file '%s' contains inconsistent SFT-blocks!\n\n", fname );
+        }
 
-	      SFTDescriptor *desc = &(ret->data[numSFTs - 1]);
+      mprev_header = this_header;
+      mprev_version = this_version;
+      mprev_nsamples = this_nsamples;
 
-	      desc->locator = XLALCalloc ( 1, sizeof ( *(desc->locator) ) );
-	      if ( desc->locator ) {
-		desc->locator->fname = XLALCalloc( 1, strlen(fname) + 1 );
-              }
-	      if ( (desc->locator == NULL) || (desc->locator->fname == NULL ) )
-		{
-                  XLALPrintError ("ERROR: XLALCalloc() failed\n" );
-		  XLALDestroyStringVector ( fnames );
-		  XLALDestroySFTCatalog ( ret );
-		  fclose(fp);
-		  XLAL_ERROR_NULL ( XLAL_ENOMEM );
-		}
-	      strcpy ( desc->locator->fname, fname );
-	      desc->locator->offset = this_filepos;
+      if ( SFT_satisfies_constraints ( &this_header, constraints ) )
+        {
+          /* do we need to alloc more memory for the SFTs? */
+          if ( catalog->length == *numAlloc )
+            {
+              /* we realloc SFT-memory blockwise in order to
+               * improve speed in debug-mode (using LALMalloc/LALFree)
+               */
+              int len = (*numAlloc + SFTFILEIO_REALLOC_BLOCKSIZE) * sizeof( *(catalog->data) );
+              SFTDescriptor *data;
+              if ( (data = LALRealloc ( catalog->data, len )) == NULL )
+                {
+                  XLALFree ( this_comment );
+                  fclose(fp);
+                  XLAL_ERROR ( XLAL_ENOMEM, "SFT memory reallocation failed: nSFT:%d, len = %d\n", catalog->length + 1, len );
+                }
+              catalog->data = data;
 
-	      desc->header  = this_header;
-	      desc->comment = this_comment;
-	      desc->numBins = this_nsamples;
-	      desc->version = this_version;
-	      desc->crc64   = this_crc;
+              /* properly initialize data-fields pointers to NULL to avoid SegV when Freeing */
+              memset ( &(catalog->data[*numAlloc]), 0, SFTFILEIO_REALLOC_BLOCKSIZE * sizeof( catalog->data[0] ) );
 
-	    } /* if want_this_block */
-	  else
-	    {
-	      XLALFree ( this_comment );
-	    }
+              *numAlloc += SFTFILEIO_REALLOC_BLOCKSIZE;
+            } // if catalog->length == *numAlloc
 
-	  mfirst_block = FALSE;
+          SFTDescriptor *desc = &(catalog->data[catalog->length]);
+          catalog->length ++;
 
-	  /* skip seeking if we know we would reach the end */
-	  if ( ftell ( fp ) + (long)this_nsamples * 8 >= file_len )
-	    break;
+          desc->comment = this_comment;
+          if ( (desc->locator = XLALCalloc ( 1, sizeof ( *(desc->locator) ) )) == NULL || (desc->locator->fname = XLALStringDuplicate ( fname )) == NULL )
+            {
+              fclose(fp);
+              XLAL_ERROR ( XLAL_ENOMEM, "XLALCalloc() failed\n" );
+            }
+          desc->locator->offset = this_filepos;
 
-	  /* seek to end of SFT data-entries in file  */
-	  if ( fseek ( fp, this_nsamples * 8 , SEEK_CUR ) == -1 )
-	    {
-              XLALPrintError ("ERROR: Failed to skip DATA field for SFT '%s': %s\n", fname, strerror(errno) );
-	      XLALFree ( this_comment );
-	      XLALDestroyStringVector ( fnames );
-	      XLALDestroySFTCatalog ( ret );
-	      fclose(fp);
-	      XLAL_ERROR_NULL ( XLAL_EIO );
-	    }
+          desc->header  = this_header;
+          desc->numBins = this_nsamples;
+          desc->version = this_version;
+          desc->crc64   = this_crc;
 
-	} /* while !feof */
+        } /* if SFT satisfies constraints */
+      else
+        {
+          XLALFree ( this_comment );
+        }
 
-      fclose(fp);
+      mfirst_block = FALSE;
 
-    } /* for i < numFiles */
+      /* skip seeking if we know we would reach the end */
+      if ( ftell ( fp ) + (long)this_nsamples * 8 >= file_len )
+        break;
 
-  /* free matched filenames */
-  XLALDestroyStringVector ( fnames );
+      /* seek to end of SFT data-entries in file  */
+      if ( fseek ( fp, this_nsamples * 8 , SEEK_CUR ) == -1 )
+        {
+          fclose(fp);
+          XLAL_ERROR ( XLAL_EIO, "Failed to skip DATA field for SFT '%s': %s\n", fname, strerror(errno) );
+        }
 
-  /* now realloc SFT-vector (alloc'ed blockwise) to its *actual size* */
-  int len;
-  if ( (ret->data = XLALRealloc ( ret->data, len = numSFTs * sizeof( *(ret->data) ))) == NULL )
+    } /* while !feof */
+
+  fclose(fp);
+
+  return XLAL_SUCCESS;
+
+} /* scan_SFTfile() */
+
+
+/**
+ * Write an index of the SFTs in a catalog to the file \a fname, from which XLALSFTdataFind()
+ * can later return the same SFTs, given the pattern <tt>index:<fname></tt>, without having
+ * to open and parse every SFT file again.
+ *
+ * Each line of the index describes one SFT: its version, detector, epoch, frequency band and
+ * CRC64 checksum, the size and modification time of its file, and its position in this file.
+ * Relative file names are stored as given, i.e. relative to the current directory.
+ * SFT comments are not stored in the index.
+ *
+ * SFT file names containing '"', or the comment characters '%' or '#' of XLALParseDataFile(),
+ * cannot be stored in an index and are rejected with ::XLAL_EINVAL.
+ */
+int
+XLALWriteSFTCatalogIndex ( const SFTCatalog *catalog,	/**< [in] catalog of SFTs, as returned by XLALSFTdataFind() */
+                           const CHAR *fname		/**< [in] name of index file to write */
+                           )
+{
+  XLAL_CHECK ( catalog != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( fname != NULL, XLAL_EINVAL );
+
+  FILE *fp;
+  XLAL_CHECK ( (fp = fopen ( fname, "wb" )) != NULL, XLAL_EIO, "Failed to open '%s' for writing: %s\n", fname, strerror(errno) );
+
+  fprintf ( fp, "%% SFT catalog index: use \"%s%s\" as SFT-pattern\n", SFT_INDEX_PREFIX, fname );
+  fprintf ( fp, "%% version detector gpsSeconds gpsNanoSeconds f0 deltaF numBins crc64 fileSize fileModTime offset \"fileName\"\n" );
+
+  const CHAR *prev_fname = NULL;
+  struct stat st;
+  for ( UINT4 i = 0; i < catalog->length; i ++ )
     {
-      XLALDestroySFTCatalog ( ret );
-      XLAL_ERROR_NULL ( XLAL_ENOMEM, "XLALRecalloc ( %d ) failed.\n", len );
+      const SFTDescriptor *desc = &(catalog->data[i]);
+      const struct tagSFTLocator *locator = desc->locator;
+
+      if ( strpbrk ( locator->fname, "\"%#" ) != NULL )
+        {
+          fclose ( fp );
+          XLAL_ERROR ( XLAL_EINVAL, "Cannot index SFT file name '%s' containing any of '\"%%#'\n", locator->fname );
+        }
+      if ( (prev_fname == NULL) || strcmp ( prev_fname, locator->fname ) )
+        {
+          if ( stat ( locator->fname, &st ) != 0 )
+            {
+              fclose ( fp );
+              XLAL_ERROR ( XLAL_EIO, "Failed to stat() SFT file '%s': %s\n", locator->fname, strerror(errno) );
+            }
+          prev_fname = locator->fname;
+        }
+
+      fprintf ( fp, "%" LAL_UINT4_FORMAT " %c%c %" LAL_INT4_FORMAT " %" LAL_INT4_FORMAT " %.17g %.17g %" LAL_UINT4_FORMAT " %" LAL_UINT8_FORMAT " %lld %lld %ld \"%s\"\n",
+                desc->version, desc->header.name[0], desc->header.name[1], desc->header.epoch.gpsSeconds, desc->header.epoch.gpsNanoSeconds,
+                desc->header.f0, desc->header.deltaF, desc->numBins, desc->crc64,
+                (long long) st.st_size, (long long) st.st_mtime, locator->offset, locator->fname );
     }
-  ret->length = numSFTs;
 
-  /* ----- final consistency-checks: ----- */
+  XLAL_CHECK ( fclose ( fp ) == 0, XLAL_EIO, "Failed to write SFT catalog index '%s'\n", fname );
 
-  /* did we find all timestamps that lie within [minStartTime, maxStartTime)? */
-  if ( constraints && constraints->timestamps )
+  return XLAL_SUCCESS;
+
+} /* XLALWriteSFTCatalogIndex() */
+
+
+/*
+ * read an SFT catalog index written by XLALWriteSFTCatalogIndex(), keeping SFTs which satisfy the constraints;
+ * the SFTs of files which have changed since the index was written are found by scanning these files instead
+ */
+static SFTCatalog *
+read_SFTCatalogIndex ( const CHAR *fname, const SFTConstraints *constraints )
+{
+  LALParsedDataFile *flines = NULL;
+  XLAL_CHECK_NULL ( XLALParseDataFile ( &flines, fname ) == XLAL_SUCCESS, XLAL_EFUNC, "Could not parse SFT catalog index '%s'\n", fname );
+  const UINT4 numLines = flines->lines->nTokens;
+
+  SFTCatalog *ret;
+  UINT4 numAlloc = numLines;
+  if ( (ret = XLALCalloc ( 1, sizeof(*ret) )) == NULL || (numLines > 0 && (ret->data = XLALCalloc ( numLines, sizeof(ret->data[0]) )) == NULL) )
     {
-      LIGOTimeGPSVector *ts = constraints->timestamps;
+      XLALFree ( ret );
+      XLALDestroyParsedDataFile ( flines );
+      XLAL_ERROR_NULL ( XLAL_ENOMEM );
+    }
 
-      for ( UINT4 i = 0; i < ts->length; i ++ )
-	{
-          const LIGOTimeGPS *ts_i = &(ts->data[i]);
-	  if ( XLALCWGPSinRange(*ts_i, constraints->minStartTime, constraints->maxStartTime) == 0 )
+  /* files which have changed since the index was written, and have been scanned instead */
+  LALStringVector *scanned = NULL;
+
+  /* print the message before freeing 'flines', as it may refer to its contents */
+#define READINDEXERROR(eno, ...) do {		\
+    XLAL_PRINT_ERROR ( __VA_ARGS__ );		\
+    XLALDestroyParsedDataFile ( flines );	\
+    XLALDestroySFTCatalog ( ret );		\
+    XLALDestroyStringVector ( scanned );	\
+    XLAL_ERROR_NULL ( eno );			\
+  } while(0)
+
+  CHAR *prev_fname = NULL;
+  for ( UINT4 l = 0; l < numLines; l ++ )
+    {
+      CHAR *line = flines->lines->tokens[l];
+
+      UINT4 version, numBins;
+      CHAR detector[3];
+      INT4 gpsSeconds, gpsNanoSeconds;
+      REAL8 f0, deltaF;
+      UINT8 crc64;
+      long long fileSize, fileModTime;
+      long offset;
+      int fname_pos = -1;
+      if ( sscanf ( line, "%" LAL_UINT4_FORMAT " %2s %" LAL_INT4_FORMAT " %" LAL_INT4_FORMAT " %lf %lf %" LAL_UINT4_FORMAT " %" LAL_UINT8_FORMAT " %lld %lld %ld %n",
+                    &version, detector, &gpsSeconds, &gpsNanoSeconds, &f0, &deltaF, &numBins, &crc64,
+                    &fileSize, &fileModTime, &offset, &fname_pos ) != 11 || fname_pos < 0 )
+        {
+          READINDEXERROR ( XLAL_EDATA, "Invalid line %u in SFT catalog index '%s': %s\n", l + 1, fname, line );
+        }
+
+      /* file name is given in quotes */
+      CHAR *this_fname = line + fname_pos;
+      size_t len = strlen ( this_fname );
+      if ( len < 3 || this_fname[0] != '"' || this_fname[len - 1] != '"' )
+        {
+          READINDEXERROR ( XLAL_EDATA, "Invalid file name in line %u of SFT catalog index '%s': %s\n", l + 1, fname, line );
+        }
+      this_fname[len - 1] = '\0';
+      this_fname ++;
+
+      /* the SFTs of a file which has changed since the index was written are taken from the file itself */
+      if ( scanned != NULL && XLALFindStringInVector ( this_fname, scanned ) >= 0 )
+        continue;
+      if ( (prev_fname == NULL) || strcmp ( prev_fname, this_fname ) )
+        {
+          struct stat st;
+          if ( stat ( this_fname, &st ) != 0 )
             {
-              UINT4 j;
-              for ( j = 0; j < ret->length; j ++ )
+              READINDEXERROR ( XLAL_EIO, "Failed to stat() SFT file '%s' listed in SFT catalog index '%s': %s\n", this_fname, fname, strerror(errno) );
+            }
+          if ( (long long) st.st_size != fileSize || (long long) st.st_mtime != fileModTime )
+            {
+              XLALPrintInfo ( "%s: SFT file '%s' has changed since SFT catalog index '%s' was written, scanning it instead\n", __func__, this_fname, fname );
+              if ( scan_SFTfile ( ret, &numAlloc, this_fname, constraints ) != XLAL_SUCCESS )
                 {
-                  const LIGOTimeGPS *sft_i = &(ret->data[j].header.epoch);
-                  if ( (ts_i->gpsSeconds == sft_i->gpsSeconds) && ( ts_i->gpsNanoSeconds == sft_i->gpsNanoSeconds ) ) {
-                    break;
-                  }
+                  READINDEXERROR ( XLAL_EFUNC, "Failed to scan SFT file '%s' listed in SFT catalog index '%s'\n", this_fname, fname );
                 }
-              XLAL_CHECK_NULL ( j < ret->length, XLAL_EFAILED,
-                                "Timestamp %d : [%d, %d] did not find a matching SFT\n\n", (i+1), ts_i->gpsSeconds, ts_i->gpsNanoSeconds );
+              if ( (scanned = XLALAppendString2Vector ( scanned, this_fname )) == NULL )
+                {
+                  READINDEXERROR ( XLAL_EFUNC, "XLALAppendString2Vector() failed\n" );
+                }
+              prev_fname = NULL;
+              continue;
             }
-	} // for i < ts->length
+          prev_fname = this_fname;
+        }
 
-    } /* if constraints->timestamps */
+      SFTtype XLAL_INIT_DECL(this_header);
+      this_header.name[0] = detector[0];
+      this_header.name[1] = detector[1];
+      this_header.epoch.gpsSeconds = gpsSeconds;
+      this_header.epoch.gpsNanoSeconds = gpsNanoSeconds;
+      this_header.f0 = f0;
+      this_header.deltaF = deltaF;
 
-  SFTtype XLAL_INIT_DECL(first_header);
-  /* have all matched SFTs identical dFreq values ? */
-  for ( UINT4 i = 0; i < ret->length; i ++ )
-    {
-      SFTtype this_header = ret->data[i].header;
+      if ( !SFT_satisfies_constraints ( &this_header, constraints ) )
+        continue;
 
-      if ( i == 0 ) {
-	first_header = this_header;
-      }
-
-      /* dont give out v1-SFTs without detector-entry, except if constraint->detector="??" ! */
-      if ( !constraints || !constraints->detector || strncmp(constraints->detector, "??", 2) )
-	{
-	  if ( !strncmp ( this_header.name, "??", 2 ) )
-	    {
-	      XLALDestroySFTCatalog ( ret );
-	      XLAL_ERROR_NULL ( XLAL_EINVAL, "Pattern '%s' matched v1-SFTs but no detector-constraint given!\n\n", file_pattern);
-	    }
-	} /* if detector-constraint was not '??' */
+      /* scanned files may have taken the room of later lines */
+      if ( ret->length == numAlloc )
+        {
+          SFTDescriptor *data;
+          if ( (data = XLALRealloc ( ret->data, (numAlloc + SFTFILEIO_REALLOC_BLOCKSIZE) * sizeof(ret->data[0]) )) == NULL )
+            {
+              READINDEXERROR ( XLAL_ENOMEM, "XLALRealloc() failed\n" );
+            }
+          ret->data = data;
+          memset ( &(ret->data[numAlloc]), 0, SFTFILEIO_REALLOC_BLOCKSIZE * sizeof(ret->data[0]) );
+          numAlloc += SFTFILEIO_REALLOC_BLOCKSIZE;
+        }
 
-      if ( this_header.deltaF != first_header.deltaF )
-	{
-	  XLALDestroySFTCatalog ( ret );
-	  XLAL_ERROR_NULL ( XLAL_EDATA, "Pattern '%s' matched SFTs with inconsistent deltaF: %.18g != %.18g!\n\n",
-                            file_pattern, this_header.deltaF, first_header.deltaF );
-	}
+      SFTDescriptor *desc = &(ret->data[ret->length]);
+      if ( (desc->locator = XLALCalloc ( 1, sizeof ( *(desc->locator) ) )) == NULL || (desc->locator->fname = XLALStringDuplicate ( this_fname )) == NULL )
+        {
+          ret->length ++;
+          READINDEXERROR ( XLAL_ENOMEM, "XLALCalloc() failed\n" );
+        }
+      ret->length ++;
+      desc->locator->offset = offset;
+      desc->header  = this_header;
+      desc->comment = NULL;
+      desc->numBins = numBins;
+      desc->version = version;
+      desc->crc64   = crc64;
 
-    } /* for i < numSFTs */
+    } /* for l < numLines */
 
+  /* finalize_SFTCatalog() uses the index name in place of the pattern in error messages */
+  if ( finalize_SFTCatalog ( ret, constraints, fname ) != XLAL_SUCCESS )
+    {
+      READINDEXERROR ( XLAL_EFUNC, "Invalid SFT catalog read from index '%s'\n", fname );
+    }
 
-  /* sort catalog in order of increasing GPS-time */
-  qsort( (void*)ret->data, ret->length, sizeof( ret->data[0] ), compareSFTdesc );
+#undef READINDEXERROR
 
+  XLALDestroyParsedDataFile ( flines );
+  XLALDestroyStringVector ( scanned );
 
-  /* return result catalog (=sft-vect and locator-vect) */
   return ret;
 
-} /* XLALSFTdataFind() */
+} /* read_SFTCatalogIndex() */
 
 
 /*
@@ -1082,6 +1249,144 @@ XLALLoadMultiSFTsFromView ( const MultiSFTCatalogView *multiCatalogView,/**< The
 } // XLALLoadMultiSFTsFromView()
 
 
+/**
+ * Load a frequency-band <tt>[fMin, fMax]</tt> from the SFTs in a catalog by memory-mapping the SFT
+ * files, otherwise the documentation of XLALLoadMultiSFTs() applies.
+ *
+ * Wherever possible the returned SFTs are not copied, but their data point directly into the mapped
+ * files, so that only the pages holding the requested band are ever read from disk. The files are
+ * mapped privately: SFT data may be modified in place (e.g. by XLALNormalizeMultiSFTVect()), which
+ * only copies the modified pages, and never changes the files themselves.
+ *
+ * SFTs which cannot be used in place, i.e. v1-SFTs, SFTs of non-native byte-order, SFTs split across
+ * several SFT-blocks, and SFTs in files which could not be mapped, are read into memory instead.
+ *
+ * If the environment variable <tt>LALPULSAR_SHM_CACHE</tt> is set, the loaded SFTs are also cached in
+ * POSIX shared memory, in a segment whose name begins with the value of the variable: the first
+ * process to load a given band of a given set of (unmodified) SFT files publishes it, and later
+ * processes on the same node attach to it instead of loading the SFTs again. SFT data attached from
+ * the cache are likewise mapped privately; they may be modified in place, but each modified page is
+ * then copied into private memory, so callers which modify the SFTs should rather copy them, as
+ * XLALLoadNormalizedMultiSFTs() does.
+ *
+ * The returned SFTs must not be resized, and must be freed with XLALDestroyMappedMultiSFTVector().
+ */
+MappedMultiSFTVector *
+XLALLoadMultiSFTsMapped ( const SFTCatalog *catalog,	/**< The 'catalogue' of SFTs to load */
+                          REAL8 fMin,			/**< minumum requested frequency (-1 = read from lowest) */
+                          REAL8 fMax			/**< maximum requested frequency (-1 = read up to highest) */
+                          )
+{
+  XLAL_CHECK_NULL ( (catalog != NULL) && (catalog->length != 0), XLAL_EINVAL );
+
+  MultiSFTCatalogView *multiCatalogView;
+  XLAL_CHECK_NULL ( (multiCatalogView = XLALGetMultiSFTCatalogView ( catalog )) != NULL, XLAL_EFUNC );
+  const UINT4 numIFOs = multiCatalogView->length;
+
+  MappedMultiSFTVector *ret = NULL;
+  if ( (ret = XLALCalloc ( 1, sizeof(*ret) )) == NULL
+       || (ret->maps = XLALCalloc ( 1, sizeof(*ret->maps) )) == NULL
+       || (ret->maps->addr = XLALCalloc ( catalog->length, sizeof(ret->maps->addr[0]) )) == NULL
+       || (ret->maps->length = XLALCalloc ( catalog->length, sizeof(ret->maps->length[0]) )) == NULL
+       || (ret->maps->inplace = XLALCalloc ( numIFOs, sizeof(ret->maps->inplace[0]) )) == NULL
+       || (ret->multiSFTs = XLALCalloc ( 1, sizeof(*ret->multiSFTs) )) == NULL
+       || (ret->multiSFTs->data = XLALCalloc ( numIFOs, sizeof(ret->multiSFTs->data[0]) )) == NULL )
+    {
+      XLALDestroyMappedMultiSFTVector ( ret );
+      XLALDestroyMultiSFTCatalogView ( multiCatalogView );
+      XLAL_ERROR_NULL ( XLAL_ENOMEM );
+    }
+  ret->maps->numIFOs = numIFOs;
+  ret->multiSFTs->length = numIFOs;
+
+  /* attach to the SFTs in the shared-memory cache, if enabled and published by another process */
+  const UINT8 cacheKey = shared_SFTs_cache_key ( multiCatalogView, fMin, fMax );
+  if ( cacheKey != 0 )
+    {
+      BOOLEAN attached = FALSE;
+      if ( attach_shared_SFTs ( &attached, ret, multiCatalogView, cacheKey ) != XLAL_SUCCESS )
+        {
+          XLALDestroyMappedMultiSFTVector ( ret );
+          XLALDestroyMultiSFTCatalogView ( multiCatalogView );
+          XLAL_ERROR_NULL ( XLAL_EFUNC );
+        }
+      if ( attached )
+        {
+          XLALDestroyMultiSFTCatalogView ( multiCatalogView );
+          return ret;
+        }
+    }
+
+  for ( UINT4 X = 0; X < numIFOs; X ++ )
+    {
+      if ( map_SFTs ( &(ret->multiSFTs->data[X]), &(ret->maps->inplace[X]), ret->maps, &(multiCatalogView->data[X]), fMin, fMax ) != XLAL_SUCCESS )
+        {
+          XLALDestroyMappedMultiSFTVector ( ret );
+          XLALDestroyMultiSFTCatalogView ( multiCatalogView );
+          XLAL_ERROR_NULL ( XLAL_EFUNC, "Failed to map SFTs for IFO X = %d\n", X );
+        }
+    }
+
+  XLALDestroyMultiSFTCatalogView ( multiCatalogView );
+
+  /* publish the SFTs in the shared-memory cache, if enabled */
+  if ( cacheKey != 0 )
+    publish_shared_SFTs ( ret->multiSFTs, cacheKey );
+
+  return ret;
+
+} /* XLALLoadMultiSFTsMapped() */
+
+
+/**
+ * Free SFTs returned by XLALLoadMultiSFTsMapped(), and unmap their files (or detach from the shared-memory cache).
+ */
+void
+XLALDestroyMappedMultiSFTVector ( MappedMultiSFTVector *mapped )
+{
+  if ( mapped == NULL )
+    return;
+
+  struct tagSFTFileMaps *maps = mapped->maps;
+
+  if ( mapped->multiSFTs )
+    {
+      /* SFT data which point into a mapping are not freed */
+      for ( UINT4 X = 0; maps && maps->inplace && X < maps->numIFOs; X ++ )
+        {
+          SFTVector *sfts = mapped->multiSFTs->data[X];
+          if ( sfts == NULL || maps->inplace[X] == NULL )
+            continue;
+          for ( UINT4 i = 0; i < sfts->length; i ++ )
+            if ( maps->inplace[X][i] && sfts->data[i].data )
+              sfts->data[i].data->data = NULL;
+        }
+      XLALDestroyMultiSFTVector ( mapped->multiSFTs );
+    }
+
+  if ( maps )
+    {
+#ifdef SFTFILEIO_USE_MMAP
+      for ( UINT4 m = 0; m < maps->numMaps; m ++ )
+        munmap ( maps->addr[m], maps->length[m] );
+#endif
+      if ( maps->shared )
+        XLALSharedCacheDetach ( maps->shared );
+      for ( UINT4 X = 0; maps->inplace && X < maps->numIFOs; X ++ )
+        XLALFree ( maps->inplace[X] );
+      XLALFree ( maps->inplace );
+      XLALFree ( maps->addr );
+      XLALFree ( maps->length );
+      XLALFree ( maps );
+    }
+
+  XLALFree ( mapped );
+
+  return;
+
+} /* XLALDestroyMappedMultiSFTVector() */
+
+
 /// backwards compatible wrapper to XLALReadTimestampsFileConstrained() without GPS-time constraints
 LIGOTimeGPSVector *
 XLALReadTimestampsFile ( const CHAR *fname )
@@ -2057,6 +2362,422 @@ timestamp_in_list( LIGOTimeGPS timestamp, LIGOTimeGPSVector *list )
 } /* timestamp_in_list() */
 
 
+/* does an SFT with the given header satisfy the user-constraints?
+ * NOTE: v1-SFTs have '??' as detector-name, which is SET to the detector-constraint here */
+static BOOLEAN
+SFT_satisfies_constraints ( SFTtype *header, const SFTConstraints *constraints )
+{
+  if ( !constraints )
+    return TRUE;
+
+  if ( constraints->detector && strncmp(constraints->detector, "??", 2) )
+    {
+      if ( ! strncmp (header->name, "??", 2 ) ) {
+        strncpy ( header->name, constraints->detector, 2 );
+      }
+      else if ( strncmp( constraints->detector, header->name, 2) ) {
+        return FALSE;
+      }
+    }
+
+  if ( XLALCWGPSinRange(header->epoch, constraints->minStartTime, constraints->maxStartTime) != 0 ) {
+    return FALSE;
+  }
+
+  if ( constraints->timestamps && !timestamp_in_list(header->epoch, constraints->timestamps) ) {
+    return FALSE;
+  }
+
+  return TRUE;
+
+} /* SFT_satisfies_constraints() */
+
+
+/* final consistency-checks on a catalog of matched SFTs, which is then sorted by increasing GPS-epochs */
+static int
+finalize_SFTCatalog ( SFTCatalog *catalog, const SFTConstraints *constraints, const CHAR *file_pattern )
+{
+  /* did we find all timestamps that lie within [minStartTime, maxStartTime)? */
+  if ( constraints && constraints->timestamps )
+    {
+      LIGOTimeGPSVector *ts = constraints->timestamps;
+
+      for ( UINT4 i = 0; i < ts->length; i ++ )
+	{
+          const LIGOTimeGPS *ts_i = &(ts->data[i]);
+	  if ( XLALCWGPSinRange(*ts_i, constraints->minStartTime, constraints->maxStartTime) == 0 )
+            {
+              UINT4 j;
+              for ( j = 0; j < catalog->length; j ++ )
+                {
+                  const LIGOTimeGPS *sft_i = &(catalog->data[j].header.epoch);
+                  if ( (ts_i->gpsSeconds == sft_i->gpsSeconds) && ( ts_i->gpsNanoSeconds == sft_i->gpsNanoSeconds ) ) {
+                    break;
+                  }
+                }
+              XLAL_CHECK ( j < catalog->length, XLAL_EFAILED,
+                           "Timestamp %d : [%d, %d] did not find a matching SFT\n\n", (i+1), ts_i->gpsSeconds, ts_i->gpsNanoSeconds );
+            }
+	} // for i < ts->length
+
+    } /* if constraints->timestamps */
+
+  /* have all matched SFTs identical dFreq values ? */
+  for ( UINT4 i = 0; i < catalog->length; i ++ )
+    {
+      const SFTtype *this_header = &(catalog->data[i].header);
+
+      /* dont give out v1-SFTs without detector-entry, except if constraint->detector="??" ! */
+      if ( !constraints || !constraints->detector || strncmp(constraints->detector, "??", 2) )
+	{
+	  XLAL_CHECK ( strncmp ( this_header->name, "??", 2 ) != 0, XLAL_EINVAL,
+                       "Pattern '%s' matched v1-SFTs but no detector-constraint given!\n\n", file_pattern );
+	} /* if detector-constraint was not '??' */
+
+      XLAL_CHECK ( this_header->deltaF == catalog->data[0].header.deltaF, XLAL_EDATA,
+                   "Pattern '%s' matched SFTs with inconsistent deltaF: %.18g != %.18g!\n\n",
+                   file_pattern, this_header->deltaF, catalog->data[0].header.deltaF );
+
+    } /* for i < numSFTs */
+
+  /* sort catalog in order of increasing GPS-time */
+  qsort( (void*)catalog->data, catalog->length, sizeof( catalog->data[0] ), compareSFTdesc );
+
+  return XLAL_SUCCESS;
+
+} /* finalize_SFTCatalog() */
+
+
+/* map the SFTs of a single-IFO catalog into an SFT vector for XLALLoadMultiSFTsMapped() */
+static int
+map_SFTs ( SFTVector **sfts, BOOLEAN **inplace, struct tagSFTFileMaps *maps, const SFTCatalog *catalog, REAL8 fMin, REAL8 fMax )
+{
+  const UINT4 numSFTs = catalog->length;
+
+  /* v1-SFTs and SFTs split across several blocks are read into memory */
+  BOOLEAN readall = FALSE;
+  for ( UINT4 i = 0; i < numSFTs; i ++ )
+    {
+      if ( catalog->data[i].version != 2 || catalog->data[i].header.data != NULL )
+        readall = TRUE;
+      if ( i > 0 && GPSEQUAL ( catalog->data[i].header.epoch, catalog->data[i-1].header.epoch ) )
+        readall = TRUE;
+    }
+  if ( readall )
+    {
+      XLAL_CHECK ( ((*sfts) = XLALLoadSFTs ( catalog, fMin, fMax )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( ((*inplace) = XLALCalloc ( (*sfts)->length, sizeof((*inplace)[0]) )) != NULL, XLAL_ENOMEM );
+      return XLAL_SUCCESS;
+    }
+
+  /* determine first and last frequency bin to load, as in XLALLoadSFTs() */
+  const REAL8 deltaF = catalog->data[0].header.deltaF;
+  UINT4 minbin = 0, maxbin = 0;
+  for ( UINT4 i = 0; i < numSFTs; i ++ )
+    {
+      volatile REAL8 tmp = catalog->data[i].header.f0 / deltaF;
+      const UINT4 firstSFTbin = lround ( tmp );
+      const UINT4 lastSFTbin = firstSFTbin + catalog->data[i].numBins - 1;
+      if ( i == 0 || firstSFTbin < minbin )
+        minbin = firstSFTbin;
+      if ( i == 0 || lastSFTbin > maxbin )
+        maxbin = lastSFTbin;
+    }
+  const UINT4 firstbin = ( fMin < 0 ) ? minbin : XLALRoundFrequencyDownToSFTBin ( fMin, deltaF );
+  const UINT4 lastbin = ( fMax < 0 ) ? maxbin : XLALRoundFrequencyUpToSFTBin ( fMax, deltaF );
+  XLAL_CHECK ( firstbin <= lastbin, XLAL_EINVAL, "Empty frequency band [%u, %u] bins requested\n", firstbin, lastbin );
+  const UINT4 numBins = lastbin - firstbin + 1;
+
+  SFTVector *ret;
+  XLAL_CHECK ( ((*sfts) = ret = XLALCalloc ( 1, sizeof(*ret) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( (ret->data = XLALCalloc ( numSFTs, sizeof(ret->data[0]) )) != NULL, XLAL_ENOMEM );
+  ret->length = numSFTs;
+  XLAL_CHECK ( ((*inplace) = XLALCalloc ( numSFTs, sizeof((*inplace)[0]) )) != NULL, XLAL_ENOMEM );
+
+  /* go through the SFTs file by file */
+  const SFTDescriptor **bylocator;
+  XLAL_CHECK ( (bylocator = XLALMalloc ( numSFTs * sizeof(bylocator[0]) )) != NULL, XLAL_ENOMEM );
+  for ( UINT4 i = 0; i < numSFTs; i ++ )
+    bylocator[i] = &(catalog->data[i]);
+  qsort ( (void*)bylocator, numSFTs, sizeof(bylocator[0]), compareSFTdescLocator );
+
+  int retn = XLAL_SUCCESS;
+  for ( UINT4 j = 0, jend = 0; j < numSFTs && retn == XLAL_SUCCESS; j = jend )
+    {
+      const CHAR *fname = bylocator[j]->locator->fname;
+      for ( jend = j + 1; jend < numSFTs && !strcmp ( bylocator[jend]->locator->fname, fname ); jend ++ );
+
+      /* map this file, if possible; otherwise its SFTs are read */
+      CHAR *addr = NULL;
+      size_t length = 0;
+#ifdef SFTFILEIO_USE_MMAP
+      int fd = open ( fname, O_RDONLY );
+      struct stat st;
+      if ( fd >= 0 && fstat ( fd, &st ) == 0 && st.st_size > 0 )
+        {
+          void *a = mmap ( NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+          if ( a != MAP_FAILED )
+            {
+              addr = a;
+              length = st.st_size;
+              maps->addr[maps->numMaps] = a;
+              maps->length[maps->numMaps] = length;
+              maps->numMaps ++;
+            }
+          else
+            {
+              XLALPrintInfo ( "%s: Failed to mmap() '%s', reading it instead: %s\n", __func__, fname, strerror(errno) );
+            }
+        }
+      if ( fd >= 0 )
+        close ( fd );
+#endif
+
+      BOOLEAN used = FALSE;
+      for ( UINT4 k = j; k < jend; k ++ )
+        {
+          const SFTDescriptor *desc = bylocator[k];
+          const UINT4 i = desc - catalog->data;
+          SFTtype *sft = &(ret->data[i]);
+
+          *sft = desc->header;
+          sft->data = NULL;
+          sft->f0 = 1.0 * firstbin * deltaF;
+
+          COMPLEX8 *bins = addr ? mapped_SFT_bins ( addr, length, desc, firstbin, numBins ) : NULL;
+          if ( bins )
+            {
+              if ( (sft->data = XLALMalloc ( sizeof(*sft->data) )) == NULL )
+                {
+                  retn = XLAL_ENOMEM;
+                  break;
+                }
+              sft->data->length = numBins;
+              sft->data->data = bins;
+              (*inplace)[i] = TRUE;
+              used = TRUE;
+            }
+          else
+            {
+              if ( (sft->data = XLALCreateCOMPLEX8Vector ( numBins )) == NULL )
+                {
+                  retn = XLAL_ENOMEM;
+                  break;
+                }
+              FILE *fp;
+              if ( (fp = fopen_SFTLocator ( desc->locator )) == NULL )
+                {
+                  retn = XLAL_EIO;
+                  break;
+                }
+              SFTtype XLAL_INIT_DECL(tmp);
+              tmp.data = sft->data;
+              UINT4 firstBinRead = 0;
+              const UINT4 lastBinRead = read_sft_bins_from_fp ( &tmp, &firstBinRead, firstbin, lastbin, fp );
+              fclose ( fp );
+              if ( lastBinRead != lastbin || firstBinRead != firstbin )
+                {
+                  XLALPrintError ( "ERROR: could not read bins [%u, %u] from SFT '%s'\n", firstbin, lastbin, XLALshowSFTLocator ( desc->locator ) );
+                  retn = XLAL_EIO;
+                  break;
+                }
+            }
+        } /* for k < jend */
+
+#ifdef SFTFILEIO_USE_MMAP
+      /* release mapping if no SFT points into it */
+      if ( addr && !used )
+        {
+          maps->numMaps --;
+          munmap ( maps->addr[maps->numMaps], maps->length[maps->numMaps] );
+        }
+#else
+      (void) used;
+#endif
+
+    } /* for j < numSFTs */
+
+  XLALFree ( bylocator );
+
+  XLAL_CHECK ( retn == XLAL_SUCCESS, retn );
+
+  return XLAL_SUCCESS;
+
+} /* map_SFTs() */
+
+
+/* return the shared-memory cache key of a frequency band of the SFTs in a multi-IFO catalog view,
+ * which depends on the SFT files, their sizes and modification times; returns 0 if the cache is disabled */
+static UINT8
+shared_SFTs_cache_key ( const MultiSFTCatalogView *multiCatalogView, REAL8 fMin, REAL8 fMax )
+{
+  if ( !XLALSharedCacheEnabled() )
+    return 0;
+
+  UINT8 key = SHARED_CACHE_KEY_INIT;
+  key = XLALSharedCacheHash ( key, &fMin, sizeof(fMin) );
+  key = XLALSharedCacheHash ( key, &fMax, sizeof(fMax) );
+  key = XLALSharedCacheHash ( key, &(multiCatalogView->length), sizeof(multiCatalogView->length) );
+  for ( UINT4 X = 0; X < multiCatalogView->length && key != 0; X ++ )
+    {
+      const SFTCatalog *catalog = &(multiCatalogView->data[X]);
+      key = XLALSharedCacheHash ( key, &(catalog->length), sizeof(catalog->length) );
+      for ( UINT4 i = 0; i < catalog->length && key != 0; i ++ )
+        {
+          const SFTDescriptor *desc = &(catalog->data[i]);
+          key = XLALSharedCacheHashFile ( key, desc->locator->fname );
+          key = XLALSharedCacheHash ( key, &(desc->locator->offset), sizeof(desc->locator->offset) );
+          key = XLALSharedCacheHash ( key, &(desc->header.epoch), sizeof(desc->header.epoch) );
+          key = XLALSharedCacheHash ( key, &(desc->numBins), sizeof(desc->numBins) );
+        }
+    }
+
+  return key;
+
+} /* shared_SFTs_cache_key() */
+
+
+/* attach to SFTs in the shared-memory cache for XLALLoadMultiSFTsMapped(); sets 'attached' to
+ * FALSE, without raising an error, if they have not been published */
+static int
+attach_shared_SFTs ( BOOLEAN *attached, MappedMultiSFTVector *mapped, const MultiSFTCatalogView *multiCatalogView, UINT8 key )
+{
+  *attached = FALSE;
+
+  size_t size = 0;
+  CHAR *data = XLALSharedCacheAttach ( "sfts", key, 1, &size );
+  if ( data == NULL )
+    return XLAL_SUCCESS;
+
+  /* check the layout of the SFTs against the catalog view */
+  const UINT4 numIFOs = multiCatalogView->length;
+  const SharedSFTsHeader *header = (const SharedSFTsHeader *) data;
+  const size_t lengthsSize = ( ( numIFOs + 1 ) / 2 ) * 2 * sizeof(UINT4);
+  BOOLEAN valid = ( size >= sizeof(*header) + lengthsSize && header->numIFOs == numIFOs );
+  const UINT4 *lengths = (const UINT4 *) ( data + sizeof(*header) );
+  UINT4 numSFTs = 0;
+  for ( UINT4 X = 0; valid && X < numIFOs; X ++ )
+    {
+      valid = ( lengths[X] == multiCatalogView->data[X].length );
+      numSFTs += lengths[X];
+    }
+  valid = valid && ( header->numSFTs == numSFTs ) && ( size >= sizeof(*header) + lengthsSize + numSFTs * sizeof(SharedSFTRecord) );
+  SharedSFTRecord *records = (SharedSFTRecord *) ( data + sizeof(*header) + lengthsSize );
+  size_t expectSize = sizeof(*header) + lengthsSize + numSFTs * sizeof(SharedSFTRecord);
+  for ( UINT4 n = 0; valid && n < numSFTs; n ++ )
+    expectSize += records[n].numBins * sizeof(COMPLEX8);
+  if ( !valid || size != expectSize )
+    {
+      XLALPrintInfo ( "%s: shared-memory SFTs do not match the catalog; loading them instead\n", __func__ );
+      XLALSharedCacheDetach ( data );
+      return XLAL_SUCCESS;
+    }
+
+  /* point SFT data into the cache */
+  mapped->maps->shared = data;
+  *attached = TRUE;
+  COMPLEX8 *bins = (COMPLEX8 *) ( records + numSFTs );
+  for ( UINT4 X = 0; X < numIFOs; X ++ )
+    {
+      SFTVector *sfts;
+      XLAL_CHECK ( (mapped->multiSFTs->data[X] = sfts = XLALCalloc ( 1, sizeof(*sfts) )) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK ( (sfts->data = XLALCalloc ( lengths[X], sizeof(sfts->data[0]) )) != NULL, XLAL_ENOMEM );
+      sfts->length = lengths[X];
+      XLAL_CHECK ( (mapped->maps->inplace[X] = XLALCalloc ( lengths[X], sizeof(mapped->maps->inplace[X][0]) )) != NULL, XLAL_ENOMEM );
+      for ( UINT4 i = 0; i < lengths[X]; i ++, records ++ )
+        {
+          SFTtype *sft = &(sfts->data[i]);
+          *sft = records->header;
+          XLAL_CHECK ( (sft->data = XLALMalloc ( sizeof(*sft->data) )) != NULL, XLAL_ENOMEM );
+          sft->data->length = records->numBins;
+          sft->data->data = bins;
+          mapped->maps->inplace[X][i] = TRUE;
+          bins += records->numBins;
+        }
+    }
+
+  return XLAL_SUCCESS;
+
+} /* attach_shared_SFTs() */
+
+
+/* publish SFTs loaded by XLALLoadMultiSFTsMapped() in the shared-memory cache; failure is not an error */
+static void
+publish_shared_SFTs ( const MultiSFTVector *multiSFTs, UINT8 key )
+{
+  const UINT4 numIFOs = multiSFTs->length;
+  UINT4 numSFTs = 0;
+  for ( UINT4 X = 0; X < numIFOs; X ++ )
+    numSFTs += multiSFTs->data[X]->length;
+
+  SharedSFTsHeader header = { numIFOs, numSFTs };
+  const size_t lengthsSize = ( ( numIFOs + 1 ) / 2 ) * 2 * sizeof(UINT4);
+  UINT4 *lengths = XLALCalloc ( 1, lengthsSize );
+  SharedSFTRecord *records = XLALCalloc ( numSFTs, sizeof(*records) );
+  const void **parts = XLALCalloc ( 3 + numSFTs, sizeof(*parts) );
+  size_t *sizes = XLALCalloc ( 3 + numSFTs, sizeof(*sizes) );
+  if ( lengths != NULL && records != NULL && parts != NULL && sizes != NULL )
+    {
+      parts[0] = &header;
+      sizes[0] = sizeof(header);
+      parts[1] = lengths;
+      sizes[1] = lengthsSize;
+      parts[2] = records;
+      sizes[2] = numSFTs * sizeof(*records);
+      for ( UINT4 X = 0, n = 0; X < numIFOs; X ++ )
+        {
+          lengths[X] = multiSFTs->data[X]->length;
+          for ( UINT4 i = 0; i < lengths[X]; i ++, n ++ )
+            {
+              const SFTtype *sft = &(multiSFTs->data[X]->data[i]);
+              records[n].header = *sft;
+              records[n].header.data = NULL;
+              records[n].numBins = sft->data->length;
+              parts[3 + n] = sft->data->data;
+              sizes[3 + n] = sft->data->length * sizeof(sft->data->data[0]);
+            }
+        }
+      XLALSharedCachePublish ( "sfts", key, parts, sizes, 3 + numSFTs );
+    }
+
+  XLALFree ( lengths );
+  XLALFree ( records );
+  XLALFree ( parts );
+  XLALFree ( sizes );
+
+} /* publish_shared_SFTs() */
+
+
+/* return a pointer to the requested bins of an SFT in a mapped file, or NULL if they cannot be used in place */
+static COMPLEX8 *
+mapped_SFT_bins ( CHAR *addr, size_t length, const SFTDescriptor *desc, UINT4 firstbin, UINT4 numBins )
+{
+  const long offset = desc->locator->offset;
+  _SFT_header_v2_t rawheader;
+  if ( offset < 0 || (size_t)offset + sizeof(rawheader) > length )
+    return NULL;
+  memcpy ( &rawheader, addr + offset, sizeof(rawheader) );
+
+  /* only native byte-order v2-SFTs which agree with the catalog can be used in place;
+     the SFT data following the header are then 8-byte aligned, as the comment length is a multiple of 8 */
+  if ( rawheader.version != 2 || rawheader.nsamples < 0 || (UINT4)rawheader.nsamples != desc->numBins
+       || rawheader.gps_sec != desc->header.epoch.gpsSeconds || rawheader.gps_nsec != desc->header.epoch.gpsNanoSeconds
+       || rawheader.comment_length < 0 || rawheader.comment_length % 8 != 0 || rawheader.first_frequency_index < 0 )
+    return NULL;
+
+  const UINT4 firstSFTbin = rawheader.first_frequency_index;
+  if ( firstbin < firstSFTbin || firstbin + numBins > firstSFTbin + desc->numBins )
+    return NULL;
+
+  const size_t start = (size_t)offset + sizeof(rawheader) + rawheader.comment_length + (size_t)(firstbin - firstSFTbin) * sizeof(COMPLEX8);
+  if ( start + (size_t)numBins * sizeof(COMPLEX8) > length )
+    return NULL;
+
+  return (COMPLEX8 *)(addr + start);
+
+} /* mapped_SFT_bins() */
+
+
 /* check consistency constraints for SFT-blocks within a merged SFT-file,
  * see SFT-v2 spec */
 static BOOLEAN
@@ -3084,6 +3805,25 @@ compareSFTloc(const void *ptr1, const void *ptr2)
 } /* compareSFTloc() */
 
 
+/* compare pointers to SFT-descriptors by locator, for XLALLoadMultiSFTsMapped() */
+static int
+compareSFTdescLocator(const void *ptr1, const void *ptr2)
+{
+  const SFTDescriptor *desc1 = *(const SFTDescriptor * const *)ptr1;
+  const SFTDescriptor *desc2 = *(const SFTDescriptor * const *)ptr2;
+  int s = strcmp(desc1->locator->fname, desc2->locator->fname);
+  if(!s) {
+    if (desc1->locator->offset < desc2->locator->offset)
+      return(-1);
+    else if (desc1->locator->offset > desc2->locator->offset)
+      return(1);
+    else
+      return(0);
+  }
+  return(s);
+} /* compareSFTdescLocator() */
+
+
 /* compare two SFT-catalog by detector name in alphabetic order */
 static int
 compareDetNameCatalogs ( const void *ptr1, const void *ptr2 )
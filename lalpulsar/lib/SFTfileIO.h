@@ -46,7 +46,8 @@ extern "C" {
  * gravity.phys.uwm.edu:2402/usr/local/cvs/lscsoft sftlib, Copyright (C) 2004 Bruce Allen
  *
  * <p> <h3> Overview:</h3>
- * - SFT-reading: XLALSFTdataFind(), XLALLoadSFTs(), XLALLoadMultiSFTs()
+ * - SFT-reading: XLALSFTdataFind(), XLALLoadSFTs(), XLALLoadMultiSFTs(), XLALLoadMultiSFTsMapped()
+ * - SFT catalog indices: XLALWriteSFTCatalogIndex()
  * - SFT-writing: XLALWriteSFT2file(), XLALWriteSFTVector2File(), XLALWriteSFTVector2Dir()
  * - SFT-checking: XLALCheckCRCSFTCatalog(): complete check of SFT-validity including CRC64 checksum
  * - free SFT-catalog: XLALDestroySFTCatalog()
@@ -134,6 +135,17 @@ extern "C" {
  * The function XLALLoadMultiSFTs() is similar to the above, except that it accepts an ::SFTCatalog with different detectors,
  * and returns corresponding multi-IFO vector of SFTVectors.
  *
+ * The function XLALLoadMultiSFTsMapped() returns the same SFTs as XLALLoadMultiSFTs(), but memory-maps the SFT files,
+ * and lets the SFT data point into the mapped files wherever possible instead of copying them.
+ *
+ * <h4>SFT catalog indices</h4>
+ *
+ * For large sets of SFTs, finding them with XLALSFTdataFind() is dominated by opening and parsing every SFT file.
+ * XLALWriteSFTCatalogIndex() writes the descriptors of an ::SFTCatalog to an index file, and XLALSFTdataFind()
+ * given the pattern <tt>index:<fname></tt> returns the SFTs listed in this index which satisfy the constraints,
+ * after only checking that the SFT files have not changed since the index was written; SFT files which have
+ * changed are scanned again, as they would be without an index.
+ *
  * <p><h2>Usage: Writing of SFT-files</h2>
  *
  * For <b>writing SFTs</b>:
@@ -278,6 +290,17 @@ typedef struct tagMultiSFTCatalogView
 } MultiSFTCatalogView;
 
 
+/**
+ * A multi-IFO vector of SFTs returned by XLALLoadMultiSFTsMapped(), whose data may point
+ * directly into memory-mapped SFT files.
+ */
+typedef struct tagMappedMultiSFTVector
+{
+  MultiSFTVector *multiSFTs;		/**< SFT vector for each ifo; free only with XLALDestroyMappedMultiSFTVector() */
+  struct tagSFTFileMaps *maps;		/**< *internal* description of the mapped SFT files [opaque!] */
+} MappedMultiSFTVector;
+
+
 /*---------- Global variables ----------*/
 
 /*
@@ -292,6 +315,7 @@ UINT4 XLALRoundFrequencyUpToSFTBin( const REAL8 freq, const REAL8 df );
 LALStringVector *XLALFindFiles (const CHAR *globstring);
 
 SFTCatalog *XLALSFTdataFind ( const CHAR *file_pattern, const SFTConstraints *constraints );
+int XLALWriteSFTCatalogIndex ( const SFTCatalog *catalog, const CHAR *fname );
 
 int XLALWriteSFTVector2Dir  ( const SFTVector *sftVect, const CHAR *dirname, const CHAR *SFTcomment, const CHAR *Misc );
 int XLALWriteSFTVector2File ( const SFTVector *sftVect, const CHAR *dirname, const CHAR *SFTcomment, const CHAR *Misc );
@@ -311,6 +335,9 @@ SFTVector* XLALLoadSFTs (const SFTCatalog *catalog, REAL8 fMin, REAL8 fMax);
 MultiSFTVector* XLALLoadMultiSFTs (const SFTCatalog *catalog, REAL8 fMin, REAL8 fMax);
 MultiSFTVector *XLALLoadMultiSFTsFromView ( const MultiSFTCatalogView *multiCatalogView, REAL8 fMin, REAL8 fMax );
 
+MappedMultiSFTVector *XLALLoadMultiSFTsMapped ( const SFTCatalog *catalog, REAL8 fMin, REAL8 fMax );
+void XLALDestroyMappedMultiSFTVector ( MappedMultiSFTVector *mapped );
+
 int XLALCheckCRCSFTCatalog( BOOLEAN *crc_check, SFTCatalog *catalog );
 
 void XLALDestroySFTCatalog ( SFTCatalog *catalog );
@@ -31,6 +31,9 @@
 
 /*---------- local DEFINES ----------*/
 
+/* number of sky-positions processed together by XLALGetMultiSSBtimesSky() */
+#define SSB_SKY_BLOCK 64
+
 /*----- Macros ----- */
 
 /** Simple Euklidean scalar product for two 3-dim vectors in cartesian coords */
@@ -53,6 +56,20 @@ struct E_solver_params {
   double A, B, x0;
 };
 
+/* sky-independent coefficients of the SSB timing of one detector */
+typedef struct tagSSBskyCoeffs {
+  UINT4 length;				/* number of timestamps */
+  LIGOTimeGPS *tGPS;			/* timestamps t_i */
+  BarycenterSkyCoeffs *coeffs;		/* sky-independent coefficients at t_i */
+} SSBskyCoeffs;
+
+/* sky-independent coefficients of the SSB timing of multiple detectors */
+struct tagMultiSSBskyCoeffs {
+  SSBprecision precision;		/* precision of SSB timing */
+  UINT4 length;				/* number of detectors */
+  SSBskyCoeffs *data;			/* coefficients for each detector */
+};
+
 /*==================== FUNCTION DEFINITIONS ====================*/
 
 /** Compute extra time-delays for a CW source in a (Keplerian) binary orbital system.
@@ -699,6 +716,256 @@ XLALGetMultiSSBtimes ( const MultiDetectorStateSeries *multiDetStates, /**< [in]
 
 } /* XLALGetMultiSSBtimes() */
 
+/** Compute the sky-position independent part of the SSB timing of all detector-states in
+ * \a multiDetStates, so that the SSB timings for any number of sky-positions can then be
+ * obtained cheaply with XLALGetMultiSSBtimesSky().
+ *
+ * NOTE: this functions *allocates* the output-struct,
+ * use XLALDestroyMultiSSBskyCoeffs() to free this.
+ */
+MultiSSBskyCoeffs *
+XLALCreateMultiSSBskyCoeffs ( const MultiDetectorStateSeries *multiDetStates,	/**< [in] detector-states at timestamps t_i */
+                              SSBprecision precision				/**< use relativistic or Newtonian SSB timing?  */
+                              )
+{
+  XLAL_CHECK_NULL ( multiDetStates != NULL, XLAL_EINVAL, "Invalid NULL input 'multiDetStates'\n");
+  XLAL_CHECK_NULL ( multiDetStates->length > 0, XLAL_EINVAL, "Invalid zero-length 'multiDetStates'\n");
+  XLAL_CHECK_NULL ( precision < SSBPREC_LAST, XLAL_EDOM, "Invalid value precision=%d, allowed are [0, %d]\n", precision, SSBPREC_LAST -1 );
+
+  UINT4 numDetectors = multiDetStates->length;
+
+  // prepare return struct
+  int len;
+  MultiSSBskyCoeffs *ret = XLALCalloc ( 1, len = sizeof( *ret ) );
+  XLAL_CHECK_NULL ( ret != NULL, XLAL_ENOMEM, "Failed to XLALCalloc(1,%d)\n", len );
+  ret->precision = precision;
+  ret->length = numDetectors;
+  ret->data = XLALCalloc ( numDetectors, len=sizeof ( *ret->data ) );
+  if ( ret->data == NULL ) {
+    XLALDestroyMultiSSBskyCoeffs ( ret );
+    XLAL_ERROR_NULL ( XLAL_ENOMEM, "Failed to XLALCalloc(%d,%d)\n", numDetectors, len );
+  }
+
+  // loop over detectors
+  for ( UINT4 X = 0; X < numDetectors; X ++ )
+    {
+      const DetectorStateSeries *DetectorStates = multiDetStates->data[X];
+      if ( DetectorStates == NULL ) {
+        XLALDestroyMultiSSBskyCoeffs ( ret );
+        XLAL_ERROR_NULL ( XLAL_EINVAL, "Invalid NULL input 'multiDetStates->data[%d]'\n", X );
+      }
+      UINT4 numSteps = DetectorStates->length;
+
+      SSBskyCoeffs *coeffsX = &(ret->data[X]);
+      coeffsX->length = numSteps;
+      if ( ( coeffsX->tGPS = XLALCalloc ( numSteps, sizeof(coeffsX->tGPS[0]) ) ) == NULL || ( coeffsX->coeffs = XLALCalloc ( numSteps, sizeof(coeffsX->coeffs[0]) ) ) == NULL ) {
+        XLALDestroyMultiSSBskyCoeffs ( ret );
+        XLAL_ERROR_NULL ( XLAL_ENOMEM );
+      }
+
+      BarycenterInput XLAL_INIT_DECL(baryinput);
+      baryinput.site = DetectorStates->detector;
+      baryinput.site.location[0] /= LAL_C_SI;
+      baryinput.site.location[1] /= LAL_C_SI;
+      baryinput.site.location[2] /= LAL_C_SI;
+      baryinput.dInv = 0;
+
+      for ( UINT4 i = 0; i < numSteps; i++ )
+        {
+          const DetectorState *state = &(DetectorStates->data[i]);
+          BarycenterSkyCoeffs *coeffs = &(coeffsX->coeffs[i]);
+          coeffsX->tGPS[i] = state->tGPS;
+
+          switch ( precision )
+            {
+            case SSBPREC_NEWTONIAN:	/* simple vr.vn and vv.vn */
+              for ( UINT4 j = 0; j < 3; j++ )
+                {
+                  coeffs->deltaT[j] = state->rDetector[j];
+                  coeffs->tDot[j] = state->vDetector[j];
+                }
+              coeffs->tDot0 = 1.0;
+              break;
+
+            case SSBPREC_RELATIVISTIC:
+            case SSBPREC_RELATIVISTICOPT:
+              baryinput.tgps = state->tGPS;
+              if ( XLALBarycenterSkyCoeffs ( coeffs, &baryinput, &(state->earthState) ) != XLAL_SUCCESS ) {
+                XLALDestroyMultiSSBskyCoeffs ( ret );
+                XLAL_ERROR_NULL ( XLAL_EFUNC );
+              }
+              break;
+
+            default:	/* no sky-dependent terms */
+              coeffs->tDot0 = 1.0;
+              break;
+            } /* switch precision */
+
+        } /* for i < numSteps */
+
+    } /* for X < numDetectors */
+
+  return ret;
+
+} /* XLALCreateMultiSSBskyCoeffs() */
+
+/** Compute the SSB timings, as returned by XLALGetMultiSSBtimes(), for a block of \a numSky
+ * sky-positions \a skypos, given the sky-independent coefficients \a coeffs of the detector-states
+ * from XLALCreateMultiSSBskyCoeffs().
+ *
+ * The work is ordered so that the timings of all sky-positions are computed together for each
+ * timestamp, from sky-independent terms computed only once; this is much faster than calling
+ * XLALGetMultiSSBtimes() for each sky-position. The relativistic precisions are computed with
+ * XLALBarycenterSkyBlock(), and agree with XLALBarycenterOpt() to rounding.
+ *
+ * The output array \a multiSSB must have \a numSky elements: NULL elements are allocated here,
+ * otherwise the existing MultiSSBtimes are re-used.
+ */
+int
+XLALGetMultiSSBtimesSky ( MultiSSBtimes **multiSSB,		/**< [in/out] SSB timings for each sky-position */
+                          const MultiSSBskyCoeffs *coeffs,	/**< [in] sky-independent coefficients */
+                          const SkyPosition *skypos,		/**< [in] source sky-positions [in equatorial coords!] */
+                          UINT4 numSky,				/**< [in] number of sky-positions */
+                          LIGOTimeGPS refTime			/**< [in] SSB reference-time T_0 for SSB-timing */
+                          )
+{
+  XLAL_CHECK ( coeffs != NULL, XLAL_EINVAL, "Invalid NULL input 'coeffs'\n" );
+  XLAL_CHECK ( numSky == 0 || ( multiSSB != NULL && skypos != NULL ), XLAL_EINVAL, "Invalid NULL input 'multiSSB' or 'skypos'\n" );
+
+  UINT4 numDetectors = coeffs->length;
+
+  // prepare output structs, or check the ones to be re-used
+  for ( UINT4 s = 0; s < numSky; s++ )
+    {
+      XLAL_CHECK ( skypos[s].system == COORDINATESYSTEM_EQUATORIAL, XLAL_EDOM, "Only equatorial coordinate system (=%d) allowed, got %d\n", COORDINATESYSTEM_EQUATORIAL, skypos[s].system );
+      XLAL_CHECK ( fabs ( skypos[s].longitude ) <= LAL_TWOPI, XLAL_EDOM, "alpha = %f outside of allowed range [-2pi,2pi]\n", skypos[s].longitude );
+      XLAL_CHECK ( fabs ( skypos[s].latitude ) <= LAL_PI_2, XLAL_EDOM, "delta = %f outside of allowed range [-pi/2,pi/2]\n", skypos[s].latitude );
+
+      if ( multiSSB[s] == NULL )
+        {
+          int len;
+          MultiSSBtimes *ret = XLALCalloc ( 1, len = sizeof( *ret ) );
+          XLAL_CHECK ( ret != NULL, XLAL_ENOMEM, "Failed to XLALCalloc(1,%d)\n", len );
+          multiSSB[s] = ret;
+          ret->length = numDetectors;
+          ret->data = XLALCalloc ( numDetectors, len=sizeof ( *ret->data ) );
+          XLAL_CHECK ( ret->data != NULL, XLAL_ENOMEM, "Failed to XLALCalloc(%d,%d)\n", numDetectors, len );
+          for ( UINT4 X = 0; X < numDetectors; X ++ )
+            {
+              UINT4 numSteps = coeffs->data[X].length;
+              XLAL_CHECK ( ( ret->data[X] = XLALCalloc ( 1, len = sizeof(*ret->data[X]) ) ) != NULL, XLAL_ENOMEM, "Failed to XLALCalloc(1,%d)\n", len );
+              XLAL_CHECK ( ( ret->data[X]->DeltaT = XLALCreateREAL8Vector ( numSteps ) ) != NULL, XLAL_EFUNC, "XLALCreateREAL8Vector(%d) failed\n", numSteps );
+              XLAL_CHECK ( ( ret->data[X]->Tdot = XLALCreateREAL8Vector ( numSteps ) ) != NULL, XLAL_EFUNC, "XLALCreateREAL8Vector(%d) failed\n", numSteps );
+            }
+        }
+      else
+        {
+          XLAL_CHECK ( multiSSB[s]->length == numDetectors, XLAL_EINVAL, "Inconsistent number of detectors: multiSSB[%d] has %d, coeffs has %d\n", s, multiSSB[s]->length, numDetectors );
+          for ( UINT4 X = 0; X < numDetectors; X ++ )
+            {
+              UINT4 numSteps = coeffs->data[X].length;
+              XLAL_CHECK ( multiSSB[s]->data[X]->DeltaT->length == numSteps && multiSSB[s]->data[X]->Tdot->length == numSteps, XLAL_EINVAL,
+                           "Inconsistent number of timestamps for detector %d: multiSSB[%d] has %d, coeffs has %d\n", X, s, multiSSB[s]->data[X]->DeltaT->length, numSteps );
+            }
+        }
+      for ( UINT4 X = 0; X < numDetectors; X ++ )
+        {
+          multiSSB[s]->data[X]->refTime = refTime;
+        }
+
+    } /* for s < numSky */
+
+  REAL8 refTimeREAL8 = XLALGPSGetREAL8 ( &refTime );
+
+  // loop over blocks of sky-positions
+  for ( UINT4 s0 = 0; s0 < numSky; s0 += SSB_SKY_BLOCK )
+    {
+      const UINT4 numBlock = ( numSky - s0 < SSB_SKY_BLOCK ) ? ( numSky - s0 ) : SSB_SKY_BLOCK;
+
+      /*----- get the cartesian source unit-vectors */
+      REAL8 nx[SSB_SKY_BLOCK], ny[SSB_SKY_BLOCK], nz[SSB_SKY_BLOCK];
+      for ( UINT4 s = 0; s < numBlock; s++ )
+        {
+          REAL8 alpha = skypos[s0 + s].longitude;
+          REAL8 delta = skypos[s0 + s].latitude;
+          nx[s] = cos(alpha) * cos(delta);
+          ny[s] = sin(alpha) * cos(delta);
+          nz[s] = sin(delta);
+        }
+
+      for ( UINT4 X = 0; X < numDetectors; X ++ )
+        {
+          const SSBskyCoeffs *coeffsX = &(coeffs->data[X]);
+
+          for ( UINT4 i = 0; i < coeffsX->length; i++ )
+            {
+              const LIGOTimeGPS *ti = &(coeffsX->tGPS[i]);
+              const BarycenterSkyCoeffs *c = &(coeffsX->coeffs[i]);
+              REAL8 deltaT[SSB_SKY_BLOCK], Tdot[SSB_SKY_BLOCK];
+
+              switch ( coeffs->precision )
+                {
+                case SSBPREC_NEWTONIAN:	/* as in XLALGetSSBtimes() */
+                  {
+                    REAL8 tiREAL8 = XLALGPSGetREAL8 ( ti );
+                    for ( UINT4 s = 0; s < numBlock; s++ )
+                      {
+                        deltaT[s]  = tiREAL8;
+                        deltaT[s] += c->deltaT[0] * nx[s] + c->deltaT[1] * ny[s] + c->deltaT[2] * nz[s];
+                        deltaT[s] -= refTimeREAL8;
+                        Tdot[s] = 1.0 + ( c->tDot[0] * nx[s] + c->tDot[1] * ny[s] + c->tDot[2] * nz[s] );
+                      }
+                  }
+                  break;
+
+                case SSBPREC_RELATIVISTIC:
+                case SSBPREC_RELATIVISTICOPT:
+                  XLAL_CHECK ( XLALBarycenterSkyBlock ( deltaT, Tdot, c, nx, ny, nz, numBlock ) == XLAL_SUCCESS, XLAL_EFUNC );
+                  for ( UINT4 s = 0; s < numBlock; s++ )
+                    {
+                      /* emission time rounded to nanoseconds, as in XLALBarycenterOpt() */
+                      LIGOTimeGPS te;
+                      INT4 deltaTint = floor ( deltaT[s] );
+                      REAL8 frac = 1e-9 * ti->gpsNanoSeconds + deltaT[s] - deltaTint;
+                      if ( frac >= 1.e0 )
+                        {
+                          te.gpsSeconds     = ti->gpsSeconds + deltaTint + 1;
+                          te.gpsNanoSeconds = floor ( 1e9 * ( frac - 1.0 ) );
+                        }
+                      else
+                        {
+                          te.gpsSeconds     = ti->gpsSeconds + deltaTint;
+                          te.gpsNanoSeconds = floor ( 1e9 * frac );
+                        }
+                      deltaT[s] = XLALGPSGetREAL8 ( &te ) - refTimeREAL8;
+                    }
+                  break;
+
+                default:	/* switch off all demodulation terms */
+                  for ( UINT4 s = 0; s < numBlock; s++ )
+                    {
+                      deltaT[s] = XLALGPSGetREAL8 ( ti ) - refTimeREAL8;
+                      Tdot[s] = 1.0;
+                    }
+                  break;
+                } /* switch precision */
+
+              for ( UINT4 s = 0; s < numBlock; s++ )
+                {
+                  multiSSB[s0 + s]->data[X]->DeltaT->data[i] = deltaT[s];
+                  multiSSB[s0 + s]->data[X]->Tdot->data[i] = Tdot[s];
+                }
+
+            } /* for i < numSteps */
+
+        } /* for X < numDetectors */
+
+    } /* for s0 < numSky */
+
+  return XLAL_SUCCESS;
+
+} /* XLALGetMultiSSBtimesSky() */
+
 /** Find the earliest timestamp in a multi-SSB data structure
  *
 */
@@ -877,3 +1144,29 @@ XLALDestroyMultiSSBtimes ( MultiSSBtimes *multiSSB )
   return;
 
 } /* XLALDestroyMultiSSBtimes() */
+
+/** Destroy a MultiSSBskyCoeffs structure.
+ * Note, this is "NULL-robust" in the sense that it will not crash
+ * on NULL-entries anywhere in this struct, so it can be used
+ * for failure-cleanup even on incomplete structs
+ */
+void
+XLALDestroyMultiSSBskyCoeffs ( MultiSSBskyCoeffs *coeffs )
+{
+  if ( ! coeffs )
+    return;
+
+  if ( coeffs->data )
+    {
+      for ( UINT4 X = 0; X < coeffs->length; X ++ )
+        {
+          XLALFree ( coeffs->data[X].tGPS );
+          XLALFree ( coeffs->data[X].coeffs );
+        } /* for X < numDetectors */
+      XLALFree ( coeffs->data );
+    }
+  XLALFree ( coeffs );
+
+  return;
+
+} /* XLALDestroyMultiSSBskyCoeffs() */
@@ -69,6 +69,10 @@ typedef struct tagMultiSSBtimes {
   SSBtimes **data;	/**< array of SSBtimes (pointers) */
 } MultiSSBtimes;
 
+/** Sky-position independent part of the SSB timing of a MultiDetectorStateSeries (opaque),
+ * see XLALCreateMultiSSBskyCoeffs() */
+typedef struct tagMultiSSBskyCoeffs MultiSSBskyCoeffs;
+
 /*---------- exported Global variables ----------*/
 
 /*---------- exported prototypes [API] ----------*/
@@ -80,12 +84,16 @@ MultiSSBtimes *XLALDuplicateMultiSSBtimes ( const MultiSSBtimes *multiSSB );
 SSBtimes *XLALGetSSBtimes ( const DetectorStateSeries *DetectorStates, SkyPosition pos, LIGOTimeGPS refTime, SSBprecision precision );
 MultiSSBtimes *XLALGetMultiSSBtimes ( const MultiDetectorStateSeries *multiDetStates, SkyPosition skypos, LIGOTimeGPS refTime, SSBprecision precision);
 
+MultiSSBskyCoeffs *XLALCreateMultiSSBskyCoeffs ( const MultiDetectorStateSeries *multiDetStates, SSBprecision precision );
+int XLALGetMultiSSBtimesSky ( MultiSSBtimes **multiSSB, const MultiSSBskyCoeffs *coeffs, const SkyPosition *skypos, UINT4 numSky, LIGOTimeGPS refTime );
+
 int XLALEarliestMultiSSBtime ( LIGOTimeGPS *out, const MultiSSBtimes *multiSSB, const REAL8 Tsft );
 int XLALLatestMultiSSBtime ( LIGOTimeGPS *out, const MultiSSBtimes *multiSSB,  const REAL8 Tsft );
 
 /* destructors */
 void XLALDestroySSBtimes ( SSBtimes *multiSSB );
 void XLALDestroyMultiSSBtimes ( MultiSSBtimes *multiSSB );
+void XLALDestroyMultiSSBskyCoeffs ( MultiSSBskyCoeffs *coeffs );
 
 /** @} */
 
@@ -0,0 +1,338 @@
+//
+// Copyright (C) 2026
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+#define _GNU_SOURCE   /* for realpath() */
+
+#include <config.h>
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_MMAP) && defined(HAVE_SHM_OPEN)
+#include <fcntl.h>
+#include <sys/mman.h>
+#define SHARED_CACHE_USE_SHM 1
+#endif
+
+#include <lal/LALStdlib.h>
+
+#include "SharedMemoryCache_internal.h"
+
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+static pthread_mutex_t cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+#else
+#define pthread_mutex_lock( pmut )
+#define pthread_mutex_unlock( pmut )
+#endif
+
+// ---------- Internal definitions ---------- //
+
+// Magic number identifying a cache segment, and the version of its layout
+#define SHARED_CACHE_MAGIC 0x4c414c5053484d31ULL  // "LALPSHM1"
+
+// Header at the start of each cache segment; its size is a multiple of 64 bytes, so that the
+// contents following it are aligned for any type
+typedef struct {
+  UINT8 magic;                  // SHARED_CACHE_MAGIC
+  UINT8 key;                    // Cache key of the contents
+  UINT8 size;                   // Size of the contents in bytes
+  volatile UINT4 ready;         // Set to 1 once the contents have been completely written
+  CHAR padding[36];
+} SharedCacheHeader;
+
+// Segments attached by this process
+typedef struct tagSharedCacheSegment {
+  void *addr;                                   // Start of the mapping
+  size_t length;                                // Length of the mapping
+  struct tagSharedCacheSegment *next;           // Next attached segment
+} SharedCacheSegment;
+static SharedCacheSegment *attached = NULL;
+
+// ---------- Internal functions ---------- //
+
+#ifdef SHARED_CACHE_USE_SHM
+
+///
+/// Write the name of the segment of type 'kind' for 'key' to 'name'; returns XLAL_FAILURE if the cache is disabled
+///
+static int shared_cache_name ( char *name, size_t namelen, const char *kind, UINT8 key )
+{
+  const char *prefix = getenv ( SHARED_CACHE_ENV );
+  if ( prefix == NULL || prefix[0] == '\0' ) {
+    return XLAL_FAILURE;
+  }
+  if ( prefix[0] == '/' ) {
+    ++prefix;
+  }
+  if ( prefix[0] == '\0' || strchr ( prefix, '/' ) != NULL ) {
+    XLALPrintWarning ( "%s: ignoring invalid value '%s' of %s\n", __func__, getenv ( SHARED_CACHE_ENV ), SHARED_CACHE_ENV );
+    return XLAL_FAILURE;
+  }
+  const int n = snprintf ( name, namelen, "/%s.%s.%016llx", prefix, kind, (unsigned long long) key );
+  if ( n < 0 || (size_t) n >= namelen ) {
+    return XLAL_FAILURE;
+  }
+  return XLAL_SUCCESS;
+}
+
+///
+/// Remove the segment 'name' if it is incomplete and has not been modified for SHARED_CACHE_STALE_TIMEOUT
+/// seconds, e.g. because its publisher crashed; returns true if it was removed
+///
+static int shared_cache_remove_stale ( const char *name )
+{
+  const int fd = shm_open ( name, O_RDONLY, 0 );
+  if ( fd < 0 ) {
+    return 0;
+  }
+  struct stat st;
+  int stale = 0;
+  if ( fstat ( fd, &st ) == 0 && difftime ( time ( NULL ), st.st_mtime ) > SHARED_CACHE_STALE_TIMEOUT ) {
+    stale = 1;
+    if ( (size_t) st.st_size >= sizeof(SharedCacheHeader) ) {
+      void *addr = mmap ( NULL, sizeof(SharedCacheHeader), PROT_READ, MAP_SHARED, fd, 0 );
+      if ( addr != MAP_FAILED ) {
+        stale = ( ( (const SharedCacheHeader *) addr )->ready != 1 );
+        munmap ( addr, sizeof(SharedCacheHeader) );
+      }
+    }
+  }
+  close ( fd );
+  if ( stale && shm_unlink ( name ) == 0 ) {
+    XLALPrintInfo ( "%s: removed incomplete shared-memory segment '%s', unmodified for %g seconds\n", __func__, name, difftime ( time ( NULL ), st.st_mtime ) );
+    return 1;
+  }
+  return 0;
+}
+
+#endif // SHARED_CACHE_USE_SHM
+
+// ---------- Function definitions ---------- //
+
+int XLALSharedCacheEnabled ( void )
+{
+#ifdef SHARED_CACHE_USE_SHM
+  char name[256];
+  return shared_cache_name ( name, sizeof(name), "x", 0 ) == XLAL_SUCCESS;
+#else
+  return 0;
+#endif
+}
+
+UINT8 XLALSharedCacheHash ( UINT8 key, const void *data, size_t len )
+{
+  // 64-bit FNV-1a hash
+  const unsigned char *p = (const unsigned char *) data;
+  for ( size_t i = 0; i < len; ++i ) {
+    key ^= p[i];
+    key *= 0x100000001b3ULL;
+  }
+  return key;
+}
+
+UINT8 XLALSharedCacheHashFile ( UINT8 key, const char *path )
+{
+  struct stat st;
+  if ( path == NULL || stat ( path, &st ) != 0 ) {
+    return 0;
+  }
+
+  // Hash the canonical path, so that processes naming the file differently, e.g. relative to different
+  // working directories, or through symbolic links, compute the same key
+  char *canonical = realpath ( path, NULL );
+  if ( canonical == NULL ) {
+    return 0;
+  }
+  const INT8 size = st.st_size, mtime = st.st_mtime;
+  key = XLALSharedCacheHash ( key, canonical, strlen ( canonical ) + 1 );
+  key = XLALSharedCacheHash ( key, &size, sizeof(size) );
+  key = XLALSharedCacheHash ( key, &mtime, sizeof(mtime) );
+  free ( canonical );
+  return key;
+}
+
+void *XLALSharedCacheAttach ( const char *kind, UINT8 key, int writable, size_t *size )
+{
+#ifdef SHARED_CACHE_USE_SHM
+
+  char name[256];
+  if ( kind == NULL || size == NULL || shared_cache_name ( name, sizeof(name), kind, key ) != XLAL_SUCCESS ) {
+    return NULL;
+  }
+
+  // Open segment; a missing segment is not an error
+  const int fd = shm_open ( name, O_RDONLY, 0 );
+  if ( fd < 0 ) {
+    return NULL;
+  }
+
+  // Map segment, if it is at least large enough to hold a header; it may still be being created
+  struct stat st;
+  void *addr = MAP_FAILED;
+  if ( fstat ( fd, &st ) == 0 && (size_t) st.st_size > sizeof(SharedCacheHeader) ) {
+    addr = mmap ( NULL, st.st_size, writable ? ( PROT_READ | PROT_WRITE ) : PROT_READ, MAP_PRIVATE, fd, 0 );
+  }
+  close ( fd );
+  if ( addr == MAP_FAILED ) {
+    return NULL;
+  }
+
+  // Check that segment is complete and matches the key
+  const SharedCacheHeader *header = (const SharedCacheHeader *) addr;
+#ifdef __GNUC__
+  __sync_synchronize();
+#endif
+  if ( header->magic != SHARED_CACHE_MAGIC || header->key != key || header->ready != 1
+       || header->size != (UINT8) st.st_size - sizeof(SharedCacheHeader) ) {
+    XLALPrintInfo ( "%s: shared-memory segment '%s' is incomplete or does not match; ignoring it\n", __func__, name );
+    munmap ( addr, st.st_size );
+    return NULL;
+  }
+
+  // Record attached segment
+  SharedCacheSegment *seg = XLALCalloc ( 1, sizeof(*seg) );
+  if ( seg == NULL ) {
+    munmap ( addr, st.st_size );
+    return NULL;
+  }
+  seg->addr = addr;
+  seg->length = st.st_size;
+  pthread_mutex_lock ( &cache_mutex );
+  seg->next = attached;
+  attached = seg;
+  pthread_mutex_unlock ( &cache_mutex );
+
+  XLALPrintInfo ( "%s: attached to shared-memory segment '%s'\n", __func__, name );
+  *size = header->size;
+  return ( (char *) addr ) + sizeof(SharedCacheHeader);
+
+#else // !SHARED_CACHE_USE_SHM
+
+  (void) kind; (void) key; (void) writable; (void) size;
+  return NULL;
+
+#endif // SHARED_CACHE_USE_SHM
+}
+
+int XLALSharedCacheContains ( const void *ptr )
+{
+  int found = 0;
+  pthread_mutex_lock ( &cache_mutex );
+  for ( SharedCacheSegment *seg = attached; seg != NULL && !found; seg = seg->next ) {
+    found = ( (const char *) ptr >= (const char *) seg->addr && (const char *) ptr < ( (const char *) seg->addr ) + seg->length );
+  }
+  pthread_mutex_unlock ( &cache_mutex );
+  return found;
+}
+
+void XLALSharedCacheDetach ( const void *ptr )
+{
+  SharedCacheSegment *seg = NULL;
+  pthread_mutex_lock ( &cache_mutex );
+  for ( SharedCacheSegment **pseg = &attached; *pseg != NULL; pseg = &( (*pseg)->next ) ) {
+    if ( (const char *) ptr >= (const char *) (*pseg)->addr && (const char *) ptr < ( (const char *) (*pseg)->addr ) + (*pseg)->length ) {
+      seg = *pseg;
+      *pseg = seg->next;
+      break;
+    }
+  }
+  pthread_mutex_unlock ( &cache_mutex );
+  if ( seg != NULL ) {
+#ifdef SHARED_CACHE_USE_SHM
+    munmap ( seg->addr, seg->length );
+#endif
+    XLALFree ( seg );
+  }
+}
+
+int XLALSharedCachePublish ( const char *kind, UINT8 key, const void *const *parts, const size_t *sizes, UINT4 numParts )
+{
+#ifdef SHARED_CACHE_USE_SHM
+
+  char name[256];
+  if ( kind == NULL || shared_cache_name ( name, sizeof(name), kind, key ) != XLAL_SUCCESS ) {
+    return XLAL_FAILURE;
+  }
+
+  // Create segment exclusively, so that only one process publishes it; take over an existing
+  // segment if it has been left incomplete for too long
+  int fd = shm_open ( name, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR );
+  if ( fd < 0 && errno == EEXIST && shared_cache_remove_stale ( name ) ) {
+    fd = shm_open ( name, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR );
+  }
+  if ( fd < 0 ) {
+    if ( errno != EEXIST ) {
+      XLALPrintInfo ( "%s: could not create shared-memory segment '%s': %s\n", __func__, name, strerror ( errno ) );
+    }
+    return XLAL_FAILURE;
+  }
+
+  // Size and map segment
+  size_t size = 0;
+  for ( UINT4 i = 0; i < numParts; ++i ) {
+    size += sizes[i];
+  }
+  const size_t length = sizeof(SharedCacheHeader) + size;
+  void *addr = MAP_FAILED;
+  if ( ftruncate ( fd, length ) == 0 ) {
+    addr = mmap ( NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+  }
+  close ( fd );
+  if ( addr == MAP_FAILED ) {
+    XLALPrintInfo ( "%s: could not allocate shared-memory segment '%s' of %zu bytes: %s\n", __func__, name, length, strerror ( errno ) );
+    shm_unlink ( name );
+    return XLAL_FAILURE;
+  }
+
+  // Write contents, then mark them as ready
+  SharedCacheHeader *header = (SharedCacheHeader *) addr;
+  header->magic = SHARED_CACHE_MAGIC;
+  header->key = key;
+  header->size = size;
+  char *p = ( (char *) addr ) + sizeof(SharedCacheHeader);
+  for ( UINT4 i = 0; i < numParts; ++i ) {
+    memcpy ( p, parts[i], sizes[i] );
+    p += sizes[i];
+  }
+#ifdef __GNUC__
+  __sync_synchronize();
+#endif
+  header->ready = 1;
+  munmap ( addr, length );
+
+  XLALPrintInfo ( "%s: published shared-memory segment '%s' of %zu bytes\n", __func__, name, length );
+  return XLAL_SUCCESS;
+
+#else // !SHARED_CACHE_USE_SHM
+
+  (void) kind; (void) key; (void) parts; (void) sizes; (void) numParts;
+  return XLAL_FAILURE;
+
+#endif // SHARED_CACHE_USE_SHM
+}
@@ -0,0 +1,75 @@
+//
+// Copyright (C) 2026
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+#ifndef _SHAREDMEMORYCACHE_INTERNAL_H
+#define _SHAREDMEMORYCACHE_INTERNAL_H
+
+#include <stddef.h>
+#include <lal/LALStdlib.h>
+
+// ================================================================================================= //
+//                                                                                                   //
+// Opt-in cache of read-only data in POSIX shared memory, shared between the processes on one node.  //
+// The first process to load some data (e.g. an ephemeris, or a band of SFTs) publishes it in a      //
+// shared-memory segment; later processes loading the same data attach to the segment instead. If   //
+// the cache is disabled, or anything goes wrong, callers simply load their data privately.          //
+//                                                                                                   //
+// ================================================================================================= //
+
+// Name of the environment variable which enables the cache; its value is used as a prefix for the
+// names of the shared-memory segments, e.g. LALPULSAR_SHM_CACHE=myjobs gives segments named
+// /dev/shm/myjobs.<kind>.<key> on Linux. Segments persist until removed, e.g. with rm /dev/shm/myjobs.*
+#define SHARED_CACHE_ENV "LALPULSAR_SHM_CACHE"
+
+// Time in seconds after which an incomplete segment, which has not been modified since, is assumed to
+// have been left by a publisher which crashed, and may be replaced by another publisher
+#ifndef SHARED_CACHE_STALE_TIMEOUT
+#define SHARED_CACHE_STALE_TIMEOUT 600
+#endif
+
+// Initial value of a cache key computed with XLALSharedCacheHash()
+#define SHARED_CACHE_KEY_INIT 0xcbf29ce484222325ULL
+
+// Return true if the cache is enabled, and shared memory is supported
+int XLALSharedCacheEnabled ( void );
+
+// Update a cache key 'key' with 'len' bytes of 'data'
+UINT8 XLALSharedCacheHash ( UINT8 key, const void *data, size_t len );
+
+// Update a cache key 'key' with the canonical name, size, and modification time of the file 'path'; returns 0 if the file cannot be found
+UINT8 XLALSharedCacheHashFile ( UINT8 key, const char *path );
+
+// Attach to the segment of type 'kind' for 'key', if it has been published; returns a pointer to its
+// contents, and their size in 'size', or NULL without raising an error. The contents are mapped
+// privately: if 'writable' is true they may be modified, which only copies the modified pages.
+void *XLALSharedCacheAttach ( const char *kind, UINT8 key, int writable, size_t *size );
+
+// Return true if 'ptr' points into a segment attached with XLALSharedCacheAttach()
+int XLALSharedCacheContains ( const void *ptr );
+
+// Detach from the segment which 'ptr' points into
+void XLALSharedCacheDetach ( const void *ptr );
+
+// Publish the 'numParts' blocks of data 'parts' of sizes 'sizes', concatenated, as the segment of type
+// 'kind' for 'key'; does nothing if the segment already exists, unless it has been left incomplete for
+// SHARED_CACHE_STALE_TIMEOUT seconds, in which case it is replaced. Failure to publish does not raise an
+// error, and only returns XLAL_FAILURE.
+int XLALSharedCachePublish ( const char *kind, UINT8 key, const void *const *parts, const size_t *sizes, UINT4 numParts );
+
+#endif // _SHAREDMEMORYCACHE_INTERNAL_H
@@ -28,24 +28,23 @@
 // main definition of lookup table code
 #include "SinCosLUT.i"
 
-static BOOLEAN haveLUT = 0;
+/* pthread locking to make LUT initialization thread-safe */
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+static pthread_once_t lutOnce = PTHREAD_ONCE_INIT;
+#define LUT_ONCE(init) pthread_once(&lutOnce, (init))
+#else
+static int lutOnce = 1;
+#define LUT_ONCE(init) (lutOnce ? (init)(), lutOnce = 0 : 0)
+#endif
 
 /* global VARIABLES to be used in (global) macros */
 UNUSED REAL4 sincosLUTbase[SINCOS_LUT_RES+SINCOS_LUT_RES/4];
 UNUSED REAL4 sincosLUTdiff[SINCOS_LUT_RES+SINCOS_LUT_RES/4];
 
-/*
- * LUT initialization. Normally not required for user, as will
- * be called transparently by sincosLUT functions.
- * Put here for certain specialized low-level usage in hotloops.
-*/
-void
-XLALSinCosLUTInit (void)
+static void
+sincos_lut_init (void)
 {
-  if ( haveLUT ) {
-    return;
-  }
-
   static const REAL8 step = LAL_TWOPI / (REAL8)SINCOS_LUT_RES;
   static const REAL8 divide  = 1.0 / ( 1 << SINCOS_SHIFT );
   REAL8 start, end, true_mid, linear_mid;
@@ -62,9 +61,18 @@ XLALSinCosLUTInit (void)
       start = end;
     } // for i < LUT_RES
 
-  haveLUT = 1;
-  return;
+} // sincos_lut_init()
 
+/*
+ * LUT initialization. Normally not required for user, as will
+ * be called transparently by sincosLUT functions.
+ * Put here for certain specialized low-level usage in hotloops,
+ * which should call it before starting any threads that use the LUT.
+*/
+void
+XLALSinCosLUTInit (void)
+{
+  LUT_ONCE ( sincos_lut_init );
 } // XLALSinCosLUTInit()
 
 ///
@@ -118,9 +126,7 @@ int XLALSinCos2PiLUTtrimmed ( REAL4 *s, REAL4 *c, REAL8 x )
 #endif
 
   /* the first time we get called, we set up the lookup-table */
-  if ( ! haveLUT ) {
-    XLALSinCosLUTInit();
-  }
+  XLALSinCosLUTInit();
 
   /* use the macros defined above */
   SINCOS_PROLOG
@@ -232,6 +232,72 @@ main ( int argc, char *argv[] )
 
     } // for iSky < numSkyPoints
 
+  // ----- test XLALComputeFstatParallel() and XLALComputeFstatBatch() against XLALComputeFstat()
+  {
+    const UINT4 numDopplers = 4;
+    PulsarDopplerParams dopplers[numDopplers];
+    for ( UINT4 i = 0; i < numDopplers; i ++ )
+      {
+        dopplers[i] = Doppler;
+        dopplers[i].Alpha += ( i / 2 ) * dSky;
+        dopplers[i].fkdot[1] += ( i % 2 ) * df1dot;
+      }
+    for ( UINT4 iMethod = FMETHOD_START; iMethod < FMETHOD_END; iMethod ++ )
+      {
+        if ( !XLALFstatMethodIsAvailable(iMethod) || (iMethod == FMETHOD_DEMOD_BEST) || (iMethod == FMETHOD_RESAMP_BEST) ) {
+          continue;
+        }
+        FstatResults *results_serial = NULL, *results_parallel = NULL;
+        FstatResults *results_batch[numDopplers];
+        XLAL_INIT_MEM ( results_batch );
+        XLAL_CHECK ( XLALComputeFstatBatch ( results_batch, input_seg1[iMethod], dopplers, numDopplers, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+        for ( UINT4 i = 0; i < numDopplers; i ++ )
+          {
+            XLAL_CHECK ( XLALComputeFstat ( &results_serial, input_seg1[iMethod], &dopplers[i], numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+            XLAL_CHECK ( XLALComputeFstatParallel ( &results_parallel, input_seg1[iMethod], &dopplers[i], numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+            XLALPrintInfo ( "Comparing results between XLALComputeFstat(), XLALComputeFstatParallel() and XLALComputeFstatBatch() for method '%s'\n", XLALGetFstatInputMethodName(input_seg1[iMethod]) );
+            XLAL_CHECK ( compareFstatResults ( results_serial, results_parallel ) == XLAL_SUCCESS, XLAL_EFUNC, "Comparison with XLALComputeFstatParallel() failed for method '%s'", XLALGetFstatInputMethodName(input_seg1[iMethod]) );
+            XLAL_CHECK ( compareFstatResults ( results_serial, results_batch[i] ) == XLAL_SUCCESS, XLAL_EFUNC, "Comparison with XLALComputeFstatBatch() failed for method '%s'", XLALGetFstatInputMethodName(input_seg1[iMethod]) );
+            XLAL_CHECK ( XLALGPSCmp ( &results_serial->refTimePhase, &results_batch[i]->refTimePhase ) == 0, XLAL_EFAILED );
+            XLALDestroyFstatResults ( results_batch[i] );
+          }
+        XLALDestroyFstatResults ( results_serial );
+        XLALDestroyFstatResults ( results_parallel );
+      }
+  }
+
+  // ----- test Demod hotloops which allow any Dterms with an odd Dterms, so that the number of
+  // Dirichlet kernel terms is not a multiple of the vector length: this exercises the scalar
+  // remainder of the AVX2 hotloop and the masked tail of the AVX-512 hotloop
+  {
+    const FstatMethodType anyDtermsMethods[] = { FMETHOD_DEMOD_AVX2, FMETHOD_DEMOD_AVX512 };
+    FstatOptionalArgs oddDtermsArgs = optionalArgs;
+    oddDtermsArgs.Dterms = 7;
+    oddDtermsArgs.prevInput = NULL;
+    oddDtermsArgs.FstatMethod = FMETHOD_DEMOD_GENERIC;
+    FstatInput *input_generic = NULL;
+    FstatResults *results_generic = NULL;
+    XLAL_CHECK ( (input_generic = XLALCreateFstatInput ( catalog, minCoverFreq, maxCoverFreq, dFreq, ephem, &oddDtermsArgs )) != NULL, XLAL_EFUNC );
+    XLAL_CHECK ( XLALComputeFstat ( &results_generic, input_generic, &Doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+    for ( UINT4 i = 0; i < XLAL_NUM_ELEM(anyDtermsMethods); i ++ )
+      {
+        if ( !XLALFstatMethodIsAvailable(anyDtermsMethods[i]) ) {
+          continue;
+        }
+        oddDtermsArgs.FstatMethod = anyDtermsMethods[i];
+        FstatInput *input_odd = NULL;
+        FstatResults *results_odd = NULL;
+        XLAL_CHECK ( (input_odd = XLALCreateFstatInput ( catalog, minCoverFreq, maxCoverFreq, dFreq, ephem, &oddDtermsArgs )) != NULL, XLAL_EFUNC );
+        XLAL_CHECK ( XLALComputeFstat ( &results_odd, input_odd, &Doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLALPrintInfo ( "Comparing results between method '%s' and '%s' with Dterms=%u\n", XLALGetFstatInputMethodName(input_generic), XLALGetFstatInputMethodName(input_odd), oddDtermsArgs.Dterms );
+        XLAL_CHECK ( compareFstatResults ( results_generic, results_odd ) == XLAL_SUCCESS, XLAL_EFUNC, "Comparison with method '%s' failed for Dterms=%u", XLALGetFstatInputMethodName(input_odd), oddDtermsArgs.Dterms );
+        XLALDestroyFstatResults ( results_odd );
+        XLALDestroyFstatInput ( input_odd );
+      }
+    XLALDestroyFstatResults ( results_generic );
+    XLALDestroyFstatInput ( input_generic );
+  }
+
   // ----- test XLALFstatInputTimeslice()
   // setup optional Fstat arguments
   optionalArgs.FstatMethod = FMETHOD_DEMOD_BEST; // only use demod best
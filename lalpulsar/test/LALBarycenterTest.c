@@ -45,6 +45,11 @@
  *
  */
 
+#include <stddef.h>
+#include <stdio.h>
+#include <time.h>
+#include <utime.h>
+
 #include <lal/LALBarycenter.h>
 #include <lal/LALInitBarycenter.h>
 #include <lal/DetectorSite.h>
@@ -55,6 +60,8 @@
 
 /* ----- internal prototype ---------- */
 int compare_ephemeris ( const EphemerisData *edat1, const EphemerisData *edat2 );
+int copy_file ( const char *dest, const char *src );
+int set_file_age ( const char *fname, time_t age );
 REAL8 relerr(REAL8 x, REAL8 xapprox);
 
 inline REAL8 relerr ( REAL8 x, REAL8 xapprox )
@@ -210,6 +217,159 @@ main( void )
   XLALPrintError ("XLALBarycenter() 	%g s\n", tau / counter );
   XLALPrintError ("XLALBarycenterOpt()	%g s (= %.1f %%)\n", tau_opt / counter,  - 100 * (tau - tau_opt ) / tau );
 
+  /* ===== test XLALBarycenterEarthBatch() ===== */
+  XLALPrintInfo("\n\nTesting XLALBarycenterEarthBatch() ... ");
+  {
+    /* runs of timestamps spaced by 1800 s, interrupted by irregular gaps */
+    const UINT4 numTimes = 500;
+    LIGOTimeGPS *tBatch = XLALCalloc ( numTimes, sizeof(*tBatch) );
+    EarthState *earthBatch = XLALCalloc ( numTimes, sizeof(*earthBatch) );
+    XLAL_CHECK_MAIN( tBatch != NULL && earthBatch != NULL, XLAL_ENOMEM );
+    for ( UINT4 i = 0; i < numTimes; i ++ ) {
+      tBatch[i].gpsSeconds = t1998 + 86400 + 1800 * i + 7 * ( i / 100 ) + ( i % 37 == 0 ? 1 : 0 );
+      tBatch[i].gpsNanoSeconds = 123456789;
+    }
+    XLAL_CHECK_MAIN( XLALBarycenterEarthBatch ( earthBatch, tBatch, numTimes, edat, NULL, TIMECORRECTION_ORIGINAL ) == XLAL_SUCCESS, XLAL_EFUNC );
+    for ( UINT4 i = 0; i < numTimes; i ++ ) {
+      XLAL_CHECK_MAIN( XLALBarycenterEarth ( &earth, &tBatch[i], edat ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( fabs ( earthBatch[i].einstein - earth.einstein ) < 1e-15, XLAL_EFAILED, "\nTest FAILED: einstein %.16g != %.16g at i=%u\n", earthBatch[i].einstein, earth.einstein, i );
+      XLAL_CHECK_MAIN( fabs ( earthBatch[i].deinstein - earth.deinstein ) < 1e-20, XLAL_EFAILED, "\nTest FAILED: deinstein %.16g != %.16g at i=%u\n", earthBatch[i].deinstein, earth.deinstein, i );
+      earthBatch[i].einstein = earth.einstein;
+      earthBatch[i].deinstein = earth.deinstein;
+      XLAL_CHECK_MAIN( memcmp ( &earthBatch[i], &earth, offsetof ( EarthState, ttype ) ) == 0 && earthBatch[i].ttype == earth.ttype, XLAL_EFAILED, "\nTest FAILED: earth-states differ at i=%u\n", i );
+    }
+
+    /* a timestamp outside the ephemeris fails */
+    tBatch[numTimes - 1].gpsSeconds = t1998 + 5e7;
+    XLAL_CHECK_MAIN( XLALBarycenterEarthBatch ( earthBatch, tBatch, numTimes, edat, NULL, TIMECORRECTION_ORIGINAL ) == XLAL_FAILURE, XLAL_EFAILED, "Expected XLALBarycenterEarthBatch() to fail!" );
+    XLALClearErrno();
+
+    XLALFree ( tBatch );
+    XLALFree ( earthBatch );
+  }
+  XLALPrintInfo("PASSED\n\n");
+
+  /* ===== test XLALBarycenterSkyCoeffs() and XLALBarycenterSkyBlock() ===== */
+  XLALPrintInfo("\n\nTesting XLALBarycenterSkyBlock() ... ");
+  {
+    /* random sky-positions, the first few of them behind the Sun */
+    const UINT4 numSky = 100, numBehindSun = 5;
+    REAL8 nx[numSky], ny[numSky], nz[numSky], alpha[numSky], delta[numSky], deltaT[numSky], tDot[numSky];
+    REAL8 maxDiffDeltaT = 0, maxDiffTdot = 0;
+    for ( UINT4 i = 0; i < 50; i ++ )
+      {
+        REAL8 tPulse = t1998 + ( 1.0 * rand() / RAND_MAX ) * LAL_YRSID_SI;	// t in [1998, 1999]
+        XLALGPSSetREAL8( &tGPS, tPulse );
+        baryinput.tgps = tGPS;
+        baryinput.dInv = 0;
+        XLAL_CHECK_MAIN( XLALBarycenterEarth ( &earth, &tGPS, edat ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+        for ( UINT4 s = 0; s < numSky; s ++ )
+          {
+            if ( s < numBehindSun )
+              {
+                REAL8 n[3];
+                for ( UINT4 j = 0; j < 3; j ++ )
+                  n[j] = - earth.se[j] / earth.rse + 1e-3 * ( 1.0 * rand() / RAND_MAX - 0.5 );
+                alpha[s] = atan2 ( n[1], n[0] );
+                delta[s] = asin ( n[2] / sqrt ( n[0]*n[0] + n[1]*n[1] + n[2]*n[2] ) );
+              }
+            else
+              {
+                alpha[s] = ( 1.0 * rand() / RAND_MAX ) * LAL_TWOPI;	// in [0, 2pi]
+                delta[s] = ( 1.0 * rand() / RAND_MAX ) * LAL_PI - LAL_PI_2;// in [-pi/2, pi/2]
+              }
+            nx[s] = cos ( alpha[s] ) * cos ( delta[s] );
+            ny[s] = sin ( alpha[s] ) * cos ( delta[s] );
+            nz[s] = sin ( delta[s] );
+          }
+
+        BarycenterSkyCoeffs coeffs;
+        XLAL_CHECK_MAIN( XLALBarycenterSkyCoeffs ( &coeffs, &baryinput, &earth ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK_MAIN( XLALBarycenterSkyBlock ( deltaT, tDot, &coeffs, nx, ny, nz, numSky ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+        for ( UINT4 s = 0; s < numSky; s ++ )
+          {
+            baryinput.alpha = alpha[s];
+            baryinput.delta = delta[s];
+            XLAL_CHECK_MAIN( XLALBarycenterOpt ( &emit_opt, &baryinput, &earth, &buffer ) == XLAL_SUCCESS, XLAL_EFUNC );
+            maxDiffDeltaT = fmax ( maxDiffDeltaT, fabs ( deltaT[s] - emit_opt.deltaT ) );
+            maxDiffTdot = fmax ( maxDiffTdot, fabs ( tDot[s] - emit_opt.tDot ) );
+          }
+      }
+    XLALFree ( buffer );
+    buffer = NULL;
+    XLALPrintInfo ( "Max error between XLALBarycenterOpt() and XLALBarycenterSkyBlock(): deltaT = %g s, tDot = %g ... ", maxDiffDeltaT, maxDiffTdot );
+    XLAL_CHECK_MAIN( maxDiffDeltaT < tolerance, XLAL_EFAILED, "\nTest FAILED: deltaT differs by %g s, exceeding tolerance of %g s\n", maxDiffDeltaT, tolerance );
+    XLAL_CHECK_MAIN( maxDiffTdot < 1e-14, XLAL_EFAILED, "\nTest FAILED: tDot differs by %g, exceeding tolerance of %g\n", maxDiffTdot, 1e-14 );
+
+    /* finite-distance correction is not supported */
+    baryinput.dInv = 1e-5;
+    BarycenterSkyCoeffs coeffs;
+    XLAL_CHECK_MAIN( XLALBarycenterSkyCoeffs ( &coeffs, &baryinput, &earth ) == XLAL_FAILURE, XLAL_EFAILED, "Expected XLALBarycenterSkyCoeffs() to fail!" );
+    XLALClearErrno();
+    baryinput.dInv = 0;
+  }
+  XLALPrintInfo("PASSED\n\n");
+
+  /* ===== test XLALWriteBinaryEphemerisFile() ===== */
+  XLALPrintInfo("\n\nTesting XLALWriteBinaryEphemerisFile() ... ");
+  {
+    const char eEphFileBin[] = "LALBarycenterTest_earth98.bin";
+    const char sEphFileBin[] = "LALBarycenterTest_sun98.bin";
+    XLAL_CHECK_MAIN( XLALWriteBinaryEphemerisFile ( eEphFileBin, eEphFile ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALWriteBinaryEphemerisFile ( sEphFileBin, sEphFile ) == XLAL_SUCCESS, XLAL_EFUNC );
+    EphemerisData *edatBin = XLALInitBarycenter ( eEphFileBin, sEphFileBin );
+    XLAL_CHECK_MAIN( edatBin != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( compare_ephemeris ( edat, edatBin ) == XLAL_SUCCESS, XLAL_EFAILED, "\nTest FAILED: binary ephemeris differs from ASCII ephemeris\n" );
+    XLALDestroyEphemerisData ( edatBin );
+
+    /* a truncated binary ephemeris-file is rejected */
+    char buf[100];
+    FILE *fp = fopen ( eEphFileBin, "rb" );
+    XLAL_CHECK_MAIN( fp != NULL && fread ( buf, 1, sizeof(buf), fp ) == sizeof(buf), XLAL_EIO );
+    fclose ( fp );
+    fp = fopen ( eEphFileBin, "wb" );
+    XLAL_CHECK_MAIN( fp != NULL && fwrite ( buf, 1, sizeof(buf), fp ) == sizeof(buf), XLAL_EIO );
+    fclose ( fp );
+    XLAL_CHECK_MAIN( XLALInitBarycenter ( eEphFileBin, sEphFileBin ) == NULL, XLAL_EFAILED, "Expected XLALInitBarycenter( '%s', '%s' ) to fail!", eEphFileBin, sEphFileBin );
+    XLALClearErrno();
+
+    remove ( eEphFileBin );
+    remove ( sEphFileBin );
+  }
+  {
+    /* a binary ephemeris-file alongside the ASCII ephemeris-file is read in its place ... */
+    const char eEphFileCopy[] = "LALBarycenterTest_earth98.dat", eEphFileCopyBin[] = "LALBarycenterTest_earth98.dat.bin";
+    const char sEphFileCopy[] = "LALBarycenterTest_sun98.dat", sEphFileCopyBin[] = "LALBarycenterTest_sun98.dat.bin";
+    XLAL_CHECK_MAIN( copy_file ( eEphFileCopy, eEphFile ) == XLAL_SUCCESS && copy_file ( sEphFileCopy, sEphFile ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALWriteBinaryEphemerisFile ( NULL, eEphFileCopy ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALWriteBinaryEphemerisFile ( NULL, sEphFileCopy ) == XLAL_SUCCESS, XLAL_EFUNC );
+    FILE *fp = fopen ( eEphFileCopy, "w" );
+    XLAL_CHECK_MAIN( fp != NULL && fprintf ( fp, "not an ephemeris-file\n" ) > 0 && fclose ( fp ) == 0, XLAL_EIO );
+    XLAL_CHECK_MAIN( set_file_age ( eEphFileCopy, 3600 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    EphemerisData *edatBin = XLALInitBarycenter ( eEphFileCopy, sEphFileCopy );
+    XLAL_CHECK_MAIN( edatBin != NULL, XLAL_EFUNC, "Binary ephemeris-file '%s' was not read in place of '%s'", eEphFileCopyBin, eEphFileCopy );
+    XLAL_CHECK_MAIN( compare_ephemeris ( edat, edatBin ) == XLAL_SUCCESS, XLAL_EFAILED, "\nTest FAILED: binary ephemeris read in place of ASCII ephemeris differs\n" );
+    XLALDestroyEphemerisData ( edatBin );
+
+    /* ... unless it is older than the ASCII ephemeris-file */
+    XLAL_CHECK_MAIN( copy_file ( eEphFileCopy, eEphFile ) == XLAL_SUCCESS, XLAL_EFUNC );
+    fp = fopen ( eEphFileCopyBin, "w" );
+    XLAL_CHECK_MAIN( fp != NULL && fprintf ( fp, "not a binary ephemeris-file\n" ) > 0 && fclose ( fp ) == 0, XLAL_EIO );
+    XLAL_CHECK_MAIN( set_file_age ( eEphFileCopyBin, 3600 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    edatBin = XLALInitBarycenter ( eEphFileCopy, sEphFileCopy );
+    XLAL_CHECK_MAIN( edatBin != NULL, XLAL_EFUNC, "Binary ephemeris-file '%s' older than '%s' was not ignored", eEphFileCopyBin, eEphFileCopy );
+    XLAL_CHECK_MAIN( compare_ephemeris ( edat, edatBin ) == XLAL_SUCCESS, XLAL_EFAILED, "\nTest FAILED: ASCII ephemeris read in place of older binary ephemeris differs\n" );
+    XLALDestroyEphemerisData ( edatBin );
+
+    remove ( eEphFileCopy );
+    remove ( eEphFileCopyBin );
+    remove ( sEphFileCopy );
+    remove ( sEphFileCopyBin );
+  }
+  XLALPrintInfo("PASSED\n\n");
+
   /* ===== test XLALRestrictEphemerisData() ===== */
   XLALPrintInfo("\n\nTesting XLALRestrictEphemerisData() ... ");
   {
@@ -417,6 +577,42 @@ compare_ephemeris ( const EphemerisData *edat1, const EphemerisData *edat2 )
 
 } /* compare_ephemeris() */
 
+/* copy the file 'src' to 'dest' */
+int
+copy_file ( const char *dest, const char *src )
+{
+  FILE *in = fopen ( src, "rb" ), *out = fopen ( dest, "wb" );
+  if ( in == NULL || out == NULL ) {
+    if ( in != NULL ) fclose ( in );
+    if ( out != NULL ) fclose ( out );
+    XLAL_ERROR ( XLAL_EIO, "Failed to open '%s' or '%s'\n", src, dest );
+  }
+  char buf[4096];
+  size_t n;
+  int errnum = XLAL_SUCCESS;
+  while ( errnum == XLAL_SUCCESS && ( n = fread ( buf, 1, sizeof(buf), in ) ) > 0 ) {
+    if ( fwrite ( buf, 1, n, out ) != n )
+      errnum = XLAL_EIO;
+  }
+  fclose ( in );
+  if ( fclose ( out ) != 0 )
+    errnum = XLAL_EIO;
+  XLAL_CHECK ( errnum == XLAL_SUCCESS, errnum, "Failed to copy '%s' to '%s'\n", src, dest );
+  return XLAL_SUCCESS;
+
+} /* copy_file() */
+
+/* set the access and modification times of the file 'fname' to 'age' seconds ago */
+int
+set_file_age ( const char *fname, time_t age )
+{
+  struct utimbuf times;
+  times.actime = times.modtime = time ( NULL ) - age;
+  XLAL_CHECK ( utime ( fname, &times ) == 0, XLAL_EIO, "Failed to set modification time of '%s'\n", fname );
+  return XLAL_SUCCESS;
+
+} /* set_file_age() */
+
 /* return differences in all fields from EmissionTime struct */
 int
 diffEmissionTime ( EmissionTime *diff, const EmissionTime *emit1, const EmissionTime *emit2 )
@@ -223,6 +223,68 @@ int main( void )
       } /* for X < numIFOs */
   } /* ------ */
 
+  /* write an SFT catalog index, read it back, and compare SFTs loaded from it with XLALLoadMultiSFTsMapped() */
+  {
+    SFTCatalog *catalog2 = NULL;
+    MappedMultiSFTVector *mapped = NULL;
+    XLAL_CHECK_MAIN ( ( catalog = XLALSFTdataFind ( TEST_DATA_DIR "SFT-test[123]*;" TEST_DATA_DIR "SFT-test[5]*", NULL ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( XLALWriteSFTCatalogIndex ( catalog, "SFTcatalog_index.dat" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( ( catalog2 = XLALSFTdataFind ( "index:SFTcatalog_index.dat", NULL ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( catalog2->length == catalog->length, XLAL_EFAILED, "SFT catalog index has %u SFTs instead of %u\n", catalog2->length, catalog->length );
+    for ( UINT4 i = 0; i < catalog->length; i ++ )
+      {
+        const SFTDescriptor *desc1 = &catalog->data[i], *desc2 = &catalog2->data[i];
+        XLAL_CHECK_MAIN ( XLALGPSCmp ( &desc1->header.epoch, &desc2->header.epoch ) == 0 && desc1->header.f0 == desc2->header.f0 && desc1->header.deltaF == desc2->header.deltaF
+                          && desc1->numBins == desc2->numBins && desc1->crc64 == desc2->crc64, XLAL_EFAILED, "SFT descriptor %u differs when read from SFT catalog index\n", i );
+      }
+    XLALDestroySFTCatalog(catalog);
+
+    XLAL_CHECK_MAIN ( ( mapped = XLALLoadMultiSFTsMapped ( catalog2, -1, -1 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( mapped->multiSFTs->length == multsft_vect->length, XLAL_EFAILED );
+    for ( UINT4 X = 0; X < multsft_vect->length; X ++ )
+      {
+        XLAL_CHECK_MAIN ( CompareSFTVectors ( multsft_vect->data[X], mapped->multiSFTs->data[X] ) == 0, XLAL_EFAILED, "XLALLoadMultiSFTsMapped(): sft-vectors differ for X=%d\n", X );
+      }
+    XLALDestroyMappedMultiSFTVector ( mapped );
+    XLALDestroySFTCatalog(catalog2);
+  }
+
+  /* an SFT file rewritten after its SFT catalog index was written is scanned again */
+  {
+    SFTCatalog *catalog2 = NULL;
+    XLAL_CHECK_MAIN ( XLALWriteSFT2file ( &(multsft_vect->data[0]->data[0]), "SFTindex_test1.sft", "first SFT" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( XLALWriteSFT2file ( &(multsft_vect->data[0]->data[1]), "SFTindex_test2.sft", "second SFT" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( ( catalog = XLALSFTdataFind ( "SFTindex_test?.sft", NULL ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( XLALWriteSFTCatalogIndex ( catalog, "SFTindex_test.dat" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroySFTCatalog(catalog);
+
+    /* the longer comment, padded to a multiple of 8 bytes, changes the size of the file */
+    XLAL_CHECK_MAIN ( XLALWriteSFT2file ( &(multsft_vect->data[0]->data[2]), "SFTindex_test2.sft", "rewritten second SFT" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( ( catalog = XLALSFTdataFind ( "SFTindex_test?.sft", NULL ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( ( catalog2 = XLALSFTdataFind ( "index:SFTindex_test.dat", NULL ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( catalog2->length == catalog->length, XLAL_EFAILED, "SFT catalog index has %u SFTs instead of %u\n", catalog2->length, catalog->length );
+    for ( UINT4 i = 0; i < catalog->length; i ++ )
+      {
+        const SFTDescriptor *desc1 = &catalog->data[i], *desc2 = &catalog2->data[i];
+        XLAL_CHECK_MAIN ( XLALGPSCmp ( &desc1->header.epoch, &desc2->header.epoch ) == 0 && desc1->numBins == desc2->numBins && desc1->crc64 == desc2->crc64,
+                          XLAL_EFAILED, "SFT descriptor %u differs when read from stale SFT catalog index\n", i );
+        /* only the SFT of the scanned file has its comment */
+        const BOOLEAN rewritten = ( XLALGPSCmp ( &desc2->header.epoch, &multsft_vect->data[0]->data[2].epoch ) == 0 );
+        XLAL_CHECK_MAIN ( rewritten ? ( desc2->comment != NULL && strstr ( desc2->comment, "rewritten second SFT" ) != NULL ) : ( desc2->comment == NULL ),
+                          XLAL_EFAILED, "SFT descriptor %u was not %s\n", i, rewritten ? "scanned again" : "read from SFT catalog index" );
+      }
+    XLALDestroySFTCatalog(catalog);
+    XLALDestroySFTCatalog(catalog2);
+
+    /* file names containing comment characters cannot be indexed */
+    XLAL_CHECK_MAIN ( XLALWriteSFT2file ( &(multsft_vect->data[0]->data[0]), "SFTindex_test%1.sft", NULL ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( ( catalog = XLALSFTdataFind ( "SFTindex_test%1.sft", NULL ) ) != NULL, XLAL_EFUNC );
+    int errnum;
+    XLAL_TRY ( XLALWriteSFTCatalogIndex ( catalog, "SFTindex_test.dat" ), errnum );
+    XLAL_CHECK_MAIN ( errnum == XLAL_EINVAL, XLAL_EFAILED, "XLALWriteSFTCatalogIndex() should fail with XLAL_EINVAL for a file name containing '%%', got %d\n", errnum );
+    XLALDestroySFTCatalog(catalog);
+  }
+
   /* ----- v2 SFT writing ----- */
   /* write v2-SFT to disk */
   XLAL_CHECK_MAIN ( XLALWriteSFT2file(&(multsft_vect->data[0]->data[0]), "outputsftv2_r1.sft", "A v2-SFT file for testing!") == XLAL_SUCCESS, XLAL_EFUNC );
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2026
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include <lal/XLALError.h>
+#include <lal/LALInitBarycenter.h>
+#include <lal/DetectorStates.h>
+#include <lal/SSBtimes.h>
+#include <lal/SFTutils.h>
+#include <lal/LALString.h>
+
+/**
+ * \file
+ * \ingroup SSBtimes_h
+ * \brief Tests for XLALGetMultiSSBtimesSky()
+ *
+ * The SSB timings of a few blocks of sky-positions are compared, for each SSB precision, with
+ * those of XLALGetMultiSSBtimes() for each sky-position; the output structs allocated by the
+ * first call are re-used for all later ones.
+ */
+
+// number of sky-positions: more than two blocks of XLALGetMultiSSBtimesSky()
+#define NUM_SKY 133
+
+// tolerances: the relativistic emission times are rounded to nanoseconds, and
+// XLALGetMultiSSBtimes() with SSBPREC_RELATIVISTIC uses XLALBarycenter() rather than XLALBarycenterOpt()
+#define TOL_DELTAT_NEWTONIAN	1e-9
+#define TOL_TDOT_NEWTONIAN	1e-14
+#define TOL_DELTAT_RELATIVISTIC	2e-9
+#define TOL_TDOT_RELATIVISTIC	1e-12
+
+static int compare_MultiSSBtimes ( const MultiSSBtimes *multiSSB1, const MultiSSBtimes *multiSSB2, REAL8 tolDeltaT, REAL8 tolTdot );
+
+int main ( void )
+{
+
+  // Set up detectors, timestamps and ephemerides
+  LALStringVector *detNames = NULL;
+  XLAL_CHECK_MAIN ( ( detNames = XLALCreateStringVector ( "H1", "L1", NULL ) ) != NULL, XLAL_EFUNC );
+  MultiLALDetector multiIFO;
+  XLAL_CHECK_MAIN ( XLALParseMultiLALDetector ( &multiIFO, detNames ) == XLAL_SUCCESS, XLAL_EFUNC );
+  const REAL8 Tsft = 1800;
+  const LIGOTimeGPS startTime = { 818845553, 0 };
+  MultiLIGOTimeGPSVector *multiTS = NULL;
+  XLAL_CHECK_MAIN ( ( multiTS = XLALMakeMultiTimestamps ( startTime, 2 * LAL_DAYSID_SI, Tsft, 0, multiIFO.length ) ) != NULL, XLAL_EFUNC );
+  EphemerisData *edat = NULL;
+  XLAL_CHECK_MAIN ( ( edat = XLALInitBarycenter ( TEST_PKG_DATA_DIR "earth00-19-DE405.dat.gz", TEST_PKG_DATA_DIR "sun00-19-DE405.dat.gz" ) ) != NULL, XLAL_EFUNC );
+  MultiDetectorStateSeries *multiDetStates = NULL;
+  XLAL_CHECK_MAIN ( ( multiDetStates = XLALGetMultiDetectorStates ( multiTS, &multiIFO, edat, 0.5 * Tsft ) ) != NULL, XLAL_EFUNC );
+
+  // Pick sky-positions at random, over the whole allowed range of longitudes
+  srand ( 4321 );
+  SkyPosition skypos[NUM_SKY];
+  for ( UINT4 s = 0; s < NUM_SKY; ++s )
+    {
+      skypos[s].longitude = LAL_TWOPI * ( 2.0 * rand() / RAND_MAX - 1.0 );	// alpha uniform in [-2pi, 2pi]
+      skypos[s].latitude = LAL_PI_2 - acos ( 1 - 2.0 * rand() / RAND_MAX );	// sin(delta) uniform in [-1,1]
+      skypos[s].system = COORDINATESYSTEM_EQUATORIAL;
+    }
+
+  // Output structs, allocated by the first call to XLALGetMultiSSBtimesSky()
+  MultiSSBtimes *multiSSBsky[NUM_SKY];
+  for ( UINT4 s = 0; s < NUM_SKY; ++s )
+    {
+      multiSSBsky[s] = NULL;
+    }
+
+  const SSBprecision precisions[] = { SSBPREC_NEWTONIAN, SSBPREC_RELATIVISTIC, SSBPREC_RELATIVISTICOPT, SSBPREC_DMOFF };
+  for ( UINT4 p = 0; p < sizeof ( precisions ) / sizeof ( precisions[0] ); ++p )
+    {
+      const SSBprecision precision = precisions[p];
+      const BOOLEAN relativistic = ( precision == SSBPREC_RELATIVISTIC || precision == SSBPREC_RELATIVISTICOPT );
+      const REAL8 tolDeltaT = relativistic ? TOL_DELTAT_RELATIVISTIC : TOL_DELTAT_NEWTONIAN;
+      const REAL8 tolTdot = relativistic ? TOL_TDOT_RELATIVISTIC : TOL_TDOT_NEWTONIAN;
+
+      MultiSSBskyCoeffs *coeffs = NULL;
+      XLAL_CHECK_MAIN ( ( coeffs = XLALCreateMultiSSBskyCoeffs ( multiDetStates, precision ) ) != NULL, XLAL_EFUNC );
+
+      // Compute the timings of all sky-positions twice, with different reference times and
+      // with the sky-positions in reverse order the second time
+      for ( UINT4 pass = 0; pass < 2; ++pass )
+        {
+          LIGOTimeGPS refTime = startTime;
+          XLALGPSAdd ( &refTime, pass == 0 ? 0.0 : LAL_DAYSID_SI + 0.123456789 );
+          SkyPosition passSkypos[NUM_SKY];
+          for ( UINT4 s = 0; s < NUM_SKY; ++s )
+            {
+              passSkypos[s] = skypos[ pass == 0 ? s : NUM_SKY - 1 - s ];
+            }
+
+          XLAL_CHECK_MAIN ( XLALGetMultiSSBtimesSky ( multiSSBsky, coeffs, passSkypos, NUM_SKY, refTime ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+          for ( UINT4 s = 0; s < NUM_SKY; ++s )
+            {
+              MultiSSBtimes *multiSSB = NULL;
+              XLAL_CHECK_MAIN ( ( multiSSB = XLALGetMultiSSBtimes ( multiDetStates, passSkypos[s], refTime, precision ) ) != NULL, XLAL_EFUNC );
+              XLAL_CHECK_MAIN ( compare_MultiSSBtimes ( multiSSBsky[s], multiSSB, tolDeltaT, tolTdot ) == XLAL_SUCCESS, XLAL_EFUNC,
+                                "Test FAILED for precision=%d, pass %u, sky-position %u", precision, pass, s );
+              XLALDestroyMultiSSBtimes ( multiSSB );
+            }
+        }
+
+      XLALDestroyMultiSSBskyCoeffs ( coeffs );
+    }
+
+  // Output structs with a different number of detectors cannot be re-used
+  {
+    MultiDetectorStateSeries singleDetStates = { .length = 1, .data = multiDetStates->data };
+    MultiSSBskyCoeffs *coeffs = NULL;
+    XLAL_CHECK_MAIN ( ( coeffs = XLALCreateMultiSSBskyCoeffs ( &singleDetStates, SSBPREC_NEWTONIAN ) ) != NULL, XLAL_EFUNC );
+    int errnum = 0;
+    XLAL_TRY ( XLALGetMultiSSBtimesSky ( multiSSBsky, coeffs, skypos, NUM_SKY, startTime ), errnum );
+    XLAL_CHECK_MAIN ( errnum == XLAL_EINVAL, XLAL_EFAILED, "Expected XLALGetMultiSSBtimesSky() to fail with XLAL_EINVAL, got %d", errnum );
+    XLALDestroyMultiSSBskyCoeffs ( coeffs );
+  }
+
+  // Cleanup
+  for ( UINT4 s = 0; s < NUM_SKY; ++s )
+    {
+      XLALDestroyMultiSSBtimes ( multiSSBsky[s] );
+    }
+  XLALDestroyMultiDetectorStateSeries ( multiDetStates );
+  XLALDestroyEphemerisData ( edat );
+  XLALDestroyMultiTimestamps ( multiTS );
+  XLALDestroyStringVector ( detNames );
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+} // main()
+
+// Compare two MultiSSBtimes, which must have the same reference time and lengths
+static int
+compare_MultiSSBtimes ( const MultiSSBtimes *multiSSB1, const MultiSSBtimes *multiSSB2, REAL8 tolDeltaT, REAL8 tolTdot )
+{
+  XLAL_CHECK ( multiSSB1->length == multiSSB2->length, XLAL_EFAILED, "Numbers of detectors differ: %u != %u", multiSSB1->length, multiSSB2->length );
+  for ( UINT4 X = 0; X < multiSSB1->length; ++X )
+    {
+      const SSBtimes *t1 = multiSSB1->data[X], *t2 = multiSSB2->data[X];
+      XLAL_CHECK ( XLALGPSCmp ( &t1->refTime, &t2->refTime ) == 0, XLAL_EFAILED, "Reference times differ for X=%u", X );
+      XLAL_CHECK ( t1->DeltaT->length == t2->DeltaT->length && t1->Tdot->length == t2->Tdot->length, XLAL_EFAILED, "Numbers of timestamps differ for X=%u", X );
+      for ( UINT4 i = 0; i < t1->DeltaT->length; ++i )
+        {
+          const REAL8 errDeltaT = fabs ( t1->DeltaT->data[i] - t2->DeltaT->data[i] );
+          const REAL8 errTdot = fabs ( t1->Tdot->data[i] - t2->Tdot->data[i] );
+          XLAL_CHECK ( errDeltaT <= tolDeltaT, XLAL_EFAILED, "DeltaT differs by %g s, exceeding tolerance of %g s, for X=%u, i=%u", errDeltaT, tolDeltaT, X, i );
+          XLAL_CHECK ( errTdot <= tolTdot, XLAL_EFAILED, "Tdot differs by %g, exceeding tolerance of %g, for X=%u, i=%u", errTdot, tolTdot, X, i );
+        }
+    }
+  return XLAL_SUCCESS;
+}
@@ -0,0 +1,370 @@
+//
+// Copyright (C) 2026
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+///
+/// \file
+/// \brief Tests for the shared-memory cache of ephemerides and SFTs enabled by LALPULSAR_SHM_CACHE.
+///
+/// The segments of the cache are inspected, corrupted, and removed through /dev/shm, and the
+/// segments attached by this process are found in /proc/self/maps, so the test only runs on Linux.
+///
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALInitBarycenter.h>
+#include <lal/SFTfileIO.h>
+#include <lal/SFTutils.h>
+#include <lal/NormalizeSFTRngMed.h>
+
+#if !defined(__linux__)
+
+int main( void )
+{
+  fprintf( stderr, "Shared-memory segments cannot be inspected on this platform; skipping test\n" );
+  return 77;
+}
+
+#else // defined(__linux__)
+
+#include <unistd.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+#define SHM_DIR "/dev/shm/"
+
+#define EARTH_DE405 TEST_PKG_DATA_DIR "earth00-19-DE405.dat.gz"
+#define SUN_DE405   TEST_PKG_DATA_DIR "sun00-19-DE405.dat.gz"
+#define EARTH_DE200 TEST_PKG_DATA_DIR "earth00-19-DE200.dat.gz"
+#define SUN_DE200   TEST_PKG_DATA_DIR "sun00-19-DE200.dat.gz"
+
+// Prefix of the segments created by this test
+static char prefix[64];
+
+// Return the number of segments of type 'kind' in the cache, and the name of one of them other than 'exclude' in 'name'
+static int find_segments( const char *kind, const char *exclude, char *name, size_t namelen )
+{
+  char start[128];
+  snprintf( start, sizeof( start ), "%s.%s.", prefix, kind );
+  int count = 0;
+  DIR *dir = opendir( SHM_DIR );
+  XLAL_CHECK( dir != NULL, XLAL_ESYS, "Could not open " SHM_DIR );
+  for ( struct dirent *entry = readdir( dir ); entry != NULL; entry = readdir( dir ) ) {
+    if ( strncmp( entry->d_name, start, strlen( start ) ) == 0 ) {
+      ++count;
+      if ( name != NULL && ( exclude == NULL || strcmp( entry->d_name, exclude ) != 0 ) ) {
+        snprintf( name, namelen, "%s", entry->d_name );
+      }
+    }
+  }
+  closedir( dir );
+  return count;
+}
+
+// Return true if this process has a segment of type 'kind' attached
+static int segment_attached( const char *kind )
+{
+  char start[160];
+  snprintf( start, sizeof( start ), SHM_DIR "%s.%s.", prefix, kind );
+  int found = 0;
+  char line[4096];
+  FILE *fp = fopen( "/proc/self/maps", "r" );
+  XLAL_CHECK( fp != NULL, XLAL_ESYS, "Could not open /proc/self/maps" );
+  while ( !found && fgets( line, sizeof( line ), fp ) != NULL ) {
+    found = ( strstr( line, start ) != NULL );
+  }
+  fclose( fp );
+  return found;
+}
+
+// Change the size of the segment 'name' by 'delta' bytes
+static int resize_segment( const char *name, off_t delta )
+{
+  char path[256];
+  struct stat st;
+  snprintf( path, sizeof( path ), SHM_DIR "%s", name );
+  XLAL_CHECK( stat( path, &st ) == 0 && truncate( path, st.st_size + delta ) == 0, XLAL_ESYS, "Could not resize '%s'", path );
+  return XLAL_SUCCESS;
+}
+
+// Replace the contents of the segment 'name' with those of the segment 'source'
+static int copy_segment( const char *name, const char *source )
+{
+  char path[256], srcpath[256];
+  snprintf( path, sizeof( path ), SHM_DIR "%s", name );
+  snprintf( srcpath, sizeof( srcpath ), SHM_DIR "%s", source );
+  FILE *in = fopen( srcpath, "rb" ), *out = fopen( path, "wb" );
+  XLAL_CHECK( in != NULL && out != NULL, XLAL_ESYS, "Could not open '%s' or '%s'", srcpath, path );
+  char buf[65536];
+  size_t n;
+  while ( ( n = fread( buf, 1, sizeof( buf ), in ) ) > 0 ) {
+    XLAL_CHECK( fwrite( buf, 1, n, out ) == n, XLAL_ESYS, "Could not write '%s'", path );
+  }
+  fclose( in );
+  fclose( out );
+  return XLAL_SUCCESS;
+}
+
+// Mark the segment 'name' as incomplete, as if its publisher had crashed 'age' seconds ago
+static int abandon_segment( const char *name, long age )
+{
+  char path[256];
+  snprintf( path, sizeof( path ), SHM_DIR "%s", name );
+  const UINT4 ready = 0;
+  const int fd = open( path, O_WRONLY );
+  XLAL_CHECK( fd >= 0, XLAL_ESYS, "Could not open '%s'", path );
+  const int written = ( pwrite( fd, &ready, sizeof( ready ), 24 ) == sizeof( ready ) );  // offset of 'ready' in the segment header
+  close( fd );
+  XLAL_CHECK( written, XLAL_ESYS, "Could not write '%s'", path );
+  struct timeval times[2];
+  XLAL_CHECK( gettimeofday( &times[0], NULL ) == 0, XLAL_ESYS );
+  times[0].tv_sec -= age;
+  times[1] = times[0];
+  XLAL_CHECK( utimes( path, times ) == 0, XLAL_ESYS, "Could not set modification time of '%s'", path );
+  return XLAL_SUCCESS;
+}
+
+// Remove all segments created by this test
+static void remove_segments( void )
+{
+  char start[80];
+  snprintf( start, sizeof( start ), "%s.", prefix );
+  DIR *dir = opendir( SHM_DIR );
+  if ( dir == NULL ) {
+    return;
+  }
+  for ( struct dirent *entry = readdir( dir ); entry != NULL; entry = readdir( dir ) ) {
+    if ( strncmp( entry->d_name, start, strlen( start ) ) == 0 ) {
+      char name[300];
+      snprintf( name, sizeof( name ), "/%s", entry->d_name );
+      shm_unlink( name );
+    }
+  }
+  closedir( dir );
+}
+
+// Compare ephemerides bit by bit
+static int compare_ephemerides( const EphemerisData *edat1, const EphemerisData *edat2 )
+{
+  XLAL_CHECK( edat1->etype == edat2->etype, XLAL_EFAILED, "Ephemeris types differ" );
+  XLAL_CHECK( edat1->nentriesE == edat2->nentriesE && edat1->nentriesS == edat2->nentriesS, XLAL_EFAILED, "Numbers of ephemeris entries differ" );
+  XLAL_CHECK( edat1->dtEtable == edat2->dtEtable && edat1->dtStable == edat2->dtStable, XLAL_EFAILED, "Ephemeris time steps differ" );
+  XLAL_CHECK( memcmp( edat1->ephemE, edat2->ephemE, edat1->nentriesE * sizeof( edat1->ephemE[0] ) ) == 0, XLAL_EFAILED, "Earth ephemerides differ" );
+  XLAL_CHECK( memcmp( edat1->ephemS, edat2->ephemS, edat1->nentriesS * sizeof( edat1->ephemS[0] ) ) == 0, XLAL_EFAILED, "Sun ephemerides differ" );
+  return XLAL_SUCCESS;
+}
+
+// Compare SFTs bit by bit
+static int compare_SFTs( const MultiSFTVector *multiSFTs1, const MultiSFTVector *multiSFTs2 )
+{
+  XLAL_CHECK( multiSFTs1->length == multiSFTs2->length, XLAL_EFAILED, "Numbers of detectors differ" );
+  for ( UINT4 X = 0; X < multiSFTs1->length; ++X ) {
+    const SFTVector *sfts1 = multiSFTs1->data[X], *sfts2 = multiSFTs2->data[X];
+    XLAL_CHECK( sfts1->length == sfts2->length, XLAL_EFAILED, "Numbers of SFTs differ for X=%u", X );
+    for ( UINT4 i = 0; i < sfts1->length; ++i ) {
+      const SFTtype *sft1 = &sfts1->data[i], *sft2 = &sfts2->data[i];
+      XLAL_CHECK( strcmp( sft1->name, sft2->name ) == 0 && XLALGPSCmp( &sft1->epoch, &sft2->epoch ) == 0
+                  && sft1->f0 == sft2->f0 && sft1->deltaF == sft2->deltaF, XLAL_EFAILED, "Headers of SFT %u differ for X=%u", i, X );
+      XLAL_CHECK( sft1->data->length == sft2->data->length, XLAL_EFAILED, "Lengths of SFT %u differ for X=%u", i, X );
+      XLAL_CHECK( memcmp( sft1->data->data, sft2->data->data, sft1->data->length * sizeof( sft1->data->data[0] ) ) == 0,
+                  XLAL_EFAILED, "Data of SFT %u differ for X=%u", i, X );
+    }
+  }
+  return XLAL_SUCCESS;
+}
+
+int main( void )
+{
+
+  // Use a prefix unique to this process, and start without the cache
+  snprintf( prefix, sizeof( prefix ), "lalpulsar-SharedMemoryCacheTest-%ld", (long) getpid() );
+  XLAL_CHECK_MAIN( unsetenv( "LALPULSAR_SHM_CACHE" ) == 0, XLAL_ESYS );
+
+  // Load ephemerides and SFTs privately
+  const LIGOTimeGPS start = { 800000000, 0 }, end = { 810000000, 0 };
+  EphemerisData *edat_private = NULL, *edat_private_restricted = NULL;
+  XLAL_CHECK_MAIN( ( edat_private = XLALInitBarycenter( EARTH_DE405, SUN_DE405 ) ) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( ( edat_private_restricted = XLALInitBarycenter( EARTH_DE405, SUN_DE405 ) ) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALRestrictEphemerisData( edat_private_restricted, &start, &end ) == XLAL_SUCCESS, XLAL_EFUNC );
+  SFTCatalog *catalog = NULL;
+  XLAL_CHECK_MAIN( ( catalog = XLALSFTdataFind( TEST_DATA_DIR "MultiNoiseWeightsTest*.sft", NULL ) ) != NULL, XLAL_EFUNC );
+  MultiSFTVector *sfts_private = NULL, *normalized_private = NULL;
+  MultiPSDVector *psds_private = NULL;
+  XLAL_CHECK_MAIN( ( sfts_private = XLALLoadMultiSFTs( catalog, -1, -1 ) ) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALLoadNormalizedMultiSFTs( &normalized_private, &psds_private, catalog, -1, -1, 11, NULL, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Enable the cache
+  XLAL_CHECK_MAIN( setenv( "LALPULSAR_SHM_CACHE", prefix, 1 ) == 0, XLAL_ESYS );
+  char ephem_DE405[256], ephem_DE200[256], sfts[256];
+
+  // The first load publishes the ephemerides; skip the test if shared memory is not available
+  {
+    EphemerisData *edat = NULL;
+    XLAL_CHECK_MAIN( ( edat = XLALInitBarycenter( EARTH_DE405, SUN_DE405 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( compare_ephemerides( edat, edat_private ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyEphemerisData( edat );
+    if ( find_segments( "ephem", NULL, ephem_DE405, sizeof( ephem_DE405 ) ) != 1 ) {
+      fprintf( stderr, "Shared-memory segments could not be published; skipping test\n" );
+      remove_segments();
+      return 77;
+    }
+  }
+
+  // Later loads attach to the published ephemerides
+  {
+    EphemerisData *edat1 = NULL, *edat2 = NULL;
+    XLAL_CHECK_MAIN( ( edat1 = XLALInitBarycenter( EARTH_DE405, SUN_DE405 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( ( edat2 = XLALInitBarycenter( EARTH_DE405, SUN_DE405 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( segment_attached( "ephem" ), XLAL_EFAILED, "Ephemerides were not attached" );
+    XLAL_CHECK_MAIN( compare_ephemerides( edat1, edat_private ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( compare_ephemerides( edat2, edat_private ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // Destroying attached ephemerides detaches only them
+    XLALDestroyEphemerisData( edat1 );
+    XLAL_CHECK_MAIN( segment_attached( "ephem" ), XLAL_EFAILED, "Ephemerides still in use were detached" );
+
+    // Restricting attached ephemerides copies the restricted tables, and detaches them
+    XLAL_CHECK_MAIN( XLALRestrictEphemerisData( edat2, &start, &end ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( !segment_attached( "ephem" ), XLAL_EFAILED, "Restricted ephemerides were not detached" );
+    XLAL_CHECK_MAIN( compare_ephemerides( edat2, edat_private_restricted ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyEphemerisData( edat2 );
+  }
+
+  // Loading SFTs with normalization publishes the raw band, and normalizes copies of it
+  {
+    MultiSFTVector *normalized = NULL;
+    MultiPSDVector *psds = NULL;
+    XLAL_CHECK_MAIN( XLALLoadNormalizedMultiSFTs( &normalized, &psds, catalog, -1, -1, 11, NULL, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( find_segments( "sfts", NULL, sfts, sizeof( sfts ) ) == 1, XLAL_EFAILED, "SFTs were not published" );
+    XLAL_CHECK_MAIN( compare_SFTs( normalized, normalized_private ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyMultiSFTVector( normalized );
+    XLALDestroyMultiPSDVector( psds );
+  }
+
+  // Later loads attach to the raw band, which normalization leaves unchanged
+  {
+    MappedMultiSFTVector *mapped = NULL;
+    XLAL_CHECK_MAIN( ( mapped = XLALLoadMultiSFTsMapped( catalog, -1, -1 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( segment_attached( "sfts" ), XLAL_EFAILED, "SFTs were not attached" );
+    XLAL_CHECK_MAIN( compare_SFTs( mapped->multiSFTs, sfts_private ) == XLAL_SUCCESS, XLAL_EFUNC );
+    MultiSFTVector *normalized = NULL;
+    XLAL_CHECK_MAIN( XLALLoadNormalizedMultiSFTs( &normalized, NULL, catalog, -1, -1, 11, NULL, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( compare_SFTs( normalized, normalized_private ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( compare_SFTs( mapped->multiSFTs, sfts_private ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyMultiSFTVector( normalized );
+    XLALDestroyMappedMultiSFTVector( mapped );
+    XLAL_CHECK_MAIN( !segment_attached( "sfts" ), XLAL_EFAILED, "Destroyed SFTs were not detached" );
+  }
+
+  // SFT files named by a different path attach to the same raw band
+  {
+    SFTCatalog *catalog_dot = NULL;
+    XLAL_CHECK_MAIN( ( catalog_dot = XLALSFTdataFind( TEST_DATA_DIR "./MultiNoiseWeightsTest*.sft", NULL ) ) != NULL, XLAL_EFUNC );
+    MappedMultiSFTVector *mapped = NULL;
+    XLAL_CHECK_MAIN( ( mapped = XLALLoadMultiSFTsMapped( catalog_dot, -1, -1 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( segment_attached( "sfts" ), XLAL_EFAILED, "SFTs named by a different path were not attached" );
+    XLAL_CHECK_MAIN( find_segments( "sfts", NULL, NULL, 0 ) == 1, XLAL_EFAILED, "SFTs named by a different path were published again" );
+    XLAL_CHECK_MAIN( compare_SFTs( mapped->multiSFTs, sfts_private ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyMappedMultiSFTVector( mapped );
+    XLALDestroySFTCatalog( catalog_dot );
+  }
+
+  // Segments whose size does not match their header are ignored, and the data loaded privately
+  {
+    XLAL_CHECK_MAIN( resize_segment( ephem_DE405, 64 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    EphemerisData *edat = NULL;
+    XLAL_CHECK_MAIN( ( edat = XLALInitBarycenter( EARTH_DE405, SUN_DE405 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( !segment_attached( "ephem" ), XLAL_EFAILED, "Resized ephemeris segment was attached" );
+    XLAL_CHECK_MAIN( compare_ephemerides( edat, edat_private ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyEphemerisData( edat );
+
+    XLAL_CHECK_MAIN( resize_segment( sfts, -8 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    MappedMultiSFTVector *mapped = NULL;
+    XLAL_CHECK_MAIN( ( mapped = XLALLoadMultiSFTsMapped( catalog, -1, -1 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( !segment_attached( "sfts" ), XLAL_EFAILED, "Resized SFT segment was attached" );
+    XLAL_CHECK_MAIN( compare_SFTs( mapped->multiSFTs, sfts_private ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyMappedMultiSFTVector( mapped );
+  }
+
+  // Segments holding other data are ignored, and the data loaded privately
+  {
+    EphemerisData *edat = NULL;
+    XLAL_CHECK_MAIN( ( edat = XLALInitBarycenter( EARTH_DE200, SUN_DE200 ) ) != NULL, XLAL_EFUNC );
+    XLALDestroyEphemerisData( edat );
+    XLAL_CHECK_MAIN( find_segments( "ephem", ephem_DE405, ephem_DE200, sizeof( ephem_DE200 ) ) == 2, XLAL_EFAILED, "Ephemerides were not published" );
+    XLAL_CHECK_MAIN( copy_segment( ephem_DE405, ephem_DE200 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( ( edat = XLALInitBarycenter( EARTH_DE405, SUN_DE405 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( !segment_attached( "ephem" ), XLAL_EFAILED, "Mismatched ephemeris segment was attached" );
+    XLAL_CHECK_MAIN( compare_ephemerides( edat, edat_private ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyEphemerisData( edat );
+
+    XLAL_CHECK_MAIN( copy_segment( sfts, ephem_DE200 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    MappedMultiSFTVector *mapped = NULL;
+    XLAL_CHECK_MAIN( ( mapped = XLALLoadMultiSFTsMapped( catalog, -1, -1 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( !segment_attached( "sfts" ), XLAL_EFAILED, "Mismatched SFT segment was attached" );
+    XLAL_CHECK_MAIN( compare_SFTs( mapped->multiSFTs, sfts_private ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyMappedMultiSFTVector( mapped );
+  }
+
+  // Incomplete segments are ignored, and replaced only once they have been abandoned for long enough
+  {
+    MappedMultiSFTVector *mapped = NULL;
+    XLAL_CHECK_MAIN( abandon_segment( sfts, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( ( mapped = XLALLoadMultiSFTsMapped( catalog, -1, -1 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( !segment_attached( "sfts" ), XLAL_EFAILED, "Incomplete SFT segment was attached" );
+    XLAL_CHECK_MAIN( compare_SFTs( mapped->multiSFTs, sfts_private ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyMappedMultiSFTVector( mapped );
+    XLAL_CHECK_MAIN( ( mapped = XLALLoadMultiSFTsMapped( catalog, -1, -1 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( !segment_attached( "sfts" ), XLAL_EFAILED, "Recently incomplete SFT segment was replaced" );
+    XLALDestroyMappedMultiSFTVector( mapped );
+
+    // a day is longer than the timeout after which an incomplete segment is replaced
+    XLAL_CHECK_MAIN( abandon_segment( sfts, 86400 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( ( mapped = XLALLoadMultiSFTsMapped( catalog, -1, -1 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( compare_SFTs( mapped->multiSFTs, sfts_private ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyMappedMultiSFTVector( mapped );
+    XLAL_CHECK_MAIN( ( mapped = XLALLoadMultiSFTsMapped( catalog, -1, -1 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( segment_attached( "sfts" ), XLAL_EFAILED, "Abandoned SFT segment was not replaced" );
+    XLAL_CHECK_MAIN( compare_SFTs( mapped->multiSFTs, sfts_private ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyMappedMultiSFTVector( mapped );
+  }
+
+  // Remove the segments
+  remove_segments();
+  XLAL_CHECK_MAIN( find_segments( "ephem", NULL, NULL, 0 ) == 0 && find_segments( "sfts", NULL, NULL, 0 ) == 0, XLAL_EFAILED, "Segments were not removed" );
+
+  // Cleanup
+  XLALDestroyEphemerisData( edat_private );
+  XLALDestroyEphemerisData( edat_private_restricted );
+  XLALDestroyMultiSFTVector( sfts_private );
+  XLALDestroyMultiSFTVector( normalized_private );
+  XLALDestroyMultiPSDVector( psds_private );
+  XLALDestroySFTCatalog( catalog );
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
+
+#endif // defined(__linux__)
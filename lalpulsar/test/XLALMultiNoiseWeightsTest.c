@@ -29,7 +29,7 @@
  * \author John T. Whelan
  * \file
  * \ingroup SFTutils_h
- * \brief Tests for XLALComputeMultiNoiseWeights()
+ * \brief Tests for XLALComputeMultiNoiseWeights() and XLALLoadNormalizedMultiSFTs()
  *
  * PSDs are calculated using the test SFTs created for
  * SFTfileIOTest.c
@@ -41,6 +41,7 @@
 
 /* ----- internal prototypes ---------- */
 int XLALCompareMultiNoiseWeights ( MultiNoiseWeights *multiWeights1, MultiNoiseWeights *multiWeights2, REAL8 tolerance );
+int XLALCompareNormalizedMultiSFTs ( const MultiSFTVector *multiSFTs1, const MultiPSDVector *multiPSDs1, const MultiSFTVector *multiSFTs2, const MultiPSDVector *multiPSDs2 );
 
 /* ----- function definitions ---------- */
 int
@@ -51,6 +52,8 @@ main (  void )
   SFTConstraints XLAL_INIT_DECL(constraints);
   MultiSFTVector *multiSFTs = NULL;
   MultiPSDVector *multiPSDs = NULL;
+  MultiSFTVector *multiSFTsLoaded = NULL;
+  MultiPSDVector *multiPSDsLoaded = NULL;
   MultiNoiseWeights *multiWeightsXLAL = NULL;
   MultiNoiseWeights *multiWeightsCorrect = NULL;
   UINT4 rngmedBins = 11;
@@ -87,11 +90,20 @@ main (  void )
   /* Compare XLAL weights to reference */
   XLAL_CHECK ( XLALCompareMultiNoiseWeights ( multiWeightsXLAL, multiWeightsCorrect, tolerance ) == XLAL_SUCCESS, XLAL_EFAILED, "Comparison between XLAL and reference MultiNoiseWeights failed\n" );
 
+  /* Load and normalize the SFTs in one go, and check that the normalized SFTs and PSDs are identical, and the weights the same */
+  XLALDestroyMultiNoiseWeights ( multiWeightsXLAL );
+  XLAL_CHECK ( XLALLoadNormalizedMultiSFTs ( &multiSFTsLoaded, &multiPSDsLoaded, catalog, -1, -1, rngmedBins, NULL, 0 ) == XLAL_SUCCESS, XLAL_EFUNC, " XLALLoadNormalizedMultiSFTs failed\n" );
+  XLAL_CHECK ( XLALCompareNormalizedMultiSFTs ( multiSFTs, multiPSDs, multiSFTsLoaded, multiPSDsLoaded ) == XLAL_SUCCESS, XLAL_EFAILED, "XLALLoadNormalizedMultiSFTs() and XLALNormalizeMultiSFTVect() differ\n" );
+  XLAL_CHECK ( ( multiWeightsXLAL = XLALComputeMultiNoiseWeights ( multiPSDsLoaded, rngmedBins, 0 ) ) != NULL, XLAL_EFUNC, " XLALComputeMultiNoiseWeights failed\n" );
+  XLAL_CHECK ( XLALCompareMultiNoiseWeights ( multiWeightsXLAL, multiWeightsCorrect, tolerance ) == XLAL_SUCCESS, XLAL_EFAILED, "Comparison between XLALLoadNormalizedMultiSFTs() and reference MultiNoiseWeights failed\n" );
+
   /* Clean up memory */
   XLALDestroyMultiNoiseWeights ( multiWeightsCorrect );
   XLALDestroyMultiNoiseWeights ( multiWeightsXLAL );
   XLALDestroyMultiPSDVector ( multiPSDs );
   XLALDestroyMultiSFTVector ( multiSFTs );
+  XLALDestroyMultiPSDVector ( multiPSDsLoaded );
+  XLALDestroyMultiSFTVector ( multiSFTsLoaded );
   XLALDestroySFTCatalog ( catalog );
   /* check for memory-leaks */
   LALCheckMemoryLeaks();
@@ -132,3 +144,33 @@ XLALCompareMultiNoiseWeights ( MultiNoiseWeights *multiWeights1, MultiNoiseWeigh
   return XLAL_SUCCESS;
 
 } /* XLALCompareMultiNoiseWeights() */
+
+/**
+ * Comparison function for two sets of normalized SFTs and their PSDs, return success if their headers and data are identical.
+ *
+ */
+int
+XLALCompareNormalizedMultiSFTs ( const MultiSFTVector *multiSFTs1, const MultiPSDVector *multiPSDs1, const MultiSFTVector *multiSFTs2, const MultiPSDVector *multiPSDs2 )
+{
+  XLAL_CHECK ( multiSFTs1->length == multiSFTs2->length && multiPSDs1->length == multiSFTs1->length && multiPSDs2->length == multiSFTs2->length, XLAL_EFAILED, "Numbers of IFOs differ\n" );
+  for ( UINT4 X = 0; X < multiSFTs1->length; X++ )
+    {
+      XLAL_CHECK ( multiSFTs1->data[X]->length == multiSFTs2->data[X]->length, XLAL_EFAILED, "Numbers of SFTs differ for X=%d\n", X );
+      for ( UINT4 alpha = 0; alpha < multiSFTs1->data[X]->length; alpha++ )
+        {
+          const SFTtype *sft1 = &multiSFTs1->data[X]->data[alpha], *sft2 = &multiSFTs2->data[X]->data[alpha];
+          const REAL8FrequencySeries *psd1 = &multiPSDs1->data[X]->data[alpha], *psd2 = &multiPSDs2->data[X]->data[alpha];
+          XLAL_CHECK ( XLALGPSCmp ( &sft1->epoch, &sft2->epoch ) == 0 && sft1->f0 == sft2->f0 && sft1->deltaF == sft2->deltaF, XLAL_EFAILED, "SFT headers differ for X=%d, alpha=%d\n", X, alpha );
+          XLAL_CHECK ( sft1->data->length == sft2->data->length && psd1->data->length == psd2->data->length, XLAL_EFAILED, "Numbers of bins differ for X=%d, alpha=%d\n", X, alpha );
+          for ( UINT4 k = 0; k < sft1->data->length; k++ )
+            {
+              XLAL_CHECK ( sft1->data->data[k] == sft2->data->data[k], XLAL_EFAILED, "SFT data differs for X=%d, alpha=%d, bin %d\n", X, alpha, k );
+            }
+          for ( UINT4 k = 0; k < psd1->data->length; k++ )
+            {
+              XLAL_CHECK ( psd1->data->data[k] == psd2->data->data[k], XLAL_EFAILED, "PSD data differs for X=%d, alpha=%d, bin %d\n", X, alpha, k );
+            }
+        }
+    }
+  return XLAL_SUCCESS;
+}